@@ -943,9 +943,16 @@ void CaptureContext::CacheResources()
 {
   m_Resources.clear();
 
+  // invalidate the name cache and pre-fill it for every known resource, so that name lookups
+  // during painting are a single cached fetch and the sort below doesn't re-fetch names for
+  // every comparison.
+  m_ResourceNameCache.clear();
+  for(ResourceDescription &res : m_ResourceList)
+    m_ResourceNameCache[res.resourceId] = GetResourceName(&res);
+
   std::sort(m_ResourceList.begin(), m_ResourceList.end(),
             [this](const ResourceDescription &a, const ResourceDescription &b) {
-              return GetResourceName(&a) < GetResourceName(&b);
+              return m_ResourceNameCache[a.resourceId] < m_ResourceNameCache[b.resourceId];
             });
 
   for(ResourceDescription &res : m_ResourceList)
@@ -1189,6 +1196,7 @@ void CaptureContext::CloseCapture()
   m_TextureList.clear();
   m_Resources.clear();
   m_ResourceList.clear();
+  m_ResourceNameCache.clear();
 
   m_CustomNames.clear();
   m_Bookmarks.clear();
@@ -1375,6 +1383,43 @@ void CaptureContext::SetEventID(const rdcarray<ICaptureViewer *> &exclude, uint3
   bool updateEvent = force || prevEventID != eventId;
 
   RefreshUIStatus(exclude, updateSelectedEvent, updateEvent);
+
+  PrefetchAdjacentEvents(eventId);
+}
+
+void CaptureContext::PrefetchAdjacentEvents(uint32_t eventId)
+{
+  const DrawcallDescription *draw = GetDrawcall(eventId);
+
+  if(!draw)
+    return;
+
+  // the draws the user is most likely to step to with the arrow keys
+  rdcarray<uint32_t> neighbours;
+  if(draw->next)
+    neighbours.push_back(draw->next->eventId);
+  if(draw->previous)
+    neighbours.push_back(draw->previous->eventId);
+
+  if(neighbours.empty())
+    return;
+
+  // speculatively replay the adjacent draws, so that when the user steps to one of them the
+  // replay-side caches are already warm. This is queued at prefetch priority so anything
+  // interactive that comes in meanwhile runs first, and a newer prefetch for a different event
+  // supersedes this one.
+  m_Replay.AsyncInvoke(lit("EventPrefetch"), ReplayPriority::Prefetch,
+                       [this, eventId, neighbours](IReplayController *r) {
+    for(uint32_t eid : neighbours)
+    {
+      // stop if the user has moved elsewhere or a newer prefetch cancelled us - any replaying
+      // we've done so far is still useful.
+      if(m_EventID != eventId || m_Replay.IsCurrentInvokeCancelled())
+        break;
+
+      r->PrefetchFrameEvent(eid);
+    }
+  });
 }
 
 void CaptureContext::SetRemoteHost(int hostIdx)
@@ -1679,14 +1724,30 @@ rdcstr CaptureContext::GetResourceName(ResourceId id)
   if(id == ResourceId())
     return tr("No Resource");
 
+  // this is called per-cell during painting in several models, so serve repeated lookups from
+  // the cache. The cache is invalidated on rename (via CacheResources) and on capture close.
+  auto it = m_ResourceNameCache.find(id);
+  if(it != m_ResourceNameCache.end())
+    return it.value();
+
+  rdcstr ret;
+
   ResourceDescription *desc = GetResource(id);
 
   if(desc)
-    return GetResourceName(desc);
+  {
+    ret = GetResourceName(desc);
+  }
+  else
+  {
+    uint64_t num;
+    memcpy(&num, &id, sizeof(num));
+    ret = tr("Unknown Resource %1").arg(num);
+  }
+
+  m_ResourceNameCache.insert(id, ret);
 
-  uint64_t num;
-  memcpy(&num, &id, sizeof(num));
-  return tr("Unknown Resource %1").arg(num);
+  return ret;
 }
 
 rdcstr CaptureContext::GetResourceName(const ResourceDescription *desc)
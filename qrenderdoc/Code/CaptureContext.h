@@ -307,6 +307,8 @@ private:
                          std::function<void()> callback);
   void CleanMenu(QAction *action);
 
+  void PrefetchAdjacentEvents(uint32_t eventId);
+
   uint32_t m_SelectedEventID = 0;
   uint32_t m_EventID = 0;
 
@@ -354,6 +356,10 @@ private:
   QMap<ResourceId, QString> m_CustomNames;
   int m_CustomNameCachedID = 1;
 
+  // cached display names for resources, rebuilt whenever names change (see CacheResources) so
+  // repeated GetResourceName calls during painting don't re-format anything
+  QMap<ResourceId, rdcstr> m_ResourceNameCache;
+
   const SDFile *m_StructuredFile = NULL;
   SDFile m_DummySDFile;
 
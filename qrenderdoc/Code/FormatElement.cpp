@@ -997,6 +997,117 @@ QVariantList FormatElement::GetVariants(const byte *&data, const byte *end) cons
   return ret;
 }
 
+uint32_t FormatElement::GetFloats(const byte *data, const byte *end, float out[4]) const
+{
+  // only plain float/integer formats convert directly - packed formats, matrices, normalised
+  // types and BGRA ordering go through the generic QVariant path below.
+  bool direct = format.type == ResourceFormatType::Regular && matrixdim <= 1 &&
+                !format.BGRAOrder() &&
+                (format.compType == CompType::Float || format.compType == CompType::UInt ||
+                 format.compType == CompType::SInt || format.compType == CompType::UScaled ||
+                 format.compType == CompType::SScaled || format.compType == CompType::Depth ||
+                 format.compType == CompType::Double);
+
+  if(!direct)
+  {
+    QVariantList list = GetVariants(data, end);
+
+    uint32_t count = (uint32_t)qMin(4, list.count());
+
+    for(uint32_t comp = 0; comp < count; comp++)
+    {
+      const QVariant &v = list[(int)comp];
+
+      QMetaType::Type vt = GetVariantMetatype(v);
+
+      if(vt == QMetaType::Double)
+        out[comp] = (float)v.toDouble();
+      else if(vt == QMetaType::Float)
+        out[comp] = v.toFloat();
+      else if(vt == QMetaType::UInt || vt == QMetaType::UShort || vt == QMetaType::UChar)
+        out[comp] = (float)v.toUInt();
+      else if(vt == QMetaType::Int || vt == QMetaType::Short || vt == QMetaType::SChar)
+        out[comp] = (float)v.toInt();
+      else
+        out[comp] = (float)qQNaN();
+    }
+
+    return count;
+  }
+
+  uint32_t count = qMin(4U, (uint32_t)format.compCount);
+
+  bool ok = true;
+
+  for(uint32_t i = 0; i < count && ok; i++)
+  {
+    if(format.compType == CompType::Float)
+    {
+      if(format.compByteWidth == 8)
+        out[i] = (float)readObj<double>(data, end, ok);
+      else if(format.compByteWidth == 4)
+        out[i] = readObj<float>(data, end, ok);
+      else if(format.compByteWidth == 2)
+        out[i] = RENDERDOC_HalfToFloat(readObj<uint16_t>(data, end, ok));
+      else
+        out[i] = (float)qQNaN();
+    }
+    else if(format.compType == CompType::SInt || format.compType == CompType::SScaled)
+    {
+      if(format.compByteWidth == 4)
+        out[i] = (float)readObj<int32_t>(data, end, ok);
+      else if(format.compByteWidth == 2)
+        out[i] = (float)readObj<int16_t>(data, end, ok);
+      else if(format.compByteWidth == 1)
+        out[i] = (float)readObj<int8_t>(data, end, ok);
+      else
+        out[i] = (float)qQNaN();
+    }
+    else if(format.compType == CompType::UInt || format.compType == CompType::UScaled)
+    {
+      if(format.compByteWidth == 4)
+        out[i] = (float)readObj<uint32_t>(data, end, ok);
+      else if(format.compByteWidth == 2)
+        out[i] = (float)readObj<uint16_t>(data, end, ok);
+      else if(format.compByteWidth == 1)
+        out[i] = (float)readObj<uint8_t>(data, end, ok);
+      else
+        out[i] = (float)qQNaN();
+    }
+    else if(format.compType == CompType::Depth)
+    {
+      if(format.compByteWidth == 4)
+      {
+        out[i] = readObj<float>(data, end, ok);
+      }
+      else if(format.compByteWidth == 3)
+      {
+        uint32_t f = readObj<uint32_t>(data, end, ok);
+        f &= 0x00ffffff;
+        out[i] = (float)f / (float)0x00ffffff;
+      }
+      else if(format.compByteWidth == 2)
+      {
+        out[i] = (float)readObj<uint16_t>(data, end, ok) / (float)0x0000ffff;
+      }
+      else
+      {
+        out[i] = (float)qQNaN();
+      }
+    }
+    else if(format.compType == CompType::Double)
+    {
+      out[i] = (float)readObj<double>(data, end, ok);
+    }
+  }
+
+  // we read off the end, return nothing - matching GetVariants()
+  if(!ok)
+    return 0;
+
+  return count;
+}
+
 ShaderVariable FormatElement::GetShaderVar(const byte *&data, const byte *end) const
 {
   QVariantList objs = GetVariants(data, end);
@@ -683,6 +683,31 @@ protected:
 DECLARE_REFLECTION_STRUCT(ICaptureViewer);
 DECLARE_REFLECTION_STRUCT(ICaptureViewer *);
 
+DOCUMENT(R"(Specifies the priority of a non-blocking invoke onto the replay thread. Queued
+invokes are processed in priority order - higher priority invokes jump ahead of queued lower
+priority ones, and invokes at the same priority are processed in the order they were made.
+
+.. data:: Interactive
+
+  The invoke is in direct response to user input - e.g. changing event, or picking a pixel - and
+  should be processed as soon as possible.
+
+.. data:: Prefetch
+
+  The invoke fetches data speculatively or refreshes something non-critical such as a thumbnail.
+  It waits behind interactive work but runs ahead of long background tasks.
+
+.. data:: Background
+
+  The invoke is a long-running task with no interactive deadline, such as fetching counter data.
+)");
+enum class ReplayPriority : int
+{
+  Interactive = 0,
+  Prefetch,
+  Background,
+};
+
 DOCUMENT(R"(A manager for accessing the underlying replay information that isn't already abstracted
 in UI side structures. This manager controls and serialises access to the underlying
 :class:`~renderdoc.ReplayController`, as well as handling remote server connections.
@@ -845,12 +870,37 @@ comes in, we remove any other requests in the queue before it that have the same
 )");
   virtual void AsyncInvoke(const rdcstr &tag, InvokeCallback method) = 0;
 
+  DOCUMENT(R"(Make a tagged non-blocking invoke call onto the replay thread at a given priority.
+
+In addition to the queue-removal behaviour of the tagged overload above, if the currently
+executing invoke has the same tag it is flagged as cancelled. Cancellation is cooperative -
+expensive callbacks can poll :meth:`IsCurrentInvokeCancelled` between steps and return early,
+since their result has already been superseded.
+
+:param str tag: The tag to identify this callback.
+:param ReplayPriority priority: The priority to process this callback at, relative to other
+  queued invokes.
+:param InvokeCallback method: The function to callback on the replay thread.
+)");
+  virtual void AsyncInvoke(const rdcstr &tag, ReplayPriority priority, InvokeCallback method) = 0;
+
   DOCUMENT(R"(Make a non-blocking invoke call onto the replay thread.
 
 :param InvokeCallback method: The function to callback on the replay thread.
 )");
   virtual void AsyncInvoke(InvokeCallback method) = 0;
 
+  DOCUMENT(R"(Check from within an invoke callback whether that invoke has been superseded.
+
+Returns ``True`` if a newer invoke with the same tag arrived while this one was executing, or if
+the replay thread is shutting down. Callbacks which do a lot of work in multiple steps can poll
+this and bail out early rather than computing a result that will be thrown away.
+
+:return: ``True`` if the currently executing invoke has been cancelled.
+:rtype: bool
+)");
+  virtual bool IsCurrentInvokeCancelled() = 0;
+
   // This is an ugly hack, but we leave BlockInvoke as the last method, so that when the class is
   // extended and the wrapper around BlockInvoke to release the python GIL happens, it picks up the
   // same docstring.
@@ -86,6 +86,11 @@ public:
   static QString GenerateTextureBufferFormat(const TextureDescription &tex);
 
   QVariantList GetVariants(const byte *&data, const byte *end) const;
+  // interpret up to the first four components of one element directly as floats, without
+  // allocating QVariants - for bulk passes over whole tables like bounding box calculation.
+  // Returns the number of components written to out. Components that have no meaningful float
+  // interpretation are written as NaN, so callers filtering on qIsFinite() skip them.
+  uint32_t GetFloats(const byte *data, const byte *end, float out[4]) const;
   ShaderVariable GetShaderVar(const byte *&data, const byte *end) const;
 
   uint32_t byteSize() const;
@@ -237,6 +237,12 @@ float ReplayManager::GetCurrentProcessingTime()
 }
 
 void ReplayManager::AsyncInvoke(const rdcstr &tag, ReplayManager::InvokeCallback m)
+{
+  AsyncInvoke(tag, ReplayPriority::Interactive, m);
+}
+
+void ReplayManager::AsyncInvoke(const rdcstr &tag, ReplayPriority priority,
+                                ReplayManager::InvokeCallback m)
 {
   QString qtag(tag);
 
@@ -255,9 +261,14 @@ void ReplayManager::AsyncInvoke(const rdcstr &tag, ReplayManager::InvokeCallback
         i++;
       }
     }
+
+    // if the invoke currently being executed has the same tag, its result is already stale. Flag
+    // it as cancelled so the callback can poll IsCurrentInvokeCancelled() and bail out early.
+    if(m_CurrentInvoke && m_CurrentInvoke->tag == qtag)
+      m_CurrentInvoke->cancelled = 1;
   }
 
-  InvokeHandle *cmd = new InvokeHandle(m, qtag);
+  InvokeHandle *cmd = new InvokeHandle(m, qtag, priority);
   cmd->selfdelete = true;
 
   PushInvoke(cmd);
@@ -271,6 +282,16 @@ void ReplayManager::AsyncInvoke(ReplayManager::InvokeCallback m)
   PushInvoke(cmd);
 }
 
+bool ReplayManager::IsCurrentInvokeCancelled()
+{
+  // when shutting down everything is cancelled, so long-running callbacks stop promptly
+  if(!m_Running)
+    return true;
+
+  QMutexLocker autolock(&m_RenderLock);
+  return m_CurrentInvoke != NULL && m_CurrentInvoke->cancelled != 0;
+}
+
 void ReplayManager::BlockInvoke(ReplayManager::InvokeCallback m)
 {
   InvokeHandle *cmd = new InvokeHandle(m);
@@ -411,7 +432,14 @@ void ReplayManager::PushInvoke(ReplayManager::InvokeHandle *cmd)
   }
 
   QMutexLocker autolock(&m_RenderLock);
-  m_RenderQueue.enqueue(cmd);
+
+  // insert ahead of any queued invokes with a strictly lower priority, but behind everything of
+  // equal or higher priority, so that invokes at the same priority stay in FIFO order.
+  int idx = 0;
+  while(idx < m_RenderQueue.count() && m_RenderQueue[idx]->priority <= cmd->priority)
+    idx++;
+  m_RenderQueue.insert(idx, cmd);
+
   m_RenderCondition.wakeAll();
 }
 
@@ -462,6 +490,8 @@ void ReplayManager::run(int proxyRenderer, const QString &capturefile,
 
       if(!m_RenderQueue.isEmpty())
         cmd = m_RenderQueue.dequeue();
+
+      m_CurrentInvoke = cmd;
     }
 
     if(cmd == NULL)
@@ -482,6 +512,11 @@ void ReplayManager::run(int proxyRenderer, const QString &capturefile,
       }
     }
 
+    {
+      QMutexLocker autolock(&m_RenderLock);
+      m_CurrentInvoke = NULL;
+    }
+
     // if it's a throwaway command, delete it
     if(cmd->selfdelete)
       delete cmd;
@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include <QAtomicInt>
 #include <QElapsedTimer>
 #include <QMutex>
 #include <QQueue>
@@ -61,7 +62,9 @@ public:
   // the manager processes only the request on the top of the queue, so when a new tagged invoke
   // comes in, we remove any other requests in the queue before it that have the same tag
   void AsyncInvoke(const rdcstr &tag, InvokeCallback m);
+  void AsyncInvoke(const rdcstr &tag, ReplayPriority priority, InvokeCallback m);
   void AsyncInvoke(InvokeCallback m);
+  bool IsCurrentInvokeCancelled();
   void BlockInvoke(InvokeCallback m);
 
   void CancelReplayLoop();
@@ -100,16 +103,20 @@ public:
 private:
   struct InvokeHandle
   {
-    InvokeHandle(InvokeCallback m, const QString &t = QString())
+    InvokeHandle(InvokeCallback m, const QString &t = QString(),
+                 ReplayPriority p = ReplayPriority::Interactive)
     {
       tag = t;
       method = m;
+      priority = p;
       selfdelete = false;
     }
 
     QString tag;
     InvokeCallback method;
+    ReplayPriority priority;
     QSemaphore processed;
+    QAtomicInt cancelled;
     bool selfdelete;
   };
 
@@ -121,6 +128,9 @@ private:
   QMutex m_RenderLock;
   QQueue<InvokeHandle *> m_RenderQueue;
   QWaitCondition m_RenderCondition;
+  // the invoke currently executing on the replay thread, so a newer invoke with the same tag can
+  // flag it as cancelled. Only accessed with m_RenderLock held.
+  InvokeHandle *m_CurrentInvoke = NULL;
 
   ICaptureFile *m_CaptureFile = NULL;
   IReplayController *m_Renderer = NULL;
@@ -341,6 +341,16 @@ void PythonContext::GlobalInit()
   PyEval_SaveThread();
 }
 
+void PythonContext::EnsureGlobalInit()
+{
+  // creating the interpreter and registering the binding modules takes a second or two, so it's
+  // deferred until the python shell or an extension actually needs it rather than being paid by
+  // every startup. The interpreter must live (and be finalised) on the UI thread, so GlobalInit's
+  // thread check still applies here.
+  if(!initialised())
+    GlobalInit();
+}
+
 bool PythonContext::initialised()
 {
   return main_dict != NULL;
@@ -348,6 +358,8 @@ bool PythonContext::initialised()
 
 PythonContext::PythonContext(QObject *parent) : QObject(parent)
 {
+  EnsureGlobalInit();
+
   if(!initialised())
     return;
 
@@ -473,6 +485,10 @@ void PythonContext::GlobalShutdown()
 
 void PythonContext::ProcessExtensionWork(std::function<void()> callback)
 {
+  // extensions may be the first thing to touch python, and we can't take the GIL before the
+  // interpreter exists
+  EnsureGlobalInit();
+
   PyGILState_STATE gil = PyGILState_Ensure();
 
   callback();
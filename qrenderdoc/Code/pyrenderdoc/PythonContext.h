@@ -53,6 +53,9 @@ public:
 
   PyThreadState *GetExecutingThreadState() { return m_State; }
   static void GlobalInit();
+  // initialises the interpreter on first use, so sessions that never touch scripting don't pay
+  // the startup cost. Like GlobalInit this must be called on the UI thread
+  static void EnsureGlobalInit();
   static void GlobalShutdown();
 
   static void ProcessExtensionWork(std::function<void()> callback);
@@ -493,15 +493,36 @@ struct TypeConversion<bytebuf, false>
   // nicer failure error messages out with the index that failed
   static int ConvertFromPy(PyObject *in, bytebuf &out, int *failIdx)
   {
-    if(!PyBytes_Check(in))
-      return SWIG_TypeError;
+    if(PyBytes_Check(in))
+    {
+      Py_ssize_t len = PyBytes_Size(in);
 
-    Py_ssize_t len = PyBytes_Size(in);
+      out.resize((size_t)len);
+      memcpy(out.data(), PyBytes_AsString(in), out.size());
 
-    out.resize((size_t)len);
-    memcpy(out.data(), PyBytes_AsString(in), out.size());
+      return SWIG_OK;
+    }
 
-    return SWIG_OK;
+    // accept any contiguous buffer-protocol object - bytearray, memoryview, numpy arrays, or the
+    // views returned from bulk readbacks like GetBufferData
+    if(PyObject_CheckBuffer(in))
+    {
+      Py_buffer view;
+      if(PyObject_GetBuffer(in, &view, PyBUF_CONTIG_RO) != 0)
+      {
+        PyErr_Clear();
+        return SWIG_TypeError;
+      }
+
+      out.resize((size_t)view.len);
+      memcpy(out.data(), view.buf, out.size());
+
+      PyBuffer_Release(&view);
+
+      return SWIG_OK;
+    }
+
+    return SWIG_TypeError;
   }
 
   static int ConvertFromPy(PyObject *in, bytebuf &out) { return ConvertFromPy(in, out, NULL); }
@@ -519,6 +540,62 @@ struct TypeConversion<bytebuf, false>
   static PyObject *ConvertToPy(const bytebuf &in) { return ConvertToPy(in, NULL); }
 };
 
+// python object that owns a bytebuf and exposes it via the buffer protocol. Used for functions
+// that return a bytebuf by value - the result is moved in here rather than copied into an
+// immutable bytes object, so scripts can wrap multi-gigabyte readbacks in a memoryview or numpy
+// array without a copy.
+struct bytebuf_owner
+{
+  PyObject_HEAD
+  bytebuf *buf;
+};
+
+static int bytebuf_owner_getbuffer(PyObject *obj, Py_buffer *view, int flags)
+{
+  bytebuf *buf = ((bytebuf_owner *)obj)->buf;
+  return PyBuffer_FillInfo(view, obj, buf->data(), (Py_ssize_t)buf->size(), 1 /* readonly */, flags);
+}
+
+static void bytebuf_owner_dealloc(PyObject *obj)
+{
+  delete ((bytebuf_owner *)obj)->buf;
+  Py_TYPE(obj)->tp_free(obj);
+}
+
+inline PyObject *StealBytebufToPy(bytebuf &in)
+{
+  static PyBufferProcs bufferprocs = {};
+  static PyTypeObject owner_type = {PyVarObject_HEAD_INIT(NULL, 0)};
+
+  if(owner_type.tp_name == NULL)
+  {
+    bufferprocs.bf_getbuffer = &bytebuf_owner_getbuffer;
+
+    owner_type.tp_name = "renderdoc.bytebuf_owner";
+    owner_type.tp_basicsize = sizeof(bytebuf_owner);
+    owner_type.tp_dealloc = &bytebuf_owner_dealloc;
+    owner_type.tp_flags = Py_TPFLAGS_DEFAULT;
+    owner_type.tp_as_buffer = &bufferprocs;
+    owner_type.tp_doc = "Owns raw data returned from the replay, accessed via the buffer protocol";
+
+    if(PyType_Ready(&owner_type) < 0)
+      return NULL;
+  }
+
+  bytebuf_owner *owner = PyObject_New(bytebuf_owner, &owner_type);
+  if(!owner)
+    return NULL;
+
+  owner->buf = new bytebuf;
+  owner->buf->swap(in);
+
+  // hand back a memoryview over the owning object, which keeps it alive for as long as the view
+  // (or anything constructed from it) exists
+  PyObject *view = PyMemoryView_FromObject((PyObject *)owner);
+  Py_DECREF(owner);
+  return view;
+}
+
 // specialisation for array
 template <typename U>
 struct TypeConversion<rdcarray<U>, false>
@@ -150,6 +150,37 @@ SIMPLE_TYPEMAPS(rdcstr)
 SIMPLE_TYPEMAPS(rdcdatetime)
 SIMPLE_TYPEMAPS(bytebuf)
 
+// ignore the caller-buffer-reuse overloads of the bulk readbacks - python callers can't re-use an
+// allocation through an immutable bytes object, so only the by-value returning variants make sense.
+%ignore IReplayController::GetBufferData(ResourceId, uint64_t, uint64_t, bytebuf &);
+%ignore IReplayController::GetTextureData(ResourceId, uint32_t, uint32_t, bytebuf &);
+
+// functions that return a bytebuf by value hand their result over wholesale - e.g. the bulk
+// readbacks GetBufferData and GetTextureData. Instead of copying into an immutable bytes object,
+// move the result into an owning object exposing the buffer protocol, so scripts can wrap
+// potentially gigabytes of data in a memoryview or numpy array without a copy. Note this
+// deliberately doesn't apply to bytebuf members or reference returns, which don't own their data.
+%typemap(out) bytebuf {
+  $result = StealBytebufToPy($1);
+  if(!$result)
+    SWIG_fail;
+}
+
+// release the GIL while the bulk readbacks execute on the replay, so that other python threads
+// can make progress instead of blocking behind replay work. The GIL is re-acquired before the
+// result is converted.
+%exception IReplayController::GetBufferData {
+  Py_BEGIN_ALLOW_THREADS
+  $action
+  Py_END_ALLOW_THREADS
+}
+
+%exception IReplayController::GetTextureData {
+  Py_BEGIN_ALLOW_THREADS
+  $action
+  Py_END_ALLOW_THREADS
+}
+
 FIXED_ARRAY_TYPEMAPS(ResourceId)
 FIXED_ARRAY_TYPEMAPS(double)
 FIXED_ARRAY_TYPEMAPS(float)
@@ -384,7 +384,9 @@ int main(int argc, char *argv[])
     }
     else
     {
-      PythonContext::GlobalInit();
+      // python initialises lazily on first use - see PythonContext::EnsureGlobalInit(). Most
+      // sessions never touch scripting, and the interpreter setup takes a second or two that
+      // would otherwise delay the UI appearing.
 
       if(updateApplied)
       {
@@ -31,6 +31,7 @@ CustomPaintWidget::CustomPaintWidget(QWidget *parent) : QWidget(parent)
 {
   m_Ctx = NULL;
   m_Output = NULL;
+  m_Priority = ReplayPriority::Interactive;
   setAttribute(Qt::WA_OpaquePaintEvent);
   setMouseTracking(true);
   m_Tag = QFormatStr("custompaint%1").arg((uintptr_t) this);
@@ -40,6 +41,7 @@ CustomPaintWidget::CustomPaintWidget(ICaptureContext *c, QWidget *parent) : QWid
 {
   m_Ctx = c;
   m_Output = NULL;
+  m_Priority = ReplayPriority::Interactive;
   setAttribute(Qt::WA_OpaquePaintEvent);
   if(c)
     setAttribute(Qt::WA_PaintOnScreen);
@@ -91,7 +93,8 @@ void CustomPaintWidget::paintEvent(QPaintEvent *e)
   if(m_Ctx)
   {
     if(m_Output != NULL)
-      m_Ctx->Replay().AsyncInvoke(m_Tag, [this](IReplayController *r) { m_Output->Display(); });
+      m_Ctx->Replay().AsyncInvoke(m_Tag, m_Priority,
+                                  [this](IReplayController *r) { m_Output->Display(); });
   }
   else if(m_Dark == m_Light)
   {
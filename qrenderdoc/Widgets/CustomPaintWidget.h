@@ -28,6 +28,7 @@
 
 struct IReplayOutput;
 struct ICaptureContext;
+enum class ReplayPriority : int;
 
 class CustomPaintWidget : public QWidget
 {
@@ -45,6 +46,9 @@ public:
   // So we go by whether or not we have a CaptureContext * and go on faith that the
   // output will be set before any painting work has to happen.
   void setOutput(IReplayOutput *out) { m_Output = out; }
+  // the priority the display invokes are queued at. Defaults to interactive, but non-critical
+  // displays like thumbnails can be lowered so they don't hold up user-driven work.
+  void setRenderPriority(ReplayPriority priority) { m_Priority = priority; }
   void setColours(QColor dark, QColor light)
   {
     m_Dark = dark;
@@ -80,6 +84,7 @@ protected:
   QPaintEngine *paintEngine() const override { return m_Ctx ? NULL : QWidget::paintEngine(); }
   ICaptureContext *m_Ctx;
   IReplayOutput *m_Output;
+  ReplayPriority m_Priority;
   QString m_Tag;
   QColor m_Dark;
   QColor m_Light;
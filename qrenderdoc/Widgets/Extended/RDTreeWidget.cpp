@@ -583,6 +583,9 @@ RDTreeWidget::RDTreeWidget(QWidget *parent) : RDTreeView(parent)
   m_model = new RDTreeWidgetModel(this);
   RDTreeView::setModel(m_model);
 
+  QObject::connect(this, &RDTreeWidget::expanded, [this](const QModelIndex &idx) {
+    emit itemExpanded(m_model->itemForIndex(idx));
+  });
   QObject::connect(this, &RDTreeWidget::activated, [this](const QModelIndex &idx) {
     emit itemActivated(m_model->itemForIndex(idx), idx.column());
   });
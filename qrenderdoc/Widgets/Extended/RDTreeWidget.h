@@ -260,6 +260,7 @@ public:
 
 signals:
   void mouseMove(QMouseEvent *e);
+  void itemExpanded(RDTreeWidgetItem *item);
   void itemClicked(RDTreeWidgetItem *item, int column);
   void itemChanged(RDTreeWidgetItem *item, int column);
   void itemDoubleClicked(RDTreeWidgetItem *item, int column);
@@ -34,6 +34,8 @@ ResourcePreview::ResourcePreview(ICaptureContext &c, IReplayOutput *output, QWid
 
   CustomPaintWidget *thumb = new CustomPaintWidget(&c, this);
   thumb->setOutput(output);
+  // thumbnails are nice-to-have, don't queue their redraws ahead of interactive work
+  thumb->setRenderPriority(ReplayPriority::Prefetch);
   thumb->setObjectName(ui->thumbnail->objectName());
   thumb->setSizePolicy(ui->thumbnail->sizePolicy());
   thumb->setMinimumSize(QSize(0, 0));
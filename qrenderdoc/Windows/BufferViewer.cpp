@@ -328,10 +328,60 @@ struct BufferData
   bytebuf storage;
   QAtomicInteger<uint32_t> refcount;
 
+  // Paged access for large raw buffer views. Instead of fetching the whole contents up front we
+  // page windows of rows in on demand as they scroll into view, and discard the least recently
+  // fetched pages over the cap below, keeping memory bounded no matter how large the buffer is.
+  // Pages are only inserted and evicted on the UI thread.
+  static const uint32_t PageRowCount = 0x10000;
+  static const int MaxResidentPages = 4;
+
+  bool paged = false;
+  uint64_t pagedSize = 0;          // byte size of the whole buffer view
+  uint64_t pageByteSize = 0;       // byte size of one page - always a whole number of rows
+  QMap<uint64_t, bytebuf> pages;   // resident pages, keyed by byte offset within the view
+  QList<uint64_t> pageLRU;
+
   const byte *data() const { return storage.begin(); };
   const byte *end() const { return storage.end(); }
-  bool hasData() const { return !storage.empty(); }
-  size_t size() const { return storage.size(); }
+  bool hasData() const { return paged ? pagedSize > 0 : !storage.empty(); }
+  size_t size() const { return paged ? (size_t)pagedSize : storage.size(); }
+
+  // look up the bytes at offs into the buffer view, returning the end of contiguously readable
+  // data in dataEnd. For paged data this returns NULL if the containing page isn't resident -
+  // the caller is expected to request the page and display a placeholder in the meantime.
+  const byte *dataAt(uint64_t offs, const byte *&dataEnd) const
+  {
+    if(!paged)
+    {
+      dataEnd = end();
+      if(offs >= storage.size())
+        return dataEnd;
+      return data() + offs;
+    }
+
+    uint64_t page = offs - (offs % pageByteSize);
+
+    auto it = pages.find(page);
+    if(it == pages.end() || it->empty())
+    {
+      dataEnd = NULL;
+      return NULL;
+    }
+
+    dataEnd = it->end();
+    return it->begin() + (offs - page);
+  }
+
+  void insertPage(uint64_t offs, bytebuf &pageData)
+  {
+    pages[offs].swap(pageData);
+
+    pageLRU.removeOne(offs);
+    pageLRU.push_back(offs);
+
+    while(pageLRU.count() > MaxResidentPages)
+      pages.remove(pageLRU.takeFirst());
+  }
 };
 
 struct BufferConfiguration
@@ -572,6 +622,16 @@ public:
   {
     emit beginResetModel();
     config.reset();
+    m_PageCtx = NULL;
+    m_CachedElement = -1;
+  }
+  // configure on-demand paging for a raw buffer view whose buffers[0] is paged - pages are
+  // fetched from the replay thread as their rows scroll into view.
+  void setPageSource(ICaptureContext &ctx, ResourceId id, uint64_t baseByteOffset)
+  {
+    m_PageCtx = &ctx;
+    m_PageBufferId = id;
+    m_PageBaseOffset = baseByteOffset;
   }
   void endReset(const BufferConfiguration &conf)
   {
@@ -718,18 +778,24 @@ public:
         else
         {
           const FormatElement &el = elementForColumn(col);
+          int elIdx = elementIndexForColumn(col);
 
           if(el.rgb && el.buffer < config.buffers.size())
           {
-            const byte *data = config.buffers[el.buffer]->data();
-            const byte *end = config.buffers[el.buffer]->end();
+            const BufferData *buffer = config.buffers[el.buffer];
+
+            uint64_t offs = buffer->stride * uint64_t(row) + el.offset;
+
+            const byte *end = NULL;
+            const byte *data = buffer->dataAt(offs, end);
 
-            data += config.buffers[el.buffer]->stride * row;
-            data += el.offset;
+            // page not resident yet - skip the colouring, the DisplayRole lookup will fetch it.
+            if(data == NULL)
+              return QVariant();
 
             // only slightly wasteful, we need to fetch all variants together
             // since some formats are packed and can't be read individually
-            QVariantList list = el.GetVariants(data, end);
+            QVariantList list = cachedVariants(elIdx, el, offs, data, end);
 
             if(!list.isEmpty())
             {
@@ -831,19 +897,25 @@ public:
 
           if(el.buffer < config.buffers.size())
           {
-            const byte *data = config.buffers[el.buffer]->data();
-            const byte *end = config.buffers[el.buffer]->end();
+            const BufferData *buffer = config.buffers[el.buffer];
 
-            if(!el.perinstance)
-              data += config.buffers[el.buffer]->stride * idx;
-            else
-              data += config.buffers[el.buffer]->stride * instIdx;
+            uint64_t offs = buffer->stride * uint64_t(el.perinstance ? instIdx : idx) + el.offset;
+
+            const byte *end = NULL;
+            const byte *data = buffer->dataAt(offs, end);
 
-            data += el.offset;
+            // the page containing this row isn't resident yet - kick off a fetch and show a
+            // placeholder, the rows will repaint when it arrives.
+            if(data == NULL)
+            {
+              if(GUIInvoke::onUIThread())
+                const_cast<BufferItemModel *>(this)->fetchPage(offs);
+              return QString();
+            }
 
             // only slightly wasteful, we need to fetch all variants together
             // since some formats are packed and can't be read individually
-            QVariantList list = el.GetVariants(data, end);
+            QVariantList list = cachedVariants(elementIndexForColumn(col), el, offs, data, end);
 
             int comp = componentForIndex(col);
 
@@ -958,6 +1030,84 @@ private:
   // the mutable configuration of what we're displaying.
   BufferConfiguration config;
 
+  // the last interpreted element, so the per-component columns of an element (and its colouring
+  // roles) don't each re-parse and re-allocate the variant list for the same bytes. The data is
+  // immutable for a given config, so element index and byte offset are enough of a key. Only
+  // used on the UI thread - exports call data() from their own thread.
+  mutable int m_CachedElement = -1;
+  mutable uint64_t m_CachedOffset = ~0ULL;
+  mutable QVariantList m_CachedVariants;
+
+  // interpret the element's variants at the given byte offset, through the cache above.
+  QVariantList cachedVariants(int elIdx, const FormatElement &el, uint64_t offs, const byte *data,
+                              const byte *end) const
+  {
+    if(!GUIInvoke::onUIThread())
+      return el.GetVariants(data, end);
+
+    if(m_CachedElement != elIdx || m_CachedOffset != offs)
+    {
+      m_CachedElement = elIdx;
+      m_CachedOffset = offs;
+      m_CachedVariants = el.GetVariants(data, end);
+    }
+
+    return m_CachedVariants;
+  }
+
+  // set when buffers[0] in the config is paged - where to fetch pages from on demand.
+  ICaptureContext *m_PageCtx = NULL;
+  ResourceId m_PageBufferId;
+  uint64_t m_PageBaseOffset = 0;
+  // pages with a fetch in flight, so scrolling doesn't request the same page every paint.
+  QSet<uint64_t> m_PagesInFlight;
+
+  // fetch the page containing the given byte offset from the replay thread, then repaint its
+  // rows. data() shows placeholders for these rows until the page arrives.
+  void fetchPage(uint64_t offs)
+  {
+    if(m_PageCtx == NULL || config.buffers.isEmpty())
+      return;
+
+    BufferData *buf = config.buffers[0];
+
+    uint64_t page = offs - (offs % buf->pageByteSize);
+
+    if(page >= buf->pagedSize || m_PagesInFlight.contains(page))
+      return;
+
+    m_PagesInFlight.insert(page);
+
+    // keep the buffer alive until the fetch lands, in case the model is reset meanwhile
+    buf->ref();
+
+    ResourceId id = m_PageBufferId;
+    uint64_t byteOffset = m_PageBaseOffset + page;
+    uint64_t len = qMin(buf->pageByteSize, buf->pagedSize - page);
+
+    m_PageCtx->Replay().AsyncInvoke([this, buf, id, page, byteOffset, len](IReplayController *r) {
+      bytebuf contents = r->GetBufferData(id, byteOffset, len);
+
+      GUIInvoke::call(view, [this, buf, page, contents]() mutable {
+        // only insert the page if we're still displaying the same paged buffer - the model may
+        // have been reset while the fetch was in flight.
+        if(m_PageCtx && !config.buffers.isEmpty() && config.buffers[0] == buf && buf->paged)
+        {
+          buf->insertPage(page, contents);
+
+          uint32_t firstRow = uint32_t(page / buf->stride);
+          uint32_t lastRow = qMin(config.numRows, firstRow + BufferData::PageRowCount);
+
+          if(lastRow > firstRow)
+            emit dataChanged(index(firstRow, 0), index(lastRow - 1, totalColumnCount - 1));
+        }
+
+        m_PagesInFlight.remove(page);
+        buf->deref();
+      });
+    });
+  }
+
   // Internal cached data, generated by cacheColumns() from endReset().
   // Only accessible to main UI thread
 
@@ -2152,7 +2302,36 @@ void BufferViewer::OnEventChanged(uint32_t eventId)
         if(len == UINT64_MAX)
           len = 0;
 
-        buf->storage = r->GetBufferData(m_BufferID, m_ByteOffset, len);
+        // work out how large the view is, so we can decide whether to page it. The tight stride
+        // here matches the one calculated when the data arrives back on the UI thread.
+        size_t stride = 0;
+        for(const FormatElement &el : bufdata->vsinConfig.columns)
+          stride += el.byteSize();
+        stride = qMax((size_t)1, stride);
+
+        uint64_t viewLen = len;
+
+        BufferDescription *bufDesc = m_Ctx.GetBuffer(m_BufferID);
+        if(bufDesc && (viewLen == 0 || m_ByteOffset + viewLen > bufDesc->length))
+          viewLen = bufDesc->length - qMin(bufDesc->length, m_ByteOffset);
+
+        const uint64_t pageByteSize = uint64_t(BufferData::PageRowCount) * stride;
+
+        if(viewLen > pageByteSize * BufferData::MaxResidentPages)
+        {
+          // large buffers are paged in on demand as they're scrolled rather than fetched up
+          // front - just grab the first page now.
+          buf->paged = true;
+          buf->pagedSize = viewLen;
+          buf->pageByteSize = pageByteSize;
+
+          bytebuf firstPage = r->GetBufferData(m_BufferID, m_ByteOffset, pageByteSize);
+          buf->insertPage(0, firstPage);
+        }
+        else
+        {
+          buf->storage = r->GetBufferData(m_BufferID, m_ByteOffset, len);
+        }
       }
       else
       {
@@ -2184,6 +2363,9 @@ void BufferViewer::OnEventChanged(uint32_t eventId)
       m_ModelVSOut->endReset(bufdata->vsoutConfig);
       m_ModelGSOut->endReset(bufdata->gsoutConfig);
 
+      if(buf && buf->paged)
+        m_ModelVSIn->setPageSource(m_Ctx, m_BufferID, m_ByteOffset);
+
       m_PostVS = bufdata->postVS;
       m_PostGS = bufdata->postGS;
 
@@ -2356,31 +2538,18 @@ void BufferViewer::calcBoundingData(CalcBoundingBoxData &bbox)
           if(!el->perinstance)
             bytes += d.stride * idx;
 
-          QVariantList list = el->GetVariants(bytes, d.end);
+          // interpret directly to floats - this loop touches every row of every column, and
+          // going through QVariant allocation here dominates the fill time for large meshes.
+          float fvals[4];
+          uint32_t compCount = el->GetFloats(bytes, d.end, fvals);
 
-          for(int comp = 0; comp < 4 && comp < list.count(); comp++)
+          for(uint32_t comp = 0; comp < compCount; comp++)
           {
-            const QVariant &v = list[comp];
-
-            QMetaType::Type vt = GetVariantMetatype(v);
-
-            float fval = 0.0f;
-
-            if(vt == QMetaType::Double)
-              fval = (float)v.toDouble();
-            else if(vt == QMetaType::Float)
-              fval = v.toFloat();
-            else if(vt == QMetaType::UInt || vt == QMetaType::UShort || vt == QMetaType::UChar)
-              fval = (float)v.toUInt();
-            else if(vt == QMetaType::Int || vt == QMetaType::Short || vt == QMetaType::SChar)
-              fval = (float)v.toInt();
-            else
-              continue;
-
-            if(qIsFinite(fval))
+            // non-numeric components come back as NaN
+            if(qIsFinite(fvals[comp]))
             {
-              minOut[comp] = qMin(minOut[comp], fval);
-              maxOut[comp] = qMax(maxOut[comp], fval);
+              minOut[comp] = qMin(minOut[comp], fvals[comp]);
+              maxOut[comp] = qMax(maxOut[comp], fvals[comp]);
             }
           }
         }
@@ -3275,9 +3444,29 @@ void BufferViewer::exportData(const BufferExport &params)
 
       if(!m_MeshView)
       {
-        // this is the simplest possible case, we just dump the contents of the first buffer, as
-        // it's tightly packed
-        f->write((const char *)config.buffers[0]->data(), int(config.buffers[0]->size()));
+        BufferData *buf = config.buffers[0];
+
+        if(buf->paged)
+        {
+          // the resident pages only cover what's been displayed, so stream the contents through
+          // in page-sized chunks rather than fetching the whole buffer into memory. The chunk
+          // lives outside the loop so every fetch re-uses one allocation.
+          bytebuf chunk;
+          for(uint64_t offs = 0; offs < buf->pagedSize; offs += buf->pageByteSize)
+          {
+            uint64_t chunkLen = qMin(buf->pageByteSize, buf->pagedSize - offs);
+            m_Ctx.Replay().BlockInvoke([this, offs, chunkLen, &chunk](IReplayController *r) {
+              r->GetBufferData(m_BufferID, m_ByteOffset + offs, chunkLen, chunk);
+            });
+            f->write((const char *)chunk.data(), int(chunk.size()));
+          }
+        }
+        else
+        {
+          // this is the simplest possible case, we just dump the contents of the first buffer, as
+          // it's tightly packed
+          f->write((const char *)buf->data(), int(buf->size()));
+        }
       }
       else
       {
@@ -3333,29 +3522,164 @@ void BufferViewer::exportData(const BufferExport &params)
       // this works identically no matter whether we're mesh view or what, we just iterate the
       // elements and call the model's data()
 
-      QTextStream s(f);
+      {
+        QTextStream s(f);
+
+        for(int i = 0; i < model->columnCount(); i++)
+        {
+          s << model->headerData(i, Qt::Horizontal, Qt::DisplayRole).toString();
+
+          if(i + 1 < model->columnCount())
+            s << ", ";
+        }
+
+        s << "\n";
+      }
+
+      // for a paged raw buffer view the data() lookups below only see resident pages, so page
+      // the contents in as we go. The insert happens on the UI thread via blockcall, since
+      // pages are only ever mutated there.
+      BufferData *pagedBuf = NULL;
+      const BufferConfiguration &config = model->getConfig();
+      if(!m_MeshView && !config.buffers.isEmpty() && config.buffers[0]->paged)
+        pagedBuf = config.buffers[0];
+
+      const int rowCount = model->rowCount();
+      const int colCount = model->columnCount();
+
+      // formatting every cell through data() dominates large exports, so rows are processed in
+      // page-sized batches by a pool of worker threads. Two batches are in flight at once: while
+      // the workers format one, this thread writes the previous batch's text to disk and pages in
+      // the data for the next. That bounds memory to two batches of text regardless of row count,
+      // and keeps at most two pages live for a paged buffer - safely inside the residency limit
+      // so a page can't be evicted while a worker is still reading it.
+      const int batchRows = (int)BufferData::PageRowCount;
+
+      const int workerCount = qBound(1, QThread::idealThreadCount(), 16);
+
+      struct FormatBatch
+      {
+        int firstRow = 0;
+        int numRows = 0;
+        QVector<QByteArray> text;
+      } batches[2];
+
+      batches[0].text.resize(workerCount);
+      batches[1].text.resize(workerCount);
+
+      // the batch the workers should format next. Updated before their start semaphore is
+      // released, and only read by the workers until they signal completion. NULL tells them to
+      // exit
+      FormatBatch *curBatch = NULL;
+
+      QSemaphore workStart, workDone;
+
+      QVector<LambdaThread *> workers;
 
-      for(int i = 0; i < model->columnCount(); i++)
+      for(int w = 0; w < workerCount; w++)
       {
-        s << model->headerData(i, Qt::Horizontal, Qt::DisplayRole).toString();
+        LambdaThread *worker = new LambdaThread(
+            [model, colCount, workerCount, w, &curBatch, &workStart, &workDone]() {
+              for(;;)
+              {
+                workStart.acquire();
+
+                if(curBatch == NULL)
+                {
+                  workDone.release();
+                  return;
+                }
+
+                // each worker takes a contiguous slice of the batch, so concatenating the
+                // workers' text in order preserves row order
+                int sliceRows = (curBatch->numRows + workerCount - 1) / workerCount;
+                int first = curBatch->firstRow + w * sliceRows;
+                int last = qMin(curBatch->firstRow + curBatch->numRows, first + sliceRows);
+
+                QByteArray &text = curBatch->text[w];
+                text.clear();
 
-        if(i + 1 < model->columnCount())
-          s << ", ";
+                QTextStream s(&text, QIODevice::WriteOnly);
+
+                for(int row = first; row < last; row++)
+                {
+                  for(int col = 0; col < colCount; col++)
+                  {
+                    s << model->data(model->index(row, col), Qt::DisplayRole).toString();
+
+                    if(col + 1 < colCount)
+                      s << ", ";
+                  }
+
+                  s << "\n";
+                }
+
+                s.flush();
+
+                workDone.release();
+              }
+            });
+        worker->start();
+        workers.push_back(worker);
       }
 
-      s << "\n";
+      FormatBatch *writeBatch = NULL;
 
-      for(int row = 0; row < model->rowCount(); row++)
+      // re-used across fetches - insertPage swaps the old page's storage back into this, so the
+      // evicted allocation gets recycled for the next fetch.
+      bytebuf contents;
+
+      for(int firstRow = 0; firstRow < rowCount || writeBatch; firstRow += batchRows)
       {
-        for(int col = 0; col < model->columnCount(); col++)
+        FormatBatch *formatBatch = NULL;
+
+        if(firstRow < rowCount)
         {
-          s << model->data(model->index(row, col), Qt::DisplayRole).toString();
+          if(pagedBuf)
+          {
+            uint64_t page = uint64_t(firstRow) * pagedBuf->stride;
+            uint64_t pageLen = qMin(pagedBuf->pageByteSize,
+                                    pagedBuf->pagedSize - qMin(pagedBuf->pagedSize, page));
 
-          if(col + 1 < model->columnCount())
-            s << ", ";
+            m_Ctx.Replay().BlockInvoke([this, page, pageLen, &contents](IReplayController *r) {
+              r->GetBufferData(m_BufferID, m_ByteOffset + page, pageLen, contents);
+            });
+
+            GUIInvoke::blockcall(this, [pagedBuf, page, &contents]() {
+              pagedBuf->insertPage(page, contents);
+            });
+          }
+
+          formatBatch = (writeBatch == &batches[0]) ? &batches[1] : &batches[0];
+          formatBatch->firstRow = firstRow;
+          formatBatch->numRows = qMin(batchRows, rowCount - firstRow);
+
+          curBatch = formatBatch;
+          workStart.release(workerCount);
         }
 
-        s << "\n";
+        // write the previous batch's text while the workers format the new one
+        if(writeBatch)
+        {
+          for(const QByteArray &text : writeBatch->text)
+            f->write(text);
+        }
+
+        if(formatBatch)
+          workDone.acquire(workerCount);
+
+        writeBatch = formatBatch;
+      }
+
+      // shut the workers down
+      curBatch = NULL;
+      workStart.release(workerCount);
+      workDone.acquire(workerCount);
+
+      for(LambdaThread *worker : workers)
+      {
+        worker->wait();
+        worker->deleteLater();
       }
     }
 
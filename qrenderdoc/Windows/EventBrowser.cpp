@@ -135,6 +135,7 @@ EventBrowser::EventBrowser(ICaptureContext &ctx, QWidget *parent)
   QObject::connect(ui->closeFind, &QToolButton::clicked, this, &EventBrowser::on_HideFindJump);
   QObject::connect(ui->closeJump, &QToolButton::clicked, this, &EventBrowser::on_HideFindJump);
   QObject::connect(ui->events, &RDTreeWidget::keyPress, this, &EventBrowser::events_keyPress);
+  QObject::connect(ui->events, &RDTreeWidget::itemExpanded, this, &EventBrowser::PopulateDeferred);
   ui->jumpStrip->hide();
   ui->findStrip->hide();
   ui->bookmarkStrip->hide();
@@ -250,6 +251,11 @@ void EventBrowser::OnCaptureLoaded()
   QPair<uint32_t, uint32_t> lastEIDDraw = AddDrawcalls(frame, m_Ctx.CurDrawcalls());
   frame->setTag(QVariant::fromValue(EventItemTag(0, lastEIDDraw.first)));
 
+  m_FindIndex.clear();
+  BuildFindIndex(m_Ctx.CurDrawcalls());
+  m_FindIndexHiddenValid = false;
+  m_FindCacheValid = false;
+
   ui->events->addTopLevelItem(frame);
 
   ui->events->expandItem(frame);
@@ -270,6 +276,15 @@ void EventBrowser::OnCaptureClosed()
 {
   clearBookmarks();
 
+  m_DeferredChildren.clear();
+
+  m_FindIndex.clear();
+  m_FindIndexHidden.clear();
+  m_FindIndexHiddenValid = false;
+  m_FindCacheFilter = QString();
+  m_FindCacheMatches.clear();
+  m_FindCacheValid = false;
+
   ui->events->clear();
 
   ui->find->setEnabled(false);
@@ -358,7 +373,9 @@ QPair<uint32_t, uint32_t> EventBrowser::AddDrawcalls(RDTreeWidgetItem *parent,
     RDTreeWidgetItem *child = new RDTreeWidgetItem(
         {name, QString::number(d.eventId), QString::number(d.drawcallId), lit("---")});
 
-    QPair<uint32_t, uint32_t> last = AddDrawcalls(child, d.children);
+    // summarise the subtree from the drawcall data instead of recursing to create items - the
+    // child items are only built when this marker is first expanded.
+    QPair<uint32_t, uint32_t> last = GetLastEIDDraw(d.children);
     lastEID = last.first;
     lastDraw = last.second;
 
@@ -399,12 +416,143 @@ QPair<uint32_t, uint32_t> EventBrowser::AddDrawcalls(RDTreeWidgetItem *parent,
       }
     }
 
+    if(!d.children.isEmpty())
+    {
+      // placeholder child so the expander arrow shows - replaced by PopulateDeferred on the
+      // first expand.
+      child->addChild(new RDTreeWidgetItem({QString(), QString(), QString(), QString()}));
+      m_DeferredChildren[child] = &d.children;
+    }
+
     parent->addChild(child);
   }
 
   return qMakePair(lastEID, lastDraw);
 }
 
+QPair<uint32_t, uint32_t> EventBrowser::GetLastEIDDraw(const rdcarray<DrawcallDescription> &draws)
+{
+  uint lastEID = 0, lastDraw = 0;
+
+  // mirrors the visibility and 'set marker' logic in AddDrawcalls, but walks the drawcall data
+  // without creating any items.
+  for(int32_t i = 0; i < draws.count(); i++)
+  {
+    const DrawcallDescription &d = draws[i];
+
+    if(ShouldHide(d))
+      continue;
+
+    QPair<uint32_t, uint32_t> last = GetLastEIDDraw(d.children);
+    lastEID = last.first;
+    lastDraw = last.second;
+
+    if(lastEID == 0)
+    {
+      lastEID = d.eventId;
+      lastDraw = d.drawcallId;
+
+      if((d.flags & DrawFlags::SetMarker) && i + 1 < draws.count())
+        lastEID = draws[i + 1].eventId;
+    }
+  }
+
+  return qMakePair(lastEID, lastDraw);
+}
+
+void EventBrowser::BuildFindIndex(const rdcarray<DrawcallDescription> &draws)
+{
+  // index every drawcall regardless of the current hide settings - visibility is applied at query
+  // time by RefreshFindIndexVisibility() so it can't go stale against the settings.
+  for(int32_t i = 0; i < draws.count(); i++)
+  {
+    const DrawcallDescription &d = draws[i];
+
+    // identify the entry by the same EID the tree item would carry - the end of the range for
+    // markers with children.
+    uint32_t eid = d.eventId;
+
+    if(!d.children.isEmpty())
+    {
+      uint32_t lastEID = GetLastEIDDraw(d.children).first;
+      if(lastEID > 0)
+        eid = lastEID;
+    }
+    else if((d.flags & DrawFlags::SetMarker) && i + 1 < draws.count())
+    {
+      eid = draws[i + 1].eventId;
+    }
+
+    int entryIdx = m_FindIndex.count();
+
+    FindIndexEntry entry;
+    entry.eid = eid;
+    entry.descendantCount = 0;
+    entry.draw = &d;
+    entry.lowerName = QString(d.name).toLower();
+    m_FindIndex.push_back(entry);
+
+    if(!d.children.isEmpty())
+    {
+      BuildFindIndex(d.children);
+      m_FindIndex[entryIdx].descendantCount = m_FindIndex.count() - entryIdx - 1;
+    }
+  }
+}
+
+void EventBrowser::RefreshFindIndexVisibility()
+{
+  bool hideEmpty = m_Ctx.Config().EventBrowser_HideEmpty;
+  bool hideAPICalls = m_Ctx.Config().EventBrowser_HideAPICalls;
+
+  if(m_FindIndexHiddenValid && hideEmpty == m_FindIndexHideEmpty &&
+     hideAPICalls == m_FindIndexHideAPICalls)
+    return;
+
+  m_FindIndexHidden.fill(false, m_FindIndex.count());
+
+  for(int i = 0; i < m_FindIndex.count(); i++)
+  {
+    const FindIndexEntry &e = m_FindIndex[i];
+
+    if(ShouldHide(*e.draw))
+    {
+      // hiding a marker hides its whole subtree
+      for(int j = i; j <= i + e.descendantCount; j++)
+        m_FindIndexHidden[j] = true;
+
+      i += e.descendantCount;
+    }
+  }
+
+  m_FindIndexHideEmpty = hideEmpty;
+  m_FindIndexHideAPICalls = hideAPICalls;
+  m_FindIndexHiddenValid = true;
+}
+
+void EventBrowser::PopulateDeferred(RDTreeWidgetItem *item)
+{
+  auto it = m_DeferredChildren.find(item);
+  if(it == m_DeferredChildren.end())
+    return;
+
+  const rdcarray<DrawcallDescription> &draws = *it.value();
+  m_DeferredChildren.remove(item);
+
+  // remove the placeholder before batching in the real children. All the inserts are under one
+  // parent so endUpdate issues a single update rather than a model reset, which would collapse
+  // the expansion we're in the middle of.
+  item->clear();
+
+  ui->events->beginUpdate();
+  AddDrawcalls(item, draws);
+  ui->events->endUpdate();
+
+  // fill in durations if timings have already been fetched
+  if(!m_Times.empty())
+    SetDrawcallTimes(item, m_Times);
+}
+
 void EventBrowser::SetDrawcallTimes(RDTreeWidgetItem *node, const rdcarray<CounterResult> &results)
 {
   if(node == NULL)
@@ -443,14 +591,31 @@ void EventBrowser::SetDrawcallTimes(RDTreeWidgetItem *node, const rdcarray<Count
     return;
   }
 
-  for(int i = 0; i < node->childCount(); i++)
+  // marker nodes take the sum of their children. The children of collapsed markers may not have
+  // items yet, so the sum comes from the drawcall data rather than the child items.
+  const DrawcallDescription *draw = m_Ctx.GetDrawcall(node->tag().value<EventItemTag>().EID);
+
+  if(draw != NULL)
   {
-    SetDrawcallTimes(node->child(i), results);
+    duration = GetDrawTime(*draw);
+  }
+  else
+  {
+    // the frame node has no drawcall of its own - sum the whole frame
+    duration = 0.0;
 
-    double nd = node->child(i)->tag().value<EventItemTag>().duration;
+    for(const DrawcallDescription &d : m_Ctx.CurDrawcalls())
+    {
+      double f = GetDrawTime(d);
+      if(f >= 0)
+        duration += f;
+    }
+  }
 
-    if(nd > 0.0)
-      duration += nd;
+  if(!m_DeferredChildren.contains(node))
+  {
+    for(int i = 0; i < node->childCount(); i++)
+      SetDrawcallTimes(node->child(i), results);
   }
 
   double secs = duration;
@@ -496,7 +661,10 @@ void EventBrowser::on_timeDraws_clicked()
 
   ui->events->header()->showSection(COL_DURATION);
 
-  m_Ctx.Replay().AsyncInvoke([this](IReplayController *r) {
+  // counter fetches replay the whole frame several times - queue at background priority so that
+  // event changes and other interactive invokes made meanwhile aren't stuck behind it.
+  m_Ctx.Replay().AsyncInvoke(lit("TimeDrawcalls"), ReplayPriority::Background,
+                             [this](IReplayController *r) {
 
     m_Times = r->FetchCounters({GPUCounter::EventGPUDuration});
 
@@ -1183,6 +1351,18 @@ bool EventBrowser::FindEventNode(RDTreeWidgetItem *&found, RDTreeWidgetItem *par
     if(nEID == eventId && n->childCount() == 0)
       return true;
 
+    // populate deferred children along the search path, but only when the target event is inside
+    // this marker's range so that one search doesn't build out the whole tree.
+    if(m_DeferredChildren.contains(n))
+    {
+      EventItemTag tag = n->tag().value<EventItemTag>();
+
+      if(eventId >= tag.EID && eventId <= tag.lastEID)
+        PopulateDeferred(n);
+      else
+        continue;
+    }
+
     if(n->childCount() > 0)
     {
       bool exact = FindEventNode(found, n, eventId);
@@ -1237,7 +1417,7 @@ void EventBrowser::ClearFindIcons(RDTreeWidgetItem *parent)
     n->setTag(QVariant::fromValue(tag));
     RefreshIcon(n, tag);
 
-    if(n->childCount() > 0)
+    if(n->childCount() > 0 && !m_DeferredChildren.contains(n))
       ClearFindIcons(n);
   }
 }
@@ -1265,7 +1445,7 @@ int EventBrowser::SetFindIcons(RDTreeWidgetItem *parent, QString filter)
       results++;
     }
 
-    if(n->childCount() > 0)
+    if(n->childCount() > 0 && !m_DeferredChildren.contains(n))
     {
       results += SetFindIcons(n, filter);
     }
@@ -1279,7 +1459,61 @@ int EventBrowser::SetFindIcons(QString filter)
   if(filter.isEmpty())
     return 0;
 
-  return SetFindIcons(ui->events->topLevelItem(0), filter);
+  // icons can only be applied to items that exist, but the reported result count covers the
+  // whole frame - including the children of markers that haven't been expanded yet.
+  SetFindIcons(ui->events->topLevelItem(0), filter);
+
+  return CountEventMatches(filter);
+}
+
+const QVector<int> &EventBrowser::FindMatches(const QString &filter)
+{
+  QString lowered = filter.toLower();
+
+  if(m_FindCacheValid && lowered == m_FindCacheFilter)
+    return m_FindCacheMatches;
+
+  QVector<int> matches;
+
+  if(m_FindCacheValid && !m_FindCacheFilter.isEmpty() && lowered.contains(m_FindCacheFilter))
+  {
+    // the new filter contains the old one, so anything that matches it matched before too -
+    // refine the previous results rather than rescanning the whole index.
+    for(int idx : m_FindCacheMatches)
+    {
+      if(m_FindIndex[idx].lowerName.contains(lowered))
+        matches.push_back(idx);
+    }
+  }
+  else
+  {
+    for(int i = 0; i < m_FindIndex.count(); i++)
+    {
+      if(m_FindIndex[i].lowerName.contains(lowered))
+        matches.push_back(i);
+    }
+  }
+
+  m_FindCacheFilter = lowered;
+  m_FindCacheMatches = matches;
+  m_FindCacheValid = true;
+
+  return m_FindCacheMatches;
+}
+
+int EventBrowser::CountEventMatches(const QString &filter)
+{
+  RefreshFindIndexVisibility();
+
+  int results = 0;
+
+  for(int idx : FindMatches(filter))
+  {
+    if(!m_FindIndexHidden[idx])
+      results++;
+  }
+
+  return results;
 }
 
 RDTreeWidgetItem *EventBrowser::FindNode(RDTreeWidgetItem *parent, QString filter, uint32_t after)
@@ -1305,30 +1539,32 @@ RDTreeWidgetItem *EventBrowser::FindNode(RDTreeWidgetItem *parent, QString filte
   return NULL;
 }
 
-int EventBrowser::FindEvent(RDTreeWidgetItem *parent, QString filter, uint32_t after, bool forward)
+int EventBrowser::FindEventBackward(int begin, int end, const QString &lowered, uint32_t after)
 {
-  if(parent == NULL)
-    return -1;
+  // mirror the old recursive walk: the last sibling at each level is visited first, but a marker
+  // is checked before its children.
+  QVector<int> siblings;
 
-  for(int i = forward ? 0 : parent->childCount() - 1; i >= 0 && i < parent->childCount();
-      i += forward ? 1 : -1)
+  for(int i = begin; i < end; i++)
   {
-    auto n = parent->child(i);
+    siblings.push_back(i);
+    i += m_FindIndex[i].descendantCount;
+  }
 
-    uint eid = n->tag().value<EventItemTag>().lastEID;
+  for(int s = siblings.count() - 1; s >= 0; s--)
+  {
+    int i = siblings[s];
+    const FindIndexEntry &e = m_FindIndex[i];
 
-    bool matchesAfter = (forward && eid > after) || (!forward && eid < after);
+    if(m_FindIndexHidden[i])
+      continue;
 
-    if(matchesAfter)
-    {
-      QString name = n->text(COL_NAME);
-      if(name.contains(filter, Qt::CaseInsensitive))
-        return (int)eid;
-    }
+    if(e.eid < after && e.lowerName.contains(lowered))
+      return (int)e.eid;
 
-    if(n->childCount() > 0)
+    if(e.descendantCount > 0)
     {
-      int found = FindEvent(n, filter, after, forward);
+      int found = FindEventBackward(i + 1, i + 1 + e.descendantCount, lowered, after);
 
       if(found > 0)
         return found;
@@ -1343,7 +1579,23 @@ int EventBrowser::FindEvent(QString filter, uint32_t after, bool forward)
   if(!m_Ctx.IsCaptureLoaded())
     return 0;
 
-  return FindEvent(ui->events->topLevelItem(0), filter, after, forward);
+  // search the index rather than the item tree, so matches inside markers that haven't been
+  // expanded yet are still found - SelectEvent populates the path to whatever we return.
+  RefreshFindIndexVisibility();
+
+  if(forward)
+  {
+    // the cached matches are in pre-order, the same order the old recursive walk visited draws
+    for(int idx : FindMatches(filter))
+    {
+      if(!m_FindIndexHidden[idx] && m_FindIndex[idx].eid > after)
+        return (int)m_FindIndex[idx].eid;
+    }
+
+    return -1;
+  }
+
+  return FindEventBackward(0, m_FindIndex.count(), filter.toLower(), after);
 }
 
 void EventBrowser::Find(bool forward)
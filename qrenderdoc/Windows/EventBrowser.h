@@ -98,6 +98,8 @@ private:
   bool ShouldHide(const DrawcallDescription &drawcall);
   QPair<uint32_t, uint32_t> AddDrawcalls(RDTreeWidgetItem *parent,
                                          const rdcarray<DrawcallDescription> &draws);
+  QPair<uint32_t, uint32_t> GetLastEIDDraw(const rdcarray<DrawcallDescription> &draws);
+  void PopulateDeferred(RDTreeWidgetItem *item);
   void SetDrawcallTimes(RDTreeWidgetItem *node, const rdcarray<CounterResult> &results);
 
   void ExpandNode(RDTreeWidgetItem *node);
@@ -116,7 +118,12 @@ private:
   bool hasBookmark(RDTreeWidgetItem *node);
 
   RDTreeWidgetItem *FindNode(RDTreeWidgetItem *parent, QString filter, uint32_t after);
-  int FindEvent(RDTreeWidgetItem *parent, QString filter, uint32_t after, bool forward);
+
+  void BuildFindIndex(const rdcarray<DrawcallDescription> &draws);
+  void RefreshFindIndexVisibility();
+  const QVector<int> &FindMatches(const QString &filter);
+  int CountEventMatches(const QString &filter);
+  int FindEventBackward(int begin, int end, const QString &lowered, uint32_t after);
   int FindEvent(QString filter, uint32_t after, bool forward);
   void Find(bool forward);
 
@@ -133,6 +140,39 @@ private:
 
   rdcarray<CounterResult> m_Times;
 
+  // markers whose child items haven't been created yet - they hold a single placeholder child so
+  // the expander arrow shows, and the real items are built from the referenced drawcalls when the
+  // marker is first expanded. This keeps the item count (and capture open time) proportional to
+  // what's actually been expanded rather than the total event count.
+  QHash<RDTreeWidgetItem *, const rdcarray<DrawcallDescription> *> m_DeferredChildren;
+
+  // flat pre-order index over the frame's drawcalls, built once at capture load so the find and
+  // filter queries don't re-walk the tree and re-convert every name on each keystroke.
+  struct FindIndexEntry
+  {
+    // the same EID the tree item for this drawcall carries - the end of the range for markers
+    uint32_t eid;
+    // number of index entries under this one, so a hidden marker's subtree can be skipped
+    int descendantCount;
+    const DrawcallDescription *draw;
+    // name lower-cased once at build time, so matching is a plain case-sensitive search
+    QString lowerName;
+  };
+  QVector<FindIndexEntry> m_FindIndex;
+
+  // per-entry ShouldHide() results, including hiding inherited from ancestor markers. Cached
+  // since they only change when the hide settings do.
+  QVector<bool> m_FindIndexHidden;
+  bool m_FindIndexHiddenValid = false;
+  bool m_FindIndexHideEmpty = false;
+  bool m_FindIndexHideAPICalls = false;
+
+  // matches of the most recent filter. Typing more characters can only narrow the previous
+  // result set, so each keystroke usually refines this instead of rescanning the whole index.
+  QString m_FindCacheFilter;
+  QVector<int> m_FindCacheMatches;
+  bool m_FindCacheValid = false;
+
   QTimer *m_FindHighlight;
 
   FlowLayout *m_BookmarkStripLayout;
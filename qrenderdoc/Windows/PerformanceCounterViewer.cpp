@@ -194,79 +194,151 @@ void PerformanceCounterViewer::CaptureCounters()
 
   ANALYTIC_SET(UIFeatures.PerformanceCounters, true);
 
-  bool done = false;
-  m_Ctx.Replay().AsyncInvoke([this, &done](IReplayController *controller) -> void {
-    rdcarray<GPUCounter> counters;
-    counters.resize(m_SelectedCounters.size());
+  // Split the selection into batches that stream into the table as each one completes, so the
+  // hottest draws can be sorted and triaged while the rest of the counters are still collecting.
+  // All generic counters go into one batch - the drivers collect every enabled generic counter in
+  // a single replay pass, so splitting them up would only multiply the number of replays. Vendor
+  // counters need multiple passes anyway, so they stream in small groups.
+  QList<GPUCounter> genericCounters, vendorCounters;
+  for(GPUCounter counter : m_SelectedCounters)
+  {
+    if(IsGenericCounter(counter))
+      genericCounters.push_back(counter);
+    else
+      vendorCounters.push_back(counter);
+  }
 
-    QMap<GPUCounter, CounterDescription> counterDescriptions;
+  QList<QList<GPUCounter>> batches;
 
-    for(int i = 0; i < m_SelectedCounters.size(); ++i)
-    {
-      counters[i] = (GPUCounter)m_SelectedCounters[i];
-      counterDescriptions.insert(counters[i], controller->DescribeCounter(counters[i]));
-    }
+  if(!genericCounters.isEmpty())
+    batches.push_back(genericCounters);
 
-    QMap<GPUCounter, int> counterIndex;
-    for(int i = 0; i < m_SelectedCounters.size(); ++i)
-    {
-      counterIndex.insert((GPUCounter)m_SelectedCounters[i], i);
-    }
+  const int vendorBatchSize = 4;
+  for(int i = 0; i < vendorCounters.count(); i += vendorBatchSize)
+    batches.push_back(vendorCounters.mid(i, vendorBatchSize));
 
-    const rdcarray<CounterResult> results = controller->FetchCounters(counters);
+  m_FetchGeneration++;
+  m_FirstResultsArrived = false;
+  m_EventItems.clear();
 
-    GUIInvoke::call(this, [this, results, counterDescriptions, counterIndex]() {
-      ui->counterResults->clear();
+  if(batches.isEmpty())
+    return;
 
-      QStringList headers;
-      headers << lit("EID");
-      for(const CounterDescription &cd : counterDescriptions)
-      {
-        headers << cd.name;
-      }
+  QMap<GPUCounter, int> counterIndex;
+  for(int i = 0; i < m_SelectedCounters.size(); ++i)
+    counterIndex.insert((GPUCounter)m_SelectedCounters[i], i);
 
-      QMap<uint32_t, int> eventIdToRow;
-      for(const CounterResult &result : results)
-      {
-        if(eventIdToRow.contains(result.eventId))
-          continue;
-        eventIdToRow.insert(result.eventId, eventIdToRow.size());
-      }
+  ui->captureCounters->setEnabled(false);
 
-      ui->counterResults->setColumnCount(headers.size());
-      ui->counterResults->setHorizontalHeaderLabels(headers);
-      ui->counterResults->setRowCount(eventIdToRow.size());
+  FetchBatch(batches, 0, counterIndex, m_FetchGeneration);
 
-      ui->counterResults->setSortingEnabled(false);
+  // block only until the first batch of results has landed in the table - the remaining batches
+  // stream in the background while these results can already be sorted and inspected.
+  ShowProgressDialog(this, tr("Capturing counters"),
+                     [this]() -> bool { return m_FirstResultsArrived; });
+}
 
-      for(int i = 0; i < (int)results.size(); ++i)
-      {
-        int row = eventIdToRow[results[i].eventId];
+void PerformanceCounterViewer::FetchBatch(const QList<QList<GPUCounter>> &batches, int batchIdx,
+                                          const QMap<GPUCounter, int> &counterIndex, int generation)
+{
+  const QList<GPUCounter> batch = batches[batchIdx];
+  const bool first = (batchIdx == 0);
+  const bool last = (batchIdx == batches.count() - 1);
+
+  // only one batch is in the queue at a time (the next is chained once this one lands), and it's
+  // tagged so that restarting a collection cancels a stale batch still waiting in the queue.
+  m_Ctx.Replay().AsyncInvoke(
+      lit("FetchCounters"), ReplayPriority::Background,
+      [this, batches, batchIdx, batch, counterIndex, first, last,
+       generation](IReplayController *controller) -> void {
+        rdcarray<GPUCounter> counters;
+        for(GPUCounter counter : batch)
+          counters.push_back(counter);
+
+        QMap<GPUCounter, CounterDescription> counterDescriptions;
+        for(GPUCounter counter : batch)
+          counterDescriptions.insert(counter, controller->DescribeCounter(counter));
+
+        // the first batch lays out every column up front, so it describes the full selection
+        if(first)
+        {
+          for(GPUCounter counter : counterIndex.keys())
+          {
+            if(!counterDescriptions.contains(counter))
+              counterDescriptions.insert(counter, controller->DescribeCounter(counter));
+          }
+        }
 
-        ui->counterResults->setItem(row, 0,
-                                    new CustomSortedTableItem(QString::number(results[i].eventId),
-                                                              SortValue(results[i].eventId)));
+        const rdcarray<CounterResult> results = controller->FetchCounters(counters);
 
-        ui->counterResults->setItem(
-            row, counterIndex[results[i].counter] + 1,
-            MakeCounterResultItem(results[i], counterDescriptions[results[i].counter]));
+        GUIInvoke::call(this, [this, batches, batchIdx, results, counterDescriptions, counterIndex,
+                               first, last, generation]() {
+          // a new collection started (or the capture closed) while this batch was in flight
+          if(generation != m_FetchGeneration)
+            return;
 
-        ui->counterResults->item(row, 0)->setData(Qt::UserRole, results[i].eventId);
-      }
+          if(first)
+          {
+            m_FirstResultsArrived = true;
 
-      ui->counterResults->setSortingEnabled(true);
+            ui->counterResults->clear();
+            m_EventItems.clear();
 
-      ui->counterResults->resizeColumnsToContents();
-    });
+            QStringList headers;
+            headers << lit("EID");
+            for(GPUCounter counter : m_SelectedCounters)
+              headers << counterDescriptions[counter].name;
+
+            ui->counterResults->setColumnCount(headers.size());
+            ui->counterResults->setHorizontalHeaderLabels(headers);
+            ui->counterResults->setRowCount(0);
+          }
 
-    done = true;
-  });
+          ui->counterResults->setSortingEnabled(false);
 
-  ShowProgressDialog(this, tr("Capturing counters"), [&done]() -> bool { return done; });
+          for(const CounterResult &result : results)
+          {
+            QTableWidgetItem *eidItem = m_EventItems.value(result.eventId, NULL);
+
+            if(!eidItem)
+            {
+              int row = ui->counterResults->rowCount();
+              ui->counterResults->insertRow(row);
+
+              eidItem = new CustomSortedTableItem(QString::number(result.eventId),
+                                                  SortValue(result.eventId));
+              eidItem->setData(Qt::UserRole, result.eventId);
+
+              ui->counterResults->setItem(row, 0, eidItem);
+              m_EventItems.insert(result.eventId, eidItem);
+            }
+
+            // locate the row through the EID item - the user may have re-sorted the table since
+            // an earlier batch inserted it.
+            ui->counterResults->setItem(
+                eidItem->row(), counterIndex[result.counter] + 1,
+                MakeCounterResultItem(result, counterDescriptions[result.counter]));
+          }
+
+          ui->counterResults->setSortingEnabled(true);
+
+          if(first)
+            ui->counterResults->resizeColumnsToContents();
+
+          if(last)
+            ui->captureCounters->setEnabled(m_Ctx.IsCaptureLoaded());
+          else
+            FetchBatch(batches, batchIdx + 1, counterIndex, generation);
+        });
+      });
 }
 
 void PerformanceCounterViewer::OnCaptureClosed()
 {
+  // drop any counter batches still in flight
+  m_FetchGeneration++;
+  m_EventItems.clear();
+
   ui->captureCounters->setEnabled(false);
   ui->saveCSV->setEnabled(false);
 
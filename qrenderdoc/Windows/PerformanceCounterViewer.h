@@ -58,8 +58,22 @@ private:
   QTableWidgetItem *MakeCounterResultItem(const CounterResult &result,
                                           const CounterDescription &description);
 
+  void FetchBatch(const QList<QList<GPUCounter>> &batches, int batchIdx,
+                  const QMap<GPUCounter, int> &counterIndex, int generation);
+
   QList<GPUCounter> m_SelectedCounters;
 
+  // maps an event to its EID cell, so counter results streaming in batch-by-batch can find their
+  // row even after the user has re-sorted the table mid-collection.
+  QMap<uint32_t, QTableWidgetItem *> m_EventItems;
+
+  // bumped whenever a new collection starts or the capture closes, so results from a stale
+  // collection that are still in flight get dropped instead of landing in the new table.
+  int m_FetchGeneration = 0;
+
+  // set once the first batch of results has arrived and the table is usable.
+  bool m_FirstResultsArrived = false;
+
   Ui::PerformanceCounterViewer *ui;
   ICaptureContext &m_Ctx;
   void CaptureCounters();
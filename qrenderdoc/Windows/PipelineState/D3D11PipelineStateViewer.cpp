@@ -824,6 +824,7 @@ void D3D11PipelineStateViewer::clearState()
 {
   m_VBNodes.clear();
   m_EmptyNodes.clear();
+  m_StaleShaderStages = 0;
 
   ui->iaLayouts->clear();
   ui->iaBuffers->clear();
@@ -1157,6 +1158,60 @@ void D3D11PipelineStateViewer::setShaderState(const D3D11Pipe::Shader &stage, RD
   classes->parentWidget()->setVisible(!stage.classInstances.empty());
 }
 
+void D3D11PipelineStateViewer::setShaderStageState(int tabIndex)
+{
+  if(!m_Ctx.IsCaptureLoaded())
+    return;
+
+  // map from a stage tab index to the shader stage shown on it, skipping fixed-function tabs
+  int stage = -1;
+  switch(tabIndex)
+  {
+    case 1: stage = 0; break;    // vertex shader
+    case 2: stage = 1; break;    // hull shader
+    case 3: stage = 2; break;    // domain shader
+    case 4: stage = 3; break;    // geometry shader
+    case 6: stage = 4; break;    // pixel shader
+    case 8: stage = 5; break;    // compute shader
+    default: return;
+  }
+
+  if((m_StaleShaderStages & (1U << stage)) == 0)
+    return;
+
+  m_StaleShaderStages &= ~(1U << stage);
+
+  const D3D11Pipe::State &state = *m_Ctx.CurD3D11PipelineState();
+
+  switch(stage)
+  {
+    case 0:
+      setShaderState(state.vertexShader, ui->vsShader, ui->vsResources, ui->vsSamplers,
+                     ui->vsCBuffers, ui->vsClasses);
+      break;
+    case 1:
+      setShaderState(state.hullShader, ui->hsShader, ui->hsResources, ui->hsSamplers,
+                     ui->hsCBuffers, ui->hsClasses);
+      break;
+    case 2:
+      setShaderState(state.domainShader, ui->dsShader, ui->dsResources, ui->dsSamplers,
+                     ui->dsCBuffers, ui->dsClasses);
+      break;
+    case 3:
+      setShaderState(state.geometryShader, ui->gsShader, ui->gsResources, ui->gsSamplers,
+                     ui->gsCBuffers, ui->gsClasses);
+      break;
+    case 4:
+      setShaderState(state.pixelShader, ui->psShader, ui->psResources, ui->psSamplers,
+                     ui->psCBuffers, ui->psClasses);
+      break;
+    case 5:
+      setShaderState(state.computeShader, ui->csShader, ui->csResources, ui->csSamplers,
+                     ui->csCBuffers, ui->csClasses);
+      break;
+  }
+}
+
 void D3D11PipelineStateViewer::setState()
 {
   if(!m_Ctx.IsCaptureLoaded())
@@ -1497,18 +1552,10 @@ void D3D11PipelineStateViewer::setState()
   ui->iaBuffers->endUpdate();
   ui->iaBuffers->verticalScrollBar()->setValue(vs);
 
-  setShaderState(state.vertexShader, ui->vsShader, ui->vsResources, ui->vsSamplers, ui->vsCBuffers,
-                 ui->vsClasses);
-  setShaderState(state.geometryShader, ui->gsShader, ui->gsResources, ui->gsSamplers,
-                 ui->gsCBuffers, ui->gsClasses);
-  setShaderState(state.hullShader, ui->hsShader, ui->hsResources, ui->hsSamplers, ui->hsCBuffers,
-                 ui->hsClasses);
-  setShaderState(state.domainShader, ui->dsShader, ui->dsResources, ui->dsSamplers, ui->dsCBuffers,
-                 ui->dsClasses);
-  setShaderState(state.pixelShader, ui->psShader, ui->psResources, ui->psSamplers, ui->psCBuffers,
-                 ui->psClasses);
-  setShaderState(state.computeShader, ui->csShader, ui->csResources, ui->csSamplers, ui->csCBuffers,
-                 ui->csClasses);
+  // mark every shader stage's tab as stale, then populate only the one that's visible. The others
+  // are populated on demand when their tab is selected, since only one can be seen at a time.
+  m_StaleShaderStages = 0x3f;
+  setShaderStageState(ui->stagesTabs->currentIndex());
 
   QToolButton *shaderButtons[] = {
       ui->vsShaderViewButton, ui->hsShaderViewButton, ui->dsShaderViewButton,
@@ -2233,6 +2280,9 @@ void D3D11PipelineStateViewer::on_iaBuffers_mouseMove(QMouseEvent *e)
 void D3D11PipelineStateViewer::on_pipeFlow_stageSelected(int index)
 {
   ui->stagesTabs->setCurrentIndex(index);
+
+  // if this stage's tab was skipped in the last state update, fill it in now
+  setShaderStageState(index);
 }
 
 void D3D11PipelineStateViewer::vertex_leave(QEvent *e)
@@ -90,6 +90,7 @@ private:
   void clearShaderState(RDLabel *shader, RDTreeWidget *tex, RDTreeWidget *samp,
                         RDTreeWidget *cbuffer, RDTreeWidget *classes);
   void setState();
+  void setShaderStageState(int tabIndex);
   void clearState();
 
   QVariantList exportViewHTML(const D3D11Pipe::View &view, int i, ShaderReflection *refl,
@@ -118,4 +119,10 @@ private:
   QList<RDTreeWidgetItem *> m_VBNodes;
   // list of empty VB nodes that shouldn't be highlighted on hover
   QList<RDTreeWidgetItem *> m_EmptyNodes;
+
+  // bitmask of shader stages (VS,HS,DS,GS,PS,CS) whose tab contents are stale. Populating every
+  // stage's widgets is the most expensive part of a state update on binding-heavy events, so
+  // setState() only fills in the visible tab and the rest are populated on demand when their tab
+  // is first selected.
+  uint32_t m_StaleShaderStages = 0;
 };
@@ -864,6 +864,7 @@ void D3D12PipelineStateViewer::clearState()
 {
   m_VBNodes.clear();
   m_EmptyNodes.clear();
+  m_StaleShaderStages = 0;
 
   ui->iaLayouts->clear();
   ui->iaBuffers->clear();
@@ -1226,6 +1227,60 @@ void D3D12PipelineStateViewer::setShaderState(const D3D12Pipe::Shader &stage, RD
   cbuffers->verticalScrollBar()->setValue(vs);
 }
 
+void D3D12PipelineStateViewer::setShaderStageState(int tabIndex)
+{
+  if(!m_Ctx.IsCaptureLoaded())
+    return;
+
+  // map from a stage tab index to the shader stage shown on it, skipping fixed-function tabs
+  int stage = -1;
+  switch(tabIndex)
+  {
+    case 1: stage = 0; break;    // vertex shader
+    case 2: stage = 1; break;    // hull shader
+    case 3: stage = 2; break;    // domain shader
+    case 4: stage = 3; break;    // geometry shader
+    case 6: stage = 4; break;    // pixel shader
+    case 8: stage = 5; break;    // compute shader
+    default: return;
+  }
+
+  if((m_StaleShaderStages & (1U << stage)) == 0)
+    return;
+
+  m_StaleShaderStages &= ~(1U << stage);
+
+  const D3D12Pipe::State &state = *m_Ctx.CurD3D12PipelineState();
+
+  switch(stage)
+  {
+    case 0:
+      setShaderState(state.vertexShader, ui->vsShader, ui->vsRootSig, ui->vsResources,
+                     ui->vsSamplers, ui->vsCBuffers, ui->vsUAVs);
+      break;
+    case 1:
+      setShaderState(state.hullShader, ui->hsShader, ui->hsRootSig, ui->hsResources,
+                     ui->hsSamplers, ui->hsCBuffers, ui->hsUAVs);
+      break;
+    case 2:
+      setShaderState(state.domainShader, ui->dsShader, ui->dsRootSig, ui->dsResources,
+                     ui->dsSamplers, ui->dsCBuffers, ui->dsUAVs);
+      break;
+    case 3:
+      setShaderState(state.geometryShader, ui->gsShader, ui->gsRootSig, ui->gsResources,
+                     ui->gsSamplers, ui->gsCBuffers, ui->gsUAVs);
+      break;
+    case 4:
+      setShaderState(state.pixelShader, ui->psShader, ui->psRootSig, ui->psResources,
+                     ui->psSamplers, ui->psCBuffers, ui->psUAVs);
+      break;
+    case 5:
+      setShaderState(state.computeShader, ui->csShader, ui->csRootSig, ui->csResources,
+                     ui->csSamplers, ui->csCBuffers, ui->csUAVs);
+      break;
+  }
+}
+
 void D3D12PipelineStateViewer::setState()
 {
   if(!m_Ctx.IsCaptureLoaded())
@@ -1515,18 +1570,10 @@ void D3D12PipelineStateViewer::setState()
   ui->iaBuffers->endUpdate();
   ui->iaBuffers->verticalScrollBar()->setValue(vs);
 
-  setShaderState(state.vertexShader, ui->vsShader, ui->vsRootSig, ui->vsResources, ui->vsSamplers,
-                 ui->vsCBuffers, ui->vsUAVs);
-  setShaderState(state.geometryShader, ui->gsShader, ui->gsRootSig, ui->gsResources, ui->gsSamplers,
-                 ui->gsCBuffers, ui->gsUAVs);
-  setShaderState(state.hullShader, ui->hsShader, ui->hsRootSig, ui->hsResources, ui->hsSamplers,
-                 ui->hsCBuffers, ui->hsUAVs);
-  setShaderState(state.domainShader, ui->dsShader, ui->dsRootSig, ui->dsResources, ui->dsSamplers,
-                 ui->dsCBuffers, ui->dsUAVs);
-  setShaderState(state.pixelShader, ui->psShader, ui->psRootSig, ui->psResources, ui->psSamplers,
-                 ui->psCBuffers, ui->psUAVs);
-  setShaderState(state.computeShader, ui->csShader, ui->csRootSig, ui->csResources, ui->csSamplers,
-                 ui->csCBuffers, ui->csUAVs);
+  // mark every shader stage's tab as stale, then populate only the one that's visible. The others
+  // are populated on demand when their tab is selected, since only one can be seen at a time.
+  m_StaleShaderStages = 0x3f;
+  setShaderStageState(ui->stagesTabs->currentIndex());
 
   QToolButton *shaderButtons[] = {
       ui->vsShaderViewButton, ui->hsShaderViewButton, ui->dsShaderViewButton,
@@ -2097,6 +2144,9 @@ void D3D12PipelineStateViewer::vertex_leave(QEvent *e)
 void D3D12PipelineStateViewer::on_pipeFlow_stageSelected(int index)
 {
   ui->stagesTabs->setCurrentIndex(index);
+
+  // if this stage's tab was skipped in the last state update, fill it in now
+  setShaderStageState(index);
 }
 
 void D3D12PipelineStateViewer::shaderView_clicked()
@@ -561,6 +561,7 @@ void GLPipelineStateViewer::clearState()
 {
   m_VBNodes.clear();
   m_EmptyNodes.clear();
+  m_StaleShaderStages = 0;
 
   ui->vaoLabel->setText(QString());
 
@@ -1205,6 +1206,60 @@ GLPipelineStateViewer::GLReadWriteType GLPipelineStateViewer::GetGLReadWriteType
   return ret;
 }
 
+void GLPipelineStateViewer::setShaderStageState(int tabIndex)
+{
+  if(!m_Ctx.IsCaptureLoaded())
+    return;
+
+  // map from a stage tab index to the shader stage shown on it, skipping fixed-function tabs
+  int stage = -1;
+  switch(tabIndex)
+  {
+    case 1: stage = 0; break;    // vertex shader
+    case 2: stage = 1; break;    // tess control shader
+    case 3: stage = 2; break;    // tess eval shader
+    case 4: stage = 3; break;    // geometry shader
+    case 6: stage = 4; break;    // fragment shader
+    case 8: stage = 5; break;    // compute shader
+    default: return;
+  }
+
+  if((m_StaleShaderStages & (1U << stage)) == 0)
+    return;
+
+  m_StaleShaderStages &= ~(1U << stage);
+
+  const GLPipe::State &state = *m_Ctx.CurGLPipelineState();
+
+  switch(stage)
+  {
+    case 0:
+      setShaderState(state.vertexShader, ui->vsShader, ui->vsTextures, ui->vsSamplers, ui->vsUBOs,
+                     ui->vsSubroutines, ui->vsReadWrite);
+      break;
+    case 1:
+      setShaderState(state.tessControlShader, ui->tcsShader, ui->tcsTextures, ui->tcsSamplers,
+                     ui->tcsUBOs, ui->tcsSubroutines, ui->tcsReadWrite);
+      break;
+    case 2:
+      setShaderState(state.tessEvalShader, ui->tesShader, ui->tesTextures, ui->tesSamplers,
+                     ui->tesUBOs, ui->tesSubroutines, ui->tesReadWrite);
+      break;
+    case 3:
+      setShaderState(state.geometryShader, ui->gsShader, ui->gsTextures, ui->gsSamplers, ui->gsUBOs,
+                     ui->gsSubroutines, ui->gsReadWrite);
+      break;
+    case 4:
+      setShaderState(state.fragmentShader, ui->fsShader, ui->fsTextures, ui->fsSamplers, ui->fsUBOs,
+                     ui->fsSubroutines, ui->fsReadWrite);
+      break;
+    case 5:
+      setShaderState(state.computeShader, ui->csShader, ui->csTextures, ui->csSamplers, ui->csUBOs,
+                     ui->csSubroutines, ui->csReadWrite);
+      break;
+  }
+}
+
 void GLPipelineStateViewer::setState()
 {
   if(!m_Ctx.IsCaptureLoaded())
@@ -1451,18 +1506,10 @@ void GLPipelineStateViewer::setState()
   ui->viBuffers->endUpdate();
   ui->viBuffers->verticalScrollBar()->setValue(vs);
 
-  setShaderState(state.vertexShader, ui->vsShader, ui->vsTextures, ui->vsSamplers, ui->vsUBOs,
-                 ui->vsSubroutines, ui->vsReadWrite);
-  setShaderState(state.geometryShader, ui->gsShader, ui->gsTextures, ui->gsSamplers, ui->gsUBOs,
-                 ui->gsSubroutines, ui->gsReadWrite);
-  setShaderState(state.tessControlShader, ui->tcsShader, ui->tcsTextures, ui->tcsSamplers,
-                 ui->tcsUBOs, ui->tcsSubroutines, ui->tcsReadWrite);
-  setShaderState(state.tessEvalShader, ui->tesShader, ui->tesTextures, ui->tesSamplers, ui->tesUBOs,
-                 ui->tesSubroutines, ui->tesReadWrite);
-  setShaderState(state.fragmentShader, ui->fsShader, ui->fsTextures, ui->fsSamplers, ui->fsUBOs,
-                 ui->fsSubroutines, ui->fsReadWrite);
-  setShaderState(state.computeShader, ui->csShader, ui->csTextures, ui->csSamplers, ui->csUBOs,
-                 ui->csSubroutines, ui->csReadWrite);
+  // mark every shader stage's tab as stale, then populate only the one that's visible. The others
+  // are populated on demand when their tab is selected, since only one can be seen at a time.
+  m_StaleShaderStages = 0x3f;
+  setShaderStageState(ui->stagesTabs->currentIndex());
 
   QToolButton *shaderButtons[] = {
       ui->vsShaderViewButton, ui->tcsShaderViewButton, ui->tesShaderViewButton,
@@ -2328,6 +2375,9 @@ void GLPipelineStateViewer::vertex_leave(QEvent *e)
 void GLPipelineStateViewer::on_pipeFlow_stageSelected(int index)
 {
   ui->stagesTabs->setCurrentIndex(index);
+
+  // if this stage's tab was skipped in the last state update, fill it in now
+  setShaderStageState(index);
 }
 
 void GLPipelineStateViewer::shaderView_clicked()
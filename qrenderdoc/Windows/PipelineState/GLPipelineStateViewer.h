@@ -94,6 +94,7 @@ private:
   void clearShaderState(RDLabel *shader, RDTreeWidget *tex, RDTreeWidget *samp, RDTreeWidget *ubo,
                         RDTreeWidget *sub, RDTreeWidget *rw);
   void setState();
+  void setShaderStageState(int tabIndex);
   void clearState();
 
   void setInactiveRow(RDTreeWidgetItem *node);
@@ -118,4 +119,10 @@ private:
   QList<RDTreeWidgetItem *> m_VBNodes;
   // list of empty VB nodes that shouldn't be highlighted on hover
   QList<RDTreeWidgetItem *> m_EmptyNodes;
+
+  // bitmask of shader stages (VS,TCS,TES,GS,FS,CS) whose tab contents are stale. Populating every
+  // stage's widgets is the most expensive part of a state update on binding-heavy events, so
+  // setState() only fills in the visible tab and the rest are populated on demand when their tab
+  // is first selected.
+  uint32_t m_StaleShaderStages = 0;
 };
@@ -649,6 +649,7 @@ void VulkanPipelineStateViewer::clearState()
   m_VBNodes.clear();
   m_BindNodes.clear();
   m_EmptyNodes.clear();
+  m_StaleShaderStages = 0;
 
   ui->viAttrs->clear();
   ui->viBuffers->clear();
@@ -1674,6 +1675,58 @@ void VulkanPipelineStateViewer::setShaderState(const VKPipe::Shader &stage,
   ubos->applyExpansion(expansion, bindsetKeygen);
 }
 
+void VulkanPipelineStateViewer::setShaderStageState(int tabIndex)
+{
+  if(!m_Ctx.IsCaptureLoaded())
+    return;
+
+  // map from a stage tab index to the shader stage shown on it, skipping fixed-function tabs
+  int stage = -1;
+  switch(tabIndex)
+  {
+    case 1: stage = 0; break;    // vertex shader
+    case 2: stage = 1; break;    // tess control shader
+    case 3: stage = 2; break;    // tess eval shader
+    case 4: stage = 3; break;    // geometry shader
+    case 6: stage = 4; break;    // fragment shader
+    case 8: stage = 5; break;    // compute shader
+    default: return;
+  }
+
+  if((m_StaleShaderStages & (1U << stage)) == 0)
+    return;
+
+  m_StaleShaderStages &= ~(1U << stage);
+
+  const VKPipe::State &state = *m_Ctx.CurVulkanPipelineState();
+
+  switch(stage)
+  {
+    case 0:
+      setShaderState(state.vertexShader, state.graphics, ui->vsShader, ui->vsResources, ui->vsUBOs);
+      break;
+    case 1:
+      setShaderState(state.tessControlShader, state.graphics, ui->tcsShader, ui->tcsResources,
+                     ui->tcsUBOs);
+      break;
+    case 2:
+      setShaderState(state.tessEvalShader, state.graphics, ui->tesShader, ui->tesResources,
+                     ui->tesUBOs);
+      break;
+    case 3:
+      setShaderState(state.geometryShader, state.graphics, ui->gsShader, ui->gsResources,
+                     ui->gsUBOs);
+      break;
+    case 4:
+      setShaderState(state.fragmentShader, state.graphics, ui->fsShader, ui->fsResources,
+                     ui->fsUBOs);
+      break;
+    case 5:
+      setShaderState(state.computeShader, state.compute, ui->csShader, ui->csResources, ui->csUBOs);
+      break;
+  }
+}
+
 void VulkanPipelineStateViewer::setState()
 {
   if(!m_Ctx.IsCaptureLoaded())
@@ -1964,13 +2017,10 @@ void VulkanPipelineStateViewer::setState()
   ui->viBuffers->endUpdate();
   ui->viBuffers->verticalScrollBar()->setValue(vs);
 
-  setShaderState(state.vertexShader, state.graphics, ui->vsShader, ui->vsResources, ui->vsUBOs);
-  setShaderState(state.geometryShader, state.graphics, ui->gsShader, ui->gsResources, ui->gsUBOs);
-  setShaderState(state.tessControlShader, state.graphics, ui->tcsShader, ui->tcsResources,
-                 ui->tcsUBOs);
-  setShaderState(state.tessEvalShader, state.graphics, ui->tesShader, ui->tesResources, ui->tesUBOs);
-  setShaderState(state.fragmentShader, state.graphics, ui->fsShader, ui->fsResources, ui->fsUBOs);
-  setShaderState(state.computeShader, state.compute, ui->csShader, ui->csResources, ui->csUBOs);
+  // mark every shader stage's tab as stale, then populate only the one that's visible. The others
+  // are populated on demand when their tab is selected, since only one can be seen at a time.
+  m_StaleShaderStages = 0x3f;
+  setShaderStageState(ui->stagesTabs->currentIndex());
 
   QToolButton *shaderButtons[] = {
       ui->vsShaderViewButton, ui->tcsShaderViewButton, ui->tesShaderViewButton,
@@ -2672,6 +2722,9 @@ void VulkanPipelineStateViewer::vertex_leave(QEvent *e)
 void VulkanPipelineStateViewer::on_pipeFlow_stageSelected(int index)
 {
   ui->stagesTabs->setCurrentIndex(index);
+
+  // if this stage's tab was skipped in the last state update, fill it in now
+  setShaderStageState(index);
 }
 
 void VulkanPipelineStateViewer::shaderView_clicked()
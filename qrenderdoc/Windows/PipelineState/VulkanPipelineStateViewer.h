@@ -98,6 +98,7 @@ private:
                       RDTreeWidget *res, RDTreeWidget *ubo);
   void clearShaderState(RDLabel *shader, RDTreeWidget *res, RDTreeWidget *ubo);
   void setState();
+  void setShaderStageState(int tabIndex);
   void clearState();
 
   void setInactiveRow(RDTreeWidgetItem *node);
@@ -135,4 +136,10 @@ private:
 
   // from an combined image to its sampler (since we de-duplicate)
   QMap<RDTreeWidgetItem *, RDTreeWidgetItem *> m_CombinedImageSamplers;
+
+  // bitmask of shader stages (VS,TCS,TES,GS,FS,CS) whose tab contents are stale. Populating every
+  // stage's resources and UBOs is the most expensive part of a state update on descriptor-heavy
+  // events, so setState() only fills in the visible tab and the rest are populated on demand when
+  // their tab is first selected.
+  uint32_t m_StaleShaderStages = 0;
 };
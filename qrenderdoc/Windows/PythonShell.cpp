@@ -499,7 +499,9 @@ PythonShell::PythonShell(ICaptureContext &ctx, QWidget *parent)
   scriptEditor->setScrollWidth(1);
   scriptEditor->setScrollWidthTracking(true);
 
-  scriptEditor->colourise(0, -1);
+  // style the visible region on demand and the rest of the document during idle time, rather
+  // than lexing the whole script up-front
+  scriptEditor->setIdleStyling(SC_IDLESTYLING_ALL);
 
   QObject::connect(scriptEditor, &ScintillaEdit::modified, [this](int type, int, int, int,
                                                                   const QByteArray &, int, int, int) {
@@ -30,7 +30,6 @@
 #include "ui_ResourceInspector.h"
 
 static const int ResourceIdRole = Qt::UserRole;
-static const int FilterRole = Qt::UserRole + 1;
 
 class ResourceListItemModel : public QAbstractItemModel
 {
@@ -38,11 +37,63 @@ public:
   ResourceListItemModel(QWidget *parent, ICaptureContext &ctx)
       : QAbstractItemModel(parent), m_Ctx(ctx)
   {
+    m_Collator.setNumericMode(true);
+    m_Collator.setCaseSensitivity(Qt::CaseInsensitive);
   }
 
   void reset()
   {
     emit beginResetModel();
+    rebuildCache();
+    emit endResetModel();
+  }
+
+  void setFilter(const QString &text)
+  {
+    QString filter = text.trimmed().toLower();
+
+    if(filter == m_Filter)
+      return;
+
+    emit beginResetModel();
+
+    // when the new filter is an extension of the old one - the common case, since the user is
+    // typing into the filter box - every matching row also matched the old filter, so we only
+    // need to re-check the rows currently displayed instead of every resource in the capture.
+    bool narrowing = !m_Filter.isEmpty() && filter.startsWith(m_Filter);
+
+    m_Filter = filter;
+
+    QStringList tokens = filter.split(QLatin1Char(' '), QString::SkipEmptyParts);
+
+    if(tokens.isEmpty())
+    {
+      m_FilteredRows.resize(m_Entries.count());
+      for(int i = 0; i < m_Entries.count(); i++)
+        m_FilteredRows[i] = i;
+    }
+    else if(narrowing)
+    {
+      QVector<int> prev;
+      prev.swap(m_FilteredRows);
+
+      for(int row : prev)
+      {
+        if(matchesFilter(m_Entries[row], tokens))
+          m_FilteredRows.push_back(row);
+      }
+    }
+    else
+    {
+      m_FilteredRows.clear();
+
+      for(int i = 0; i < m_Entries.count(); i++)
+      {
+        if(matchesFilter(m_Entries[i], tokens))
+          m_FilteredRows.push_back(i);
+      }
+    }
+
     emit endResetModel();
   }
 
@@ -57,7 +108,7 @@ public:
   QModelIndex parent(const QModelIndex &index) const override { return QModelIndex(); }
   int rowCount(const QModelIndex &parent = QModelIndex()) const override
   {
-    return m_Ctx.GetResources().count();
+    return m_FilteredRows.count();
   }
   int columnCount(const QModelIndex &parent = QModelIndex()) const override { return 1; }
   Qt::ItemFlags flags(const QModelIndex &index) const override
@@ -70,30 +121,86 @@ public:
 
   QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override
   {
-    if(index.isValid())
+    if(index.isValid() && index.row() < m_FilteredRows.count())
     {
-      const rdcarray<ResourceDescription> &resources = m_Ctx.GetResources();
-
-      if(index.row() < resources.count())
-      {
-        const ResourceDescription &desc = resources[index.row()];
+      const ResourceEntry &entry = m_Entries[m_FilteredRows[index.row()]];
 
-        if(role == Qt::DisplayRole)
-          return m_Ctx.GetResourceName(desc.resourceId);
+      if(role == Qt::DisplayRole)
+        return entry.name;
 
-        if(role == ResourceIdRole)
-          return QVariant::fromValue(desc.resourceId);
-
-        if(role == FilterRole)
-          return ToQStr(desc.type) + lit(" ") + m_Ctx.GetResourceName(desc.resourceId);
-      }
+      if(role == ResourceIdRole)
+        return QVariant::fromValue(entry.id);
     }
 
     return QVariant();
   }
 
 private:
+  // the name and search text of every resource is cached (and sorted) up-front rather than being
+  // fetched per keystroke of the filter - iterating all of the resources on every filter change
+  // makes typing lag badly on captures with very large numbers of resources.
+  struct ResourceEntry
+  {
+    ResourceId id;
+    QString name;
+    // lower case "type name" string that filter tokens are matched against
+    QString filterText;
+  };
+
+  void rebuildCache()
+  {
+    m_Entries.clear();
+
+    const rdcarray<ResourceDescription> &resources = m_Ctx.GetResources();
+
+    m_Entries.reserve(resources.count());
+
+    for(const ResourceDescription &desc : resources)
+    {
+      ResourceEntry entry;
+      entry.id = desc.resourceId;
+      entry.name = m_Ctx.GetResourceName(desc.resourceId);
+      entry.filterText = (ToQStr(desc.type) + lit(" ") + entry.name).toLower();
+      m_Entries.push_back(entry);
+    }
+
+    // sort once here so that filtering never has to - every subset of the cache stays sorted
+    std::sort(m_Entries.begin(), m_Entries.end(),
+              [this](const ResourceEntry &a, const ResourceEntry &b) {
+                return m_Collator.compare(a.name, b.name) < 0;
+              });
+
+    // re-apply the current filter against the new cache
+    QStringList tokens = m_Filter.split(QLatin1Char(' '), QString::SkipEmptyParts);
+
+    m_FilteredRows.clear();
+
+    for(int i = 0; i < m_Entries.count(); i++)
+    {
+      if(tokens.isEmpty() || matchesFilter(m_Entries[i], tokens))
+        m_FilteredRows.push_back(i);
+    }
+  }
+
+  static bool matchesFilter(const ResourceEntry &entry, const QStringList &tokens)
+  {
+    for(const QString &token : tokens)
+    {
+      if(!entry.filterText.contains(token))
+        return false;
+    }
+
+    return true;
+  }
+
   ICaptureContext &m_Ctx;
+
+  QCollator m_Collator;
+
+  QVector<ResourceEntry> m_Entries;
+  // rows of m_Entries matching the current filter, in sorted order
+  QVector<int> m_FilteredRows;
+  QString m_Filter;
 };
 
 ResourceInspector::ResourceInspector(ICaptureContext &ctx, QWidget *parent)
@@ -111,15 +218,10 @@ ResourceInspector::ResourceInspector(ICaptureContext &ctx, QWidget *parent)
 
   m_ResourceModel = new ResourceListItemModel(this, m_Ctx);
 
-  m_FilterModel = new QCollatorSortFilterProxyModel(this);
-  m_FilterModel->setSourceModel(m_ResourceModel);
-  m_FilterModel->setFilterCaseSensitivity(Qt::CaseInsensitive);
-  m_FilterModel->setFilterRole(FilterRole);
-  m_FilterModel->sort(0);
-  m_FilterModel->collator()->setNumericMode(true);
-  m_FilterModel->collator()->setCaseSensitivity(Qt::CaseInsensitive);
+  ui->resourceList->setModel(m_ResourceModel);
 
-  ui->resourceList->setModel(m_FilterModel);
+  // all rows are the same height, which lets the view do constant-time layout of huge lists
+  ui->resourceList->setUniformItemSizes(true);
 
   ui->initChunks->setColumns({lit("Parameter"), tr("Value")});
   ui->initChunks->header()->resizeSection(0, 200);
@@ -430,7 +532,7 @@ void ResourceInspector::on_cancelResourceListFilter_clicked()
 
 void ResourceInspector::on_resourceListFilter_textChanged(const QString &text)
 {
-  m_FilterModel->setFilterFixedString(text);
+  m_ResourceModel->setFilter(text);
 }
 
 void ResourceInspector::resource_doubleClicked(const QModelIndex &index)
@@ -32,8 +32,6 @@ namespace Ui
 class ResourceInspector;
 }
 
-class QCollatorSortFilterProxyModel;
-
 class RDTreeWidgetItem;
 class ResourceListItemModel;
 
@@ -85,5 +83,4 @@ private:
   ResourceId m_Resource;
   ResourceListItemModel *m_ResourceModel;
   int m_ResourceCacheID = -1;
-  QCollatorSortFilterProxyModel *m_FilterModel;
 };
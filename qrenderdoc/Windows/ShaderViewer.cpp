@@ -362,17 +362,43 @@ void ShaderViewer::debugShader(const ShaderBindpointMapping *bind, const ShaderR
           }
         }
 
+        if(!targetNames.isEmpty())
+          m_DisassemblyCache[targetNames[0]] = QString(disasm);
+
         m_DisassemblyType->clear();
         m_DisassemblyType->addItems(targetNames);
         m_DisassemblyType->setCurrentIndex(0);
         QObject::connect(m_DisassemblyType, OverloadedSlot<int>::of(&QComboBox::currentIndexChanged),
                          this, &ShaderViewer::disassemble_typeChanged);
 
+        // warm the cache with the remaining targets in the background, so switching
+        // representation is instant instead of re-blocking on the replay thread each time
+        if(targets.count() > 1)
+        {
+          rdcarray<rdcstr> remaining(targets.begin() + 1, targets.size() - 1);
+
+          m_Ctx.Replay().AsyncInvoke(QFormatStr("DisasmWarmup%1").arg((uintptr_t)this),
+                                     ReplayPriority::Prefetch,
+                                     [this, remaining](IReplayController *r) {
+            for(const rdcstr &t : remaining)
+            {
+              if(m_Ctx.Replay().IsCurrentInvokeCancelled())
+                break;
+
+              rdcstr d = r->DisassembleShader(m_Pipeline, m_ShaderDetails, t.c_str());
+
+              GUIInvoke::call(this, [this, t, d]() { m_DisassemblyCache[QString(t)] = QString(d); });
+            }
+          });
+        }
+
         // read-only applies to us too!
         m_DisassemblyView->setReadOnly(false);
         m_DisassemblyView->setText(disasm.c_str());
         m_DisassemblyView->setReadOnly(true);
 
+        cacheDisassemblyLines();
+
         bool preferSourceDebug = false;
 
         for(const ShaderCompileFlag &flag : m_ShaderDetails->debugInfo.compileFlags.flags)
@@ -909,7 +935,12 @@ ScintillaEdit *ShaderViewer::MakeEditor(const QString &name, const QString &text
   ret->setScrollWidth(1);
   ret->setScrollWidthTracking(true);
 
-  ret->colourise(0, -1);
+  // don't force an up-front lex of the whole document here - hand-written shaders are small
+  // enough not to care, but generated sources can run to tens of thousands of lines and take
+  // seconds to style. Instead Scintilla styles the visible region on demand (and restyles just the
+  // edited region plus lookahead on edits), and idle styling progressively fills in the rest of
+  // the document in the background so scrolling stays smooth.
+  ret->setIdleStyling(SC_IDLESTYLING_ALL);
 
   ret->emptyUndoBuffer();
 
@@ -1210,18 +1241,35 @@ void ShaderViewer::disassemble_typeChanged(int index)
       m_DisassemblyView->setText(text.c_str());
       m_DisassemblyView->setReadOnly(true);
       m_DisassemblyView->emptyUndoBuffer();
+      cacheDisassemblyLines();
       return;
     }
   }
 
-  m_Ctx.Replay().AsyncInvoke([this, target](IReplayController *r) {
+  // the warm-up task fetches every target in the background when the viewer opens, so by the
+  // time the user switches representation this is nearly always a cache hit
+  auto it = m_DisassemblyCache.find(targetStr);
+  if(it != m_DisassemblyCache.end())
+  {
+    m_DisassemblyView->setReadOnly(false);
+    m_DisassemblyView->setText(it.value().toUtf8().data());
+    m_DisassemblyView->setReadOnly(true);
+    m_DisassemblyView->emptyUndoBuffer();
+    cacheDisassemblyLines();
+    return;
+  }
+
+  m_Ctx.Replay().AsyncInvoke([this, targetStr, target](IReplayController *r) {
     rdcstr disasm = r->DisassembleShader(m_Pipeline, m_ShaderDetails, target.data());
 
-    GUIInvoke::call(this, [this, disasm]() {
+    GUIInvoke::call(this, [this, targetStr, disasm]() {
+      m_DisassemblyCache[targetStr] = QString(disasm);
+
       m_DisassemblyView->setReadOnly(false);
       m_DisassemblyView->setText(disasm.c_str());
       m_DisassemblyView->setReadOnly(true);
       m_DisassemblyView->emptyUndoBuffer();
+      cacheDisassemblyLines();
     });
   });
 }
@@ -1430,6 +1478,19 @@ int ShaderViewer::instructionForLine(sptr_t line)
   return -1;
 }
 
+void ShaderViewer::cacheDisassemblyLines()
+{
+  m_Inst2DisasmLine.clear();
+
+  for(sptr_t i = 0; i < m_DisassemblyView->lineCount(); i++)
+  {
+    int inst = instructionForLine(i);
+
+    if(inst >= 0 && !m_Inst2DisasmLine.contains(inst))
+      m_Inst2DisasmLine[inst] = i;
+  }
+}
+
 void ShaderViewer::runToSample()
 {
   runTo(-1, true, ShaderEvents::SampleLoadGather);
@@ -1723,7 +1784,7 @@ void ShaderViewer::updateDebugging()
       ui->debugToggle->setText(tr("Debug in HLSL"));
   }
 
-  const ShaderDebugState &state = m_Trace->states[m_CurrentStep];
+  const ShaderDebugState &state = currentDebugState();
 
   uint32_t nextInst = state.nextInstruction;
   bool done = false;
@@ -1752,20 +1813,19 @@ void ShaderViewer::updateDebugging()
     m_CurInstructionScintilla = NULL;
   }
 
-  for(sptr_t i = 0; i < m_DisassemblyView->lineCount(); i++)
+  auto instLineIt = m_Inst2DisasmLine.find((int)nextInst);
+
+  if(instLineIt != m_Inst2DisasmLine.end())
   {
-    if(QString::fromUtf8(m_DisassemblyView->getLine(i).trimmed())
-           .startsWith(QFormatStr("%1:").arg(nextInst)))
-    {
-      m_DisassemblyView->markerAdd(i, done ? FINISHED_MARKER : CURRENT_MARKER);
-      m_DisassemblyView->markerAdd(i, done ? FINISHED_MARKER + 1 : CURRENT_MARKER + 1);
+    sptr_t i = instLineIt.value();
 
-      int pos = m_DisassemblyView->positionFromLine(i);
-      m_DisassemblyView->setSelection(pos, pos);
+    m_DisassemblyView->markerAdd(i, done ? FINISHED_MARKER : CURRENT_MARKER);
+    m_DisassemblyView->markerAdd(i, done ? FINISHED_MARKER + 1 : CURRENT_MARKER + 1);
 
-      ensureLineScrolled(m_DisassemblyView, i);
-      break;
-    }
+    int pos = m_DisassemblyView->positionFromLine(i);
+    m_DisassemblyView->setSelection(pos, pos);
+
+    ensureLineScrolled(m_DisassemblyView, i);
   }
 
   ui->callstack->clear();
@@ -2413,9 +2473,78 @@ void ShaderViewer::updateDebugging()
   updateVariableTooltip();
 }
 
+const ShaderDebugState &ShaderViewer::currentDebugState()
+{
+  const rdcarray<ShaderDebugState> &states = m_Trace->states;
+
+  const ShaderDebugState &state = states[m_CurrentStep];
+
+  if(!(state.flags & ShaderEvents::PartialState))
+    return state;
+
+  if(m_FullStateStep == m_CurrentStep)
+    return m_FullState;
+
+  // find the nearest full snapshot at or before the current step
+  int start = m_CurrentStep;
+  while(start > 0 && bool(states[start].flags & ShaderEvents::PartialState))
+    start--;
+
+  // everything between the snapshot and the current step is partial, so if the previous
+  // reconstruction lies in that range - e.g. when single-stepping forwards - roll forward from it
+  // rather than starting over from the snapshot
+  if(m_FullStateStep >= start && m_FullStateStep < m_CurrentStep)
+    start = m_FullStateStep;
+  else
+    m_FullState = states[start];
+
+  for(int i = start + 1; i <= m_CurrentStep; i++)
+    applyPartialState(m_FullState, states[i]);
+
+  m_FullStateStep = m_CurrentStep;
+
+  return m_FullState;
+}
+
+void ShaderViewer::applyPartialState(ShaderDebugState &dst, const ShaderDebugState &partial)
+{
+  size_t reg = 0, out = 0, temp = 0;
+
+  // the entries of each array in a partial state correspond in order to the locations of their
+  // type in partialLocations
+  for(const RegisterRange &loc : partial.partialLocations)
+  {
+    switch(loc.type)
+    {
+      case RegisterType::Undefined:
+      case RegisterType::Input: break;
+      case RegisterType::Temporary:
+        if(reg < partial.registers.size() && loc.index < dst.registers.size())
+          dst.registers[loc.index] = partial.registers[reg];
+        reg++;
+        break;
+      case RegisterType::IndexedTemporary:
+        if(temp < partial.indexableTemps.size() && loc.index < dst.indexableTemps.size())
+          dst.indexableTemps[loc.index] = partial.indexableTemps[temp];
+        temp++;
+        break;
+      case RegisterType::Output:
+        if(out < partial.outputs.size() && loc.index < dst.outputs.size())
+          dst.outputs[loc.index] = partial.outputs[out];
+        out++;
+        break;
+    }
+  }
+
+  dst.locals = partial.locals;
+  dst.modified = partial.modified;
+  dst.nextInstruction = partial.nextInstruction;
+  dst.flags = partial.flags & ~ShaderEvents::PartialState;
+}
+
 const ShaderVariable *ShaderViewer::GetRegisterVariable(const RegisterRange &r)
 {
-  const ShaderDebugState &state = m_Trace->states[m_CurrentStep];
+  const ShaderDebugState &state = currentDebugState();
 
   const ShaderVariable *var = NULL;
   switch(r.type)
@@ -2517,16 +2646,7 @@ void ShaderViewer::ToggleBreakpoint(int instruction)
   if(instLine == -1)
   {
     // find line for this instruction
-    for(instLine = 0; instLine < m_DisassemblyView->lineCount(); instLine++)
-    {
-      int inst = instructionForLine(instLine);
-
-      if(instruction == inst)
-        break;
-    }
-
-    if(instLine >= m_DisassemblyView->lineCount())
-      instLine = -1;
+    instLine = m_Inst2DisasmLine.value(instruction, -1);
   }
 
   if(m_Breakpoints.contains(instruction))
@@ -3027,7 +3147,7 @@ const rdcarray<ShaderVariable> *ShaderViewer::GetVariableList(VariableCategory v
   if(!m_Trace || m_CurrentStep < 0 || m_CurrentStep >= m_Trace->states.count())
     return vars;
 
-  const ShaderDebugState &state = m_Trace->states[m_CurrentStep];
+  const ShaderDebugState &state = currentDebugState();
 
   arrayIdx = qMax(0, arrayIdx);
 
@@ -3086,7 +3206,7 @@ void ShaderViewer::updateVariableTooltip()
   if(!m_Trace || m_CurrentStep < 0 || m_CurrentStep >= m_Trace->states.count())
     return;
 
-  const ShaderDebugState &state = m_Trace->states[m_CurrentStep];
+  const ShaderDebugState &state = currentDebugState();
 
   if(m_TooltipVarCat == VariableCategory::ByString)
   {
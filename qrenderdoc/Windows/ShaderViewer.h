@@ -25,6 +25,7 @@
 #pragma once
 
 #include <QFrame>
+#include <QMap>
 #include "Code/Interface/QRDInterface.h"
 
 namespace Ui
@@ -196,6 +197,9 @@ private:
   QFrame *m_DisassemblyToolbar = NULL;
   QWidget *m_DisassemblyFrame = NULL;
   QComboBox *m_DisassemblyType = NULL;
+  // disassembly per target, warmed in the background when the viewer opens so switching
+  // representations doesn't block on the replay thread
+  QMap<QString, QString> m_DisassemblyCache;
   ScintillaEdit *m_Errors = NULL;
   ScintillaEdit *m_FindResults = NULL;
   QList<ScintillaEdit *> m_Scintillas;
@@ -203,6 +207,11 @@ private:
   // a map per file, from line number to instruction index
   QVector<QMap<int32_t, size_t>> m_Line2Inst;
 
+  // from instruction index to line in the disassembly view, rebuilt whenever the disassembly
+  // text changes. Stepping needs the reverse lookup on every step, and scanning the view's text
+  // for it takes ~100ms on very large shaders.
+  QMap<int, sptr_t> m_Inst2DisasmLine;
+
   ScintillaEdit *m_CurInstructionScintilla = NULL;
   QList<ScintillaEdit *> m_FileScintillas;
 
@@ -231,6 +240,11 @@ private:
   int m_CurrentStep;
   QList<int> m_Breakpoints;
 
+  // reconstructed full contents when the trace only stores a partial state at the current step,
+  // and which step the reconstruction corresponds to
+  ShaderDebugState m_FullState;
+  int m_FullStateStep = -1;
+
   static const int CURRENT_MARKER = 0;
   static const int BREAKPOINT_MARKER = 2;
   static const int FINISHED_MARKER = 4;
@@ -255,9 +269,15 @@ private:
   void insertVulkanUBO();
 
   int instructionForLine(sptr_t line);
+  void cacheDisassemblyLines();
 
   void updateDebugging();
 
+  // returns full variable contents at the current step, reconstructing them on demand when the
+  // trace only stores a partial state there (see ShaderEvents::PartialState)
+  const ShaderDebugState &currentDebugState();
+  void applyPartialState(ShaderDebugState &dst, const ShaderDebugState &partial);
+
   const ShaderVariable *GetRegisterVariable(const RegisterRange &r);
 
   void ensureLineScrolled(ScintillaEdit *s, int i);
@@ -709,7 +709,7 @@ void TextureViewer::HighlightUsage()
 }
 
 void TextureViewer::RT_FetchCurrentPixel(uint32_t x, uint32_t y, PixelValue &pickValue,
-                                         PixelValue &realValue)
+                                         PixelValue *realValue)
 {
   TextureDescription *texptr = GetCurrentTexture();
 
@@ -722,9 +722,9 @@ void TextureViewer::RT_FetchCurrentPixel(uint32_t x, uint32_t y, PixelValue &pic
   pickValue = m_Output->PickPixel(m_TexDisplay.resourceId, true, x, y, m_TexDisplay.sliceFace,
                                   m_TexDisplay.mip, m_TexDisplay.sampleIdx);
 
-  if(m_TexDisplay.customShaderId != ResourceId())
-    realValue = m_Output->PickPixel(m_TexDisplay.resourceId, false, x, y, m_TexDisplay.sliceFace,
-                                    m_TexDisplay.mip, m_TexDisplay.sampleIdx);
+  if(realValue && m_TexDisplay.customShaderId != ResourceId())
+    *realValue = m_Output->PickPixel(m_TexDisplay.resourceId, false, x, y, m_TexDisplay.sliceFace,
+                                     m_TexDisplay.mip, m_TexDisplay.sampleIdx);
 }
 
 void TextureViewer::RT_PickPixelsAndUpdate(IReplayController *)
@@ -737,7 +737,7 @@ void TextureViewer::RT_PickPixelsAndUpdate(IReplayController *)
   uint32_t x = (uint32_t)m_PickedPoint.x();
   uint32_t y = (uint32_t)m_PickedPoint.y();
 
-  RT_FetchCurrentPixel(x, y, pickValue, realValue);
+  RT_FetchCurrentPixel(x, y, pickValue, &realValue);
 
   m_Output->SetPixelContextLocation(x, y);
 
@@ -751,12 +751,13 @@ void TextureViewer::RT_PickPixelsAndUpdate(IReplayController *)
 
 void TextureViewer::RT_PickHoverAndUpdate(IReplayController *)
 {
-  PixelValue pickValue, realValue;
+  PixelValue pickValue;
 
   uint32_t x = (uint32_t)m_CurHoverPixel.x();
   uint32_t y = (uint32_t)m_CurHoverPixel.y();
 
-  RT_FetchCurrentPixel(x, y, pickValue, realValue);
+  // the hover status text only shows the displayed value, don't fetch the real value
+  RT_FetchCurrentPixel(x, y, pickValue, NULL);
 
   m_CurHoverValue = pickValue;
 
@@ -1106,6 +1107,10 @@ void TextureViewer::UI_OnTextureSelectionChanged(bool newdraw)
   // reset high-water mark
   m_HighWaterStatusLength = 0;
 
+  // the contents under the cursor may have changed even at the same co-ordinates (e.g. stepping
+  // between events), so let the next hover re-pick
+  m_LastHoverPick.pos = QPoint(-1, -1);
+
   if(texptr == NULL)
     return;
 
@@ -2320,8 +2325,27 @@ void TextureViewer::render_mouseMove(QMouseEvent *e)
       }
       else if(e->buttons() == Qt::NoButton)
       {
-        m_Ctx.Replay().AsyncInvoke(lit("PickPixelHover"),
-                                   [this](IReplayController *r) { RT_PickHoverAndUpdate(r); });
+        // sub-texel mouse moves would pick the same value over and over - only queue a new pick
+        // if the hovered texel or anything affecting its value has changed since the last one.
+        if(m_LastHoverPick.pos != m_CurHoverPixel ||
+           m_LastHoverPick.id != m_TexDisplay.resourceId ||
+           m_LastHoverPick.mip != m_TexDisplay.mip ||
+           m_LastHoverPick.slice != m_TexDisplay.sliceFace ||
+           m_LastHoverPick.sample != m_TexDisplay.sampleIdx ||
+           m_LastHoverPick.customShader != m_TexDisplay.customShaderId ||
+           m_LastHoverPick.overlay != m_TexDisplay.overlay)
+        {
+          m_LastHoverPick.pos = m_CurHoverPixel;
+          m_LastHoverPick.id = m_TexDisplay.resourceId;
+          m_LastHoverPick.mip = m_TexDisplay.mip;
+          m_LastHoverPick.slice = m_TexDisplay.sliceFace;
+          m_LastHoverPick.sample = m_TexDisplay.sampleIdx;
+          m_LastHoverPick.customShader = m_TexDisplay.customShaderId;
+          m_LastHoverPick.overlay = m_TexDisplay.overlay;
+
+          m_Ctx.Replay().AsyncInvoke(lit("PickPixelHover"), ReplayPriority::Prefetch,
+                                     [this](IReplayController *r) { RT_PickHoverAndUpdate(r); });
+        }
       }
     }
   }
@@ -215,7 +215,9 @@ protected:
   void changeEvent(QEvent *event) override;
 
 private:
-  void RT_FetchCurrentPixel(uint32_t x, uint32_t y, PixelValue &pickValue, PixelValue &realValue);
+  // realValue may be NULL if only the displayed value is wanted, to skip the second pick when a
+  // custom shader or overlay is active.
+  void RT_FetchCurrentPixel(uint32_t x, uint32_t y, PixelValue &pickValue, PixelValue *realValue);
   void RT_PickPixelsAndUpdate(IReplayController *);
   void RT_PickHoverAndUpdate(IReplayController *);
   void RT_UpdateAndDisplay(IReplayController *);
@@ -292,6 +294,18 @@ private:
   QPoint m_CurHoverPixel;
   QPoint m_PickedPoint;
 
+  // the parameters of the last hover pick we queued. Mouse moves within one texel would all pick
+  // the same value, so we only queue a new pick when something here changes - the coordinate, the
+  // selected subresource, or the custom shader/overlay the value is read back through.
+  struct
+  {
+    QPoint pos = QPoint(-1, -1);
+    ResourceId id;
+    uint32_t mip = 0, slice = 0, sample = 0;
+    ResourceId customShader;
+    DebugOverlay overlay = DebugOverlay::NoOverlay;
+  } m_LastHoverPick;
+
   QSizeF m_PrevSize;
 
   PixelValue m_CurRealValue = {};
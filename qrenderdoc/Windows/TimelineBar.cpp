@@ -355,12 +355,7 @@ void TimelineBar::mousePressEvent(QMouseEvent *e)
     if(!m_Draws.isEmpty() && m_dataArea.contains(m_lastPos))
     {
       uint32_t eid = eventAt(x);
-      auto it = std::find_if(m_Draws.begin(), m_Draws.end(), [eid](uint32_t d) {
-        if(d >= eid)
-          return true;
-
-        return false;
-      });
+      auto it = std::lower_bound(m_Draws.begin(), m_Draws.end(), eid);
 
       if(it == m_Draws.end())
         m_Ctx.SetEventID({}, m_Draws.back(), m_Draws.back());
@@ -393,12 +388,7 @@ void TimelineBar::mouseMoveEvent(QMouseEvent *e)
             !m_highlightingRect.contains(e->localPos()))
     {
       uint32_t eid = eventAt(x);
-      auto it = std::find_if(m_Draws.begin(), m_Draws.end(), [eid](uint32_t d) {
-        if(d >= eid)
-          return true;
-
-        return false;
-      });
+      auto it = std::lower_bound(m_Draws.begin(), m_Draws.end(), eid);
 
       if(it != m_Draws.end())
         m_Ctx.SetEventID({}, *it, *it);
@@ -773,13 +763,29 @@ void TimelineBar::paintEvent(QPaintEvent *e)
     qreal leftClip = -triRadius * 2.0;
     qreal rightClip = pipsRect.width() + triRadius * 10.0;
 
+    // the event lists are sorted and pip positions are monotonic in event ID, so binary search
+    // to the first pip that isn't fully off the left edge and stop at the first one past the
+    // right edge - we only touch the events that could actually be painted.
+    const qreal pipLeftEdge = pipsRect.left() - triRadius * 2.0;
+
     if(!m_HistoryEvents.isEmpty())
     {
-      for(const PixelModification &mod : m_HistoryEvents)
+      auto modIt = std::lower_bound(
+          m_HistoryEvents.begin(), m_HistoryEvents.end(), pipLeftEdge,
+          [this, triRadius](const PixelModification &mod, qreal edge) {
+            return offsetOf(mod.eventId) + m_eidWidth / 2 - triRadius < edge;
+          });
+
+      for(; modIt != m_HistoryEvents.end(); ++modIt)
       {
+        const PixelModification &mod = *modIt;
+
         qreal pos = offsetOf(mod.eventId) + m_eidWidth / 2 - triRadius;
 
-        if(pos < leftClip || pos > rightClip)
+        if(pos > rightClip)
+          break;
+
+        if(pos < leftClip)
           continue;
 
         if(mod.Passed())
@@ -790,11 +796,22 @@ void TimelineBar::paintEvent(QPaintEvent *e)
     }
     else
     {
-      for(const EventUsage &use : m_UsageEvents)
+      auto useIt = std::lower_bound(m_UsageEvents.begin(), m_UsageEvents.end(), pipLeftEdge,
+                                    [this, triRadius](const EventUsage &use, qreal edge) {
+                                      return offsetOf(use.eventId) + m_eidWidth / 2 - triRadius <
+                                             edge;
+                                    });
+
+      for(; useIt != m_UsageEvents.end(); ++useIt)
       {
+        const EventUsage &use = *useIt;
+
         qreal pos = offsetOf(use.eventId) + m_eidWidth / 2 - triRadius;
 
-        if(pos < leftClip || pos > rightClip)
+        if(pos > rightClip)
+          break;
+
+        if(pos < leftClip)
           continue;
 
         if(((int)use.usage >= (int)ResourceUsage::VS_RWResource &&
@@ -851,8 +868,24 @@ TimelineBar::Marker *TimelineBar::findMarker(QVector<Marker> &markers, QRectF ma
 {
   QFontMetrics fm(Formatter::PreferredFont());
 
-  for(Marker &m : markers)
+  // conservative event ID for the cursor position, to binary search past markers entirely left
+  // of it. eventAt() truncates so step back one to be safe - containment is tested exactly below.
+  uint32_t eid = eventAt(pos.x());
+  if(eid > 0)
+    eid--;
+
+  auto firstMarker =
+      std::lower_bound(markers.begin(), markers.end(), eid,
+                       [](const Marker &m, uint32_t e) { return m.eidEnd < e; });
+
+  for(auto markerIt = firstMarker; markerIt != markers.end(); ++markerIt)
   {
+    Marker &m = *markerIt;
+
+    // markers are sorted, so once one starts right of the cursor none of the rest can contain it
+    if(offsetOf(m.eidStart) > pos.x())
+      break;
+
     QRectF r = markerRect;
     r.setLeft(qMax(m_markerRect.left() + borderWidth * 2, offsetOf(m.eidStart)));
     r.setRight(qMin(m_markerRect.right() - borderWidth, offsetOf(m.eidEnd + 1)));
@@ -898,8 +931,23 @@ void TimelineBar::paintMarkers(QPainter &p, const QVector<Marker> &markers,
   // store a reference of what a completely elided string looks like
   QString tooshort = fm.elidedText(lit("asd"), Qt::ElideRight, fm.height());
 
-  for(const Marker &m : markers)
+  // the range of events that can possibly be visible. Markers and draws are sorted by event ID,
+  // so we can binary search to the first visible entry and stop at the first one off the right
+  // edge, touching O(visible) entries rather than every event in the frame.
+  const uint32_t visMinEID = eventAt(m_dataArea.left());
+  const uint32_t visMaxEID = eventAt(m_dataArea.right()) + 1;
+
+  auto firstMarker = std::lower_bound(
+      markers.begin(), markers.end(), visMinEID,
+      [](const Marker &m, uint32_t eid) { return m.eidEnd < eid; });
+
+  for(auto markerIt = firstMarker; markerIt != markers.end(); ++markerIt)
   {
+    const Marker &m = *markerIt;
+
+    if(m.eidStart > visMaxEID)
+      break;
+
     QRectF r = markerRect;
     r.setLeft(qMax(m_dataArea.left() + borderWidth * 3, offsetOf(m.eidStart)));
     r.setRight(qMin(m_dataArea.right() - borderWidth, offsetOf(m.eidEnd + 1)));
@@ -956,18 +1004,46 @@ void TimelineBar::paintMarkers(QPainter &p, const QVector<Marker> &markers,
 
   p.setRenderHint(QPainter::Antialiasing);
 
-  for(uint32_t d : draws)
+  // when zoomed out an individual draw covers less than a pixel, so aggregate runs of draws
+  // that land within a pixel of each other into a single span. That bounds the amount of
+  // painting at O(pixels) regardless of how many draws are in the frame.
+  const bool aggregate = m_eidWidth < 1.0;
+
+  auto drawIt = std::lower_bound(draws.begin(), draws.end(), visMinEID);
+
+  while(drawIt != draws.end())
   {
+    uint32_t d = *drawIt;
+
+    if(d > visMaxEID)
+      break;
+
+    bool current = (d == m_Ctx.CurEvent());
+
+    qreal spanRight = offsetOf(d + 1);
+
+    ++drawIt;
+
+    if(aggregate)
+    {
+      while(drawIt != draws.end() && offsetOf(*drawIt) <= spanRight + 1.0)
+      {
+        current |= (*drawIt == m_Ctx.CurEvent());
+        spanRight = offsetOf(*drawIt + 1);
+        ++drawIt;
+      }
+    }
+
     QRectF r = markerRect;
     r.setLeft(qMax(m_dataArea.left() + borderWidth * 3, offsetOf(d)));
-    r.setRight(qMin(m_dataArea.right() - borderWidth, offsetOf(d + 1)));
+    r.setRight(qMin(m_dataArea.right() - borderWidth, spanRight));
     r.setHeight(fm.height() + borderWidth * 2);
 
     QPainterPath path;
     path.addRoundedRect(r, 5, 5);
 
     p.setPen(QPen(palette().brush(QPalette::Text), 1.0));
-    p.fillPath(path, d == m_Ctx.CurEvent() ? Qt::green : Qt::blue);
+    p.fillPath(path, current ? Qt::green : Qt::blue);
     p.drawPath(path);
   }
 
@@ -425,11 +425,13 @@ extern int LoadEXRFromMemory(float **out_rgba, int *width, int *height,
 #define TINYEXR_IMPLEMENTATION_DEIFNED
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <sstream>
+#include <thread>
 
 #include <limits>
 #include <string>
@@ -10474,7 +10476,7 @@ static int DecodeChunk(EXRImage *exr_image, const EXRHeader *exr_header,
                                 &channel_offset, num_channels,
                                 exr_header->channels);
 
-  bool invalid_data = false;  // TODO(LTE): Use atomic lock for MT safety.
+  std::atomic<bool> invalid_data(false);
 
   if (exr_header->tiled) {
     size_t num_tiles = offsets.size();  // = # of blocks
@@ -10553,10 +10555,7 @@ static int DecodeChunk(EXRImage *exr_image, const EXRHeader *exr_header,
         num_channels, exr_header->channels, exr_header->requested_pixel_types,
         data_width, data_height);
 
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-    for (int y = 0; y < static_cast<int>(num_blocks); y++) {
+    auto decode_block = [&](int y) {
       size_t y_idx = static_cast<size_t>(y);
 
       if (offsets[y_idx] + sizeof(int) * 2 > size) {
@@ -10613,7 +10612,43 @@ static int DecodeChunk(EXRImage *exr_image, const EXRHeader *exr_header,
           }
         }
       }
-    }  // omp parallel
+    };
+
+    // Each scanline block is compressed independently, so blocks can decode in
+    // parallel (the loop above was previously annotated for OpenMP). Only
+    // worth spinning up threads when there are enough blocks to go around.
+    int num_threads = 1;
+    if (num_blocks >= 16) {
+      num_threads = static_cast<int>(std::thread::hardware_concurrency());
+      if (num_threads < 1) {
+        num_threads = 1;
+      }
+      if (num_threads > static_cast<int>(num_blocks)) {
+        num_threads = static_cast<int>(num_blocks);
+      }
+    }
+
+    if (num_threads > 1) {
+      std::atomic<int> next_block(0);
+      std::vector<std::thread> workers;
+
+      for (int t = 0; t < num_threads; t++) {
+        workers.push_back(std::thread([&]() {
+          int y = 0;
+          while ((y = next_block.fetch_add(1)) < static_cast<int>(num_blocks)) {
+            decode_block(y);
+          }
+        }));
+      }
+
+      for (size_t t = 0; t < workers.size(); t++) {
+        workers[t].join();
+      }
+    } else {
+      for (int y = 0; y < static_cast<int>(num_blocks); y++) {
+        decode_block(y);
+      }
+    }
   }
 
   if (invalid_data) {
@@ -272,8 +272,10 @@ ExecuteResult StartAndroidPackageForCapture(const char *host, const char *packag
 
   adbForwardPorts(index, deviceID, jdwpPort, pid, false);
 
-  // sleep a little to let the ports initialise
-  Threading::Sleep(500);
+  // when we're not injecting there's nothing to synchronise with, so sleep a little to let the
+  // ports initialise. The JDWP injection below retries its connection itself.
+  if(jdwpPort == 0)
+    Threading::Sleep(500);
 
   if(jdwpPort)
   {
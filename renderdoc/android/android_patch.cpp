@@ -54,12 +54,15 @@ bool RemoveAPKSignature(const string &apk)
   if(fileList.empty())
     return false;
 
-  // Walk through the output.  If it starts with META-INF, remove it.
+  // Walk through the output.  If it starts with META-INF, remove it. We batch all the removals
+  // into as few aapt invocations as possible - every invocation re-opens and rewrites the
+  // archive's central directory, which is slow on large APKs.
   uint32_t fileCount = 0;
   uint32_t matchCount = 0;
   std::istringstream contents(fileList);
   string line;
   string prefix("META-INF");
+  string removals;
   while(std::getline(contents, line))
   {
     line = trim(line);
@@ -67,10 +70,21 @@ bool RemoveAPKSignature(const string &apk)
     if(line.compare(0, prefix.size(), prefix) == 0)
     {
       RDCDEBUG("Match found, removing  %s", line.c_str());
-      execCommand(aapt, "remove \"" + apk + "\" " + line);
+      removals += " " + line;
       matchCount++;
+
+      // flush the batch well before we risk hitting any command line length limit
+      if(removals.size() > 4096)
+      {
+        execCommand(aapt, "remove \"" + apk + "\"" + removals);
+        removals.clear();
+      }
     }
   }
+
+  if(!removals.empty())
+    execCommand(aapt, "remove \"" + apk + "\"" + removals);
+
   RDCLOG("%d files searched, %d removed", fileCount, matchCount);
 
   // Ensure no hits on second pass through
@@ -191,8 +205,8 @@ bool RealignAPK(const string &apk, string &alignedAPK, const string &tmpDir)
       return true;
     }
 
-    Threading::Sleep(1000);
-    elapsed += 1000;
+    Threading::Sleep(250);
+    elapsed += 250;
   }
 
   RDCERR("Timeout reached aligning APK");
@@ -311,8 +325,8 @@ bool UninstallOriginalAPK(const string &deviceID, const string &packageName, con
       return true;
     }
 
-    Threading::Sleep(1000);
-    elapsed += 1000;
+    Threading::Sleep(250);
+    elapsed += 250;
   }
 
   RDCERR("Uninstallation of APK failed!");
@@ -342,8 +356,8 @@ bool ReinstallPatchedAPK(const string &deviceID, const string &apk, const string
       return true;
     }
 
-    Threading::Sleep(1000);
-    elapsed += 1000;
+    Threading::Sleep(250);
+    elapsed += 250;
   }
 
   RDCERR("Reinstallation of APK failed!");
@@ -447,8 +461,8 @@ bool PullAPK(const string &deviceID, const string &pkgPath, const string &apk)
       return true;
     }
 
-    Threading::Sleep(1000);
-    elapsed += 1000;
+    Threading::Sleep(250);
+    elapsed += 250;
   }
 
   RDCLOG("Failed to pull APK");
@@ -618,17 +632,27 @@ extern "C" RENDERDOC_API AndroidFlags RENDERDOC_CC RENDERDOC_MakeDebuggablePacka
 
   progress(0.475f);
 
-  if(!Android::RealignAPK(origAPK, alignedAPK, tmpDir))
-    return AndroidFlags::RepackagingAPKFailure;
+  // the uninstall runs entirely on the device while realigning and re-signing run entirely on the
+  // host, so overlap them - on large APKs each side takes a noticeable amount of time.
+  bool uninstalled = false;
+  Threading::ThreadHandle uninstallThread = Threading::CreateThread([&uninstalled, &deviceID,
+                                                                     packageName, &tmpDir]() {
+    uninstalled = Android::UninstallOriginalAPK(deviceID, packageName, tmpDir);
+  });
+
+  bool repackaged = Android::RealignAPK(origAPK, alignedAPK, tmpDir);
 
   progress(0.5f);
 
-  if(!Android::DebugSignAPK(alignedAPK, tmpDir))
-    return AndroidFlags::RepackagingAPKFailure;
+  if(repackaged)
+    repackaged = Android::DebugSignAPK(alignedAPK, tmpDir);
 
   progress(0.525f);
 
-  if(!Android::UninstallOriginalAPK(deviceID, packageName, tmpDir))
+  Threading::JoinThread(uninstallThread);
+  Threading::CloseThread(uninstallThread);
+
+  if(!repackaged || !uninstalled)
     return AndroidFlags::RepackagingAPKFailure;
 
   progress(0.6f);
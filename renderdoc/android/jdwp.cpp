@@ -414,7 +414,18 @@ namespace Android
 {
 bool InjectWithJDWP(const std::string &deviceID, uint16_t jdwpport)
 {
-  Network::Socket *sock = Network::CreateClientSocket("localhost", jdwpport, 500);
+  // the adb port forward may take a short while to become usable after it's set up, so rather than
+  // sleeping a fixed amount before connecting we retry promptly for a couple of seconds - in the
+  // common case the first attempt succeeds straight away.
+  Network::Socket *sock = NULL;
+
+  for(int attempt = 0; attempt < 10 && !sock; attempt++)
+  {
+    sock = Network::CreateClientSocket("localhost", jdwpport, 250);
+
+    if(!sock)
+      Threading::Sleep(50);
+  }
 
   if(sock)
   {
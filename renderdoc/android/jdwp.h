@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include <map>
 #include "serialise/streamio.h"
 
 namespace JDWP
@@ -569,5 +570,13 @@ private:
   classID GetSuper(classID clazz);
   std::string GetSignature(referenceTypeID typeID);
   std::vector<Method> GetMethods(referenceTypeID searchClass);
+
+  // the IDs we look up are fixed for the lifetime of the VM, but every query is a round-trip over
+  // the adb-forwarded socket which can be very slow. Memoise the lookups that get repeated during
+  // injection - e.g. searching for several method overloads on the same class, or walking the same
+  // superclass chain more than once.
+  std::map<std::string, referenceTypeID> typeCache;
+  std::map<referenceTypeID, std::vector<Method>> methodsCache;
+  std::map<classID, classID> superCache;
 };
 };
\ No newline at end of file
@@ -201,6 +201,10 @@ void Connection::Resume()
 
 referenceTypeID Connection::GetType(const std::string &signature)
 {
+  auto it = typeCache.find(signature);
+  if(it != typeCache.end())
+    return it->second;
+
   Command cmd(CommandSet::VirtualMachine, 2);
   cmd.GetData().Write(signature);
 
@@ -219,6 +223,9 @@ referenceTypeID Connection::GetType(const std::string &signature)
   else if(numTypes > 1)
     RDCWARN("Multiple types found for '%s'", signature.c_str());
 
+  // only cache successful lookups - a class that isn't loaded yet could appear later
+  typeCache[signature] = ret;
+
   return ret;
 }
 
@@ -581,6 +588,10 @@ std::string Connection::GetString(objectID str)
 
 classID Connection::GetSuper(classID clazz)
 {
+  auto it = superCache.find(clazz);
+  if(it != superCache.end())
+    return it->second;
+
   Command cmd(CommandSet::ClassType, 1);
   cmd.GetData().Write(clazz);
 
@@ -589,6 +600,9 @@ classID Connection::GetSuper(classID clazz)
 
   classID ret;
   cmd.GetData().Read(ret).Done();
+
+  superCache[clazz] = ret;
+
   return ret;
 }
 
@@ -607,6 +621,10 @@ std::string Connection::GetSignature(referenceTypeID typeID)
 
 std::vector<Method> Connection::GetMethods(referenceTypeID searchClass)
 {
+  auto it = methodsCache.find(searchClass);
+  if(it != methodsCache.end())
+    return it->second;
+
   Command cmd(CommandSet::ReferenceType, 5);
   cmd.GetData().Write(searchClass);
 
@@ -619,6 +637,9 @@ std::vector<Method> Connection::GetMethods(referenceTypeID searchClass)
     data.Read(m.id).Read(m.name).Read(m.signature).Read(m.modBits);
   });
   data.Done();
+
+  methodsCache[searchClass] = ret;
+
   return ret;
 }
 };
\ No newline at end of file
@@ -625,6 +625,18 @@ public:
     assign(in);
   }
 
+  // move construction steals the backing store instead of copying the elements, so returning
+  // large arrays (e.g. bulk buffer readbacks) by value is cheap. The source is left empty.
+  rdcarray(rdcarray<T> &&in)
+  {
+    elems = in.elems;
+    allocatedCount = in.allocatedCount;
+    usedCount = in.usedCount;
+    in.elems = NULL;
+    in.allocatedCount = 0;
+    in.usedCount = 0;
+  }
+
   inline void swap(rdcarray<T> &other)
   {
     std::swap(elems, other.elems);
@@ -701,6 +713,19 @@ public:
     return *this;
   }
 
+  rdcarray &operator=(rdcarray &&in)
+  {
+    // do nothing if we're self-assigning
+    if(this == &in)
+      return *this;
+
+    // swap storage with the source - we take its elements, and our old elements are destroyed
+    // when the (usually temporary) source is destructed.
+    swap(in);
+
+    return *this;
+  }
+
   // assignment with no operator = taking a pointer and length
   inline void assign(const T *in, size_t count)
   {
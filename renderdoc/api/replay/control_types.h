@@ -281,6 +281,17 @@ If set to (0, 0, 0, 0) the global checkerboard colors are used.
   DOCUMENT("Selects a :class:`DebugOverlay` to draw over the top of the texture.");
   DebugOverlay overlay = DebugOverlay::NoOverlay;
 
+  DOCUMENT(R"(The width in pixels of the viewport this texture is displayed into, or ``0`` if not
+known.
+
+This is filled in automatically when rendering through a :class:`ReplayOutput`. When set, a remote
+replay connection can restrict transfers of very large textures to the visible region.
+)");
+  uint32_t viewportWidth = 0;
+
+  DOCUMENT("The height in pixels of the viewport. See :data:`viewportWidth`.");
+  uint32_t viewportHeight = 0;
+
   static const uint32_t ResolveSamples = ~0U;
 };
 
@@ -36,6 +36,7 @@ class rdcliteral
 
   // make the literal operator a friend so it can construct fixed strings. No-one else can.
   friend rdcliteral operator"" _lit(const char *str, size_t len);
+  friend rdcliteral make_rdcliteral(const char *str, size_t len);
 
   rdcliteral(const char *s, size_t l) : str(s), len(l) {}
   rdcliteral() = delete;
@@ -50,6 +51,14 @@ inline rdcliteral operator"" _lit(const char *str, size_t len)
   return rdcliteral(str, len);
 }
 
+// constructs an rdcliteral from a string that isn't a compile-time literal but has the same
+// lifetime guarantees - immutable storage that is never freed or modified, such as an interning
+// pool. Use with care, anything else must go through rdcstr so it gets copied.
+inline rdcliteral make_rdcliteral(const char *str, size_t len)
+{
+  return rdcliteral(str, len);
+}
+
 DOCUMENT("");
 class rdcstr
 {
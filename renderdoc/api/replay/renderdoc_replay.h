@@ -113,6 +113,16 @@ typedef void(RENDERDOC_CC *pRENDERDOC_FreeArrayMem)(const void *mem);
 extern "C" RENDERDOC_API void *RENDERDOC_CC RENDERDOC_AllocArrayMem(uint64_t sz);
 typedef void *(RENDERDOC_CC *pRENDERDOC_AllocArrayMem)(uint64_t sz);
 
+// equivalents for objects in a structured data tree, used by the operator new/delete overloads on
+// SDObject in structured_data.h. These are backed by a slab pool inside the module, since a
+// structured file for a large capture contains millions of identically-sized objects.
+
+extern "C" RENDERDOC_API void RENDERDOC_CC RENDERDOC_FreeStructuredMem(void *mem);
+typedef void(RENDERDOC_CC *pRENDERDOC_FreeStructuredMem)(void *mem);
+
+extern "C" RENDERDOC_API void *RENDERDOC_CC RENDERDOC_AllocStructuredMem(uint64_t sz);
+typedef void *(RENDERDOC_CC *pRENDERDOC_AllocStructuredMem)(uint64_t sz);
+
 #ifdef NO_ENUM_CLASS_OPERATORS
 
 #define BITMASK_OPERATORS(a)
@@ -885,6 +895,17 @@ function must be called from another thread.
 )");
   virtual void SetFrameEvent(uint32_t eventId, bool force) = 0;
 
+  DOCUMENT(R"(Speculatively replay to the given :data:`eventId <APIEvent.eventId>` and back again.
+
+Unlike :meth:`SetFrameEvent` this does not change any visible state - outputs and pipeline state
+remain on the current event - but it warms any replay-side caches along the way, so that a
+subsequent :meth:`SetFrameEvent` to the same event is cheaper. Intended for low priority
+prefetching of events the user is likely to move to next.
+
+:param int eventId: The :data:`eventId <APIEvent.eventId>` to prefetch.
+)");
+  virtual void PrefetchFrameEvent(uint32_t eventId) = 0;
+
   DOCUMENT(R"(Retrieve the current :class:`D3D11State` pipeline state.
 
 The return value will be ``None`` if the capture is not using the D3D11 API.
@@ -1254,6 +1275,27 @@ texture to something compatible with the target file format.
 )");
   virtual bool SaveTexture(const TextureSave &saveData, const char *path) = 0;
 
+  DOCUMENT(R"(Save a texture to a file on disk at each of a list of events, replaying through the
+frame in a single ordered pass. This is much faster than calling :meth:`SetFrameEvent` and
+:meth:`SaveTexture` per event in an arbitrary order, which replays the frame from the start for
+every backwards step.
+
+If :data:`TextureSave.resourceId` is a null :class:`ResourceId`, the first bound colour output at
+each event is saved (falling back to the depth output), otherwise the specified texture is saved
+at each event.
+
+After this call the current frame event is the largest event in the list.
+
+:param TextureSave saveData: The configuration settings of how to save each texture.
+:param List[int] eventIds: The events to save at.
+:param List[str] paths: The path to save to on disk for each event, parallel to ``eventIds``.
+:return: The events where saving failed, or an empty list if all succeeded.
+:rtype: ``list`` of ``int``
+)");
+  virtual rdcarray<uint32_t> SaveTextureAtEvents(const TextureSave &saveData,
+                                                 const rdcarray<uint32_t> &eventIds,
+                                                 const rdcarray<rdcstr> &paths) = 0;
+
   DOCUMENT(R"(Retrieve the generated data from one of the geometry processing shader stages.
 
 :param int instance: The index of the instance to retrieve data for, or 0 for non-instanced draws.
@@ -1274,6 +1316,20 @@ texture to something compatible with the target file format.
 )");
   virtual bytebuf GetBufferData(ResourceId buff, uint64_t offset, uint64_t len) = 0;
 
+  DOCUMENT(R"(Retrieve the contents of a range of a buffer into a caller-provided buffer.
+
+This is identical to the other overload except that the data is written into :paramref:`data`,
+re-using its allocation where possible. Callers fetching large amounts of data repeatedly - such as
+a buffer viewer scrubbing through events - can pass the same buffer each time to avoid allocating
+and freeing the storage on every fetch.
+
+:param ResourceId buff: The id of the buffer to retrieve data from.
+:param int offset: The byte offset to the start of the range.
+:param int len: The length of the range, or 0 to retrieve the rest of the bytes in the buffer.
+:param bytes data: The buffer to fill with the requested contents.
+)");
+  virtual void GetBufferData(ResourceId buff, uint64_t offset, uint64_t len, bytebuf &data) = 0;
+
   DOCUMENT(R"(Retrieve the contents of one subresource of a texture as a ``bytes``.
 
 For multi-sampled images, they are treated as if they are an array that is Nx longer, with each
@@ -1288,6 +1344,18 @@ sample 0, etc.
 )");
   virtual bytebuf GetTextureData(ResourceId tex, uint32_t arrayIdx, uint32_t mip) = 0;
 
+  DOCUMENT(R"(Retrieve the contents of one subresource of a texture into a caller-provided buffer.
+
+This is identical to the other overload except that the data is written into :paramref:`data`,
+re-using its allocation where possible - see :meth:`GetBufferData` for when this is useful.
+
+:param ResourceId tex: The id of the texture to retrieve data from.
+:param int arrayIdx: The slice of an array or 3D texture, or face of a cubemap texture.
+:param int mip: The mip level to pick from.
+:param bytes data: The buffer to fill with the requested contents.
+)");
+  virtual void GetTextureData(ResourceId tex, uint32_t arrayIdx, uint32_t mip, bytebuf &data) = 0;
+
   static const uint32_t NoPreference = ~0U;
 
 protected:
@@ -1609,6 +1677,9 @@ the capture must be available on the machine where the replay happens.
 
 This function will block until the copy is fully complete, or an error has occurred.
 
+If a previous copy to the same local path was interrupted, the partial file is verified against
+the remote file and the transfer resumes from where it left off instead of restarting from zero.
+
 :param str remotepath: The remote path where the file should be copied from.
 :param str localpath: The local path where the file should be saved.
 :param ProgressCallback progress: A callback that will be repeatedly called with an updated progress
@@ -2085,6 +2156,56 @@ extern "C" RENDERDOC_API void RENDERDOC_CC RENDERDOC_BecomeRemoteServer(
     const char *listenhost, uint32_t port, RENDERDOC_KillCallback killReplay,
     RENDERDOC_PreviewWindowCallback previewWindow);
 
+DOCUMENT(R"(This launches a remote server pinned to a single capture, for running batches of
+analysis against one file. The capture is loaded once when the daemon starts, and any client
+opening the same path over the remote server protocol re-uses the live replay instead of paying
+the full load each time.
+
+This function will block until a remote connection tells the server to shut down, or the
+``killReplay`` callback returns ``True``.
+
+:param str host: The name of the interface to listen on. By default only local connections are
+  accepted.
+:param int port: The port to listen on, or the default port if 0.
+:param str capturefile: The path to the capture to load and keep alive between connections.
+:param KillCallback killReplay: A callback that returns a ``bool`` indicating if the server should
+  be shut down or not.
+:param PreviewWindowCallback previewWindow: A callback that returns information for a preview window
+  when the server wants to display some preview of the ongoing replay.
+)");
+extern "C" RENDERDOC_API void RENDERDOC_CC RENDERDOC_BecomeReplayDaemon(
+    const char *listenhost, uint32_t port, const char *capturefile,
+    RENDERDOC_KillCallback killReplay, RENDERDOC_PreviewWindowCallback previewWindow);
+
+DOCUMENT(R"(Packs a capture for archiving. The frame capture payload is moved out into
+content-addressed blob files in a shared store, so that captures containing identical data - e.g.
+repeated captures of the same program - share blobs instead of each storing its own copy. The pack
+file keeps all other sections and metadata intact but can't be opened for replay until it is
+unpacked against the same blob store with :func:`UnpackCaptureFile`.
+
+:param str infile: The path to the capture to pack.
+:param str packfile: The path to write the packed capture to.
+:param str blobdir: The path to the blob store directory, created if it doesn't exist.
+:return: The status of the pack operation.
+:rtype: ReplayStatus
+)");
+extern "C" RENDERDOC_API ReplayStatus RENDERDOC_CC RENDERDOC_PackCaptureFile(const char *infile,
+                                                                             const char *packfile,
+                                                                             const char *blobdir);
+
+DOCUMENT(R"(Unpacks a capture packed with :func:`PackCaptureFile`, reassembling a standalone
+capture from the pack file and the blob store it was packed against.
+
+:param str packfile: The path to the packed capture.
+:param str outfile: The path to write the reassembled capture to.
+:param str blobdir: The path to the blob store directory.
+:return: The status of the unpack operation.
+:rtype: ReplayStatus
+)");
+extern "C" RENDERDOC_API ReplayStatus RENDERDOC_CC RENDERDOC_UnpackCaptureFile(const char *packfile,
+                                                                               const char *outfile,
+                                                                               const char *blobdir);
+
 //////////////////////////////////////////////////////////////////////////
 // Injection/execution capture functions.
 //////////////////////////////////////////////////////////////////////////
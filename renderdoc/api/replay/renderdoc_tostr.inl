@@ -915,6 +915,10 @@ rdcstr DoStringise(const SectionType &el)
     STRINGISE_ENUM_CLASS_NAMED(ResourceRenames, "renderdoc/ui/resrenames");
     STRINGISE_ENUM_CLASS_NAMED(AMDRGPProfile, "amd/rgp/profile");
     STRINGISE_ENUM_CLASS_NAMED(ExtendedThumbnail, "renderdoc/internal/exthumb");
+    STRINGISE_ENUM_CLASS_NAMED(ChunkIndex, "renderdoc/internal/chunkindex");
+    STRINGISE_ENUM_CLASS_NAMED(ExternalBlobs, "renderdoc/internal/externalblobs");
+    STRINGISE_ENUM_CLASS_NAMED(TextureStatistics, "renderdoc/internal/texstats");
+    STRINGISE_ENUM_CLASS_NAMED(GPUDurations, "renderdoc/internal/gpudurations");
   }
   END_ENUM_STRINGISE();
 }
@@ -973,6 +977,7 @@ rdcstr DoStringise(const ShaderEvents &el)
 
     STRINGISE_BITFIELD_CLASS_BIT(SampleLoadGather);
     STRINGISE_BITFIELD_CLASS_BIT(GeneratedNanOrInf);
+    STRINGISE_BITFIELD_CLASS_BIT(PartialState);
   }
   END_BITFIELD_STRINGISE();
 }
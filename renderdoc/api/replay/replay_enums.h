@@ -83,6 +83,44 @@ version of RenderDoc that addes a new section type. They should be considered eq
   lossless.
 
   The name for this section will be "renderdoc/internal/exthumb".
+
+.. data:: ChunkIndex
+
+  This section contains an index of the chunks in the frame capture section, as a table of
+  (chunk ID, event ID, offset) tuples referring to offsets in the uncompressed frame capture data.
+  It allows seeking directly to a chunk without linearly parsing the frame capture section. This
+  section is optional and purely an accelerator - the capture is fully usable without it.
+
+  The name for this section will be "renderdoc/internal/chunkindex".
+
+.. data:: ExternalBlobs
+
+  This section contains a list of references to blobs stored outside the capture file in a
+  content-addressed blob store, replacing the contents of the frame capture section. It is written
+  by the pack process that deduplicates identical data between captures in an archive, and a packed
+  capture can't be opened for replay until the blobs are resolved again by unpacking.
+
+  The name for this section will be "renderdoc/internal/externalblobs".
+
+.. data:: TextureStatistics
+
+  This section contains precomputed per-subresource min/max values for the textures in the
+  capture, baked by the replay the first time the capture is loaded. It allows subsequent
+  sessions to answer texture viewer auto-range queries without running any GPU reduction
+  passes. This section is optional and purely an accelerator - values are recomputed on the
+  GPU when it is absent.
+
+  The name for this section will be "renderdoc/internal/texstats".
+
+.. data:: GPUDurations
+
+  This section contains per-event GPU durations measured by a previous replay session that ran
+  the GPU duration counter, so timeline and event browser heat displays can be shown without
+  replaying the frame under timing. This section is optional and purely an accelerator - the
+  durations are re-measured when it is absent, and the stored values reflect the GPU and driver
+  of the session that baked them.
+
+  The name for this section will be "renderdoc/internal/gpudurations".
 )");
 enum class SectionType : uint32_t
 {
@@ -95,6 +133,10 @@ enum class SectionType : uint32_t
   ResourceRenames,
   AMDRGPProfile,
   ExtendedThumbnail,
+  ChunkIndex,
+  ExternalBlobs,
+  TextureStatistics,
+  GPUDurations,
   Count,
 };
 
@@ -3640,12 +3682,18 @@ DOCUMENT(R"(A set of flags for events that may occur while debugging a shader
 .. data:: GeneratedNanOrInf
 
   A floating point operation generated a ``NaN`` or ``infinity`` result.
+
+.. data:: PartialState
+
+  This state only stores the variables that were written since the previous state, to keep very
+  long traces within a memory budget. See :data:`ShaderDebugState.partialLocations`.
 )");
 enum class ShaderEvents : uint32_t
 {
   NoEvent = 0,
   SampleLoadGather = 0x1,
   GeneratedNanOrInf = 0x2,
+  PartialState = 0x4,
 };
 
 BITMASK_OPERATORS(ShaderEvents);
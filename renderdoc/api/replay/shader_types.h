@@ -409,6 +409,12 @@ DECLARE_REFLECTION_STRUCT(LineColumnInfo);
 
 DOCUMENT(R"(This stores the current state of shader debugging at one particular step in the shader,
 with all mutable variable contents.
+
+On very long traces most states only store the variables that were written by their step, flagged
+with :data:`ShaderEvents.PartialState` in :data:`flags`, with a full snapshot stored at regular
+intervals. Full contents for a partial state can be reconstructed by walking forward from the
+nearest earlier state without the flag, applying each intermediate state's variables at the
+locations given by :data:`partialLocations`.
 )");
 struct ShaderDebugState
 {
@@ -453,6 +459,14 @@ to which registers, and their type
   DOCUMENT("A list of registers that were modified.");
   rdcarray<RegisterRange> modified;
 
+  DOCUMENT(R"(Only valid when :data:`flags` includes :data:`ShaderEvents.PartialState` - the
+location in the full arrays of each variable stored in this state. Entries with type
+:data:`RegisterType.Temporary`, :data:`RegisterType.Output` and
+:data:`RegisterType.IndexedTemporary` correspond in order to the entries of :data:`registers`,
+:data:`outputs` and :data:`indexableTemps` respectively. :data:`RegisterRange.component` is unused.
+)");
+  rdcarray<RegisterRange> partialLocations;
+
   DOCUMENT(R"(The next instruction to be executed after this state. The initial state before any
 shader execution happened will have ``nextInstruction == 0``.
 )");
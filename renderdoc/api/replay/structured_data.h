@@ -211,12 +211,18 @@ DOCUMENT(R"(Bitfield flags that could be applied to an :class:`SDChunk`.
 
   This chunk has a callstack. Used to indicate the presence of a callstack even if it's empty
   (perhaps due to failure to collect the stack frames).
+
+.. data:: StubChunk
+
+  Only the metadata for this chunk was loaded, its contents are an empty stub. The full
+  structured data can be materialised on demand from the capture.
 )");
 enum class SDChunkFlags : uint64_t
 {
   NoFlags = 0x0,
   OpaqueChunk = 0x1,
   HasCallstack = 0x2,
+  StubChunk = 0x4,
 };
 
 BITMASK_OPERATORS(SDChunkFlags);
@@ -353,6 +359,16 @@ struct SDObject
     data.children.clear();
   }
 
+#if !defined(SWIG)
+  // structured objects are always heap allocated, and a structured file for a large capture
+  // contains millions of them - allocating each individually costs time while building the tree
+  // and far worse, many seconds of frees when destroying it at session close. Route the memory
+  // through a pooled allocator in the module that hands slabs back wholesale instead. This is
+  // inherited by SDChunk, and covers objects created in other modules (e.g. python) too.
+  void *operator new(size_t count) { return RENDERDOC_AllocStructuredMem((uint64_t)count); }
+  void operator delete(void *p) { RENDERDOC_FreeStructuredMem(p); }
+#endif
+
   DOCUMENT("Create a deep copy of this object.");
   SDObject *Duplicate()
   {
@@ -777,6 +793,7 @@ DOCUMENT("Defines a single structured chunk, which is a :class:`SDObject`.");
 struct SDChunk : public SDObject
 {
   SDChunk(const char *name) : SDObject(name, "Chunk"_lit) { type.basetype = SDBasic::Chunk; }
+  SDChunk(const rdcliteral &name) : SDObject(name, "Chunk"_lit) { type.basetype = SDBasic::Chunk; }
   DOCUMENT("The :class:`SDChunkMetaData` with the metadata for this chunk.");
   SDChunkMetaData metadata;
 
@@ -31,6 +31,31 @@
 #include "os/os_specific.h"
 #include "strings/string_utils.h"
 
+#if ENABLED(RDOC_SIMD_X86)
+
+#include <emmintrin.h>
+
+// AVX2 needs either MSVC (intrinsics always available) or a compiler supporting per-function
+// target attributes, since we can't compile the whole file with -mavx2 and still run on older
+// hardware.
+#if ENABLED(RDOC_MSVS)
+#include <intrin.h>
+#define AVX2_TARGET
+#define SIMD_AVX2_COMPILED 1
+#elif defined(__clang__) || defined(__GNUC__)
+#include <immintrin.h>
+#define AVX2_TARGET __attribute__((target("avx2")))
+#define SIMD_AVX2_COMPILED 1
+#else
+#define SIMD_AVX2_COMPILED 0
+#endif
+
+#elif ENABLED(RDOC_SIMD_NEON)
+
+#include <arm_neon.h>
+
+#endif
+
 using std::string;
 
 //	for(int i=0; i < 256; i++)
@@ -125,103 +150,311 @@ bool Vec16NotEqual(void *a, void *b)
 #endif
 }
 
-bool FindDiffRange(void *a, void *b, size_t bufSize, size_t &diffStart, size_t &diffEnd)
+// the scan kernels below sweep over 16-byte aligned data and return chunk-granular offsets:
+// forward scans return the offset of a chunk containing the first difference (or len if equal),
+// backward scans return the offset just past a chunk containing the last difference (or 0 if
+// equal). Byte-accurate trimming is done by the callers, so the granularity - 16 or 32 bytes -
+// doesn't leak into results.
+//
+// len must be a multiple of 16, and a and b must be 16-byte aligned.
+typedef size_t (*DiffScanFunc)(const byte *a, const byte *b, size_t len);
+
+static size_t ScanDiffForward_Scalar(const byte *a, const byte *b, size_t len)
 {
-  RDCASSERT(uintptr_t(a) % 16 == 0);
-  RDCASSERT(uintptr_t(b) % 16 == 0);
+  for(size_t offs = 0; offs < len; offs += 16)
+    if(Vec16NotEqual((void *)(a + offs), (void *)(b + offs)))
+      return offs;
 
-  diffStart = bufSize + 1;
-  diffEnd = 0;
+  return len;
+}
+
+static size_t ScanDiffBackward_Scalar(const byte *a, const byte *b, size_t len)
+{
+  for(size_t offs = len; offs > 0; offs -= 16)
+    if(Vec16NotEqual((void *)(a + offs - 16), (void *)(b + offs - 16)))
+      return offs;
+
+  return 0;
+}
 
-  size_t alignedSize = bufSize & (~0xf);
-  size_t numVecs = alignedSize / 16;
+#if ENABLED(RDOC_SIMD_X86)
+
+// unlike the disabled float-compare path in Vec16NotEqual above, integer byte compares have no
+// -0.0f/NaN pitfalls so these are safe to enable.
+
+static size_t ScanDiffForward_SSE2(const byte *a, const byte *b, size_t len)
+{
+  for(size_t offs = 0; offs < len; offs += 16)
+  {
+    __m128i va = _mm_load_si128((const __m128i *)(a + offs));
+    __m128i vb = _mm_load_si128((const __m128i *)(b + offs));
+
+    if(_mm_movemask_epi8(_mm_cmpeq_epi8(va, vb)) != 0xffff)
+      return offs;
+  }
+
+  return len;
+}
+
+static size_t ScanDiffBackward_SSE2(const byte *a, const byte *b, size_t len)
+{
+  for(size_t offs = len; offs > 0; offs -= 16)
+  {
+    __m128i va = _mm_load_si128((const __m128i *)(a + offs - 16));
+    __m128i vb = _mm_load_si128((const __m128i *)(b + offs - 16));
+
+    if(_mm_movemask_epi8(_mm_cmpeq_epi8(va, vb)) != 0xffff)
+      return offs;
+  }
+
+  return 0;
+}
+
+#if SIMD_AVX2_COMPILED
+
+AVX2_TARGET static size_t ScanDiffForward_AVX2(const byte *a, const byte *b, size_t len)
+{
+  size_t len32 = len & ~(size_t)0x1f;
 
   size_t offs = 0;
+  for(; offs < len32; offs += 32)
+  {
+    __m256i va = _mm256_loadu_si256((const __m256i *)(a + offs));
+    __m256i vb = _mm256_loadu_si256((const __m256i *)(b + offs));
+
+    if(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(va, vb))) != 0xffffffffU)
+      return offs;
+  }
 
-  float *aflt = (float *)a;
-  float *bflt = (float *)b;
+  // odd 16-byte chunk at the end
+  if(offs < len)
+    return offs + ScanDiffForward_SSE2(a + offs, b + offs, 16);
 
-  // sweep to find the start of differences
-  for(size_t v = 0; v < numVecs; v++)
+  return len;
+}
+
+AVX2_TARGET static size_t ScanDiffBackward_AVX2(const byte *a, const byte *b, size_t len)
+{
+  size_t offs = len;
+
+  // odd 16-byte chunk at the end first
+  if(offs & 0x1f)
   {
-    if(Vec16NotEqual(aflt, bflt))
-    {
-      diffStart = offs;
-      break;
-    }
+    offs -= 16;
+    if(ScanDiffBackward_SSE2(a + offs, b + offs, 16) > 0)
+      return offs + 16;
+  }
+
+  while(offs > 0)
+  {
+    offs -= 32;
 
-    aflt += 4;
-    bflt += 4;
-    offs += 4 * sizeof(float);
+    __m256i va = _mm256_loadu_si256((const __m256i *)(a + offs));
+    __m256i vb = _mm256_loadu_si256((const __m256i *)(b + offs));
+
+    if(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(va, vb))) != 0xffffffffU)
+      return offs + 32;
   }
 
-  // make sure we're byte-accurate, to comply with WRITE_NO_OVERWRITE
-  while(diffStart < bufSize && *((byte *)a + diffStart) == *((byte *)b + diffStart))
-    diffStart++;
+  return 0;
+}
+
+static bool AVX2Supported()
+{
+#if ENABLED(RDOC_MSVS)
+  int info[4] = {};
+
+  __cpuid(info, 0);
+  if(info[0] < 7)
+    return false;
+
+  // the OS must save/restore YMM state for AVX to be usable
+  __cpuid(info, 1);
+  const int OSXSAVE = 1 << 27;
+  if((info[2] & OSXSAVE) == 0 || (_xgetbv(0) & 0x6) != 0x6)
+    return false;
+
+  __cpuidex(info, 7, 0);
+  return (info[1] & (1 << 5)) != 0;
+#else
+  return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+
+#endif    // SIMD_AVX2_COMPILED
+
+#elif ENABLED(RDOC_SIMD_NEON)
+
+static bool Vec16NotEqual_NEON(const byte *a, const byte *b)
+{
+  uint8x16_t va = vld1q_u8(a);
+  uint8x16_t vb = vld1q_u8(b);
+
+  uint64x2_t eq = vreinterpretq_u64_u8(vceqq_u8(va, vb));
+
+  return vgetq_lane_u64(eq, 0) != ~0ULL || vgetq_lane_u64(eq, 1) != ~0ULL;
+}
+
+static size_t ScanDiffForward_NEON(const byte *a, const byte *b, size_t len)
+{
+  for(size_t offs = 0; offs < len; offs += 16)
+    if(Vec16NotEqual_NEON(a + offs, b + offs))
+      return offs;
+
+  return len;
+}
+
+static size_t ScanDiffBackward_NEON(const byte *a, const byte *b, size_t len)
+{
+  for(size_t offs = len; offs > 0; offs -= 16)
+    if(Vec16NotEqual_NEON(a + offs - 16, b + offs - 16))
+      return offs;
+
+  return 0;
+}
+
+#endif
+
+static DiffScanFunc ScanDiffForward = NULL;
+static DiffScanFunc ScanDiffBackward = NULL;
 
-  // do we have some unaligned bytes at the end of the buffer?
-  if(bufSize > alignedSize)
+static void InitDiffScans()
+{
+  // benign race - all threads write the same values
+  if(ScanDiffForward)
+    return;
+
+#if ENABLED(RDOC_SIMD_X86)
+
+#if SIMD_AVX2_COMPILED
+  if(AVX2Supported())
   {
-    size_t numBytes = bufSize - alignedSize;
+    ScanDiffForward = &ScanDiffForward_AVX2;
+    ScanDiffBackward = &ScanDiffBackward_AVX2;
+    return;
+  }
+#endif
 
-    // if we haven't even found a start, check in these bytes
-    if(diffStart > bufSize)
-    {
-      offs = alignedSize;
-
-      for(size_t by = 0; by < numBytes; by++)
-      {
-        if(*((byte *)a + alignedSize + by) != *((byte *)b + alignedSize + by))
-        {
-          diffStart = offs;
-          break;
-        }
-
-        offs++;
-      }
-    }
+  // SSE2 is baseline on every x86 target we build for
+  ScanDiffForward = &ScanDiffForward_SSE2;
+  ScanDiffBackward = &ScanDiffBackward_SSE2;
 
-    // sweep from the last byte to find the end
-    for(size_t by = 0; by < numBytes; by++)
-    {
-      if(*((byte *)a + bufSize - 1 - by) != *((byte *)b + bufSize - 1 - by))
-      {
-        diffEnd = bufSize - by;
-        break;
-      }
-    }
+#elif ENABLED(RDOC_SIMD_NEON)
+
+  ScanDiffForward = &ScanDiffForward_NEON;
+  ScanDiffBackward = &ScanDiffBackward_NEON;
+
+#else
+
+  ScanDiffForward = &ScanDiffForward_Scalar;
+  ScanDiffBackward = &ScanDiffBackward_Scalar;
+
+#endif
+}
+
+// returns the byte offset of the first difference between a and b in [0, len), or len if equal
+static size_t FindFirstDiffByte(const byte *a, const byte *b, size_t len)
+{
+  size_t alignedLen = len & ~(size_t)0xf;
+
+  size_t offs = ScanDiffForward(a, b, alignedLen);
+
+  // make sure we're byte-accurate, to comply with WRITE_NO_OVERWRITE. If the scan found nothing
+  // this also covers any unaligned bytes at the end of the buffer
+  while(offs < len && a[offs] == b[offs])
+    offs++;
+
+  return offs;
+}
+
+// returns the offset just past the last difference between a and b in [0, len), or 0 if equal
+static size_t FindLastDiffByte(const byte *a, const byte *b, size_t len)
+{
+  size_t alignedLen = len & ~(size_t)0xf;
+
+  // check any unaligned bytes at the end of the buffer first
+  size_t end = len;
+  while(end > alignedLen && a[end - 1] == b[end - 1])
+    end--;
+
+  if(end > alignedLen)
+    return end;
+
+  end = ScanDiffBackward(a, b, alignedLen);
+
+  // byte-accurate trim within the differing chunk
+  while(end > 0 && a[end - 1] == b[end - 1])
+    end--;
+
+  return end;
+}
+
+bool FindDiffRange(void *a, void *b, size_t bufSize, size_t &diffStart, size_t &diffEnd)
+{
+  RDCASSERT(uintptr_t(a) % 16 == 0);
+  RDCASSERT(uintptr_t(b) % 16 == 0);
+
+  InitDiffScans();
+
+  diffEnd = 0;
+
+  diffStart = FindFirstDiffByte((const byte *)a, (const byte *)b, bufSize);
+
+  if(diffStart >= bufSize)
+  {
+    diffStart = bufSize + 1;
+    return false;
   }
 
-  // if we haven't found a start, or we've found a start AND and end,
-  // then we're done.
-  if(diffStart > bufSize || diffEnd > 0)
-    return diffStart < bufSize;
+  diffEnd = FindLastDiffByte((const byte *)a, (const byte *)b, bufSize);
 
-  offs = alignedSize;
+  return true;
+}
+
+bool FindDiffPageRanges(void *a, void *b, size_t bufSize, size_t pageSize,
+                        std::vector<DiffRange> &ranges)
+{
+  RDCASSERT(uintptr_t(a) % 16 == 0);
+  RDCASSERT(uintptr_t(b) % 16 == 0);
+  RDCASSERT(pageSize > 0 && pageSize % 16 == 0);
 
-  // sweep from the last __m128
-  aflt = (float *)a + offs / sizeof(float) - 4;
-  bflt = (float *)b + offs / sizeof(float) - 4;
+  InitDiffScans();
 
-  for(size_t v = 0; v < numVecs; v++)
+  const byte *abytes = (const byte *)a;
+  const byte *bbytes = (const byte *)b;
+
+  bool found = false;
+  size_t prevDirtyPage = ~(size_t)0;
+
+  for(size_t pageStart = 0; pageStart < bufSize; pageStart += pageSize)
   {
-    if(Vec16NotEqual(aflt, bflt))
+    size_t pageLen = RDCMIN(pageSize, bufSize - pageStart);
+
+    size_t first = FindFirstDiffByte(abytes + pageStart, bbytes + pageStart, pageLen);
+
+    if(first >= pageLen)
+      continue;
+
+    size_t last = FindLastDiffByte(abytes + pageStart, bbytes + pageStart, pageLen);
+
+    size_t page = pageStart / pageSize;
+
+    if(found && prevDirtyPage == page - 1)
+    {
+      // adjacent dirty pages coalesce into one range. This includes the clean bytes between the
+      // two pages' diffs, which only means we serialise a slight superset
+      ranges.back().end = pageStart + last;
+    }
+    else
     {
-      diffEnd = offs;
-      break;
+      ranges.push_back({pageStart + first, pageStart + last});
     }
 
-    aflt -= 4;
-    bflt -= 4;
-    offs -= 16;
+    prevDirtyPage = page;
+    found = true;
   }
 
-  // make sure we're byte-accurate, to comply with WRITE_NO_OVERWRITE
-  while(diffEnd > 0 && *((byte *)a + diffEnd - 1) == *((byte *)b + diffEnd - 1))
-    diffEnd--;
-
-  // if we found a start then we necessarily found an end
-  return diffStart < bufSize;
+  return found;
 }
 
 uint32_t CalcNumMips(int w, int h, int d)
@@ -269,11 +502,54 @@ byte *AllocAlignedBuffer(uint64_t size, uint64_t alignment)
   return alignedAlloc;
 }
 
+// stable memory ranges that deserialised buffers can borrow views into - see common.h. There are
+// only ever a handful of these (one per open memory-mapped capture), so a locked linear scan in
+// FreeAlignedBuffer is cheap next to the free itself.
+static Threading::CriticalSection stableRangeLock;
+static std::vector<std::pair<const byte *, const byte *>> stableRanges;
+// lock-free emptiness check so FreeAlignedBuffer doesn't pay for the lock on the capture side,
+// where no ranges are ever registered
+static volatile int32_t stableRangeCount = 0;
+
+void RegisterStableMemoryRange(const byte *begin, const byte *end)
+{
+  SCOPED_LOCK(stableRangeLock);
+  stableRanges.push_back(std::make_pair(begin, end));
+  Atomic::Inc32(&stableRangeCount);
+}
+
+void UnregisterStableMemoryRange(const byte *begin)
+{
+  SCOPED_LOCK(stableRangeLock);
+  for(size_t i = 0; i < stableRanges.size(); i++)
+  {
+    if(stableRanges[i].first == begin)
+    {
+      stableRanges.erase(stableRanges.begin() + i);
+      Atomic::Dec32(&stableRangeCount);
+      return;
+    }
+  }
+}
+
+bool IsStableMemoryPointer(const void *ptr)
+{
+  SCOPED_LOCK(stableRangeLock);
+  for(size_t i = 0; i < stableRanges.size(); i++)
+    if(ptr >= stableRanges[i].first && ptr < stableRanges[i].second)
+      return true;
+  return false;
+}
+
 void FreeAlignedBuffer(byte *buf)
 {
   if(buf == NULL)
     return;
 
+  // borrowed views into stable storage were never allocated, leave them alone
+  if(stableRangeCount > 0 && IsStableMemoryPointer(buf))
+    return;
+
   byte **realPointer = (byte **)buf;
   byte *rawAlloc = realPointer[-1];
 
@@ -28,6 +28,7 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <vector>
 #include "api/replay/renderdoc_replay.h"
 #include "globalconfig.h"
 
@@ -156,11 +157,36 @@ inline T AlignUpPtr(T x, A a)
   (((uint32_t)(d) << 24) | ((uint32_t)(c) << 16) | ((uint32_t)(b) << 8) | (uint32_t)(a))
 
 bool FindDiffRange(void *a, void *b, size_t bufSize, size_t &diffStart, size_t &diffEnd);
+
+// a byte-accurate [start, end) range of differing bytes, as appended by FindDiffPageRanges
+struct DiffRange
+{
+  size_t start;
+  size_t end;
+};
+
+// as FindDiffRange, but appends one range per contiguous run of modified pages instead of
+// returning a single bounding range, so scattered writes to a large buffer don't force
+// serialising everything between the first and last touched byte. Each range is byte-accurate at
+// both ends and page-granular in the middle. pageSize must be a non-zero multiple of 16.
+// Returns true if any difference was found.
+bool FindDiffPageRanges(void *a, void *b, size_t bufSize, size_t pageSize,
+                        std::vector<DiffRange> &ranges);
 uint32_t CalcNumMips(int Width, int Height, int Depth);
 
 byte *AllocAlignedBuffer(uint64_t size, uint64_t alignment = 64);
 void FreeAlignedBuffer(byte *buf);
 
+// registers a range of stable externally-owned memory (e.g. a memory-mapped capture file) that
+// deserialised buffers may point directly into, instead of being copied into an allocation. Any
+// pointer inside a registered range is recognised by FreeAlignedBuffer and left alone, so
+// borrowed views flow through the normal buffer ownership paths without every call site having
+// to know whether a copy was made. The range must stay registered for as long as any borrowed
+// pointer into it might be freed.
+void RegisterStableMemoryRange(const byte *begin, const byte *end);
+void UnregisterStableMemoryRange(const byte *begin);
+bool IsStableMemoryPointer(const void *ptr);
+
 uint32_t Log2Floor(uint32_t value);
 #if ENABLED(RDOC_X64)
 uint64_t Log2Floor(uint64_t value);
@@ -0,0 +1,154 @@
+/******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Baldur Karlsson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include <string.h>
+#include "common/common.h"
+
+#if ENABLED(ENABLE_UNIT_TESTS)
+
+#include "3rdparty/catch/catch.hpp"
+
+TEST_CASE("Test FindDiffRange", "[common]")
+{
+  // deliberately not a multiple of 16, so the vectorised sweeps leave a byte tail
+  const size_t bufSize = 75000 + 7;
+
+  byte *a = AllocAlignedBuffer(bufSize);
+  byte *b = AllocAlignedBuffer(bufSize);
+
+  for(size_t i = 0; i < bufSize; i++)
+    a[i] = b[i] = byte((i * 17 + (i >> 9)) & 0xff);
+
+  size_t diffStart = 0, diffEnd = 0;
+
+  SECTION("identical buffers have no diff")
+  {
+    CHECK_FALSE(FindDiffRange(a, b, bufSize, diffStart, diffEnd));
+  }
+
+  SECTION("single byte diffs are byte-accurate")
+  {
+    // prod bytes at awkward offsets: chunk-aligned, just before/after alignment, in the
+    // unaligned tail, and at the very first and last byte
+    const size_t offsets[] = {0, 1, 15, 16, 17, 4095, 4096, 60000, bufSize - 8, bufSize - 1};
+
+    for(size_t offs : offsets)
+    {
+      b[offs] ^= 0xff;
+
+      CHECK(FindDiffRange(a, b, bufSize, diffStart, diffEnd));
+      CHECK(diffStart == offs);
+      CHECK(diffEnd == offs + 1);
+
+      b[offs] = a[offs];
+    }
+  }
+
+  SECTION("bounding range covers scattered diffs")
+  {
+    b[100] ^= 0x1;
+    b[50000] ^= 0x80;
+
+    CHECK(FindDiffRange(a, b, bufSize, diffStart, diffEnd));
+    CHECK(diffStart == 100);
+    CHECK(diffEnd == 50001);
+  }
+
+  FreeAlignedBuffer(a);
+  FreeAlignedBuffer(b);
+}
+
+TEST_CASE("Test FindDiffPageRanges", "[common]")
+{
+  const size_t pageSize = 4096;
+  const size_t bufSize = pageSize * 20 + 100;
+
+  byte *a = AllocAlignedBuffer(bufSize);
+  byte *b = AllocAlignedBuffer(bufSize);
+
+  memset(a, 0x3f, bufSize);
+  memset(b, 0x3f, bufSize);
+
+  std::vector<DiffRange> ranges;
+
+  SECTION("identical buffers have no ranges")
+  {
+    CHECK_FALSE(FindDiffPageRanges(a, b, bufSize, pageSize, ranges));
+    CHECK(ranges.empty());
+  }
+
+  SECTION("scattered writes give separate ranges")
+  {
+    b[10] = 0;
+    b[pageSize * 7 + 123] = 0;
+    b[bufSize - 1] = 0;
+
+    CHECK(FindDiffPageRanges(a, b, bufSize, pageSize, ranges));
+
+    REQUIRE(ranges.size() == 3);
+
+    CHECK(ranges[0].start == 10);
+    CHECK(ranges[0].end == 11);
+
+    CHECK(ranges[1].start == pageSize * 7 + 123);
+    CHECK(ranges[1].end == pageSize * 7 + 124);
+
+    CHECK(ranges[2].start == bufSize - 1);
+    CHECK(ranges[2].end == bufSize);
+  }
+
+  SECTION("adjacent dirty pages coalesce")
+  {
+    // dirty a span crossing three page boundaries
+    memset(b + pageSize * 3 - 100, 0, pageSize * 2 + 200);
+
+    CHECK(FindDiffPageRanges(a, b, bufSize, pageSize, ranges));
+
+    REQUIRE(ranges.size() == 1);
+
+    CHECK(ranges[0].start == pageSize * 3 - 100);
+    CHECK(ranges[0].end == pageSize * 5 + 100);
+  }
+
+  SECTION("ranges agree with FindDiffRange's bounds")
+  {
+    b[pageSize + 5] = 0;
+    b[pageSize * 12 + 70] = 0;
+
+    size_t diffStart = 0, diffEnd = 0;
+
+    CHECK(FindDiffRange(a, b, bufSize, diffStart, diffEnd));
+    CHECK(FindDiffPageRanges(a, b, bufSize, pageSize, ranges));
+
+    REQUIRE(!ranges.empty());
+
+    CHECK(ranges.front().start == diffStart);
+    CHECK(ranges.back().end == diffEnd);
+  }
+
+  FreeAlignedBuffer(a);
+  FreeAlignedBuffer(b);
+}
+
+#endif    // ENABLED(ENABLE_UNIT_TESTS)
@@ -43,6 +43,18 @@
 #define RDOC_X64 OPTION_OFF
 #endif
 
+// SIMD instruction family available for optimised memory comparison routines
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define RDOC_SIMD_X86 OPTION_ON
+#define RDOC_SIMD_NEON OPTION_OFF
+#elif defined(__aarch64__) || defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define RDOC_SIMD_X86 OPTION_OFF
+#define RDOC_SIMD_NEON OPTION_ON
+#else
+#define RDOC_SIMD_X86 OPTION_OFF
+#define RDOC_SIMD_NEON OPTION_OFF
+#endif
+
 #if defined(RELEASE) || defined(_RELEASE)
 #define RDOC_RELEASE OPTION_ON
 #define RDOC_DEVEL OPTION_OFF
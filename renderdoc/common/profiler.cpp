@@ -0,0 +1,186 @@
+/******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Baldur Karlsson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "profiler.h"
+#include "common.h"
+
+namespace CaptureProfiler
+{
+bool ProfilerEnabled = false;
+
+namespace
+{
+// per-frame aggregates for every counter. Scopes on other threads add into the slot that
+// m_CurFrame points at, so the totals use atomic adds - a scope straddling a frame boundary just
+// lands in whichever frame was current when it ended, which is fine for aggregates.
+struct FrameStats
+{
+  uint64_t frameIndex;
+  uint64_t startTick;
+  int64_t ticks[(size_t)Counter::Count];
+  int32_t calls[(size_t)Counter::Count];
+};
+
+// about a minute of history at 60fps. The ring wraps and keeps the most recent frames.
+const size_t FrameHistoryLength = 4096;
+
+FrameStats m_Frames[FrameHistoryLength];
+
+// index of the frame currently accumulating. Read by scopes on any thread, only written on the
+// present thread in BeginFrame.
+volatile int32_t m_CurFrame = 0;
+
+// total number of BeginFrame calls, to know how much of the ring is valid and where it starts
+uint64_t m_TotalFrames = 0;
+
+uint64_t m_BaseTick = 0;
+
+const char *m_CounterNames[(size_t)Counter::Count] = {
+    "Queue submit processing", "Resource ref marking", "Chunk writing",
+};
+};
+
+void Init()
+{
+  const char *profile = Process::GetEnvVariable("RENDERDOC_PROFILE");
+
+  ProfilerEnabled = (profile && profile[0] != '\0' && profile[0] != '0');
+
+  if(!ProfilerEnabled)
+    return;
+
+  m_BaseTick = Timing::GetTick();
+
+  RDCEraseEl(m_Frames[0]);
+  m_Frames[0].startTick = m_BaseTick;
+
+  RDCLOG("Capture profiler enabled - %zu frames of history", FrameHistoryLength);
+}
+
+void BeginFrame()
+{
+  if(!ProfilerEnabled)
+    return;
+
+  m_TotalFrames++;
+
+  int32_t next = int32_t(m_TotalFrames % FrameHistoryLength);
+
+  // zero the slot before publishing it, so scopes never add into stale data from a previous lap
+  // around the ring.
+  RDCEraseEl(m_Frames[next]);
+  m_Frames[next].frameIndex = m_TotalFrames;
+  m_Frames[next].startTick = Timing::GetTick();
+
+  m_CurFrame = next;
+}
+
+void AccumulateTicks(Counter counter, uint64_t ticks)
+{
+  FrameStats &frame = m_Frames[m_CurFrame];
+
+  Atomic::ExchAdd64(&frame.ticks[(size_t)counter], int64_t(ticks));
+  Atomic::Inc32(&frame.calls[(size_t)counter]);
+}
+
+bool WriteTrace(const char *filename)
+{
+  if(!ProfilerEnabled || m_TotalFrames == 0)
+    return false;
+
+  FILE *f = FileIO::fopen(filename, "w");
+
+  if(!f)
+    return false;
+
+  // ticks to microseconds - GetTickFrequency() returns ticks per millisecond
+  const double ticksToUS = 1000.0 / Timing::GetTickFrequency();
+
+  std::string str;
+
+  str = R"({
+  "displayTimeUnit": "ns",
+  "traceEvents": [)";
+
+  // name the tracks - one per counter, plus track 0 carrying the frame markers
+  str += StringFormat::Fmt(
+      R"(
+    { "name": "process_name", "ph": "M", "pid": 1, "args": { "name": "RenderDoc capture" } },
+    { "name": "thread_name", "ph": "M", "pid": 1, "tid": 0, "args": { "name": "Frames" } })");
+
+  for(size_t c = 0; c < (size_t)Counter::Count; c++)
+    str += StringFormat::Fmt(R"(,
+    { "name": "thread_name", "ph": "M", "pid": 1, "tid": %zu, "args": { "name": "%s" } })",
+                             c + 1, m_CounterNames[c]);
+
+  uint64_t numFrames = RDCMIN(m_TotalFrames, (uint64_t)FrameHistoryLength);
+  uint64_t firstFrame = m_TotalFrames - numFrames + 1;
+
+  uint64_t endTick = Timing::GetTick();
+
+  for(uint64_t i = 0; i < numFrames; i++)
+  {
+    uint64_t frameIndex = firstFrame + i;
+
+    const FrameStats &frame = m_Frames[frameIndex % FrameHistoryLength];
+
+    // the slot was overwritten while we iterated - skip it rather than emit garbage
+    if(frame.frameIndex != frameIndex)
+      continue;
+
+    uint64_t frameStart = frame.startTick;
+    uint64_t frameEnd = endTick;
+
+    if(i + 1 < numFrames)
+      frameEnd = m_Frames[(frameIndex + 1) % FrameHistoryLength].startTick;
+
+    str += StringFormat::Fmt(R"(,
+    { "name": "Frame %llu", "cat": "Capture", "ph": "X",
+      "ts": %llu, "dur": %llu, "pid": 1, "tid": 0 })",
+                             frameIndex, uint64_t(double(frameStart - m_BaseTick) * ticksToUS),
+                             uint64_t(double(frameEnd - frameStart) * ticksToUS));
+
+    for(size_t c = 0; c < (size_t)Counter::Count; c++)
+    {
+      if(frame.calls[c] == 0)
+        continue;
+
+      str += StringFormat::Fmt(R"(,
+    { "name": "%s", "cat": "Capture", "ph": "X",
+      "ts": %llu, "dur": %llu, "pid": 1, "tid": %zu, "args": { "calls": %d } })",
+                               m_CounterNames[c],
+                               uint64_t(double(frameStart - m_BaseTick) * ticksToUS),
+                               uint64_t(double(frame.ticks[c]) * ticksToUS), c + 1, frame.calls[c]);
+    }
+  }
+
+  str += "\n  ]\n}";
+
+  FileIO::fwrite(str.data(), 1, str.size(), f);
+
+  FileIO::fclose(f);
+
+  return true;
+}
+};
@@ -0,0 +1,100 @@
+/******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Baldur Karlsson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+#include "os/os_specific.h"
+#include "common.h"
+
+// a lightweight always-available profiler for the hot capture-side paths, to quantify what
+// injection costs the captured application. Scopes accumulate tick totals and call counts into
+// per-frame slots in a fixed ring buffer, so the steady-state cost when enabled is two timestamp
+// reads and two atomic adds per scope, and a single predicted branch when disabled.
+//
+// It is opt-in at runtime via the RENDERDOC_PROFILE environment variable, and the gathered
+// history is written out on shutdown as chrome://tracing JSON next to the capture log.
+namespace CaptureProfiler
+{
+// the instrumented paths. Each counter gets its own track in the exported trace.
+enum class Counter : uint32_t
+{
+  // serialising and reference-gathering around queue/command submission in the driver
+  QueueSubmit = 0,
+  // frame-reference marking in the resource manager
+  RefMarking,
+  // writing chunks through a WriteSerialiser
+  ChunkWrite,
+  Count,
+};
+
+// reads RENDERDOC_PROFILE and enables the profiler if it's set to anything but empty or '0'.
+void Init();
+
+// advances the ring to a fresh frame slot. Called once per presented frame from the core tick.
+void BeginFrame();
+
+// adds a completed scope's duration into the current frame's slot for the counter.
+void AccumulateTicks(Counter counter, uint64_t ticks);
+
+// writes the aggregated per-frame history to a JSON file loadable by chrome://tracing. Returns
+// false if the profiler never recorded anything or the file couldn't be written.
+bool WriteTrace(const char *filename);
+
+extern bool ProfilerEnabled;
+
+inline bool IsEnabled()
+{
+  return ProfilerEnabled;
+}
+
+class Scope
+{
+public:
+  Scope(Counter counter) : m_Counter(counter)
+  {
+    m_Start = ProfilerEnabled ? Timing::GetTick() : 0;
+  }
+  ~Scope()
+  {
+    if(m_Start)
+      AccumulateTicks(m_Counter, Timing::GetTick() - m_Start);
+  }
+
+  // ends the scope early, e.g. to exclude a call into the real API from the measured range.
+  void End()
+  {
+    if(m_Start)
+      AccumulateTicks(m_Counter, Timing::GetTick() - m_Start);
+    m_Start = 0;
+  }
+
+private:
+  Counter m_Counter;
+  uint64_t m_Start;
+};
+};
+
+#define PROFILE_CAPTURE_SCOPE(counter) \
+  CaptureProfiler::Scope CONCAT(profscope, __LINE__)(CaptureProfiler::Counter::counter);
@@ -0,0 +1,197 @@
+/******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Baldur Karlsson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "common/threading.h"
+#include "common/common.h"
+
+namespace Threading
+{
+TaskPool &TaskPool::Instance()
+{
+  static TaskPool pool;
+  return pool;
+}
+
+uint32_t TaskPool::NumWorkers()
+{
+  EnsureStarted();
+
+  return (uint32_t)m_Threads.size();
+}
+
+void TaskPool::EnsureStarted()
+{
+  if(Atomic::CmpExch32(&m_Started, 1, 1) == 1)
+    return;
+
+  SCOPED_LOCK(m_SetupLock);
+
+  if(m_Started)
+    return;
+
+  // leave a core for whichever thread is submitting and waiting
+  uint32_t numThreads = RDCMAX(1U, NumberOfCores() - 1);
+
+  m_Queues.resize(numThreads);
+  for(uint32_t i = 0; i < numThreads; i++)
+    m_Queues[i] = new WorkerQueue;
+
+  for(uint32_t i = 0; i < numThreads; i++)
+    m_Threads.push_back(CreateThread([this, i]() { WorkerEntry(i); }));
+
+  Atomic::Inc32(&m_Started);
+}
+
+void TaskPool::Submit(TaskGroup &group, std::function<void()> task)
+{
+  EnsureStarted();
+
+  Atomic::Inc32(&group.pending);
+
+  // if we're on a worker thread, push to its own deque - the task is freshest there and stays
+  // cache-hot if the same worker pops it straight back. Otherwise distribute round-robin.
+  uint64_t threadID = GetCurrentID();
+
+  size_t q = m_Queues.size();
+  for(size_t i = 0; i < m_Queues.size(); i++)
+  {
+    if(m_Queues[i]->threadID == threadID)
+    {
+      q = i;
+      break;
+    }
+  }
+
+  if(q == m_Queues.size())
+    q = size_t(uint32_t(Atomic::Inc32(&m_NextQueue))) % m_Queues.size();
+
+  ScopedSpinLock lock(m_Queues[q]->lock);
+  m_Queues[q]->tasks.push_back({std::move(task), &group});
+}
+
+bool TaskPool::PopTask(size_t preferred, Task &task)
+{
+  // pop the newest task from our own deque first
+  if(preferred < m_Queues.size())
+  {
+    WorkerQueue *queue = m_Queues[preferred];
+
+    ScopedSpinLock lock(queue->lock);
+    if(!queue->tasks.empty())
+    {
+      task = std::move(queue->tasks.back());
+      queue->tasks.pop_back();
+      return true;
+    }
+  }
+
+  // otherwise steal the oldest task from anyone else
+  for(size_t i = 0; i < m_Queues.size(); i++)
+  {
+    if(i == preferred)
+      continue;
+
+    WorkerQueue *queue = m_Queues[i];
+
+    ScopedSpinLock lock(queue->lock);
+    if(!queue->tasks.empty())
+    {
+      task = std::move(queue->tasks.front());
+      queue->tasks.pop_front();
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void TaskPool::RunTask(Task &task)
+{
+  task.func();
+  // the function object may own resources - destroy it before the group is signalled so a waiter
+  // can't race ahead of the cleanup
+  task.func = std::function<void()>();
+  Atomic::Dec32(&task.group->pending);
+}
+
+void TaskPool::WorkerEntry(size_t index)
+{
+  m_Queues[index]->threadID = GetCurrentID();
+
+  for(;;)
+  {
+    Task task;
+    if(PopTask(index, task))
+    {
+      RunTask(task);
+      continue;
+    }
+
+    // only exit once every deque has fully drained
+    if(Atomic::CmpExch32(&m_Kill, 1, 1) == 1)
+      return;
+
+    Sleep(1);
+  }
+}
+
+void TaskPool::Wait(TaskGroup &group)
+{
+  while(Atomic::CmpExch32(&group.pending, 0, 0) != 0)
+  {
+    // help out rather than blocking. We might execute tasks from an unrelated group here, which
+    // is fine - it only means we do useful work while we wait
+    Task task;
+    if(PopTask(m_Queues.size(), task))
+      RunTask(task);
+    else
+      Sleep(0);
+  }
+}
+
+void TaskPool::Shutdown()
+{
+  SCOPED_LOCK(m_SetupLock);
+
+  if(m_Threads.empty())
+    return;
+
+  Atomic::Inc32(&m_Kill);
+
+  for(ThreadHandle thread : m_Threads)
+  {
+    JoinThread(thread);
+    CloseThread(thread);
+  }
+
+  m_Threads.clear();
+
+  for(WorkerQueue *queue : m_Queues)
+    delete queue;
+
+  m_Queues.clear();
+  m_Kill = 0;
+  m_Started = 0;
+}
+};
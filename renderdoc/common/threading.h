@@ -25,6 +25,8 @@
 
 #pragma once
 
+#include <deque>
+#include <vector>
 #include "os/os_specific.h"
 
 namespace Threading
@@ -89,6 +91,66 @@ public:
 private:
   SpinLock *m_Spin;
 };
+
+// counts the tasks submitted against it that haven't finished yet. Waiting on a group executes
+// queued work instead of blocking, so it's safe to Wait() from inside a task on the pool.
+struct TaskGroup
+{
+  volatile int32_t pending = 0;
+};
+
+// process-wide work-stealing task pool. Worker threads start lazily on the first Submit() and
+// each owns a deque: a worker pushes and pops at the back of its own deque so the most recently
+// submitted (cache-hot) tasks run locally, and steals from the front of another worker's deque
+// when its own runs dry so the oldest tasks migrate to idle threads.
+//
+// subsystems that want parallelism should submit closures against their own TaskGroup and Wait()
+// on it, rather than creating and joining threads themselves.
+class TaskPool
+{
+public:
+  // the shared pool. Don't instantiate TaskPools directly
+  static TaskPool &Instance();
+
+  // the number of worker threads, for sizing task granularity. At least 1
+  uint32_t NumWorkers();
+
+  // queues a task against the group. Tasks may run on any worker in any order, and must not
+  // depend on each other except via nested Submit()/Wait()
+  void Submit(TaskGroup &group, std::function<void()> task);
+
+  // executes queued tasks until every task submitted against the group has completed
+  void Wait(TaskGroup &group);
+
+  // drains remaining work and joins the workers. Called once at module shutdown
+  void Shutdown();
+
+private:
+  struct Task
+  {
+    std::function<void()> func;
+    TaskGroup *group;
+  };
+
+  struct WorkerQueue
+  {
+    SpinLock lock;
+    std::deque<Task> tasks;
+    uint64_t threadID = 0;
+  };
+
+  void EnsureStarted();
+  bool PopTask(size_t preferred, Task &task);
+  void RunTask(Task &task);
+  void WorkerEntry(size_t index);
+
+  CriticalSection m_SetupLock;
+  std::vector<WorkerQueue *> m_Queues;
+  std::vector<ThreadHandle> m_Threads;
+  volatile int32_t m_Started = 0;
+  volatile int32_t m_NextQueue = 0;
+  volatile int32_t m_Kill = 0;
+};
 };
 
 #define SCOPED_LOCK(cs) Threading::ScopedLock CONCAT(scopedlock, __LINE__)(&cs);
@@ -71,4 +71,74 @@ TEST_CASE("Test spin lock", "[threading]")
   CHECK(finalValue == value);
 }
 
+TEST_CASE("Test work-stealing task pool", "[threading]")
+{
+  Threading::TaskPool &pool = Threading::TaskPool::Instance();
+
+  CHECK(pool.NumWorkers() >= 1);
+
+  SECTION("many small tasks sum correctly")
+  {
+    volatile int32_t sum = 0;
+
+    Threading::TaskGroup group;
+
+    const int numTasks = 1000;
+
+    for(int i = 0; i < numTasks; i++)
+      pool.Submit(group, [&sum]() { Atomic::Inc32(&sum); });
+
+    pool.Wait(group);
+
+    CHECK(sum == numTasks);
+  }
+
+  SECTION("groups wait independently")
+  {
+    volatile int32_t countA = 0, countB = 0;
+
+    Threading::TaskGroup groupA, groupB;
+
+    for(int i = 0; i < 100; i++)
+    {
+      pool.Submit(groupA, [&countA]() { Atomic::Inc32(&countA); });
+      pool.Submit(groupB, [&countB]() {
+        Threading::Sleep(0);
+        Atomic::Inc32(&countB);
+      });
+    }
+
+    pool.Wait(groupA);
+
+    CHECK(countA == 100);
+
+    pool.Wait(groupB);
+
+    CHECK(countB == 100);
+  }
+
+  SECTION("tasks can submit and wait on nested tasks")
+  {
+    volatile int32_t leaves = 0;
+
+    Threading::TaskGroup outer;
+
+    for(int i = 0; i < 8; i++)
+    {
+      pool.Submit(outer, [&pool, &leaves]() {
+        Threading::TaskGroup inner;
+
+        for(int j = 0; j < 8; j++)
+          pool.Submit(inner, [&leaves]() { Atomic::Inc32(&leaves); });
+
+        pool.Wait(inner);
+      });
+    }
+
+    pool.Wait(outer);
+
+    CHECK(leaves == 8 * 8);
+  }
+}
+
 #endif    // ENABLED(ENABLE_UNIT_TESTS)
\ No newline at end of file
@@ -55,38 +55,19 @@ class WrappingPool
 public:
   void *Allocate()
   {
-    SCOPED_LOCK(m_Lock);
-
-    // try and allocate from immediate pool
-    void *ret = m_ImmediatePool.Allocate();
-    if(ret != NULL)
-      return ret;
-
-    // fall back to additional pools, if there are any
-    for(size_t i = 0; i < m_AdditionalPools.size(); i++)
-    {
-      ret = m_AdditionalPools[i]->Allocate();
-      if(ret != NULL)
-        return ret;
-    }
+    // common case - pop a cached free slot from this thread's magazine without locking
+    Magazine &mag = GetMagazine();
 
-// warn when we need to allocate an additional pool
-#if ENABLED(INCLUDE_TYPE_NAMES)
-    RDCWARN("Ran out of free slots in %s pool!", GetTypeName<WrapType>::Name());
-#else
-    RDCWARN("Ran out of free slots in pool 0x%p!", &m_ImmediatePool.items[0]);
-#endif
+    if(mag.count == 0)
+      RefillMagazine(mag);
 
-    // allocate a new additional pool and use that to allocate from
-    m_AdditionalPools.push_back(new ItemPool());
+    void *ret = mag.items[--mag.count];
 
-#if ENABLED(INCLUDE_TYPE_NAMES)
-    RDCDEBUG("WrappingPool[%d]<%s>: %p -> %p", (uint32_t)m_AdditionalPools.size() - 1,
-             GetTypeName<WrapType>::Name(), &m_AdditionalPools.back()->items[0],
-             &m_AdditionalPools.back()->items[AllocCount - 1]);
+#if ENABLED(RDOC_DEVEL)
+    memset(ret, 0xb0, AllocByteSize);
 #endif
 
-    return m_AdditionalPools.back()->Allocate();
+    return ret;
   }
 
   bool IsAlloc(const void *p)
@@ -114,35 +95,33 @@ public:
     if(p == NULL)
       return;
 
-    SCOPED_LOCK(m_Lock);
-
-    // try immediate pool
-    if(m_ImmediatePool.IsAlloc(p))
+#if ENABLED(RDOC_DEVEL)
+    // catch deletes through the wrong pool immediately in devel builds. In release builds this is
+    // deferred until the slot spills back to the shared pools.
+    if(!IsAlloc(p))
     {
-      m_ImmediatePool.Deallocate(p);
+#if ENABLED(INCLUDE_TYPE_NAMES)
+      RDCERR("Resource being deleted through wrong pool - 0x%p not a member of %s", p,
+             GetTypeName<WrapType>::Name());
+#else
+      RDCERR("Resource being deleted through wrong pool - 0x%p not a member of 0x%p", p,
+             &m_ImmediatePool.items[0]);
+#endif
       return;
     }
-    else if(!m_AdditionalPools.empty())
-    {
-      // fall back and try additional pools
-      for(size_t i = 0; i < m_AdditionalPools.size(); i++)
-      {
-        if(m_AdditionalPools[i]->IsAlloc(p))
-        {
-          m_AdditionalPools[i]->Deallocate(p);
-          return;
-        }
-      }
-    }
 
-// this is an error - deleting an object that we don't recognise
-#if ENABLED(INCLUDE_TYPE_NAMES)
-    RDCERR("Resource being deleted through wrong pool - 0x%p not a member of %s", p,
-           GetTypeName<WrapType>::Name());
-#else
-    RDCERR("Resource being deleted through wrong pool - 0x%p not a member of 0x%p", p,
-           &m_ImmediatePool.items[0]);
+    if(DebugClear)
+      memset(p, 0xfe, AllocByteSize);
 #endif
+
+    // common case - push the free slot onto this thread's magazine without locking
+    Magazine &mag = GetMagazine();
+    mag.pool = this;
+
+    if(mag.count == MagazineSize)
+      SpillMagazine(mag, MagazineSize / 2);
+
+    mag.items[mag.count++] = p;
   }
 
   static const size_t AllocCount = PoolCount;
@@ -170,6 +149,119 @@ private:
 
   Threading::CriticalSection m_Lock;
 
+  // per-thread magazine of free slots. The alloc/free fast path pops and pushes here without any
+  // locking, and only batches of half the magazine refill from or spill to the locked shared
+  // pools, so threads creating and destroying thousands of wrapped objects per frame don't
+  // serialise on m_Lock.
+  static const size_t MagazineSize = 32;
+
+  struct Magazine
+  {
+    ~Magazine()
+    {
+      // return any cached slots when the thread exits. The shared pool is a static member of the
+      // wrapped type, destroyed after thread-local storage during process shutdown, so it's safe
+      // to spill into it here.
+      if(pool)
+        pool->SpillMagazine(*this, count);
+    }
+
+    WrappingPool *pool = NULL;
+    void *items[MagazineSize];
+    size_t count = 0;
+  };
+
+  static Magazine &GetMagazine()
+  {
+    static thread_local Magazine mag;
+    return mag;
+  }
+
+  void RefillMagazine(Magazine &mag)
+  {
+    mag.pool = this;
+
+    SCOPED_LOCK(m_Lock);
+
+    for(size_t i = 0; i < MagazineSize / 2; i++)
+      mag.items[mag.count++] = AllocateFromPools();
+  }
+
+  void SpillMagazine(Magazine &mag, size_t spill)
+  {
+    SCOPED_LOCK(m_Lock);
+
+    for(size_t i = 0; i < spill && mag.count > 0; i++)
+      DeallocateToPools(mag.items[--mag.count]);
+  }
+
+  // allocates one slot from the shared pools, growing them if necessary. Must hold m_Lock.
+  void *AllocateFromPools()
+  {
+    // try and allocate from immediate pool
+    void *ret = m_ImmediatePool.Allocate();
+    if(ret != NULL)
+      return ret;
+
+    // fall back to additional pools, if there are any
+    for(size_t i = 0; i < m_AdditionalPools.size(); i++)
+    {
+      ret = m_AdditionalPools[i]->Allocate();
+      if(ret != NULL)
+        return ret;
+    }
+
+// warn when we need to allocate an additional pool
+#if ENABLED(INCLUDE_TYPE_NAMES)
+    RDCWARN("Ran out of free slots in %s pool!", GetTypeName<WrapType>::Name());
+#else
+    RDCWARN("Ran out of free slots in pool 0x%p!", &m_ImmediatePool.items[0]);
+#endif
+
+    // allocate a new additional pool and use that to allocate from
+    m_AdditionalPools.push_back(new ItemPool());
+
+#if ENABLED(INCLUDE_TYPE_NAMES)
+    RDCDEBUG("WrappingPool[%d]<%s>: %p -> %p", (uint32_t)m_AdditionalPools.size() - 1,
+             GetTypeName<WrapType>::Name(), &m_AdditionalPools.back()->items[0],
+             &m_AdditionalPools.back()->items[AllocCount - 1]);
+#endif
+
+    return m_AdditionalPools.back()->Allocate();
+  }
+
+  // returns one slot to whichever shared pool owns it. Must hold m_Lock.
+  void DeallocateToPools(void *p)
+  {
+    // try immediate pool
+    if(m_ImmediatePool.IsAlloc(p))
+    {
+      m_ImmediatePool.Deallocate(p);
+      return;
+    }
+    else if(!m_AdditionalPools.empty())
+    {
+      // fall back and try additional pools
+      for(size_t i = 0; i < m_AdditionalPools.size(); i++)
+      {
+        if(m_AdditionalPools[i]->IsAlloc(p))
+        {
+          m_AdditionalPools[i]->Deallocate(p);
+          return;
+        }
+      }
+    }
+
+// this is an error - deleting an object that we don't recognise
+#if ENABLED(INCLUDE_TYPE_NAMES)
+    RDCERR("Resource being deleted through wrong pool - 0x%p not a member of %s", p,
+           GetTypeName<WrapType>::Name());
+#else
+    RDCERR("Resource being deleted through wrong pool - 0x%p not a member of 0x%p", p,
+           &m_ImmediatePool.items[0]);
+#endif
+  }
+
   struct ItemPool
   {
     ItemPool()
@@ -28,6 +28,8 @@
 #include <algorithm>
 #include "api/replay/version.h"
 #include "common/common.h"
+#include "common/profiler.h"
+#include "common/threading.h"
 #include "hooks/hooks.h"
 #include "maths/formatpacking.h"
 #include "replay/replay_driver.h"
@@ -204,6 +206,7 @@ rdcstr DoStringise(const SystemChunk &el)
     STRINGISE_ENUM_CLASS_NAMED(CaptureBegin, "Beginning of Capture");
     STRINGISE_ENUM_CLASS_NAMED(CaptureScope, "Frame Metadata");
     STRINGISE_ENUM_CLASS_NAMED(CaptureEnd, "End of Capture");
+    STRINGISE_ENUM_CLASS_NAMED(InitialContentsReference, "Initial Contents Reference");
   }
   END_ENUM_STRINGISE();
 }
@@ -358,6 +361,8 @@ void RenderDoc::Initialise()
 
   m_FrameTimer.InitTimers();
 
+  CaptureProfiler::Init();
+
   m_ExHandler = NULL;
 
   {
@@ -405,6 +410,14 @@ RenderDoc::~RenderDoc()
     }
   }
 
+  if(CaptureProfiler::IsEnabled())
+  {
+    string profilePath = m_LoggingFilename + ".profile.json";
+
+    if(CaptureProfiler::WriteTrace(profilePath.c_str()))
+      RDCLOG("Wrote capture profiler trace to %s", profilePath.c_str());
+  }
+
   RDCSTOPLOGGING(m_LoggingFilename.c_str());
 
   if(m_RemoteThread)
@@ -444,6 +457,8 @@ void RenderDoc::Shutdown()
     Threading::CloseThread(m_RemoteThread);
     m_RemoteThread = 0;
   }
+
+  Threading::TaskPool::Instance().Shutdown();
 }
 
 void RenderDoc::ProcessGlobalEnvironment(GlobalEnvironment env, const std::vector<std::string> &args)
@@ -605,6 +620,8 @@ void RenderDoc::Tick()
 
   m_FrameTimer.UpdateTimers();
 
+  CaptureProfiler::BeginFrame();
+
   if(!prev_focus && cur_focus)
   {
     CycleActiveWindow();
@@ -1378,6 +1395,10 @@ void RenderDoc::FinishCaptureWriting(RDCFile *rdc, uint32_t frameNumber)
     RDCLOG("Discarded capture, Frame %u", frameNumber);
   }
 
+  // most chunks recorded for this capture have been freed by now, so return any fully-drained
+  // chunk pages rather than holding them until the next capture.
+  ChunkAllocator::ReleaseFreePages();
+
   RenderDoc::Inst().SetProgress(CaptureProgress::FileWriting, 1.0f);
 }
 
@@ -154,6 +154,7 @@ enum class SystemChunk : uint32_t
   CaptureBegin,
   CaptureScope,
   CaptureEnd,
+  InitialContentsReference,
 
   FirstDriverChunk = 1000,
 };
@@ -326,7 +327,9 @@ class RDCFile;
 typedef ReplayStatus (*RemoteDriverProvider)(RDCFile *rdc, IRemoteDriver **driver);
 typedef ReplayStatus (*ReplayDriverProvider)(RDCFile *rdc, IReplayDriver **driver);
 
-typedef void (*StructuredProcessor)(RDCFile *rdc, SDFile &structData);
+// if includeBuffers is false only the chunk tree is decompiled, and the buffer contents - usually
+// the bulk of the memory for large captures - are skipped.
+typedef void (*StructuredProcessor)(RDCFile *rdc, SDFile &structData, bool includeBuffers);
 
 typedef ReplayStatus (*CaptureImporter)(const char *filename, StreamReader &reader, RDCFile *rdc,
                                         SDFile &structData, RENDERDOC_ProgressCallback progress);
@@ -417,7 +420,8 @@ public:
   const string &GetConfigSetting(string name) { return m_ConfigSettings[name]; }
   void SetConfigSetting(string name, string value) { m_ConfigSettings[name] = value; }
   void BecomeRemoteServer(const char *listenhost, uint16_t port, RENDERDOC_KillCallback killReplay,
-                          RENDERDOC_PreviewWindowCallback previewWindow);
+                          RENDERDOC_PreviewWindowCallback previewWindow,
+                          const char *preloadCapture = NULL);
 
   DriverInformation GetDriverInformation(GraphicsAPI api);
 
@@ -550,6 +554,9 @@ public:
   }
 
   void TriggerCapture(uint32_t numFrames) { m_Cap = numFrames; }
+  // returns true if more frames of a multi-frame TriggerCapture() burst are still queued to be
+  // captured back-to-back after the current one
+  bool HasQueuedCaptureFrames() { return m_Cap > 0; }
   uint32_t GetOverlayBits() { return m_Overlay; }
   void MaskOverlayBits(uint32_t And, uint32_t Or) { m_Overlay = (m_Overlay & And) | Or; }
   void QueueCapture(uint32_t frameNumber) { m_QueuedFrameCaptures.insert(frameNumber); }
@@ -39,19 +39,39 @@ public:
   {
     m_ExHandler = NULL;
 
-    google_breakpad::AppMemoryList mem;
-
     _CrtSetReportMode(_CRT_ASSERT, 0);
 
+    bool createServer = (existing == NULL);
+
     if(existing)
     {
       CrashHandler *crash = ((CrashHandler *)existing);
+
+      // the previous handler's connection may still be in flight on its background thread -
+      // wait for it, so we can take over its server and registered memory regions.
+      crash->WaitForInit();
+
       m_PipeName = crash->m_PipeName;
-      mem = crash->m_ExHandler->QueryRegisteredAppMemory();
+
+      google_breakpad::AppMemoryList mem = crash->m_ExHandler->QueryRegisteredAppMemory();
+
+      for(size_t i = 0; i < mem.size(); i++)
+        m_PendingRegions.push_back(std::make_pair((void *)mem[i].ptr, (size_t)mem[i].length));
+
       RDCLOG("Re-using crash-handling server %ls", m_PipeName.c_str());
       SAFE_DELETE(existing);
     }
-    else
+
+    // launching the server and connecting breakpad takes long enough to show up in injected
+    // application startup, so it happens on a thread. Until the thread finishes, memory region
+    // registrations queue up in m_PendingRegions - the only cost is that a crash in the first
+    // fraction of a second produces no minidump.
+    m_InitThread = Threading::CreateThread([this, createServer]() { Init(createServer); });
+  }
+
+  void Init(bool createServer)
+  {
+    if(createServer)
     {
       m_PipeName = NewPipeName();
       CreateCrashHandlingServer();
@@ -89,32 +109,52 @@ public:
 
     RDCLOG("Connecting to server %ls", m_PipeName.c_str());
 
-    m_ExHandler = new google_breakpad::ExceptionHandler(
+    google_breakpad::ExceptionHandler *handler = new google_breakpad::ExceptionHandler(
         dumpFolder.c_str(), NULL, NULL, NULL, google_breakpad::ExceptionHandler::HANDLER_ALL,
         dumpType, m_PipeName.c_str(), &custom);
 
-    if(!m_ExHandler->IsOutOfProcess())
+    if(!handler->IsOutOfProcess())
     {
       RDCWARN("Couldn't connect to existing breakpad server");
 
-      SAFE_DELETE(m_ExHandler);
+      SAFE_DELETE(handler);
 
       m_PipeName = NewPipeName();
 
       CreateCrashHandlingServer();
 
-      m_ExHandler = new google_breakpad::ExceptionHandler(
+      handler = new google_breakpad::ExceptionHandler(
           dumpFolder.c_str(), NULL, NULL, NULL, google_breakpad::ExceptionHandler::HANDLER_ALL,
           dumpType, m_PipeName.c_str(), &custom);
 
-      if(!m_ExHandler->IsOutOfProcess())
+      if(!handler->IsOutOfProcess())
         RDCERR("Couldn't launch and connect to new breakpad server");
     }
 
-    m_ExHandler->set_handle_debug_exceptions(true);
+    handler->set_handle_debug_exceptions(true);
+
+    {
+      SCOPED_LOCK(m_PendingLock);
+
+      for(size_t i = 0; i < m_PendingRegions.size(); i++)
+        handler->RegisterAppMemory(m_PendingRegions[i].first, m_PendingRegions[i].second);
+
+      m_PendingRegions.clear();
 
-    for(size_t i = 0; i < mem.size(); i++)
-      m_ExHandler->RegisterAppMemory((void *)mem[i].ptr, mem[i].length);
+      // published under the lock, so registrations racing with the end of init either make the
+      // loop above or see the handler
+      m_ExHandler = handler;
+    }
+  }
+
+  void WaitForInit()
+  {
+    if(m_InitThread)
+    {
+      Threading::JoinThread(m_InitThread);
+      Threading::CloseThread(m_InitThread);
+      m_InitThread = 0;
+    }
   }
 
   void CreateCrashHandlingServer()
@@ -178,12 +218,53 @@ public:
     RDCLOG("Created crash-handling server %ls", m_PipeName.c_str());
   }
 
-  virtual ~CrashHandler() { SAFE_DELETE(m_ExHandler); }
-  void RegisterMemoryRegion(void *mem, size_t size) { m_ExHandler->RegisterAppMemory(mem, size); }
-  void UnregisterMemoryRegion(void *mem) { m_ExHandler->UnregisterAppMemory(mem); }
+  virtual ~CrashHandler()
+  {
+    WaitForInit();
+    SAFE_DELETE(m_ExHandler);
+  }
+
+  void RegisterMemoryRegion(void *mem, size_t size)
+  {
+    SCOPED_LOCK(m_PendingLock);
+
+    if(!m_ExHandler)
+    {
+      m_PendingRegions.push_back(std::make_pair(mem, size));
+      return;
+    }
+
+    m_ExHandler->RegisterAppMemory(mem, size);
+  }
+
+  void UnregisterMemoryRegion(void *mem)
+  {
+    SCOPED_LOCK(m_PendingLock);
+
+    if(!m_ExHandler)
+    {
+      for(auto it = m_PendingRegions.begin(); it != m_PendingRegions.end(); ++it)
+      {
+        if(it->first == mem)
+        {
+          m_PendingRegions.erase(it);
+          break;
+        }
+      }
+      return;
+    }
+
+    m_ExHandler->UnregisterAppMemory(mem);
+  }
+
 private:
   std::wstring m_PipeName;
   google_breakpad::ExceptionHandler *m_ExHandler;
+  Threading::ThreadHandle m_InitThread = 0;
+
+  // memory regions registered before the background init finished, applied when it does
+  Threading::CriticalSection m_PendingLock;
+  std::vector<std::pair<void *, size_t>> m_PendingRegions;
 
   std::wstring NewPipeName()
   {
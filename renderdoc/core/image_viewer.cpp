@@ -23,6 +23,7 @@
  ******************************************************************************/
 
 #include "common/dds_readwrite.h"
+#include "common/threading.h"
 #include "core/core.h"
 #include "replay/replay_driver.h"
 #include "serialise/rdcfile.h"
@@ -576,19 +577,37 @@ void ImageViewer::RefreshFile()
     float *rgba = (float *)data;
     float **src = (float **)exrImage.images;
 
-    for(uint32_t i = 0; i < texDetails.width * texDetails.height; i++)
+    // interleaving the planar channels of a large image touches gigabytes of memory, so split
+    // the rows into tasks across the worker pool.
+    const uint32_t width = texDetails.width;
+    const uint32_t numTasks =
+        RDCMIN(Threading::TaskPool::Instance().NumWorkers() * 4, texDetails.height);
+
+    Threading::TaskGroup group;
+
+    for(uint32_t task = 0; task < numTasks; task++)
     {
-      for(int c = 0; c < 4; c++)
-      {
-        if(channels[c] >= 0)
-          rgba[i * 4 + c] = src[channels[c]][i];
-        else if(c < 3)    // RGB channels default to 0
-          rgba[i * 4 + c] = 0.0f;
-        else    // alpha defaults to 1
-          rgba[i * 4 + c] = 1.0f;
-      }
+      const uint32_t firstTexel = width * (texDetails.height * task / numTasks);
+      const uint32_t lastTexel = width * (texDetails.height * (task + 1) / numTasks);
+
+      Threading::TaskPool::Instance().Submit(group, [=]() {
+        for(uint32_t i = firstTexel; i < lastTexel; i++)
+        {
+          for(int c = 0; c < 4; c++)
+          {
+            if(channels[c] >= 0)
+              rgba[i * 4 + c] = src[channels[c]][i];
+            else if(c < 3)    // RGB channels default to 0
+              rgba[i * 4 + c] = 0.0f;
+            else    // alpha defaults to 1
+              rgba[i * 4 + c] = 1.0f;
+          }
+        }
+      });
     }
 
+    Threading::TaskPool::Instance().Wait(group);
+
     FreeEXRImage(&exrImage);
 
     // shouldn't get here but let's be safe
@@ -39,7 +39,8 @@ struct Interval
   uint64_t end;
 };
 
-void check_intervals(Intervals<uint64_t> &value, const std::vector<Interval> &expected)
+template <typename IntervalsType>
+void check_intervals(IntervalsType &value, const std::vector<Interval> &expected)
 {
   auto i = value.begin();
   auto j = expected.begin();
@@ -53,9 +54,10 @@ void check_intervals(Intervals<uint64_t> &value, const std::vector<Interval> &ex
   CHECK((j == expected.end()));
 }
 
-Intervals<uint64_t> make_intervals(const std::vector<Interval> &intervals)
+template <typename IntervalsType>
+IntervalsType make_intervals(const std::vector<Interval> &intervals)
 {
-  Intervals<uint64_t> res;
+  IntervalsType res;
   for(auto i = intervals.begin(); i != intervals.end(); i++)
   {
     auto j = res.end();
@@ -73,76 +75,87 @@ Intervals<uint64_t> make_intervals(const std::vector<Interval> &intervals)
   return res;
 }
 
-TEST_CASE("Test Intervals type", "[intervals]")
+// the conformance suite, run over both the map-backed Intervals and the flat-array
+// FlatIntervals so the two implementations can't drift apart.
+template <typename IntervalsType>
+static void RunIntervalsTestSuite()
 {
   SECTION("update tests")
   {
     SECTION("empty Intervals")
     {
-      Intervals<uint64_t> test;
+      IntervalsType test;
       check_intervals(test, {{0, 0, UINT64_MAX}});
     };
 
     SECTION("update a sub-interval")
     {
-      Intervals<uint64_t> test;
+      IntervalsType test;
       test.update(5, 10, 1, [](uint64_t x, uint64_t y) -> uint64_t { return x + y; });
       check_intervals(test, {{0, 0, 5}, {5, 1, 10}, {10, 0, UINT64_MAX}});
     };
 
     SECTION("update a sub-interval matching on the left")
     {
-      Intervals<uint64_t> test = make_intervals({{0, 0, 5}, {5, 1, 10}, {10, 0, UINT64_MAX}});
+      IntervalsType test =
+          make_intervals<IntervalsType>({{0, 0, 5}, {5, 1, 10}, {10, 0, UINT64_MAX}});
       test.update(5, 7, 1, [](uint64_t x, uint64_t y) -> uint64_t { return x + y; });
       check_intervals(test, {{0, 0, 5}, {5, 2, 7}, {7, 1, 10}, {10, 0, UINT64_MAX}});
     };
 
     SECTION("update a sub-interval matching on the right")
     {
-      Intervals<uint64_t> test = make_intervals({{0, 0, 5}, {5, 1, 10}, {10, 0, UINT64_MAX}});
+      IntervalsType test =
+          make_intervals<IntervalsType>({{0, 0, 5}, {5, 1, 10}, {10, 0, UINT64_MAX}});
       test.update(7, 10, 1, [](uint64_t x, uint64_t y) -> uint64_t { return x + y; });
       check_intervals(test, {{0, 0, 5}, {5, 1, 7}, {7, 2, 10}, {10, 0, UINT64_MAX}});
     };
 
     SECTION("update an interval that exactly matches an existing interval")
     {
-      Intervals<uint64_t> test = make_intervals({{0, 0, 5}, {5, 1, 10}, {10, 0, UINT64_MAX}});
+      IntervalsType test =
+          make_intervals<IntervalsType>({{0, 0, 5}, {5, 1, 10}, {10, 0, UINT64_MAX}});
       test.update(5, 10, 1, [](uint64_t x, uint64_t y) -> uint64_t { return x + y; });
       check_intervals(test, {{0, 0, 5}, {5, 2, 10}, {10, 0, UINT64_MAX}});
     };
 
     SECTION("update a properly overlapping interval")
     {
-      Intervals<uint64_t> test = make_intervals({{0, 0, 5}, {5, 1, 10}, {10, 0, UINT64_MAX}});
+      IntervalsType test =
+          make_intervals<IntervalsType>({{0, 0, 5}, {5, 1, 10}, {10, 0, UINT64_MAX}});
       test.update(7, 15, 1, [](uint64_t x, uint64_t y) -> uint64_t { return x + y; });
       check_intervals(test, {{0, 0, 5}, {5, 1, 7}, {7, 2, 10}, {10, 1, 15}, {15, 0, UINT64_MAX}});
     };
 
     SECTION("update a super-interval")
     {
-      Intervals<uint64_t> test = make_intervals({{0, 0, 5}, {5, 1, 10}, {10, 0, UINT64_MAX}});
+      IntervalsType test =
+          make_intervals<IntervalsType>({{0, 0, 5}, {5, 1, 10}, {10, 0, UINT64_MAX}});
       test.update(2, 15, 1, [](uint64_t x, uint64_t y) -> uint64_t { return x + y; });
       check_intervals(test, {{0, 0, 2}, {2, 1, 5}, {5, 2, 10}, {10, 1, 15}, {15, 0, UINT64_MAX}});
     };
 
     SECTION("update a super-interval matching on the left")
     {
-      Intervals<uint64_t> test = make_intervals({{0, 0, 5}, {5, 1, 10}, {10, 0, UINT64_MAX}});
+      IntervalsType test =
+          make_intervals<IntervalsType>({{0, 0, 5}, {5, 1, 10}, {10, 0, UINT64_MAX}});
       test.update(5, 15, 1, [](uint64_t x, uint64_t y) -> uint64_t { return x + y; });
       check_intervals(test, {{0, 0, 5}, {5, 2, 10}, {10, 1, 15}, {15, 0, UINT64_MAX}});
     };
 
     SECTION("update a super-interval matching on the right")
     {
-      Intervals<uint64_t> test = make_intervals({{0, 0, 5}, {5, 1, 10}, {10, 0, UINT64_MAX}});
+      IntervalsType test =
+          make_intervals<IntervalsType>({{0, 0, 5}, {5, 1, 10}, {10, 0, UINT64_MAX}});
       test.update(2, 10, 1, [](uint64_t x, uint64_t y) -> uint64_t { return x + y; });
       check_intervals(test, {{0, 0, 2}, {2, 1, 5}, {5, 2, 10}, {10, 0, UINT64_MAX}});
     };
 
     SECTION("update overlapping 2 intervals")
     {
-      Intervals<uint64_t> test =
-          make_intervals({{0, 0, 5}, {5, 1, 10}, {10, 0, 20}, {20, 10, 30}, {30, 0, UINT64_MAX}});
+      IntervalsType test =
+          make_intervals<IntervalsType>(
+              {{0, 0, 5}, {5, 1, 10}, {10, 0, 20}, {20, 10, 30}, {30, 0, UINT64_MAX}});
       test.update(7, 25, 1, [](uint64_t x, uint64_t y) -> uint64_t { return x + y; });
       check_intervals(test, {{0, 0, 5},
                              {5, 1, 7},
@@ -155,8 +168,9 @@ TEST_CASE("Test Intervals type", "[intervals]")
 
     SECTION("update overlapping 2 intervals matching on start of leftmost interval")
     {
-      Intervals<uint64_t> test =
-          make_intervals({{0, 0, 5}, {5, 1, 10}, {10, 0, 20}, {20, 10, 30}, {30, 0, UINT64_MAX}});
+      IntervalsType test =
+          make_intervals<IntervalsType>(
+              {{0, 0, 5}, {5, 1, 10}, {10, 0, 20}, {20, 10, 30}, {30, 0, UINT64_MAX}});
       test.update(5, 25, 1, [](uint64_t x, uint64_t y) -> uint64_t { return x + y; });
       check_intervals(
           test,
@@ -165,8 +179,9 @@ TEST_CASE("Test Intervals type", "[intervals]")
 
     SECTION("update overlapping 2 intervals matching on end of leftmost interval")
     {
-      Intervals<uint64_t> test =
-          make_intervals({{0, 0, 5}, {5, 5, 10}, {10, 0, 20}, {20, 10, 30}, {30, 0, UINT64_MAX}});
+      IntervalsType test =
+          make_intervals<IntervalsType>(
+              {{0, 0, 5}, {5, 5, 10}, {10, 0, 20}, {20, 10, 30}, {30, 0, UINT64_MAX}});
       test.update(10, 25, 1, [](uint64_t x, uint64_t y) -> uint64_t { return x + y; });
       check_intervals(
           test,
@@ -175,8 +190,9 @@ TEST_CASE("Test Intervals type", "[intervals]")
 
     SECTION("update overlapping 2 intervals matching on start of rightmost interval")
     {
-      Intervals<uint64_t> test =
-          make_intervals({{0, 0, 5}, {5, 1, 10}, {10, 0, 20}, {20, 10, 30}, {30, 0, UINT64_MAX}});
+      IntervalsType test =
+          make_intervals<IntervalsType>(
+              {{0, 0, 5}, {5, 1, 10}, {10, 0, 20}, {20, 10, 30}, {30, 0, UINT64_MAX}});
       test.update(7, 20, 1, [](uint64_t x, uint64_t y) -> uint64_t { return x + y; });
       check_intervals(
           test, {{0, 0, 5}, {5, 1, 7}, {7, 2, 10}, {10, 1, 20}, {20, 10, 30}, {30, 0, UINT64_MAX}});
@@ -184,8 +200,9 @@ TEST_CASE("Test Intervals type", "[intervals]")
 
     SECTION("update overlapping 2 intervals matching on end of rightmost interval")
     {
-      Intervals<uint64_t> test =
-          make_intervals({{0, 0, 5}, {5, 1, 10}, {10, 0, 20}, {20, 10, 30}, {30, 0, UINT64_MAX}});
+      IntervalsType test =
+          make_intervals<IntervalsType>(
+              {{0, 0, 5}, {5, 1, 10}, {10, 0, 20}, {20, 10, 30}, {30, 0, UINT64_MAX}});
       test.update(7, 30, 1, [](uint64_t x, uint64_t y) -> uint64_t { return x + y; });
       check_intervals(
           test, {{0, 0, 5}, {5, 1, 7}, {7, 2, 10}, {10, 1, 20}, {20, 11, 30}, {30, 0, UINT64_MAX}});
@@ -193,35 +210,39 @@ TEST_CASE("Test Intervals type", "[intervals]")
 
     SECTION("update triggering merge on left")
     {
-      Intervals<uint64_t> test = make_intervals({{0, 0, 5}, {5, 1, 10}, {10, 0, UINT64_MAX}});
+      IntervalsType test =
+          make_intervals<IntervalsType>({{0, 0, 5}, {5, 1, 10}, {10, 0, UINT64_MAX}});
       test.update(10, 20, 1, [](uint64_t x, uint64_t y) -> uint64_t { return x + y; });
       check_intervals(test, {{0, 0, 5}, {5, 1, 20}, {20, 0, UINT64_MAX}});
     };
 
     SECTION("update triggering merge on right")
     {
-      Intervals<uint64_t> test = make_intervals({{0, 0, 5}, {5, 1, 10}, {10, 0, UINT64_MAX}});
+      IntervalsType test =
+          make_intervals<IntervalsType>({{0, 0, 5}, {5, 1, 10}, {10, 0, UINT64_MAX}});
       test.update(2, 5, 1, [](uint64_t x, uint64_t y) -> uint64_t { return x + y; });
       check_intervals(test, {{0, 0, 2}, {2, 1, 10}, {10, 0, UINT64_MAX}});
     };
 
     SECTION("overlapping update triggering merge on left")
     {
-      Intervals<uint64_t> test = make_intervals({{0, 0, 5}, {5, 1, 10}, {10, 0, UINT64_MAX}});
+      IntervalsType test =
+          make_intervals<IntervalsType>({{0, 0, 5}, {5, 1, 10}, {10, 0, UINT64_MAX}});
       test.update(7, 20, 1, [](uint64_t, uint64_t) -> uint64_t { return 1; });
       check_intervals(test, {{0, 0, 5}, {5, 1, 20}, {20, 0, UINT64_MAX}});
     };
 
     SECTION("overlapping update triggering merge on right")
     {
-      Intervals<uint64_t> test = make_intervals({{0, 0, 5}, {5, 1, 10}, {10, 0, UINT64_MAX}});
+      IntervalsType test =
+          make_intervals<IntervalsType>({{0, 0, 5}, {5, 1, 10}, {10, 0, UINT64_MAX}});
       test.update(2, 7, 1, [](uint64_t, uint64_t) -> uint64_t { return 1; });
       check_intervals(test, {{0, 0, 2}, {2, 1, 10}, {10, 0, UINT64_MAX}});
     };
 
     SECTION("update triggering multiple merges")
     {
-      Intervals<uint64_t> test = make_intervals(
+      IntervalsType test = make_intervals<IntervalsType>(
           {{0, 0, 5}, {5, 1, 10}, {10, 0, 12}, {12, 5, 18}, {18, 0, 20}, {20, 1, 30}, {30, 0, UINT64_MAX}});
       test.update(7, 25, 1, [](uint64_t, uint64_t) -> uint64_t { return 1; });
       check_intervals(test, {{0, 0, 5}, {5, 1, 30}, {30, 0, UINT64_MAX}});
@@ -230,7 +251,7 @@ TEST_CASE("Test Intervals type", "[intervals]")
     SECTION(
         "update triggering multiple merges, including merge with non-overlapping interval on left")
     {
-      Intervals<uint64_t> test = make_intervals(
+      IntervalsType test = make_intervals<IntervalsType>(
           {{0, 0, 5}, {5, 1, 10}, {10, 0, 12}, {12, 5, 18}, {18, 0, 20}, {20, 1, 30}, {30, 0, UINT64_MAX}});
       test.update(10, 25, 1, [](uint64_t, uint64_t) -> uint64_t { return 1; });
       check_intervals(test, {{0, 0, 5}, {5, 1, 30}, {30, 0, UINT64_MAX}});
@@ -239,7 +260,7 @@ TEST_CASE("Test Intervals type", "[intervals]")
     SECTION(
         "update triggering multiple merges, including merge with non-overlapping interval on right")
     {
-      Intervals<uint64_t> test = make_intervals(
+      IntervalsType test = make_intervals<IntervalsType>(
           {{0, 0, 5}, {5, 1, 10}, {10, 0, 12}, {12, 5, 18}, {18, 0, 20}, {20, 1, 30}, {30, 0, UINT64_MAX}});
       test.update(7, 20, 1, [](uint64_t, uint64_t) -> uint64_t { return 1; });
       check_intervals(test, {{0, 0, 5}, {5, 1, 30}, {30, 0, UINT64_MAX}});
@@ -247,49 +268,56 @@ TEST_CASE("Test Intervals type", "[intervals]")
 
     SECTION("update a interval starting at 0")
     {
-      Intervals<uint64_t> test = make_intervals({{0, 0, 5}, {5, 1, 10}, {10, 0, UINT64_MAX}});
+      IntervalsType test =
+          make_intervals<IntervalsType>({{0, 0, 5}, {5, 1, 10}, {10, 0, UINT64_MAX}});
       test.update(0, 10, 1, [](uint64_t x, uint64_t y) -> uint64_t { return x + y; });
       check_intervals(test, {{0, 1, 5}, {5, 2, 10}, {10, 0, UINT64_MAX}});
     };
 
     SECTION("update a interval finishing at UINT64_MAX")
     {
-      Intervals<uint64_t> test = make_intervals({{0, 0, 5}, {5, 1, 10}, {10, 0, UINT64_MAX}});
+      IntervalsType test =
+          make_intervals<IntervalsType>({{0, 0, 5}, {5, 1, 10}, {10, 0, UINT64_MAX}});
       test.update(5, UINT64_MAX, 1, [](uint64_t x, uint64_t y) -> uint64_t { return x + y; });
       check_intervals(test, {{0, 0, 5}, {5, 2, 10}, {10, 1, UINT64_MAX}});
     };
 
     SECTION("update entire range")
     {
-      Intervals<uint64_t> test = make_intervals({{0, 0, 5}, {5, 1, 10}, {10, 0, UINT64_MAX}});
+      IntervalsType test =
+          make_intervals<IntervalsType>({{0, 0, 5}, {5, 1, 10}, {10, 0, UINT64_MAX}});
       test.update(0, UINT64_MAX, 1, [](uint64_t x, uint64_t y) -> uint64_t { return x + y; });
       check_intervals(test, {{0, 1, 5}, {5, 2, 10}, {10, 1, UINT64_MAX}});
     };
 
     SECTION("update an empty interval in the interior of an interval")
     {
-      Intervals<uint64_t> test = make_intervals({{0, 0, 5}, {5, 1, 10}, {10, 0, UINT64_MAX}});
+      IntervalsType test =
+          make_intervals<IntervalsType>({{0, 0, 5}, {5, 1, 10}, {10, 0, UINT64_MAX}});
       test.update(2, 2, 1, [](uint64_t x, uint64_t y) -> uint64_t { return x + y; });
       check_intervals(test, {{0, 0, 5}, {5, 1, 10}, {10, 0, UINT64_MAX}});
     };
 
     SECTION("update an empty interval on a boundary")
     {
-      Intervals<uint64_t> test = make_intervals({{0, 0, 5}, {5, 1, 10}, {10, 0, UINT64_MAX}});
+      IntervalsType test =
+          make_intervals<IntervalsType>({{0, 0, 5}, {5, 1, 10}, {10, 0, UINT64_MAX}});
       test.update(5, 5, 1, [](uint64_t x, uint64_t y) -> uint64_t { return x + y; });
       check_intervals(test, {{0, 0, 5}, {5, 1, 10}, {10, 0, UINT64_MAX}});
     };
 
     SECTION("update an empty interval at 0")
     {
-      Intervals<uint64_t> test = make_intervals({{0, 0, 5}, {5, 1, 10}, {10, 0, UINT64_MAX}});
+      IntervalsType test =
+          make_intervals<IntervalsType>({{0, 0, 5}, {5, 1, 10}, {10, 0, UINT64_MAX}});
       test.update(0, 0, 1, [](uint64_t x, uint64_t y) -> uint64_t { return x + y; });
       check_intervals(test, {{0, 0, 5}, {5, 1, 10}, {10, 0, UINT64_MAX}});
     };
 
     SECTION("update an empty interval at UINT64_MAX")
     {
-      Intervals<uint64_t> test = make_intervals({{0, 0, 5}, {5, 1, 10}, {10, 0, UINT64_MAX}});
+      IntervalsType test =
+          make_intervals<IntervalsType>({{0, 0, 5}, {5, 1, 10}, {10, 0, UINT64_MAX}});
       test.update(UINT64_MAX, UINT64_MAX, 1,
                   [](uint64_t x, uint64_t y) -> uint64_t { return x + y; });
       check_intervals(test, {{0, 0, 5}, {5, 1, 10}, {10, 0, UINT64_MAX}});
@@ -300,20 +328,24 @@ TEST_CASE("Test Intervals type", "[intervals]")
   {
     SECTION("merge matching intervals")
     {
-      Intervals<uint64_t> test =
-          make_intervals({{0, 0, 10}, {10, 1, 20}, {20, 0, 30}, {30, 1, 40}, {40, 0, UINT64_MAX}});
-      Intervals<uint64_t> other =
-          make_intervals({{0, 0, 10}, {10, 1, 20}, {20, 0, 30}, {30, 1, 40}, {40, 0, UINT64_MAX}});
+      IntervalsType test =
+          make_intervals<IntervalsType>(
+              {{0, 0, 10}, {10, 1, 20}, {20, 0, 30}, {30, 1, 40}, {40, 0, UINT64_MAX}});
+      IntervalsType other =
+          make_intervals<IntervalsType>(
+              {{0, 0, 10}, {10, 1, 20}, {20, 0, 30}, {30, 1, 40}, {40, 0, UINT64_MAX}});
       test.merge(other, [](uint64_t x, uint64_t y) -> uint64_t { return x + y; });
       check_intervals(test, {{0, 0, 10}, {10, 2, 20}, {20, 0, 30}, {30, 2, 40}, {40, 0, UINT64_MAX}});
     };
 
     SECTION("merge shifted intervals")
     {
-      Intervals<uint64_t> test =
-          make_intervals({{0, 0, 10}, {10, 1, 20}, {20, 0, 30}, {30, 1, 40}, {40, 0, UINT64_MAX}});
-      Intervals<uint64_t> other =
-          make_intervals({{0, 0, 5}, {5, 1, 15}, {15, 0, 25}, {25, 1, 35}, {35, 0, UINT64_MAX}});
+      IntervalsType test =
+          make_intervals<IntervalsType>(
+              {{0, 0, 10}, {10, 1, 20}, {20, 0, 30}, {30, 1, 40}, {40, 0, UINT64_MAX}});
+      IntervalsType other =
+          make_intervals<IntervalsType>(
+              {{0, 0, 5}, {5, 1, 15}, {15, 0, 25}, {25, 1, 35}, {35, 0, UINT64_MAX}});
       test.merge(other, [](uint64_t x, uint64_t y) -> uint64_t { return x + y; });
       check_intervals(test, {{0, 0, 5},
                              {5, 1, 10},
@@ -328,27 +360,31 @@ TEST_CASE("Test Intervals type", "[intervals]")
 
     SECTION("merge into empty intervals")
     {
-      Intervals<uint64_t> test = make_intervals({{0, 0, UINT64_MAX}});
-      Intervals<uint64_t> other =
-          make_intervals({{0, 0, 5}, {5, 1, 15}, {15, 0, 25}, {25, 1, 35}, {35, 0, UINT64_MAX}});
+      IntervalsType test = make_intervals<IntervalsType>({{0, 0, UINT64_MAX}});
+      IntervalsType other =
+          make_intervals<IntervalsType>(
+              {{0, 0, 5}, {5, 1, 15}, {15, 0, 25}, {25, 1, 35}, {35, 0, UINT64_MAX}});
       test.merge(other, [](uint64_t x, uint64_t y) -> uint64_t { return x + y; });
       check_intervals(test, {{0, 0, 5}, {5, 1, 15}, {15, 0, 25}, {25, 1, 35}, {35, 0, UINT64_MAX}});
     };
 
     SECTION("merge with empty intervals")
     {
-      Intervals<uint64_t> test =
-          make_intervals({{0, 0, 5}, {5, 1, 15}, {15, 0, 25}, {25, 1, 35}, {35, 0, UINT64_MAX}});
-      Intervals<uint64_t> other = make_intervals({{0, 0, UINT64_MAX}});
+      IntervalsType test =
+          make_intervals<IntervalsType>(
+              {{0, 0, 5}, {5, 1, 15}, {15, 0, 25}, {25, 1, 35}, {35, 0, UINT64_MAX}});
+      IntervalsType other = make_intervals<IntervalsType>({{0, 0, UINT64_MAX}});
       test.merge(other, [](uint64_t x, uint64_t y) -> uint64_t { return x + y; });
       check_intervals(test, {{0, 0, 5}, {5, 1, 15}, {15, 0, 25}, {25, 1, 35}, {35, 0, UINT64_MAX}});
     };
 
     SECTION("merge into single interval")
     {
-      Intervals<uint64_t> test = make_intervals({{0, 0, 10}, {10, 1, 30}, {30, 0, UINT64_MAX}});
-      Intervals<uint64_t> other =
-          make_intervals({{0, 0, 5}, {5, 1, 15}, {15, 0, 25}, {25, 1, 35}, {35, 0, UINT64_MAX}});
+      IntervalsType test = make_intervals<IntervalsType>(
+          {{0, 0, 10}, {10, 1, 30}, {30, 0, UINT64_MAX}});
+      IntervalsType other =
+          make_intervals<IntervalsType>(
+              {{0, 0, 5}, {5, 1, 15}, {15, 0, 25}, {25, 1, 35}, {35, 0, UINT64_MAX}});
       test.merge(other, [](uint64_t x, uint64_t y) -> uint64_t { return x + y; });
       check_intervals(test, {{0, 0, 5},
                              {5, 1, 10},
@@ -361,9 +397,11 @@ TEST_CASE("Test Intervals type", "[intervals]")
 
     SECTION("merge with single interval")
     {
-      Intervals<uint64_t> test =
-          make_intervals({{0, 0, 5}, {5, 1, 15}, {15, 0, 25}, {25, 1, 35}, {35, 0, UINT64_MAX}});
-      Intervals<uint64_t> other = make_intervals({{0, 0, 10}, {10, 1, 30}, {30, 0, UINT64_MAX}});
+      IntervalsType test =
+          make_intervals<IntervalsType>(
+              {{0, 0, 5}, {5, 1, 15}, {15, 0, 25}, {25, 1, 35}, {35, 0, UINT64_MAX}});
+      IntervalsType other = make_intervals<IntervalsType>(
+          {{0, 0, 10}, {10, 1, 30}, {30, 0, UINT64_MAX}});
       test.merge(other, [](uint64_t x, uint64_t y) -> uint64_t { return x + y; });
       check_intervals(test, {{0, 0, 5},
                              {5, 1, 10},
@@ -376,10 +414,12 @@ TEST_CASE("Test Intervals type", "[intervals]")
 
     SECTION("merge disjoint before")
     {
-      Intervals<uint64_t> test =
-          make_intervals({{0, 0, 50}, {50, 1, 60}, {60, 0, 70}, {70, 1, 80}, {80, 0, UINT64_MAX}});
-      Intervals<uint64_t> other =
-          make_intervals({{0, 0, 10}, {10, 1, 20}, {20, 0, 30}, {30, 1, 40}, {40, 0, UINT64_MAX}});
+      IntervalsType test =
+          make_intervals<IntervalsType>(
+              {{0, 0, 50}, {50, 1, 60}, {60, 0, 70}, {70, 1, 80}, {80, 0, UINT64_MAX}});
+      IntervalsType other =
+          make_intervals<IntervalsType>(
+              {{0, 0, 10}, {10, 1, 20}, {20, 0, 30}, {30, 1, 40}, {40, 0, UINT64_MAX}});
       test.merge(other, [](uint64_t x, uint64_t y) -> uint64_t { return x + y; });
       check_intervals(test, {{0, 0, 10},
                              {10, 1, 20},
@@ -394,10 +434,12 @@ TEST_CASE("Test Intervals type", "[intervals]")
 
     SECTION("merge disjoint after")
     {
-      Intervals<uint64_t> test =
-          make_intervals({{0, 0, 10}, {10, 1, 20}, {20, 0, 30}, {30, 1, 40}, {40, 0, UINT64_MAX}});
-      Intervals<uint64_t> other =
-          make_intervals({{0, 0, 50}, {50, 1, 60}, {60, 0, 70}, {70, 1, 80}, {80, 0, UINT64_MAX}});
+      IntervalsType test =
+          make_intervals<IntervalsType>(
+              {{0, 0, 10}, {10, 1, 20}, {20, 0, 30}, {30, 1, 40}, {40, 0, UINT64_MAX}});
+      IntervalsType other =
+          make_intervals<IntervalsType>(
+              {{0, 0, 50}, {50, 1, 60}, {60, 0, 70}, {70, 1, 80}, {80, 0, UINT64_MAX}});
       test.merge(other, [](uint64_t x, uint64_t y) -> uint64_t { return x + y; });
       check_intervals(test, {{0, 0, 10},
                              {10, 1, 20},
@@ -412,10 +454,12 @@ TEST_CASE("Test Intervals type", "[intervals]")
 
     SECTION("merge disjoint interleaved")
     {
-      Intervals<uint64_t> test =
-          make_intervals({{0, 0, 10}, {10, 1, 20}, {20, 0, 50}, {50, 1, 60}, {60, 0, UINT64_MAX}});
-      Intervals<uint64_t> other =
-          make_intervals({{0, 0, 30}, {30, 1, 40}, {40, 0, 70}, {70, 1, 80}, {80, 0, UINT64_MAX}});
+      IntervalsType test =
+          make_intervals<IntervalsType>(
+              {{0, 0, 10}, {10, 1, 20}, {20, 0, 50}, {50, 1, 60}, {60, 0, UINT64_MAX}});
+      IntervalsType other =
+          make_intervals<IntervalsType>(
+              {{0, 0, 30}, {30, 1, 40}, {40, 0, 70}, {70, 1, 80}, {80, 0, UINT64_MAX}});
       test.merge(other, [](uint64_t x, uint64_t y) -> uint64_t { return x + y; });
       check_intervals(test, {{0, 0, 10},
                              {10, 1, 20},
@@ -430,14 +474,26 @@ TEST_CASE("Test Intervals type", "[intervals]")
 
     SECTION("merge disjoint interleaved touching")
     {
-      Intervals<uint64_t> test =
-          make_intervals({{0, 0, 10}, {10, 1, 20}, {20, 0, 30}, {30, 1, 40}, {40, 0, UINT64_MAX}});
-      Intervals<uint64_t> other =
-          make_intervals({{0, 0, 20}, {20, 1, 30}, {30, 0, 40}, {40, 1, 50}, {50, 0, UINT64_MAX}});
+      IntervalsType test =
+          make_intervals<IntervalsType>(
+              {{0, 0, 10}, {10, 1, 20}, {20, 0, 30}, {30, 1, 40}, {40, 0, UINT64_MAX}});
+      IntervalsType other =
+          make_intervals<IntervalsType>(
+              {{0, 0, 20}, {20, 1, 30}, {30, 0, 40}, {40, 1, 50}, {50, 0, UINT64_MAX}});
       test.merge(other, [](uint64_t x, uint64_t y) -> uint64_t { return x + y; });
       check_intervals(test, {{0, 0, 10}, {10, 1, 50}, {50, 0, UINT64_MAX}});
     };
   };
 };
 
+TEST_CASE("Test Intervals type", "[intervals]")
+{
+  RunIntervalsTestSuite<Intervals<uint64_t>>();
+}
+
+TEST_CASE("Test FlatIntervals type", "[intervals]")
+{
+  RunIntervalsTestSuite<FlatIntervals<uint64_t>>();
+}
+
 #endif    // ENABLED(ENABLE_UNIT_TESTS)
\ No newline at end of file
@@ -23,10 +23,74 @@
  ******************************************************************************/
 
 #include "core/plugins.h"
+#include <map>
+#include "common/threading.h"
 #include "os/os_specific.h"
 #include "strings/string_utils.h"
 
-std::string LocatePluginFile(const std::string &path, const std::string &fileName)
+// probing every candidate plugin directory with filesystem checks is slow on network-mounted
+// installs, so we remember where each plugin file was last found - along with the modified
+// timestamp of the directory it was found in - and persist that to the app folder. Warm lookups
+// then go straight to the cached file and revalidate the directory in the background.
+struct PluginCacheEntry
+{
+  uint64_t mtime = 0;
+  std::string resolved;
+};
+
+static Threading::CriticalSection pluginCacheLock;
+static std::map<std::string, PluginCacheEntry> pluginCache;
+static bool pluginCacheLoaded = false;
+static Threading::TaskGroup pluginCacheRevalidates;
+
+static std::string PluginCacheFilename()
+{
+  return FileIO::GetAppFolderFilename("plugins.cache");
+}
+
+// must hold pluginCacheLock
+static void LoadPluginCache()
+{
+  pluginCacheLoaded = true;
+
+  FILE *f = FileIO::fopen(PluginCacheFilename().c_str(), "r");
+
+  while(f && !FileIO::feof(f))
+  {
+    std::string line = FileIO::getline(f);
+
+    // tab-separated: directory timestamp, lookup key, resolved filename
+    size_t a = line.find('\t');
+    size_t b = (a == std::string::npos) ? a : line.find('\t', a + 1);
+
+    if(b == std::string::npos)
+      continue;
+
+    PluginCacheEntry entry;
+    entry.mtime = strtoull(line.c_str(), NULL, 10);
+    entry.resolved = line.substr(b + 1);
+
+    if(!entry.resolved.empty())
+      pluginCache[line.substr(a + 1, b - a - 1)] = entry;
+  }
+
+  if(f)
+    FileIO::fclose(f);
+}
+
+// must hold pluginCacheLock
+static void SavePluginCache()
+{
+  std::string contents;
+
+  for(const std::pair<const std::string, PluginCacheEntry> &it : pluginCache)
+    contents += StringFormat::Fmt("%llu\t%s\t%s\n", it.second.mtime, it.first.c_str(),
+                                  it.second.resolved.c_str());
+
+  FileIO::dump(PluginCacheFilename().c_str(), contents.c_str(), contents.size());
+}
+
+static std::string SearchPluginPaths(const std::string &path, const std::string &fileName)
 {
   std::string ret;
 
@@ -80,9 +144,67 @@ std::string LocatePluginFile(const std::string &path, const std::string &fileNam
     }
   }
 
-  // if we didn't find it anywhere, just try running it directly in case it's in the PATH
-  if(ret.empty())
-    ret = fileName;
-
   return ret;
+}
+
+std::string LocatePluginFile(const std::string &path, const std::string &fileName)
+{
+  std::string key = path + "/" + fileName;
+
+  {
+    SCOPED_LOCK(pluginCacheLock);
+
+    if(!pluginCacheLoaded)
+      LoadPluginCache();
+
+    auto it = pluginCache.find(key);
+
+    // trust a cached location as long as the file is still there - a single existence check
+    // instead of probing every candidate directory.
+    if(it != pluginCache.end() && FileIO::exists(it->second.resolved.c_str()))
+    {
+      std::string ret = it->second.resolved;
+      uint64_t cachedMTime = it->second.mtime;
+
+      // revalidate in the background: if the directory we found the file in has changed since
+      // then, a different candidate directory might now take priority, so re-run the full search
+      // and update the cache ready for the next lookup.
+      Threading::TaskPool::Instance().Submit(
+          pluginCacheRevalidates, [key, path, fileName, ret, cachedMTime]() {
+            uint64_t mtime = FileIO::GetModifiedTimestamp(get_dirname(ret));
+
+            if(mtime == cachedMTime)
+              return;
+
+            std::string found = SearchPluginPaths(path, fileName);
+
+            SCOPED_LOCK(pluginCacheLock);
+
+            PluginCacheEntry &entry = pluginCache[key];
+            entry.mtime = mtime;
+            if(!found.empty())
+              entry.resolved = found;
+            SavePluginCache();
+          });
+
+      return ret;
+    }
+  }
+
+  std::string ret = SearchPluginPaths(path, fileName);
+
+  if(!ret.empty())
+  {
+    SCOPED_LOCK(pluginCacheLock);
+
+    PluginCacheEntry &entry = pluginCache[key];
+    entry.mtime = FileIO::GetModifiedTimestamp(get_dirname(ret));
+    entry.resolved = ret;
+    SavePluginCache();
+
+    return ret;
+  }
+
+  // if we didn't find it anywhere, just try running it directly in case it's in the PATH
+  return fileName;
 }
\ No newline at end of file
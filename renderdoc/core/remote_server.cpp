@@ -25,12 +25,14 @@
 
 #include <sstream>
 #include <utility>
+#include "3rdparty/zstd/xxhash.h"
 #include "android/android.h"
 #include "api/replay/renderdoc_replay.h"
 #include "api/replay/version.h"
 #include "core/core.h"
 #include "os/os_specific.h"
 #include "replay/replay_controller.h"
+#include "serialise/lz4io.h"
 #include "serialise/rdcfile.h"
 #include "serialise/serialiser.h"
 #include "strings/string_utils.h"
@@ -78,16 +80,282 @@ RDCCOMPILE_ASSERT((int)eRemoteServer_RemoteServerCount < (int)eReplayProxy_First
 #define WRITE_DATA_SCOPE() WriteSerialiser &ser = writer;
 #define READ_DATA_SCOPE() ReadSerialiser &ser = reader;
 
+// capture files are transferred in blocks of this size, each followed by its hash so the receiver
+// only ever commits verified data to disk. That means an interrupted transfer can safely resume
+// from the size of the partial file, instead of restarting a multi-GB pull from zero.
+static const uint64_t FileTransferBlockSize = 4 * 1024 * 1024;
+
+// hashes the first length bytes of the file. Used to check that the partial file on one end is a
+// prefix of the source file on the other before resuming a transfer - if anything doesn't match
+// we fall back to sending the whole file.
+static uint64_t HashFilePrefix(FILE *f, uint64_t length)
+{
+  XXH64_state_t *state = XXH64_createState();
+  XXH64_reset(state, 0);
+
+  std::vector<byte> buf;
+  buf.resize((size_t)RDCMIN(FileTransferBlockSize, length));
+
+  FileIO::fseek64(f, 0, SEEK_SET);
+
+  uint64_t remaining = length;
+
+  while(remaining > 0)
+  {
+    size_t chunkSize = (size_t)RDCMIN(FileTransferBlockSize, remaining);
+    size_t numRead = FileIO::fread(buf.data(), 1, chunkSize, f);
+
+    XXH64_update(state, buf.data(), numRead);
+
+    // a short read means we can't hash the full prefix - bail, the digest won't match and the
+    // transfer will safely restart from scratch.
+    if(numRead != chunkSize)
+      break;
+
+    remaining -= chunkSize;
+  }
+
+  uint64_t hash = XXH64_digest(state);
+  XXH64_freeState(state);
+
+  return hash;
+}
+
+// double-buffered hand-off between the socket and the disk during a file transfer, so that file
+// reads/writes and hashing overlap with network transfer instead of alternating with it on one
+// thread. Mirrors the window scheme in PipelinedDecompressor.
+struct TransferPipeline
+{
+  bytebuf block[2];
+  uint64_t hash[2] = {0, 0};
+
+  // 0 = empty (producer may fill), 1 = ready (consumer may drain). The producer moves 0 -> 1,
+  // the consumer moves 1 -> 0.
+  volatile int32_t state[2] = {0, 0};
+
+  // set by either side on failure, to stop the other
+  volatile int32_t error = 0;
+
+  // set once the last block has been handed over
+  volatile int32_t finished = 0;
+};
+
+// streams the file contents from resumeOffset to the end as hashed blocks. A worker thread reads
+// and hashes the next block while the current one is on the socket.
+static void SendFileBlocks(WriteSerialiser &ser, FILE *f, uint64_t totalSize, uint64_t resumeOffset,
+                           RENDERDOC_ProgressCallback progress)
+{
+  if(f)
+    FileIO::fseek64(f, resumeOffset, SEEK_SET);
+
+  uint64_t remaining = totalSize - resumeOffset;
+
+  TransferPipeline pipe;
+
+  uint64_t toRead = remaining;
+
+  Threading::ThreadHandle readThread = Threading::CreateThread([f, toRead, &pipe]() {
+    uint64_t left = toRead;
+    int slot = 0;
+
+    while(left > 0)
+    {
+      while(Atomic::CmpExch32(&pipe.state[slot], 0, 0) != 0)
+      {
+        if(Atomic::CmpExch32(&pipe.error, 0, 0) != 0)
+          return;
+
+        Threading::Sleep(0);
+      }
+
+      size_t blockSize = (size_t)RDCMIN(FileTransferBlockSize, left);
+
+      pipe.block[slot].resize(blockSize);
+
+      size_t numRead = f ? FileIO::fread(pipe.block[slot].data(), 1, blockSize, f) : 0;
+
+      pipe.block[slot].resize(numRead);
+      pipe.hash[slot] = XXH64(pipe.block[slot].data(), numRead, 0);
+
+      left -= numRead;
+
+      Atomic::CmpExch32(&pipe.state[slot], 0, 1);
+
+      // a short read means the file shrank underneath us. The receiver treats the undersized
+      // block as the end of the transfer, so just stop reading.
+      if(numRead < blockSize)
+        return;
+
+      slot = 1 - slot;
+    }
+  });
+
+  int slot = 0;
+  uint64_t sent = resumeOffset;
+
+  while(remaining > 0 && !ser.IsErrored())
+  {
+    while(Atomic::CmpExch32(&pipe.state[slot], 1, 1) != 1)
+      Threading::Sleep(0);
+
+    size_t expected = (size_t)RDCMIN(FileTransferBlockSize, remaining);
+
+    bytebuf &block = pipe.block[slot];
+    uint64_t blockHash = pipe.hash[slot];
+
+    SERIALISE_ELEMENT(block);
+    SERIALISE_ELEMENT(blockHash);
+
+    remaining -= block.size();
+    sent += block.size();
+
+    bool shortBlock = block.size() < expected;
+
+    Atomic::CmpExch32(&pipe.state[slot], 1, 0);
+    slot = 1 - slot;
+
+    if(progress && totalSize > 0)
+      progress(float(double(sent) / double(totalSize)));
+
+    if(shortBlock)
+      break;
+  }
+
+  // stop the worker if it's still reading (e.g. the socket died mid-transfer)
+  Atomic::CmpExch32(&pipe.error, 0, 1);
+
+  Threading::JoinThread(readThread);
+  Threading::CloseThread(readThread);
+}
+
+// receives hashed blocks and writes them to the file, which may be NULL to drain a transfer that
+// can't be stored. A worker thread verifies and writes the previous block while the next one is
+// being pulled off the socket. Blocks are only committed to disk once their hash checks out, so a
+// partial file only ever contains known-good data that a future resume can trust.
+static bool ReceiveFileBlocks(ReadSerialiser &ser, FILE *f, uint64_t totalSize,
+                              uint64_t resumeOffset, RENDERDOC_ProgressCallback progress)
+{
+  TransferPipeline pipe;
+
+  Threading::ThreadHandle writeThread = Threading::CreateThread([f, &pipe]() {
+    int slot = 0;
+
+    while(true)
+    {
+      while(Atomic::CmpExch32(&pipe.state[slot], 1, 1) != 1)
+      {
+        if(Atomic::CmpExch32(&pipe.error, 0, 0) != 0)
+          return;
+
+        // the receiving thread marks blocks ready before setting finished, so an empty slot after
+        // the finished flag is set means there's nothing left to write.
+        if(Atomic::CmpExch32(&pipe.finished, 0, 0) != 0 &&
+           Atomic::CmpExch32(&pipe.state[slot], 1, 1) != 1)
+          return;
+
+        Threading::Sleep(0);
+      }
+
+      bytebuf &block = pipe.block[slot];
+
+      if(XXH64(block.data(), block.size(), 0) != pipe.hash[slot])
+      {
+        RDCERR("Checksum mismatch receiving capture file block");
+        Atomic::CmpExch32(&pipe.error, 0, 1);
+        return;
+      }
+
+      if(f)
+        FileIO::fwrite(block.data(), 1, block.size(), f);
+
+      Atomic::CmpExch32(&pipe.state[slot], 1, 0);
+      slot = 1 - slot;
+    }
+  });
+
+  uint64_t received = resumeOffset;
+  int slot = 0;
+  bool success = true;
+
+  while(received < totalSize && !ser.IsErrored())
+  {
+    while(Atomic::CmpExch32(&pipe.state[slot], 0, 0) != 0)
+    {
+      if(Atomic::CmpExch32(&pipe.error, 0, 0) != 0)
+        break;
+
+      Threading::Sleep(0);
+    }
+
+    if(Atomic::CmpExch32(&pipe.error, 0, 0) != 0)
+    {
+      success = false;
+      break;
+    }
+
+    size_t expected = (size_t)RDCMIN(FileTransferBlockSize, totalSize - received);
+
+    bytebuf &block = pipe.block[slot];
+    uint64_t blockHash = 0;
+
+    SERIALISE_ELEMENT(block);
+    SERIALISE_ELEMENT(blockHash);
+
+    if(ser.IsErrored())
+    {
+      success = false;
+      break;
+    }
+
+    pipe.hash[slot] = blockHash;
+
+    received += block.size();
+
+    bool shortBlock = block.size() < expected;
+
+    Atomic::CmpExch32(&pipe.state[slot], 0, 1);
+    slot = 1 - slot;
+
+    if(progress && totalSize > 0)
+      progress(float(double(received) / double(totalSize)));
+
+    // an undersized block means the remote file was truncated mid-transfer - treat it as the end
+    // of the stream rather than waiting for data that will never arrive.
+    if(shortBlock)
+    {
+      RDCERR("Capture file transfer ended early at %llu/%llu bytes", received, totalSize);
+      success = false;
+      break;
+    }
+  }
+
+  Atomic::CmpExch32(&pipe.finished, 0, 1);
+
+  Threading::JoinThread(writeThread);
+  Threading::CloseThread(writeThread);
+
+  if(Atomic::CmpExch32(&pipe.error, 0, 0) != 0)
+    success = false;
+
+  return success && !ser.IsErrored();
+}
+
 struct ClientThread
 {
   ClientThread()
-      : socket(NULL), allowExecution(false), killThread(false), killServer(false), thread(0)
+      : socket(NULL),
+        allowExecution(false),
+        readOnly(false),
+        killThread(false),
+        killServer(false),
+        thread(0)
   {
   }
 
   Network::Socket *socket;
 
   bool allowExecution;
+  bool readOnly;
   bool killThread;
   bool killServer;
 
@@ -148,14 +416,102 @@ static void InactiveRemoteClientThread(ClientThread *threadData)
   }
 }
 
+// daemon mode pins one capture: its replay is loaded once and then kept alive between client
+// connections, so successive analysis runs against the same file skip the full load. Several
+// clients can be attached to the shared replay at once - one writing client plus any number of
+// read-only ones - with all replay work serialised by the lock below.
+struct CachedCapture
+{
+  CachedCapture() : rdc(NULL), remoteDriver(NULL), replayDriver(NULL), replayOwner(NULL) {}
+  std::string path;
+  RDCFile *rdc;
+  IRemoteDriver *remoteDriver;
+  IReplayDriver *replayDriver;
+
+  // serialises loading/attaching, all proxy commands, and file section access between clients
+  Threading::CriticalSection lock;
+  // the client whose replay position the driver currently reflects. Commands from any other
+  // client re-replay to their own event first, so each client inspects events independently.
+  ClientThread *replayOwner;
+};
+
+// opens a capture and creates & initialises the replay for it. The file is always returned, even
+// on failure, so that section queries still work - the drivers are NULL if the load failed.
+static ReplayStatus LoadCaptureForRemote(const std::string &path, RDCFile *&rdc,
+                                         IRemoteDriver *&remoteDriver, IReplayDriver *&replayDriver)
+{
+  ReplayStatus status = ReplayStatus::InternalError;
+
+  rdc = new RDCFile();
+  rdc->Open(path.c_str());
+
+  if(rdc->ErrorCode() != ContainerError::NoError)
+  {
+    RDCERR("Failed to open '%s': %d", path.c_str(), rdc->ErrorCode());
+
+    switch(rdc->ErrorCode())
+    {
+      case ContainerError::FileNotFound: status = ReplayStatus::FileNotFound; break;
+      case ContainerError::FileIO: status = ReplayStatus::FileIOFailed; break;
+      case ContainerError::Corrupt: status = ReplayStatus::FileCorrupted; break;
+      case ContainerError::UnsupportedVersion:
+        status = ReplayStatus::FileIncompatibleVersion;
+        break;
+      default: break;
+    }
+
+    return status;
+  }
+
+  if(!RenderDoc::Inst().HasRemoteDriver(rdc->GetDriver()))
+  {
+    RDCERR("File needs driver for '%s' which isn't supported!", rdc->GetDriverName().c_str());
+
+    return ReplayStatus::APIUnsupported;
+  }
+
+  // if we have a replay driver, try to create it so we can display a local preview e.g.
+  if(RenderDoc::Inst().HasReplayDriver(rdc->GetDriver()))
+  {
+    status = RenderDoc::Inst().CreateReplayDriver(rdc, &replayDriver);
+    if(replayDriver)
+      remoteDriver = replayDriver;
+  }
+  else
+  {
+    status = RenderDoc::Inst().CreateRemoteDriver(rdc, &remoteDriver);
+  }
+
+  if(status != ReplayStatus::Succeeded || remoteDriver == NULL)
+  {
+    RDCERR("Failed to create remote driver for driver '%s'", rdc->GetDriverName().c_str());
+    return status;
+  }
+
+  status = remoteDriver->ReadLogInitialisation(rdc, false);
+
+  if(status != ReplayStatus::Succeeded)
+  {
+    RDCERR("Failed to initialise remote driver.");
+
+    remoteDriver->Shutdown();
+    remoteDriver = NULL;
+    replayDriver = NULL;
+  }
+
+  return status;
+}
+
 static void ActiveRemoteClientThread(ClientThread *threadData,
-                                     RENDERDOC_PreviewWindowCallback previewWindow)
+                                     RENDERDOC_PreviewWindowCallback previewWindow,
+                                     CachedCapture *cachedCapture)
 {
   Network::Socket *&client = threadData->socket;
 
   uint32_t ip = client->GetRemoteIP();
 
   uint32_t version = 0;
+  uint32_t lz4Compression = 0;
 
   {
     ReadSerialiser ser(new StreamReader(client, Ownership::Nothing), Ownership::Stream);
@@ -173,6 +529,12 @@ static void ActiveRemoteClientThread(ClientThread *threadData,
 
     SERIALISE_ELEMENT(version);
 
+    // clients advertise LZ4 transport compression support after the version. Only read it when the
+    // version matches - older clients end their handshake at the version, and in streaming mode
+    // chunks carry no length so we can't skip data that isn't there.
+    if(version == RemoteServerProtocolVersion)
+      SERIALISE_ELEMENT(lz4Compression);
+
     ser.EndChunk();
   }
 
@@ -194,11 +556,15 @@ static void ActiveRemoteClientThread(ClientThread *threadData,
     }
     else
     {
-      // handshake and continue
+      // handshake and continue, echoing back the agreed compression
       SCOPED_SERIALISE_CHUNK(eRemoteServer_Handshake);
+      SERIALISE_ELEMENT(lz4Compression);
     }
   }
 
+  if(lz4Compression)
+    RDCLOG("Compressing remote server traffic with LZ4");
+
   std::vector<std::string> tempFiles;
   IRemoteDriver *remoteDriver = NULL;
   IReplayDriver *replayDriver = NULL;
@@ -206,8 +572,26 @@ static void ActiveRemoteClientThread(ClientThread *threadData,
   RDCFile *rdc = NULL;
   Callstack::StackResolver *resolver = NULL;
 
-  WriteSerialiser writer(new StreamWriter(client, Ownership::Nothing), Ownership::Stream);
-  ReadSerialiser reader(new StreamReader(client, Ownership::Nothing), Ownership::Stream);
+  // true while we're attached to the shared replay of the pinned capture, possibly alongside
+  // other clients. All access to the replay and the capture file is then serialised by
+  // cachedCapture->lock.
+  bool sharedReplay = false;
+
+  StreamWriter *streamWriter = new StreamWriter(client, Ownership::Nothing);
+  StreamReader *streamReader = new StreamReader(client, Ownership::Nothing);
+
+  // if negotiated, layer streaming LZ4 over the socket. The compressor flushes a block at the end
+  // of every chunk so the client never stalls waiting for buffered data.
+  if(lz4Compression)
+  {
+    streamWriter = new StreamWriter(new LZ4FlushingCompressor(streamWriter, Ownership::Stream),
+                                    Ownership::Stream);
+    streamReader =
+        new StreamReader(new LZ4Decompressor(streamReader, Ownership::Stream), Ownership::Stream);
+  }
+
+  WriteSerialiser writer(streamWriter, Ownership::Stream);
+  ReadSerialiser reader(streamReader, Ownership::Stream);
 
   writer.SetStreamingMode(true);
   reader.SetStreamingMode(true);
@@ -234,7 +618,10 @@ static void ActiveRemoteClientThread(ClientThread *threadData,
       reader.EndChunk();
 
       if(proxy)
+      {
+        SCOPED_LOCK_OPTIONAL(cachedCapture->lock, sharedReplay);
         proxy->RefreshPreviewWindow();
+      }
 
       // insert a dummy line into our logcat so we can keep track of our progress
       Android::TickDeviceLogcat();
@@ -296,21 +683,51 @@ static void ActiveRemoteClientThread(ClientThread *threadData,
     else if(type == eRemoteServer_CopyCaptureFromRemote)
     {
       std::string path;
+      uint64_t clientOffset = 0;
+      uint64_t clientPrefixHash = 0;
 
       {
         READ_DATA_SCOPE();
         SERIALISE_ELEMENT(path);
+        SERIALISE_ELEMENT(clientOffset);
+        SERIALISE_ELEMENT(clientPrefixHash);
       }
 
       reader.EndChunk();
 
+      FILE *f = FileIO::fopen(path.c_str(), "rb");
+
+      uint64_t totalSize = 0;
+
+      if(f)
+      {
+        FileIO::fseek64(f, 0, SEEK_END);
+        totalSize = FileIO::ftell64(f);
+      }
+
+      // resume from the client's offset only when its partial data hashes identically to our own
+      // prefix - anything else (stale file, different capture, short read) restarts from zero.
+      uint64_t resumeOffset = 0;
+
+      if(f && clientOffset > 0 && clientOffset <= totalSize &&
+         HashFilePrefix(f, clientOffset) == clientPrefixHash)
+        resumeOffset = clientOffset;
+
+      if(resumeOffset > 0)
+        RDCLOG("Resuming capture transfer of '%s' from offset %llu", path.c_str(), resumeOffset);
+
       {
         WRITE_DATA_SCOPE();
         SCOPED_SERIALISE_CHUNK(eRemoteServer_CopyCaptureFromRemote);
 
-        StreamReader fileStream(FileIO::fopen(path.c_str(), "rb"));
-        ser.SerialiseStream(path, fileStream);
+        SERIALISE_ELEMENT(totalSize);
+        SERIALISE_ELEMENT(resumeOffset);
+
+        SendFileBlocks(ser, f, totalSize, resumeOffset, RENDERDOC_ProgressCallback());
       }
+
+      if(f)
+        FileIO::fclose(f);
     }
     else if(type == eRemoteServer_CopyCaptureToRemote)
     {
@@ -322,17 +739,30 @@ static void ActiveRemoteClientThread(ClientThread *threadData,
 
       FileIO::CreateParentDirectory(path);
 
+      bool received = false;
+
       {
         READ_DATA_SCOPE();
 
-        StreamWriter streamWriter(FileIO::fopen(path.c_str(), "wb"), Ownership::Stream);
+        uint64_t totalSize = 0;
+        uint64_t resumeOffset = 0;
+
+        SERIALISE_ELEMENT(totalSize);
+        SERIALISE_ELEMENT(resumeOffset);
+
+        FILE *f = FileIO::fopen(path.c_str(), "wb");
 
-        ser.SerialiseStream(path.c_str(), streamWriter, NULL);
+        received = ReceiveFileBlocks(ser, f, totalSize, resumeOffset, RENDERDOC_ProgressCallback());
+
+        if(f)
+          FileIO::fclose(f);
+
+        received = received && (f != NULL);
       }
 
       reader.EndChunk();
 
-      if(reader.IsErrored())
+      if(reader.IsErrored() || !received)
       {
         FileIO::Delete(path.c_str());
 
@@ -369,10 +799,21 @@ static void ActiveRemoteClientThread(ClientThread *threadData,
     {
       reader.EndChunk();
 
-      RDCLOG("Requested to shut down.");
+      if(threadData->readOnly)
+      {
+        // don't let a read-only client sharing someone else's replay take the whole server
+        // down - just drop its own connection.
+        RDCLOG("Ignoring shutdown request from read-only connection.");
 
-      threadData->killServer = true;
-      threadData->killThread = true;
+        threadData->killThread = true;
+      }
+      else
+      {
+        RDCLOG("Requested to shut down.");
+
+        threadData->killServer = true;
+        threadData->killThread = true;
+      }
 
       {
         WRITE_DATA_SCOPE();
@@ -393,93 +834,82 @@ static void ActiveRemoteClientThread(ClientThread *threadData,
       RDCASSERT(remoteDriver == NULL && proxy == NULL && rdc == NULL);
       ReplayStatus status = ReplayStatus::InternalError;
 
-      rdc = new RDCFile();
-      rdc->Open(path.c_str());
+      sharedReplay = (cachedCapture && path == cachedCapture->path);
 
-      if(rdc->ErrorCode() != ContainerError::NoError)
+      // hold the shared lock over the attach - or over the whole load, if we're the first client
+      // to open the pinned capture.
+      SCOPED_LOCK_OPTIONAL(cachedCapture->lock, sharedReplay);
+
+      if(threadData->readOnly && !sharedReplay)
+      {
+        // read-only connections exist to share the pinned capture's replay - they can't load
+        // anything else on the server.
+        RDCWARN("Read-only connection tried to open '%s' - only the pinned capture is shared.",
+                path.c_str());
+      }
+      // in daemon mode the pinned capture stays loaded between connections, so opening the same
+      // path again re-attaches to the live replay instead of paying the full load.
+      else if(sharedReplay && cachedCapture->remoteDriver)
       {
-        RDCERR("Failed to open '%s': %d", path.c_str(), rdc->ErrorCode());
+        RDCLOG("Re-using already loaded replay of '%s'", path.c_str());
 
-        switch(rdc->ErrorCode())
-        {
-          case ContainerError::FileNotFound: status = ReplayStatus::FileNotFound; break;
-          case ContainerError::FileIO: status = ReplayStatus::FileIOFailed; break;
-          case ContainerError::Corrupt: status = ReplayStatus::FileCorrupted; break;
-          case ContainerError::UnsupportedVersion:
-            status = ReplayStatus::FileIncompatibleVersion;
-            break;
-          default: break;
-        }
+        rdc = cachedCapture->rdc;
+        remoteDriver = cachedCapture->remoteDriver;
+        replayDriver = cachedCapture->replayDriver;
+        status = ReplayStatus::Succeeded;
       }
       else
       {
-        if(RenderDoc::Inst().HasRemoteDriver(rdc->GetDriver()))
-        {
-          bool kill = false;
-          float progress = 0.0f;
+        bool kill = false;
+        float progress = 0.0f;
 
-          RenderDoc::Inst().SetProgressCallback<LoadProgress>([&progress](float p) { progress = p; });
+        RenderDoc::Inst().SetProgressCallback<LoadProgress>([&progress](float p) { progress = p; });
 
-          Threading::ThreadHandle ticker = Threading::CreateThread([&writer, &kill, &progress]() {
-            while(!kill)
-            {
-              {
-                WRITE_DATA_SCOPE();
-                SCOPED_SERIALISE_CHUNK(eRemoteServer_LogOpenProgress);
-                SERIALISE_ELEMENT(progress);
-              }
-              Threading::Sleep(100);
-            }
-          });
-
-          // if we have a replay driver, try to create it so we can display a local preview e.g.
-          if(RenderDoc::Inst().HasReplayDriver(rdc->GetDriver()))
-          {
-            status = RenderDoc::Inst().CreateReplayDriver(rdc, &replayDriver);
-            if(replayDriver)
-              remoteDriver = replayDriver;
-          }
-          else
-          {
-            status = RenderDoc::Inst().CreateRemoteDriver(rdc, &remoteDriver);
-          }
-
-          if(status != ReplayStatus::Succeeded || remoteDriver == NULL)
-          {
-            RDCERR("Failed to create remote driver for driver '%s'", rdc->GetDriverName().c_str());
-          }
-          else
+        Threading::ThreadHandle ticker = Threading::CreateThread([&writer, &kill, &progress]() {
+          while(!kill)
           {
-            status = remoteDriver->ReadLogInitialisation(rdc, false);
-
-            if(status != ReplayStatus::Succeeded)
             {
-              RDCERR("Failed to initialise remote driver.");
-
-              remoteDriver->Shutdown();
-              remoteDriver = NULL;
+              WRITE_DATA_SCOPE();
+              SCOPED_SERIALISE_CHUNK(eRemoteServer_LogOpenProgress);
+              SERIALISE_ELEMENT(progress);
             }
+            Threading::Sleep(100);
           }
+        });
 
-          RenderDoc::Inst().SetProgressCallback<LoadProgress>(RENDERDOC_ProgressCallback());
+        status = LoadCaptureForRemote(path, rdc, remoteDriver, replayDriver);
 
-          kill = true;
-          Threading::JoinThread(ticker);
-          Threading::CloseThread(ticker);
+        RenderDoc::Inst().SetProgressCallback<LoadProgress>(RENDERDOC_ProgressCallback());
 
-          if(status == ReplayStatus::Succeeded && remoteDriver)
-          {
-            proxy = new ReplayProxy(reader, writer, remoteDriver, replayDriver, previewWindow);
-          }
-        }
-        else
-        {
-          RDCERR("File needs driver for '%s' which isn't supported!", rdc->GetDriverName().c_str());
+        kill = true;
+        Threading::JoinThread(ticker);
+        Threading::CloseThread(ticker);
 
-          status = ReplayStatus::APIUnsupported;
+        // if this is the pinned capture, keep the loaded replay alive for future connections
+        if(cachedCapture && status == ReplayStatus::Succeeded && remoteDriver &&
+           path == cachedCapture->path)
+        {
+          cachedCapture->rdc = rdc;
+          cachedCapture->remoteDriver = remoteDriver;
+          cachedCapture->replayDriver = replayDriver;
         }
       }
 
+      if(status == ReplayStatus::Succeeded && remoteDriver)
+      {
+        // read-only clients don't apply mutating commands to the shared replay, and don't drive
+        // the preview window - the writing client owns it.
+        proxy = new ReplayProxy(
+            reader, writer, remoteDriver, replayDriver,
+            threadData->readOnly ? RENDERDOC_PreviewWindowCallback() : previewWindow);
+
+        if(threadData->readOnly)
+          proxy->SetReadOnly();
+      }
+
+      if(proxy == NULL)
+        sharedReplay = false;
+
       {
         WRITE_DATA_SCOPE();
         SCOPED_SERIALISE_CHUNK(eRemoteServer_LogOpened);
@@ -490,6 +920,9 @@ static void ActiveRemoteClientThread(ClientThread *threadData,
     {
       reader.EndChunk();
 
+      // all capture file access is serialised against other clients sharing the replay
+      SCOPED_LOCK_OPTIONAL(cachedCapture->lock, sharedReplay);
+
       bool HasCallstacks = rdc && rdc->SectionIndex(SectionType::ResolveDatabase) >= 0;
 
       {
@@ -504,18 +937,30 @@ static void ActiveRemoteClientThread(ClientThread *threadData,
 
       bool success = false;
 
-      int sectionIndex = rdc ? rdc->SectionIndex(SectionType::ResolveDatabase) : -1;
+      int sectionIndex = -1;
+
+      {
+        SCOPED_LOCK_OPTIONAL(cachedCapture->lock, sharedReplay);
+        sectionIndex = rdc ? rdc->SectionIndex(SectionType::ResolveDatabase) : -1;
+      }
 
       SAFE_DELETE(resolver);
       if(sectionIndex >= 0)
       {
-        StreamReader *sectionReader = rdc->ReadSection(sectionIndex);
-
         std::vector<byte> buf;
-        buf.resize((size_t)sectionReader->GetSize());
-        success = sectionReader->Read(buf.data(), sectionReader->GetSize());
 
-        delete sectionReader;
+        {
+          // serialise the section read against other clients sharing the capture file. The
+          // resolver build below is long, CPU-only work so it runs outside the lock.
+          SCOPED_LOCK_OPTIONAL(cachedCapture->lock, sharedReplay);
+
+          StreamReader *sectionReader = rdc->ReadSection(sectionIndex);
+
+          buf.resize((size_t)sectionReader->GetSize());
+          success = sectionReader->Read(buf.data(), sectionReader->GetSize());
+
+          delete sectionReader;
+        }
 
         if(success)
         {
@@ -588,6 +1033,8 @@ static void ActiveRemoteClientThread(ClientThread *threadData,
     {
       reader.EndChunk();
 
+      SCOPED_LOCK_OPTIONAL(cachedCapture->lock, sharedReplay);
+
       int count = rdc ? rdc->NumSections() : 0;
 
       {
@@ -607,6 +1054,8 @@ static void ActiveRemoteClientThread(ClientThread *threadData,
 
       reader.EndChunk();
 
+      SCOPED_LOCK_OPTIONAL(cachedCapture->lock, sharedReplay);
+
       int index = rdc ? rdc->SectionIndex(name.c_str()) : -1;
 
       {
@@ -626,6 +1075,8 @@ static void ActiveRemoteClientThread(ClientThread *threadData,
 
       reader.EndChunk();
 
+      SCOPED_LOCK_OPTIONAL(cachedCapture->lock, sharedReplay);
+
       int index = rdc ? rdc->SectionIndex(sectionType) : -1;
 
       {
@@ -645,6 +1096,8 @@ static void ActiveRemoteClientThread(ClientThread *threadData,
 
       reader.EndChunk();
 
+      SCOPED_LOCK_OPTIONAL(cachedCapture->lock, sharedReplay);
+
       SectionProperties props;
       if(rdc && index >= 0 && index < rdc->NumSections())
         props = rdc->GetSectionProperties(index);
@@ -668,6 +1121,8 @@ static void ActiveRemoteClientThread(ClientThread *threadData,
 
       bytebuf contents;
 
+      SCOPED_LOCK_OPTIONAL(cachedCapture->lock, sharedReplay);
+
       if(rdc && index >= 0 && index < rdc->NumSections())
       {
         StreamReader *sectionReader = rdc->ReadSection(index);
@@ -702,7 +1157,10 @@ static void ActiveRemoteClientThread(ClientThread *threadData,
 
       bool success = false;
 
-      if(rdc)
+      SCOPED_LOCK_OPTIONAL(cachedCapture->lock, sharedReplay);
+
+      // read-only clients sharing a replay can't write sections into the capture file
+      if(rdc && !threadData->readOnly)
       {
         StreamWriter *sectionWriter = rdc->WriteSection(props);
 
@@ -725,14 +1183,34 @@ static void ActiveRemoteClientThread(ClientThread *threadData,
     {
       reader.EndChunk();
 
-      SAFE_DELETE(proxy);
+      // the pinned capture's shared replay stays loaded, ready for the other attached clients
+      // and the next connection
+      if(sharedReplay)
+      {
+        SCOPED_LOCK(cachedCapture->lock);
+
+        SAFE_DELETE(proxy);
+
+        if(cachedCapture->replayOwner == threadData)
+          cachedCapture->replayOwner = NULL;
 
-      if(remoteDriver)
-        remoteDriver->Shutdown();
-      remoteDriver = NULL;
-      replayDriver = NULL;
+        remoteDriver = NULL;
+        replayDriver = NULL;
+        rdc = NULL;
+        sharedReplay = false;
+      }
+      else
+      {
+        SAFE_DELETE(proxy);
+
+        if(remoteDriver)
+          remoteDriver->Shutdown();
+        remoteDriver = NULL;
+        replayDriver = NULL;
+
+        SAFE_DELETE(rdc);
+      }
 
-      SAFE_DELETE(rdc);
       SAFE_DELETE(resolver);
     }
     else if(type == eRemoteServer_ExecuteAndInject)
@@ -772,7 +1250,25 @@ static void ActiveRemoteClientThread(ClientThread *threadData,
     }
     else if((int)type >= eReplayProxy_First && proxy)
     {
-      bool ok = proxy->Tick(type);
+      bool ok = false;
+
+      {
+        // when several clients share one replay, all replay work is serialised by this lock
+        SCOPED_LOCK_OPTIONAL(cachedCapture->lock, sharedReplay);
+
+        // if another client has replayed elsewhere since our last command, restore our replay
+        // position first so each client inspects its own event independently
+        if(sharedReplay && cachedCapture->replayOwner != threadData)
+        {
+          // no need to restore the old position if this command replays somewhere anyway
+          if((int)type != eReplayProxy_ReplayLog)
+            proxy->ScheduleReplayResync();
+
+          cachedCapture->replayOwner = threadData;
+        }
+
+        ok = proxy->Tick(type);
+      }
 
       if(!ok)
         break;
@@ -781,13 +1277,32 @@ static void ActiveRemoteClientThread(ClientThread *threadData,
     }
   }
 
-  SAFE_DELETE(proxy);
+  // as in CloseLog, leave the pinned capture's shared replay loaded for the other attached
+  // clients and the next connection
+  if(sharedReplay)
+  {
+    SCOPED_LOCK(cachedCapture->lock);
+
+    SAFE_DELETE(proxy);
+
+    if(cachedCapture->replayOwner == threadData)
+      cachedCapture->replayOwner = NULL;
+
+    remoteDriver = NULL;
+    replayDriver = NULL;
+    rdc = NULL;
+  }
+  else
+  {
+    SAFE_DELETE(proxy);
+
+    if(remoteDriver)
+      remoteDriver->Shutdown();
+    remoteDriver = NULL;
+    replayDriver = NULL;
+    SAFE_DELETE(rdc);
+  }
 
-  if(remoteDriver)
-    remoteDriver->Shutdown();
-  remoteDriver = NULL;
-  replayDriver = NULL;
-  SAFE_DELETE(rdc);
   SAFE_DELETE(resolver);
 
   for(size_t i = 0; i < tempFiles.size(); i++)
@@ -805,13 +1320,38 @@ static void ActiveRemoteClientThread(ClientThread *threadData,
 
 void RenderDoc::BecomeRemoteServer(const char *listenhost, uint16_t port,
                                    RENDERDOC_KillCallback killReplay,
-                                   RENDERDOC_PreviewWindowCallback previewWindow)
+                                   RENDERDOC_PreviewWindowCallback previewWindow,
+                                   const char *preloadCapture)
 {
   Network::Socket *sock = Network::CreateServerSocket(listenhost, port, 1);
 
   if(sock == NULL)
     return;
 
+  // daemon mode: load the pinned capture once up front, so even the first connection skips the
+  // load. The replay is then kept alive between connections and handed to any client that opens
+  // the same path.
+  CachedCapture cachedCapture;
+
+  if(preloadCapture)
+  {
+    cachedCapture.path = preloadCapture;
+
+    RDCLOG("Loading pinned capture '%s'", preloadCapture);
+
+    ReplayStatus status =
+        LoadCaptureForRemote(cachedCapture.path, cachedCapture.rdc, cachedCapture.remoteDriver,
+                             cachedCapture.replayDriver);
+
+    if(status != ReplayStatus::Succeeded)
+    {
+      RDCWARN("Couldn't load '%s' up front: %s. It will be loaded when first opened.",
+              preloadCapture, ToStr(status).c_str());
+
+      SAFE_DELETE(cachedCapture.rdc);
+    }
+  }
+
   std::vector<std::pair<uint32_t, uint32_t> > listenRanges;
   bool allowExecution = true;
 
@@ -894,6 +1434,10 @@ void RenderDoc::BecomeRemoteServer(const char *listenhost, uint16_t port,
 
   ClientThread *activeClientData = NULL;
 
+  // in daemon mode, extra clients can attach read-only to the pinned capture's shared replay,
+  // each on their own thread
+  std::vector<ClientThread *> readOnlyClients;
+
   std::vector<ClientThread *> inactives;
 
   while(!killReplay())
@@ -916,6 +1460,19 @@ void RenderDoc::BecomeRemoteServer(const char *listenhost, uint16_t port,
       }
     }
 
+    // reap any dead read-only client threads
+    for(size_t i = 0; i < readOnlyClients.size(); i++)
+    {
+      if(readOnlyClients[i]->socket == NULL)
+      {
+        Threading::JoinThread(readOnlyClients[i]->thread);
+        Threading::CloseThread(readOnlyClients[i]->thread);
+        delete readOnlyClients[i];
+        readOnlyClients.erase(readOnlyClients.begin() + i);
+        break;
+      }
+    }
+
     // reap our active connection possibly
     if(activeClientData && activeClientData->socket == NULL)
     {
@@ -973,12 +1530,34 @@ void RenderDoc::BecomeRemoteServer(const char *listenhost, uint16_t port,
       activeClientData->socket = client;
       activeClientData->allowExecution = allowExecution;
 
-      activeClientData->thread = Threading::CreateThread([activeClientData, previewWindow]() {
-        ActiveRemoteClientThread(activeClientData, previewWindow);
-      });
+      CachedCapture *cache = preloadCapture ? &cachedCapture : NULL;
+
+      activeClientData->thread =
+          Threading::CreateThread([activeClientData, previewWindow, cache]() {
+            ActiveRemoteClientThread(activeClientData, previewWindow, cache);
+          });
 
       RDCLOG("Making active connection");
     }
+    else if(preloadCapture)
+    {
+      // daemon mode - additional clients attach read-only, sharing the pinned capture's loaded
+      // replay with the active client
+      ClientThread *secondary = new ClientThread();
+      secondary->socket = client;
+      secondary->allowExecution = false;
+      secondary->readOnly = true;
+
+      CachedCapture *cache = &cachedCapture;
+
+      secondary->thread = Threading::CreateThread([secondary, previewWindow, cache]() {
+        ActiveRemoteClientThread(secondary, previewWindow, cache);
+      });
+
+      readOnlyClients.push_back(secondary);
+
+      RDCLOG("Making read-only connection");
+    }
     else
     {
       ClientThread *inactive = new ClientThread();
@@ -1004,6 +1583,15 @@ void RenderDoc::BecomeRemoteServer(const char *listenhost, uint16_t port,
     delete activeClientData;
   }
 
+  for(size_t i = 0; i < readOnlyClients.size(); i++)
+  {
+    readOnlyClients[i]->killThread = true;
+
+    Threading::JoinThread(readOnlyClients[i]->thread);
+    Threading::CloseThread(readOnlyClients[i]->thread);
+    delete readOnlyClients[i];
+  }
+
   // shut down client threads
   for(size_t i = 0; i < inactives.size(); i++)
   {
@@ -1012,17 +1600,35 @@ void RenderDoc::BecomeRemoteServer(const char *listenhost, uint16_t port,
     delete inactives[i];
   }
 
+  // shut down the pinned capture's replay, if one is still loaded
+  if(cachedCapture.remoteDriver)
+    cachedCapture.remoteDriver->Shutdown();
+  SAFE_DELETE(cachedCapture.rdc);
+
   SAFE_DELETE(sock);
 }
 
 struct RemoteServer : public IRemoteServer
 {
 public:
-  RemoteServer(Network::Socket *sock, const char *hostname)
+  RemoteServer(Network::Socket *sock, const char *hostname, bool lz4Compression)
       : m_Socket(sock),
         m_hostname(hostname),
-        reader(new StreamReader(sock, Ownership::Nothing), Ownership::Stream),
-        writer(new StreamWriter(sock, Ownership::Nothing), Ownership::Stream)
+        // mirror of the server-side setup: if compression was negotiated in the handshake, layer
+        // streaming LZ4 over the socket in both directions.
+        reader(lz4Compression
+                   ? new StreamReader(new LZ4Decompressor(new StreamReader(sock, Ownership::Nothing),
+                                                          Ownership::Stream),
+                                      Ownership::Stream)
+                   : new StreamReader(sock, Ownership::Nothing),
+               Ownership::Stream),
+        writer(lz4Compression
+                   ? new StreamWriter(new LZ4FlushingCompressor(
+                                          new StreamWriter(sock, Ownership::Nothing),
+                                          Ownership::Stream),
+                                      Ownership::Stream)
+                   : new StreamWriter(sock, Ownership::Nothing),
+               Ownership::Stream)
   {
     writer.SetStreamingMode(true);
     reader.SetStreamingMode(true);
@@ -1325,10 +1931,33 @@ public:
   {
     std::string path = remotepath;
 
+    // if an earlier interrupted copy left a partial file behind, offer to resume from the end of
+    // it. We hash our partial data so the server can check it really is a prefix of the remote
+    // file - a stale or unrelated local file just means the transfer restarts from zero.
+    uint64_t clientOffset = 0;
+    uint64_t clientPrefixHash = 0;
+
+    {
+      FILE *existing = FileIO::fopen(localpath, "rb");
+
+      if(existing)
+      {
+        FileIO::fseek64(existing, 0, SEEK_END);
+        clientOffset = FileIO::ftell64(existing);
+
+        if(clientOffset > 0)
+          clientPrefixHash = HashFilePrefix(existing, clientOffset);
+
+        FileIO::fclose(existing);
+      }
+    }
+
     {
       WRITE_DATA_SCOPE();
       SCOPED_SERIALISE_CHUNK(eRemoteServer_CopyCaptureFromRemote);
       SERIALISE_ELEMENT(path);
+      SERIALISE_ELEMENT(clientOffset);
+      SERIALISE_ELEMENT(clientPrefixHash);
     }
 
     {
@@ -1337,11 +1966,47 @@ public:
 
       if(type == eRemoteServer_CopyCaptureFromRemote)
       {
-        StreamWriter streamWriter(FileIO::fopen(localpath, "wb"), Ownership::Stream);
+        uint64_t totalSize = 0;
+        uint64_t resumeOffset = 0;
+
+        SERIALISE_ELEMENT(totalSize);
+        SERIALISE_ELEMENT(resumeOffset);
+
+        FILE *f = NULL;
+
+        if(resumeOffset > 0)
+        {
+          RDCLOG("Resuming capture transfer of '%s' at %llu/%llu bytes", localpath, resumeOffset,
+                 totalSize);
+
+          f = FileIO::fopen(localpath, "r+b");
 
-        ser.SerialiseStream(localpath, streamWriter, progress);
+          if(f)
+            FileIO::fseek64(f, resumeOffset, SEEK_SET);
+        }
+
+        if(f == NULL)
+        {
+          f = FileIO::fopen(localpath, "wb");
+
+          // if we couldn't re-open the partial file the server is skipping data we can't recreate,
+          // so the transfer can't succeed - drain it below but start from scratch next time.
+          if(f && resumeOffset > 0)
+          {
+            RDCERR("Couldn't re-open partial file '%s' to resume into", localpath);
+            FileIO::fclose(f);
+            f = NULL;
+          }
+        }
+
+        bool success = ReceiveFileBlocks(ser, f, totalSize, resumeOffset, progress);
+
+        success = success && (f != NULL);
+
+        if(f)
+          FileIO::fclose(f);
 
-        if(ser.IsErrored())
+        if(ser.IsErrored() || !success)
         {
           RDCERR("Network error receiving file");
           return;
@@ -1358,14 +2023,34 @@ public:
 
   rdcstr CopyCaptureToRemote(const char *filename, RENDERDOC_ProgressCallback progress)
   {
+    FILE *f = FileIO::fopen(filename, "rb");
+
+    uint64_t totalSize = 0;
+
+    if(f)
+    {
+      FileIO::fseek64(f, 0, SEEK_END);
+      totalSize = FileIO::ftell64(f);
+    }
+
     {
       WRITE_DATA_SCOPE();
       SCOPED_SERIALISE_CHUNK(eRemoteServer_CopyCaptureToRemote);
 
-      StreamReader fileStream(FileIO::fopen(filename, "rb"));
-      ser.SerialiseStream(filename, fileStream, progress);
+      // uploads always land in a fresh temporary file on the server, so there's never a partial
+      // file to resume into - the offset exists to keep the block stream symmetric with
+      // CopyCaptureFromRemote.
+      uint64_t resumeOffset = 0;
+
+      SERIALISE_ELEMENT(totalSize);
+      SERIALISE_ELEMENT(resumeOffset);
+
+      SendFileBlocks(ser, f, totalSize, resumeOffset, progress);
     }
 
+    if(f)
+      FileIO::fclose(f);
+
     std::string path;
 
     {
@@ -1895,6 +2580,10 @@ RENDERDOC_CreateRemoteServerConnection(const char *host, uint32_t port, IRemoteS
 
   uint32_t version = RemoteServerProtocolVersion;
 
+  // advertise that we support LZ4 compression of the connection. The server echoes back the
+  // agreed value in its handshake - older servers fail the version check before ever seeing it.
+  uint32_t lz4Compression = 1;
+
   {
     WriteSerialiser ser(new StreamWriter(sock, Ownership::Nothing), Ownership::Stream);
 
@@ -1902,6 +2591,7 @@ RENDERDOC_CreateRemoteServerConnection(const char *host, uint32_t port, IRemoteS
 
     SCOPED_SERIALISE_CHUNK(eRemoteServer_Handshake);
     SERIALISE_ELEMENT(version);
+    SERIALISE_ELEMENT(lz4Compression);
   }
 
   if(!sock->Connected())
@@ -1912,6 +2602,9 @@ RENDERDOC_CreateRemoteServerConnection(const char *host, uint32_t port, IRemoteS
 
     RemoteServerPacket type = ser.ReadChunk<RemoteServerPacket>();
 
+    if(type == eRemoteServer_Handshake)
+      SERIALISE_ELEMENT(lz4Compression);
+
     ser.EndChunk();
 
     if(type == eRemoteServer_Busy)
@@ -1934,7 +2627,7 @@ RENDERDOC_CreateRemoteServerConnection(const char *host, uint32_t port, IRemoteS
     }
   }
 
-  *rend = new RemoteServer(sock, host);
+  *rend = new RemoteServer(sock, host, lz4Compression != 0);
 
   return ReplayStatus::Succeeded;
 }
@@ -24,7 +24,9 @@
  ******************************************************************************/
 
 #include "replay_proxy.h"
+#include <algorithm>
 #include "3rdparty/lz4/lz4.h"
+#include "3rdparty/zstd/xxhash.h"
 #include "serialise/lz4io.h"
 
 template <>
@@ -92,6 +94,11 @@ rdcstr DoStringise(const ReplayProxyPacket &el)
     STRINGISE_ENUM_NAMED(eReplayProxy_GetTargetShaderEncodings, "GetTargetShaderEncodings");
 
     STRINGISE_ENUM_NAMED(eReplayProxy_GetDriverInfo, "GetDriverInfo");
+
+    STRINGISE_ENUM_NAMED(eReplayProxy_CacheBufferDataBatch, "CacheBufferDataBatch");
+    STRINGISE_ENUM_NAMED(eReplayProxy_CacheTextureDataBatch, "CacheTextureDataBatch");
+
+    STRINGISE_ENUM_NAMED(eReplayProxy_FetchStructuredChunks, "FetchStructuredChunks");
   }
   END_ENUM_STRINGISE();
 }
@@ -587,6 +594,12 @@ FrameRecord ReplayProxy::Proxied_GetFrameRecord(ParamSerialiser &paramser, Retur
     // re-configure the drawcall pointers, since they will be invalid
     SetupDrawcallPointers(m_Drawcalls, ret.drawcallList);
   }
+  else if(m_FrameRecord.drawcallList.empty())
+  {
+    // keep a copy on the remote server too, so the render target prefetcher can look up the
+    // outputs of an event.
+    m_FrameRecord = ret;
+  }
 
   return ret;
 }
@@ -863,7 +876,20 @@ void ReplayProxy::Proxied_GetTextureData(ParamSerialiser &paramser, ReturnSerial
   {
     REMOTE_EXECUTION();
     if(paramser.IsReading() && !paramser.IsErrored() && !m_IsErrored)
-      m_Remote->GetTextureData(tex, arrayIdx, mip, params, data);
+    {
+      if(!GetPrefetchedTextureData(tex, arrayIdx, mip, params, data))
+        m_Remote->GetTextureData(tex, arrayIdx, mip, params, data);
+
+      // drivers always read back the full subresource - crop to the requested rect here so only
+      // the visible portion of huge textures goes over the wire.
+      if(params.partialWidth > 0 && params.partialHeight > 0)
+        CropPartialTextureData(tex, mip, params, data);
+
+      // likewise reduce lossy preview fetches to the requested fraction of the resolution before
+      // transfer.
+      if(params.downsampleFactor > 1)
+        DownsampleTextureData(tex, mip, params, data);
+    }
   }
 
   // over-estimate of total uncompressed data written. Since the decompression chain needs to know
@@ -1331,7 +1357,9 @@ void ReplayProxy::Proxied_ReplaceResource(ParamSerialiser &paramser, ReturnSeria
 
   {
     REMOTE_EXECUTION();
-    if(paramser.IsReading() && !paramser.IsErrored() && !m_IsErrored)
+    // resource replacement changes the replay for every client attached to a shared replay, so
+    // read-only proxies consume the command but don't apply it
+    if(paramser.IsReading() && !paramser.IsErrored() && !m_IsErrored && !m_ReadOnly)
       m_Remote->ReplaceResource(from, to);
   }
 
@@ -1358,7 +1386,8 @@ void ReplayProxy::Proxied_RemoveReplacement(ParamSerialiser &paramser, ReturnSer
 
   {
     REMOTE_EXECUTION();
-    if(paramser.IsReading() && !paramser.IsErrored() && !m_IsErrored)
+    // as in ReplaceResource, read-only proxies don't modify the shared replay
+    if(paramser.IsReading() && !paramser.IsErrored() && !m_IsErrored && !m_ReadOnly)
       m_Remote->RemoveReplacement(id);
   }
 
@@ -1556,27 +1585,60 @@ void ReplayProxy::Proxied_SavePipelineState(ParamSerialiser &paramser, ReturnSer
   {
     ReturnSerialiser &ser = retser;
     PACKET_HEADER(packet);
-    if(m_APIProps.pipelineType == GraphicsAPI::D3D11)
-    {
-      SERIALISE_ELEMENT(m_D3D11PipelineState);
-    }
-    else if(m_APIProps.pipelineType == GraphicsAPI::D3D12)
-    {
-      SERIALISE_ELEMENT(m_D3D12PipelineState);
-    }
-    else if(m_APIProps.pipelineType == GraphicsAPI::OpenGL)
-    {
-      SERIALISE_ELEMENT(m_GLPipelineState);
-    }
-    else if(m_APIProps.pipelineType == GraphicsAPI::Vulkan)
+    SERIALISE_ELEMENT(packet);
+
+    // the pipeline state structs are large - hundreds of KB serialised - but consecutive events
+    // share almost all of their state, so rather than serialising the struct directly we serialise
+    // it into a snapshot buffer and delta-transfer the bytes against the snapshot from the last
+    // transfer, the same way resource contents are transferred. If the serialised size changes
+    // then byte offsets aren't comparable any more, so both sides drop their reference and the
+    // whole snapshot is sent.
+    bytebuf snapshot;
+
+    if(ser.IsWriting())
     {
-      SERIALISE_ELEMENT(m_VulkanPipelineState);
+      WriteSerialiser snapser(new StreamWriter(64 * 1024), Ownership::Stream);
+
+      if(m_APIProps.pipelineType == GraphicsAPI::D3D11)
+        snapser.Serialise("state"_lit, m_D3D11PipelineState);
+      else if(m_APIProps.pipelineType == GraphicsAPI::D3D12)
+        snapser.Serialise("state"_lit, m_D3D12PipelineState);
+      else if(m_APIProps.pipelineType == GraphicsAPI::OpenGL)
+        snapser.Serialise("state"_lit, m_GLPipelineState);
+      else if(m_APIProps.pipelineType == GraphicsAPI::Vulkan)
+        snapser.Serialise("state"_lit, m_VulkanPipelineState);
+
+      snapshot.append(snapser.GetWriter()->GetData(), (size_t)snapser.GetWriter()->GetOffset());
     }
-    SERIALISE_ELEMENT(packet);
+
+    uint64_t snapshotSize = snapshot.size();
+    ser.Serialise("snapshotSize"_lit, snapshotSize);
+
+    if(m_PipelineSnapshot.size() != snapshotSize)
+      m_PipelineSnapshot.clear();
+
+    // both sides compute the same changed flag from the delta transfer itself. If nothing changed
+    // the state deserialised on the last transfer is still valid, including its reflection
+    // pointers, so the client can skip the decode entirely.
+    bool changed = DeltaTransferBytes(retser, m_PipelineSnapshot, m_PipelineSnapshotHash, snapshot);
+
     ser.EndChunk();
 
-    if(retser.IsReading())
+    if(retser.IsReading() && changed)
     {
+      // deserialise the state struct out of the reconstructed snapshot
+      ReadSerialiser snapser(new StreamReader(m_PipelineSnapshot.data(), m_PipelineSnapshot.size()),
+                             Ownership::Stream);
+
+      if(m_APIProps.pipelineType == GraphicsAPI::D3D11)
+        snapser.Serialise("state"_lit, m_D3D11PipelineState);
+      else if(m_APIProps.pipelineType == GraphicsAPI::D3D12)
+        snapser.Serialise("state"_lit, m_D3D12PipelineState);
+      else if(m_APIProps.pipelineType == GraphicsAPI::OpenGL)
+        snapser.Serialise("state"_lit, m_GLPipelineState);
+      else if(m_APIProps.pipelineType == GraphicsAPI::Vulkan)
+        snapser.Serialise("state"_lit, m_VulkanPipelineState);
+
       if(m_APIProps.pipelineType == GraphicsAPI::D3D11)
       {
         D3D11Pipe::Shader *stages[] = {
@@ -1666,12 +1728,36 @@ void ReplayProxy::Proxied_ReplayLog(ParamSerialiser &paramser, ReturnSerialiser
   if(retser.IsReading())
   {
     m_TextureProxyCache.clear();
+
+    // all buffers are invalidated on event change. GetUsage can't tell us which buffers are
+    // genuinely static - CPU updates (glBufferSubData, mapped memory flushes) replay without
+    // generating any EventUsage - so we rely on the delta transfer in CacheBufferData to turn a
+    // re-fetch of unchanged contents into just a hash check with no payload.
     m_BufferProxyCache.clear();
+    m_PartialTextureRects.clear();
+    m_PartialTextureData.clear();
+    m_PreviewTextures.clear();
   }
 
   m_EventID = endEventID;
+  m_ReplayLogType = replayType;
+  m_HasReplayed = true;
 
   SERIALISE_RETURN_VOID();
+
+  // on the client, pull in the structured chunks around the new event if the structured file was
+  // synchronised lazily, so the API inspector has them without a round trip per event. This is a
+  // fresh request/reply exchange - the reply above has been fully consumed so the connection is
+  // idle again.
+  if(paramser.IsWriting() && !m_IsErrored)
+    FetchStructuredChunksForEvent(endEventID);
+
+  // on the remote server, once the reply is on the wire speculatively read back the render
+  // targets bound at the new event while the connection is idle - the common follow-up after a
+  // step is the client fetching them for display. Any in-flight request from the client just
+  // waits in the socket buffer until we're done.
+  if(paramser.IsReading() && !m_IsErrored)
+    PrefetchRenderTargets(endEventID);
 }
 
 void ReplayProxy::ReplayLog(uint32_t endEventID, ReplayLogType replayType)
@@ -1679,6 +1765,15 @@ void ReplayProxy::ReplayLog(uint32_t endEventID, ReplayLogType replayType)
   PROXY_FUNCTION(ReplayLog, endEventID, replayType);
 }
 
+
+// above these sizes the structured file is synchronised lazily: the chunk table is sent eagerly
+// as metadata-only stubs and the full SDObject trees (plus the buffers they reference) are fetched
+// on demand as events are inspected, with read-ahead around the current event. Transferring
+// everything up front costs tens of seconds on big captures, almost all of it for chunks that are
+// never looked at.
+static const uint64_t LazyStructuredChunkThreshold = 10000;
+static const uint64_t LazyStructuredBufferThreshold = 64 * 1024 * 1024;
+
 template <typename ParamSerialiser, typename ReturnSerialiser>
 void ReplayProxy::Proxied_FetchStructuredFile(ParamSerialiser &paramser, ReturnSerialiser &retser)
 {
@@ -1702,6 +1797,23 @@ void ReplayProxy::Proxied_FetchStructuredFile(ParamSerialiser &paramser, ReturnS
     ReturnSerialiser &ser = retser;
     PACKET_HEADER(packet);
 
+    // the remote side decides whether to synchronise lazily, based on how big the transfer would
+    // be. The stubs it sends are flagged with SDChunkFlags::StubChunk, the same marker the local
+    // lazy structured load uses, so UI code treats both cases identically.
+    bool lazySync = false;
+
+    if(ser.IsWriting())
+    {
+      uint64_t bufferBytes = 0;
+      for(size_t b = 0; b < file->buffers.size(); b++)
+        bufferBytes += file->buffers[b]->size();
+
+      lazySync = file->chunks.size() > LazyStructuredChunkThreshold ||
+                 bufferBytes > LazyStructuredBufferThreshold;
+    }
+
+    ser.Serialise("lazySync"_lit, lazySync);
+
     uint64_t chunkCount = file->chunks.size();
     SERIALISE_ELEMENT(chunkCount);
 
@@ -1713,7 +1825,20 @@ void ReplayProxy::Proxied_FetchStructuredFile(ParamSerialiser &paramser, ReturnS
       if(retser.IsReading())
         file->chunks[c] = new SDChunk("");
 
-      ser.Serialise("chunk"_lit, *file->chunks[c]);
+      if(lazySync && ser.IsWriting())
+      {
+        // send a metadata-only stub - the tree is fetched on demand in FetchStructuredChunks
+        SDChunk stub(file->chunks[c]->name.c_str());
+        stub.metadata = file->chunks[c]->metadata;
+        stub.metadata.flags |= SDChunkFlags::StubChunk;
+        stub.type.byteSize = file->chunks[c]->type.byteSize;
+
+        ser.Serialise("chunk"_lit, stub);
+      }
+      else
+      {
+        ser.Serialise("chunk"_lit, *file->chunks[c]);
+      }
     }
 
     uint64_t bufferCount = file->buffers.size();
@@ -1727,6 +1852,11 @@ void ReplayProxy::Proxied_FetchStructuredFile(ParamSerialiser &paramser, ReturnS
       if(retser.IsReading())
         file->buffers[b] = new bytebuf;
 
+      // in lazy mode buffers stay empty on the client and are filled in when a chunk referencing
+      // them is fetched.
+      if(lazySync)
+        continue;
+
       bytebuf *buf = file->buffers[b];
 
       ser.Serialise("buffer"_lit, *buf);
@@ -1745,6 +1875,133 @@ void ReplayProxy::FetchStructuredFile()
   PROXY_FUNCTION(FetchStructuredFile);
 }
 
+// collects the indices of any structured buffers referenced in an SDObject tree, so the buffers
+// backing a chunk can be transferred along with it.
+static void GatherBufferReferences(const SDObject *obj, std::set<uint64_t> &buffers)
+{
+  if(obj->type.basetype == SDBasic::Buffer)
+    buffers.insert(obj->data.basic.u);
+
+  for(size_t i = 0; i < obj->NumChildren(); i++)
+    GatherBufferReferences(obj->GetChild(i), buffers);
+}
+
+template <typename ParamSerialiser, typename ReturnSerialiser>
+void ReplayProxy::Proxied_FetchStructuredChunks(ParamSerialiser &paramser, ReturnSerialiser &retser,
+                                                const std::vector<uint32_t> &chunks)
+{
+  const ReplayProxyPacket expectedPacket = eReplayProxy_FetchStructuredChunks;
+  ReplayProxyPacket packet = eReplayProxy_FetchStructuredChunks;
+
+  std::vector<uint32_t> indices = chunks;
+
+  {
+    BEGIN_PARAMS();
+    SERIALISE_ELEMENT(indices);
+    END_PARAMS();
+  }
+
+  SDFile *file = &m_StructuredFile;
+
+  {
+    REMOTE_EXECUTION();
+    if(paramser.IsReading() && !paramser.IsErrored() && !m_IsErrored)
+      file = (SDFile *)&m_Remote->GetStructuredFile();
+  }
+
+  {
+    ReturnSerialiser &ser = retser;
+    PACKET_HEADER(packet);
+
+    // serialise the requested chunk trees, replacing the client's stubs. Both sides skip invalid
+    // indices identically so the stream stays in sync.
+    for(size_t i = 0; i < indices.size(); i++)
+    {
+      size_t c = indices[i];
+
+      if(c >= file->chunks.size())
+        continue;
+
+      if(retser.IsReading())
+      {
+        delete file->chunks[c];
+        file->chunks[c] = new SDChunk("");
+      }
+
+      ser.Serialise("chunk"_lit, *file->chunks[c]);
+    }
+
+    // send along any buffers the requested chunks reference that haven't been transferred yet.
+    std::vector<uint64_t> newBuffers;
+
+    if(ser.IsWriting())
+    {
+      std::set<uint64_t> refs;
+
+      for(size_t i = 0; i < indices.size(); i++)
+        if(indices[i] < file->chunks.size())
+          GatherBufferReferences(file->chunks[indices[i]], refs);
+
+      for(uint64_t b : refs)
+        if(b < file->buffers.size() && m_TransferredBuffers.insert(b).second)
+          newBuffers.push_back(b);
+    }
+
+    SERIALISE_ELEMENT(newBuffers);
+
+    for(size_t i = 0; i < newBuffers.size(); i++)
+    {
+      bytebuf dummy;
+      uint64_t b = newBuffers[i];
+
+      bytebuf *buf = b < file->buffers.size() ? file->buffers[b] : &dummy;
+
+      ser.Serialise("buffer"_lit, *buf);
+    }
+
+    SERIALISE_ELEMENT(packet);
+
+    ser.EndChunk();
+  }
+
+  CheckError(packet, expectedPacket);
+}
+
+void ReplayProxy::FetchStructuredChunks(const std::vector<uint32_t> &chunks)
+{
+  PROXY_FUNCTION(FetchStructuredChunks, chunks);
+}
+
+void ReplayProxy::FetchStructuredChunksForEvent(uint32_t eventId)
+{
+  // read ahead a window of events either side of the one being inspected, roughly matching what
+  // the event browser has visible, so stepping through nearby events is a no-op.
+  const uint32_t eventWindow = 128;
+
+  uint32_t first = eventId > eventWindow ? eventId - eventWindow : 0;
+  uint32_t last = eventId + eventWindow;
+
+  std::set<uint32_t> want;
+
+  for(uint32_t eid = first; eid <= last && eid < m_Drawcalls.size(); eid++)
+  {
+    const DrawcallDescription *draw = m_Drawcalls[eid];
+
+    if(!draw)
+      continue;
+
+    for(const APIEvent &ev : draw->events)
+    {
+      if(ev.chunkIndex < m_StructuredFile.chunks.size() &&
+         bool(m_StructuredFile.chunks[ev.chunkIndex]->metadata.flags & SDChunkFlags::StubChunk))
+        want.insert(ev.chunkIndex);
+    }
+  }
+
+  if(!want.empty())
+    FetchStructuredChunks(std::vector<uint32_t>(want.begin(), want.end()));
+}
+
 struct DeltaSection
 {
   uint64_t offs = 0;
@@ -1761,7 +2018,8 @@ void DoSerialise(SerialiserType &ser, DeltaSection &el)
 }
 
 template <typename SerialiserType>
-void ReplayProxy::DeltaTransferBytes(SerialiserType &xferser, bytebuf &referenceData, bytebuf &newData)
+bool ReplayProxy::DeltaTransferBytes(SerialiserType &xferser, bytebuf &referenceData,
+                                     uint64_t &referenceHash, bytebuf &newData)
 {
   char empty[128] = {};
 
@@ -1779,7 +2037,7 @@ void ReplayProxy::DeltaTransferBytes(SerialiserType &xferser, bytebuf &reference
     {
       // fast path - no changes.
       RDCDEBUG("Unchanged");
-      return;
+      return false;
     }
     else
     {
@@ -1841,17 +2099,28 @@ void ReplayProxy::DeltaTransferBytes(SerialiserType &xferser, bytebuf &reference
                  (uint32_t)deltas.size(), deltaBytes, (uint64_t)referenceData.size());
       }
     }
+
+    return true;
   }
   else
   {
     uint64_t uncompSize = 0;
 
+    // hash the new contents so that unchanged resources are detected with one pass over the new
+    // data, without comparing against the reference copy chunk-by-chunk.
+    uint64_t newHash = XXH64(newData.data(), newData.size(), 0);
+
     if(referenceData.empty())
     {
       // no previous reference data, need to transfer the whole object.
       deltas.resize(1);
       deltas.back().contents = newData;
     }
+    else if(newHash == referenceHash && referenceData.size() == newData.size())
+    {
+      // content hash matches the last transfer - nothing changed, leave the delta list empty so
+      // we send the 'unchanged' fast path below.
+    }
     else
     {
       if(referenceData.size() != newData.size())
@@ -1988,13 +2257,16 @@ void ReplayProxy::DeltaTransferBytes(SerialiserType &xferser, bytebuf &reference
     }
 
     // This is the proxy side, so we have the complete newest contents in data. Swap the new data
-    // into refData for next time.
+    // into refData for next time, and remember its hash.
+    referenceHash = newHash;
     referenceData.swap(newData);
+
+    return !deltas.empty();
   }
 }
 
 template <typename ParamSerialiser, typename ReturnSerialiser>
-void ReplayProxy::Proxied_CacheBufferData(ParamSerialiser &paramser, ReturnSerialiser &retser,
+bool ReplayProxy::Proxied_CacheBufferData(ParamSerialiser &paramser, ReturnSerialiser &retser,
                                           ResourceId buff)
 {
   const ReplayProxyPacket expectedPacket = eReplayProxy_CacheBufferData;
@@ -2020,20 +2292,24 @@ void ReplayProxy::Proxied_CacheBufferData(ParamSerialiser &paramser, ReturnSeria
     SERIALISE_ELEMENT(packet);
   }
 
-  DeltaTransferBytes(retser, m_ProxyBufferData[buff], data);
+  // both sides compute the same changed flag from the delta transfer itself, so it doesn't need
+  // serialising separately.
+  bool changed = DeltaTransferBytes(retser, m_ProxyBufferData[buff], m_ProxyBufferHashes[buff], data);
 
   retser.EndChunk();
 
   CheckError(packet, expectedPacket);
+
+  return changed;
 }
 
-void ReplayProxy::CacheBufferData(ResourceId buff)
+bool ReplayProxy::CacheBufferData(ResourceId buff)
 {
   PROXY_FUNCTION(CacheBufferData, buff);
 }
 
 template <typename ParamSerialiser, typename ReturnSerialiser>
-void ReplayProxy::Proxied_CacheTextureData(ParamSerialiser &paramser, ReturnSerialiser &retser,
+bool ReplayProxy::Proxied_CacheTextureData(ParamSerialiser &paramser, ReturnSerialiser &retser,
                                            ResourceId tex, uint32_t arrayIdx, uint32_t mip,
                                            const GetTextureDataParams &params)
 {
@@ -2054,7 +2330,10 @@ void ReplayProxy::Proxied_CacheTextureData(ParamSerialiser &paramser, ReturnSeri
   {
     REMOTE_EXECUTION();
     if(paramser.IsReading() && !paramser.IsErrored() && !m_IsErrored)
-      m_Remote->GetTextureData(tex, arrayIdx, mip, params, data);
+    {
+      if(!GetPrefetchedTextureData(tex, arrayIdx, mip, params, data))
+        m_Remote->GetTextureData(tex, arrayIdx, mip, params, data);
+    }
   }
 
   {
@@ -2064,21 +2343,191 @@ void ReplayProxy::Proxied_CacheTextureData(ParamSerialiser &paramser, ReturnSeri
   }
 
   TextureCacheEntry entry = {tex, arrayIdx, mip};
-  DeltaTransferBytes(retser, m_ProxyTextureData[entry], data);
+  bool changed =
+      DeltaTransferBytes(retser, m_ProxyTextureData[entry], m_ProxyTextureHashes[entry], data);
 
   retser.EndChunk();
 
   CheckError(packet, expectedPacket);
+
+  return changed;
 }
 
-void ReplayProxy::CacheTextureData(ResourceId tex, uint32_t arrayIdx, uint32_t mip,
+bool ReplayProxy::CacheTextureData(ResourceId tex, uint32_t arrayIdx, uint32_t mip,
                                    const GetTextureDataParams &params)
 {
   PROXY_FUNCTION(CacheTextureData, tex, arrayIdx, mip, params);
 }
 
+template <typename ParamSerialiser, typename ReturnSerialiser>
+void ReplayProxy::Proxied_CacheBufferDataBatch(ParamSerialiser &paramser, ReturnSerialiser &retser,
+                                               const std::vector<ResourceId> &buffs,
+                                               std::vector<bool> &changed)
+{
+  const ReplayProxyPacket expectedPacket = eReplayProxy_CacheBufferDataBatch;
+  ReplayProxyPacket packet = eReplayProxy_CacheBufferDataBatch;
+
+  {
+    BEGIN_PARAMS();
+    SERIALISE_ELEMENT(buffs);
+    END_PARAMS();
+  }
+
+  std::vector<bytebuf> data;
+  data.resize(buffs.size());
+
+  {
+    REMOTE_EXECUTION();
+    if(paramser.IsReading() && !paramser.IsErrored() && !m_IsErrored)
+    {
+      for(size_t i = 0; i < buffs.size(); i++)
+        m_Remote->GetBufferData(buffs[i], 0, 0, data[i]);
+    }
+  }
+
+  {
+    ReturnSerialiser &ser = retser;
+    PACKET_HEADER(packet);
+    SERIALISE_ELEMENT(packet);
+  }
+
+  // the reply contains all the delta-encoded contents back-to-back - one round trip however many
+  // buffers were requested.
+  changed.resize(buffs.size());
+  for(size_t i = 0; i < buffs.size(); i++)
+    changed[i] =
+        DeltaTransferBytes(retser, m_ProxyBufferData[buffs[i]], m_ProxyBufferHashes[buffs[i]], data[i]);
+
+  retser.EndChunk();
+
+  CheckError(packet, expectedPacket);
+}
+
+void ReplayProxy::CacheBufferDataBatch(const std::vector<ResourceId> &buffs,
+                                       std::vector<bool> &changed)
+{
+  PROXY_FUNCTION(CacheBufferDataBatch, buffs, changed);
+}
+
+template <typename ParamSerialiser, typename ReturnSerialiser>
+void ReplayProxy::Proxied_CacheTextureDataBatch(ParamSerialiser &paramser, ReturnSerialiser &retser,
+                                                ResourceId tex,
+                                                const std::vector<uint32_t> &arrayIdxs, uint32_t mip,
+                                                const GetTextureDataParams &params,
+                                                std::vector<bool> &changed)
+{
+  const ReplayProxyPacket expectedPacket = eReplayProxy_CacheTextureDataBatch;
+  ReplayProxyPacket packet = eReplayProxy_CacheTextureDataBatch;
+
+  {
+    BEGIN_PARAMS();
+    SERIALISE_ELEMENT(tex);
+    SERIALISE_ELEMENT(arrayIdxs);
+    SERIALISE_ELEMENT(mip);
+    SERIALISE_ELEMENT(params);
+    END_PARAMS();
+  }
+
+  std::vector<bytebuf> data;
+  data.resize(arrayIdxs.size());
+
+  {
+    REMOTE_EXECUTION();
+    if(paramser.IsReading() && !paramser.IsErrored() && !m_IsErrored)
+    {
+      for(size_t i = 0; i < arrayIdxs.size(); i++)
+        m_Remote->GetTextureData(tex, arrayIdxs[i], mip, params, data[i]);
+    }
+  }
+
+  {
+    ReturnSerialiser &ser = retser;
+    PACKET_HEADER(packet);
+    SERIALISE_ELEMENT(packet);
+  }
+
+  changed.resize(arrayIdxs.size());
+  for(size_t i = 0; i < arrayIdxs.size(); i++)
+  {
+    TextureCacheEntry entry = {tex, arrayIdxs[i], mip};
+    changed[i] =
+        DeltaTransferBytes(retser, m_ProxyTextureData[entry], m_ProxyTextureHashes[entry], data[i]);
+  }
+
+  retser.EndChunk();
+
+  CheckError(packet, expectedPacket);
+}
+
+void ReplayProxy::CacheTextureDataBatch(ResourceId tex, const std::vector<uint32_t> &arrayIdxs,
+                                        uint32_t mip, const GetTextureDataParams &params,
+                                        std::vector<bool> &changed)
+{
+  PROXY_FUNCTION(CacheTextureDataBatch, tex, arrayIdxs, mip, params, changed);
+}
+
 #pragma endregion Proxied Functions
 
+void ReplayProxy::PrefetchRenderTargets(uint32_t eventId)
+{
+  // whatever we speculated last time is for the wrong event now.
+  m_PrefetchedTextures.clear();
+
+  // we need the frame record to know the outputs of the event. The client fetches it early in
+  // every session, so this only skips speculating before anything has been replayed.
+  const DrawcallDescription *draw = FindDraw(m_FrameRecord.drawcallList, eventId);
+
+  if(!draw)
+    return;
+
+  std::vector<ResourceId> targets;
+
+  for(ResourceId id : draw->outputs)
+  {
+    if(id != ResourceId())
+      targets.push_back(id);
+  }
+
+  if(draw->depthOut != ResourceId())
+    targets.push_back(draw->depthOut);
+
+  for(ResourceId id : targets)
+  {
+    TextureDescription desc = m_Remote->GetTexture(id);
+
+    // only speculate on the simple common case. MSAA textures are fetched with remapped
+    // per-sample subresource indices, and 3D textures as a whole - we can't predict either here.
+    if(desc.msSamp > 1 || desc.dimension == 3)
+      continue;
+
+    PrefetchedTexture &tex = m_PrefetchedTextures[{id, 0, 0}];
+    m_Remote->GetTextureData(id, 0, 0, tex.params, tex.data);
+  }
+}
+
+bool ReplayProxy::GetPrefetchedTextureData(ResourceId tex, uint32_t arrayIdx, uint32_t mip,
+                                           const GetTextureDataParams &params, bytebuf &data)
+{
+  TextureCacheEntry entry = {tex, arrayIdx, mip};
+
+  auto it = m_PrefetchedTextures.find(entry);
+  if(it == m_PrefetchedTextures.end())
+    return false;
+
+  // the prefetch guessed default parameters - if the client needs some remapping or resolve we
+  // can't use it, fall back to a real readback.
+  const GetTextureDataParams &p = it->second.params;
+  if(params.forDiskSave != p.forDiskSave || params.typeHint != p.typeHint ||
+     params.resolve != p.resolve || params.remap != p.remap ||
+     params.blackPoint != p.blackPoint || params.whitePoint != p.whitePoint)
+    return false;
+
+  data.swap(it->second.data);
+  m_PrefetchedTextures.erase(it);
+
+  return true;
+}
+
 // If a remap is required, modify the params that are used when getting the proxy texture data
 // for replay on the current driver.
 void ReplayProxy::RemapProxyTextureIfNeeded(TextureDescription &tex, GetTextureDataParams &params)
@@ -2156,7 +2605,489 @@ void ReplayProxy::RemapProxyTextureIfNeeded(TextureDescription &tex, GetTextureD
   }
 }
 
-void ReplayProxy::EnsureTexCached(ResourceId texid, uint32_t arrayIdx, uint32_t mip)
+// mips at least this large (in bytes) stream only the visible portion over the remote
+// connection, instead of transferring the whole subresource before anything displays.
+static const uint64_t PartialFetchThresholdBytes = 64 * 1024 * 1024;
+
+// fetched rects are aligned out to this tile size, so panning by a few pixels doesn't cause a
+// fresh transfer. Must be a power of two.
+static const uint32_t PartialFetchTileSize = 256;
+
+// upper bound on the bytes fetched for one visible rect. Zoomed out far enough that the visible
+// region exceeds this, the rect shrinks around its centre and the low-res base fills the rest.
+static const uint64_t PartialFetchMaxBytes = 64 * 1024 * 1024;
+
+// the low-res base is the largest mip of the texture no bigger than this.
+static const uint64_t PartialFetchBaseSizeBytes = 4 * 1024 * 1024;
+
+// subresources at least this large (in bytes) are eligible for a downsampled lossy preview when
+// they're displayed well below their native resolution.
+static const uint64_t PreviewFetchThresholdBytes = 4 * 1024 * 1024;
+
+// upper bound on the preview downsample factor, so extreme zoom-out doesn't reduce textures to a
+// handful of texels.
+static const uint32_t PreviewMaxDownsample = 16;
+
+// byte size of one texel as transferred over the proxy connection, taking any remap into account.
+// Returns 0 for formats that can't be cropped as tightly packed rows of texels.
+static uint32_t ProxyTexelByteSize(const ResourceFormat &fmt, const GetTextureDataParams &params)
+{
+  switch(params.remap)
+  {
+    case RemapTexture::RGBA8: return 4;
+    case RemapTexture::RGBA16: return 8;
+    case RemapTexture::RGBA32: return 16;
+    default: break;
+  }
+
+  if(fmt.type != ResourceFormatType::Regular)
+    return 0;
+
+  return fmt.compByteWidth * fmt.compCount;
+}
+
+bool ReplayProxy::GetPartialFetchRect(const TextureCacheEntry &entry, const TextureDisplay &display,
+                                      TexelRect &rect)
+{
+  if(display.viewportWidth == 0 || display.viewportHeight == 0)
+    return false;
+
+  auto texIt = m_TextureInfo.find(entry.replayid);
+  if(texIt == m_TextureInfo.end())
+    return false;
+
+  const TextureDescription &desc = texIt->second;
+
+  // only 2D non-MSAA textures with an uncompressed (possibly remapped) representation can be
+  // cropped into tiles on the remote side.
+  if(desc.dimension != 2 || desc.msSamp > 1)
+    return false;
+
+  uint32_t bpp = ProxyTexelByteSize(desc.format, m_ProxyTextures[entry.replayid].params);
+  if(bpp == 0)
+    return false;
+
+  uint32_t mipWidth = RDCMAX(1U, desc.width >> entry.mip);
+  uint32_t mipHeight = RDCMAX(1U, desc.height >> entry.mip);
+
+  // small subresources just transfer whole.
+  if(uint64_t(mipWidth) * mipHeight * bpp < PartialFetchThresholdBytes)
+    return false;
+
+  // scale is in output pixels per mip 0 texel. Negative scale means fit-to-window - thumbnails
+  // render that way with no offset.
+  float scale = display.scale;
+  if(scale <= 0.0f)
+    scale = RDCMIN(float(display.viewportWidth) / float(desc.width),
+                   float(display.viewportHeight) / float(desc.height));
+
+  if(scale <= 0.0f)
+    return false;
+
+  // unproject the viewport corners into mip 0 texel space
+  float tx0 = (0.0f - display.xOffset) / scale;
+  float tx1 = (float(display.viewportWidth) - display.xOffset) / scale;
+  float ty0 = (0.0f - display.yOffset) / scale;
+  float ty1 = (float(display.viewportHeight) - display.yOffset) / scale;
+
+  if(display.flipY)
+  {
+    float y = ty0;
+    ty0 = float(desc.height) - ty1;
+    ty1 = float(desc.height) - y;
+  }
+
+  // convert to texels in the displayed mip, clamped to its dimensions
+  float mipScale = float(1U << entry.mip);
+
+  uint32_t x0 = uint32_t(RDCCLAMP(floorf(tx0 / mipScale), 0.0f, float(mipWidth)));
+  uint32_t x1 = uint32_t(RDCCLAMP(ceilf(tx1 / mipScale), 0.0f, float(mipWidth)));
+  uint32_t y0 = uint32_t(RDCCLAMP(floorf(ty0 / mipScale), 0.0f, float(mipHeight)));
+  uint32_t y1 = uint32_t(RDCCLAMP(ceilf(ty1 / mipScale), 0.0f, float(mipHeight)));
+
+  // panned entirely off screen - keep a single texel at the nearest edge so the tile alignment
+  // below still produces a valid rect.
+  if(x1 <= x0)
+  {
+    x0 = RDCMIN(x0, mipWidth - 1);
+    x1 = x0 + 1;
+  }
+  if(y1 <= y0)
+  {
+    y0 = RDCMIN(y0, mipHeight - 1);
+    y1 = y0 + 1;
+  }
+
+  // align out to whole tiles
+  x0 &= ~(PartialFetchTileSize - 1);
+  y0 &= ~(PartialFetchTileSize - 1);
+  x1 = RDCMIN(mipWidth, AlignUp(x1, PartialFetchTileSize));
+  y1 = RDCMIN(mipHeight, AlignUp(y1, PartialFetchTileSize));
+
+  // when zoomed out the visible region can cover most of a huge mip - shrink around the centre
+  // to keep the transfer bounded, and let the low-res base cover the edges until the user zooms.
+  while(uint64_t(x1 - x0) * (y1 - y0) * bpp > PartialFetchMaxBytes)
+  {
+    if(x1 - x0 >= y1 - y0)
+    {
+      uint32_t centre = x0 + (x1 - x0) / 2;
+      uint32_t width = RDCMAX(PartialFetchTileSize, (x1 - x0) / 2);
+      x0 = (centre > width / 2 ? centre - width / 2 : 0) & ~(PartialFetchTileSize - 1);
+      x1 = RDCMIN(mipWidth, x0 + width);
+    }
+    else
+    {
+      uint32_t centre = y0 + (y1 - y0) / 2;
+      uint32_t height = RDCMAX(PartialFetchTileSize, (y1 - y0) / 2);
+      y0 = (centre > height / 2 ? centre - height / 2 : 0) & ~(PartialFetchTileSize - 1);
+      y1 = RDCMIN(mipHeight, y0 + height);
+    }
+  }
+
+  rect = {x0, y0, x1 - x0, y1 - y0};
+
+  return true;
+}
+
+void ReplayProxy::FetchPartialTexture(const TextureCacheEntry &entry, const TexelRect &rect)
+{
+  const TextureDescription &desc = m_TextureInfo[entry.replayid];
+  const ProxyTextureProperties &proxy = m_ProxyTextures[entry.replayid];
+
+  uint32_t bpp = ProxyTexelByteSize(desc.format, proxy.params);
+
+  uint32_t mipWidth = RDCMAX(1U, desc.width >> entry.mip);
+  uint32_t mipHeight = RDCMAX(1U, desc.height >> entry.mip);
+  uint64_t rowPitch = uint64_t(mipWidth) * bpp;
+
+  bytebuf &composed = m_PartialTextureData[entry];
+  std::vector<TexelRect> &rects = m_PartialTextureRects[entry];
+
+  // first touch - build the low-res base that the full-resolution tiles refine. We fetch the
+  // largest mip under the base size limit whole, and point-upscale it, so panning into regions
+  // that haven't been fetched yet shows a blurry preview instead of garbage.
+  if(composed.empty())
+  {
+    composed.resize(size_t(rowPitch * mipHeight));
+
+    uint32_t baseMip = entry.mip;
+    for(uint32_t m = entry.mip + 1; m < desc.mips; m++)
+    {
+      baseMip = m;
+      if(uint64_t(RDCMAX(1U, desc.width >> m)) * RDCMAX(1U, desc.height >> m) * bpp <=
+         PartialFetchBaseSizeBytes)
+        break;
+    }
+
+    if(baseMip != entry.mip)
+    {
+      EnsureTexCached(entry.replayid, entry.arrayIdx, baseMip);
+
+      TextureCacheEntry baseEntry = entry;
+      baseEntry.mip = baseMip;
+
+      auto baseIt = m_ProxyTextureData.find(baseEntry);
+
+      uint32_t baseWidth = RDCMAX(1U, desc.width >> baseMip);
+      uint32_t baseHeight = RDCMAX(1U, desc.height >> baseMip);
+
+      if(baseIt != m_ProxyTextureData.end() &&
+         baseIt->second.size() >= size_t(baseWidth) * baseHeight * bpp)
+      {
+        const byte *base = baseIt->second.data();
+
+        // nearest-neighbour upscale, duplicating whole rows where possible.
+        for(uint32_t y = 0; y < mipHeight; y++)
+        {
+          byte *dstRow = composed.data() + y * rowPitch;
+          uint32_t srcY = uint32_t(uint64_t(y) * baseHeight / mipHeight);
+
+          if(y > 0 && srcY == uint32_t(uint64_t(y - 1) * baseHeight / mipHeight))
+          {
+            memcpy(dstRow, dstRow - rowPitch, size_t(rowPitch));
+            continue;
+          }
+
+          const byte *srcRow = base + uint64_t(srcY) * baseWidth * bpp;
+          for(uint32_t x = 0; x < mipWidth; x++)
+          {
+            uint32_t srcX = uint32_t(uint64_t(x) * baseWidth / mipWidth);
+            memcpy(dstRow + uint64_t(x) * bpp, srcRow + uint64_t(srcX) * bpp, bpp);
+          }
+        }
+      }
+    }
+  }
+
+  // fetch the full-resolution rect and splat it over the composed copy.
+  if(rect.width > 0 && rect.height > 0)
+  {
+    GetTextureDataParams params = proxy.params;
+    params.partialX = rect.x;
+    params.partialY = rect.y;
+    params.partialWidth = rect.width;
+    params.partialHeight = rect.height;
+
+    bytebuf data;
+    GetTextureData(entry.replayid, entry.arrayIdx, entry.mip, params, data);
+
+    if(data.size() == size_t(rect.width) * rect.height * bpp)
+    {
+      for(uint32_t y = 0; y < rect.height; y++)
+        memcpy(composed.data() + (rect.y + y) * rowPitch + uint64_t(rect.x) * bpp,
+               data.data() + uint64_t(y) * rect.width * bpp, size_t(rect.width) * bpp);
+
+      rects.push_back(rect);
+    }
+    else
+    {
+      RDCERR("Partial fetch returned %llu bytes, expected %llu", (uint64_t)data.size(),
+             uint64_t(rect.width) * rect.height * bpp);
+    }
+  }
+
+  m_Proxy->SetProxyTextureData(proxy.id, entry.arrayIdx, entry.mip, composed.data(),
+                               composed.size());
+
+  m_TextureProxyCache.insert(entry);
+}
+
+void ReplayProxy::CropPartialTextureData(ResourceId tex, uint32_t mip,
+                                         const GetTextureDataParams &params, bytebuf &data)
+{
+  TextureDescription desc = m_Remote->GetTexture(tex);
+
+  uint32_t bpp = ProxyTexelByteSize(desc.format, params);
+
+  uint32_t mipWidth = RDCMAX(1U, desc.width >> mip);
+  uint32_t mipHeight = RDCMAX(1U, desc.height >> mip);
+  uint64_t rowPitch = uint64_t(mipWidth) * bpp;
+
+  if(bpp == 0 || params.partialX + params.partialWidth > mipWidth ||
+     params.partialY + params.partialHeight > mipHeight ||
+     data.size() < size_t(rowPitch * mipHeight))
+  {
+    // send the full data rather than nothing - the client detects the size mismatch.
+    RDCERR("Invalid partial fetch of %s mip %u: %ux%u rect at (%u, %u), %llu bytes read back",
+           ToStr(tex).c_str(), mip, params.partialWidth, params.partialHeight, params.partialX,
+           params.partialY, (uint64_t)data.size());
+    return;
+  }
+
+  bytebuf cropped;
+  cropped.resize(size_t(params.partialWidth) * params.partialHeight * bpp);
+
+  for(uint32_t y = 0; y < params.partialHeight; y++)
+    memcpy(cropped.data() + size_t(y) * params.partialWidth * bpp,
+           data.data() + (params.partialY + y) * rowPitch + uint64_t(params.partialX) * bpp,
+           size_t(params.partialWidth) * bpp);
+
+  data.swap(cropped);
+}
+
+uint32_t ReplayProxy::GetPreviewDownsampleFactor(const TextureCacheEntry &entry,
+                                                 const TextureDisplay &display)
+{
+  if(display.viewportWidth == 0 || display.viewportHeight == 0)
+    return 1;
+
+  auto texIt = m_TextureInfo.find(entry.replayid);
+  if(texIt == m_TextureInfo.end())
+    return 1;
+
+  const TextureDescription &desc = texIt->second;
+
+  // as with partial fetches, only 2D non-MSAA textures with an uncompressed (possibly remapped)
+  // representation can be reduced on the remote side.
+  if(desc.dimension != 2 || desc.msSamp > 1)
+    return 1;
+
+  uint32_t bpp = ProxyTexelByteSize(desc.format, m_ProxyTextures[entry.replayid].params);
+  if(bpp == 0)
+    return 1;
+
+  uint32_t mipWidth = RDCMAX(1U, desc.width >> entry.mip);
+  uint32_t mipHeight = RDCMAX(1U, desc.height >> entry.mip);
+
+  uint64_t mipBytes = uint64_t(mipWidth) * mipHeight * bpp;
+
+  // small subresources aren't worth a lossy preview, and huge ones stream in visible tiles on a
+  // low-res base instead.
+  if(mipBytes < PreviewFetchThresholdBytes || mipBytes >= PartialFetchThresholdBytes)
+    return 1;
+
+  // scale is in output pixels per mip 0 texel. Negative scale means fit-to-window - thumbnails
+  // render that way with no offset.
+  float scale = display.scale;
+  if(scale <= 0.0f)
+    scale = RDCMIN(float(display.viewportWidth) / float(desc.width),
+                   float(display.viewportHeight) / float(desc.height));
+
+  if(scale <= 0.0f)
+    return 1;
+
+  // the size of one texel of the displayed mip in output pixels
+  float texelSize = scale * float(1U << entry.mip);
+
+  // largest power of two reduction where the preview still has at least one texel per displayed
+  // pixel, so the preview is indistinguishable at the current zoom.
+  uint32_t factor = 1;
+  while(factor < PreviewMaxDownsample && texelSize * float(factor * 2) <= 1.0f &&
+        mipWidth / (factor * 2) > 0 && mipHeight / (factor * 2) > 0)
+    factor *= 2;
+
+  return factor;
+}
+
+void ReplayProxy::FetchPreviewTexture(const TextureCacheEntry &entry, uint32_t factor)
+{
+  const TextureDescription &desc = m_TextureInfo[entry.replayid];
+  const ProxyTextureProperties &proxy = m_ProxyTextures[entry.replayid];
+
+  uint32_t bpp = ProxyTexelByteSize(desc.format, proxy.params);
+
+  uint32_t mipWidth = RDCMAX(1U, desc.width >> entry.mip);
+  uint32_t mipHeight = RDCMAX(1U, desc.height >> entry.mip);
+
+  uint32_t dsWidth = RDCMAX(1U, mipWidth / factor);
+  uint32_t dsHeight = RDCMAX(1U, mipHeight / factor);
+
+  GetTextureDataParams params = proxy.params;
+  params.downsampleFactor = factor;
+
+  bytebuf data;
+  GetTextureData(entry.replayid, entry.arrayIdx, entry.mip, params, data);
+
+  if(data.size() == size_t(dsWidth) * dsHeight * bpp)
+  {
+    // point-upscale back to the subresource's real size for upload, so the proxy texture keeps
+    // its dimensions and none of the display maths changes.
+    uint64_t rowPitch = uint64_t(mipWidth) * bpp;
+
+    bytebuf upscaled;
+    upscaled.resize(size_t(rowPitch * mipHeight));
+
+    for(uint32_t y = 0; y < mipHeight; y++)
+    {
+      byte *dstRow = upscaled.data() + y * rowPitch;
+      uint32_t srcY = RDCMIN(dsHeight - 1, y / factor);
+
+      if(y > 0 && srcY == RDCMIN(dsHeight - 1, (y - 1) / factor))
+      {
+        memcpy(dstRow, dstRow - rowPitch, size_t(rowPitch));
+        continue;
+      }
+
+      const byte *srcRow = data.data() + uint64_t(srcY) * dsWidth * bpp;
+      for(uint32_t x = 0; x < mipWidth; x++)
+      {
+        uint32_t srcX = RDCMIN(dsWidth - 1, x / factor);
+        memcpy(dstRow + uint64_t(x) * bpp, srcRow + uint64_t(srcX) * bpp, bpp);
+      }
+    }
+
+    m_Proxy->SetProxyTextureData(proxy.id, entry.arrayIdx, entry.mip, upscaled.data(),
+                                 upscaled.size());
+
+    m_PreviewTextures[entry] = factor;
+    m_TextureProxyCache.insert(entry);
+    return;
+  }
+
+  // the remote side fell back to a full-resolution transfer - upload it as the real contents.
+  if(data.size() == size_t(mipWidth) * mipHeight * bpp)
+  {
+    m_Proxy->SetProxyTextureData(proxy.id, entry.arrayIdx, entry.mip, data.data(), data.size());
+    m_TextureProxyCache.insert(entry);
+    return;
+  }
+
+  RDCERR("Preview fetch of %s mip %u returned %llu bytes, expected %llu",
+         ToStr(entry.replayid).c_str(), entry.mip, (uint64_t)data.size(),
+         uint64_t(dsWidth) * dsHeight * bpp);
+}
+
+void ReplayProxy::DownsampleTextureData(ResourceId tex, uint32_t mip,
+                                        const GetTextureDataParams &params, bytebuf &data)
+{
+  TextureDescription desc = m_Remote->GetTexture(tex);
+
+  uint32_t bpp = ProxyTexelByteSize(desc.format, params);
+
+  uint32_t mipWidth = RDCMAX(1U, desc.width >> mip);
+  uint32_t mipHeight = RDCMAX(1U, desc.height >> mip);
+  uint64_t rowPitch = uint64_t(mipWidth) * bpp;
+
+  uint32_t factor = params.downsampleFactor;
+
+  if(bpp == 0 || data.size() < size_t(rowPitch * mipHeight))
+  {
+    // send the full data rather than nothing - the client detects the size mismatch.
+    RDCERR("Invalid preview fetch of %s mip %u: factor %u, %llu bytes read back",
+           ToStr(tex).c_str(), mip, factor, (uint64_t)data.size());
+    return;
+  }
+
+  uint32_t dsWidth = RDCMAX(1U, mipWidth / factor);
+  uint32_t dsHeight = RDCMAX(1U, mipHeight / factor);
+
+  // lossy point-sampled reduction. The preview is replaced with real data on zoom or pixel
+  // inspection, so a cheap filter that works for any texel format wins over a correct box filter
+  // that would have to understand every format.
+  bytebuf reduced;
+  reduced.resize(size_t(dsWidth) * dsHeight * bpp);
+
+  for(uint32_t y = 0; y < dsHeight; y++)
+  {
+    const byte *srcRow = data.data() + uint64_t(RDCMIN(mipHeight - 1, y * factor)) * rowPitch;
+    byte *dstRow = reduced.data() + size_t(y) * dsWidth * bpp;
+
+    for(uint32_t x = 0; x < dsWidth; x++)
+      memcpy(dstRow + uint64_t(x) * bpp, srcRow + uint64_t(RDCMIN(mipWidth - 1, x * factor)) * bpp,
+             bpp);
+  }
+
+  data.swap(reduced);
+}
+
+void ReplayProxy::EnsureTexelCached(ResourceId texid, uint32_t arrayIdx, uint32_t mip, uint32_t x,
+                                    uint32_t y)
+{
+  TextureCacheEntry entry = {texid, arrayIdx, mip};
+
+  auto partIt = m_PartialTextureRects.find(entry);
+  if(partIt == m_PartialTextureRects.end())
+  {
+    EnsureTexCached(texid, arrayIdx, mip);
+    return;
+  }
+
+  // picking from a partially-fetched texture - make sure the tile under the picked texel holds
+  // real data rather than the upscaled base. Picks land inside the visible (and thus fetched)
+  // region in practice, so this rarely transfers anything.
+  const TextureDescription &desc = m_TextureInfo[texid];
+
+  uint32_t mipWidth = RDCMAX(1U, desc.width >> mip);
+  uint32_t mipHeight = RDCMAX(1U, desc.height >> mip);
+
+  if(x >= mipWidth || y >= mipHeight)
+    return;
+
+  TexelRect pick;
+  pick.x = x & ~(PartialFetchTileSize - 1);
+  pick.y = y & ~(PartialFetchTileSize - 1);
+  pick.width = RDCMIN(PartialFetchTileSize, mipWidth - pick.x);
+  pick.height = RDCMIN(PartialFetchTileSize, mipHeight - pick.y);
+
+  for(const TexelRect &r : partIt->second)
+    if(r.Contains(pick))
+      return;
+
+  FetchPartialTexture(entry, pick);
+}
+
+void ReplayProxy::EnsureTexCached(ResourceId texid, uint32_t arrayIdx, uint32_t mip,
+                                  const TextureDisplay *display)
 {
   if(m_Reader.IsErrored() || m_Writer.IsErrored())
     return;
@@ -2173,6 +3104,59 @@ void ReplayProxy::EnsureTexCached(ResourceId texid, uint32_t arrayIdx, uint32_t
   if(m_LocalTextures.find(texid) != m_LocalTextures.end())
     return;
 
+  bool forceUpload = false;
+
+  auto partIt = m_PartialTextureRects.find(entry);
+  if(partIt != m_PartialTextureRects.end())
+  {
+    TexelRect visible;
+    if(display && GetPartialFetchRect(entry, *display, visible))
+    {
+      // displaying again - if a fetched rect already covers the visible region we're done,
+      // otherwise stream in the newly visible tiles.
+      for(const TexelRect &r : partIt->second)
+        if(r.Contains(visible))
+          return;
+
+      FetchPartialTexture(entry, visible);
+      return;
+    }
+
+    // the caller needs the full contents - histograms, custom shaders, etc. Drop the partial
+    // state and fall through to a full fetch. The proxy texture currently holds partial
+    // contents, so the upload can't be skipped even if the delta transfer below reports no
+    // changes since the last full transfer.
+    m_PartialTextureRects.erase(entry);
+    m_PartialTextureData.erase(entry);
+    m_TextureProxyCache.erase(entry);
+    forceUpload = true;
+  }
+
+  auto previewIt = m_PreviewTextures.find(entry);
+  if(previewIt != m_PreviewTextures.end())
+  {
+    uint32_t factor = display ? GetPreviewDownsampleFactor(entry, *display) : 1;
+
+    // still displayed at or below the resolution the preview was fetched for - nothing to do.
+    if(factor >= previewIt->second)
+      return;
+
+    // zoomed in, or the caller needs the real contents - pixel picks, histograms, custom
+    // shaders, saves. Refetch at the new quality, or upgrade to the full data. Either way the
+    // proxy texture holds lossy contents, so the upload can't be skipped even if the delta
+    // transfer below reports no changes since the last full transfer.
+    m_PreviewTextures.erase(previewIt);
+    m_TextureProxyCache.erase(entry);
+
+    if(factor > 1)
+    {
+      FetchPreviewTexture(entry, factor);
+      return;
+    }
+
+    forceUpload = true;
+  }
+
   if(m_TextureProxyCache.find(entry) == m_TextureProxyCache.end())
   {
     if(m_ProxyTextures.find(texid) == m_ProxyTextures.end())
@@ -2189,6 +3173,44 @@ void ReplayProxy::EnsureTexCached(ResourceId texid, uint32_t arrayIdx, uint32_t
 
     const ProxyTextureProperties &proxy = m_ProxyTextures[texid];
 
+    // huge subresources stream in visible tiles on top of a low-res base instead of stalling the
+    // first display on a full transfer.
+    TexelRect visible;
+    if(display && GetPartialFetchRect(entry, *display, visible))
+    {
+      FetchPartialTexture(entry, visible);
+      return;
+    }
+
+    // subresources displayed well below their native resolution fetch a downsampled lossy
+    // preview - the remote side point-samples down to roughly the displayed size, cutting the
+    // transfer by the square of the factor. Zooming in or inspecting pixels upgrades to the real
+    // contents.
+    if(display)
+    {
+      uint32_t previewFactor = GetPreviewDownsampleFactor(entry, *display);
+      if(previewFactor > 1)
+      {
+        FetchPreviewTexture(entry, previewFactor);
+        return;
+      }
+    }
+
+    std::vector<bool> changed(proxy.msSamp, true);
+
+#if ENABLED(TRANSFER_RESOURCE_CONTENTS_DELTAS)
+    // fetch every sample in a single batched round trip - for MSAA textures the per-sample loop
+    // below would otherwise pay a network latency per sample.
+    if(proxy.msSamp > 1)
+    {
+      std::vector<uint32_t> sampleIdxs;
+      for(uint32_t sample = 0; sample < proxy.msSamp; sample++)
+        sampleIdxs.push_back(arrayIdx * proxy.msSamp + sample);
+
+      CacheTextureDataBatch(texid, sampleIdxs, mip, proxy.params, changed);
+    }
+#endif
+
     for(uint32_t sample = 0; sample < proxy.msSamp; sample++)
     {
       // MSAA array textures are remapped so it's:
@@ -2201,11 +3223,19 @@ void ReplayProxy::EnsureTexCached(ResourceId texid, uint32_t arrayIdx, uint32_t
       sampleArrayEntry.arrayIdx = sampleArrayIdx;
 
 #if ENABLED(TRANSFER_RESOURCE_CONTENTS_DELTAS)
-      CacheTextureData(texid, sampleArrayIdx, mip, proxy.params);
+      if(proxy.msSamp == 1)
+        changed[sample] = CacheTextureData(texid, sampleArrayIdx, mip, proxy.params);
 #else
       GetTextureData(texid, sampleArrayIdx, mip, proxy.params, m_ProxyTextureData[entry]);
 #endif
 
+      // if the contents are unchanged since the last transfer, the proxy texture already has
+      // them - stepping between events that don't touch this texture skips the upload entirely.
+      // When upgrading from a partial fetch the proxy texture holds partial contents, so the
+      // upload always happens.
+      if(!changed[sample] && !forceUpload)
+        continue;
+
       auto it = m_ProxyTextureData.find(sampleArrayEntry);
       if(it != m_ProxyTextureData.end())
         m_Proxy->SetProxyTextureData(proxy.id, sampleArrayIdx, mip, it->second.data(),
@@ -2217,31 +3247,67 @@ void ReplayProxy::EnsureTexCached(ResourceId texid, uint32_t arrayIdx, uint32_t
 }
 
 void ReplayProxy::EnsureBufCached(ResourceId bufid)
+{
+  EnsureBufCached(std::vector<ResourceId>(1, bufid));
+}
+
+void ReplayProxy::EnsureBufCached(const std::vector<ResourceId> &bufids)
 {
   if(m_Reader.IsErrored() || m_Writer.IsErrored())
     return;
 
-  if(m_BufferProxyCache.find(bufid) == m_BufferProxyCache.end())
+  // filter down to the buffers that actually need fetching, creating proxy buffers where they
+  // don't exist yet.
+  std::vector<ResourceId> uncached;
+
+  for(ResourceId bufid : bufids)
   {
+    if(bufid == ResourceId() || m_BufferProxyCache.find(bufid) != m_BufferProxyCache.end())
+      continue;
+
+    // don't fetch the same buffer twice if it's listed twice (e.g. used as both vertex and index
+    // buffer).
+    if(std::find(uncached.begin(), uncached.end(), bufid) != uncached.end())
+      continue;
+
     if(m_ProxyBufferIds.find(bufid) == m_ProxyBufferIds.end())
     {
       BufferDescription buf = GetBuffer(bufid);
       m_ProxyBufferIds[bufid] = m_Proxy->CreateProxyBuffer(buf);
     }
 
-    ResourceId proxyid = m_ProxyBufferIds[bufid];
+    uncached.push_back(bufid);
+  }
+
+  if(uncached.empty())
+    return;
+
+  std::vector<bool> changed(uncached.size(), true);
 
 #if ENABLED(TRANSFER_RESOURCE_CONTENTS_DELTAS)
-    CacheBufferData(bufid);
+  // fetch all the buffer contents in one round trip.
+  if(uncached.size() == 1)
+    changed[0] = CacheBufferData(uncached[0]);
+  else
+    CacheBufferDataBatch(uncached, changed);
 #else
+  for(ResourceId bufid : uncached)
     GetBufferData(bufid, 0, 0, m_ProxyBufferData[bufid]);
 #endif
 
-    auto it = m_ProxyBufferData.find(bufid);
-    if(it != m_ProxyBufferData.end())
-      m_Proxy->SetProxyBufferData(proxyid, it->second.data(), it->second.size());
+  for(size_t i = 0; i < uncached.size(); i++)
+  {
+    ResourceId bufid = uncached[i];
 
     m_BufferProxyCache.insert(bufid);
+
+    // unchanged contents are already in the proxy buffer from a previous upload.
+    if(!changed[i])
+      continue;
+
+    auto it = m_ProxyBufferData.find(bufid);
+    if(it != m_ProxyBufferData.end())
+      m_Proxy->SetProxyBufferData(m_ProxyBufferIds[bufid], it->second.data(), it->second.size());
   }
 }
 
@@ -2418,6 +3484,16 @@ void ReplayProxy::BeginRemoteExecution()
     // m_RemoteExecutionActive must be inactive because it starts inactive, and we synchronise it in
     // EndRemoteExecution
     Atomic::CmpExch32(&m_RemoteExecutionState, RemoteExecution_Inactive, RemoteExecution_ThreadIdle);
+
+    // with the keepalive thread now covering us, restore this client's replay position if another
+    // client sharing the replay has moved it since our last command
+    if(m_ResyncReplay)
+    {
+      m_ResyncReplay = false;
+
+      if(m_Remote && m_HasReplayed && !m_IsErrored)
+        m_Remote->ReplayLog(m_EventID, m_ReplayLogType);
+    }
   }
   else
   {
@@ -2559,8 +3635,21 @@ bool ReplayProxy::Tick(int type)
     case eReplayProxy_CacheTextureData:
       CacheTextureData(ResourceId(), 0, 0, GetTextureDataParams());
       break;
+    case eReplayProxy_CacheBufferDataBatch:
+    {
+      std::vector<bool> dummy;
+      CacheBufferDataBatch(std::vector<ResourceId>(), dummy);
+      break;
+    }
+    case eReplayProxy_CacheTextureDataBatch:
+    {
+      std::vector<bool> dummy;
+      CacheTextureDataBatch(ResourceId(), std::vector<uint32_t>(), 0, GetTextureDataParams(), dummy);
+      break;
+    }
     case eReplayProxy_ReplayLog: ReplayLog(0, (ReplayLogType)0); break;
     case eReplayProxy_FetchStructuredFile: FetchStructuredFile(); break;
+    case eReplayProxy_FetchStructuredChunks: FetchStructuredChunks(std::vector<uint32_t>()); break;
     case eReplayProxy_GetAPIProperties: GetAPIProperties(); break;
     case eReplayProxy_GetPassEvents: GetPassEvents(0); break;
     case eReplayProxy_GetResources: GetResources(); break;
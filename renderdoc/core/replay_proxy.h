@@ -99,6 +99,15 @@ enum ReplayProxyPacket
   eReplayProxy_GetTargetShaderEncodings,
 
   eReplayProxy_GetDriverInfo,
+
+  // must be at the end of the list - batched variants of CacheBufferData/CacheTextureData that
+  // fetch several resources in one round trip.
+  eReplayProxy_CacheBufferDataBatch,
+  eReplayProxy_CacheTextureDataBatch,
+
+  // on-demand fetch of structured chunk trees, for captures whose structured file is synchronised
+  // lazily. See FetchStructuredFile/FetchStructuredChunks.
+  eReplayProxy_FetchStructuredChunks,
 };
 
 DECLARE_REFLECTION_ENUM(ReplayProxyPacket);
@@ -154,6 +163,15 @@ public:
   void ShutdownPreviewWindow();
   void RefreshPreviewWindow();
 
+  // remote server only, for when several clients share one loaded replay. Read-only proxies
+  // serialise mutating commands as normal but skip applying them, so one client can't change
+  // what the others see.
+  void SetReadOnly() { m_ReadOnly = true; }
+  // flags that another client has moved the shared replay since our last command. The next
+  // command re-replays to this client's last event before executing - inside the keepalive
+  // window, since the re-replay can be as long as any other replay.
+  void ScheduleReplayResync() { m_ResyncReplay = true; }
+
   void InitRemoteExecutionThread();
   void ShutdownRemoteExecutionThread();
   void BeginRemoteExecution();
@@ -279,7 +297,7 @@ public:
   {
     if(m_Proxy)
     {
-      EnsureTexCached(cfg.resourceId, cfg.sliceFace, cfg.mip);
+      EnsureTexCached(cfg.resourceId, cfg.sliceFace, cfg.mip, &cfg);
       if(cfg.resourceId == ResourceId() || m_ProxyTextures[cfg.resourceId] == ResourceId())
         return false;
       cfg.resourceId = m_ProxyTextures[cfg.resourceId];
@@ -303,7 +321,7 @@ public:
   {
     if(m_Proxy)
     {
-      EnsureTexCached(texture, sliceFace, mip);
+      EnsureTexelCached(texture, sliceFace, mip, x, y);
       if(texture == ResourceId() || m_ProxyTextures[texture] == ResourceId())
         return;
 
@@ -331,38 +349,48 @@ public:
     {
       MeshDisplay proxiedCfg = cfg;
 
-      EnsureBufCached(proxiedCfg.position.vertexResourceId);
-      if(proxiedCfg.position.vertexResourceId == ResourceId() ||
-         m_ProxyBufferIds[proxiedCfg.position.vertexResourceId] == ResourceId())
+      vector<MeshFormat> secDraws = secondaryDraws;
+
+      // gather every buffer the mesh view needs, so any that aren't cached yet can be fetched in
+      // one batched round trip rather than one per buffer.
+      {
+        std::vector<ResourceId> buffers;
+
+        buffers.push_back(proxiedCfg.position.vertexResourceId);
+
+        if(proxiedCfg.second.vertexResourceId != ResourceId())
+          buffers.push_back(proxiedCfg.second.vertexResourceId);
+
+        if(proxiedCfg.position.indexResourceId != ResourceId())
+          buffers.push_back(proxiedCfg.position.indexResourceId);
+
+        for(size_t i = 0; i < secDraws.size(); i++)
+        {
+          if(secDraws[i].vertexResourceId != ResourceId())
+            buffers.push_back(secDraws[i].vertexResourceId);
+          if(secDraws[i].indexResourceId != ResourceId())
+            buffers.push_back(secDraws[i].indexResourceId);
+        }
+
+        EnsureBufCached(buffers);
+      }
+
+      if(m_ProxyBufferIds[proxiedCfg.position.vertexResourceId] == ResourceId())
         return;
       proxiedCfg.position.vertexResourceId = m_ProxyBufferIds[proxiedCfg.position.vertexResourceId];
 
       if(proxiedCfg.second.vertexResourceId != ResourceId())
-      {
-        EnsureBufCached(proxiedCfg.second.vertexResourceId);
         proxiedCfg.second.vertexResourceId = m_ProxyBufferIds[proxiedCfg.second.vertexResourceId];
-      }
 
       if(proxiedCfg.position.indexResourceId != ResourceId())
-      {
-        EnsureBufCached(proxiedCfg.position.indexResourceId);
         proxiedCfg.position.indexResourceId = m_ProxyBufferIds[proxiedCfg.position.indexResourceId];
-      }
-
-      vector<MeshFormat> secDraws = secondaryDraws;
 
       for(size_t i = 0; i < secDraws.size(); i++)
       {
         if(secDraws[i].vertexResourceId != ResourceId())
-        {
-          EnsureBufCached(secDraws[i].vertexResourceId);
           secDraws[i].vertexResourceId = m_ProxyBufferIds[secDraws[i].vertexResourceId];
-        }
         if(secDraws[i].indexResourceId != ResourceId())
-        {
-          EnsureBufCached(secDraws[i].indexResourceId);
           secDraws[i].indexResourceId = m_ProxyBufferIds[secDraws[i].indexResourceId];
-        }
       }
 
       m_Proxy->RenderMesh(eventId, secDraws, proxiedCfg);
@@ -376,23 +404,30 @@ public:
     {
       MeshDisplay proxiedCfg = cfg;
 
-      EnsureBufCached(proxiedCfg.position.vertexResourceId);
-      if(proxiedCfg.position.vertexResourceId == ResourceId() ||
-         m_ProxyBufferIds[proxiedCfg.position.vertexResourceId] == ResourceId())
+      // as in RenderMesh, batch-fetch all the buffers we need in one round trip.
+      {
+        std::vector<ResourceId> buffers;
+
+        buffers.push_back(proxiedCfg.position.vertexResourceId);
+
+        if(proxiedCfg.second.vertexResourceId != ResourceId())
+          buffers.push_back(proxiedCfg.second.vertexResourceId);
+
+        if(proxiedCfg.position.indexResourceId != ResourceId())
+          buffers.push_back(proxiedCfg.position.indexResourceId);
+
+        EnsureBufCached(buffers);
+      }
+
+      if(m_ProxyBufferIds[proxiedCfg.position.vertexResourceId] == ResourceId())
         return ~0U;
       proxiedCfg.position.vertexResourceId = m_ProxyBufferIds[proxiedCfg.position.vertexResourceId];
 
       if(proxiedCfg.second.vertexResourceId != ResourceId())
-      {
-        EnsureBufCached(proxiedCfg.second.vertexResourceId);
         proxiedCfg.second.vertexResourceId = m_ProxyBufferIds[proxiedCfg.second.vertexResourceId];
-      }
 
       if(proxiedCfg.position.indexResourceId != ResourceId())
-      {
-        EnsureBufCached(proxiedCfg.position.indexResourceId);
         proxiedCfg.position.indexResourceId = m_ProxyBufferIds[proxiedCfg.position.indexResourceId];
-      }
 
       return m_Proxy->PickVertex(eventId, width, height, proxiedCfg, x, y);
     }
@@ -450,6 +485,11 @@ public:
   const SDFile &GetStructuredFile() { return m_StructuredFile; }
   IMPLEMENT_FUNCTION_PROXIED(void, FetchStructuredFile);
 
+  // fetches the full SDObject trees for the given chunk indices, along with any structured buffers
+  // they reference that haven't been transferred yet. Only used when FetchStructuredFile decided
+  // to synchronise lazily and sent the chunk table as metadata-only stubs.
+  IMPLEMENT_FUNCTION_PROXIED(void, FetchStructuredChunks, const std::vector<uint32_t> &chunks);
+
   IMPLEMENT_FUNCTION_PROXIED(const std::vector<ResourceDescription> &, GetResources);
 
   IMPLEMENT_FUNCTION_PROXIED(std::vector<ResourceId>, GetBuffers);
@@ -529,14 +569,35 @@ public:
   // these functions are not part of the replay driver interface - they are similar to GetBufferData
   // and GetTextureData, but they do extra work to try and optimise transfer by delta-encoding the
   // difference in the returned data to the last time the resource was cached
-  IMPLEMENT_FUNCTION_PROXIED(void, CacheBufferData, ResourceId buff);
-  IMPLEMENT_FUNCTION_PROXIED(void, CacheTextureData, ResourceId tex, uint32_t arrayIdx,
+  // the return value indicates whether the contents actually changed since the last time the
+  // resource was cached - if not, the proxy resource already contains the up to date data and the
+  // caller can skip re-uploading it.
+  IMPLEMENT_FUNCTION_PROXIED(bool, CacheBufferData, ResourceId buff);
+  IMPLEMENT_FUNCTION_PROXIED(bool, CacheTextureData, ResourceId tex, uint32_t arrayIdx,
                              uint32_t mip, const GetTextureDataParams &params);
 
+  // batched variants of the above. Each proxied call is a full network round trip, so operations
+  // that need several resources at once (e.g. all the buffers for a mesh view, or every sample of
+  // an MSAA texture) pay a latency per resource - these fetch a whole list in a single
+  // request/reply exchange. Since the connection is a single ordered stream the replies come back
+  // in request order, so no extra matching is needed.
+  // changed is filled with one entry per resource, analogous to the singular functions' return
+  // value. It is an output parameter only and isn't serialised.
+  IMPLEMENT_FUNCTION_PROXIED(void, CacheBufferDataBatch, const std::vector<ResourceId> &buffs,
+                             std::vector<bool> &changed);
+  IMPLEMENT_FUNCTION_PROXIED(void, CacheTextureDataBatch, ResourceId tex,
+                             const std::vector<uint32_t> &arrayIdxs, uint32_t mip,
+                             const GetTextureDataParams &params, std::vector<bool> &changed);
+
   // utility function to serialise the contents of a byte array given the previous contents that's
-  // available on both sides of the communication.
+  // available on both sides of the communication. referenceHash caches an XXH64 hash of the last
+  // transferred contents on the sending side, so unchanged resources are detected with a single
+  // pass over the new data instead of a chunk-by-chunk comparison against the reference copy.
+  // Returns whether the contents changed - on the sending side because some delta was non-empty,
+  // on the receiving side because a non-empty delta list arrived.
   template <typename SerialiserType>
-  void DeltaTransferBytes(SerialiserType &xferser, bytebuf &referenceData, bytebuf &newData);
+  bool DeltaTransferBytes(SerialiserType &xferser, bytebuf &referenceData, uint64_t &referenceHash,
+                          bytebuf &newData);
 
   void FileChanged() {}
   // will never be used
@@ -565,9 +626,12 @@ public:
   }
 
 private:
-  void EnsureTexCached(ResourceId texid, uint32_t arrayIdx, uint32_t mip);
+  void EnsureTexCached(ResourceId texid, uint32_t arrayIdx, uint32_t mip,
+                       const TextureDisplay *display = NULL);
+  void EnsureTexelCached(ResourceId texid, uint32_t arrayIdx, uint32_t mip, uint32_t x, uint32_t y);
   void RemapProxyTextureIfNeeded(TextureDescription &tex, GetTextureDataParams &params);
   void EnsureBufCached(ResourceId bufid);
+  void EnsureBufCached(const std::vector<ResourceId> &bufids);
   IMPLEMENT_FUNCTION_PROXIED(bool, NeedRemapForFetch, const ResourceFormat &format);
 
   const DrawcallDescription *FindDraw(const rdcarray<DrawcallDescription> &drawcallList,
@@ -619,6 +683,83 @@ private:
   std::map<TextureCacheEntry, bytebuf> m_ProxyTextureData;
   std::map<ResourceId, bytebuf> m_ProxyBufferData;
 
+  // a texel rect within one mip, used for streaming huge textures in visible tiles.
+  struct TexelRect
+  {
+    uint32_t x;
+    uint32_t y;
+    uint32_t width;
+    uint32_t height;
+
+    bool Contains(const TexelRect &o) const
+    {
+      return o.x >= x && o.y >= y && o.x + o.width <= x + width && o.y + o.height <= y + height;
+    }
+  };
+
+  // subresources in m_TextureProxyCache that only contain full-resolution data inside the rects
+  // fetched so far, with an upscaled low-res base everywhere else. Client side only.
+  std::map<TextureCacheEntry, std::vector<TexelRect>> m_PartialTextureRects;
+  // the composed client-side copy (low-res base plus any fetched rects) that gets uploaded to the
+  // proxy texture. Kept separate from m_ProxyTextureData so that the delta transfer reference
+  // data is never polluted with partial contents.
+  std::map<TextureCacheEntry, bytebuf> m_PartialTextureData;
+
+  bool GetPartialFetchRect(const TextureCacheEntry &entry, const TextureDisplay &display,
+                           TexelRect &rect);
+  void FetchPartialTexture(const TextureCacheEntry &entry, const TexelRect &rect);
+  void CropPartialTextureData(ResourceId tex, uint32_t mip, const GetTextureDataParams &params,
+                              bytebuf &data);
+
+  // subresources whose proxy texture currently holds a lossy downsampled preview rather than the
+  // real contents, with the downsample factor it was fetched at. Client side only.
+  std::map<TextureCacheEntry, uint32_t> m_PreviewTextures;
+
+  uint32_t GetPreviewDownsampleFactor(const TextureCacheEntry &entry,
+                                      const TextureDisplay &display);
+  void FetchPreviewTexture(const TextureCacheEntry &entry, uint32_t factor);
+  void DownsampleTextureData(ResourceId tex, uint32_t mip, const GetTextureDataParams &params,
+                             bytebuf &data);
+
+  // content hashes of the reference data above, maintained on the remote side only where the
+  // deltas are calculated. See DeltaTransferBytes.
+  std::map<TextureCacheEntry, uint64_t> m_ProxyTextureHashes;
+  std::map<ResourceId, uint64_t> m_ProxyBufferHashes;
+
+  // fetches the structured chunks for the events in a window around the given event, so stepping
+  // through the event browser doesn't pay a round trip per inspected event. Client side only, and
+  // a no-op unless the structured file was synchronised lazily.
+  void FetchStructuredChunksForEvent(uint32_t eventId);
+
+  // indices of structured buffers that have been transferred to the client, maintained on the
+  // remote side only so that chunk fetches don't re-send buffers shared between chunks.
+  std::set<uint64_t> m_TransferredBuffers;
+
+  // serialised snapshot of the pipeline state from the last SavePipelineState transfer. Like the
+  // resource caches above this exists on both sides of the connection and must be kept in sync -
+  // the remote side diffs each new state against it so that stepping between events only sends
+  // the bytes that changed, and the client side reconstructs the new snapshot from the deltas
+  // before deserialising it. The hash is only maintained on the remote side.
+  bytebuf m_PipelineSnapshot;
+  uint64_t m_PipelineSnapshotHash = 0;
+
+  // speculative readback cache, only used on the remote server. After replying to a ReplayLog the
+  // connection sits idle while the client refreshes its UI, and the most common next requests are
+  // fetches of the render targets bound at the new event - so we read those back ahead of time
+  // and serve the texture fetches from this cache. Entries are consumed on use, and the next
+  // ReplayLog throws away whatever wasn't used - which also acts as cancellation when the client
+  // seeks somewhere we didn't predict.
+  struct PrefetchedTexture
+  {
+    GetTextureDataParams params;
+    bytebuf data;
+  };
+  std::map<TextureCacheEntry, PrefetchedTexture> m_PrefetchedTextures;
+
+  void PrefetchRenderTargets(uint32_t eventId);
+  bool GetPrefetchedTextureData(ResourceId tex, uint32_t arrayIdx, uint32_t mip,
+                                const GetTextureDataParams &params, bytebuf &data);
+
   // this lists any textures which are only created locally (e.g. custom visualisation shaders) and
   // should not be treated as proxied.
   std::set<ResourceId> m_LocalTextures;
@@ -663,6 +804,9 @@ private:
   // true if we're the remote server, false if we're the host
   bool m_RemoteServer;
 
+  // true if this proxy serves a read-only client attached to a shared replay - see SetReadOnly()
+  bool m_ReadOnly = false;
+
   // The callback (if provided) that handles creating and ticking a preview window on the remote
   // host.
   RENDERDOC_PreviewWindowCallback m_PreviewWindow;
@@ -673,6 +817,11 @@ private:
   WindowingData m_PreviewWindowingData = {WindowingSystem::Unknown};
 
   uint32_t m_EventID = 0;
+  // the type of the last ReplayLog executed, stored with m_EventID so ResyncReplay() can restore
+  // this client's exact replay position on a shared replay.
+  ReplayLogType m_ReplayLogType = eReplay_Full;
+  bool m_HasReplayed = false;
+  bool m_ResyncReplay = false;
 
   enum RemoteExecutionState
   {
@@ -28,8 +28,11 @@
 #include <map>
 #include <set>
 #include "api/replay/renderdoc_replay.h"
+#include "common/profiler.h"
 #include "common/threading.h"
 #include "core/core.h"
+#include "core/intervals.h"
+#include "lz4/lz4.h"
 #include "os/os_specific.h"
 #include "serialise/serialiser.h"
 
@@ -433,6 +436,195 @@ bool ResourceRecord::MarkResourceFrameReferenced(ResourceId id, FrameRefType ref
   return MarkReferenced(m_FrameRefs, id, refType, comp);
 }
 
+// a map sharded over several independently spin-locked buckets. The resource manager's lookup
+// tables are hit on nearly every wrapped API call from every application thread, and lookups
+// outnumber insertions by orders of magnitude in steady state - with sharding two threads only
+// contend when their keys land in the same shard, instead of serialising every lookup through the
+// manager's single critical section.
+//
+// Keys must be hashable by reading their object representation, so they must not contain padding
+// bytes (IDs, handles and pointers are all fine).
+template <typename Key, typename Value>
+class ShardedMap
+{
+public:
+  // fetches the value for key into value, returning false (and leaving value untouched) if the
+  // key isn't present.
+  bool Lookup(const Key &key, Value &value)
+  {
+    Shard &shard = ShardFor(key);
+    Threading::ScopedSpinLock scope(shard.lock);
+    auto it = shard.map.find(key);
+    if(it == shard.map.end())
+      return false;
+    value = it->second;
+    return true;
+  }
+
+  bool Has(const Key &key)
+  {
+    Shard &shard = ShardFor(key);
+    Threading::ScopedSpinLock scope(shard.lock);
+    return shard.map.find(key) != shard.map.end();
+  }
+
+  // stores key = value, returning false if a value was already present (it is overwritten).
+  bool Set(const Key &key, const Value &value)
+  {
+    Shard &shard = ShardFor(key);
+    Threading::ScopedSpinLock scope(shard.lock);
+    auto result = shard.map.insert(std::make_pair(key, value));
+    if(!result.second)
+      result.first->second = value;
+    return result.second;
+  }
+
+  // removes key, returning false if it wasn't present.
+  bool Erase(const Key &key)
+  {
+    Shard &shard = ShardFor(key);
+    Threading::ScopedSpinLock scope(shard.lock);
+    return shard.map.erase(key) != 0;
+  }
+
+  // iterates over every element, holding one shard's lock at a time. The callback must not
+  // re-enter the map. If the callback takes the resource manager's lock, the caller must already
+  // hold it around the iteration to keep a consistent lock order.
+  template <typename Callback>
+  void ForEach(Callback callback)
+  {
+    for(size_t s = 0; s < ShardCount; s++)
+    {
+      Threading::ScopedSpinLock scope(m_Shards[s].lock);
+      for(auto it = m_Shards[s].map.begin(); it != m_Shards[s].map.end(); ++it)
+        callback(it->first, it->second);
+    }
+  }
+
+  size_t size()
+  {
+    size_t ret = 0;
+    for(size_t s = 0; s < ShardCount; s++)
+    {
+      Threading::ScopedSpinLock scope(m_Shards[s].lock);
+      ret += m_Shards[s].map.size();
+    }
+    return ret;
+  }
+
+  bool empty() { return size() == 0; }
+  void clear()
+  {
+    for(size_t s = 0; s < ShardCount; s++)
+    {
+      Threading::ScopedSpinLock scope(m_Shards[s].lock);
+      m_Shards[s].map.clear();
+    }
+  }
+
+private:
+  static const size_t ShardCount = 16;
+
+  struct Shard
+  {
+    Threading::SpinLock lock;
+    std::map<Key, Value> map;
+  };
+
+  Shard m_Shards[ShardCount];
+
+  Shard &ShardFor(const Key &key)
+  {
+    // read the key's bytes as integers and mix, so that sequential IDs or aligned pointers still
+    // spread over the shards.
+    uint64_t x = 0;
+    const byte *bytes = (const byte *)&key;
+    for(size_t i = 0; i < sizeof(Key); i += sizeof(uint64_t))
+    {
+      uint64_t chunk = 0;
+      memcpy(&chunk, bytes + i, RDCMIN(sizeof(uint64_t), sizeof(Key) - i));
+      x = (x ^ chunk) * 0xff51afd7ed558ccdULL;
+    }
+    x ^= x >> 33;
+    return m_Shards[x % ShardCount];
+  }
+};
+
+// maps ResourceId to ResourceId for the replay-side original <-> live translation.
+// GetLiveID()/GetOriginalID() run inside nearly every replayed chunk's handling, so a std::map
+// walk per lookup is measurable when loading large captures. Both sides of the mapping come from
+// a global counter (original IDs allocated by the captured application, live IDs by the replay
+// process), so the keys are near-dense - lookups index a flat table by the key's offset from the
+// first key inserted, with a map fallback for outliers or keys past the table's size cap.
+class DenseIdMap
+{
+public:
+  // fetches the value for key into value, returning false (and leaving value untouched) if the
+  // key isn't present.
+  bool Lookup(ResourceId key, ResourceId &value) const
+  {
+    uint64_t raw = RawId(key);
+
+    if(raw >= m_Base && raw - m_Base < m_Flat.size())
+    {
+      ResourceId ret = m_Flat[size_t(raw - m_Base)];
+      // the table's holes are null IDs - values set are never null, so null means not present
+      if(ret == ResourceId())
+        return false;
+      value = ret;
+      return true;
+    }
+
+    auto it = m_Outliers.find(key);
+    if(it == m_Outliers.end())
+      return false;
+    value = it->second;
+    return true;
+  }
+
+  // stores key = value, overwriting any previous value.
+  void Set(ResourceId key, ResourceId value)
+  {
+    uint64_t raw = RawId(key);
+
+    if(m_Flat.empty() && m_Outliers.empty())
+    {
+      // seed the base from the first key. IDs are handed out in increasing order and inserted
+      // in roughly allocation order, so later keys nearly always land at small offsets above it.
+      m_Base = raw;
+    }
+    else if(raw < m_Base || raw - m_Base >= MaxTableSize)
+    {
+      m_Outliers[key] = value;
+      return;
+    }
+
+    uint64_t idx = raw - m_Base;
+    if(idx >= m_Flat.size())
+      m_Flat.resize(size_t(idx) + 1);
+    m_Flat[size_t(idx)] = value;
+  }
+
+private:
+  // bounds the flat table at 32MB per direction in case a key lands far above the base - anything
+  // past this goes to the outlier map.
+  static const uint64_t MaxTableSize = 4 * 1024 * 1024;
+
+  static uint64_t RawId(ResourceId id)
+  {
+    // ResourceId is a struct around a single private uint64_t. We only need a stable integer to
+    // offset into the table, so read the object representation directly as ShardedMap does.
+    uint64_t raw = 0;
+    RDCCOMPILE_ASSERT(sizeof(ResourceId) == sizeof(uint64_t), "ResourceId is not a uint64_t");
+    memcpy(&raw, &id, sizeof(raw));
+    return raw;
+  }
+
+  uint64_t m_Base = 0;
+  std::vector<ResourceId> m_Flat;
+  std::map<ResourceId, ResourceId> m_Outliers;
+};
+
 // the resource manager is a utility class that's not required but is likely wanted by any API
 // implementation.
 // It keeps track of resource records, which resources are alive and allows you to query for them by
@@ -489,6 +681,23 @@ public:
   // of the frame.
   inline void MarkDirtyResource(ResourceId res);
 
+  // as MarkDirtyResource, but indicates that only the given [start, end) byte range is suspect.
+  // Ranges accumulate across calls. Marking the whole resource dirty discards the range
+  // information - the entire contents stay suspect from then on.
+  inline void MarkDirtyResourceRange(ResourceId res, uint64_t start, uint64_t end);
+
+  // returns the accumulated dirty byte ranges for a resource that has only ever been marked
+  // dirty via MarkDirtyResourceRange(), as intervals with value true. Returns NULL if the
+  // resource is clean or wholly dirty, in which case the full contents must be snapshotted.
+  // The returned pointer is invalidated by any further dirty marking, so this should only be
+  // called from the Prepare_InitialState callbacks.
+  const Intervals<bool> *GetDirtyRanges(ResourceId res);
+
+  // discards the accumulated dirty ranges for a resource, once Prepare_InitialState has taken a
+  // snapshot incorporating them. The resource stays range-tracked, so ranges marked afterwards
+  // describe what changed relative to that snapshot.
+  void ClearDirtyRanges(ResourceId res);
+
   // returns if the resource has been marked as dirty
   bool IsResourceDirty(ResourceId res);
 
@@ -512,7 +721,12 @@ public:
   void Serialise_InitialContentsNeeded(WriteSerialiser &ser);
 
   // mark resource referenced somewhere in the main frame-affecting calls.
-  // That means this resource should be included in the final serialise out
+  // That means this resource should be included in the final serialise out.
+  //
+  // The common overload below queues the mark into a per-thread-sharded log and returns - the
+  // logs are merged under m_Lock the next time the frame reference data is read, so many threads
+  // marking references (e.g. per bind during a multithreaded capture) don't serialise on the
+  // manager's lock. The Compose overload applies immediately.
   template <typename Compose>
   void MarkResourceFrameReferenced(ResourceId id, FrameRefType refType, Compose comp);
 
@@ -539,8 +753,17 @@ public:
   // Serialise in which resources need initial contents and set them up.
   void CreateInitialContents(ReadSerialiser &ser);
 
-  // Free any initial contents that are prepared (for after capture is complete)
-  void FreeInitialContents();
+  // Serialise in a reference to another resource's initial contents, and share its in-memory
+  // copy. Written instead of a full InitialContents chunk when the contents are byte-identical
+  // to one serialised earlier in the capture.
+  void CreateInitialContentsReference(ReadSerialiser &ser);
+
+  // Free any initial contents that are prepared (for after capture is complete). When further
+  // frames of a multi-frame capture burst are queued and the backend opts in via
+  // RetainPreparedContentsAcrossBurst(), contents for resources the captured frame didn't write
+  // are retained so the next PrepareInitialContents() only re-snapshots what changed. Pass
+  // allowBurstRetention = false to force a full free regardless (e.g. at shutdown).
+  void FreeInitialContents(bool allowBurstRetention = true);
 
   // Apply the initial contents for the resources that need them, used at the start of a frame
   void ApplyInitialContents();
@@ -563,13 +786,37 @@ protected:
     return true;
   }
   virtual bool Prepare_InitialState(WrappedResourceType res) = 0;
+  // called around the loop of Prepare_InitialState() calls at capture start. Backends can use
+  // these to batch GPU copies across resources into a few submissions, or to fan CPU-side
+  // preparation out to the shared task pool, instead of each resource synchronising alone. All
+  // initial contents must be set by the time End_PrepareInitialBatch() returns.
+  virtual void Begin_PrepareInitialBatch() {}
+  virtual void End_PrepareInitialBatch() {}
   virtual uint64_t GetSize_InitialState(ResourceId id, const InitialContentData &initial) = 0;
+  // optionally return a hash of the initial contents for a resource, used to deduplicate
+  // byte-identical initial states when writing the capture file. The hash must only match when
+  // Serialise_InitialState() would produce interchangeable contents. Return 0 (the default) to
+  // disable deduplication for the resource.
+  virtual uint64_t GetContentHash_InitialState(ResourceId id, const InitialContentData &initial)
+  {
+    return 0;
+  }
   virtual bool Serialise_InitialState(WriteSerialiser &ser, ResourceId id, RecordType *record,
                                       const InitialContentData *initialData) = 0;
+  // whether prepared initial contents stay valid after a capture completes, so they can be
+  // retained across the frames of a multi-frame capture burst and resources that weren't written
+  // in between don't need re-snapshotting. Backends whose prepared contents live in memory that
+  // is freed wholesale at the end of a capture must leave this returning false.
+  virtual bool RetainPreparedContentsAcrossBurst() { return false; }
   virtual void Create_InitialState(ResourceId id, WrappedResourceType live, bool hasData) = 0;
   virtual void Apply_InitialState(WrappedResourceType live, const InitialContentData &initial) = 0;
   virtual std::vector<ResourceId> InitialContentResources();
 
+  // merges marks queued by MarkResourceFrameReferenced() and MarkDirtyResource() into
+  // m_FrameReferencedResources and m_DirtyResources. Must be called with m_Lock held, before
+  // reading either container.
+  void FlushPendingMarks();
+
   // very coarse lock, protects EVERYTHING. This could certainly be improved and it may be a
   // bottleneck
   // for performance. Given that the main use cases are write-rarely read-often the lock should be
@@ -584,8 +831,8 @@ protected:
   // likely prove that some or all of these could be a problem
 
   // used during capture - map from real resource to its wrapper (other way can be done just with an
-  // Unwrap)
-  std::map<RealResourceType, WrappedResourceType> m_WrapperMap;
+  // Unwrap). Sharded as it's looked up on wrapped API call hot paths.
+  ShardedMap<RealResourceType, WrappedResourceType> m_WrapperMap;
 
   // used during capture - holds resources referenced in current frame (and how they're referenced)
   std::map<ResourceId, FrameRefType> m_FrameReferencedResources;
@@ -593,9 +840,69 @@ protected:
   // used during capture - holds resources marked as dirty, needing initial contents
   set<ResourceId> m_DirtyResources;
 
+  // used during capture - for resources in m_DirtyResources that have only been marked dirty
+  // with byte ranges, the intervals (with value true) that are suspect. A dirty resource with no
+  // entry here is wholly dirty.
+  std::map<ResourceId, Intervals<bool>> m_DirtyResourceRanges;
+
+  // used during capture when the backend retains prepared contents across a multi-frame burst -
+  // resources written (dirtied or write-referenced) since the last PrepareInitialContents(), and
+  // resources whose prepared contents were retained by the previous frame's FreeInitialContents()
+  set<ResourceId> m_WrittenSincePrepare;
+  set<ResourceId> m_RetainedContents;
+
+  // marks queued from API threads, merged by FlushPendingMarks() when the containers above are
+  // next read. Sharded by thread ID so the per-call hot path is an append under an uncontended
+  // spin lock instead of serialising every marking thread on m_Lock.
+  struct PendingFrameRef
+  {
+    ResourceId id;
+    FrameRefType refType;
+    // whether the marking thread took a reference on the resource record - see
+    // MarkResourceFrameReferenced
+    bool hasRecordRef;
+  };
+
+  struct PendingMarkShard
+  {
+    Threading::SpinLock lock;
+    // set under the lock whenever the vectors are non-empty, read unlocked as a fast out in
+    // FlushPendingMarks
+    volatile int32_t pending = 0;
+    std::vector<PendingFrameRef> frameRefs;
+    std::vector<ResourceId> dirty;
+  };
+
+  static const size_t PendingMarkShardCount = 16;
+
+  PendingMarkShard m_PendingMarks[PendingMarkShardCount];
+
+  PendingMarkShard &PendingShardForThread()
+  {
+    // mix the thread ID so threads spread over the shards. Appends from one thread always land in
+    // the same shard, preserving that thread's marking order through the merge.
+    uint64_t x = Threading::GetCurrentID();
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    return m_PendingMarks[x % PendingMarkShardCount];
+  }
+
   struct InitialContentDataOrChunk
   {
     Chunk *chunk = NULL;
+
+    // during capture the serialised chunk payload is LZ4-compressed in the background once it's
+    // been prepared, since it can sit in memory for the whole frame before it's written out.
+    // When this is set the chunk has been deleted and the payload is decompressed at write time.
+    byte *compressed = NULL;
+    uint32_t compressedSize = 0;
+    uint32_t uncompressedSize = 0;
+
+    // bumped whenever the chunk is freed or replaced, so an in-flight background compress of a
+    // stale chunk knows to throw its result away
+    uint32_t generation = 0;
+
     InitialContentData data;
 
     void Free(ResourceManager *mgr)
@@ -606,6 +913,14 @@ protected:
         chunk = NULL;
       }
 
+      if(compressed)
+      {
+        FreeAlignedBuffer(compressed);
+        compressed = NULL;
+      }
+
+      generation++;
+
       data.Free(mgr);
     }
   };
@@ -613,18 +928,31 @@ protected:
   // used during capture or replay - holds initial contents
   std::map<ResourceId, InitialContentDataOrChunk> m_InitialContents;
 
+  // tracks the background compression of prepared initial content chunks
+  Threading::TaskGroup m_InitialChunkCompressTasks;
+
+  // used during capture - maps {content hash, serialised size} of initial contents already
+  // written to the resource that owns them, so identical contents serialise as a reference
+  std::map<std::pair<uint64_t, uint64_t>, ResourceId> m_InitialContentHashes;
+
+  // used during replay - resources whose initial contents alias another entry in
+  // m_InitialContents. These must not be freed, the owning resource will free the data.
+  set<ResourceId> m_SharedInitialContents;
+
   // used during capture or replay - map of resources currently alive with their real IDs, used in
-  // capture and replay.
-  std::map<ResourceId, WrappedResourceType> m_CurrentResourceMap;
+  // capture and replay. Sharded as it's looked up on wrapped API call hot paths.
+  ShardedMap<ResourceId, WrappedResourceType> m_CurrentResourceMap;
 
-  // used during replay - maps back and forth from original id to live id and vice-versa
-  std::map<ResourceId, ResourceId> m_OriginalIDs, m_LiveIDs;
+  // used during replay - maps back and forth from original id to live id and vice-versa. These
+  // are hit by every replayed chunk so they use the flat dense-index tables above.
+  DenseIdMap m_OriginalIDs, m_LiveIDs;
 
   // used during replay - holds resources allocated and the original id that they represent
   std::map<ResourceId, WrappedResourceType> m_LiveResourceMap;
 
-  // used during capture - holds resource records by id.
-  std::map<ResourceId, RecordType *> m_ResourceRecords;
+  // used during capture - holds resource records by id. Sharded as it's looked up on wrapped API
+  // call hot paths.
+  ShardedMap<ResourceId, RecordType *> m_ResourceRecords;
 
   // used during replay - holds current resource replacements
   std::map<ResourceId, ResourceId> m_Replacements;
@@ -640,7 +968,8 @@ ResourceManager<Configuration>::ResourceManager()
 template <typename Configuration>
 void ResourceManager<Configuration>::Shutdown()
 {
-  FreeInitialContents();
+  // no more frames are coming, free everything even if a capture burst was in progress
+  FreeInitialContents(false);
 
   while(!m_LiveResourceMap.empty())
   {
@@ -672,11 +1001,16 @@ template <typename Compose>
 void ResourceManager<Configuration>::MarkResourceFrameReferenced(ResourceId id,
                                                                  FrameRefType refType, Compose comp)
 {
+  PROFILE_CAPTURE_SCOPE(RefMarking);
+
   SCOPED_LOCK(m_Lock);
 
   if(id == ResourceId())
     return;
 
+  // merge any queued marks first, so references this thread queued earlier compose in order
+  FlushPendingMarks();
+
   bool newRef = MarkReferenced(m_FrameReferencedResources, id, refType, comp);
 
   if(newRef)
@@ -691,18 +1025,146 @@ void ResourceManager<Configuration>::MarkResourceFrameReferenced(ResourceId id,
 template <typename Configuration>
 void ResourceManager<Configuration>::MarkResourceFrameReferenced(ResourceId id, FrameRefType refType)
 {
-  return MarkResourceFrameReferenced(id, refType, ComposeFrameRefs);
+  PROFILE_CAPTURE_SCOPE(RefMarking);
+
+  if(id == ResourceId())
+    return;
+
+  // take a reference on the record up-front rather than at merge time, so the record (and its
+  // chunks) can't be destroyed before the merge if the application releases the resource
+  // mid-capture. FlushPendingMarks() drops the extra reference if this turns out not to be the
+  // first reference this frame.
+  RecordType *record = GetResourceRecord(id);
+
+  if(record)
+    record->AddRef();
+
+  PendingMarkShard &shard = PendingShardForThread();
+
+  Threading::ScopedSpinLock scope(shard.lock);
+  shard.frameRefs.push_back({id, refType, record != NULL});
+  shard.pending = 1;
+}
+
+template <typename Configuration>
+void ResourceManager<Configuration>::FlushPendingMarks()
+{
+  const bool trackWrites = RetainPreparedContentsAcrossBurst();
+
+  for(size_t s = 0; s < PendingMarkShardCount; s++)
+  {
+    PendingMarkShard &shard = m_PendingMarks[s];
+
+    // unlocked read as a fast out - a mark that lands after this check is treated as happening
+    // after whatever operation prompted the flush, the same ordering the per-call lock gave.
+    if(!shard.pending)
+      continue;
+
+    std::vector<PendingFrameRef> frameRefs;
+    std::vector<ResourceId> dirty;
+
+    {
+      Threading::ScopedSpinLock scope(shard.lock);
+      frameRefs.swap(shard.frameRefs);
+      dirty.swap(shard.dirty);
+      shard.pending = 0;
+    }
+
+    for(const PendingFrameRef &ref : frameRefs)
+    {
+      bool newRef = MarkReferenced(m_FrameReferencedResources, ref.id, ref.refType);
+
+      if(trackWrites && IsDirtyFrameRef(ref.refType))
+        m_WrittenSincePrepare.insert(ref.id);
+
+      // the marking thread took a reference to keep the record alive until this merge. If this
+      // isn't the first reference this frame the map already accounts for one, so drop the extra.
+      if(!newRef && ref.hasRecordRef)
+      {
+        RecordType *record = GetResourceRecord(ref.id);
+
+        if(record)
+          record->Delete(this);
+      }
+    }
+
+    for(ResourceId id : dirty)
+    {
+      m_DirtyResources.insert(id);
+
+      if(trackWrites)
+        m_WrittenSincePrepare.insert(id);
+
+      // whole-resource dirty supersedes any accumulated range information
+      m_DirtyResourceRanges.erase(id);
+    }
+  }
 }
 
 template <typename Configuration>
 void ResourceManager<Configuration>::MarkDirtyResource(ResourceId res)
+{
+  if(res == ResourceId())
+    return;
+
+  // as with frame references, queue the mark and merge it when the dirty state is next read
+  PendingMarkShard &shard = PendingShardForThread();
+
+  Threading::ScopedSpinLock scope(shard.lock);
+  shard.dirty.push_back(res);
+  shard.pending = 1;
+}
+
+template <typename Configuration>
+void ResourceManager<Configuration>::MarkDirtyResourceRange(ResourceId res, uint64_t start,
+                                                            uint64_t end)
 {
   SCOPED_LOCK(m_Lock);
 
-  if(res == ResourceId())
+  if(res == ResourceId() || end <= start)
+    return;
+
+  // a queued whole-resource mark must land before the check below, so it supersedes this range
+  FlushPendingMarks();
+
+  // if the resource is already wholly dirty, that subsumes any range
+  if(m_DirtyResources.find(res) != m_DirtyResources.end() &&
+     m_DirtyResourceRanges.find(res) == m_DirtyResourceRanges.end())
     return;
 
   m_DirtyResources.insert(res);
+  m_DirtyResourceRanges[res].update(start, end, true, [](bool a, bool b) { return a || b; });
+
+  if(RetainPreparedContentsAcrossBurst())
+    m_WrittenSincePrepare.insert(res);
+}
+
+template <typename Configuration>
+const Intervals<bool> *ResourceManager<Configuration>::GetDirtyRanges(ResourceId res)
+{
+  SCOPED_LOCK(m_Lock);
+
+  FlushPendingMarks();
+
+  auto it = m_DirtyResourceRanges.find(res);
+
+  if(it == m_DirtyResourceRanges.end())
+    return NULL;
+
+  return &it->second;
+}
+
+template <typename Configuration>
+void ResourceManager<Configuration>::ClearDirtyRanges(ResourceId res)
+{
+  SCOPED_LOCK(m_Lock);
+
+  FlushPendingMarks();
+
+  auto it = m_DirtyResourceRanges.find(res);
+
+  if(it != m_DirtyResourceRanges.end())
+    it->second = Intervals<bool>();
 }
 
 template <typename Configuration>
@@ -713,6 +1175,8 @@ bool ResourceManager<Configuration>::IsResourceDirty(ResourceId res)
   if(res == ResourceId())
     return false;
 
+  FlushPendingMarks();
+
   return m_DirtyResources.find(res) != m_DirtyResources.end();
 }
 
@@ -744,7 +1208,61 @@ void ResourceManager<Configuration>::SetInitialChunk(ResourceId id, Chunk *chunk
   if(data.chunk)
     delete data.chunk;
 
+  if(data.compressed)
+  {
+    FreeAlignedBuffer(data.compressed);
+    data.compressed = NULL;
+  }
+
+  data.generation++;
   data.chunk = chunk;
+
+  // compress the payload in the background, trading a little CPU for the memory that would
+  // otherwise stay resident until the capture is serialised. Small chunks aren't worth the
+  // round-trip, and LZ4 can't handle inputs over ~2GB in one shot.
+  if(chunk->GetLength() >= 64 * 1024 && chunk->GetLength() <= (uint32_t)LZ4_MAX_INPUT_SIZE)
+  {
+    // the duplicate keeps the payload alive even if the manager frees or replaces its copy of
+    // the chunk before the task runs
+    Chunk *ownedChunk = chunk->Duplicate();
+    uint32_t generation = data.generation;
+
+    Threading::TaskPool::Instance().Submit(
+        m_InitialChunkCompressTasks, [this, id, generation, ownedChunk]() {
+          uint32_t uncompSize = ownedChunk->GetLength();
+          int bound = LZ4_compressBound((int)uncompSize);
+
+          byte *compressed = AllocAlignedBuffer(bound);
+
+          int compSize = LZ4_compress_default((const char *)ownedChunk->GetData(),
+                                              (char *)compressed, (int)uncompSize, bound);
+
+          {
+            SCOPED_LOCK(m_Lock);
+
+            auto it = m_InitialContents.find(id);
+
+            // only store the result if the chunk we compressed is still current, and compressing
+            // actually saved memory
+            if(compSize > 0 && uint32_t(compSize) < uncompSize &&
+               it != m_InitialContents.end() && it->second.generation == generation &&
+               it->second.chunk)
+            {
+              delete it->second.chunk;
+              it->second.chunk = NULL;
+              it->second.compressed = compressed;
+              it->second.compressedSize = (uint32_t)compSize;
+              it->second.uncompressedSize = uncompSize;
+              compressed = NULL;
+            }
+          }
+
+          if(compressed)
+            FreeAlignedBuffer(compressed);
+
+          delete ownedChunk;
+        });
+  }
 }
 
 template <typename Configuration>
@@ -788,6 +1306,8 @@ void ResourceManager<Configuration>::Serialise_InitialContentsNeeded(WriteSerial
 
   SCOPED_LOCK(m_Lock);
 
+  FlushPendingMarks();
+
   std::vector<WrittenRecord> WrittenRecords;
 
   // reasonable estimate, and these records are small
@@ -826,15 +1346,92 @@ void ResourceManager<Configuration>::Serialise_InitialContentsNeeded(WriteSerial
 }
 
 template <typename Configuration>
-void ResourceManager<Configuration>::FreeInitialContents()
+void ResourceManager<Configuration>::FreeInitialContents(bool allowBurstRetention)
 {
+  // finish any in-flight background compression before the entries it refers to are destroyed
+  Threading::TaskPool::Instance().Wait(m_InitialChunkCompressTasks);
+
+  // when further frames of a multi-frame capture burst are queued, retain prepared contents for
+  // resources the captured frame didn't write - their start-of-frame state is unchanged, so the
+  // next PrepareInitialContents() can re-use them instead of re-snapshotting every dirty
+  // resource.
+  if(allowBurstRetention && RetainPreparedContentsAcrossBurst() &&
+     RenderDoc::Inst().HasQueuedCaptureFrames())
+  {
+    SCOPED_LOCK(m_Lock);
+
+    FlushPendingMarks();
+
+    m_RetainedContents.clear();
+
+    for(auto it = m_InitialContents.begin(); it != m_InitialContents.end(); ++it)
+    {
+      if(m_WrittenSincePrepare.find(it->first) == m_WrittenSincePrepare.end() &&
+         HasCurrentResource(it->first))
+        m_RetainedContents.insert(it->first);
+    }
+
+    // free everything that wasn't retained. As below, Free() can re-enter the manager so don't
+    // assume iterators stay valid across it.
+    while(true)
+    {
+      auto it = m_InitialContents.begin();
+
+      while(it != m_InitialContents.end() &&
+            m_RetainedContents.find(it->first) != m_RetainedContents.end())
+        ++it;
+
+      if(it == m_InitialContents.end())
+        break;
+
+      ResourceId id = it->first;
+
+      if(m_SharedInitialContents.find(id) == m_SharedInitialContents.end())
+        it->second.Free(this);
+
+      it = m_InitialContents.find(id);
+      if(it != m_InitialContents.end())
+        m_InitialContents.erase(it);
+    }
+
+    return;
+  }
+
+  m_RetainedContents.clear();
+
   while(!m_InitialContents.empty())
   {
     auto it = m_InitialContents.begin();
-    it->second.Free(this);
+    if(m_SharedInitialContents.find(it->first) == m_SharedInitialContents.end())
+      it->second.Free(this);
     if(!m_InitialContents.empty())
       m_InitialContents.erase(m_InitialContents.begin());
   }
+  m_SharedInitialContents.clear();
+}
+
+template <typename Configuration>
+void ResourceManager<Configuration>::CreateInitialContentsReference(ReadSerialiser &ser)
+{
+  ResourceId id;
+  ResourceId dupId;
+
+  SERIALISE_ELEMENT(id);
+  SERIALISE_ELEMENT(dupId);
+
+  SCOPED_LOCK(m_Lock);
+
+  auto dup = m_InitialContents.find(dupId);
+
+  // if the referenced contents don't exist there's nothing to share - e.g. during structured
+  // export no initial contents are created at all.
+  if(dup == m_InitialContents.end())
+    return;
+
+  // share the in-memory copy, and remember that this resource doesn't own the data so that it
+  // isn't freed twice.
+  m_InitialContents[id].data = dup->second.data;
+  m_SharedInitialContents.insert(id);
 }
 
 template <typename Configuration>
@@ -863,7 +1460,10 @@ void ResourceManager<Configuration>::CreateInitialContents(ReadSerialiser &ser)
 
     if(neededInitials.find(id) == neededInitials.end())
     {
-      it->second.Free(this);
+      if(m_SharedInitialContents.find(id) == m_SharedInitialContents.end())
+        it->second.Free(this);
+      else
+        m_SharedInitialContents.erase(id);
       ++it;
       m_InitialContents.erase(id);
     }
@@ -908,12 +1508,7 @@ std::vector<ResourceId> ResourceManager<Configuration>::InitialContentResources(
 template <typename Configuration>
 void ResourceManager<Configuration>::MarkUnwrittenResources()
 {
-  SCOPED_LOCK(m_Lock);
-
-  for(auto it = m_ResourceRecords.begin(); it != m_ResourceRecords.end(); ++it)
-  {
-    it->second->MarkDataUnwritten();
-  }
+  m_ResourceRecords.ForEach([](ResourceId id, RecordType *record) { record->MarkDataUnwritten(); });
 }
 
 template <typename Configuration>
@@ -923,6 +1518,8 @@ void ResourceManager<Configuration>::InsertReferencedChunks(WriteSerialiser &ser
 
   SCOPED_LOCK(m_Lock);
 
+  FlushPendingMarks();
+
   RDCDEBUG("%u frame resource records", (uint32_t)m_FrameReferencedResources.size());
 
   if(RenderDoc::Inst().GetCaptureOptions().refAllResources)
@@ -930,17 +1527,16 @@ void ResourceManager<Configuration>::InsertReferencedChunks(WriteSerialiser &ser
     float num = float(m_ResourceRecords.size());
     float idx = 0.0f;
 
-    for(auto it = m_ResourceRecords.begin(); it != m_ResourceRecords.end(); ++it)
-    {
+    m_ResourceRecords.ForEach([this, &sortedChunks, &idx, num](ResourceId id, RecordType *record) {
       RenderDoc::Inst().SetProgress(CaptureProgress::AddReferencedResources, idx / num);
       idx += 1.0f;
 
-      if(m_FrameReferencedResources.find(it->first) == m_FrameReferencedResources.end() &&
-         it->second->InternalResource)
-        continue;
+      if(m_FrameReferencedResources.find(id) == m_FrameReferencedResources.end() &&
+         record->InternalResource)
+        return;
 
-      it->second->Insert(sortedChunks);
-    }
+      record->Insert(sortedChunks);
+    });
   }
   else
   {
@@ -971,12 +1567,26 @@ void ResourceManager<Configuration>::PrepareInitialContents()
 {
   SCOPED_LOCK(m_Lock);
 
+  FlushPendingMarks();
+
+  // contents retained from the previous frame of a multi-frame capture burst are still valid for
+  // any resource that hasn't been written since that frame's PrepareInitialContents(). Snapshot
+  // both sets up-front - writes marked while we're preparing count against the next frame.
+  set<ResourceId> retained;
+  retained.swap(m_RetainedContents);
+
+  set<ResourceId> written;
+  written.swap(m_WrittenSincePrepare);
+
   RDCDEBUG("Preparing up to %u potentially dirty resources", (uint32_t)m_DirtyResources.size());
   uint32_t prepared = 0;
+  uint32_t reused = 0;
 
   float num = float(m_DirtyResources.size());
   float idx = 0.0f;
 
+  Begin_PrepareInitialBatch();
+
   for(auto it = m_DirtyResources.begin(); it != m_DirtyResources.end(); ++it)
   {
     ResourceId id = *it;
@@ -997,6 +1607,17 @@ void ResourceManager<Configuration>::PrepareInitialContents()
     if(record == NULL || record->InternalResource)
       continue;
 
+    if(retained.find(id) != retained.end() && written.find(id) == written.end() &&
+       m_InitialContents.find(id) != m_InitialContents.end())
+    {
+#if ENABLED(VERBOSE_DIRTY_RESOURCES)
+      RDCDEBUG("Resource %llu unchanged since previous burst frame - reusing prepared contents",
+               id);
+#endif
+      reused++;
+      continue;
+    }
+
     prepared++;
 
 #if ENABLED(VERBOSE_DIRTY_RESOURCES)
@@ -1006,7 +1627,9 @@ void ResourceManager<Configuration>::PrepareInitialContents()
     Prepare_InitialState(res);
   }
 
-  RDCDEBUG("Prepared %u dirty resources", prepared);
+  End_PrepareInitialBatch();
+
+  RDCDEBUG("Prepared %u dirty resources, reused %u retained", prepared, reused);
 }
 
 template <typename Configuration>
@@ -1014,9 +1637,13 @@ void ResourceManager<Configuration>::InsertInitialContentsChunks(WriteSerialiser
 {
   SCOPED_LOCK(m_Lock);
 
+  FlushPendingMarks();
+
   uint32_t dirty = 0;
   uint32_t skipped = 0;
 
+  m_InitialContentHashes.clear();
+
   RDCDEBUG("Checking %u resources with initial contents", (uint32_t)m_InitialContents.size());
 
   float num = float(m_InitialContents.size());
@@ -1074,10 +1701,51 @@ void ResourceManager<Configuration>::InsertInitialContentsChunks(WriteSerialiser
     {
       it->second.chunk->Write(ser);
     }
+    else if(it->second.compressed)
+    {
+      // the chunk payload was compressed in the background after it was prepared - decompress
+      // it into a scratch buffer and write it straight through
+      byte *uncomp = AllocAlignedBuffer(it->second.uncompressedSize);
+
+      int size = LZ4_decompress_safe((const char *)it->second.compressed, (char *)uncomp,
+                                     (int)it->second.compressedSize,
+                                     (int)it->second.uncompressedSize);
+
+      if(size == (int)it->second.uncompressedSize)
+        ser.GetWriter()->Write(uncomp, it->second.uncompressedSize);
+      else
+        RDCERR("Corrupt compressed initial contents for %llu: got %d bytes, expected %u", id, size,
+               it->second.uncompressedSize);
+
+      FreeAlignedBuffer(uncomp);
+    }
     else
     {
       uint64_t size = GetSize_InitialState(id, it->second.data);
 
+      // if the contents hash to the same value as a resource we've already serialised, write a
+      // small reference chunk instead of repeating the contents.
+      uint64_t hash = GetContentHash_InitialState(id, it->second.data);
+
+      if(hash != 0)
+      {
+        auto dup = m_InitialContentHashes.find({hash, size});
+
+        if(dup != m_InitialContentHashes.end())
+        {
+          ResourceId dupId = dup->second;
+
+          SCOPED_SERIALISE_CHUNK(SystemChunk::InitialContentsReference, 128);
+
+          SERIALISE_ELEMENT(id);
+          SERIALISE_ELEMENT(dupId);
+
+          continue;
+        }
+
+        m_InitialContentHashes[{hash, size}] = id;
+      }
+
       SCOPED_SERIALISE_CHUNK(SystemChunk::InitialContents, size);
 
       Serialise_InitialState(ser, id, record, &it->second.data);
@@ -1092,6 +1760,8 @@ void ResourceManager<Configuration>::ApplyInitialContentsNonChunks(WriteSerialis
 {
   SCOPED_LOCK(m_Lock);
 
+  FlushPendingMarks();
+
   for(auto it = m_InitialContents.begin(); it != m_InitialContents.end(); ++it)
   {
     ResourceId id = it->first;
@@ -1117,6 +1787,9 @@ void ResourceManager<Configuration>::ClearReferencedResources()
 {
   SCOPED_LOCK(m_Lock);
 
+  // merge queued marks so their record references are dropped below, not leaked
+  FlushPendingMarks();
+
   for(auto it = m_FrameReferencedResources.begin(); it != m_FrameReferencedResources.end(); ++it)
   {
     RecordType *record = GetResourceRecord(it->first);
@@ -1161,47 +1834,33 @@ void ResourceManager<Configuration>::RemoveReplacement(ResourceId id)
 template <typename Configuration>
 typename Configuration::RecordType *ResourceManager<Configuration>::GetResourceRecord(ResourceId id)
 {
-  SCOPED_LOCK(m_Lock);
-
-  auto it = m_ResourceRecords.find(id);
-
-  if(it == m_ResourceRecords.end())
-    return NULL;
-
-  return it->second;
+  RecordType *ret = NULL;
+  m_ResourceRecords.Lookup(id, ret);
+  return ret;
 }
 
 template <typename Configuration>
 bool ResourceManager<Configuration>::HasResourceRecord(ResourceId id)
 {
-  SCOPED_LOCK(m_Lock);
-
-  auto it = m_ResourceRecords.find(id);
-
-  if(it == m_ResourceRecords.end())
-    return false;
-
-  return true;
+  return m_ResourceRecords.Has(id);
 }
 
 template <typename Configuration>
 typename Configuration::RecordType *ResourceManager<Configuration>::AddResourceRecord(ResourceId id)
 {
-  SCOPED_LOCK(m_Lock);
+  RecordType *record = new RecordType(id);
 
-  RDCASSERT(m_ResourceRecords.find(id) == m_ResourceRecords.end(), id);
+  bool inserted = m_ResourceRecords.Set(id, record);
+  RDCASSERT(inserted, id);
 
-  return (m_ResourceRecords[id] = new RecordType(id));
+  return record;
 }
 
 template <typename Configuration>
 void ResourceManager<Configuration>::RemoveResourceRecord(ResourceId id)
 {
-  SCOPED_LOCK(m_Lock);
-
-  RDCASSERT(m_ResourceRecords.find(id) != m_ResourceRecords.end(), id);
-
-  m_ResourceRecords.erase(id);
+  bool present = m_ResourceRecords.Erase(id);
+  RDCASSERT(present, id);
 }
 
 template <typename Configuration>
@@ -1213,8 +1872,6 @@ void ResourceManager<Configuration>::DestroyResourceRecord(ResourceRecord *recor
 template <typename Configuration>
 bool ResourceManager<Configuration>::AddWrapper(WrappedResourceType wrap, RealResourceType real)
 {
-  SCOPED_LOCK(m_Lock);
-
   bool ret = true;
 
   if(wrap == (WrappedResourceType)RecordType::NullResource ||
@@ -1224,60 +1881,51 @@ bool ResourceManager<Configuration>::AddWrapper(WrappedResourceType wrap, RealRe
     ret = false;
   }
 
-  if(m_WrapperMap[real] != (WrappedResourceType)RecordType::NullResource)
+  if(!m_WrapperMap.Set(real, wrap))
   {
     RDCERR("Overriding wrapper for resource");
     ret = false;
   }
 
-  m_WrapperMap[real] = wrap;
-
   return ret;
 }
 
 template <typename Configuration>
 void ResourceManager<Configuration>::RemoveWrapper(RealResourceType real)
 {
-  SCOPED_LOCK(m_Lock);
-
-  if(real == (RealResourceType)RecordType::NullResource || !HasWrapper(real))
+  if(real == (RealResourceType)RecordType::NullResource || !m_WrapperMap.Erase(real))
   {
     RDCERR(
         "Invalid state removing resource wrapper - real resource is NULL or doesn't have wrapper");
-    return;
   }
-
-  m_WrapperMap.erase(m_WrapperMap.find(real));
 }
 
 template <typename Configuration>
 bool ResourceManager<Configuration>::HasWrapper(RealResourceType real)
 {
-  SCOPED_LOCK(m_Lock);
-
   if(real == (RealResourceType)RecordType::NullResource)
     return false;
 
-  return (m_WrapperMap.find(real) != m_WrapperMap.end());
+  return m_WrapperMap.Has(real);
 }
 
 template <typename Configuration>
 typename Configuration::WrappedResourceType ResourceManager<Configuration>::GetWrapper(
     RealResourceType real)
 {
-  SCOPED_LOCK(m_Lock);
+  WrappedResourceType ret = (WrappedResourceType)RecordType::NullResource;
 
   if(real == (RealResourceType)RecordType::NullResource)
-    return (WrappedResourceType)RecordType::NullResource;
+    return ret;
 
-  if(real != (RealResourceType)RecordType::NullResource && !HasWrapper(real))
+  if(!m_WrapperMap.Lookup(real, ret))
   {
     RDCERR(
         "Invalid state removing resource wrapper - real resource isn't NULL and doesn't have "
         "wrapper");
   }
 
-  return m_WrapperMap[real];
+  return ret;
 }
 
 template <typename Configuration>
@@ -1290,8 +1938,8 @@ void ResourceManager<Configuration>::AddLiveResource(ResourceId origid, WrappedR
     RDCERR("Invalid state adding resource mapping - id is invalid or live pointer is NULL");
   }
 
-  m_OriginalIDs[GetID(livePtr)] = origid;
-  m_LiveIDs[origid] = GetID(livePtr);
+  m_OriginalIDs.Set(GetID(livePtr), origid);
+  m_LiveIDs.Set(origid, GetID(livePtr));
 
   if(m_LiveResourceMap.find(origid) != m_LiveResourceMap.end())
   {
@@ -1348,34 +1996,39 @@ void ResourceManager<Configuration>::EraseLiveResource(ResourceId origid)
 template <typename Configuration>
 void ResourceManager<Configuration>::AddCurrentResource(ResourceId id, WrappedResourceType res)
 {
-  SCOPED_LOCK(m_Lock);
-
-  RDCASSERT(m_CurrentResourceMap.find(id) == m_CurrentResourceMap.end(), id);
-  m_CurrentResourceMap[id] = res;
+  bool inserted = m_CurrentResourceMap.Set(id, res);
+  RDCASSERT(inserted, id);
 }
 
 template <typename Configuration>
 bool ResourceManager<Configuration>::HasCurrentResource(ResourceId id)
 {
-  SCOPED_LOCK(m_Lock);
-
-  return m_CurrentResourceMap.find(id) != m_CurrentResourceMap.end();
+  return m_CurrentResourceMap.Has(id);
 }
 
 template <typename Configuration>
 typename Configuration::WrappedResourceType ResourceManager<Configuration>::GetCurrentResource(
     ResourceId id)
 {
-  SCOPED_LOCK(m_Lock);
+  WrappedResourceType ret = (WrappedResourceType)RecordType::NullResource;
 
   if(id == ResourceId())
-    return (WrappedResourceType)RecordType::NullResource;
+    return ret;
+
+  // replacements only exist during replay (e.g. while editing shaders), where lookups aren't
+  // contended - the empty check keeps the capture hot path off the manager's critical section.
+  if(!m_Replacements.empty())
+  {
+    SCOPED_LOCK(m_Lock);
 
-  if(m_Replacements.find(id) != m_Replacements.end())
-    return GetCurrentResource(m_Replacements[id]);
+    auto it = m_Replacements.find(id);
+    if(it != m_Replacements.end())
+      return GetCurrentResource(it->second);
+  }
 
-  RDCASSERT(m_CurrentResourceMap.find(id) != m_CurrentResourceMap.end(), id);
-  return m_CurrentResourceMap[id];
+  bool found = m_CurrentResourceMap.Lookup(id, ret);
+  RDCASSERT(found, id);
+  return ret;
 }
 
 template <typename Configuration>
@@ -1383,9 +2036,14 @@ void ResourceManager<Configuration>::ReleaseCurrentResource(ResourceId id)
 {
   SCOPED_LOCK(m_Lock);
 
-  RDCASSERT(m_CurrentResourceMap.find(id) != m_CurrentResourceMap.end(), id);
-  m_CurrentResourceMap.erase(id);
+  FlushPendingMarks();
+
+  bool present = m_CurrentResourceMap.Erase(id);
+  RDCASSERT(present, id);
   m_DirtyResources.erase(id);
+  m_DirtyResourceRanges.erase(id);
+  m_WrittenSincePrepare.erase(id);
+  m_RetainedContents.erase(id);
 }
 
 template <typename Configuration>
@@ -1394,8 +2052,10 @@ ResourceId ResourceManager<Configuration>::GetOriginalID(ResourceId id)
   if(id == ResourceId())
     return id;
 
-  RDCASSERT(m_OriginalIDs.find(id) != m_OriginalIDs.end(), id);
-  return m_OriginalIDs[id];
+  ResourceId ret;
+  bool present = m_OriginalIDs.Lookup(id, ret);
+  RDCASSERT(present, id);
+  return ret;
 }
 
 template <typename Configuration>
@@ -1404,6 +2064,8 @@ ResourceId ResourceManager<Configuration>::GetLiveID(ResourceId id)
   if(id == ResourceId())
     return id;
 
-  RDCASSERT(m_LiveIDs.find(id) != m_LiveIDs.end(), id);
-  return m_LiveIDs[id];
+  ResourceId ret;
+  bool present = m_LiveIDs.Lookup(id, ret);
+  RDCASSERT(present, id);
+  return ret;
 }
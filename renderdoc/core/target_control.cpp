@@ -52,6 +52,14 @@ static bool IsProtocolVersionSupported(const uint32_t protocolVersion)
   return false;
 }
 
+// Note for anyone looking to layer a live backbuffer preview stream onto this protocol: there is
+// currently no frame source to feed it. The in-app layer never reads the backbuffer back to the
+// CPU outside of an actual capture - the only image data sent here is the one-shot thumbnail in
+// ePacket_NewCapture, pulled from the already-written capture file. A polled preview would need a
+// per-frame GPU readback added to every driver's present path, which on the low-end devices where
+// link bandwidth matters costs more than it saves. If this is ever added it should be
+// event-driven from presents rather than polled, send only changed tiles (compare tile hashes
+// server-side), and bump TargetControlProtocolVersion.
 enum PacketType : uint32_t
 {
   ePacket_Noop = 1,
@@ -2133,9 +2133,11 @@ bool WrappedID3D11DeviceContext::Serialise_SwapDeviceContextState(
   {
     m_DoStateVerify = false;
     {
+      // apply before copying into the tracked state - ApplyState() diffs against the tracked
+      // state to skip redundant binds, so copying first would make it skip everything.
+      state.ApplyState(this);
       m_CurrentPipelineState->CopyState(state);
       m_CurrentPipelineState->SetDevice(m_pDevice);
-      state.ApplyState(this);
     }
     m_DoStateVerify = true;
     VerifyState();
@@ -228,18 +228,82 @@ struct GPUTimer
   uint32_t eventId;
 };
 
+struct GPUTimerResult
+{
+  uint32_t eventId;
+  UINT64 duration;
+  D3D11_QUERY_DATA_PIPELINE_STATISTICS pipelineStats;
+  UINT64 occlusion;
+};
+
+// cap on query sets alive at any time. Queries beyond this are handled by draining the in-flight
+// batch and reusing the pool - D3D11 queries are single-shot but become reusable once their data
+// has been read back. This bounds driver-side query storage without flushing per draw.
+static const size_t MaxQueryBatch = 1024;
+
 struct D3D11CounterContext
 {
   uint32_t eventStart;
-  vector<GPUTimer> timers;
+  vector<GPUTimer> pool;
+  size_t poolUsed;
+  vector<GPUTimerResult> results;
 };
 
-void D3D11Replay::FillTimers(D3D11CounterContext &ctx, const DrawcallDescription &drawnode)
+void D3D11Replay::DrainCounterBatch(D3D11CounterContext &ctx)
 {
-  const D3D11_QUERY_DESC qtimedesc = {D3D11_QUERY_TIMESTAMP, 0};
-  const D3D11_QUERY_DESC qstatsdesc = {D3D11_QUERY_PIPELINE_STATISTICS, 0};
-  const D3D11_QUERY_DESC qoccldesc = {D3D11_QUERY_OCCLUSION, 0};
+  if(ctx.poolUsed == 0)
+    return;
+
+  // one flush per batch rather than a full CPU/GPU sync per draw - GetData on the first query
+  // then waits out the whole batch in one go.
+  m_pImmediateContext->Flush();
+
+  HRESULT hr = S_OK;
+
+  for(size_t i = 0; i < ctx.poolUsed; i++)
+  {
+    GPUTimer &timer = ctx.pool[i];
+
+    GPUTimerResult result;
+    result.eventId = timer.eventId;
+
+    UINT64 a = 0, b = 0;
 
+    do
+    {
+      hr = m_pImmediateContext->GetData(timer.before, &a, sizeof(UINT64), 0);
+    } while(hr == S_FALSE);
+    RDCASSERTEQUAL(hr, S_OK);
+
+    do
+    {
+      hr = m_pImmediateContext->GetData(timer.after, &b, sizeof(UINT64), 0);
+    } while(hr == S_FALSE);
+    RDCASSERTEQUAL(hr, S_OK);
+
+    result.duration = b - a;
+
+    do
+    {
+      hr = m_pImmediateContext->GetData(timer.stats, &result.pipelineStats,
+                                        sizeof(D3D11_QUERY_DATA_PIPELINE_STATISTICS), 0);
+    } while(hr == S_FALSE);
+    RDCASSERTEQUAL(hr, S_OK);
+
+    do
+    {
+      hr = m_pImmediateContext->GetData(timer.occlusion, &result.occlusion, sizeof(UINT64), 0);
+    } while(hr == S_FALSE);
+    RDCASSERTEQUAL(hr, S_OK);
+
+    ctx.results.push_back(result);
+  }
+
+  ctx.poolUsed = 0;
+}
+
+void D3D11Replay::FillTimers(D3D11CounterContext &ctx, const DrawcallDescription &drawnode)
+{
   if(drawnode.children.empty())
     return;
 
@@ -251,44 +315,22 @@ void D3D11Replay::FillTimers(D3D11CounterContext &ctx, const DrawcallDescription
     if(d.events.empty())
       continue;
 
-    GPUTimer *timer = NULL;
-
-    HRESULT hr = S_OK;
-
-    {
-      ctx.timers.push_back(GPUTimer());
+    // once the pool is exhausted, read back the in-flight batch so its queries can be reused
+    if(ctx.poolUsed == ctx.pool.size())
+      DrainCounterBatch(ctx);
 
-      timer = &ctx.timers.back();
-      timer->eventId = d.eventId;
-      timer->before = timer->after = timer->stats = timer->occlusion = NULL;
-
-      hr = m_pDevice->CreateQuery(&qtimedesc, &timer->before);
-      RDCASSERTEQUAL(hr, S_OK);
-      hr = m_pDevice->CreateQuery(&qtimedesc, &timer->after);
-      RDCASSERTEQUAL(hr, S_OK);
-      hr = m_pDevice->CreateQuery(&qstatsdesc, &timer->stats);
-      RDCASSERTEQUAL(hr, S_OK);
-      hr = m_pDevice->CreateQuery(&qoccldesc, &timer->occlusion);
-      RDCASSERTEQUAL(hr, S_OK);
-    }
+    GPUTimer *timer = &ctx.pool[ctx.poolUsed++];
+    timer->eventId = d.eventId;
 
     m_pDevice->ReplayLog(ctx.eventStart, d.eventId, eReplay_WithoutDraw);
 
-    SerializeImmediateContext();
-
-    if(timer->stats)
-      m_pImmediateContext->Begin(timer->stats);
-    if(timer->occlusion)
-      m_pImmediateContext->Begin(timer->occlusion);
-    if(timer->before && timer->after)
-      m_pImmediateContext->End(timer->before);
+    m_pImmediateContext->Begin(timer->stats);
+    m_pImmediateContext->Begin(timer->occlusion);
+    m_pImmediateContext->End(timer->before);
     m_pDevice->ReplayLog(ctx.eventStart, d.eventId, eReplay_OnlyDraw);
-    if(timer->before && timer->after)
-      m_pImmediateContext->End(timer->after);
-    if(timer->occlusion)
-      m_pImmediateContext->End(timer->occlusion);
-    if(timer->stats)
-      m_pImmediateContext->End(timer->stats);
+    m_pImmediateContext->End(timer->after);
+    m_pImmediateContext->End(timer->occlusion);
+    m_pImmediateContext->End(timer->stats);
 
     ctx.eventStart = d.eventId + 1;
   }
@@ -624,8 +666,9 @@ vector<CounterResult> D3D11Replay::FetchCounters(const vector<GPUCounter> &count
   D3D11_QUERY_DESC disjointdesc = {D3D11_QUERY_TIMESTAMP_DISJOINT, 0};
   ID3D11Query *disjoint = NULL;
 
-  D3D11_QUERY_DESC qdesc = {D3D11_QUERY_TIMESTAMP, 0};
-  ID3D11Query *start = NULL;
+  const D3D11_QUERY_DESC qtimedesc = {D3D11_QUERY_TIMESTAMP, 0};
+  const D3D11_QUERY_DESC qstatsdesc = {D3D11_QUERY_PIPELINE_STATISTICS, 0};
+  const D3D11_QUERY_DESC qoccldesc = {D3D11_QUERY_OCCLUSION, 0};
 
   HRESULT hr = S_OK;
 
@@ -636,24 +679,54 @@ vector<CounterResult> D3D11Replay::FetchCounters(const vector<GPUCounter> &count
     return ret;
   }
 
-  hr = m_pDevice->CreateQuery(&qdesc, &start);
-  if(FAILED(hr))
+  D3D11CounterContext ctx;
+  ctx.poolUsed = 0;
+
+  // allocate the query pool once up-front instead of four queries per draw during the replay
+  for(size_t i = 0; i < MaxQueryBatch; i++)
   {
-    RDCERR("Failed to create start query HRESULT: %s", ToStr(hr).c_str());
-    return ret;
+    GPUTimer timer;
+    timer.eventId = 0;
+    timer.before = timer.after = timer.stats = timer.occlusion = NULL;
+
+    hr = m_pDevice->CreateQuery(&qtimedesc, &timer.before);
+    if(SUCCEEDED(hr))
+      hr = m_pDevice->CreateQuery(&qtimedesc, &timer.after);
+    if(SUCCEEDED(hr))
+      hr = m_pDevice->CreateQuery(&qstatsdesc, &timer.stats);
+    if(SUCCEEDED(hr))
+      hr = m_pDevice->CreateQuery(&qoccldesc, &timer.occlusion);
+
+    if(FAILED(hr))
+    {
+      // stop growing the pool on the first failure - a smaller pool just means smaller batches
+      SAFE_RELEASE(timer.before);
+      SAFE_RELEASE(timer.after);
+      SAFE_RELEASE(timer.stats);
+      SAFE_RELEASE(timer.occlusion);
+      break;
+    }
+
+    ctx.pool.push_back(timer);
   }
 
-  D3D11CounterContext ctx;
+  if(ctx.pool.empty())
+  {
+    RDCERR("Failed to create any counter queries HRESULT: %s", ToStr(hr).c_str());
+    SAFE_RELEASE(disjoint);
+    return ret;
+  }
 
   {
     {
       m_pImmediateContext->Begin(disjoint);
 
-      m_pImmediateContext->End(start);
-
       ctx.eventStart = 0;
       FillTimers(ctx, m_pImmediateContext->GetRootDraw());
 
+      // read back the final partial batch
+      DrainCounterBatch(ctx);
+
       m_pImmediateContext->End(disjoint);
     }
 
@@ -670,136 +743,85 @@ vector<CounterResult> D3D11Replay::FetchCounters(const vector<GPUCounter> &count
 
       double ticksToSecs = double(disjointData.Frequency);
 
-      UINT64 a = 0;
-      hr = m_pImmediateContext->GetData(start, &a, sizeof(UINT64), 0);
-      RDCASSERTEQUAL(hr, S_OK);
-
-      for(size_t i = 0; i < ctx.timers.size(); i++)
+      for(size_t i = 0; i < ctx.results.size(); i++)
       {
-        if(ctx.timers[i].before && ctx.timers[i].after && ctx.timers[i].stats &&
-           ctx.timers[i].occlusion)
-        {
-          hr = m_pImmediateContext->GetData(ctx.timers[i].before, &a, sizeof(UINT64), 0);
-          RDCASSERTEQUAL(hr, S_OK);
-
-          UINT64 b = 0;
-          hr = m_pImmediateContext->GetData(ctx.timers[i].after, &b, sizeof(UINT64), 0);
-          RDCASSERTEQUAL(hr, S_OK);
-
-          double duration = (double(b - a) / ticksToSecs);
+        double duration = (double(ctx.results[i].duration) / ticksToSecs);
 
-          a = b;
+        const D3D11_QUERY_DATA_PIPELINE_STATISTICS &pipelineStats = ctx.results[i].pipelineStats;
 
-          D3D11_QUERY_DATA_PIPELINE_STATISTICS pipelineStats;
-          hr = m_pImmediateContext->GetData(ctx.timers[i].stats, &pipelineStats,
-                                            sizeof(D3D11_QUERY_DATA_PIPELINE_STATISTICS), 0);
-          RDCASSERTEQUAL(hr, S_OK);
+        UINT64 occlusion = ctx.results[i].occlusion;
 
-          UINT64 occlusion = 0;
-          hr = m_pImmediateContext->GetData(ctx.timers[i].occlusion, &occlusion, sizeof(UINT64), 0);
-          RDCASSERTEQUAL(hr, S_OK);
-
-          for(size_t c = 0; c < d3dCounters.size(); c++)
-          {
-            switch(d3dCounters[c])
-            {
-              case GPUCounter::EventGPUDuration:
-                ret.push_back(
-                    CounterResult(ctx.timers[i].eventId, GPUCounter::EventGPUDuration, duration));
-                break;
-              case GPUCounter::InputVerticesRead:
-                ret.push_back(CounterResult(ctx.timers[i].eventId, GPUCounter::InputVerticesRead,
-                                            pipelineStats.IAVertices));
-                break;
-              case GPUCounter::IAPrimitives:
-                ret.push_back(CounterResult(ctx.timers[i].eventId, GPUCounter::IAPrimitives,
-                                            pipelineStats.IAPrimitives));
-                break;
-              case GPUCounter::VSInvocations:
-                ret.push_back(CounterResult(ctx.timers[i].eventId, GPUCounter::VSInvocations,
-                                            pipelineStats.VSInvocations));
-                break;
-              case GPUCounter::GSInvocations:
-                ret.push_back(CounterResult(ctx.timers[i].eventId, GPUCounter::GSInvocations,
-                                            pipelineStats.GSInvocations));
-                break;
-              case GPUCounter::GSPrimitives:
-                ret.push_back(CounterResult(ctx.timers[i].eventId, GPUCounter::GSPrimitives,
-                                            pipelineStats.GSPrimitives));
-                break;
-              case GPUCounter::RasterizerInvocations:
-                ret.push_back(CounterResult(ctx.timers[i].eventId, GPUCounter::RasterizerInvocations,
-                                            pipelineStats.CInvocations));
-                break;
-              case GPUCounter::RasterizedPrimitives:
-                ret.push_back(CounterResult(ctx.timers[i].eventId, GPUCounter::RasterizedPrimitives,
-                                            pipelineStats.CPrimitives));
-                break;
-              case GPUCounter::PSInvocations:
-                ret.push_back(CounterResult(ctx.timers[i].eventId, GPUCounter::PSInvocations,
-                                            pipelineStats.PSInvocations));
-                break;
-              case GPUCounter::HSInvocations:
-                ret.push_back(CounterResult(ctx.timers[i].eventId, GPUCounter::HSInvocations,
-                                            pipelineStats.HSInvocations));
-                break;
-              case GPUCounter::DSInvocations:
-                ret.push_back(CounterResult(ctx.timers[i].eventId, GPUCounter::DSInvocations,
-                                            pipelineStats.DSInvocations));
-                break;
-              case GPUCounter::CSInvocations:
-                ret.push_back(CounterResult(ctx.timers[i].eventId, GPUCounter::CSInvocations,
-                                            pipelineStats.CSInvocations));
-                break;
-              case GPUCounter::SamplesPassed:
-                ret.push_back(
-                    CounterResult(ctx.timers[i].eventId, GPUCounter::SamplesPassed, occlusion));
-                break;
-            }
-          }
-        }
-        else
+        for(size_t c = 0; c < d3dCounters.size(); c++)
         {
-          for(size_t c = 0; c < d3dCounters.size(); c++)
+          switch(d3dCounters[c])
           {
-            switch(d3dCounters[c])
-            {
-              case GPUCounter::EventGPUDuration:
-                ret.push_back(
-                    CounterResult(ctx.timers[i].eventId, GPUCounter::EventGPUDuration, -1.0));
-                break;
-              case GPUCounter::InputVerticesRead:
-              case GPUCounter::IAPrimitives:
-              case GPUCounter::GSPrimitives:
-              case GPUCounter::RasterizerInvocations:
-              case GPUCounter::RasterizedPrimitives:
-              case GPUCounter::VSInvocations:
-              case GPUCounter::HSInvocations:
-              case GPUCounter::DSInvocations:
-              case GPUCounter::GSInvocations:
-              case GPUCounter::PSInvocations:
-              case GPUCounter::CSInvocations:
-              case GPUCounter::SamplesPassed:
-                ret.push_back(
-                    CounterResult(ctx.timers[i].eventId, d3dCounters[c], 0xFFFFFFFFFFFFFFFF));
-                break;
-            }
+            case GPUCounter::EventGPUDuration:
+              ret.push_back(
+                  CounterResult(ctx.results[i].eventId, GPUCounter::EventGPUDuration, duration));
+              break;
+            case GPUCounter::InputVerticesRead:
+              ret.push_back(CounterResult(ctx.results[i].eventId, GPUCounter::InputVerticesRead,
+                                          pipelineStats.IAVertices));
+              break;
+            case GPUCounter::IAPrimitives:
+              ret.push_back(CounterResult(ctx.results[i].eventId, GPUCounter::IAPrimitives,
+                                          pipelineStats.IAPrimitives));
+              break;
+            case GPUCounter::VSInvocations:
+              ret.push_back(CounterResult(ctx.results[i].eventId, GPUCounter::VSInvocations,
+                                          pipelineStats.VSInvocations));
+              break;
+            case GPUCounter::GSInvocations:
+              ret.push_back(CounterResult(ctx.results[i].eventId, GPUCounter::GSInvocations,
+                                          pipelineStats.GSInvocations));
+              break;
+            case GPUCounter::GSPrimitives:
+              ret.push_back(CounterResult(ctx.results[i].eventId, GPUCounter::GSPrimitives,
+                                          pipelineStats.GSPrimitives));
+              break;
+            case GPUCounter::RasterizerInvocations:
+              ret.push_back(CounterResult(ctx.results[i].eventId, GPUCounter::RasterizerInvocations,
+                                          pipelineStats.CInvocations));
+              break;
+            case GPUCounter::RasterizedPrimitives:
+              ret.push_back(CounterResult(ctx.results[i].eventId, GPUCounter::RasterizedPrimitives,
+                                          pipelineStats.CPrimitives));
+              break;
+            case GPUCounter::PSInvocations:
+              ret.push_back(CounterResult(ctx.results[i].eventId, GPUCounter::PSInvocations,
+                                          pipelineStats.PSInvocations));
+              break;
+            case GPUCounter::HSInvocations:
+              ret.push_back(CounterResult(ctx.results[i].eventId, GPUCounter::HSInvocations,
+                                          pipelineStats.HSInvocations));
+              break;
+            case GPUCounter::DSInvocations:
+              ret.push_back(CounterResult(ctx.results[i].eventId, GPUCounter::DSInvocations,
+                                          pipelineStats.DSInvocations));
+              break;
+            case GPUCounter::CSInvocations:
+              ret.push_back(CounterResult(ctx.results[i].eventId, GPUCounter::CSInvocations,
+                                          pipelineStats.CSInvocations));
+              break;
+            case GPUCounter::SamplesPassed:
+              ret.push_back(
+                  CounterResult(ctx.results[i].eventId, GPUCounter::SamplesPassed, occlusion));
+              break;
           }
         }
       }
     }
   }
 
-  for(size_t i = 0; i < ctx.timers.size(); i++)
+  for(size_t i = 0; i < ctx.pool.size(); i++)
   {
-    SAFE_RELEASE(ctx.timers[i].before);
-    SAFE_RELEASE(ctx.timers[i].after);
-    SAFE_RELEASE(ctx.timers[i].stats);
-    SAFE_RELEASE(ctx.timers[i].occlusion);
+    SAFE_RELEASE(ctx.pool[i].before);
+    SAFE_RELEASE(ctx.pool[i].after);
+    SAFE_RELEASE(ctx.pool[i].stats);
+    SAFE_RELEASE(ctx.pool[i].occlusion);
   }
 
   SAFE_RELEASE(disjoint);
-  SAFE_RELEASE(start);
 
   return ret;
 }
@@ -769,6 +769,10 @@ void WrappedID3D11Device::AddDebugMessage(MessageCategory c, MessageSeverity sv,
     msg.severity = sv;
     msg.description = d;
 
+    // drop duplicate messages re-triggered by scrubbing around the frame
+    if(IsActiveReplaying(m_State) && !m_ReportedDebugMessages.insert(msg).second)
+      return;
+
     m_DebugMessages.push_back(msg);
   }
 }
@@ -776,7 +780,13 @@ void WrappedID3D11Device::AddDebugMessage(MessageCategory c, MessageSeverity sv,
 void WrappedID3D11Device::AddDebugMessage(DebugMessage msg)
 {
   if(!IsActiveReplaying(m_State) || msg.source == MessageSource::RuntimeWarning)
+  {
+    // drop duplicate messages re-triggered by scrubbing around the frame
+    if(IsActiveReplaying(m_State) && !m_ReportedDebugMessages.insert(msg).second)
+      return;
+
     m_DebugMessages.push_back(msg);
+  }
 }
 
 std::vector<DebugMessage> WrappedID3D11Device::GetDebugMessages()
@@ -1090,6 +1100,10 @@ ReplayStatus WrappedID3D11Device::ReadLogInitialisation(RDCFile *rdc, bool store
   ser.SetStringDatabase(&m_StringDB);
   ser.SetUserData(GetResourceManager());
 
+  // the chunk storage is the memory-mapped file which outlives replay, so strings and buffers
+  // can be deserialised as borrowed views instead of copies. No-op for compressed captures.
+  ser.EnableBorrowedViews(true);
+
   ser.ConfigureStructuredExport(&GetChunkName, storeStructuredBuffers);
 
   m_StructuredFile = &ser.GetStructuredFile();
@@ -1391,10 +1405,6 @@ IUnknown *WrappedID3D11Device::WrapSwapchainBuffer(WrappedIDXGISwapChain4 *swap,
 
   ResourceId id = pTex->GetResourceID();
 
-  // init the text renderer
-  if(m_TextRenderer == NULL)
-    m_TextRenderer = new D3D11TextRenderer(this);
-
   // there shouldn't be a resource record for this texture as it wasn't created via
   // CreateTexture2D
   RDCASSERT(id != ResourceId() && !GetResourceManager()->HasResourceRecord(id));
@@ -1838,14 +1848,18 @@ bool WrappedID3D11Device::EndFrameCapture(void *dev, void *wnd)
         m_pImmediateContext->GetReal()->OMSetRenderTargets(1, &rtv, NULL);
 
         DXGI_SWAP_CHAIN_DESC swapDesc = swap->GetDescWithHWND();
-        m_TextRenderer->SetOutputDimensions(swapDesc.BufferDesc.Width, swapDesc.BufferDesc.Height);
-        m_TextRenderer->SetOutputWindow(swapDesc.OutputWindow);
 
-        m_TextRenderer->RenderText(0.0f, 0.0f, "Failed to capture frame %u: %s", m_FrameCounter,
-                                   reasonString);
+        D3D11TextRenderer *text = GetTextRenderer();
+        text->SetOutputDimensions(swapDesc.BufferDesc.Width, swapDesc.BufferDesc.Height);
+        text->SetOutputWindow(swapDesc.OutputWindow);
+
+        text->RenderText(0.0f, 0.0f, "Failed to capture frame %u: %s", m_FrameCounter,
+                         reasonString);
       }
 
-      old.ApplyState(m_pImmediateContext);
+      // the render target was bound on the real context above, bypassing the state tracking, so
+      // force a full rebind rather than diffing against the tracked state
+      old.ApplyState(m_pImmediateContext, true);
     }
 
     m_CapturedFrames.back().frameNumber = m_FrameCounter;
@@ -2103,6 +2117,16 @@ void WrappedID3D11Device::FirstFrame(WrappedIDXGISwapChain4 *swapChain)
   }
 }
 
+D3D11TextRenderer *WrappedID3D11Device::GetTextRenderer()
+{
+  // the overlay is often disabled for the lifetime of the program, so create the text rendering
+  // resources on first use rather than up-front when the swapchain is created.
+  if(m_TextRenderer == NULL)
+    m_TextRenderer = new D3D11TextRenderer(this);
+
+  return m_TextRenderer;
+}
+
 HRESULT WrappedID3D11Device::Present(WrappedIDXGISwapChain4 *swap, UINT SyncInterval, UINT Flags)
 {
   if((Flags & DXGI_PRESENT_TEST) != 0)
@@ -2124,20 +2148,24 @@ HRESULT WrappedID3D11Device::Present(WrappedIDXGISwapChain4 *swap, UINT SyncInte
 
   if(IsBackgroundCapturing(m_State))
   {
-    D3D11RenderState old = *m_pImmediateContext->GetCurrentPipelineState();
-
     uint32_t overlay = RenderDoc::Inst().GetOverlayBits();
 
     if(overlay & eRENDERDOC_Overlay_Enabled)
     {
+      // only snapshot the pipeline state when the overlay will actually be drawn - the copy
+      // takes a reference on every bound object, which is pure overhead on every other frame.
+      D3D11RenderState old = *m_pImmediateContext->GetCurrentPipelineState();
+
       ID3D11RenderTargetView *rtv = m_SwapChains[swap];
 
       m_pImmediateContext->GetReal()->OMSetRenderTargets(1, &rtv, NULL);
 
       DXGI_SWAP_CHAIN_DESC swapDesc = {0};
       swap->GetDesc(&swapDesc);
-      m_TextRenderer->SetOutputDimensions(swapDesc.BufferDesc.Width, swapDesc.BufferDesc.Height);
-      m_TextRenderer->SetOutputWindow(swapDesc.OutputWindow);
+
+      D3D11TextRenderer *text = GetTextRenderer();
+      text->SetOutputDimensions(swapDesc.BufferDesc.Width, swapDesc.BufferDesc.Height);
+      text->SetOutputWindow(swapDesc.OutputWindow);
 
       int flags = activeWindow ? RenderDoc::eOverlay_ActiveWindow : 0;
       string overlayText = RenderDoc::Inst().GetOverlayText(RDCDriver::D3D11, m_FrameCounter, flags);
@@ -2157,9 +2185,11 @@ HRESULT WrappedID3D11Device::Present(WrappedIDXGISwapChain4 *swap, UINT SyncInte
       }
 
       if(!overlayText.empty())
-        m_TextRenderer->RenderText(0.0f, 0.0f, overlayText.c_str());
+        text->RenderText(0.0f, 0.0f, overlayText.c_str());
 
-      old.ApplyState(m_pImmediateContext);
+      // the render target was bound on the real context above, bypassing the state tracking, so
+      // force a full rebind rather than diffing against the tracked state
+      old.ApplyState(m_pImmediateContext, true);
     }
   }
 
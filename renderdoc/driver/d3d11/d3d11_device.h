@@ -27,6 +27,7 @@
 
 #include <stdint.h>
 #include <map>
+#include <set>
 #include "api/replay/renderdoc_replay.h"
 #include "common/threading.h"
 #include "common/timing.h"
@@ -382,6 +383,8 @@ private:
   SDFile m_StoredStructuredData;
 
   vector<DebugMessage> m_DebugMessages;
+  // unique messages seen during active replay, used to drop duplicates re-triggered by scrubbing
+  std::set<DebugMessage> m_ReportedDebugMessages;
 
   vector<FrameDescription> m_CapturedFrames;
   FrameRecord m_FrameRecord;
@@ -415,6 +418,7 @@ public:
   D3D11ShaderCache *GetShaderCache() { return m_ShaderCache; }
   D3D11ResourceManager *GetResourceManager() { return m_ResourceManager; }
   D3D11DebugManager *GetDebugManager() { return m_DebugManager; }
+  D3D11TextRenderer *GetTextRenderer();
   D3D11Replay *GetReplay() { return &m_Replay; }
   Threading::CriticalSection &D3DLock() { return m_D3DLock; }
   bool D3DThreadSafe() const { return m_D3DThreadSafe; }
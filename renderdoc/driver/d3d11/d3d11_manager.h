@@ -307,6 +307,9 @@ private:
 
   bool Need_InitialStateChunk(ResourceId id, const InitialContentData &initial);
   bool Prepare_InitialState(ID3D11DeviceChild *res);
+  // prepared contents are standalone D3D11 resources, so they stay valid between the frames of a
+  // multi-frame capture burst
+  bool RetainPreparedContentsAcrossBurst() { return true; }
   uint64_t GetSize_InitialState(ResourceId id, const D3D11InitialContents &initial);
   bool Serialise_InitialState(WriteSerialiser &ser, ResourceId id, D3D11ResourceRecord *record,
                               const D3D11InitialContents *initial);
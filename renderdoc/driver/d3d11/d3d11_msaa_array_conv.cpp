@@ -714,7 +714,8 @@ void D3D11DebugManager::CopyTex2DMSToArray(ID3D11Texture2D *destArray, ID3D11Tex
 
   ctx->PSSetShaderResources(0, 8, srvs);
 
-  // loop over every array slice in MS texture
+  // loop over every array slice in MS texture. All of the slice-sample copies batch into a single
+  // submission - the dynamic cbuffers rename on DISCARD so there's no need to flush between draws
   for(UINT slice = 0; slice < descMS.ArraySize; slice++)
   {
     // loop over every multi sample
@@ -751,8 +752,6 @@ void D3D11DebugManager::CopyTex2DMSToArray(ID3D11Texture2D *destArray, ID3D11Tex
 
       SAFE_RELEASE(rtvArray);
       SAFE_RELEASE(dsvArray);
-
-      ctx->Flush();
     }
   }
 
@@ -500,8 +500,6 @@ void D3D11Replay::InitPostVSBuffers(uint32_t eventId)
 
     D3D11_QUERY_DATA_SO_STATISTICS numPrims;
 
-    m_pImmediateContext->CopyResource(m_SOStagingBuffer, m_SOBuffer);
-
     do
     {
       hr = m_pImmediateContext->GetData(m_SOStatsQueries[0], &numPrims,
@@ -515,6 +513,15 @@ void D3D11Replay::InitPostVSBuffers(uint32_t eventId)
       return;
     }
 
+    // only copy the range the draw actually wrote to the staging buffer. The scratch buffer
+    // persists at its high-water mark once a large draw has grown it, so a full-buffer copy on
+    // every event would dominate the cost of scrubbing through small draws.
+    D3D11_BOX box = {};
+    box.right = UINT(RDCMIN(uint64_t(stride) * numPrims.NumPrimitivesWritten, m_SOBufferSize));
+    box.bottom = 1;
+    box.back = 1;
+    m_pImmediateContext->CopySubresourceRegion(m_SOStagingBuffer, 0, 0, 0, 0, m_SOBuffer, 0, &box);
+
     D3D11_MAPPED_SUBRESOURCE mapped;
     hr = m_pImmediateContext->Map(m_SOStagingBuffer, 0, D3D11_MAP_READ, 0, &mapped);
 
@@ -839,8 +846,6 @@ void D3D11Replay::InitPostVSBuffers(uint32_t eventId)
     m_pImmediateContext->GSSetShader(NULL, NULL, 0);
     m_pImmediateContext->SOSetTargets(0, NULL, NULL);
 
-    m_pImmediateContext->CopyResource(m_SOStagingBuffer, m_SOBuffer);
-
     std::vector<D3D11PostVSData::InstData> instData;
 
     if((drawcall->flags & DrawFlags::Instanced) && drawcall->numInstances > 1)
@@ -879,6 +884,16 @@ void D3D11Replay::InitPostVSBuffers(uint32_t eventId)
       return;
     }
 
+    uint64_t bytesWritten = stride * numPrims.NumPrimitivesWritten * 3;
+
+    // as with the vertex output copy above, only copy the written range to the staging buffer
+    // rather than the whole scratch buffer.
+    D3D11_BOX box = {};
+    box.right = UINT(RDCMIN(bytesWritten, m_SOBufferSize));
+    box.bottom = 1;
+    box.back = 1;
+    m_pImmediateContext->CopySubresourceRegion(m_SOStagingBuffer, 0, 0, 0, 0, m_SOBuffer, 0, &box);
+
     D3D11_MAPPED_SUBRESOURCE mapped;
     hr = m_pImmediateContext->Map(m_SOStagingBuffer, 0, D3D11_MAP_READ, 0, &mapped);
 
@@ -888,8 +903,6 @@ void D3D11Replay::InitPostVSBuffers(uint32_t eventId)
       return;
     }
 
-    uint64_t bytesWritten = stride * numPrims.NumPrimitivesWritten * 3;
-
     if(bytesWritten > 0xFFFFFFFFULL)
     {
       RDCERR("More than 4GB of data generated, cannot create output buffer large enough.");
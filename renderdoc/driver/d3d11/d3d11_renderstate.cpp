@@ -466,90 +466,122 @@ bool D3D11RenderState::PredicationWouldPass()
   return PredicateValue != data;
 }
 
-void D3D11RenderState::ApplyState(WrappedID3D11DeviceContext *context)
+void D3D11RenderState::ApplyState(WrappedID3D11DeviceContext *context, bool forceApply)
 {
-  context->ClearState();
-
-  // IA
-  context->IASetInputLayout(IA.Layout);
-  context->IASetPrimitiveTopology(IA.Topo);
-  context->IASetIndexBuffer(IA.IndexBuffer, IA.IndexFormat, IA.IndexOffset);
-  context->IASetVertexBuffers(0, D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT, IA.VBs, IA.Strides,
-                              IA.Offsets);
-
-  // VS
-  context->VSSetShaderResources(0, D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT, VS.SRVs);
-  context->VSSetSamplers(0, D3D11_COMMONSHADER_SAMPLER_SLOT_COUNT, VS.Samplers);
-  context->VSSetShader((ID3D11VertexShader *)VS.Object, VS.Instances, VS.NumInstances);
-
-  // DS
-  context->DSSetShaderResources(0, D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT, DS.SRVs);
-  context->DSSetSamplers(0, D3D11_COMMONSHADER_SAMPLER_SLOT_COUNT, DS.Samplers);
-  context->DSSetShader((ID3D11DomainShader *)DS.Object, DS.Instances, DS.NumInstances);
-
-  // HS
-  context->HSSetShaderResources(0, D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT, HS.SRVs);
-  context->HSSetSamplers(0, D3D11_COMMONSHADER_SAMPLER_SLOT_COUNT, HS.Samplers);
-  context->HSSetShader((ID3D11HullShader *)HS.Object, HS.Instances, HS.NumInstances);
-
-  // GS
-  context->GSSetShaderResources(0, D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT, GS.SRVs);
-  context->GSSetSamplers(0, D3D11_COMMONSHADER_SAMPLER_SLOT_COUNT, GS.Samplers);
-  context->GSSetShader((ID3D11GeometryShader *)GS.Object, GS.Instances, GS.NumInstances);
-
-  context->SOSetTargets(D3D11_SO_BUFFER_SLOT_COUNT, SO.Buffers, SO.Offsets);
+  // the context's pipeline state tracking is updated by every wrapped call, including on replay,
+  // so it always mirrors what is bound right now. Rather than clearing the context and rebinding
+  // the whole pipeline we compare against it and only issue the binds that change something -
+  // when stepping between adjacent events nearly all of the state is identical, and the
+  // redundant binds dominate replay CPU time.
+  //
+  // cur is a live reference, not a snapshot: each bind we issue updates it, including any
+  // implicit unbinds from read/write hazards. For that reason all the write binds (SO, OM, CS
+  // UAVs) are applied first - if one of them evicts a read bind that this state wants, the later
+  // comparison sees the evicted NULL and re-issues the read bind. This state is internally
+  // consistent, so its read binds can't conflict with its own write binds.
+  const D3D11RenderState &cur = *context->GetCurrentPipelineState();
 
-  // RS
-  context->RSSetState(RS.State);
-  context->RSSetViewports(RS.NumViews, RS.Viewports);
-  context->RSSetScissorRects(RS.NumScissors, RS.Scissors);
+  if(forceApply || memcmp(SO.Buffers, cur.SO.Buffers, sizeof(SO.Buffers)) != 0 ||
+     memcmp(SO.Offsets, cur.SO.Offsets, sizeof(SO.Offsets)) != 0)
+    context->SOSetTargets(D3D11_SO_BUFFER_SLOT_COUNT, SO.Buffers, SO.Offsets);
 
   UINT UAV_keepcounts[D3D11_1_UAV_SLOT_COUNT] = {(UINT)-1, (UINT)-1, (UINT)-1, (UINT)-1,
                                                  (UINT)-1, (UINT)-1, (UINT)-1, (UINT)-1};
 
-  // CS
-  context->CSSetShaderResources(0, D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT, CS.SRVs);
-  context->CSSetSamplers(0, D3D11_COMMONSHADER_SAMPLER_SLOT_COUNT, CS.Samplers);
-  if(context->IsFL11_1())
-    context->CSSetUnorderedAccessViews(0, D3D11_1_UAV_SLOT_COUNT, CSUAVs, UAV_keepcounts);
-  else
-    context->CSSetUnorderedAccessViews(0, D3D11_PS_CS_UAV_REGISTER_COUNT, CSUAVs, UAV_keepcounts);
-  context->CSSetShader((ID3D11ComputeShader *)CS.Object, CS.Instances, CS.NumInstances);
+  // OM
+  if(forceApply || OM.BlendState != cur.OM.BlendState ||
+     memcmp(OM.BlendFactor, cur.OM.BlendFactor, sizeof(OM.BlendFactor)) != 0 ||
+     OM.SampleMask != cur.OM.SampleMask)
+    context->OMSetBlendState(OM.BlendState, OM.BlendFactor, OM.SampleMask);
+
+  if(forceApply || OM.DepthStencilState != cur.OM.DepthStencilState ||
+     OM.StencRef != cur.OM.StencRef)
+    context->OMSetDepthStencilState(OM.DepthStencilState, OM.StencRef);
+
+  if(forceApply || memcmp(OM.RenderTargets, cur.OM.RenderTargets, sizeof(OM.RenderTargets)) != 0 ||
+     OM.DepthView != cur.OM.DepthView || OM.UAVStartSlot != cur.OM.UAVStartSlot ||
+     memcmp(OM.UAVs, cur.OM.UAVs, sizeof(OM.UAVs)) != 0)
+  {
+    if(context->IsFL11_1())
+      context->OMSetRenderTargetsAndUnorderedAccessViews(
+          RDCMIN(OM.UAVStartSlot, (UINT)D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT), OM.RenderTargets,
+          OM.DepthView, OM.UAVStartSlot, D3D11_1_UAV_SLOT_COUNT - OM.UAVStartSlot, OM.UAVs,
+          UAV_keepcounts);
+    else
+      context->OMSetRenderTargetsAndUnorderedAccessViews(
+          RDCMIN(OM.UAVStartSlot, (UINT)D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT), OM.RenderTargets,
+          OM.DepthView, OM.UAVStartSlot, D3D11_PS_CS_UAV_REGISTER_COUNT - OM.UAVStartSlot, OM.UAVs,
+          UAV_keepcounts);
+  }
 
-  // PS
-  context->PSSetShaderResources(0, D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT, PS.SRVs);
-  context->PSSetSamplers(0, D3D11_COMMONSHADER_SAMPLER_SLOT_COUNT, PS.Samplers);
-  context->PSSetShader((ID3D11PixelShader *)PS.Object, PS.Instances, PS.NumInstances);
+  if(forceApply || memcmp(CSUAVs, cur.CSUAVs, sizeof(CSUAVs)) != 0)
+  {
+    if(context->IsFL11_1())
+      context->CSSetUnorderedAccessViews(0, D3D11_1_UAV_SLOT_COUNT, CSUAVs, UAV_keepcounts);
+    else
+      context->CSSetUnorderedAccessViews(0, D3D11_PS_CS_UAV_REGISTER_COUNT, CSUAVs, UAV_keepcounts);
+  }
 
-  context->VSSetConstantBuffers1(0, D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT,
-                                 VS.ConstantBuffers, VS.CBOffsets, VS.CBCounts);
-  context->DSSetConstantBuffers1(0, D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT,
-                                 DS.ConstantBuffers, DS.CBOffsets, DS.CBCounts);
-  context->HSSetConstantBuffers1(0, D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT,
-                                 HS.ConstantBuffers, HS.CBOffsets, HS.CBCounts);
-  context->GSSetConstantBuffers1(0, D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT,
-                                 GS.ConstantBuffers, GS.CBOffsets, GS.CBCounts);
-  context->CSSetConstantBuffers1(0, D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT,
-                                 CS.ConstantBuffers, CS.CBOffsets, CS.CBCounts);
-  context->PSSetConstantBuffers1(0, D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT,
-                                 PS.ConstantBuffers, PS.CBOffsets, PS.CBCounts);
+  // RS
+  if(forceApply || RS.State != cur.RS.State)
+    context->RSSetState(RS.State);
 
-  // OM
-  context->OMSetBlendState(OM.BlendState, OM.BlendFactor, OM.SampleMask);
-  context->OMSetDepthStencilState(OM.DepthStencilState, OM.StencRef);
+  if(forceApply || RS.NumViews != cur.RS.NumViews ||
+     memcmp(RS.Viewports, cur.RS.Viewports, sizeof(RS.Viewports)) != 0)
+    context->RSSetViewports(RS.NumViews, RS.Viewports);
 
-  if(context->IsFL11_1())
-    context->OMSetRenderTargetsAndUnorderedAccessViews(
-        RDCMIN(OM.UAVStartSlot, (UINT)D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT), OM.RenderTargets,
-        OM.DepthView, OM.UAVStartSlot, D3D11_1_UAV_SLOT_COUNT - OM.UAVStartSlot, OM.UAVs,
-        UAV_keepcounts);
-  else
-    context->OMSetRenderTargetsAndUnorderedAccessViews(
-        RDCMIN(OM.UAVStartSlot, (UINT)D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT), OM.RenderTargets,
-        OM.DepthView, OM.UAVStartSlot, D3D11_PS_CS_UAV_REGISTER_COUNT - OM.UAVStartSlot, OM.UAVs,
-        UAV_keepcounts);
+  if(forceApply || RS.NumScissors != cur.RS.NumScissors ||
+     memcmp(RS.Scissors, cur.RS.Scissors, sizeof(RS.Scissors)) != 0)
+    context->RSSetScissorRects(RS.NumScissors, RS.Scissors);
 
-  context->SetPredication(Predicate, PredicateValue);
+  // IA
+  if(forceApply || IA.Layout != cur.IA.Layout)
+    context->IASetInputLayout(IA.Layout);
+
+  if(forceApply || IA.Topo != cur.IA.Topo)
+    context->IASetPrimitiveTopology(IA.Topo);
+
+  if(forceApply || IA.IndexBuffer != cur.IA.IndexBuffer || IA.IndexFormat != cur.IA.IndexFormat ||
+     IA.IndexOffset != cur.IA.IndexOffset)
+    context->IASetIndexBuffer(IA.IndexBuffer, IA.IndexFormat, IA.IndexOffset);
+
+  if(forceApply || memcmp(IA.VBs, cur.IA.VBs, sizeof(IA.VBs)) != 0 ||
+     memcmp(IA.Strides, cur.IA.Strides, sizeof(IA.Strides)) != 0 ||
+     memcmp(IA.Offsets, cur.IA.Offsets, sizeof(IA.Offsets)) != 0)
+    context->IASetVertexBuffers(0, D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT, IA.VBs, IA.Strides,
+                                IA.Offsets);
+
+// each shader stage's bindings are identical in layout, only the context entry points differ
+#define APPLY_STAGE_BINDS(prefix, ShaderType)                                                      \
+  if(forceApply || memcmp(prefix.SRVs, cur.prefix.SRVs, sizeof(prefix.SRVs)) != 0)                 \
+    context->prefix##SetShaderResources(0, D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT,           \
+                                        prefix.SRVs);                                              \
+  if(forceApply || memcmp(prefix.Samplers, cur.prefix.Samplers, sizeof(prefix.Samplers)) != 0)     \
+    context->prefix##SetSamplers(0, D3D11_COMMONSHADER_SAMPLER_SLOT_COUNT, prefix.Samplers);       \
+  if(forceApply || prefix.Object != cur.prefix.Object ||                                           \
+     prefix.NumInstances != cur.prefix.NumInstances ||                                             \
+     memcmp(prefix.Instances, cur.prefix.Instances, sizeof(prefix.Instances)) != 0)                \
+    context->prefix##SetShader((ShaderType *)prefix.Object, prefix.Instances,                      \
+                               prefix.NumInstances);                                               \
+  if(forceApply ||                                                                                 \
+     memcmp(prefix.ConstantBuffers, cur.prefix.ConstantBuffers,                                    \
+            sizeof(prefix.ConstantBuffers)) != 0 ||                                                \
+     memcmp(prefix.CBOffsets, cur.prefix.CBOffsets, sizeof(prefix.CBOffsets)) != 0 ||              \
+     memcmp(prefix.CBCounts, cur.prefix.CBCounts, sizeof(prefix.CBCounts)) != 0)                   \
+    context->prefix##SetConstantBuffers1(0, D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT,     \
+                                         prefix.ConstantBuffers, prefix.CBOffsets, prefix.CBCounts);
+
+  APPLY_STAGE_BINDS(VS, ID3D11VertexShader);
+  APPLY_STAGE_BINDS(HS, ID3D11HullShader);
+  APPLY_STAGE_BINDS(DS, ID3D11DomainShader);
+  APPLY_STAGE_BINDS(GS, ID3D11GeometryShader);
+  APPLY_STAGE_BINDS(PS, ID3D11PixelShader);
+  APPLY_STAGE_BINDS(CS, ID3D11ComputeShader);
+
+#undef APPLY_STAGE_BINDS
+
+  if(forceApply || Predicate != cur.Predicate || PredicateValue != cur.PredicateValue)
+    context->SetPredication(Predicate, PredicateValue);
 }
 
 void D3D11RenderState::TakeRef(ID3D11DeviceChild *p)
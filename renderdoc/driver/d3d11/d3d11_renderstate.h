@@ -51,7 +51,11 @@ struct D3D11RenderState
 
   void CopyState(const D3D11RenderState &other);
 
-  void ApplyState(WrappedID3D11DeviceContext *context);
+  // binds this state to the context. By default only the bindings that differ from the context's
+  // tracked pipeline state are issued - pass forceApply if the real context has been modified
+  // behind the wrapper's back (so the tracked state can't be trusted) and everything must be
+  // rebound.
+  void ApplyState(WrappedID3D11DeviceContext *context, bool forceApply = false);
   void Clear();
 
   ///////////////////////////////////////////////////////////////////////////////
@@ -247,6 +247,7 @@ void D3D11Replay::DestroyResources()
 
   ShutdownStreamOut();
   ClearPostVSCache();
+  InvalidateStagingCache();
 
   SAFE_RELEASE(m_pFactory);
 }
@@ -1480,9 +1481,56 @@ ReplayStatus D3D11Replay::ReadLogInitialisation(RDCFile *rdc, bool storeStructur
 
 void D3D11Replay::ReplayLog(uint32_t endEventID, ReplayLogType replayType)
 {
+  // replaying changes resource contents, so any staging copies cached for readback are stale
+  InvalidateStagingCache();
+
   m_pDevice->ReplayLog(0, endEventID, replayType);
 }
 
+ID3D11Resource *D3D11Replay::GetCachedStagingTexture(ResourceId id)
+{
+  for(size_t i = 0; i < m_StagingCache.size(); i++)
+  {
+    if(m_StagingCache[i].id == id)
+    {
+      StagingTexture entry = m_StagingCache[i];
+
+      // keep the cache in most-recently-used order
+      m_StagingCache.erase(m_StagingCache.begin() + i);
+      m_StagingCache.insert(m_StagingCache.begin(), entry);
+
+      // the caller releases its reference when it's done, same as if it had created the texture
+      entry.tex->AddRef();
+      return entry.tex;
+    }
+  }
+
+  return NULL;
+}
+
+void D3D11Replay::CacheStagingTexture(ResourceId id, ID3D11Resource *stagingTex)
+{
+  // the cache holds its own reference, over and above the caller's
+  stagingTex->AddRef();
+
+  StagingTexture entry = {id, stagingTex};
+  m_StagingCache.insert(m_StagingCache.begin(), entry);
+
+  while(m_StagingCache.size() > MaxStagingCacheEntries)
+  {
+    SAFE_RELEASE(m_StagingCache.back().tex);
+    m_StagingCache.pop_back();
+  }
+}
+
+void D3D11Replay::InvalidateStagingCache()
+{
+  for(StagingTexture &entry : m_StagingCache)
+    SAFE_RELEASE(entry.tex);
+
+  m_StagingCache.clear();
+}
+
 const SDFile &D3D11Replay::GetStructuredFile()
 {
   return m_pDevice->GetStructuredFile();
@@ -1789,6 +1837,14 @@ void D3D11Replay::GetTextureData(ResourceId tex, uint32_t arrayIdx, uint32_t mip
 
   size_t bytesize = 0;
 
+  // plain readbacks snapshot every subresource of the texture, so the staging copy can be cached
+  // and re-used for the viewer's per-mip and per-slice requests. Remapped or resolved fetches bake
+  // the requested subresource and display parameters into the copy, and the overlay and custom
+  // shader textures are re-rendered without replaying, so none of those are cacheable.
+  bool cacheable = params.remap == RemapTexture::NoRemap && !params.resolve &&
+                   tex != m_Overlay.resourceId && tex != m_CustomShaderResourceId;
+  bool cached = false;
+
   if(WrappedID3D11Texture1D::m_TextureList.find(tex) != WrappedID3D11Texture1D::m_TextureList.end())
   {
     WrappedID3D11Texture1D *wrapTex =
@@ -1830,19 +1886,33 @@ void D3D11Replay::GetTextureData(ResourceId tex, uint32_t arrayIdx, uint32_t mip
 
     subresource = arrayIdx * mips + mip;
 
-    HRESULT hr = m_pDevice->CreateTexture1D(&desc, NULL, &d);
+    if(cacheable)
+      d = (ID3D11Texture1D *)GetCachedStagingTexture(tex);
 
-    dummyTex = d;
+    cached = (d != NULL);
 
-    if(FAILED(hr))
+    HRESULT hr = S_OK;
+
+    if(d == NULL)
     {
-      RDCERR("Couldn't create staging texture to retrieve data. HRESULT: %s", ToStr(hr).c_str());
-      return;
+      hr = m_pDevice->CreateTexture1D(&desc, NULL, &d);
+
+      if(FAILED(hr))
+      {
+        RDCERR("Couldn't create staging texture to retrieve data. HRESULT: %s", ToStr(hr).c_str());
+        return;
+      }
     }
 
+    dummyTex = d;
+
     bytesize = GetByteSize(desc.Width, 1, 1, desc.Format, mip);
 
-    if(params.remap != RemapTexture::NoRemap)
+    if(cached)
+    {
+      // the cached staging copy already contains every subresource, just map it below
+    }
+    else if(params.remap != RemapTexture::NoRemap)
     {
       subresource = mip;
 
@@ -1920,6 +1990,9 @@ void D3D11Replay::GetTextureData(ResourceId tex, uint32_t arrayIdx, uint32_t mip
     {
       m_pImmediateContext->CopyResource(d, wrapTex);
     }
+
+    if(cacheable && !cached)
+      CacheStagingTexture(tex, d);
   }
   else if(WrappedID3D11Texture2D1::m_TextureList.find(tex) !=
           WrappedID3D11Texture2D1::m_TextureList.end())
@@ -1977,19 +2050,33 @@ void D3D11Replay::GetTextureData(ResourceId tex, uint32_t arrayIdx, uint32_t mip
 
     subresource = arrayIdx * mips + mip;
 
-    HRESULT hr = m_pDevice->CreateTexture2D(&desc, NULL, &d);
+    if(cacheable)
+      d = (ID3D11Texture2D *)GetCachedStagingTexture(tex);
 
-    dummyTex = d;
+    cached = (d != NULL);
 
-    if(FAILED(hr))
+    HRESULT hr = S_OK;
+
+    if(d == NULL)
     {
-      RDCERR("Couldn't create staging texture to retrieve data. HRESULT: %s", ToStr(hr).c_str());
-      return;
+      hr = m_pDevice->CreateTexture2D(&desc, NULL, &d);
+
+      if(FAILED(hr))
+      {
+        RDCERR("Couldn't create staging texture to retrieve data. HRESULT: %s", ToStr(hr).c_str());
+        return;
+      }
     }
 
+    dummyTex = d;
+
     bytesize = GetByteSize(desc.Width, desc.Height, 1, desc.Format, mip);
 
-    if(params.remap != RemapTexture::NoRemap)
+    if(cached)
+    {
+      // the cached staging copy already contains every subresource, just map it below
+    }
+    else if(params.remap != RemapTexture::NoRemap)
     {
       subresource = mip;
 
@@ -2095,6 +2182,9 @@ void D3D11Replay::GetTextureData(ResourceId tex, uint32_t arrayIdx, uint32_t mip
     {
       m_pImmediateContext->CopyResource(d, wrapTex);
     }
+
+    if(cacheable && !cached)
+      CacheStagingTexture(tex, d);
   }
   else if(WrappedID3D11Texture3D1::m_TextureList.find(tex) !=
           WrappedID3D11Texture3D1::m_TextureList.end())
@@ -2136,19 +2226,33 @@ void D3D11Replay::GetTextureData(ResourceId tex, uint32_t arrayIdx, uint32_t mip
 
     subresource = mip;
 
-    HRESULT hr = m_pDevice->CreateTexture3D(&desc, NULL, &d);
+    if(cacheable)
+      d = (ID3D11Texture3D *)GetCachedStagingTexture(tex);
 
-    dummyTex = d;
+    cached = (d != NULL);
 
-    if(FAILED(hr))
+    HRESULT hr = S_OK;
+
+    if(d == NULL)
     {
-      RDCERR("Couldn't create staging texture to retrieve data. HRESULT: %s", ToStr(hr).c_str());
-      return;
+      hr = m_pDevice->CreateTexture3D(&desc, NULL, &d);
+
+      if(FAILED(hr))
+      {
+        RDCERR("Couldn't create staging texture to retrieve data. HRESULT: %s", ToStr(hr).c_str());
+        return;
+      }
     }
 
+    dummyTex = d;
+
     bytesize = GetByteSize(desc.Width, desc.Height, desc.Depth, desc.Format, mip);
 
-    if(params.remap != RemapTexture::NoRemap)
+    if(cached)
+    {
+      // the cached staging copy already contains every subresource, just map it below
+    }
+    else if(params.remap != RemapTexture::NoRemap)
     {
       subresource = mip;
 
@@ -2232,6 +2336,9 @@ void D3D11Replay::GetTextureData(ResourceId tex, uint32_t arrayIdx, uint32_t mip
     {
       m_pImmediateContext->CopyResource(d, wrapTex);
     }
+
+    if(cacheable && !cached)
+      CacheStagingTexture(tex, d);
   }
   else
   {
@@ -3802,7 +3909,7 @@ ReplayStatus D3D11_CreateReplayDevice(RDCFile *rdc, IReplayDriver **driver)
 
 static DriverRegistration D3D11DriverRegistration(RDCDriver::D3D11, &D3D11_CreateReplayDevice);
 
-void D3D11_ProcessStructured(RDCFile *rdc, SDFile &output)
+void D3D11_ProcessStructured(RDCFile *rdc, SDFile &output, bool includeBuffers)
 {
   WrappedID3D11Device device(NULL, D3D11InitParams());
 
@@ -3812,7 +3919,7 @@ void D3D11_ProcessStructured(RDCFile *rdc, SDFile &output)
     return;
 
   device.SetStructuredExport(rdc->GetSectionProperties(sectionIdx).version);
-  ReplayStatus status = device.ReadLogInitialisation(rdc, true);
+  ReplayStatus status = device.ReadLogInitialisation(rdc, includeBuffers);
 
   if(status == ReplayStatus::Succeeded)
     device.GetStructuredFile().Swap(output);
@@ -260,6 +260,7 @@ private:
   std::vector<CounterResult> FetchCountersIntel(const vector<GPUCounter> &counters);
 
   void FillTimers(D3D11CounterContext &ctx, const DrawcallDescription &drawnode);
+  void DrainCounterBatch(D3D11CounterContext &ctx);
   void FillTimersAMD(uint32_t &eventStartID, uint32_t &sampleIndex, vector<uint32_t> &eventIDs,
                      const DrawcallDescription &drawnode);
   void FillTimersNV(uint32_t &eventStartID, uint32_t &sampleIndex, vector<uint32_t> &eventIDs,
@@ -326,6 +327,23 @@ private:
 
   HighlightCache m_HighlightCache;
 
+  // a small MRU cache of the CPU-readable staging copies made by GetTextureData. The staging copy
+  // contains every subresource, so the texture viewer's per-mip and per-slice requests after the
+  // first only pay for a Map. Invalidated whenever the log is replayed, since that changes
+  // resource contents.
+  struct StagingTexture
+  {
+    ResourceId id;
+    ID3D11Resource *tex = NULL;
+  };
+
+  static const size_t MaxStagingCacheEntries = 8;
+  std::vector<StagingTexture> m_StagingCache;
+
+  ID3D11Resource *GetCachedStagingTexture(ResourceId id);
+  void CacheStagingTexture(ResourceId id, ID3D11Resource *stagingTex);
+  void InvalidateStagingCache();
+
   uint64_t m_SOBufferSize = 32 * 1024 * 1024;
   ID3D11Buffer *m_SOBuffer = NULL;
   ID3D11Buffer *m_SOStagingBuffer = NULL;
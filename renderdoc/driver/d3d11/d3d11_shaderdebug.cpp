@@ -72,6 +72,13 @@ struct DebugHit
 // over this number of cycles and things get problematic
 #define SHADER_DEBUG_WARN_THRESHOLD 100000
 
+// traces below this many states are always stored densely. Above it, only every
+// SHADER_DEBUG_KEYFRAME_INTERVAL'th state stores a full snapshot and the states between store
+// just the variables each step wrote, so long-running loops stay within a memory budget. The UI
+// reconstructs full contents on demand from the nearest snapshot.
+#define SHADER_DEBUG_DENSE_STATES 10000
+#define SHADER_DEBUG_KEYFRAME_INTERVAL 100
+
 bool PromptDebugTimeout(DXBC::ProgramType prog, uint32_t cycleCounter)
 {
   string msg = StringFormat::Fmt(
@@ -1088,29 +1095,42 @@ ShaderDebugTrace D3D11Replay::DebugVertex(uint32_t eventId, uint32_t vertid, uin
 
   State last;
 
+  DXBC::DXBCDebugChunk *debugInfo = dxbc->GetDebugInfo();
+
   vector<ShaderDebugState> states;
 
-  if(dxbc->m_DebugInfo)
-    dxbc->m_DebugInfo->GetLocals(0, dxbc->GetInstruction(0).offset, initialState.locals);
+  if(debugInfo)
+    debugInfo->GetLocals(0, dxbc->GetInstruction(0).offset, initialState.locals);
 
   states.push_back((State)initialState);
 
   D3D11MarkerRegion simloop("Simulation Loop");
 
+  // ping pong between two states so each step costs a single register file copy
+  State stepState;
+
+  State *curState = &initialState, *nextState = &stepState;
+
   for(int cycleCounter = 0;; cycleCounter++)
   {
-    if(initialState.Finished())
+    if(curState->Finished())
       break;
 
-    initialState = initialState.GetNext(global, NULL);
+    curState->StepNext(nextState, global, NULL);
+    std::swap(curState, nextState);
 
-    if(dxbc->m_DebugInfo)
+    if(debugInfo)
     {
-      const ASMOperation &op = dxbc->GetInstruction((size_t)initialState.nextInstruction);
-      dxbc->m_DebugInfo->GetLocals(initialState.nextInstruction, op.offset, initialState.locals);
+      const ASMOperation &op = dxbc->GetInstruction((size_t)curState->nextInstruction);
+      debugInfo->GetLocals(curState->nextInstruction, op.offset, curState->locals);
     }
 
-    states.push_back((State)initialState);
+    // after the swap, nextState holds the previous step's full contents to diff against
+    if(states.size() >= SHADER_DEBUG_DENSE_STATES &&
+       (states.size() % SHADER_DEBUG_KEYFRAME_INTERVAL) != 0)
+      states.push_back(MakePartialState(*nextState, *curState));
+    else
+      states.push_back((State)*curState);
 
     if(cycleCounter == SHADER_DEBUG_WARN_THRESHOLD)
     {
@@ -1121,13 +1141,13 @@ ShaderDebugTrace D3D11Replay::DebugVertex(uint32_t eventId, uint32_t vertid, uin
 
   ret.states = states;
 
-  ret.hasLocals = dxbc->m_DebugInfo && dxbc->m_DebugInfo->HasLocals();
+  ret.hasLocals = debugInfo && debugInfo->HasLocals();
 
   ret.lineInfo.resize(dxbc->GetNumInstructions());
-  for(size_t i = 0; dxbc->m_DebugInfo && i < dxbc->GetNumInstructions(); i++)
+  for(size_t i = 0; debugInfo && i < dxbc->GetNumInstructions(); i++)
   {
     const ASMOperation &op = dxbc->GetInstruction(i);
-    dxbc->m_DebugInfo->GetLineInfo(i, op.offset, ret.lineInfo[i]);
+    debugInfo->GetLineInfo(i, op.offset, ret.lineInfo[i]);
   }
 
   return ret;
@@ -2262,10 +2282,12 @@ void ExtractInputsPS(PSInput IN, float4 debug_pixelPos : SV_Position, uint prim
   SAFE_DELETE_ARRAY(initialData);
   SAFE_DELETE_ARRAY(evalData);
 
+  DXBC::DXBCDebugChunk *debugInfo = dxbc->GetDebugInfo();
+
   vector<ShaderDebugState> states;
 
-  if(dxbc->m_DebugInfo)
-    dxbc->m_DebugInfo->GetLocals(0, dxbc->GetInstruction(0).offset, quad[destIdx].locals);
+  if(debugInfo)
+    debugInfo->GetLocals(0, dxbc->GetInstruction(0).offset, quad[destIdx].locals);
 
   states.push_back((State)quad[destIdx]);
 
@@ -2289,7 +2311,7 @@ void ExtractInputsPS(PSInput IN, float4 debug_pixelPos : SV_Position, uint prim
     for(size_t i = 0; i < 4; i++)
     {
       if(activeMask[i])
-        newquad[i] = curquad[i].GetNext(global, curquad);
+        curquad[i].StepNext(&newquad[i], global, curquad);
       else
         newquad[i] = curquad[i];
     }
@@ -2303,14 +2325,21 @@ void ExtractInputsPS(PSInput IN, float4 debug_pixelPos : SV_Position, uint prim
     {
       State &s = curquad[destIdx];
 
-      if(dxbc->m_DebugInfo)
+      if(debugInfo)
       {
         size_t inst = RDCMIN((size_t)s.nextInstruction, dxbc->GetNumInstructions() - 1);
         const ASMOperation &op = dxbc->GetInstruction(inst);
-        dxbc->m_DebugInfo->GetLocals(s.nextInstruction, op.offset, s.locals);
+        debugInfo->GetLocals(s.nextInstruction, op.offset, s.locals);
       }
 
-      states.push_back(s);
+      // after the swap, newquad holds the previous step's full contents to diff against. Paused
+      // steps copy the state unchanged and don't record, so this always matches the last state
+      // recorded for this thread.
+      if(states.size() >= SHADER_DEBUG_DENSE_STATES &&
+         (states.size() % SHADER_DEBUG_KEYFRAME_INTERVAL) != 0)
+        states.push_back(MakePartialState(newquad[destIdx], s));
+      else
+        states.push_back(s);
     }
 
     // we need to make sure that control flow which converges stays in lockstep so that
@@ -2403,13 +2432,13 @@ void ExtractInputsPS(PSInput IN, float4 debug_pixelPos : SV_Position, uint prim
 
   traces[destIdx].states = states;
 
-  traces[destIdx].hasLocals = dxbc->m_DebugInfo && dxbc->m_DebugInfo->HasLocals();
+  traces[destIdx].hasLocals = debugInfo && debugInfo->HasLocals();
 
   traces[destIdx].lineInfo.resize(dxbc->GetNumInstructions());
-  for(size_t i = 0; dxbc->m_DebugInfo && i < dxbc->GetNumInstructions(); i++)
+  for(size_t i = 0; debugInfo && i < dxbc->GetNumInstructions(); i++)
   {
     const ASMOperation &op = dxbc->GetInstruction(i);
-    dxbc->m_DebugInfo->GetLineInfo(i, op.offset, traces[destIdx].lineInfo[i]);
+    debugInfo->GetLineInfo(i, op.offset, traces[destIdx].lineInfo[i]);
   }
 
   return traces[destIdx];
@@ -2468,27 +2497,41 @@ ShaderDebugTrace D3D11Replay::DebugThread(uint32_t eventId, const uint32_t group
     initialState.semantics.ThreadID[i] = threadid[i];
   }
 
+  DXBC::DXBCDebugChunk *debugInfo = dxbc->GetDebugInfo();
+
   vector<ShaderDebugState> states;
 
-  if(dxbc->m_DebugInfo)
-    dxbc->m_DebugInfo->GetLocals(0, dxbc->GetInstruction(0).offset, initialState.locals);
+  if(debugInfo)
+    debugInfo->GetLocals(0, dxbc->GetInstruction(0).offset, initialState.locals);
 
   states.push_back((State)initialState);
 
+  // ping pong between two states so each step costs a single register file copy. The semantics
+  // inputs read below are carried into every stepped state, so initialState stays valid for them
+  State stepState;
+
+  State *curState = &initialState, *nextState = &stepState;
+
   for(int cycleCounter = 0;; cycleCounter++)
   {
-    if(initialState.Finished())
+    if(curState->Finished())
       break;
 
-    initialState = initialState.GetNext(global, NULL);
+    curState->StepNext(nextState, global, NULL);
+    std::swap(curState, nextState);
 
-    if(dxbc->m_DebugInfo)
+    if(debugInfo)
     {
-      const ASMOperation &op = dxbc->GetInstruction((size_t)initialState.nextInstruction);
-      dxbc->m_DebugInfo->GetLocals(initialState.nextInstruction, op.offset, initialState.locals);
+      const ASMOperation &op = dxbc->GetInstruction((size_t)curState->nextInstruction);
+      debugInfo->GetLocals(curState->nextInstruction, op.offset, curState->locals);
     }
 
-    states.push_back((State)initialState);
+    // after the swap, nextState holds the previous step's full contents to diff against
+    if(states.size() >= SHADER_DEBUG_DENSE_STATES &&
+       (states.size() % SHADER_DEBUG_KEYFRAME_INTERVAL) != 0)
+      states.push_back(MakePartialState(*nextState, *curState));
+    else
+      states.push_back((State)*curState);
 
     if(cycleCounter == SHADER_DEBUG_WARN_THRESHOLD)
     {
@@ -2499,13 +2542,13 @@ ShaderDebugTrace D3D11Replay::DebugThread(uint32_t eventId, const uint32_t group
 
   ret.states = states;
 
-  ret.hasLocals = dxbc->m_DebugInfo && dxbc->m_DebugInfo->HasLocals();
+  ret.hasLocals = debugInfo && debugInfo->HasLocals();
 
   ret.lineInfo.resize(dxbc->GetNumInstructions());
-  for(size_t i = 0; dxbc->m_DebugInfo && i < dxbc->GetNumInstructions(); i++)
+  for(size_t i = 0; debugInfo && i < dxbc->GetNumInstructions(); i++)
   {
     const ASMOperation &op = dxbc->GetInstruction(i);
-    dxbc->m_DebugInfo->GetLineInfo(i, op.offset, ret.lineInfo[i]);
+    debugInfo->GetLineInfo(i, op.offset, ret.lineInfo[i]);
   }
 
   for(size_t i = 0; i < dxbc->GetNumDeclarations(); i++)
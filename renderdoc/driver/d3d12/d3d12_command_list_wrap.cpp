@@ -82,7 +82,12 @@ bool WrappedID3D12GraphicsCommandList::Serialise_Close(SerialiserType &ser)
 
     if(IsActiveReplaying(m_State))
     {
-      if(m_Cmd->HasRerecordCmdList(BakedCommandList))
+      if(m_Cmd->m_ReusedBakedCmds.find(BakedCommandList) != m_Cmd->m_ReusedBakedCmds.end())
+      {
+        // this list was re-executed from the baked cache - it's already closed, and no commands
+        // (or markers) replayed into it this time around.
+      }
+      else if(m_Cmd->HasRerecordCmdList(BakedCommandList))
       {
         ID3D12GraphicsCommandList4 *list = m_Cmd->RerecordCmdList(BakedCommandList);
 #if ENABLED(VERBOSE_PARTIAL_REPLAY)
@@ -103,6 +108,11 @@ bool WrappedID3D12GraphicsCommandList::Serialise_Close(SerialiserType &ser)
 
         list->Close();
 
+        // now that it's fully recorded and closed, an unmodified recording moves into the baked
+        // cache so subsequent replays can re-execute it without re-recording
+        if(m_Cmd->m_CacheableCmds.find(BakedCommandList) != m_Cmd->m_CacheableCmds.end())
+          m_Cmd->CacheBakedCommandList(BakedCommandList, list);
+
         if(m_Cmd->m_Partial[D3D12CommandData::Primary].partialParent == CommandList)
           m_Cmd->m_Partial[D3D12CommandData::Primary].partialParent = ResourceId();
       }
@@ -249,33 +259,61 @@ bool WrappedID3D12GraphicsCommandList::Serialise_Reset(SerialiserType &ser,
 
       if(rerecord)
       {
-        ID3D12GraphicsCommandList *listptr = NULL;
-        HRESULT hr =
-            m_pDevice->CreateCommandList(nodeMask, type, pAllocator, pInitialState,
-                                         __uuidof(ID3D12GraphicsCommandList), (void **)&listptr);
+        // fully in-range command lists replay identically every time, so they can be recorded
+        // once and re-executed as-is on subsequent replays. The partial one must be re-recorded
+        // each time, and while a drawcall callback is registered it may insert its own commands
+        // so we neither fill nor consume the cache.
+        bool cacheable = !partial && m_Cmd->m_DrawcallCallback == NULL;
+
+        auto cached = m_Cmd->m_CachedBakedCmds.find(BakedCommandList);
 
-        if(FAILED(hr))
+        if(cacheable && cached != m_Cmd->m_CachedBakedCmds.end())
         {
-          RDCERR("Failed on resource serialise-creation, hr: %s", ToStr(hr).c_str());
-          return false;
+          // re-execute the previous fully-baked recording as-is. It's already closed, so we mark
+          // both IDs as reused - no commands will replay into it and Close() will skip it.
+          ID3D12GraphicsCommandList4 *list = cached->second;
+
+          m_Cmd->m_RerecordCmds[BakedCommandList] = list;
+          m_Cmd->m_RerecordCmds[CommandList] = list;
+
+          m_Cmd->m_ReusedBakedCmds.insert(BakedCommandList);
+          m_Cmd->m_ReusedBakedCmds.insert(CommandList);
         }
+        else
+        {
+          ID3D12GraphicsCommandList *listptr = NULL;
+          HRESULT hr =
+              m_pDevice->CreateCommandList(nodeMask, type, pAllocator, pInitialState,
+                                           __uuidof(ID3D12GraphicsCommandList), (void **)&listptr);
 
-        // this is a safe upcast because it's a wrapped object
-        ID3D12GraphicsCommandList4 *list = (ID3D12GraphicsCommandList4 *)listptr;
+          if(FAILED(hr))
+          {
+            RDCERR("Failed on resource serialise-creation, hr: %s", ToStr(hr).c_str());
+            return false;
+          }
 
-        // we store under both baked and non baked ID.
-        // The baked ID is the 'real' entry, the non baked is simply so it
-        // can be found in the subsequent serialised commands that ref the
-        // non-baked ID. The baked ID is referenced by the submit itself.
-        //
-        // In Close() we erase the non-baked reference, and since
-        // we know you can only be recording a command list once at a time
-        // (even if it's baked to several command listsin the frame)
-        // there's no issue with clashes here.
-        m_Cmd->m_RerecordCmds[BakedCommandList] = list;
-        m_Cmd->m_RerecordCmds[CommandList] = list;
-
-        m_Cmd->m_RerecordCmdList.push_back(list);
+          // this is a safe upcast because it's a wrapped object
+          ID3D12GraphicsCommandList4 *list = (ID3D12GraphicsCommandList4 *)listptr;
+
+          // we store under both baked and non baked ID.
+          // The baked ID is the 'real' entry, the non baked is simply so it
+          // can be found in the subsequent serialised commands that ref the
+          // non-baked ID. The baked ID is referenced by the submit itself.
+          //
+          // In Close() we erase the non-baked reference, and since
+          // we know you can only be recording a command list once at a time
+          // (even if it's baked to several command listsin the frame)
+          // there's no issue with clashes here.
+          m_Cmd->m_RerecordCmds[BakedCommandList] = list;
+          m_Cmd->m_RerecordCmds[CommandList] = list;
+
+          m_Cmd->m_RerecordCmdList.push_back(list);
+
+          // once this recording is closed it can move into the cache and be re-executed on
+          // subsequent replays
+          if(cacheable)
+            m_Cmd->m_CacheableCmds.insert(BakedCommandList);
+        }
 
         if(m_Cmd->IsPartialCmdList(m_Cmd->m_LastCmdListID))
           m_Cmd->m_RenderState.pipe = GetResID(pInitialState);
@@ -308,6 +308,8 @@ WrappedID3D12CommandQueue::~WrappedID3D12CommandQueue()
   for(size_t i = 0; i < m_Cmd.m_IndirectBuffers.size(); i++)
     SAFE_RELEASE(m_Cmd.m_IndirectBuffers[i]);
 
+  m_Cmd.InvalidateBakedCommandListCache();
+
   SAFE_RELEASE(m_WrappedDebug.m_pReal);
   SAFE_RELEASE(m_pReal);
 }
@@ -737,6 +739,9 @@ ReplayStatus WrappedID3D12CommandQueue::ReplayLog(CaptureState readType, uint32_
 
     m_pDevice->ExecuteLists();
     m_pDevice->FlushLists();
+
+    // evict the staging copies now the GPU is done with them, until the next apply
+    m_pDevice->GetResourceManager()->SetInitialContentsResidency(false);
   }
 
   if(IsActiveReplaying(m_State))
@@ -851,6 +856,8 @@ ReplayStatus WrappedID3D12CommandQueue::ReplayLog(CaptureState readType, uint32_
 
   m_Cmd.m_RerecordCmds.clear();
   m_Cmd.m_RerecordCmdList.clear();
+  m_Cmd.m_CacheableCmds.clear();
+  m_Cmd.m_ReusedBakedCmds.clear();
 
   return ReplayStatus::Succeeded;
 }
@@ -1294,6 +1301,30 @@ uint32_t D3D12CommandData::HandlePreCallback(ID3D12GraphicsCommandList4 *list, b
   return eventId;
 }
 
+void D3D12CommandData::CacheBakedCommandList(ResourceId bakedId, ID3D12GraphicsCommandList4 *list)
+{
+  // pull the list out of the end-of-replay release list and keep it across replays instead
+  for(auto it = m_RerecordCmdList.begin(); it != m_RerecordCmdList.end(); ++it)
+  {
+    if(*it == list)
+    {
+      m_CachedBakedCmds[bakedId] = list;
+      m_RerecordCmdList.erase(it);
+      break;
+    }
+  }
+
+  m_CacheableCmds.erase(bakedId);
+}
+
+void D3D12CommandData::InvalidateBakedCommandListCache()
+{
+  for(auto it = m_CachedBakedCmds.begin(); it != m_CachedBakedCmds.end(); ++it)
+    SAFE_RELEASE(it->second);
+
+  m_CachedBakedCmds.clear();
+}
+
 bool D3D12CommandData::InRerecordRange(ResourceId cmdid)
 {
   // if we have an outside command list, assume the range is valid and we're replaying all events
@@ -1301,6 +1332,11 @@ bool D3D12CommandData::InRerecordRange(ResourceId cmdid)
   if(m_OutsideCmdList != NULL)
     return true;
 
+  // command lists re-executed from the baked cache are already fully recorded and closed, so no
+  // commands may replay into them.
+  if(m_ReusedBakedCmds.find(cmdid) != m_ReusedBakedCmds.end())
+    return false;
+
   // if not, check if we're one of the actual partial command buffers and check to see if we're in
   // the range for their partial replay.
   for(int p = 0; p < ePartialNum; p++)
@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include <set>
 #include "api/replay/renderdoc_replay.h"
 #include "common/common.h"
 #include "d3d12_common.h"
@@ -329,6 +330,22 @@ struct D3D12CommandData
   std::map<ResourceId, ID3D12GraphicsCommandList4 *> m_RerecordCmds;
   std::vector<ID3D12GraphicsCommandList4 *> m_RerecordCmdList;
 
+  // cache of fully-baked command list re-records, by bake ID. A command list that lies completely
+  // within the replayed range re-records to exactly the same commands every replay, so once
+  // recorded and closed it can be re-executed as-is on subsequent replays instead of being
+  // re-recorded from the serialised stream - only the partial list containing the target event
+  // actually differs. Invalidated whenever resource replacements change (e.g. shader edits), since
+  // the baked commands reference the old resources.
+  std::map<ResourceId, ID3D12GraphicsCommandList4 *> m_CachedBakedCmds;
+
+  // bake IDs of lists re-recorded this replay that are unmodified and should move into
+  // m_CachedBakedCmds when they're closed, instead of being released with m_RerecordCmdList
+  std::set<ResourceId> m_CacheableCmds;
+
+  // original and bake IDs of lists re-executed from m_CachedBakedCmds this replay - these are
+  // already recorded and closed, so no commands must replay into them
+  std::set<ResourceId> m_ReusedBakedCmds;
+
   bool m_AddedDrawcall;
 
   vector<APIEvent> m_RootEvents, m_Events;
@@ -366,6 +383,8 @@ struct D3D12CommandData
   bool InRerecordRange(ResourceId cmdid);
   bool HasRerecordCmdList(ResourceId cmdid);
   bool IsPartialCmdList(ResourceId cmdid);
+  void CacheBakedCommandList(ResourceId bakedId, ID3D12GraphicsCommandList4 *list);
+  void InvalidateBakedCommandListCache();
   ID3D12GraphicsCommandList4 *RerecordCmdList(ResourceId cmdid,
                                               PartialReplayIndex partialType = ePartialNum);
 
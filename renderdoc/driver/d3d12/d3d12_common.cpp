@@ -158,6 +158,11 @@ bool D3D12InitParams::IsSupportedVersion(uint64_t ver)
   if(ver == CurrentVersion)
     return true;
 
+  // 0x6 -> 0x7 - Descriptor heap initial states serialised as ranges of defined descriptors
+  //              instead of one array covering the whole heap.
+  if(ver == 0x6)
+    return true;
+
   // 0x5 -> 0x6 - Multiply by number of planes in format when serialising initial states -
   //              i.e. stencil is saved with depth in initial states.
   if(ver == 0x5)
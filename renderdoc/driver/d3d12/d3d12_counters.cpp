@@ -373,22 +373,26 @@ struct D3D12GPUTimerCallback : public D3D12DrawcallCallback
         m_PipeStatsQueryHeap(psqh),
         m_OcclusionQueryHeap(oqh),
         m_NumStatsQueries(0),
+        m_NumOcclusionQueries(0),
         m_NumTimestampQueries(0)
   {
     m_pDevice->GetQueue()->GetCommandData()->m_DrawcallCallback = this;
   }
   ~D3D12GPUTimerCallback() { m_pDevice->GetQueue()->GetCommandData()->m_DrawcallCallback = NULL; }
-  void PreDraw(uint32_t eid, ID3D12GraphicsCommandList4 *cmd) override
+  void BeginQueries(ID3D12GraphicsCommandList4 *cmd, bool rasterize)
   {
     if(cmd->GetType() == D3D12_COMMAND_LIST_TYPE_DIRECT)
     {
-      cmd->BeginQuery(m_OcclusionQueryHeap, D3D12_QUERY_TYPE_OCCLUSION, m_NumStatsQueries);
+      // occlusion queries are only meaningful for events that rasterize - skip them around
+      // dispatches so we don't pay for queries that can never return samples.
+      if(rasterize)
+        cmd->BeginQuery(m_OcclusionQueryHeap, D3D12_QUERY_TYPE_OCCLUSION, m_NumOcclusionQueries);
       cmd->BeginQuery(m_PipeStatsQueryHeap, D3D12_QUERY_TYPE_PIPELINE_STATISTICS, m_NumStatsQueries);
     }
     cmd->EndQuery(m_TimerQueryHeap, D3D12_QUERY_TYPE_TIMESTAMP, m_NumTimestampQueries * 2 + 0);
   }
 
-  bool PostDraw(uint32_t eid, ID3D12GraphicsCommandList4 *cmd) override
+  bool EndQueries(uint32_t eid, ID3D12GraphicsCommandList4 *cmd, bool rasterize)
   {
     cmd->EndQuery(m_TimerQueryHeap, D3D12_QUERY_TYPE_TIMESTAMP, m_NumTimestampQueries * 2 + 1);
     m_NumTimestampQueries++;
@@ -397,20 +401,35 @@ struct D3D12GPUTimerCallback : public D3D12DrawcallCallback
     if(direct)
     {
       cmd->EndQuery(m_PipeStatsQueryHeap, D3D12_QUERY_TYPE_PIPELINE_STATISTICS, m_NumStatsQueries);
-      cmd->EndQuery(m_OcclusionQueryHeap, D3D12_QUERY_TYPE_OCCLUSION, m_NumStatsQueries);
-
       m_NumStatsQueries++;
+
+      if(rasterize)
+      {
+        cmd->EndQuery(m_OcclusionQueryHeap, D3D12_QUERY_TYPE_OCCLUSION, m_NumOcclusionQueries);
+        m_NumOcclusionQueries++;
+      }
     }
-    m_Results.push_back(std::make_pair(eid, direct));
+    m_Results.push_back({eid, direct, direct && rasterize});
     return false;
   }
 
+  void PreDraw(uint32_t eid, ID3D12GraphicsCommandList4 *cmd) override
+  {
+    BeginQueries(cmd, true);
+  }
+  bool PostDraw(uint32_t eid, ID3D12GraphicsCommandList4 *cmd) override
+  {
+    return EndQueries(eid, cmd, true);
+  }
   void PostRedraw(uint32_t eid, ID3D12GraphicsCommandList4 *cmd) override {}
-  // we don't need to distinguish, call the Draw functions
-  void PreDispatch(uint32_t eid, ID3D12GraphicsCommandList4 *cmd) override { PreDraw(eid, cmd); }
+  // dispatches can't generate samples, so they only get timestamps and pipeline statistics
+  void PreDispatch(uint32_t eid, ID3D12GraphicsCommandList4 *cmd) override
+  {
+    BeginQueries(cmd, false);
+  }
   bool PostDispatch(uint32_t eid, ID3D12GraphicsCommandList4 *cmd) override
   {
-    return PostDraw(eid, cmd);
+    return EndQueries(eid, cmd, false);
   }
   void PostRedispatch(uint32_t eid, ID3D12GraphicsCommandList4 *cmd) override
   {
@@ -422,14 +441,24 @@ struct D3D12GPUTimerCallback : public D3D12DrawcallCallback
     m_AliasEvents.push_back(std::make_pair(primary, alias));
   }
 
+  struct Result
+  {
+    uint32_t eventId;
+    // events on non-direct lists only record timestamps
+    bool direct;
+    // only rasterizing events on direct lists record occlusion queries
+    bool rasterized;
+  };
+
   WrappedID3D12Device *m_pDevice;
   D3D12Replay *m_pReplay;
   ID3D12QueryHeap *m_TimerQueryHeap;
   ID3D12QueryHeap *m_PipeStatsQueryHeap;
   ID3D12QueryHeap *m_OcclusionQueryHeap;
-  vector<pair<uint32_t, bool> > m_Results;
+  vector<Result> m_Results;
 
   uint32_t m_NumStatsQueries;
+  uint32_t m_NumOcclusionQueries;
   uint32_t m_NumTimestampQueries;
 
   // events which are the 'same' from being the same command buffer resubmitted
@@ -578,17 +607,21 @@ vector<CounterResult> D3D12Replay::FetchCounters(const vector<GPUCounter> &count
 
   bufferOffset += sizeof(D3D12_QUERY_DATA_PIPELINE_STATISTICS) * cb.m_NumStatsQueries;
 
-  list->ResolveQueryData(occlusionQueryHeap, D3D12_QUERY_TYPE_OCCLUSION, 0, cb.m_NumStatsQueries,
-                         readbackBuf, bufferOffset);
+  list->ResolveQueryData(occlusionQueryHeap, D3D12_QUERY_TYPE_OCCLUSION, 0,
+                         cb.m_NumOcclusionQueries, readbackBuf, bufferOffset);
+
+  bufferOffset += sizeof(uint64_t) * cb.m_NumOcclusionQueries;
 
   list->Close();
 
   m_pDevice->ExecuteLists();
   m_pDevice->FlushLists();
 
+  // only map the range we actually resolved - the buffer was sized for the worst case of every
+  // event recording every query type
   D3D12_RANGE range;
   range.Begin = 0;
-  range.End = (SIZE_T)bufDesc.Width;
+  range.End = (SIZE_T)bufferOffset;
 
   uint8_t *data;
   hr = readbackBuf->Map(0, &range, (void **)&data);
@@ -613,18 +646,20 @@ vector<CounterResult> D3D12Replay::FetchCounters(const vector<GPUCounter> &count
 
   for(size_t i = 0; i < cb.m_Results.size(); i++)
   {
-    bool direct = cb.m_Results[i].second;
-
     D3D12_QUERY_DATA_PIPELINE_STATISTICS pipeStats = {};
     uint64_t occl = 0;
 
-    // only events on direct lists recorded pipeline stats or occlusion queries
-    if(direct)
+    // only events on direct lists recorded pipeline stats queries
+    if(cb.m_Results[i].direct)
     {
       pipeStats = *pipelinestats;
-      occl = *occlusion;
-
       pipelinestats++;
+    }
+
+    // and only rasterizing events recorded occlusion queries
+    if(cb.m_Results[i].rasterized)
+    {
+      occl = *occlusion;
       occlusion++;
     }
 
@@ -632,7 +667,7 @@ vector<CounterResult> D3D12Replay::FetchCounters(const vector<GPUCounter> &count
     {
       CounterResult result;
 
-      result.eventId = cb.m_Results[i].first;
+      result.eventId = cb.m_Results[i].eventId;
       result.counter = counters[c];
 
       switch(counters[c])
@@ -23,6 +23,7 @@
  ******************************************************************************/
 
 #include "d3d12_device.h"
+#include "common/threading.h"
 #include "core/core.h"
 #include "driver/dxgi/dxgi_common.h"
 #include "driver/dxgi/dxgi_wrapped.h"
@@ -410,6 +411,11 @@ WrappedID3D12Device::~WrappedID3D12Device()
     SAFE_RELEASE(it->second);
   }
 
+  for(size_t i = 0; i < m_InitialContentsBuffers.size(); i++)
+  {
+    SAFE_RELEASE(m_InitialContentsBuffers[i]);
+  }
+
   m_Replay.DestroyResources();
 
   DestroyInternalResources();
@@ -735,13 +741,100 @@ ID3D12Resource *WrappedID3D12Device::GetUploadBuffer(uint64_t chunkOffset, uint6
   return buf;
 }
 
+byte *WrappedID3D12Device::AllocInitialStateContents(uint64_t byteSize, ID3D12Resource *&buf,
+                                                     uint64_t &offset)
+{
+  // initial contents stay alive for the whole replay, and most captures have thousands of small
+  // ones - a dedicated committed resource for each would round every one up to at least 64KB of
+  // heap. Instead bump-allocate out of large shared upload buffers, aligned so sub-allocations
+  // are usable as texture copy sources.
+  const uint64_t BlockSize = 64 * 1024 * 1024;
+
+  uint64_t curOffset =
+      AlignUp(m_InitialContentsCurOffset, (uint64_t)D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+
+  if(m_InitialContentsCurBuf == NULL || byteSize > BlockSize || curOffset + byteSize > BlockSize)
+  {
+    D3D12_RESOURCE_DESC bufDesc;
+    bufDesc.Alignment = 0;
+    bufDesc.DepthOrArraySize = 1;
+    bufDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+    bufDesc.Flags = D3D12_RESOURCE_FLAG_NONE;
+    bufDesc.Format = DXGI_FORMAT_UNKNOWN;
+    bufDesc.Height = 1;
+    bufDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+    bufDesc.MipLevels = 1;
+    bufDesc.SampleDesc.Count = 1;
+    bufDesc.SampleDesc.Quality = 0;
+    bufDesc.Width = RDCMAX(byteSize, BlockSize);
+
+    D3D12_HEAP_PROPERTIES heapProps;
+    heapProps.Type = D3D12_HEAP_TYPE_UPLOAD;
+    heapProps.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+    heapProps.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+    heapProps.CreationNodeMask = 1;
+    heapProps.VisibleNodeMask = 1;
+
+    ID3D12Resource *newBuf = NULL;
+    HRESULT hr = CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &bufDesc,
+                                         D3D12_RESOURCE_STATE_GENERIC_READ, NULL,
+                                         __uuidof(ID3D12Resource), (void **)&newBuf);
+
+    if(FAILED(hr))
+    {
+      RDCERR("Couldn't create initial contents buffer of %llu bytes: %s", bufDesc.Width,
+             ToStr(hr).c_str());
+      return NULL;
+    }
+
+    byte *map = NULL;
+    hr = newBuf->Map(0, NULL, (void **)&map);
+
+    if(FAILED(hr) || map == NULL)
+    {
+      RDCERR("Couldn't map initial contents buffer: %s", ToStr(hr).c_str());
+      SAFE_RELEASE(newBuf);
+      return NULL;
+    }
+
+    m_InitialContentsBuffers.push_back(newBuf);
+
+    // over-sized allocations get a buffer to themselves and don't disturb the current block
+    if(byteSize > BlockSize)
+    {
+      newBuf->AddRef();
+      buf = newBuf;
+      offset = 0;
+      return map;
+    }
+
+    m_InitialContentsCurBuf = newBuf;
+    m_InitialContentsCurMap = map;
+    curOffset = 0;
+  }
+
+  m_InitialContentsCurOffset = curOffset + byteSize;
+
+  m_InitialContentsCurBuf->AddRef();
+  buf = m_InitialContentsCurBuf;
+  offset = curOffset;
+  return m_InitialContentsCurMap + curOffset;
+}
+
 void WrappedID3D12Device::ApplyInitialContents()
 {
   initStateCurBatch = 0;
   initStateCurList = NULL;
 
+  // the staging copies are evicted between applies so they don't compete with the capture's own
+  // heaps for GPU memory, page them all back in before the copies reference them
+  GetResourceManager()->SetInitialContentsResidency(true);
+
   GetResourceManager()->ApplyInitialContents();
 
+  // restore all the resources we copied into back to their frame-initial states, in one barrier
+  GetResourceManager()->FlushRestoreBarriers();
+
   // close the final list
   if(initStateCurList)
   {
@@ -1330,6 +1423,16 @@ void WrappedID3D12Device::WriteToSubresource(ID3D12Resource *Resource, UINT Subr
   }
 }
 
+D3D12TextRenderer *WrappedID3D12Device::GetTextRenderer()
+{
+  // the overlay is often disabled for the lifetime of the program, so create the text rendering
+  // resources on first use rather than up-front with the other internal resources.
+  if(m_TextRenderer == NULL)
+    m_TextRenderer = new D3D12TextRenderer(this);
+
+  return m_TextRenderer;
+}
+
 HRESULT WrappedID3D12Device::Present(WrappedIDXGISwapChain4 *swap, UINT SyncInterval, UINT Flags)
 {
   if((Flags & DXGI_PRESENT_TEST) != 0)
@@ -1368,8 +1471,9 @@ HRESULT WrappedID3D12Device::Present(WrappedIDXGISwapChain4 *swap, UINT SyncInte
 
       if(rtv.ptr)
       {
-        m_TextRenderer->SetOutputDimensions(swapdesc.BufferDesc.Width, swapdesc.BufferDesc.Height,
-                                            swapdesc.BufferDesc.Format);
+        D3D12TextRenderer *text = GetTextRenderer();
+        text->SetOutputDimensions(swapdesc.BufferDesc.Width, swapdesc.BufferDesc.Height,
+                                  swapdesc.BufferDesc.Format);
 
         ID3D12GraphicsCommandList *list = GetNewList();
 
@@ -1390,7 +1494,7 @@ HRESULT WrappedID3D12Device::Present(WrappedIDXGISwapChain4 *swap, UINT SyncInte
             RenderDoc::Inst().GetOverlayText(RDCDriver::D3D12, m_FrameCounter, flags);
 
         if(!overlayText.empty())
-          m_TextRenderer->RenderText(list, 0.0f, 0.0f, overlayText.c_str());
+          text->RenderText(list, 0.0f, 0.0f, overlayText.c_str());
 
         // transition backbuffer back again
         std::swap(barrier.Transition.StateBefore, barrier.Transition.StateAfter);
@@ -1929,6 +2033,61 @@ void WrappedID3D12Device::ReleaseResource(ID3D12DeviceChild *res)
   }
 }
 
+// lowers an expanded descriptor to the regular compute descriptor, for when the newer
+// stream-based creation isn't available
+static D3D12_COMPUTE_PIPELINE_STATE_DESC MakeComputeDesc(
+    const D3D12_EXPANDED_PIPELINE_STATE_STREAM_DESC &desc)
+{
+  D3D12_COMPUTE_PIPELINE_STATE_DESC compDesc;
+  compDesc.pRootSignature = desc.pRootSignature;
+  compDesc.CS = desc.CS;
+  compDesc.NodeMask = desc.NodeMask;
+  compDesc.CachedPSO = desc.CachedPSO;
+  compDesc.Flags = desc.Flags;
+  return compDesc;
+}
+
+// as above for graphics. Lossy: depth bounds test and view instancing have no equivalent in the
+// regular descriptor
+static D3D12_GRAPHICS_PIPELINE_STATE_DESC MakeGraphicsDesc(
+    const D3D12_EXPANDED_PIPELINE_STATE_STREAM_DESC &desc)
+{
+  D3D12_GRAPHICS_PIPELINE_STATE_DESC graphicsDesc;
+  graphicsDesc.pRootSignature = desc.pRootSignature;
+  graphicsDesc.VS = desc.VS;
+  graphicsDesc.PS = desc.PS;
+  graphicsDesc.DS = desc.DS;
+  graphicsDesc.HS = desc.HS;
+  graphicsDesc.GS = desc.GS;
+  graphicsDesc.StreamOutput = desc.StreamOutput;
+  graphicsDesc.BlendState = desc.BlendState;
+  graphicsDesc.SampleMask = desc.SampleMask;
+  graphicsDesc.RasterizerState = desc.RasterizerState;
+  // graphicsDesc.DepthStencilState = desc.DepthStencilState;
+  {
+    graphicsDesc.DepthStencilState.DepthEnable = desc.DepthStencilState.DepthEnable;
+    graphicsDesc.DepthStencilState.DepthWriteMask = desc.DepthStencilState.DepthWriteMask;
+    graphicsDesc.DepthStencilState.DepthFunc = desc.DepthStencilState.DepthFunc;
+    graphicsDesc.DepthStencilState.StencilEnable = desc.DepthStencilState.StencilEnable;
+    graphicsDesc.DepthStencilState.StencilReadMask = desc.DepthStencilState.StencilReadMask;
+    graphicsDesc.DepthStencilState.StencilWriteMask = desc.DepthStencilState.StencilWriteMask;
+    graphicsDesc.DepthStencilState.FrontFace = desc.DepthStencilState.FrontFace;
+    graphicsDesc.DepthStencilState.BackFace = desc.DepthStencilState.BackFace;
+    // no DepthBoundsTestEnable
+  }
+  graphicsDesc.InputLayout = desc.InputLayout;
+  graphicsDesc.IBStripCutValue = desc.IBStripCutValue;
+  graphicsDesc.PrimitiveTopologyType = desc.PrimitiveTopologyType;
+  graphicsDesc.NumRenderTargets = desc.RTVFormats.NumRenderTargets;
+  memcpy(graphicsDesc.RTVFormats, desc.RTVFormats.RTFormats, 8 * sizeof(DXGI_FORMAT));
+  graphicsDesc.DSVFormat = desc.DSVFormat;
+  graphicsDesc.SampleDesc = desc.SampleDesc;
+  graphicsDesc.NodeMask = desc.NodeMask;
+  graphicsDesc.CachedPSO = desc.CachedPSO;
+  graphicsDesc.Flags = desc.Flags;
+  return graphicsDesc;
+}
+
 HRESULT WrappedID3D12Device::CreatePipeState(D3D12_EXPANDED_PIPELINE_STATE_STREAM_DESC &desc,
                                              ID3D12PipelineState **state)
 {
@@ -1941,53 +2100,97 @@ HRESULT WrappedID3D12Device::CreatePipeState(D3D12_EXPANDED_PIPELINE_STATE_STREA
 
   if(desc.CS.BytecodeLength > 0)
   {
-    D3D12_COMPUTE_PIPELINE_STATE_DESC compDesc;
-    compDesc.pRootSignature = desc.pRootSignature;
-    compDesc.CS = desc.CS;
-    compDesc.NodeMask = desc.NodeMask;
-    compDesc.CachedPSO = desc.CachedPSO;
-    compDesc.Flags = desc.Flags;
+    D3D12_COMPUTE_PIPELINE_STATE_DESC compDesc = MakeComputeDesc(desc);
     return CreateComputePipelineState(&compDesc, __uuidof(ID3D12PipelineState), (void **)state);
   }
   else
   {
-    D3D12_GRAPHICS_PIPELINE_STATE_DESC graphicsDesc;
-    graphicsDesc.pRootSignature = desc.pRootSignature;
-    graphicsDesc.VS = desc.VS;
-    graphicsDesc.PS = desc.PS;
-    graphicsDesc.DS = desc.DS;
-    graphicsDesc.HS = desc.HS;
-    graphicsDesc.GS = desc.GS;
-    graphicsDesc.StreamOutput = desc.StreamOutput;
-    graphicsDesc.BlendState = desc.BlendState;
-    graphicsDesc.SampleMask = desc.SampleMask;
-    graphicsDesc.RasterizerState = desc.RasterizerState;
-    // graphicsDesc.DepthStencilState = desc.DepthStencilState;
-    {
-      graphicsDesc.DepthStencilState.DepthEnable = desc.DepthStencilState.DepthEnable;
-      graphicsDesc.DepthStencilState.DepthWriteMask = desc.DepthStencilState.DepthWriteMask;
-      graphicsDesc.DepthStencilState.DepthFunc = desc.DepthStencilState.DepthFunc;
-      graphicsDesc.DepthStencilState.StencilEnable = desc.DepthStencilState.StencilEnable;
-      graphicsDesc.DepthStencilState.StencilReadMask = desc.DepthStencilState.StencilReadMask;
-      graphicsDesc.DepthStencilState.StencilWriteMask = desc.DepthStencilState.StencilWriteMask;
-      graphicsDesc.DepthStencilState.FrontFace = desc.DepthStencilState.FrontFace;
-      graphicsDesc.DepthStencilState.BackFace = desc.DepthStencilState.BackFace;
-      // no DepthBoundsTestEnable
-    }
-    graphicsDesc.InputLayout = desc.InputLayout;
-    graphicsDesc.IBStripCutValue = desc.IBStripCutValue;
-    graphicsDesc.PrimitiveTopologyType = desc.PrimitiveTopologyType;
-    graphicsDesc.NumRenderTargets = desc.RTVFormats.NumRenderTargets;
-    memcpy(graphicsDesc.RTVFormats, desc.RTVFormats.RTFormats, 8 * sizeof(DXGI_FORMAT));
-    graphicsDesc.DSVFormat = desc.DSVFormat;
-    graphicsDesc.SampleDesc = desc.SampleDesc;
-    graphicsDesc.NodeMask = desc.NodeMask;
-    graphicsDesc.CachedPSO = desc.CachedPSO;
-    graphicsDesc.Flags = desc.Flags;
+    D3D12_GRAPHICS_PIPELINE_STATE_DESC graphicsDesc = MakeGraphicsDesc(desc);
     return CreateGraphicsPipelineState(&graphicsDesc, __uuidof(ID3D12PipelineState), (void **)state);
   }
 }
 
+bool WrappedID3D12Device::CreateDeferredPipelines()
+{
+  // anything created after this point compiles inline again - mid-frame creations can be
+  // referenced by the very next chunk in the frame
+  m_DeferPipelineCompiles = false;
+
+  if(m_DeferredPipelines.empty())
+    return true;
+
+  RDCLOG("Creating %zu deferred pipeline states", m_DeferredPipelines.size());
+
+  std::vector<ID3D12PipelineState *> results;
+  results.resize(m_DeferredPipelines.size());
+
+  volatile int32_t failures = 0;
+
+  Threading::TaskGroup creates;
+
+  for(size_t i = 0; i < m_DeferredPipelines.size(); i++)
+  {
+    WrappedID3D12PipelineState *pipe = m_DeferredPipelines[i];
+    ID3D12PipelineState **result = &results[i];
+
+    // the runtime and drivers support fully concurrent PSO creation, so one task per pipeline
+    Threading::TaskPool::Instance().Submit(creates, [this, pipe, result, &failures]() {
+      HRESULT hr = E_FAIL;
+
+      if(pipe->compute)
+      {
+        D3D12_COMPUTE_PIPELINE_STATE_DESC compDesc = MakeComputeDesc(*pipe->compute);
+
+        // the stored desc points the shader at the deduplicated ShaderEntry wrapper - point it
+        // back at the real bytecode, and unwrap the root signature
+        compDesc.CS = pipe->CS()->GetDesc();
+        compDesc.pRootSignature = Unwrap(compDesc.pRootSignature);
+
+        hr = m_pDevice->CreateComputePipelineState(&compDesc, __uuidof(ID3D12PipelineState),
+                                                   (void **)result);
+      }
+      else
+      {
+        D3D12_GRAPHICS_PIPELINE_STATE_DESC graphicsDesc = MakeGraphicsDesc(*pipe->graphics);
+
+        D3D12_SHADER_BYTECODE *shaders[] = {
+            &graphicsDesc.VS, &graphicsDesc.HS, &graphicsDesc.DS,
+            &graphicsDesc.GS, &graphicsDesc.PS,
+        };
+
+        for(size_t s = 0; s < ARRAY_COUNT(shaders); s++)
+        {
+          WrappedID3D12Shader *entry = (WrappedID3D12Shader *)shaders[s]->pShaderBytecode;
+
+          if(entry)
+            *shaders[s] = entry->GetDesc();
+        }
+
+        graphicsDesc.pRootSignature = Unwrap(graphicsDesc.pRootSignature);
+
+        hr = m_pDevice->CreateGraphicsPipelineState(&graphicsDesc, __uuidof(ID3D12PipelineState),
+                                                    (void **)result);
+      }
+
+      if(FAILED(hr))
+      {
+        RDCERR("Failed creating deferred pipeline state, HRESULT: %s", ToStr(hr).c_str());
+        Atomic::Inc32(&failures);
+      }
+    });
+  }
+
+  Threading::TaskPool::Instance().Wait(creates);
+
+  // install the real PSOs on the main thread, since wrapper registration isn't thread safe
+  for(size_t i = 0; i < m_DeferredPipelines.size(); i++)
+    m_DeferredPipelines[i]->SetNewReal(results[i]);
+
+  m_DeferredPipelines.clear();
+
+  return Atomic::CmpExch32(&failures, 0, 0) == 0;
+}
+
 void WrappedID3D12Device::AddDebugMessage(MessageCategory c, MessageSeverity sv, MessageSource src,
                                           std::string d)
 {
@@ -2022,6 +2225,10 @@ void WrappedID3D12Device::AddDebugMessage(MessageCategory c, MessageSeverity sv,
 
 void WrappedID3D12Device::AddDebugMessage(const DebugMessage &msg)
 {
+  // drop duplicate messages re-triggered by scrubbing around the frame
+  if(IsActiveReplaying(m_State) && !m_ReportedDebugMessages.insert(msg).second)
+    return;
+
   m_DebugMessages.push_back(msg);
 }
 
@@ -2437,9 +2644,6 @@ void WrappedID3D12Device::CreateInternalResources()
   if(m_ShaderCache == NULL)
     m_ShaderCache = new D3D12ShaderCache();
 
-  if(m_TextRenderer == NULL)
-    m_TextRenderer = new D3D12TextRenderer(this);
-
   m_Replay.CreateResources();
 
   WrappedID3D12Shader::InternalResources(false);
@@ -2804,6 +3008,10 @@ ReplayStatus WrappedID3D12Device::ReadLogInitialisation(RDCFile *rdc, bool store
   ser.SetStringDatabase(&m_StringDB);
   ser.SetUserData(GetResourceManager());
 
+  // the chunk storage is the memory-mapped file which outlives replay, so strings and buffers
+  // can be deserialised as borrowed views instead of copies. No-op for compressed captures.
+  ser.EnableBorrowedViews(true);
+
   ser.ConfigureStructuredExport(&GetChunkName, storeStructuredBuffers);
 
   m_StructuredFile = &ser.GetStructuredFile();
@@ -2812,6 +3020,10 @@ ReplayStatus WrappedID3D12Device::ReadLogInitialisation(RDCFile *rdc, bool store
 
   ser.SetVersion(m_SectionVersion);
 
+  // batch the driver PSO compiles from the creation chunks across the task pool rather than
+  // serialising them on this thread - flushed before the captured frame is replayed
+  m_DeferPipelineCompiles = true;
+
   int chunkIdx = 0;
 
   struct chunkinfo
@@ -2872,6 +3084,11 @@ ReplayStatus WrappedID3D12Device::ReadLogInitialisation(RDCFile *rdc, bool store
 
       m_Queue->SetFrameReader(new StreamReader(reader, frameDataSize));
 
+      // every creation chunk has been processed - create the deferred PSOs before the frame
+      // capture references them
+      if(!CreateDeferredPipelines())
+        return m_FailedReplayStatus;
+
       if(!IsStructuredExporting(m_State))
         ApplyInitialContents();
 
@@ -2980,6 +3197,10 @@ void WrappedID3D12Device::ReplayLog(uint32_t startEventID, uint32_t endEventID,
 
     ExecuteLists();
     FlushLists(true);
+
+    // the copies have finished on the GPU, so the staging resources can leave GPU memory until
+    // the next full replay applies them again
+    GetResourceManager()->SetInitialContentsResidency(false);
   }
 
   m_State = CaptureState::ActiveReplaying;
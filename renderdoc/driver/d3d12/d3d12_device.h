@@ -26,6 +26,7 @@
 
 #include <stdint.h>
 #include <map>
+#include <set>
 #include "api/replay/renderdoc_replay.h"
 #include "common/threading.h"
 #include "common/timing.h"
@@ -46,7 +47,7 @@ struct D3D12InitParams
   D3D_FEATURE_LEVEL MinimumFeatureLevel;
 
   // check if a frame capture section version is supported
-  static const uint64_t CurrentVersion = 0x6;
+  static const uint64_t CurrentVersion = 0x7;
 
   static bool IsSupportedVersion(uint64_t ver);
 };
@@ -55,6 +56,7 @@ DECLARE_REFLECTION_STRUCT(D3D12InitParams);
 
 class WrappedID3D12Device;
 class WrappedID3D12Resource1;
+class WrappedID3D12PipelineState;
 
 class D3D12TextRenderer;
 class D3D12ShaderCache;
@@ -324,6 +326,14 @@ private:
   set<ResourceId> m_UploadResourceIds;
   std::map<uint64_t, ID3D12Resource *> m_UploadBuffers;
 
+  // shared persistently-mapped upload buffers that replay initial-contents data is sub-allocated
+  // from - see AllocInitialStateContents(). Each sub-allocation hands out a reference owned by the
+  // initial contents entry, the list's own references are released at shutdown.
+  std::vector<ID3D12Resource *> m_InitialContentsBuffers;
+  ID3D12Resource *m_InitialContentsCurBuf = NULL;
+  byte *m_InitialContentsCurMap = NULL;
+  uint64_t m_InitialContentsCurOffset = 0;
+
   Threading::CriticalSection m_MapsLock;
   vector<MapState> m_Maps;
 
@@ -350,6 +360,8 @@ private:
   vector<TempMem *> m_ThreadTempMem;
 
   vector<DebugMessage> m_DebugMessages;
+  // unique messages seen during active replay, used to drop duplicates re-triggered by scrubbing
+  std::set<DebugMessage> m_ReportedDebugMessages;
 
   SDFile *m_StructuredFile = NULL;
   SDFile m_StoredStructuredData;
@@ -361,6 +373,12 @@ private:
 
   ReplayStatus m_FailedReplayStatus = ReplayStatus::APIReplayFailed;
 
+  // while the initial creation chunks are processed during load, pipeline state wrappers are
+  // created empty and their driver compiles batched across the task pool, flushed by
+  // CreateDeferredPipelines before the captured frame is replayed.
+  bool m_DeferPipelineCompiles = false;
+  std::vector<WrappedID3D12PipelineState *> m_DeferredPipelines;
+
   bool m_AppControlledCapture;
 
   Threading::RWLock m_CapTransitionLock;
@@ -454,6 +472,7 @@ public:
   static std::string GetChunkName(uint32_t idx);
   D3D12ResourceManager *GetResourceManager() { return m_ResourceManager; }
   D3D12ShaderCache *GetShaderCache() { return m_ShaderCache; }
+  D3D12TextRenderer *GetTextRenderer();
   D3D12DebugManager *GetDebugManager() { return m_Replay.GetDebugManager(); }
   ResourceId GetResourceID() { return m_ResourceID; }
   Threading::RWLock &GetCapTransitionLock() { return m_CapTransitionLock; }
@@ -543,6 +562,11 @@ public:
   ID3D12GraphicsCommandList4 *GetInitialStateList();
   void CloseInitialStateList();
   ID3D12Resource *GetUploadBuffer(uint64_t chunkOffset, uint64_t byteSize);
+  // sub-allocates space for replay initial-contents data in a shared persistently-mapped upload
+  // buffer, instead of a dedicated committed resource per initial state. Returns the mapped CPU
+  // pointer to fill, and the buffer (with a new reference the caller owns) and byte offset to
+  // copy from on the GPU. Returns NULL on failure.
+  byte *AllocInitialStateContents(uint64_t byteSize, ID3D12Resource *&buf, uint64_t &offset);
   void ApplyInitialContents();
 
   void AddCaptureSubmission();
@@ -701,6 +725,10 @@ public:
   HRESULT CreatePipeState(D3D12_EXPANDED_PIPELINE_STATE_STREAM_DESC &desc,
                           ID3D12PipelineState **state);
 
+  // batch-creates the real PSOs for wrappers whose compile was deferred during load, across the
+  // task pool. Returns false if any creation failed.
+  bool CreateDeferredPipelines();
+
   // Resource
   IMPLEMENT_FUNCTION_THREAD_SERIALISED(void, SetName, ID3D12DeviceChild *pResource, const char *Name);
   IMPLEMENT_FUNCTION_THREAD_SERIALISED(HRESULT, SetShaderDebugPath, ID3D12DeviceChild *pResource,
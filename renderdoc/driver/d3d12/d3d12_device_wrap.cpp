@@ -379,7 +379,13 @@ bool WrappedID3D12Device::Serialise_CreateGraphicsPipelineState(
     unwrappedDesc.pRootSignature = Unwrap(unwrappedDesc.pRootSignature);
 
     ID3D12PipelineState *ret = NULL;
-    HRESULT hr = m_pDevice->CreateGraphicsPipelineState(&unwrappedDesc, guid, (void **)&ret);
+    HRESULT hr = S_OK;
+
+    // during load the driver compile is deferred and batched across the task pool, so creation
+    // chunks don't serialise on it. The wrapper is created empty and the real PSO installed by
+    // CreateDeferredPipelines before the captured frame is replayed.
+    if(!m_DeferPipelineCompiles)
+      hr = m_pDevice->CreateGraphicsPipelineState(&unwrappedDesc, guid, (void **)&ret);
 
     if(FAILED(hr))
     {
@@ -461,6 +467,9 @@ bool WrappedID3D12Device::Serialise_CreateGraphicsPipelineState(
         wrapped->graphics->StreamOutput.pBufferStrides = NULL;
       }
 
+      if(m_DeferPipelineCompiles)
+        m_DeferredPipelines.push_back(wrapped);
+
       GetResourceManager()->AddLiveResource(pPipelineState, ret);
     }
   }
@@ -595,7 +604,12 @@ bool WrappedID3D12Device::Serialise_CreateComputePipelineState(
     unwrappedDesc.pRootSignature = Unwrap(unwrappedDesc.pRootSignature);
 
     ID3D12PipelineState *ret = NULL;
-    HRESULT hr = m_pDevice->CreateComputePipelineState(&unwrappedDesc, guid, (void **)&ret);
+    HRESULT hr = S_OK;
+
+    // as with graphics pipelines, defer the driver compile during load. See
+    // CreateDeferredPipelines.
+    if(!m_DeferPipelineCompiles)
+      hr = m_pDevice->CreateComputePipelineState(&unwrappedDesc, guid, (void **)&ret);
 
     if(FAILED(hr))
     {
@@ -621,6 +635,9 @@ bool WrappedID3D12Device::Serialise_CreateComputePipelineState(
 
       wrapped->compute->CS.pShaderBytecode = entry;
 
+      if(m_DeferPipelineCompiles)
+        m_DeferredPipelines.push_back(wrapped);
+
       GetResourceManager()->AddLiveResource(pPipelineState, ret);
     }
   }
@@ -408,51 +408,186 @@ bool D3D12ResourceManager::Serialise_InitialState(SerialiserType &ser, ResourceI
     D3D12Descriptor *Descriptors = initial ? initial->descriptors : NULL;
     uint32_t numElems = initial ? initial->numDescriptors : 0;
 
-    SERIALISE_ELEMENT_ARRAY(Descriptors, numElems);
-    SERIALISE_ELEMENT(numElems);
+    // gate purely on the serialised version, so structured export of old captures also takes the
+    // old format path - the capture state there isn't replaying
+    if(ser.IsReading() && m_Device->GetLogVersion() < 0x7)
+    {
+      // old format: one array covering every descriptor in the heap
 
-    SERIALISE_CHECK_READ_ERRORS();
+      SERIALISE_ELEMENT_ARRAY(Descriptors, numElems);
+      SERIALISE_ELEMENT(numElems);
 
-    if(IsReplayingAndReading())
-    {
-      WrappedID3D12DescriptorHeap *heap = (WrappedID3D12DescriptorHeap *)GetLiveResource(id);
+      SERIALISE_CHECK_READ_ERRORS();
+
+      if(IsReplayingAndReading())
+      {
+        WrappedID3D12DescriptorHeap *heap = (WrappedID3D12DescriptorHeap *)GetLiveResource(id);
+
+        D3D12_DESCRIPTOR_HEAP_DESC desc = heap->GetDesc();
+
+        // this heap doesn't have to be shader visible, we just use it to copy from
+        desc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
+
+        ID3D12DescriptorHeap *copyheap = NULL;
+        HRESULT hr = m_Device->GetReal()->CreateDescriptorHeap(
+            &desc, __uuidof(ID3D12DescriptorHeap), (void **)&copyheap);
+
+        if(FAILED(hr))
+        {
+          RDCERR("Failed to create CPU descriptor heap for initial state: HRESULT: %s",
+                 ToStr(hr).c_str());
+          return false;
+        }
+
+        if(Descriptors == NULL)
+        {
+          RDCERR("Failed to correctly serialise descriptor heap initial state");
+          return false;
+        }
 
-      D3D12_DESCRIPTOR_HEAP_DESC desc = heap->GetDesc();
+        copyheap = new WrappedID3D12DescriptorHeap(copyheap, m_Device, desc);
 
-      // this heap doesn't have to be shader visible, we just use it to copy from
-      desc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
+        D3D12_CPU_DESCRIPTOR_HANDLE handle = copyheap->GetCPUDescriptorHandleForHeapStart();
 
-      ID3D12DescriptorHeap *copyheap = NULL;
-      HRESULT hr = m_Device->GetReal()->CreateDescriptorHeap(&desc, __uuidof(ID3D12DescriptorHeap),
-                                                             (void **)&copyheap);
+        UINT increment = m_Device->GetDescriptorHandleIncrementSize(desc.Type);
 
-      if(FAILED(hr))
+        for(uint32_t i = 0; i < RDCMIN(numElems, desc.NumDescriptors); i++)
+        {
+          Descriptors[i].Create(desc.Type, m_Device, handle);
+
+          handle.ptr += increment;
+        }
+
+        SetInitialContents(id, D3D12InitialContents(copyheap));
+      }
+    }
+    else
+    {
+      // descriptors that were never written since the heap was created are still Undefined, and
+      // large ring heaps are often mostly untouched, so only runs of defined descriptors are
+      // serialised. Anything not covered by a range is initialised to the same null views as on
+      // the capture side.
+
+      SERIALISE_ELEMENT(numElems);
+
+      std::vector<std::pair<uint32_t, uint32_t>> ranges;
+
+      if(ser.IsWriting())
       {
-        RDCERR("Failed to create CPU descriptor heap for initial state: HRESULT: %s",
-               ToStr(hr).c_str());
-        return false;
+        // merge runs separated by small gaps, so a fragmented heap doesn't produce a huge range
+        // list - a few stray undefined descriptors serialise smaller than an extra range.
+        const uint32_t mergeDistance = 64;
+
+        for(uint32_t i = 0; i < numElems; i++)
+        {
+          if(Descriptors[i].GetType() == D3D12DescriptorType::Undefined)
+            continue;
+
+          if(!ranges.empty() && i - (ranges.back().first + ranges.back().second) < mergeDistance)
+            ranges.back().second = i - ranges.back().first + 1;
+          else
+            ranges.push_back({i, 1});
+        }
       }
 
-      if(Descriptors == NULL)
+      uint32_t NumRanges = (uint32_t)ranges.size();
+      SERIALISE_ELEMENT(NumRanges);
+
+      WrappedID3D12DescriptorHeap *copyheap = NULL;
+      D3D12_DESCRIPTOR_HEAP_DESC desc = {};
+      UINT increment = 0;
+      D3D12_CPU_DESCRIPTOR_HANDLE base = {};
+
+      // default descriptor used to fill the gaps between ranges on replay
+      D3D12Descriptor defaultDescriptor;
+      defaultDescriptor.Setup(NULL, 0);
+
+      // the next descriptor index that still needs its default state created
+      uint32_t nextDefault = 0;
+
+      if(IsReplayingAndReading())
       {
-        RDCERR("Failed to correctly serialise descriptor heap initial state");
-        return false;
+        WrappedID3D12DescriptorHeap *heap = (WrappedID3D12DescriptorHeap *)GetLiveResource(id);
+
+        desc = heap->GetDesc();
+
+        // this heap doesn't have to be shader visible, we just use it to copy from
+        desc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
+
+        ID3D12DescriptorHeap *realheap = NULL;
+        HRESULT hr = m_Device->GetReal()->CreateDescriptorHeap(
+            &desc, __uuidof(ID3D12DescriptorHeap), (void **)&realheap);
+
+        if(FAILED(hr))
+        {
+          RDCERR("Failed to create CPU descriptor heap for initial state: HRESULT: %s",
+                 ToStr(hr).c_str());
+          ret = false;
+        }
+        else
+        {
+          copyheap = new WrappedID3D12DescriptorHeap(realheap, m_Device, desc);
+
+          base = copyheap->GetCPUDescriptorHandleForHeapStart();
+          increment = m_Device->GetDescriptorHandleIncrementSize(desc.Type);
+        }
       }
 
-      copyheap = new WrappedID3D12DescriptorHeap(copyheap, m_Device, desc);
+      for(uint32_t r = 0; r < NumRanges; r++)
+      {
+        uint32_t RangeOffset = 0;
+        uint32_t RangeCount = 0;
+        D3D12Descriptor *RangeDescriptors = NULL;
+
+        if(ser.IsWriting())
+        {
+          RangeOffset = ranges[r].first;
+          RangeCount = ranges[r].second;
+          RangeDescriptors = Descriptors + RangeOffset;
+        }
 
-      D3D12_CPU_DESCRIPTOR_HANDLE handle = copyheap->GetCPUDescriptorHandleForHeapStart();
+        SERIALISE_ELEMENT(RangeOffset);
+        SERIALISE_ELEMENT_ARRAY(RangeDescriptors, RangeCount);
+        SERIALISE_ELEMENT(RangeCount);
 
-      UINT increment = m_Device->GetDescriptorHandleIncrementSize(desc.Type);
+        if(IsReplayingAndReading() && copyheap && RangeDescriptors)
+        {
+          // bring everything before this range up to its default state
+          for(; nextDefault < RDCMIN(RangeOffset, desc.NumDescriptors); nextDefault++)
+          {
+            D3D12_CPU_DESCRIPTOR_HANDLE handle = base;
+            handle.ptr += nextDefault * increment;
+            defaultDescriptor.Create(desc.Type, m_Device, handle);
+          }
 
-      for(uint32_t i = 0; i < RDCMIN(numElems, desc.NumDescriptors); i++)
+          for(uint32_t i = 0; i < RangeCount && RangeOffset + i < desc.NumDescriptors; i++)
+          {
+            D3D12_CPU_DESCRIPTOR_HANDLE handle = base;
+            handle.ptr += (RangeOffset + i) * increment;
+            RangeDescriptors[i].Create(desc.Type, m_Device, handle);
+          }
+
+          nextDefault = RDCMAX(nextDefault, RDCMIN(RangeOffset + RangeCount, desc.NumDescriptors));
+        }
+      }
+
+      SERIALISE_CHECK_READ_ERRORS();
+
+      if(IsReplayingAndReading() && copyheap)
       {
-        Descriptors[i].Create(desc.Type, m_Device, handle);
+        // default-initialise the tail of the heap after the last range
+        for(; nextDefault < desc.NumDescriptors; nextDefault++)
+        {
+          D3D12_CPU_DESCRIPTOR_HANDLE handle = base;
+          handle.ptr += nextDefault * increment;
+          defaultDescriptor.Create(desc.Type, m_Device, handle);
+        }
 
-        handle.ptr += increment;
+        SetInitialContents(id, D3D12InitialContents(copyheap));
       }
 
-      SetInitialContents(id, D3D12InitialContents(copyheap));
+      if(!ret)
+        return false;
     }
   }
   else if(type == Resource_Resource)
@@ -462,6 +597,10 @@ bool D3D12ResourceManager::Serialise_InitialState(SerialiserType &ser, ResourceI
     byte *dummy = NULL;
     ID3D12Resource *mappedBuffer = NULL;
 
+    // on replay, the shared upload buffer space the contents were serialised into
+    ID3D12Resource *copySrc = NULL;
+    uint64_t copySrcOffset = 0;
+
     ID3D12Resource *liveRes = NULL;
 
     if(IsReplayingAndReading())
@@ -508,8 +647,6 @@ bool D3D12ResourceManager::Serialise_InitialState(SerialiserType &ser, ResourceI
     // only map on replay if we haven't encountered any errors so far
     if(IsReplayingAndReading() && !ser.IsErrored())
     {
-      D3D12_RESOURCE_DESC resDesc = liveRes->GetDesc();
-
       D3D12_HEAP_PROPERTIES heapProps = {};
       liveRes->GetHeapProperties(&heapProps, NULL);
 
@@ -518,8 +655,6 @@ bool D3D12ResourceManager::Serialise_InitialState(SerialiserType &ser, ResourceI
         // if destination is on the upload heap, it's impossible to copy via the device,
         // so we have to CPU copy. To save time and make a more optimal copy, we just keep the data
         // CPU-side
-        mappedBuffer = NULL;
-
         D3D12InitialContents initContents(D3D12InitialContents::Copy);
         ResourceContents = initContents.srcData = AllocAlignedBuffer(RDCMAX(ContentsLength, 64ULL));
         initContents.resourceType = Resource_Resource;
@@ -527,53 +662,15 @@ bool D3D12ResourceManager::Serialise_InitialState(SerialiserType &ser, ResourceI
       }
       else
       {
-        // create an upload buffer to contain the contents
-        heapProps.Type = D3D12_HEAP_TYPE_UPLOAD;
-        heapProps.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
-        heapProps.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
-        heapProps.CreationNodeMask = 1;
-        heapProps.VisibleNodeMask = 1;
-
-        D3D12_RESOURCE_DESC desc;
-        desc.Alignment = 0;
-        desc.DepthOrArraySize = 1;
-        desc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
-        desc.Flags = D3D12_RESOURCE_FLAG_NONE;
-        desc.Format = DXGI_FORMAT_UNKNOWN;
-        desc.Height = 1;
-        desc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
-        desc.MipLevels = 1;
-        desc.SampleDesc.Count = 1;
-        desc.SampleDesc.Quality = 0;
-        desc.Width = RDCMAX(ContentsLength, 64ULL);
-
-        ID3D12Resource *copySrc = NULL;
-        HRESULT hr = m_Device->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &desc,
-                                                       D3D12_RESOURCE_STATE_GENERIC_READ, NULL,
-                                                       __uuidof(ID3D12Resource), (void **)&copySrc);
-
-        if(SUCCEEDED(hr))
-        {
-          mappedBuffer = copySrc;
-
-          // map the upload buffer to serialise into
-          hr = copySrc->Map(0, NULL, (void **)&ResourceContents);
+        // sub-allocate space in a shared upload buffer to contain the contents, and serialise
+        // directly into its persistent map. The buffer stays mapped so there's no Unmap below.
+        ResourceContents = m_Device->AllocInitialStateContents(RDCMAX(ContentsLength, 64ULL),
+                                                               copySrc, copySrcOffset);
 
-          if(FAILED(hr))
-          {
-            RDCERR("Created but couldn't map upload buffer: %s", ToStr(hr).c_str());
-            ret = false;
-            SAFE_RELEASE(copySrc);
-            mappedBuffer = NULL;
-            ResourceContents = NULL;
-          }
-        }
-        else
+        if(ResourceContents == NULL)
         {
-          RDCERR("Couldn't create upload buffer: %s", ToStr(hr).c_str());
+          RDCERR("Couldn't allocate upload space for initial contents");
           ret = false;
-          mappedBuffer = NULL;
-          ResourceContents = NULL;
         }
       }
 
@@ -593,11 +690,13 @@ bool D3D12ResourceManager::Serialise_InitialState(SerialiserType &ser, ResourceI
 
     SERIALISE_CHECK_READ_ERRORS();
 
-    if(IsReplayingAndReading() && mappedBuffer)
+    if(IsReplayingAndReading() && copySrc)
     {
       D3D12InitialContents initContents(D3D12InitialContents::Copy);
       initContents.resourceType = Resource_Resource;
-      initContents.resource = mappedBuffer;
+      initContents.resource = copySrc;
+      initContents.resourceOffset = copySrcOffset;
+      initContents.dataSize = (size_t)ContentsLength;
 
       D3D12_RESOURCE_DESC resDesc = liveRes->GetDesc();
 
@@ -609,7 +708,7 @@ bool D3D12ResourceManager::Serialise_InitialState(SerialiserType &ser, ResourceI
         {
           // backwards compatibility - older captures will have no data for MSAA textures.
           initContents.resource = NULL;
-          SAFE_RELEASE(mappedBuffer);
+          SAFE_RELEASE(copySrc);
         }
         else
         {
@@ -674,8 +773,8 @@ bool D3D12ResourceManager::Serialise_InitialState(SerialiserType &ser, ResourceI
             D3D12_PLACED_SUBRESOURCE_FOOTPRINT *layouts =
                 new D3D12_PLACED_SUBRESOURCE_FOOTPRINT[numSubresources];
 
-            m_Device->GetCopyableFootprints(&arrayDesc, 0, numSubresources, 0, layouts, NULL, NULL,
-                                            NULL);
+            m_Device->GetCopyableFootprints(&arrayDesc, 0, numSubresources, copySrcOffset, layouts,
+                                            NULL, NULL, NULL);
 
             for(UINT i = 0; i < numSubresources; i++)
             {
@@ -686,7 +785,7 @@ bool D3D12ResourceManager::Serialise_InitialState(SerialiserType &ser, ResourceI
               dst.SubresourceIndex = i;
 
               src.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
-              src.pResource = Unwrap(mappedBuffer);
+              src.pResource = Unwrap(copySrc);
               src.PlacedFootprint = layouts[i];
 
               // copy buffer into this array slice
@@ -732,9 +831,10 @@ bool D3D12ResourceManager::Serialise_InitialState(SerialiserType &ser, ResourceI
 
           // subsequent copy comes from msaa texture
           initContents.resource = msaaTex;
+          initContents.resourceOffset = 0;
 
-          // we can release the buffer now, and the temporary array texture
-          SAFE_RELEASE(mappedBuffer);
+          // we can release the upload space now, and the temporary array texture
+          SAFE_RELEASE(copySrc);
           SAFE_RELEASE(arrayTex);
         }
       }
@@ -781,6 +881,56 @@ void D3D12ResourceManager::Create_InitialState(ResourceId id, ID3D12DeviceChild
   }
 }
 
+void D3D12ResourceManager::SetInitialContentsResidency(bool resident)
+{
+  std::vector<ID3D12Pageable *> pageables;
+
+  for(auto it = m_InitialContents.begin(); it != m_InitialContents.end(); ++it)
+  {
+    const D3D12InitialContents &data = it->second.data;
+
+    // only the GPU staging copies - CPU-side data and descriptor heaps don't occupy GPU memory
+    if(data.resourceType != Resource_Resource || data.tag != D3D12InitialContents::Copy)
+      continue;
+
+    ID3D12Resource *staging = (ID3D12Resource *)data.resource;
+
+    if(staging)
+      pageables.push_back(Unwrap(staging));
+  }
+
+  if(pageables.empty())
+    return;
+
+  // many initial contents share the same upload buffer, but its residency must only be changed
+  // once
+  std::sort(pageables.begin(), pageables.end());
+  pageables.erase(std::unique(pageables.begin(), pageables.end()), pageables.end());
+
+  HRESULT hr;
+
+  if(resident)
+    hr = m_Device->GetReal()->MakeResident((UINT)pageables.size(), pageables.data());
+  else
+    hr = m_Device->GetReal()->Evict((UINT)pageables.size(), pageables.data());
+
+  if(FAILED(hr))
+    RDCERR("Failed to %s %zu initial contents resources: HRESULT: %s",
+           resident ? "make resident" : "evict", pageables.size(), ToStr(hr).c_str());
+}
+
+void D3D12ResourceManager::FlushRestoreBarriers()
+{
+  if(m_DeferredRestoreBarriers.empty())
+    return;
+
+  ID3D12GraphicsCommandList *list = Unwrap(m_Device->GetInitialStateList());
+
+  list->ResourceBarrier((UINT)m_DeferredRestoreBarriers.size(), &m_DeferredRestoreBarriers[0]);
+
+  m_DeferredRestoreBarriers.clear();
+}
+
 void D3D12ResourceManager::Apply_InitialState(ID3D12DeviceChild *live,
                                               const D3D12InitialContents &data)
 {
@@ -940,8 +1090,12 @@ void D3D12ResourceManager::Apply_InitialState(ID3D12DeviceChild *live,
           D3D12_RESOURCE_DESC srcDesc = copySrc->GetDesc();
           D3D12_RESOURCE_DESC dstDesc = copyDst->GetDesc();
 
-          list->CopyBufferRegion(copyDst, 0, Unwrap(copySrc), 0,
-                                 RDCMIN(srcDesc.Width, dstDesc.Width));
+          // the source may be sub-allocated within a shared upload buffer, in which case the
+          // contents length is recorded rather than being the source buffer's whole width
+          UINT64 srcSize = data.dataSize ? (UINT64)data.dataSize : srcDesc.Width;
+
+          list->CopyBufferRegion(copyDst, 0, Unwrap(copySrc), data.resourceOffset,
+                                 RDCMIN(srcSize, dstDesc.Width));
         }
         else if(copyDst->GetDesc().SampleDesc.Count > 1)
         {
@@ -972,7 +1126,8 @@ void D3D12ResourceManager::Apply_InitialState(ID3D12DeviceChild *live,
           D3D12_PLACED_SUBRESOURCE_FOOTPRINT *layouts =
               new D3D12_PLACED_SUBRESOURCE_FOOTPRINT[numSubresources];
 
-          m_Device->GetCopyableFootprints(&desc, 0, numSubresources, 0, layouts, NULL, NULL, NULL);
+          m_Device->GetCopyableFootprints(&desc, 0, numSubresources, data.resourceOffset, layouts,
+                                          NULL, NULL, NULL);
 
           for(UINT i = 0; i < numSubresources; i++)
           {
@@ -992,14 +1147,17 @@ void D3D12ResourceManager::Apply_InitialState(ID3D12DeviceChild *live,
           delete[] layouts;
         }
 
-        // transition back to whatever it was before
+        // transition back to whatever it was before. We don't record these on the list here but
+        // defer them to one batched barrier call after every resource's copies, so the copies all
+        // run back-to-back - nothing reads these resources until the frame replays.
         for(size_t i = 0; i < barriers.size(); i++)
+        {
           std::swap(barriers[i].Transition.StateBefore, barriers[i].Transition.StateAfter);
-
-        if(!barriers.empty())
-          list->ResourceBarrier((UINT)barriers.size(), &barriers[0]);
+          m_DeferredRestoreBarriers.push_back(barriers[i]);
+        }
 
 #if ENABLED(SINGLE_FLUSH_VALIDATE)
+        FlushRestoreBarriers();
         m_Device->CloseInitialStateList();
         m_Device->ExecuteLists(NULL, true);
         m_Device->FlushLists(true);
@@ -29,6 +29,112 @@
 #include "d3d12_device.h"
 #include "d3d12_resources.h"
 
+void GPUAddressRangeTracker::RebuildSnapshot()
+{
+  SCOPED_WRITELOCK(addressLock);
+
+  Snapshot *old = m_Snapshot;
+
+  // another thread might have rebuilt while we waited for the lock
+  if(old && old->generation == m_Generation)
+    return;
+
+  Snapshot *snap = new Snapshot;
+  // no mutator can bump the generation while we hold the write lock
+  snap->generation = m_Generation;
+  snap->ranges = addresses;
+
+  if(!snap->ranges.empty())
+  {
+    // ranges are sorted by descending start address
+    snap->base = snap->ranges.back().start;
+    snap->top = 0;
+    for(size_t i = 0; i < snap->ranges.size(); i++)
+      snap->top = RDCMAX(snap->top, snap->ranges[i].end);
+  }
+
+  if(snap->top > snap->base)
+  {
+    // pick the smallest page size from 4KB upwards that covers the space in at most 64K pages
+    snap->pageShift = 12;
+    while((((snap->top - 1 - snap->base) >> snap->pageShift) + 1) > 0x10000)
+      snap->pageShift++;
+
+    size_t numPages = size_t(((snap->top - 1 - snap->base) >> snap->pageShift) + 1);
+    snap->pages.resize(numPages);
+
+    for(size_t p = 0; p < numPages; p++)
+    {
+      // the first candidate for any address in this page is the first range starting at or below
+      // the last address in the page
+      D3D12_GPU_VIRTUAL_ADDRESS pageEnd =
+          snap->base + (D3D12_GPU_VIRTUAL_ADDRESS(p + 1) << snap->pageShift) - 1;
+
+      snap->pages[p] =
+          uint32_t(std::lower_bound(snap->ranges.begin(), snap->ranges.end(), pageEnd) -
+                   snap->ranges.begin());
+    }
+  }
+
+  m_Snapshot = snap;
+
+  // wait for any lookups still reading the old snapshot to drain before freeing it. Lookups are
+  // just a short scan, and we only get here at all when the ranges changed since the last lookup.
+  // The compare-exchange orders the publish above against the readers' counter increments, so a
+  // lookup that we see finished can only ever pick up the new snapshot.
+  if(old)
+  {
+    while(Atomic::CmpExch32(&m_ActiveLookups, 0, 0) != 0)
+      Threading::Sleep(0);
+
+    delete old;
+  }
+}
+
+void GPUAddressRangeTracker::GetResIDFromAddr(D3D12_GPU_VIRTUAL_ADDRESS addr, ResourceId &id,
+                                              UINT64 &offs)
+{
+  id = ResourceId();
+  offs = 0;
+
+  if(addr == 0)
+    return;
+
+  for(;;)
+  {
+    Atomic::Inc32(&m_ActiveLookups);
+
+    Snapshot *snap = m_Snapshot;
+
+    if(snap && snap->generation == m_Generation)
+    {
+      if(!snap->pages.empty() && addr >= snap->base && addr < snap->top)
+      {
+        size_t p = size_t((addr - snap->base) >> snap->pageShift);
+
+        // scan from the page's first candidate to the first range starting at or below addr -
+        // the same range a lower_bound over the whole sorted vector would find
+        size_t i = snap->pages[p];
+        while(i < snap->ranges.size() && snap->ranges[i].start > addr)
+          i++;
+
+        if(i < snap->ranges.size() && addr >= snap->ranges[i].start && addr < snap->ranges[i].end)
+        {
+          id = snap->ranges[i].id;
+          offs = addr - snap->ranges[i].start;
+        }
+      }
+
+      Atomic::Dec32(&m_ActiveLookups);
+      return;
+    }
+
+    Atomic::Dec32(&m_ActiveLookups);
+
+    RebuildSnapshot();
+  }
+}
+
 void D3D12Descriptor::Init(const D3D12_SAMPLER_DESC *pDesc)
 {
   if(pDesc)
@@ -457,6 +457,7 @@ struct GPUAddressRange
 struct GPUAddressRangeTracker
 {
   GPUAddressRangeTracker() {}
+  ~GPUAddressRangeTracker() { delete m_Snapshot; }
   // no copying
   GPUAddressRangeTracker(const GPUAddressRangeTracker &);
   GPUAddressRangeTracker &operator=(const GPUAddressRangeTracker &);
@@ -470,6 +471,7 @@ struct GPUAddressRangeTracker
     auto it = std::lower_bound(addresses.begin(), addresses.end(), range.start);
 
     addresses.insert(it, range);
+    Atomic::Inc32(&m_Generation);
   }
 
   void RemoveFrom(const GPUAddressRange &range)
@@ -485,6 +487,7 @@ struct GPUAddressRangeTracker
         if(it->id == range.id)
         {
           addresses.erase(it);
+          Atomic::Inc32(&m_Generation);
           return;
         }
 
@@ -495,33 +498,30 @@ struct GPUAddressRangeTracker
     RDCERR("Couldn't find matching range to remove for %s", ToStr(range.id).c_str());
   }
 
-  void GetResIDFromAddr(D3D12_GPU_VIRTUAL_ADDRESS addr, ResourceId &id, UINT64 &offs)
-  {
-    id = ResourceId();
-    offs = 0;
-
-    if(addr == 0)
-      return;
+  void GetResIDFromAddr(D3D12_GPU_VIRTUAL_ADDRESS addr, ResourceId &id, UINT64 &offs);
 
-    GPUAddressRange range;
-
-    // this should really be a read-write lock
-    {
-      SCOPED_READLOCK(addressLock);
-
-      auto it = std::lower_bound(addresses.begin(), addresses.end(), addr);
-      if(it == addresses.end())
-        return;
-
-      range = *it;
-    }
+private:
+  // immutable snapshot of the sorted ranges, plus a flat page index over the covered address
+  // space, so steady-state lookups don't take addressLock at all. Replay resolves millions of
+  // addresses while the ranges only change on resource create/destroy, which just bumps the
+  // generation - the next lookup rebuilds the snapshot.
+  struct Snapshot
+  {
+    int32_t generation = 0;
+    // the address space covered by the ranges, split into equal pages of (1 << pageShift) bytes
+    D3D12_GPU_VIRTUAL_ADDRESS base = 0, top = 0;
+    uint32_t pageShift = 0;
+    // for each page, the position in ranges where a lookup in that page starts scanning
+    std::vector<uint32_t> pages;
+    // same contents and order as addresses - descending start address
+    std::vector<GPUAddressRange> ranges;
+  };
 
-    if(addr < range.start || addr >= range.end)
-      return;
+  void RebuildSnapshot();
 
-    id = range.id;
-    offs = addr - range.start;
-  }
+  Snapshot *volatile m_Snapshot = NULL;
+  volatile int32_t m_Generation = 0;
+  volatile int32_t m_ActiveLookups = 0;
 };
 
 struct MapState
@@ -615,6 +615,7 @@ struct D3D12InitialContents
         descriptors(d),
         numDescriptors(n),
         resource(NULL),
+        resourceOffset(0),
         srcData(NULL),
         dataSize(0)
   {
@@ -625,6 +626,7 @@ struct D3D12InitialContents
         descriptors(NULL),
         numDescriptors(0),
         resource(r),
+        resourceOffset(0),
         srcData(NULL),
         dataSize(0)
   {
@@ -635,6 +637,7 @@ struct D3D12InitialContents
         descriptors(NULL),
         numDescriptors(0),
         resource(r),
+        resourceOffset(0),
         srcData(NULL),
         dataSize(0)
   {
@@ -645,6 +648,7 @@ struct D3D12InitialContents
         descriptors(NULL),
         numDescriptors(0),
         resource(NULL),
+        resourceOffset(0),
         srcData(data),
         dataSize(size)
   {
@@ -655,6 +659,7 @@ struct D3D12InitialContents
         descriptors(NULL),
         numDescriptors(0),
         resource(NULL),
+        resourceOffset(0),
         srcData(NULL),
         dataSize(0)
   {
@@ -665,6 +670,7 @@ struct D3D12InitialContents
         descriptors(NULL),
         numDescriptors(0),
         resource(NULL),
+        resourceOffset(0),
         srcData(NULL),
         dataSize(0)
   {
@@ -681,6 +687,9 @@ struct D3D12InitialContents
   D3D12Descriptor *descriptors;
   uint32_t numDescriptors;
   ID3D12DeviceChild *resource;
+  // for Copy contents sub-allocated into a shared buffer, the byte offset in resource where this
+  // resource's contents begin
+  uint64_t resourceOffset;
   byte *srcData;
   size_t dataSize;
 };
@@ -725,9 +734,19 @@ public:
 
   void SetInternalResource(ID3D12DeviceChild *res);
 
+  void FlushRestoreBarriers();
+
+  void SetInitialContentsResidency(bool resident);
+
 private:
   ResourceId GetID(ID3D12DeviceChild *res);
 
+  // transitions restoring resources to their frame-initial states after an initial-contents copy.
+  // These are deferred and flushed in one batched ResourceBarrier at the end of the whole apply,
+  // so the copies for all resources run back-to-back instead of being separated by per-resource
+  // barriers.
+  std::vector<D3D12_RESOURCE_BARRIER> m_DeferredRestoreBarriers;
+
   bool ResourceTypeRelease(ID3D12DeviceChild *res);
 
   bool Prepare_InitialState(ID3D12DeviceChild *res);
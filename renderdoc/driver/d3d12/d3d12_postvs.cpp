@@ -354,7 +354,7 @@ void D3D12Replay::InitPostVSBuffers(uint32_t eventId)
 
       list = GetDebugManager()->ResetDebugList();
 
-      rs.ApplyState(m_pDevice, list);
+      rs.ApplyState(m_pDevice, list, soSig == NULL);
 
       list->SetPipelineState(pipe);
 
@@ -468,7 +468,7 @@ void D3D12Replay::InitPostVSBuffers(uint32_t eventId)
 
       list = GetDebugManager()->ResetDebugList();
 
-      rs.ApplyState(m_pDevice, list);
+      rs.ApplyState(m_pDevice, list, soSig == NULL);
 
       list->SetPipelineState(pipe);
 
@@ -837,7 +837,7 @@ void D3D12Replay::InitPostVSBuffers(uint32_t eventId)
     {
       list = GetDebugManager()->ResetDebugList();
 
-      rs.ApplyState(m_pDevice, list);
+      rs.ApplyState(m_pDevice, list, soSig == NULL);
 
       list->SetPipelineState(pipe);
 
@@ -927,7 +927,7 @@ void D3D12Replay::InitPostVSBuffers(uint32_t eventId)
         list->ResourceBarrier(1, &sobarr);
       }
 
-      rs.ApplyState(m_pDevice, list);
+      rs.ApplyState(m_pDevice, list, soSig == NULL);
 
       list->SetPipelineState(pipe);
 
@@ -983,7 +983,7 @@ void D3D12Replay::InitPostVSBuffers(uint32_t eventId)
       {
         list = GetDebugManager()->ResetDebugList();
 
-        rs.ApplyState(m_pDevice, list);
+        rs.ApplyState(m_pDevice, list, soSig == NULL);
 
         list->SetPipelineState(pipe);
 
@@ -2870,6 +2870,9 @@ void D3D12Replay::ReplaceResource(ResourceId from, ResourceId to)
     rm->ReplaceResource(from, to);
   }
 
+  // cached baked command lists bind the old pipelines, so throw them away
+  m_pDevice->GetQueue()->GetCommandData()->InvalidateBakedCommandListCache();
+
   ClearPostVSCache();
 }
 
@@ -2906,6 +2909,9 @@ void D3D12Replay::RemoveReplacement(ResourceId id)
     }
   }
 
+  // cached baked command lists bind the replacement pipelines we just destroyed
+  m_pDevice->GetQueue()->GetCommandData()->InvalidateBakedCommandListCache();
+
   ClearPostVSCache();
 }
 
@@ -3705,7 +3711,7 @@ ReplayStatus D3D12_CreateReplayDevice(RDCFile *rdc, IReplayDriver **driver)
 
 static DriverRegistration D3D12DriverRegistration(RDCDriver::D3D12, &D3D12_CreateReplayDevice);
 
-void D3D12_ProcessStructured(RDCFile *rdc, SDFile &output)
+void D3D12_ProcessStructured(RDCFile *rdc, SDFile &output, bool includeBuffers)
 {
   WrappedID3D12Device device(NULL, D3D12InitParams(), false);
 
@@ -3715,7 +3721,7 @@ void D3D12_ProcessStructured(RDCFile *rdc, SDFile &output)
     return;
 
   device.SetStructuredExport(rdc->GetSectionProperties(sectionIdx).version);
-  ReplayStatus status = device.ReadLogInitialisation(rdc, true);
+  ReplayStatus status = device.ReadLogInitialisation(rdc, includeBuffers);
 
   if(status == ReplayStatus::Succeeded)
     device.GetStructuredFile().Swap(output);
@@ -785,6 +785,16 @@ public:
       : WrappedDeviceChild12(real, device)
   {
   }
+
+  // when the driver compile is deferred during load the wrapper is constructed with no real PSO,
+  // and it's installed here once the batched creation completes. See CreateDeferredPipelines.
+  void SetNewReal(ID3D12PipelineState *real)
+  {
+    m_pReal = real;
+
+    if(real)
+      m_pDevice->GetResourceManager()->AddWrapper(this, real);
+  }
   virtual ~WrappedID3D12PipelineState()
   {
     Shutdown();
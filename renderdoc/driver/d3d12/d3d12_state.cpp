@@ -73,7 +73,8 @@ ResourceId D3D12RenderState::GetDSVID() const
   return dsv.GetResResourceId();
 }
 
-void D3D12RenderState::ApplyState(WrappedID3D12Device *dev, ID3D12GraphicsCommandList4 *cmd) const
+void D3D12RenderState::ApplyState(WrappedID3D12Device *dev, ID3D12GraphicsCommandList4 *cmd,
+                                  bool applyGraphicsRoot) const
 {
   D3D12_COMMAND_LIST_TYPE type = cmd->GetType();
 
@@ -120,24 +121,29 @@ void D3D12RenderState::ApplyState(WrappedID3D12Device *dev, ID3D12GraphicsComman
       cmd->IASetIndexBuffer(&ib);
     }
 
-    for(size_t i = 0; i < vbuffers.size(); i++)
+    if(!vbuffers.empty())
     {
-      D3D12_VERTEX_BUFFER_VIEW vb;
-      vb.BufferLocation = 0;
+      // bind all the slots with a single call rather than one per buffer. Empty slots get a
+      // NULL view, which matches the unbound state of the freshly reset lists this state is
+      // applied to.
+      D3D12_VERTEX_BUFFER_VIEW vbs[D3D12_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT] = {};
 
-      if(vbuffers[i].buf != ResourceId())
+      UINT numVBs = RDCMIN((UINT)vbuffers.size(), (UINT)ARRAY_COUNT(vbs));
+
+      for(UINT i = 0; i < numVBs; i++)
       {
+        if(vbuffers[i].buf == ResourceId())
+          continue;
+
         ID3D12Resource *res = GetResourceManager()->GetCurrentAs<ID3D12Resource>(vbuffers[i].buf);
         if(res)
-          vb.BufferLocation = res->GetGPUVirtualAddress() + vbuffers[i].offs;
-        else
-          vb.BufferLocation = 0;
+          vbs[i].BufferLocation = res->GetGPUVirtualAddress() + vbuffers[i].offs;
 
-        vb.StrideInBytes = vbuffers[i].stride;
-        vb.SizeInBytes = vbuffers[i].size;
-
-        cmd->IASetVertexBuffers((UINT)i, 1, &vb);
+        vbs[i].StrideInBytes = vbuffers[i].stride;
+        vbs[i].SizeInBytes = vbuffers[i].size;
       }
+
+      cmd->IASetVertexBuffers(0, numVBs, vbs);
     }
 
     if(!rts.empty() || dsv.GetResResourceId() != ResourceId())
@@ -166,7 +172,7 @@ void D3D12RenderState::ApplyState(WrappedID3D12Device *dev, ID3D12GraphicsComman
   if(!descHeaps.empty())
     cmd->SetDescriptorHeaps((UINT)descHeaps.size(), &descHeaps[0]);
 
-  if(graphics.rootsig != ResourceId())
+  if(applyGraphicsRoot && graphics.rootsig != ResourceId())
   {
     cmd->SetGraphicsRootSignature(
         GetResourceManager()->GetCurrentAs<ID3D12RootSignature>(graphics.rootsig));
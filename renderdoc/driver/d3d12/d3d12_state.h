@@ -46,7 +46,11 @@ struct D3D12RenderState
   D3D12RenderState() = default;
   D3D12RenderState &operator=(const D3D12RenderState &o);
 
-  void ApplyState(WrappedID3D12Device *dev, ID3D12GraphicsCommandList4 *list) const;
+  // applyGraphicsRoot can be set to false by callers that are about to bind their own root
+  // signature, since changing root signature invalidates all the root bindings anyway and
+  // applying them here would just be thrown away.
+  void ApplyState(WrappedID3D12Device *dev, ID3D12GraphicsCommandList4 *list,
+                  bool applyGraphicsRoot = true) const;
   void ApplyComputeRootElements(ID3D12GraphicsCommandList4 *cmd) const;
   void ApplyGraphicsRootElements(ID3D12GraphicsCommandList4 *cmd) const;
 
@@ -43,6 +43,31 @@ argsplit_regex = re.compile('(.*)([\*\s])([a-zA-Z0-9]+)')
 # List of hooks to define, will be filled out when processing the dispatch table header
 hooks = []
 
+# Functions whose driver wrappers are pure passthrough in every capture state - they never
+# serialise a chunk and touch nothing guarded by glLock. These get thin hook wrappers that skip
+# the global lock and current-chunk bookkeeping, since applications poll some of them (glGetError
+# especially) at very high frequency. Only add a function here after checking its WrappedOpenGL
+# wrapper: anything that touches resource records, context data or the serialiser must keep the
+# standard wrapper.
+passthrough_hooks = {
+	'glGetError',
+	'glGetGraphicsResetStatus',
+	'glIsBuffer',
+	'glIsEnabled',
+	'glIsEnabledi',
+	'glIsFramebuffer',
+	'glIsProgram',
+	'glIsProgramPipeline',
+	'glIsQuery',
+	'glIsRenderbuffer',
+	'glIsSampler',
+	'glIsShader',
+	'glIsSync',
+	'glIsTexture',
+	'glIsTransformFeedback',
+	'glIsVertexArray',
+}
+
 # A dict of typedef information
 # Elements contain:
 #   'used':      True if it's used by our definitions or not - False if unsupported
@@ -177,9 +202,11 @@ for hook in hooks:
 	for arg in typedef['args']:
 		arglist += ', {}, {}'.format(arg[0], arg[1])
 
-	f.write('  FuncWrapper{}({}, {}{}); \\\n'.format(num, typedef['return'], hook['name'], arglist))
+	passthrough = 'Passthrough' if hook['name'] in passthrough_hooks else ''
+
+	f.write('  {}FuncWrapper{}({}, {}{}); \\\n'.format(passthrough, num, typedef['return'], hook['name'], arglist))
 	for a in hook['aliases']:
-		f.write('  AliasWrapper{}({}, {}, {}{}); \\\n'.format(num, typedef['return'], a, hook['name'], arglist))
+		f.write('  {}AliasWrapper{}({}, {}, {}{}); \\\n'.format(passthrough, num, typedef['return'], a, hook['name'], arglist))
 		
 f.write("\n\n\n\n")
 
@@ -254,6 +281,30 @@ template = '''
   }} \\
   HOOK_EXPORT ret HOOK_CC function({argdecl});
 
+#define PassthroughFuncWrapper{num}(ret, function{macroargs}) \\
+  ret HOOK_CC CONCAT(function, _renderdoc_hooked)({argdecl}) \\
+  {{ \\
+    UNINIT_CALL(function, {argpass}); \\
+    return glhook.driver->function({argpass}); \\
+  }} \\
+  HOOK_EXPORT ret HOOK_CC GL_EXPORT_NAME(function)({argdecl}) \\
+  {{ \\
+    return CONCAT(function, _renderdoc_hooked)({argpass}); \\
+  }} \\
+  HOOK_EXPORT ret HOOK_CC function({argdecl});
+
+#define PassthroughAliasWrapper{num}(ret, function, realfunc{macroargs}) \\
+  ret HOOK_CC CONCAT(function, _renderdoc_hooked)({argdecl}) \\
+  {{ \\
+    UNINIT_CALL(realfunc, {argpass}); \\
+    return glhook.driver->realfunc({argpass}); \\
+  }} \\
+  HOOK_EXPORT ret HOOK_CC GL_EXPORT_NAME(function)({argdecl}) \\
+  {{ \\
+    return CONCAT(function, _renderdoc_hooked)({argpass}); \\
+  }} \\
+  HOOK_EXPORT ret HOOK_CC function({argdecl});
+
 #define UnsupportedWrapper{num}(ret, function{macroargs}) \\
   typedef ret(HOOK_CC *CONCAT(function, _hooktype))({argdecl}); \\
   CONCAT(function, _hooktype) CONCAT(unsupported_real_, function) = NULL; \\
@@ -38,6 +38,8 @@ GLChunk gl_CurChunk = GLChunk::Max;
 bool HasExt[GLExtension_Count] = {};
 bool VendorCheck[VendorCheck_Count] = {};
 
+bool GLErrorCallbackActive = false;
+
 int GLCoreVersion = 0;
 bool GLIsCore = false;
 bool IsGLES = false;
@@ -1418,6 +1420,9 @@ GLenum ShaderEnum(size_t idx)
 
 void ClearGLErrors()
 {
+  // note the KHR_debug callback reports errors but doesn't consume them from glGetError's queue,
+  // so even when it's active we must still drain here - callers poll glGetError after this and
+  // would otherwise read stale errors from earlier calls.
   int i = 0;
   GLenum err = GL.glGetError();
   while(err)
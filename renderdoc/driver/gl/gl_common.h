@@ -576,6 +576,12 @@ const char *SamplerString(GLenum smpenum);
 
 void ClearGLErrors();
 
+// set during replay when a KHR_debug callback is registered. Errors are then reported to us as
+// they're generated, so poll-and-discard checks can skip glGetError - which can force a sync with
+// the driver's submission thread. The callback doesn't consume errors from the queue though, so
+// ClearGLErrors() still drains it for callers that poll for a specific error afterwards.
+extern bool GLErrorCallbackActive;
+
 GLuint GetBoundVertexBuffer(GLuint idx);
 GLint GetNumVertexBuffers();
 
@@ -700,6 +706,7 @@ extern bool IsGLES;
   EXT_TO_CHECK(40, 32, ARB_texture_cube_map_array)               \
   EXT_TO_CHECK(40, 30, ARB_transform_feedback2)                  \
   EXT_TO_CHECK(32, 32, ARB_geometry_shader4)                     \
+  EXT_TO_CHECK(41, 30, ARB_get_program_binary)                   \
   EXT_TO_CHECK(41, 31, ARB_separate_shader_objects)              \
   EXT_TO_CHECK(41, 99, ARB_viewport_array)                       \
   EXT_TO_CHECK(41, 99, ARB_ES2_compatibility)                    \
@@ -1070,8 +1070,11 @@ void GLReplay::DeleteDebugData()
 
   MakeCurrentReplayContext(&m_ReplayCtx);
 
-  if(DebugData.overlayProg != 0)
-    drv.glDeleteProgram(DebugData.overlayProg);
+  for(auto it = m_OverlayProgs.begin(); it != m_OverlayProgs.end(); ++it)
+    drv.glDeleteProgram(it->second);
+
+  m_OverlayProgs.clear();
+  DebugData.overlayProg = 0;
 
   drv.glDeleteTransformFeedbacks(1, &DebugData.feedbackObj);
   drv.glDeleteBuffers(1, &DebugData.feedbackBuffer);
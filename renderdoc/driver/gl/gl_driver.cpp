@@ -26,6 +26,7 @@
 #include "gl_driver.h"
 #include <algorithm>
 #include "common/common.h"
+#include "common/shader_cache.h"
 #include "driver/shaders/spirv/spirv_common.h"
 #include "jpeg-compressor/jpge.h"
 #include "serialise/rdcfile.h"
@@ -819,10 +820,183 @@ WrappedOpenGL::~WrappedOpenGL()
   for(size_t i = 0; i < m_CtxDataVector.size(); i++)
     delete m_CtxDataVector[i];
 
+  CloseProgramBinaryCache();
+
   if(RenderDoc::Inst().GetCrashHandler())
     RenderDoc::Inst().GetCrashHandler()->UnregisterMemoryRegion(this);
 }
 
+struct GLProgramBinaryCallbacks
+{
+  bool Create(uint32_t size, byte *data, WrappedOpenGL::ProgramBinary **ret) const
+  {
+    RDCASSERT(ret);
+
+    // the blob must at least contain the binary format
+    if(size < sizeof(uint32_t))
+      return false;
+
+    WrappedOpenGL::ProgramBinary *bin = new WrappedOpenGL::ProgramBinary();
+    bin->blob.assign(data, data + size);
+
+    *ret = bin;
+
+    return true;
+  }
+
+  void Destroy(WrappedOpenGL::ProgramBinary *bin) const { delete bin; }
+  uint32_t GetSize(WrappedOpenGL::ProgramBinary *bin) const { return (uint32_t)bin->blob.size(); }
+  const byte *GetData(WrappedOpenGL::ProgramBinary *bin) const { return bin->blob.data(); }
+} ProgramBinaryCallbacks;
+
+void WrappedOpenGL::OpenProgramBinaryCache()
+{
+  m_ProgramBinaryCacheOpen = true;
+
+  GLint numFormats = 0;
+  GL.glGetIntegerv(eGL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+
+  // the extension is allowed to be present with no supported formats
+  m_ProgramBinaryCacheEnabled = HasExt[ARB_get_program_binary] && numFormats > 0;
+
+  if(!m_ProgramBinaryCacheEnabled)
+    return;
+
+  // program binaries are driver and GPU specific, so key the file by the implementation identity.
+  // A driver update changes GL_VERSION, making the stale cache unreachable, and any binary the
+  // driver still rejects falls back to a source link in TryRestoreProgramBinary.
+  uint32_t driverhash = strhash((const char *)GL.glGetString(eGL_VENDOR));
+  driverhash = strhash((const char *)GL.glGetString(eGL_RENDERER), driverhash);
+  driverhash = strhash((const char *)GL.glGetString(eGL_VERSION), driverhash);
+
+  m_ProgramBinaryCacheFile = StringFormat::Fmt("glprograms_%08x.cache", driverhash);
+
+  bool success = LoadShaderCache(m_ProgramBinaryCacheFile.c_str(), m_ProgramBinaryCacheMagic,
+                                 m_ProgramBinaryCacheVersion, m_ProgramBinaryCache,
+                                 ProgramBinaryCallbacks);
+
+  // if we failed to load from the cache
+  m_ProgramBinaryCacheDirty = !success;
+}
+
+void WrappedOpenGL::CloseProgramBinaryCache()
+{
+  if(m_ProgramBinaryCacheEnabled && m_ProgramBinaryCacheDirty)
+  {
+    SaveShaderCache(m_ProgramBinaryCacheFile.c_str(), m_ProgramBinaryCacheMagic,
+                    m_ProgramBinaryCacheVersion, m_ProgramBinaryCache, ProgramBinaryCallbacks);
+  }
+  else
+  {
+    for(auto it = m_ProgramBinaryCache.begin(); it != m_ProgramBinaryCache.end(); ++it)
+      ProgramBinaryCallbacks.Destroy(it->second);
+  }
+
+  m_ProgramBinaryCache.clear();
+  m_ProgramBinaryCacheEnabled = false;
+}
+
+uint32_t WrappedOpenGL::ProgramBinaryCacheHash(ResourceId progid)
+{
+  ProgramData &progDetails = m_Programs[progid];
+
+  uint32_t hash = progDetails.prelinkHash;
+
+  for(size_t s = 0; s < ARRAY_COUNT(progDetails.stageShaders); s++)
+  {
+    ResourceId id = progDetails.stageShaders[s];
+
+    if(id == ResourceId())
+      continue;
+
+    const ShaderData &shadDetails = m_Shaders[id];
+
+    for(size_t i = 0; i < shadDetails.sources.size(); i++)
+      hash = strhash(shadDetails.sources[i].c_str(), hash);
+
+    // SPIR-V shaders are specialised rather than compiled from source - don't try to match them
+    if(!shadDetails.spirvWords.empty())
+      return 0;
+  }
+
+  return hash;
+}
+
+bool WrappedOpenGL::TryRestoreProgramBinary(GLuint prog, uint32_t hash)
+{
+  if(!m_ProgramBinaryCacheEnabled || hash == 0)
+    return false;
+
+  auto it = m_ProgramBinaryCache.find(hash);
+
+  if(it == m_ProgramBinaryCache.end())
+    return false;
+
+  const std::vector<byte> &blob = it->second->blob;
+
+  GLenum binaryFormat = (GLenum)*(const uint32_t *)blob.data();
+
+  SuppressDebugMessages(true);
+  GL.glProgramBinary(prog, binaryFormat, blob.data() + sizeof(uint32_t),
+                     (GLsizei)(blob.size() - sizeof(uint32_t)));
+  SuppressDebugMessages(false);
+
+  GLint status = 0;
+  GL.glGetProgramiv(prog, eGL_LINK_STATUS, &status);
+
+  if(status != GL_TRUE)
+  {
+    // the driver rejected the binary - evict it and fall back to a source link
+    ProgramBinaryCallbacks.Destroy(it->second);
+    m_ProgramBinaryCache.erase(it);
+    m_ProgramBinaryCacheDirty = true;
+    return false;
+  }
+
+  return true;
+}
+
+void WrappedOpenGL::StoreProgramBinary(GLuint prog, uint32_t hash)
+{
+  if(!m_ProgramBinaryCacheEnabled || hash == 0)
+    return;
+
+  if(m_ProgramBinaryCache.find(hash) != m_ProgramBinaryCache.end())
+    return;
+
+  GLint status = 0;
+  GL.glGetProgramiv(prog, eGL_LINK_STATUS, &status);
+
+  // don't cache failed links
+  if(status != GL_TRUE)
+    return;
+
+  GLint len = 0;
+  GL.glGetProgramiv(prog, eGL_PROGRAM_BINARY_LENGTH, &len);
+
+  if(len <= 0)
+    return;
+
+  ProgramBinary *bin = new ProgramBinary();
+  bin->blob.resize(sizeof(uint32_t) + (size_t)len);
+
+  GLsizei retlen = 0;
+  GLenum binaryFormat = eGL_NONE;
+  GL.glGetProgramBinary(prog, len, &retlen, &binaryFormat, bin->blob.data() + sizeof(uint32_t));
+
+  if(retlen <= 0 || binaryFormat == eGL_NONE)
+  {
+    delete bin;
+    return;
+  }
+
+  memcpy(bin->blob.data(), &binaryFormat, sizeof(uint32_t));
+  bin->blob.resize(sizeof(uint32_t) + (size_t)retlen);
+
+  m_ProgramBinaryCache[hash] = bin;
+  m_ProgramBinaryCacheDirty = true;
+}
+
 ContextPair &WrappedOpenGL::GetCtx()
 {
   GLContextTLSData *ret = (GLContextTLSData *)Threading::GetTLSValue(m_CurCtxDataTLS);
@@ -833,6 +1007,11 @@ ContextPair &WrappedOpenGL::GetCtx()
 
 GLResourceRecord *WrappedOpenGL::GetContextRecord()
 {
+  // a pending coalesced buffer update must land before whatever chunk is about to be recorded, to
+  // preserve its position relative to anything that might read the buffer.
+  if(m_PendingBufferUpdates.ctxRecord)
+    FlushCoalescedBufferUpdates();
+
   GLContextTLSData *ret = (GLContextTLSData *)Threading::GetTLSValue(m_CurCtxDataTLS);
   if(ret && ret->ctxRecord)
   {
@@ -848,6 +1027,18 @@ GLResourceRecord *WrappedOpenGL::GetContextRecord()
 
 WrappedOpenGL::ContextData &WrappedOpenGL::GetCtxData()
 {
+  // this is called on virtually every wrapped GL entry point, so cache the map lookup in the
+  // thread's TLS data - the pointer stays valid until the context is deleted
+  GLContextTLSData *tlsData = (GLContextTLSData *)Threading::GetTLSValue(m_CurCtxDataTLS);
+
+  if(tlsData)
+  {
+    if(!tlsData->ctxData)
+      tlsData->ctxData = &m_ContextData[tlsData->ctxPair.ctx];
+
+    return *(ContextData *)tlsData->ctxData;
+  }
+
   return m_ContextData[GetCtx().ctx];
 }
 
@@ -921,6 +1112,11 @@ void WrappedOpenGL::DeleteContext(void *contextHandle)
     ctxdata.UnassociateWindow(wndHandle);
   }
 
+  // drop any thread's cached pointer to this context's data before erasing it
+  for(size_t i = 0; i < m_CtxDataVector.size(); i++)
+    if(m_CtxDataVector[i]->ctxData == &ctxdata)
+      m_CtxDataVector[i]->ctxData = NULL;
+
   m_ContextData.erase(contextHandle);
 }
 
@@ -1180,6 +1376,8 @@ void WrappedOpenGL::ActivateContext(GLWindowingData winData)
 
         Threading::SetTLSValue(m_CurCtxDataTLS, tlsData);
       }
+
+      tlsData->ctxData = &ctxdata;
     }
 
     if(!ctxdata.built)
@@ -2322,6 +2520,8 @@ bool WrappedOpenGL::Serialise_ContextInit(ReadSerialiser &ser)
 
 void WrappedOpenGL::ContextEndFrame()
 {
+  FlushCoalescedBufferUpdates();
+
   USE_SCRATCH_SERIALISER();
   ser.SetDrawChunk();
   SCOPED_SERIALISE_CHUNK(SystemChunk::CaptureEnd);
@@ -2352,6 +2552,10 @@ void WrappedOpenGL::CleanupCapture()
   m_SuccessfulCapture = true;
   m_FailureReason = CaptureSucceeded;
 
+  // drop any coalesced buffer update still pending - the chunks it would produce are being
+  // thrown away along with the rest of the frame's recording.
+  m_PendingBufferUpdates = PendingBufferUpdates();
+
   CleanupResourceRecord(m_ContextRecord, true);
 
   for(auto it = m_ContextData.begin(); it != m_ContextData.end(); ++it)
@@ -2519,6 +2723,11 @@ void WrappedOpenGL::AddDebugMessage(MessageCategory c, MessageSeverity sv, Messa
     msg.category = c;
     msg.severity = sv;
     msg.description = d;
+
+    // drop duplicate messages re-triggered by scrubbing around the frame
+    if(IsActiveReplaying(m_State) && !m_ReportedDebugMessages.insert(msg).second)
+      return;
+
     m_DebugMessages.push_back(msg);
   }
 }
@@ -2590,6 +2799,10 @@ void WrappedOpenGL::RegisterDebugCallback()
   {
     GL.glDebugMessageCallback(&DebugSnoopStatic, this);
     GL.glEnable(eGL_DEBUG_OUTPUT_SYNCHRONOUS);
+
+    // errors now arrive via DebugSnoop, so poll-and-discard error checks on replay can skip their
+    // glGetError. On drivers without KHR_debug this stays false and those sites poll as before.
+    GLErrorCallbackActive = true;
   }
 }
 
@@ -2732,6 +2945,10 @@ ReplayStatus WrappedOpenGL::ReadLogInitialisation(RDCFile *rdc, bool storeStruct
   ser.SetStringDatabase(&m_StringDB);
   ser.SetUserData(GetResourceManager());
 
+  // the chunk storage is the memory-mapped file which outlives replay, so strings and buffers
+  // can be deserialised as borrowed views instead of copies. No-op for compressed captures.
+  ser.EnableBorrowedViews(true);
+
   ser.ConfigureStructuredExport(&GetChunkName, storeStructuredBuffers);
 
   m_StructuredFile = &ser.GetStructuredFile();
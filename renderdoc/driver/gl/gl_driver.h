@@ -26,6 +26,7 @@
 #pragma once
 
 #include <list>
+#include <set>
 #include "common/common.h"
 #include "common/timing.h"
 #include "core/core.h"
@@ -82,6 +83,8 @@ private:
   GLPlatform &m_Platform;
 
   vector<DebugMessage> m_DebugMessages;
+  // unique messages seen during active replay, used to drop duplicates re-triggered by scrubbing
+  std::set<DebugMessage> m_ReportedDebugMessages;
   template <typename SerialiserType>
   void Serialise_DebugMessages(SerialiserType &ser);
   vector<DebugMessage> GetDebugMessages();
@@ -186,6 +189,32 @@ private:
 
   set<ResourceId> m_HighTrafficResources;
 
+  // accumulates consecutive glBufferSubData-style updates to one buffer during active capture, so
+  // that engines streaming thousands of small updates per frame get one chunk per contiguous span
+  // of bytes instead of one chunk per call. The pending update is flushed from GetContextRecord()
+  // before any other chunk is recorded, which keeps it ordered against anything that might read
+  // the buffer.
+  struct PendingBufferUpdates
+  {
+    // context record the flushed chunks will be added to. NULL means nothing is pending
+    GLResourceRecord *ctxRecord = NULL;
+    GLuint buffer = 0;
+    // buffer byte offset corresponding to data[0]
+    uint64_t base = 0;
+    // staging copy of the updated bytes, a window over [base, base + data.size())
+    std::vector<byte> data;
+    // which bytes of the window actually hold an update. Bytes in gaps were never written and
+    // must not be serialised
+    Intervals<bool> spans;
+  } m_PendingBufferUpdates;
+
+  // maximum gap between updates we'll bridge by growing the staging window, rather than flushing
+  // and starting a new window
+  static const uint64_t MaxBufferUpdateCoalesceGap = 64 * 1024;
+
+  void CoalesceBufferUpdate(GLuint buffer, GLintptr offset, GLsizeiptr size, const void *data);
+  void FlushCoalescedBufferUpdates();
+
   int m_ReplayEventCount = 0;
 
   // we store two separate sets of maps, since for an explicit glMemoryBarrier
@@ -555,7 +584,12 @@ public:
   void AddDebugMessage(DebugMessage msg)
   {
     if(IsReplayMode(m_State))
+    {
+      if(IsActiveReplaying(m_State) && !m_ReportedDebugMessages.insert(msg).second)
+        return;
+
       m_DebugMessages.push_back(msg);
+    }
   }
   void AddDebugMessage(MessageCategory c, MessageSeverity sv, MessageSource src, std::string d);
 
@@ -649,6 +683,11 @@ public:
     bool linked;
     ResourceId stageShaders[6];
 
+    // rolling hash of the pre-link state applied on replay (attrib/frag data bindings, transform
+    // feedback varyings, program parameters). Folded into the program binary cache key, since
+    // programs with identical shaders but different pre-link bindings link differently.
+    uint32_t prelinkHash = 5381;
+
     // used only when we're capturing and don't have driver-side reflection so we need to emulate
     glslang::TProgram *glslangProgram = NULL;
   };
@@ -676,6 +715,30 @@ public:
   std::map<ResourceId, ProgramData> m_Programs;
   std::map<ResourceId, PipelineData> m_Pipelines;
 
+  // on-disk cache of linked program binaries via ARB_get_program_binary, so that opening a capture
+  // with thousands of programs doesn't spend its whole load time in the driver's linker. Keyed by
+  // a hash of the attached shader sources and the replayed pre-link state, and the file itself is
+  // keyed by the driver/GPU identity since binary formats are implementation specific. Restores
+  // that fail (e.g. after a driver update mid-session) fall back to a normal source link.
+  struct ProgramBinary
+  {
+    // first 4 bytes are the GLenum binaryFormat, the rest is the driver blob
+    std::vector<byte> blob;
+  };
+  std::map<uint32_t, ProgramBinary *> m_ProgramBinaryCache;
+  bool m_ProgramBinaryCacheOpen = false;
+  bool m_ProgramBinaryCacheEnabled = false;
+  bool m_ProgramBinaryCacheDirty = false;
+  std::string m_ProgramBinaryCacheFile;
+  static const uint32_t m_ProgramBinaryCacheMagic = 0xf00dd00f;
+  static const uint32_t m_ProgramBinaryCacheVersion = 1;
+
+  void OpenProgramBinaryCache();
+  void CloseProgramBinaryCache();
+  uint32_t ProgramBinaryCacheHash(ResourceId progid);
+  bool TryRestoreProgramBinary(GLuint prog, uint32_t hash);
+  void StoreProgramBinary(GLuint prog, uint32_t hash);
+
   struct TextureData
   {
     TextureData()
@@ -216,9 +216,17 @@ void GLResourceManager::ContextPrepare_InitialState(GLResource res)
       GL.glCopyBufferSubData(eGL_COPY_READ_BUFFER, eGL_COPY_WRITE_BUFFER, 0, 0, (GLsizeiptr)length);
 
     // workaround for some drivers - mapping/unmapping here seems to help avoid problems mapping
-    // later.
-    GL.glMapNamedBufferEXT(buf, eGL_READ_ONLY);
-    GL.glUnmapNamedBufferEXT(buf);
+    // later. During the prepare batch at capture start we defer this to End_PrepareInitialBatch(),
+    // since the map blocks until the copy above has completed.
+    if(m_PrepareBatchActive)
+    {
+      m_PrepareBatchMapBuffers.push_back(buf);
+    }
+    else
+    {
+      GL.glMapNamedBufferEXT(buf, eGL_READ_ONLY);
+      GL.glUnmapNamedBufferEXT(buf);
+    }
 
     // restore old bindings
     GL.glBindBuffer(eGL_COPY_READ_BUFFER, oldbuf1);
@@ -564,6 +572,26 @@ bool GLResourceManager::Prepare_InitialState(GLResource res)
   return true;
 }
 
+void GLResourceManager::Begin_PrepareInitialBatch()
+{
+  m_PrepareBatchActive = true;
+}
+
+void GLResourceManager::End_PrepareInitialBatch()
+{
+  // perform the deferred driver-workaround map/unmap for every buffer prepared in this batch. All
+  // of the copies have been issued by now, so the first map waits for the whole queue to drain and
+  // the rest complete without stalling, instead of each buffer synchronising alone.
+  for(GLuint buf : m_PrepareBatchMapBuffers)
+  {
+    GL.glMapNamedBufferEXT(buf, eGL_READ_ONLY);
+    GL.glUnmapNamedBufferEXT(buf);
+  }
+
+  m_PrepareBatchMapBuffers.clear();
+  m_PrepareBatchActive = false;
+}
+
 void GLResourceManager::CreateTextureImage(GLuint tex, GLenum internalFormat,
                                            GLenum internalFormatHint, GLenum textype, GLint dim,
                                            GLint width, GLint height, GLint depth, GLint samples,
@@ -1025,31 +1053,41 @@ void GLResourceManager::Force_ReferenceViews()
   if(RenderDoc::Inst().GetCaptureOptions().refAllResources)
     return;
 
-  for(auto recordit = m_ResourceRecords.begin(); recordit != m_ResourceRecords.end(); ++recordit)
-  {
-    GLResourceRecord *record = recordit->second;
+  // take the manager's lock around the iteration, since we read the frame references
+  SCOPED_LOCK(m_Lock);
+
+  // merge any queued marks so the frame reference checks below see them
+  FlushPendingMarks();
+
+  // gather the IDs to force during the iteration and mark them afterwards - marking looks the
+  // record up again, which isn't allowed from inside the ForEach callback
+  std::vector<ResourceId> forced;
 
+  m_ResourceRecords.ForEach([this, &forced](ResourceId id, GLResourceRecord *record) {
     // if this resource has some viewers, check to see if they were referenced by the frame but we
     // weren't, and force our own reference as well so that our initial states are included
     if(record && !record->viewTextures.empty())
     {
       // if this data resource was referenced already, just skip
       if(m_FrameReferencedResources.find(record->GetResourceID()) != m_FrameReferencedResources.end())
-        continue;
+        return;
 
       // see if any of our viewers were referenced
       for(auto it = record->viewTextures.begin(); it != record->viewTextures.end(); ++it)
       {
-        // if so, return true to force our inclusion, for the benefit of the view
+        // if so, force our inclusion, for the benefit of the view
         if(m_FrameReferencedResources.find(*it) != m_FrameReferencedResources.end())
         {
           RDCDEBUG("Forcing inclusion of %llu for %llu", record->GetResourceID(), *it);
-          MarkResourceFrameReferenced(record->GetResourceID(), eFrameRef_ReadBeforeWrite);
+          forced.push_back(record->GetResourceID());
           break;
         }
       }
     }
-  }
+  });
+
+  for(ResourceId id : forced)
+    MarkResourceFrameReferenced(id, eFrameRef_ReadBeforeWrite);
 }
 
 uint64_t GLResourceManager::GetSize_InitialState(ResourceId resid, const GLInitialContents &initial)
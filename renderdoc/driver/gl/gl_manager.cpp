@@ -115,6 +115,64 @@ void GLResourceManager::MarkFBOReferenced(GLResource res, FrameRefType ref)
   }
 }
 
+void GLResourceManager::MarkFBOAttachmentsDirty(GLResource res)
+{
+  if(res.name == 0)
+    return;
+
+  ContextPair &ctx = m_Driver->GetCtx();
+
+  GLint numCols = 8;
+  GL.glGetIntegerv(eGL_MAX_COLOR_ATTACHMENTS, &numCols);
+
+  GLenum type = eGL_TEXTURE;
+  GLuint name = 0;
+
+  for(int c = 0; c < numCols; c++)
+  {
+    GL.glGetNamedFramebufferAttachmentParameterivEXT(res.name, GLenum(eGL_COLOR_ATTACHMENT0 + c),
+                                                     eGL_FRAMEBUFFER_ATTACHMENT_OBJECT_NAME,
+                                                     (GLint *)&name);
+    GL.glGetNamedFramebufferAttachmentParameterivEXT(res.name, GLenum(eGL_COLOR_ATTACHMENT0 + c),
+                                                     eGL_FRAMEBUFFER_ATTACHMENT_OBJECT_TYPE,
+                                                     (GLint *)&type);
+
+    if(name)
+    {
+      if(type == eGL_RENDERBUFFER)
+        MarkDirtyResource(RenderbufferRes(ctx, name));
+      else
+        MarkDirtyResource(TextureRes(ctx, name));
+    }
+  }
+
+  GL.glGetNamedFramebufferAttachmentParameterivEXT(
+      res.name, eGL_DEPTH_ATTACHMENT, eGL_FRAMEBUFFER_ATTACHMENT_OBJECT_NAME, (GLint *)&name);
+  GL.glGetNamedFramebufferAttachmentParameterivEXT(
+      res.name, eGL_DEPTH_ATTACHMENT, eGL_FRAMEBUFFER_ATTACHMENT_OBJECT_TYPE, (GLint *)&type);
+
+  if(name)
+  {
+    if(type == eGL_RENDERBUFFER)
+      MarkDirtyResource(RenderbufferRes(ctx, name));
+    else
+      MarkDirtyResource(TextureRes(ctx, name));
+  }
+
+  GL.glGetNamedFramebufferAttachmentParameterivEXT(
+      res.name, eGL_STENCIL_ATTACHMENT, eGL_FRAMEBUFFER_ATTACHMENT_OBJECT_NAME, (GLint *)&name);
+  GL.glGetNamedFramebufferAttachmentParameterivEXT(
+      res.name, eGL_STENCIL_ATTACHMENT, eGL_FRAMEBUFFER_ATTACHMENT_OBJECT_TYPE, (GLint *)&type);
+
+  if(name)
+  {
+    if(type == eGL_RENDERBUFFER)
+      MarkDirtyResource(RenderbufferRes(ctx, name));
+    else
+      MarkDirtyResource(TextureRes(ctx, name));
+  }
+}
+
 void GLResourceManager::SetInternalResource(GLResource res)
 {
   if(!RenderDoc::Inst().IsReplayApp())
@@ -239,6 +239,12 @@ public:
   void MarkVAOReferenced(GLResource res, FrameRefType ref, bool allowFake0 = false);
   void MarkFBOReferenced(GLResource res, FrameRefType ref);
 
+  // mark the current attachments of an FBO dirty. Called when the FBO is written to outside of a
+  // draw - clears and blits - since attaching a texture is deliberately not treated as a write.
+  // That way a texture that's only ever attached, never rendered to, can still be serialised from
+  // its creation chunks instead of needing a contents snapshot at capture start.
+  void MarkFBOAttachmentsDirty(GLResource res);
+
   void Force_ReferenceViews();
 
   template <typename SerialiserType>
@@ -257,6 +263,11 @@ public:
 private:
   bool ResourceTypeRelease(GLResource res);
   bool Prepare_InitialState(GLResource res);
+  // prepared contents are standalone GL objects or serialised chunks, so they stay valid between
+  // the frames of a multi-frame capture burst
+  bool RetainPreparedContentsAcrossBurst() { return true; }
+  void Begin_PrepareInitialBatch();
+  void End_PrepareInitialBatch();
   uint64_t GetSize_InitialState(ResourceId resid, const GLInitialContents &initial);
 
   void CreateTextureImage(GLuint tex, GLenum internalFormat, GLenum internalFormatHint,
@@ -278,6 +289,13 @@ private:
   std::map<ResourceId, std::string> m_Names;
   volatile int64_t m_SyncName;
 
+  // buffers created by ContextPrepare_InitialState() during the current prepare batch which still
+  // need the driver-workaround map/unmap. The map blocks until the buffer's copy has completed, so
+  // we defer it to End_PrepareInitialBatch() - that way every buffer's copy is issued before the
+  // first map has to wait, and we synchronise once on the whole queue instead of per-buffer.
+  std::vector<GLuint> m_PrepareBatchMapBuffers;
+  bool m_PrepareBatchActive = false;
+
   CaptureState m_State;
   WrappedOpenGL *m_Driver;
 };
@@ -43,11 +43,18 @@ void GLReplay::CreateOverlayProgram(GLuint Program, GLuint Pipeline, GLuint frag
 
   ContextPair &ctx = drv.GetCtx();
 
-  // delete the old program if it exists
-  if(DebugData.overlayProg != 0)
-    drv.glDeleteProgram(DebugData.overlayProg);
+  // fetch the cached program. Overlays only substitute the fragment shader, so the linked program
+  // can be re-used whenever the same program or pipeline comes around again - only the uniform
+  // values need copying fresh on each use.
+  GLuint &cachedProg =
+      m_OverlayProgs[std::make_pair(fragShader, std::make_pair(Program, Pipeline))];
 
-  DebugData.overlayProg = drv.glCreateProgram();
+  const bool link = (cachedProg == 0);
+
+  if(link)
+    cachedProg = drv.glCreateProgram();
+
+  DebugData.overlayProg = cachedProg;
 
   // these are the shaders to attach, and the programs to copy details from
   GLuint shaders[4] = {0};
@@ -81,7 +88,7 @@ void GLReplay::CreateOverlayProgram(GLuint Program, GLuint Pipeline, GLuint frag
           shaders[i] =
               m_pDriver->GetResourceManager()->GetCurrentResource(pipeDetails.stageShaders[i]).name;
 
-          if(pipeDetails.stagePrograms[i] == pipeDetails.stageShaders[i])
+          if(link && pipeDetails.stagePrograms[i] == pipeDetails.stageShaders[i])
           {
             const WrappedOpenGL::ProgramData &progDetails =
                 m_pDriver->m_Programs[pipeDetails.stagePrograms[i]];
@@ -113,7 +120,7 @@ void GLReplay::CreateOverlayProgram(GLuint Program, GLuint Pipeline, GLuint frag
             }
           }
 
-          if(i == 0)
+          if(link && i == 0)
             vsRefl = GetShader(pipeDetails.stageShaders[i], ShaderEntryPoint());
         }
       }
@@ -133,47 +140,53 @@ void GLReplay::CreateOverlayProgram(GLuint Program, GLuint Pipeline, GLuint frag
         shaders[i] =
             m_pDriver->GetResourceManager()->GetCurrentResource(progDetails.stageShaders[i]).name;
 
-        if(i == 0)
+        if(link && i == 0)
           vsRefl = GetShader(progDetails.stageShaders[0], ShaderEntryPoint());
       }
     }
   }
 
-  // attach the shaders
-  for(size_t i = 0; i < 4; i++)
-    if(shaders[i])
-      drv.glAttachShader(DebugData.overlayProg, shaders[i]);
+  if(link)
+  {
+    // attach the shaders
+    for(size_t i = 0; i < 4; i++)
+      if(shaders[i])
+        drv.glAttachShader(DebugData.overlayProg, shaders[i]);
 
-  drv.glAttachShader(DebugData.overlayProg, fragShader);
+    drv.glAttachShader(DebugData.overlayProg, fragShader);
 
-  // copy the vertex attribs over from the source program
-  if(vsRefl && programs[0])
-    CopyProgramAttribBindings(programs[0], DebugData.overlayProg, vsRefl);
+    // copy the vertex attribs over from the source program
+    if(vsRefl && programs[0])
+      CopyProgramAttribBindings(programs[0], DebugData.overlayProg, vsRefl);
 
-  // link the overlay program
-  drv.glLinkProgram(DebugData.overlayProg);
+    // link the overlay program
+    drv.glLinkProgram(DebugData.overlayProg);
 
-  // detach the shaders
-  for(size_t i = 0; i < 4; i++)
-    if(shaders[i])
-      drv.glDetachShader(DebugData.overlayProg, shaders[i]);
+    // detach the shaders
+    for(size_t i = 0; i < 4; i++)
+      if(shaders[i])
+        drv.glDetachShader(DebugData.overlayProg, shaders[i]);
 
-  drv.glDetachShader(DebugData.overlayProg, fragShader);
+    drv.glDetachShader(DebugData.overlayProg, fragShader);
 
-  // delete any temporaries
-  for(size_t i = 0; i < 4; i++)
-    if(tmpShaders[i])
-      drv.glDeleteShader(tmpShaders[i]);
-
-  // check that the link succeeded
-  char buffer[1024] = {};
-  GLint status = 0;
-  drv.glGetProgramiv(DebugData.overlayProg, eGL_LINK_STATUS, &status);
-  if(status == 0)
-  {
-    drv.glGetProgramInfoLog(DebugData.overlayProg, 1024, NULL, buffer);
-    RDCERR("Error linking overlay program: %s", buffer);
-    return;
+    // delete any temporaries
+    for(size_t i = 0; i < 4; i++)
+      if(tmpShaders[i])
+        drv.glDeleteShader(tmpShaders[i]);
+
+    // check that the link succeeded, and don't cache failed links
+    char buffer[1024] = {};
+    GLint status = 0;
+    drv.glGetProgramiv(DebugData.overlayProg, eGL_LINK_STATUS, &status);
+    if(status == 0)
+    {
+      drv.glGetProgramInfoLog(DebugData.overlayProg, 1024, NULL, buffer);
+      RDCERR("Error linking overlay program: %s", buffer);
+
+      drv.glDeleteProgram(cachedProg);
+      cachedProg = DebugData.overlayProg = 0;
+      return;
+    }
   }
 
   // copy the uniform values over from the source program. This is redundant but harmless if the
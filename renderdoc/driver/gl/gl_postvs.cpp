@@ -43,6 +43,11 @@ void GLReplay::ClearPostVSCache()
   }
 
   m_PostVSData.clear();
+
+  for(auto it = m_PostVSFeedbackProgs.begin(); it != m_PostVSFeedbackProgs.end(); ++it)
+    drv.glDeleteProgram(it->second);
+
+  m_PostVSFeedbackProgs.clear();
 }
 
 void GLReplay::InitPostVSBuffers(uint32_t eventId)
@@ -215,10 +220,31 @@ void GLReplay::InitPostVSBuffers(uint32_t eventId)
     return;
   }
 
+  // if this is a vertex-only feedback program we may have linked it already for a previous draw
+  // using the same program - setting up the varyings and linking is the dominant cost when
+  // initialising post-VS data for a whole pass. The tes/gs variants can't be cached since the
+  // program is relinked below with the last stage's varyings.
+  bool cacheableProg = (tesRefl == NULL && gsRefl == NULL && tmpShaders[0] == 0);
+  bool cachedProg = false;
+
+  std::pair<GLuint, GLuint> progKey = {stageShaders[0], stageSrcPrograms[0]};
+
+  if(cacheableProg)
+  {
+    auto cacheIt = m_PostVSFeedbackProgs.find(progKey);
+
+    if(cacheIt != m_PostVSFeedbackProgs.end())
+    {
+      drv.glDeleteProgram(feedbackProg);
+      feedbackProg = cacheIt->second;
+      cachedProg = true;
+    }
+  }
+
   // GLES requires a fragment shader even with rasterizer discard, so we'll attach this
   GLuint dummyFrag = 0;
 
-  if(IsGLES)
+  if(IsGLES && !cachedProg)
   {
     dummyFrag = drv.glCreateShader(eGL_FRAGMENT_SHADER);
 
@@ -257,18 +283,21 @@ void GLReplay::InitPostVSBuffers(uint32_t eventId)
     }
   }
 
-  // attach the vertex shader
-  drv.glAttachShader(feedbackProg, stageShaders[0]);
+  if(!cachedProg)
+  {
+    // attach the vertex shader
+    drv.glAttachShader(feedbackProg, stageShaders[0]);
+
+    // attach the dummy fragment shader, if it exists
+    if(dummyFrag)
+      drv.glAttachShader(feedbackProg, dummyFrag);
 
-  // attach the dummy fragment shader, if it exists
-  if(dummyFrag)
-    drv.glAttachShader(feedbackProg, dummyFrag);
+    CopyProgramAttribBindings(stageSrcPrograms[0], feedbackProg, vsRefl);
+  }
 
   list<string> matrixVaryings;    // matrices need some fixup
   vector<const char *> varyings;
 
-  CopyProgramAttribBindings(stageSrcPrograms[0], feedbackProg, vsRefl);
-
   varyings.clear();
 
   uint32_t stride = 0;
@@ -367,9 +396,9 @@ void GLReplay::InitPostVSBuffers(uint32_t eventId)
   // At least we don't have to reallocate strings all over, since the memory is
   // already owned elsewhere, we just need to modify pointers to trim prefixes. Bright side?
 
-  GLint status = 0;
+  GLint status = cachedProg ? 1 : 0;
   bool finished = false;
-  for(;;)
+  while(!cachedProg)
   {
     // specify current varyings & relink
     drv.glTransformFeedbackVaryings(feedbackProg, (GLsizei)varyings.size(), &varyings[0],
@@ -451,6 +480,11 @@ void GLReplay::InitPostVSBuffers(uint32_t eventId)
     return;
   }
 
+  // keep the successfully linked program for subsequent draws using the same program. The cache
+  // owns it from here - it's deleted in ClearPostVSCache().
+  if(cacheableProg && !cachedProg)
+    m_PostVSFeedbackProgs[progKey] = feedbackProg;
+
   // copy across any uniform values, bindings etc from the real program containing
   // the vertex stage
   CopyProgramUniforms(stageSrcPrograms[0], feedbackProg);
@@ -757,7 +791,9 @@ void GLReplay::InitPostVSBuffers(uint32_t eventId)
 
     drv.glDeleteShader(dummyFrag);
 
-    drv.glDeleteProgram(feedbackProg);
+    // the program is owned by the feedback program cache if it was cacheable
+    if(!cacheableProg)
+      drv.glDeleteProgram(feedbackProg);
 
     return;
   }
@@ -1479,8 +1515,9 @@ void GLReplay::InitPostVSBuffers(uint32_t eventId)
     }
   }
 
-  // delete temporary program we made
-  drv.glDeleteProgram(feedbackProg);
+  // delete temporary program we made, unless the feedback program cache owns it
+  if(!cacheableProg)
+    drv.glDeleteProgram(feedbackProg);
 
   // restore replay state we trashed
   drv.glUseProgram(rs.Program.name);
@@ -302,7 +302,11 @@ void GLReplay::RenderMesh(uint32_t eventId, const vector<MeshFormat> &secondaryD
 
       ClearGLErrors();
       drv.glUseProgram(solidProg);
-      GLenum err = drv.glGetError();
+
+      // only poll for the error when the debug callback isn't reporting them for us
+      GLenum err = eGL_NONE;
+      if(!GLErrorCallbackActive)
+        err = drv.glGetError();
 
       err = eGL_NONE;
     }
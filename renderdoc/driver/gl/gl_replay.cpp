@@ -3504,7 +3504,7 @@ ReplayStatus CreateReplayDevice(RDCDriver rdcdriver, RDCFile *rdc, GLPlatform &p
   return ReplayStatus::Succeeded;
 }
 
-void GL_ProcessStructured(RDCFile *rdc, SDFile &output)
+void GL_ProcessStructured(RDCFile *rdc, SDFile &output, bool includeBuffers)
 {
   GLDummyPlatform dummy;
   WrappedOpenGL device(dummy);
@@ -3515,7 +3515,7 @@ void GL_ProcessStructured(RDCFile *rdc, SDFile &output)
     return;
 
   device.SetStructuredExport(rdc->GetSectionProperties(sectionIdx).version);
-  ReplayStatus status = device.ReadLogInitialisation(rdc, true);
+  ReplayStatus status = device.ReadLogInitialisation(rdc, includeBuffers);
 
   if(status == ReplayStatus::Succeeded)
     device.GetStructuredFile().Swap(output);
@@ -388,8 +388,22 @@ private:
   // eventId -> data
   std::map<uint32_t, GLPostVSData> m_PostVSData;
 
+  // (vertex shader, source program) -> linked transform feedback program. Draws in a pass mostly
+  // share a handful of programs, so when stepping through draws for the mesh viewer we'd
+  // otherwise pay for a fresh varyings setup and link (the dominant cost) on every draw. Only
+  // vertex-only feedback programs are cached - with tessellation or geometry shaders the program
+  // is relinked with the last stage's varyings and can't be reused.
+  std::map<std::pair<GLuint, GLuint>, GLuint> m_PostVSFeedbackProgs;
+
   void ClearPostVSCache();
 
+  // (fragment shader, source program, source pipeline) -> linked overlay program. Overlays only
+  // substitute the fragment shader, so the linked program can be re-used whenever the same program
+  // or pipeline comes around again - quad overdraw would otherwise pay for a fresh link on every
+  // draw in the pass each time the overlay is refreshed. Uniform values are copied from the source
+  // program on every use, since they can change between draws.
+  std::map<std::pair<GLuint, std::pair<GLuint, GLuint>>, GLuint> m_OverlayProgs;
+
   // cache the previous data returned
   ResourceId m_GetTexturePrevID;
   byte *m_GetTexturePrevData[16];
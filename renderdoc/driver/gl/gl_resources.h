@@ -237,6 +237,9 @@ struct GLResourceRecord : public ResourceRecord
     bool verifyWrite;
     bool orphaned;
     bool persistent;
+    // true if the OS is tracking dirty pages in a coherent persistent map, so the barrier-time
+    // diff only needs to compare the pages the application actually wrote
+    bool writeWatched;
     byte *ptr;
   } Map;
 
@@ -316,4 +319,9 @@ struct GLContextTLSData
   GLContextTLSData(ContextPair p, GLResourceRecord *r) : ctxPair(p), ctxRecord(r) {}
   ContextPair ctxPair;
   GLResourceRecord *ctxRecord;
+  // cached pointer to the WrappedOpenGL::ContextData for ctxPair.ctx, so the per-call context
+  // data fetch is a TLS read instead of a map lookup. Stored as void* since the nested class
+  // can't be named here. Refreshed on MakeCurrent and dropped when the context is deleted - map
+  // entries are otherwise stable.
+  void *ctxData = NULL;
 };
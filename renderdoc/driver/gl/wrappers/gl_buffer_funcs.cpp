@@ -903,6 +903,75 @@ bool WrappedOpenGL::Serialise_glNamedBufferSubDataEXT(SerialiserType &ser, GLuin
   return true;
 }
 
+void WrappedOpenGL::CoalesceBufferUpdate(GLuint buffer, GLintptr offset, GLsizeiptr size,
+                                         const void *data)
+{
+  PendingBufferUpdates &pending = m_PendingBufferUpdates;
+
+  uint64_t start = (uint64_t)offset;
+  uint64_t finish = start + (uint64_t)size;
+
+  if(size == 0)
+    return;
+
+  // an update to a different buffer can't merge, and neither can one far enough away that
+  // bridging the gap would bloat the staging window - flush what we have and start fresh.
+  if(pending.ctxRecord &&
+     (pending.buffer != buffer || start > pending.base + pending.data.size() + MaxBufferUpdateCoalesceGap ||
+      finish + MaxBufferUpdateCoalesceGap < pending.base))
+    FlushCoalescedBufferUpdates();
+
+  if(pending.ctxRecord == NULL)
+  {
+    // nothing is pending now, so GetContextRecord() won't flush out from under us
+    pending.ctxRecord = GetContextRecord();
+    pending.buffer = buffer;
+    pending.base = start;
+  }
+
+  // grow the staging window to cover the new update
+  if(start < pending.base)
+  {
+    pending.data.insert(pending.data.begin(), (size_t)(pending.base - start), 0);
+    pending.base = start;
+  }
+  if(finish > pending.base + pending.data.size())
+    pending.data.resize((size_t)(finish - pending.base));
+
+  memcpy(pending.data.data() + (size_t)(start - pending.base), data, (size_t)size);
+  pending.spans.update(start, finish, true, [](bool a, bool b) { return a || b; });
+}
+
+void WrappedOpenGL::FlushCoalescedBufferUpdates()
+{
+  PendingBufferUpdates pending;
+  std::swap(pending, m_PendingBufferUpdates);
+
+  if(pending.ctxRecord == NULL)
+    return;
+
+  // serialise one chunk per contiguous span of updated bytes. We deliberately don't use the
+  // scratch serialiser - a flush can be triggered from inside another function's serialisation
+  // via GetContextRecord().
+  for(auto it = pending.spans.begin(); it != pending.spans.end(); ++it)
+  {
+    if(!it->value())
+      continue;
+
+    const void *ptr = pending.data.data() + (size_t)(it->start() - pending.base);
+    GLsizeiptr len = (GLsizeiptr)(it->finish() - it->start());
+
+    WriteSerialiser ser(new StreamWriter((uint64_t)len + 128), Ownership::Stream);
+
+    ser.SetChunkMetadataRecording(m_ScratchSerialiser.GetChunkMetadataRecording());
+
+    SCOPED_SERIALISE_CHUNK(GLChunk::glNamedBufferSubDataEXT);
+    Serialise_glNamedBufferSubDataEXT(ser, pending.buffer, (GLintptr)it->start(), len, ptr);
+
+    pending.ctxRecord->AddChunk(scope.Get());
+  }
+}
+
 void WrappedOpenGL::glNamedBufferSubDataEXT(GLuint buffer, GLintptr offset, GLsizeiptr size,
                                             const void *data)
 {
@@ -920,22 +989,22 @@ void WrappedOpenGL::glNamedBufferSubDataEXT(GLuint buffer, GLintptr offset, GLsi
        IsBackgroundCapturing(m_State))
       return;
 
-    USE_SCRATCH_SERIALISER();
-    SCOPED_SERIALISE_CHUNK(gl_CurChunk);
-    Serialise_glNamedBufferSubDataEXT(ser, buffer, offset, size, data);
-
-    Chunk *chunk = scope.Get();
-
     if(IsActiveCapturing(m_State))
     {
-      GetContextRecord()->AddChunk(chunk);
+      // merge with any immediately preceding updates to this buffer instead of serialising a
+      // chunk per call
+      CoalesceBufferUpdate(buffer, offset, size, data);
       GetResourceManager()->MarkDirtyResource(record->GetResourceID());
       GetResourceManager()->MarkResourceFrameReferenced(record->GetResourceID(),
                                                         eFrameRef_ReadBeforeWrite);
     }
     else
     {
-      record->AddChunk(chunk);
+      USE_SCRATCH_SERIALISER();
+      SCOPED_SERIALISE_CHUNK(gl_CurChunk);
+      Serialise_glNamedBufferSubDataEXT(ser, buffer, offset, size, data);
+
+      record->AddChunk(scope.Get());
       record->UpdateCount++;
 
       if(record->UpdateCount > 10)
@@ -973,22 +1042,22 @@ void WrappedOpenGL::glBufferSubData(GLenum target, GLintptr offset, GLsizeiptr s
        IsBackgroundCapturing(m_State))
       return;
 
-    USE_SCRATCH_SERIALISER();
-    SCOPED_SERIALISE_CHUNK(gl_CurChunk);
-    Serialise_glNamedBufferSubDataEXT(ser, res.name, offset, size, data);
-
-    Chunk *chunk = scope.Get();
-
     if(IsActiveCapturing(m_State))
     {
-      GetContextRecord()->AddChunk(chunk);
+      // merge with any immediately preceding updates to this buffer instead of serialising a
+      // chunk per call
+      CoalesceBufferUpdate(res.name, offset, size, data);
       GetResourceManager()->MarkDirtyResource(record->GetResourceID());
       GetResourceManager()->MarkResourceFrameReferenced(record->GetResourceID(),
                                                         eFrameRef_ReadBeforeWrite);
     }
     else
     {
-      record->AddChunk(chunk);
+      USE_SCRATCH_SERIALISER();
+      SCOPED_SERIALISE_CHUNK(gl_CurChunk);
+      Serialise_glNamedBufferSubDataEXT(ser, res.name, offset, size, data);
+
+      record->AddChunk(scope.Get());
       record->UpdateCount++;
 
       if(record->UpdateCount > 10)
@@ -2059,6 +2128,7 @@ void *WrappedOpenGL::glMapNamedBufferRangeEXT(GLuint buffer, GLintptr offset, GL
     record->Map.invalidate = invalidateMap;
     record->Map.verifyWrite = verifyWrite;
     record->Map.persistent = persistent;
+    record->Map.writeWatched = false;
 
     // store a list of all persistent writing maps, and subset of all coherent maps
     uint32_t persistentWriteFlags = GL_MAP_PERSISTENT_BIT | GL_MAP_WRITE_BIT;
@@ -2075,6 +2145,16 @@ void *WrappedOpenGL::glMapNamedBufferRangeEXT(GLuint buffer, GLintptr offset, GL
       record->Map.ptr = (byte *)GL.glMapNamedBufferRangeEXT(buffer, offset, length, access);
       record->Map.status = GLResourceRecord::Mapped_Direct;
 
+      // large coherent maps are diffed against shadow storage at every implicit coherent barrier
+      // point during capture. Ask the OS to track written pages so those diffs only touch what
+      // the application modified - small maps aren't worth the page fault overhead.
+      const GLsizeiptr watchThreshold = 4 * 1024 * 1024;
+
+      uint32_t coherentWriteFlags = GL_MAP_COHERENT_BIT | GL_MAP_WRITE_BIT;
+      if(record->Map.ptr && (access & coherentWriteFlags) == coherentWriteFlags &&
+         length >= watchThreshold)
+        record->Map.writeWatched = WriteWatch::StartTracking(record->Map.ptr, (size_t)length);
+
       return record->Map.ptr;
     }
 
@@ -2425,6 +2505,12 @@ GLboolean WrappedOpenGL::glUnmapNamedBufferEXT(GLuint buffer)
         m_CoherentMaps.erase(record);
     }
 
+    if(record->Map.writeWatched)
+    {
+      WriteWatch::StopTracking(record->Map.ptr, (size_t)record->Map.length);
+      record->Map.writeWatched = false;
+    }
+
     record->Map.status = GLResourceRecord::Unmapped;
 
     return ret;
@@ -2668,9 +2754,38 @@ void WrappedOpenGL::PersistentMapMemoryBarrier(const set<GLResourceRecord *> &ma
       size_t diffStart = 0, diffEnd = record->Map.length;
       bool found = true;
 
+      // consume any OS-tracked dirty pages. If the watch is valid and nothing was written since
+      // the last barrier, the map can be skipped without touching its contents at all.
+      bool watchValid = false;
+      std::vector<DiffRange> dirtyPages;
+
+      if(record->Map.writeWatched)
+        watchValid = WriteWatch::GetAndResetDirtyRanges(record->Map.ptr,
+                                                        (size_t)record->Map.length, dirtyPages);
+
+      if(watchValid && dirtyPages.empty())
+        continue;
+
       if(record->GetShadowPtr(0))
-        found = FindDiffRange(record->GetShadowPtr(0), record->Map.ptr, (size_t)record->Map.length,
-                              diffStart, diffEnd);
+      {
+        if(watchValid)
+        {
+          // only compare between the first and last written page, refining the page-granular
+          // bounds down to bytes
+          size_t offs = dirtyPages.front().start;
+
+          found = FindDiffRange(record->GetShadowPtr(0) + offs, record->Map.ptr + offs,
+                                dirtyPages.back().end - offs, diffStart, diffEnd);
+
+          diffStart += offs;
+          diffEnd += offs;
+        }
+        else
+        {
+          found = FindDiffRange(record->GetShadowPtr(0), record->Map.ptr,
+                                (size_t)record->Map.length, diffStart, diffEnd);
+        }
+      }
 
       if(found && diffEnd > diffStart)
       {
@@ -4720,6 +4835,12 @@ void WrappedOpenGL::glDeleteBuffers(GLsizei n, const GLuint *buffers)
           m_PersistentMaps.erase(record);
           if(record->Map.access & GL_MAP_COHERENT_BIT)
             m_CoherentMaps.erase(record);
+
+          if(record->Map.writeWatched)
+          {
+            WriteWatch::StopTracking(record->Map.ptr, (size_t)record->Map.length);
+            record->Map.writeWatched = false;
+          }
         }
 
         // free any shadow storage
@@ -3512,11 +3512,11 @@ void WrappedOpenGL::glClearNamedFramebufferfv(GLuint framebuffer, GLenum buffer,
     state.FetchState(this);
     state.MarkReferenced(this, false);
   }
-  else if(IsBackgroundCapturing(m_State))
-  {
-    GLRenderState state;
-    state.MarkDirty(this);
-  }
+
+  // the clear writes to the FBO's attachments - mark them dirty so they get snapshotted at the
+  // start of the next capture.
+  if(IsCaptureMode(m_State))
+    GetResourceManager()->MarkFBOAttachmentsDirty(FramebufferRes(GetCtx(), framebuffer));
 }
 
 void WrappedOpenGL::glClearBufferfv(GLenum buffer, GLint drawbuffer, const GLfloat *value)
@@ -3539,6 +3539,11 @@ void WrappedOpenGL::glClearBufferfv(GLenum buffer, GLint drawbuffer, const GLflo
 
     GetContextRecord()->AddChunk(scope.Get());
   }
+
+  // the clear writes to the draw FBO's attachments - mark them dirty so they get snapshotted at
+  // the start of the next capture.
+  if(IsCaptureMode(m_State) && GetCtxData().m_DrawFramebufferRecord)
+    GetResourceManager()->MarkFBOAttachmentsDirty(GetCtxData().m_DrawFramebufferRecord->Resource);
 }
 
 template <typename SerialiserType>
@@ -3634,6 +3639,11 @@ void WrappedOpenGL::glClearNamedFramebufferiv(GLuint framebuffer, GLenum buffer,
 
     GetContextRecord()->AddChunk(scope.Get());
   }
+
+  // the clear writes to the FBO's attachments - mark them dirty so they get snapshotted at the
+  // start of the next capture.
+  if(IsCaptureMode(m_State))
+    GetResourceManager()->MarkFBOAttachmentsDirty(FramebufferRes(GetCtx(), framebuffer));
 }
 
 void WrappedOpenGL::glClearBufferiv(GLenum buffer, GLint drawbuffer, const GLint *value)
@@ -3656,6 +3666,11 @@ void WrappedOpenGL::glClearBufferiv(GLenum buffer, GLint drawbuffer, const GLint
 
     GetContextRecord()->AddChunk(scope.Get());
   }
+
+  // the clear writes to the draw FBO's attachments - mark them dirty so they get snapshotted at
+  // the start of the next capture.
+  if(IsCaptureMode(m_State) && GetCtxData().m_DrawFramebufferRecord)
+    GetResourceManager()->MarkFBOAttachmentsDirty(GetCtxData().m_DrawFramebufferRecord->Resource);
 }
 
 template <typename SerialiserType>
@@ -3739,6 +3754,11 @@ void WrappedOpenGL::glClearNamedFramebufferuiv(GLuint framebuffer, GLenum buffer
 
     GetContextRecord()->AddChunk(scope.Get());
   }
+
+  // the clear writes to the FBO's attachments - mark them dirty so they get snapshotted at the
+  // start of the next capture.
+  if(IsCaptureMode(m_State))
+    GetResourceManager()->MarkFBOAttachmentsDirty(FramebufferRes(GetCtx(), framebuffer));
 }
 
 void WrappedOpenGL::glClearBufferuiv(GLenum buffer, GLint drawbuffer, const GLuint *value)
@@ -3761,6 +3781,11 @@ void WrappedOpenGL::glClearBufferuiv(GLenum buffer, GLint drawbuffer, const GLui
 
     GetContextRecord()->AddChunk(scope.Get());
   }
+
+  // the clear writes to the draw FBO's attachments - mark them dirty so they get snapshotted at
+  // the start of the next capture.
+  if(IsCaptureMode(m_State) && GetCtxData().m_DrawFramebufferRecord)
+    GetResourceManager()->MarkFBOAttachmentsDirty(GetCtxData().m_DrawFramebufferRecord->Resource);
 }
 
 template <typename SerialiserType>
@@ -3862,6 +3887,11 @@ void WrappedOpenGL::glClearNamedFramebufferfi(GLuint framebuffer, GLenum buffer,
 
     GetContextRecord()->AddChunk(scope.Get());
   }
+
+  // the clear writes to the FBO's attachments - mark them dirty so they get snapshotted at the
+  // start of the next capture.
+  if(IsCaptureMode(m_State))
+    GetResourceManager()->MarkFBOAttachmentsDirty(FramebufferRes(GetCtx(), framebuffer));
 }
 
 void WrappedOpenGL::glClearBufferfi(GLenum buffer, GLint drawbuffer, GLfloat depth, GLint stencil)
@@ -3884,6 +3914,11 @@ void WrappedOpenGL::glClearBufferfi(GLenum buffer, GLint drawbuffer, GLfloat dep
 
     GetContextRecord()->AddChunk(scope.Get());
   }
+
+  // the clear writes to the draw FBO's attachments - mark them dirty so they get snapshotted at
+  // the start of the next capture.
+  if(IsCaptureMode(m_State) && GetCtxData().m_DrawFramebufferRecord)
+    GetResourceManager()->MarkFBOAttachmentsDirty(GetCtxData().m_DrawFramebufferRecord->Resource);
 }
 
 template <typename SerialiserType>
@@ -4329,6 +4364,11 @@ void WrappedOpenGL::glClear(GLbitfield mask)
 
     GetContextRecord()->AddChunk(scope.Get());
   }
+
+  // the clear writes to the draw FBO's attachments - mark them dirty so they get snapshotted at
+  // the start of the next capture.
+  if(IsCaptureMode(m_State) && GetCtxData().m_DrawFramebufferRecord)
+    GetResourceManager()->MarkFBOAttachmentsDirty(GetCtxData().m_DrawFramebufferRecord->Resource);
 }
 
 template <typename SerialiserType>
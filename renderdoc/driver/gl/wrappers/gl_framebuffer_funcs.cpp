@@ -189,10 +189,9 @@ void WrappedOpenGL::glNamedFramebufferTextureEXT(GLuint framebuffer, GLenum atta
     GLResourceRecord *record =
         GetResourceManager()->GetResourceRecord(FramebufferRes(GetCtx(), framebuffer));
 
-    if(texture != 0 && GetResourceManager()->HasResourceRecord(TextureRes(GetCtx(), texture)))
-    {
-      GetResourceManager()->MarkDirtyResource(TextureRes(GetCtx(), texture));
-    }
+    // attaching is not treated as a write - the attachments are marked dirty when the FBO is
+    // actually written to (draws, clears, blits), so a texture that's only ever attached can be
+    // serialised from its creation chunks without a contents snapshot at capture start.
 
     if(m_HighTrafficResources.find(record->GetResourceID()) != m_HighTrafficResources.end() &&
        IsBackgroundCapturing(m_State))
@@ -242,10 +241,9 @@ void WrappedOpenGL::glFramebufferTexture(GLenum target, GLenum attachment, GLuin
         record = GetCtxData().m_ReadFramebufferRecord;
     }
 
-    if(texture != 0 && GetResourceManager()->HasResourceRecord(TextureRes(GetCtx(), texture)))
-    {
-      GetResourceManager()->MarkDirtyResource(TextureRes(GetCtx(), texture));
-    }
+    // attaching is not treated as a write - the attachments are marked dirty when the FBO is
+    // actually written to (draws, clears, blits), so a texture that's only ever attached can be
+    // serialised from its creation chunks without a contents snapshot at capture start.
 
     if(m_HighTrafficResources.find(record->GetResourceID()) != m_HighTrafficResources.end() &&
        IsBackgroundCapturing(m_State))
@@ -323,10 +321,9 @@ void WrappedOpenGL::glNamedFramebufferTexture1DEXT(GLuint framebuffer, GLenum at
     GLResourceRecord *record =
         GetResourceManager()->GetResourceRecord(FramebufferRes(GetCtx(), framebuffer));
 
-    if(texture != 0 && GetResourceManager()->HasResourceRecord(TextureRes(GetCtx(), texture)))
-    {
-      GetResourceManager()->MarkDirtyResource(TextureRes(GetCtx(), texture));
-    }
+    // attaching is not treated as a write - the attachments are marked dirty when the FBO is
+    // actually written to (draws, clears, blits), so a texture that's only ever attached can be
+    // serialised from its creation chunks without a contents snapshot at capture start.
 
     if(m_HighTrafficResources.find(record->GetResourceID()) != m_HighTrafficResources.end() &&
        IsBackgroundCapturing(m_State))
@@ -377,10 +374,9 @@ void WrappedOpenGL::glFramebufferTexture1D(GLenum target, GLenum attachment, GLe
         record = GetCtxData().m_ReadFramebufferRecord;
     }
 
-    if(texture != 0 && GetResourceManager()->HasResourceRecord(TextureRes(GetCtx(), texture)))
-    {
-      GetResourceManager()->MarkDirtyResource(TextureRes(GetCtx(), texture));
-    }
+    // attaching is not treated as a write - the attachments are marked dirty when the FBO is
+    // actually written to (draws, clears, blits), so a texture that's only ever attached can be
+    // serialised from its creation chunks without a contents snapshot at capture start.
 
     if(m_HighTrafficResources.find(record->GetResourceID()) != m_HighTrafficResources.end() &&
        IsBackgroundCapturing(m_State))
@@ -459,10 +455,9 @@ void WrappedOpenGL::glNamedFramebufferTexture2DEXT(GLuint framebuffer, GLenum at
     GLResourceRecord *record =
         GetResourceManager()->GetResourceRecord(FramebufferRes(GetCtx(), framebuffer));
 
-    if(texture != 0 && GetResourceManager()->HasResourceRecord(TextureRes(GetCtx(), texture)))
-    {
-      GetResourceManager()->MarkDirtyResource(TextureRes(GetCtx(), texture));
-    }
+    // attaching is not treated as a write - the attachments are marked dirty when the FBO is
+    // actually written to (draws, clears, blits), so a texture that's only ever attached can be
+    // serialised from its creation chunks without a contents snapshot at capture start.
 
     if(m_HighTrafficResources.find(record->GetResourceID()) != m_HighTrafficResources.end() &&
        IsBackgroundCapturing(m_State))
@@ -513,10 +508,9 @@ void WrappedOpenGL::glFramebufferTexture2D(GLenum target, GLenum attachment, GLe
         record = GetCtxData().m_ReadFramebufferRecord;
     }
 
-    if(texture != 0 && GetResourceManager()->HasResourceRecord(TextureRes(GetCtx(), texture)))
-    {
-      GetResourceManager()->MarkDirtyResource(TextureRes(GetCtx(), texture));
-    }
+    // attaching is not treated as a write - the attachments are marked dirty when the FBO is
+    // actually written to (draws, clears, blits), so a texture that's only ever attached can be
+    // serialised from its creation chunks without a contents snapshot at capture start.
 
     if(m_HighTrafficResources.find(record->GetResourceID()) != m_HighTrafficResources.end() &&
        IsBackgroundCapturing(m_State))
@@ -619,10 +613,9 @@ void WrappedOpenGL::glFramebufferTexture2DMultisampleEXT(GLenum target, GLenum a
         record = GetCtxData().m_ReadFramebufferRecord;
     }
 
-    if(texture != 0 && GetResourceManager()->HasResourceRecord(TextureRes(GetCtx(), texture)))
-    {
-      GetResourceManager()->MarkDirtyResource(TextureRes(GetCtx(), texture));
-    }
+    // attaching is not treated as a write - the attachments are marked dirty when the FBO is
+    // actually written to (draws, clears, blits), so a texture that's only ever attached can be
+    // serialised from its creation chunks without a contents snapshot at capture start.
 
     if(m_HighTrafficResources.find(record->GetResourceID()) != m_HighTrafficResources.end() &&
        IsBackgroundCapturing(m_State))
@@ -705,10 +698,9 @@ void WrappedOpenGL::glNamedFramebufferTexture3DEXT(GLuint framebuffer, GLenum at
     GLResourceRecord *record =
         GetResourceManager()->GetResourceRecord(FramebufferRes(GetCtx(), framebuffer));
 
-    if(texture != 0 && GetResourceManager()->HasResourceRecord(TextureRes(GetCtx(), texture)))
-    {
-      GetResourceManager()->MarkDirtyResource(TextureRes(GetCtx(), texture));
-    }
+    // attaching is not treated as a write - the attachments are marked dirty when the FBO is
+    // actually written to (draws, clears, blits), so a texture that's only ever attached can be
+    // serialised from its creation chunks without a contents snapshot at capture start.
 
     if(m_HighTrafficResources.find(record->GetResourceID()) != m_HighTrafficResources.end() &&
        IsBackgroundCapturing(m_State))
@@ -761,10 +753,9 @@ void WrappedOpenGL::glFramebufferTexture3D(GLenum target, GLenum attachment, GLe
         record = GetCtxData().m_ReadFramebufferRecord;
     }
 
-    if(texture != 0 && GetResourceManager()->HasResourceRecord(TextureRes(GetCtx(), texture)))
-    {
-      GetResourceManager()->MarkDirtyResource(TextureRes(GetCtx(), texture));
-    }
+    // attaching is not treated as a write - the attachments are marked dirty when the FBO is
+    // actually written to (draws, clears, blits), so a texture that's only ever attached can be
+    // serialised from its creation chunks without a contents snapshot at capture start.
 
     if(m_HighTrafficResources.find(record->GetResourceID()) != m_HighTrafficResources.end() &&
        IsBackgroundCapturing(m_State))
@@ -974,10 +965,9 @@ void WrappedOpenGL::glNamedFramebufferTextureLayerEXT(GLuint framebuffer, GLenum
     GLResourceRecord *record =
         GetResourceManager()->GetResourceRecord(FramebufferRes(GetCtx(), framebuffer));
 
-    if(texture != 0 && GetResourceManager()->HasResourceRecord(TextureRes(GetCtx(), texture)))
-    {
-      GetResourceManager()->MarkDirtyResource(TextureRes(GetCtx(), texture));
-    }
+    // attaching is not treated as a write - the attachments are marked dirty when the FBO is
+    // actually written to (draws, clears, blits), so a texture that's only ever attached can be
+    // serialised from its creation chunks without a contents snapshot at capture start.
 
     if(m_HighTrafficResources.find(record->GetResourceID()) != m_HighTrafficResources.end() &&
        IsBackgroundCapturing(m_State))
@@ -1028,10 +1018,9 @@ void WrappedOpenGL::glFramebufferTextureLayer(GLenum target, GLenum attachment,
         record = GetCtxData().m_ReadFramebufferRecord;
     }
 
-    if(texture != 0 && GetResourceManager()->HasResourceRecord(TextureRes(GetCtx(), texture)))
-    {
-      GetResourceManager()->MarkDirtyResource(TextureRes(GetCtx(), texture));
-    }
+    // attaching is not treated as a write - the attachments are marked dirty when the FBO is
+    // actually written to (draws, clears, blits), so a texture that's only ever attached can be
+    // serialised from its creation chunks without a contents snapshot at capture start.
 
     if(m_HighTrafficResources.find(record->GetResourceID()) != m_HighTrafficResources.end() &&
        IsBackgroundCapturing(m_State))
@@ -1131,10 +1120,9 @@ void WrappedOpenGL::glFramebufferTextureMultiviewOVR(GLenum target, GLenum attac
         record = GetCtxData().m_ReadFramebufferRecord;
     }
 
-    if(texture != 0 && GetResourceManager()->HasResourceRecord(TextureRes(GetCtx(), texture)))
-    {
-      GetResourceManager()->MarkDirtyResource(TextureRes(GetCtx(), texture));
-    }
+    // attaching is not treated as a write - the attachments are marked dirty when the FBO is
+    // actually written to (draws, clears, blits), so a texture that's only ever attached can be
+    // serialised from its creation chunks without a contents snapshot at capture start.
 
     if(m_HighTrafficResources.find(record->GetResourceID()) != m_HighTrafficResources.end() &&
        IsBackgroundCapturing(m_State))
@@ -1245,10 +1233,9 @@ void WrappedOpenGL::glFramebufferTextureMultisampleMultiviewOVR(GLenum target, G
         record = GetCtxData().m_ReadFramebufferRecord;
     }
 
-    if(texture != 0 && GetResourceManager()->HasResourceRecord(TextureRes(GetCtx(), texture)))
-    {
-      GetResourceManager()->MarkDirtyResource(TextureRes(GetCtx(), texture));
-    }
+    // attaching is not treated as a write - the attachments are marked dirty when the FBO is
+    // actually written to (draws, clears, blits), so a texture that's only ever attached can be
+    // serialised from its creation chunks without a contents snapshot at capture start.
 
     if(m_HighTrafficResources.find(record->GetResourceID()) != m_HighTrafficResources.end() &&
        IsBackgroundCapturing(m_State))
@@ -1939,6 +1926,11 @@ void WrappedOpenGL::glBlitNamedFramebuffer(GLuint readFramebuffer, GLuint drawFr
     GetResourceManager()->MarkFBOReferenced(FramebufferRes(GetCtx(), drawFramebuffer),
                                             eFrameRef_ReadBeforeWrite);
   }
+
+  // the blit writes to the draw FBO's attachments - mark them dirty so they get snapshotted at
+  // the start of the next capture.
+  if(IsCaptureMode(m_State))
+    GetResourceManager()->MarkFBOAttachmentsDirty(FramebufferRes(GetCtx(), drawFramebuffer));
 }
 
 void WrappedOpenGL::glBlitFramebuffer(GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1,
@@ -1970,6 +1962,11 @@ void WrappedOpenGL::glBlitFramebuffer(GLint srcX0, GLint srcY0, GLint srcX1, GLi
     GetResourceManager()->MarkFBOReferenced(FramebufferRes(GetCtx(), drawFramebuffer),
                                             eFrameRef_ReadBeforeWrite);
   }
+
+  // the blit writes to the draw FBO's attachments - mark them dirty so they get snapshotted at
+  // the start of the next capture.
+  if(IsCaptureMode(m_State) && GetCtxData().m_DrawFramebufferRecord)
+    GetResourceManager()->MarkFBOAttachmentsDirty(GetCtxData().m_DrawFramebufferRecord->Resource);
 }
 
 void WrappedOpenGL::glDeleteFramebuffers(GLsizei n, const GLuint *framebuffers)
@@ -862,7 +862,24 @@ bool WrappedOpenGL::Serialise_glLinkProgram(SerialiserType &ser, GLuint programH
       progDetails.glslangProgram = LinkProgramForReflection(glslangShaders);
     }
 
-    GL.glLinkProgram(program.name);
+    // loading a capture with thousands of programs spends nearly all of its time in the driver's
+    // linker, so try to restore the linked program from the binary cache first and only fall back
+    // to a real link on a miss (or if the driver rejects the cached binary).
+    if(!m_ProgramBinaryCacheOpen)
+      OpenProgramBinaryCache();
+
+    uint32_t binaryHash = m_ProgramBinaryCacheEnabled ? ProgramBinaryCacheHash(progid) : 0;
+
+    if(!TryRestoreProgramBinary(program.name, binaryHash))
+    {
+      // the hint must be set before linking for the binary to be reliably retrievable afterwards
+      if(m_ProgramBinaryCacheEnabled && binaryHash != 0)
+        GL.glProgramParameteri(program.name, eGL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
+      GL.glLinkProgram(program.name);
+
+      StoreProgramBinary(program.name, binaryHash);
+    }
 
     AddResourceInitChunk(program);
   }
@@ -1032,6 +1049,10 @@ bool WrappedOpenGL::Serialise_glBindAttribLocation(SerialiserType &ser, GLuint p
   {
     GL.glBindAttribLocation(program.name, index, name);
 
+    // fold this pre-link state into the program binary cache key
+    ProgramData &progDetails = m_Programs[GetResourceManager()->GetID(program)];
+    progDetails.prelinkHash = strhash(name, progDetails.prelinkHash + index);
+
     AddResourceInitChunk(program);
   }
 
@@ -1072,6 +1093,10 @@ bool WrappedOpenGL::Serialise_glBindFragDataLocation(SerialiserType &ser, GLuint
   {
     GL.glBindFragDataLocation(program.name, color, name);
 
+    // fold this pre-link state into the program binary cache key
+    ProgramData &progDetails = m_Programs[GetResourceManager()->GetID(program)];
+    progDetails.prelinkHash = strhash(name, progDetails.prelinkHash + color);
+
     AddResourceInitChunk(program);
   }
 
@@ -1148,6 +1173,10 @@ bool WrappedOpenGL::Serialise_glBindFragDataLocationIndexed(SerialiserType &ser,
   {
     GL.glBindFragDataLocationIndexed(program.name, colorNumber, index, name);
 
+    // fold this pre-link state into the program binary cache key
+    ProgramData &progDetails = m_Programs[GetResourceManager()->GetID(program)];
+    progDetails.prelinkHash = strhash(name, progDetails.prelinkHash + colorNumber * 2 + index);
+
     AddResourceInitChunk(program);
   }
 
@@ -1192,6 +1221,12 @@ bool WrappedOpenGL::Serialise_glTransformFeedbackVaryings(SerialiserType &ser, G
   {
     GL.glTransformFeedbackVaryings(program.name, count, varyings, bufferMode);
 
+    // fold this pre-link state into the program binary cache key
+    ProgramData &progDetails = m_Programs[GetResourceManager()->GetID(program)];
+    progDetails.prelinkHash = progDetails.prelinkHash * 33 + (uint32_t)bufferMode;
+    for(GLsizei i = 0; i < count; i++)
+      progDetails.prelinkHash = strhash(varyings[i], progDetails.prelinkHash);
+
     AddResourceInitChunk(program);
   }
 
@@ -1233,6 +1268,10 @@ bool WrappedOpenGL::Serialise_glProgramParameteri(SerialiserType &ser, GLuint pr
   {
     GL.glProgramParameteri(program.name, pname, value);
 
+    // fold this pre-link state into the program binary cache key
+    ProgramData &progDetails = m_Programs[GetResourceManager()->GetID(program)];
+    progDetails.prelinkHash = (progDetails.prelinkHash * 33 + (uint32_t)pname) * 33 + (uint32_t)value;
+
     AddResourceInitChunk(program);
   }
 
@@ -655,6 +655,13 @@ bool AMDCounters::IsSessionReady(uint32_t sessionIndex)
 
 void AMDCounters::BeginPass()
 {
+  // keep one pass in flight: the previous pass's readback is still completing on the GPU while
+  // we replay this one, but the pass before that must have finished. This overlaps replay with
+  // readback instead of idling between every pass, which matters when the full counter set needs
+  // dozens of passes.
+  if(m_passCounter > 0)
+    WaitForPassComplete((uint32_t)m_passCounter - 1);
+
   m_passCounter++;
 
   if(m_apiType == ApiType::Dx12 || m_apiType == ApiType::Vk)
@@ -667,6 +674,12 @@ void AMDCounters::BeginPass()
 }
 
 void AMDCounters::EndPass()
+{
+  // deliberately don't wait for this pass here - the next BeginPass() waits for it one pass
+  // late, and GetCounterData() waits for the whole session, so results are never read early.
+}
+
+void AMDCounters::WaitForPassComplete(uint32_t passIndex)
 {
   bool isReady = false;
 
@@ -677,13 +690,11 @@ void AMDCounters::EndPass()
   do
   {
     isReady =
-        GPA_STATUS_OK == m_pGPUPerfAPI->GPA_IsPassComplete(m_gpaSessionInfo.back(), m_passCounter);
+        GPA_STATUS_OK == m_pGPUPerfAPI->GPA_IsPassComplete(m_gpaSessionInfo.back(), passIndex);
     if(!isReady)
     {
       Threading::Sleep(0);
 
-      PerformanceTimer endTime;
-
       if(timeout.GetMilliseconds() > timeoutPeriod)
       {
         GPA_LoggingCallback(GPA_LOGGING_ERROR, "GPA_IsPassComplete failed due to elapsed timeout.");
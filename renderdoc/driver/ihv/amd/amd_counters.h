@@ -83,6 +83,7 @@ public:
 
 private:
   bool IsSessionReady(uint32_t sessionIndex);
+  void WaitForPassComplete(uint32_t passIndex);
 
   GPAFunctionTable *m_pGPUPerfAPI;
   GPA_ContextId m_gpaContextId;
@@ -1255,14 +1255,18 @@ static uint32_t PopCount(uint32_t x)
   return (((x + (x >> 4)) & 0x0F0F0F0F) * 0x01010101) >> 24;
 }
 
-State State::GetNext(GlobalState &global, State quad[4]) const
+void State::StepNext(State *next, GlobalState &global, State quad[4]) const
 {
-  State s = *this;
+  // the successor state is built up in *next so the simulation loop can step straight into its
+  // ping-pong destination. All sources are read from *this and quad, so one register file copy
+  // per instruction is all that's needed.
+  State &s = *next;
+  s = *this;
 
   s.modified.clear();
 
   if(s.nextInstruction >= s.dxbc->GetNumInstructions())
-    return s;
+    return;
 
   const ASMOperation &op = s.dxbc->GetInstruction((size_t)s.nextInstruction);
 
@@ -1921,7 +1925,7 @@ State State::GetNext(GlobalState &global, State quad[4]) const
       if(FAILED(hr))
       {
         RDCERR("Failed to create constant buf HRESULT: %s", ToStr(hr).c_str());
-        return s;
+        return;
       }
 
       context->CSSetConstantBuffers(0, 1, &constBuf);
@@ -1947,7 +1951,7 @@ State State::GetNext(GlobalState &global, State quad[4]) const
       if(FAILED(hr))
       {
         RDCERR("Failed to create UAV buf HRESULT: %s", ToStr(hr).c_str());
-        return s;
+        return;
       }
 
       bdesc.BindFlags = 0;
@@ -1959,7 +1963,7 @@ State State::GetNext(GlobalState &global, State quad[4]) const
       if(FAILED(hr))
       {
         RDCERR("Failed to create copy buf HRESULT: %s", ToStr(hr).c_str());
-        return s;
+        return;
       }
 
       D3D11_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
@@ -1975,7 +1979,7 @@ State State::GetNext(GlobalState &global, State quad[4]) const
       if(FAILED(hr))
       {
         RDCERR("Failed to create uav HRESULT: %s", ToStr(hr).c_str());
-        return s;
+        return;
       }
 
       context->CSSetUnorderedAccessViews(0, 1, &uav, NULL);
@@ -1989,7 +1993,7 @@ State State::GetNext(GlobalState &global, State quad[4]) const
       if(FAILED(hr))
       {
         RDCERR("Failed to map results HRESULT: %s", ToStr(hr).c_str());
-        return s;
+        return;
       }
 
       ShaderVariable calcResultA("calcA", 0.0f, 0.0f, 0.0f, 0.0f);
@@ -3928,7 +3932,7 @@ State State::GetNext(GlobalState &global, State quad[4]) const
 
           s.SetDst(op.operands[0], op, fetch);
 
-          return s;
+          return;
         }
         if(decl.declaration == OPCODE_DCL_RESOURCE && decl.operand.type == TYPE_RESOURCE &&
            decl.operand.indices.size() == 1 && decl.operand.indices[0] == op.operands[2].indices[0])
@@ -4547,7 +4551,7 @@ State State::GetNext(GlobalState &global, State quad[4]) const
       if(FAILED(hr))
       {
         RDCERR("Failed to create RT tex HRESULT: %s", ToStr(hr).c_str());
-        return s;
+        return;
       }
 
       tdesc.BindFlags = 0;
@@ -4559,7 +4563,7 @@ State State::GetNext(GlobalState &global, State quad[4]) const
       if(FAILED(hr))
       {
         RDCERR("Failed to create copy tex HRESULT: %s", ToStr(hr).c_str());
-        return s;
+        return;
       }
 
       D3D11_RENDER_TARGET_VIEW_DESC rtDesc;
@@ -4573,7 +4577,7 @@ State State::GetNext(GlobalState &global, State quad[4]) const
       if(FAILED(hr))
       {
         RDCERR("Failed to create rt rtv HRESULT: %s", ToStr(hr).c_str());
-        return s;
+        return;
       }
 
       context->OMSetRenderTargetsAndUnorderedAccessViews(1, &rtv, NULL, 0, 0, NULL, NULL);
@@ -4587,7 +4591,7 @@ State State::GetNext(GlobalState &global, State quad[4]) const
       if(FAILED(hr))
       {
         RDCERR("Failed to map results HRESULT: %s", ToStr(hr).c_str());
-        return s;
+        return;
       }
 
       ShaderVariable lookupResult("tex", 0.0f, 0.0f, 0.0f, 0.0f);
@@ -4877,8 +4881,55 @@ State State::GetNext(GlobalState &global, State quad[4]) const
       break;
     }
   }
+}
+
+ShaderDebugState MakePartialState(const ShaderDebugState &prev, const ShaderDebugState &next)
+{
+  ShaderDebugState partial;
+
+  partial.locals = next.locals;
+  partial.modified = next.modified;
+  partial.nextInstruction = next.nextInstruction;
+  partial.flags = next.flags | ShaderEvents::PartialState;
+
+  // diff against the previous state rather than trusting next.modified - some writes (e.g. to
+  // depth output and other semantic outputs) aren't tracked there.
+  RegisterRange range;
+
+  range.type = RegisterType::Temporary;
+  for(size_t i = 0; i < next.registers.size() && i < prev.registers.size(); i++)
+  {
+    if(!(prev.registers[i] == next.registers[i]))
+    {
+      range.index = uint16_t(i);
+      partial.partialLocations.push_back(range);
+      partial.registers.push_back(next.registers[i]);
+    }
+  }
+
+  range.type = RegisterType::Output;
+  for(size_t i = 0; i < next.outputs.size() && i < prev.outputs.size(); i++)
+  {
+    if(!(prev.outputs[i] == next.outputs[i]))
+    {
+      range.index = uint16_t(i);
+      partial.partialLocations.push_back(range);
+      partial.outputs.push_back(next.outputs[i]);
+    }
+  }
+
+  range.type = RegisterType::IndexedTemporary;
+  for(size_t i = 0; i < next.indexableTemps.size() && i < prev.indexableTemps.size(); i++)
+  {
+    if(!(prev.indexableTemps[i] == next.indexableTemps[i]))
+    {
+      range.index = uint16_t(i);
+      partial.partialLocations.push_back(range);
+      partial.indexableTemps.push_back(next.indexableTemps[i]);
+    }
+  }
 
-  return s;
+  return partial;
 }
 
 };    // namespace ShaderDebug
@@ -192,7 +192,10 @@ public:
   void Init();
   bool Finished() const;
 
-  State GetNext(GlobalState &global, State quad[4]) const;
+  // executes the next instruction, writing the successor state into *next (which must not alias
+  // this or any member of quad). The simulation loops step straight into their ping-pong
+  // destination this way, so each instruction costs a single register file copy.
+  void StepNext(State *next, GlobalState &global, State quad[4]) const;
 
 private:
   // index in the pixel quad
@@ -225,4 +228,10 @@ private:
   WrappedID3D11Device *device;
 };
 
+// builds a copy of next that stores only the variables that differ from prev, with
+// ShaderEvents::PartialState set in flags and the variable locations listed in partialLocations.
+// Long simulation loops store these between periodic full snapshots to keep traces within a
+// memory budget - the UI reconstructs full contents on demand from the nearest full state.
+ShaderDebugState MakePartialState(const ShaderDebugState &prev, const ShaderDebugState &next);
+
 };    // namespace ShaderDebug
@@ -26,6 +26,8 @@
 #include "dxbc_disassemble.h"
 #include <math.h>
 #include "common/common.h"
+#include "common/shader_cache.h"
+#include "common/threading.h"
 #include "core/core.h"
 #include "serialise/serialiser.h"
 #include "strings/string_utils.h"
@@ -470,6 +472,98 @@ void DXBCFile::DisassembleHexDump()
   m_Instructions.push_back(implicitRet);
 }
 
+/////////////////////////////////////////////////////////////////////////
+// Disassembly cache
+
+// captures typically share most of their shaders with other captures of the same application, so
+// the formatted disassembly text is kept in a disk cache keyed by the shader's embedded hash, and
+// consulted before formatting. The cache file's key is only 32 bits, so each value blob is
+// prefixed with the full 16-byte hash plus the friendly-naming flag (which changes the text) to
+// validate a hit.
+
+struct DisasmCacheCallbacks
+{
+  bool Create(uint32_t byteLen, byte *data, std::string *ret) const
+  {
+    ret->assign((const char *)data, byteLen);
+    return true;
+  }
+  uint32_t GetSize(const std::string &blob) const { return (uint32_t)blob.size(); }
+  const byte *GetData(const std::string &blob) const { return (const byte *)blob.data(); }
+  void Destroy(const std::string &blob) const {}
+};
+
+static const uint32_t disasmCacheMagic = 0xd15a53b1;
+static const uint32_t disasmCacheVersion = 1;
+static const size_t disasmBlobPrefixSize = sizeof(uint32_t) * 4 + 1;
+
+static Threading::CriticalSection disasmCacheLock;
+static bool disasmCacheLoaded = false;
+static bool disasmCacheDirty = false;
+static std::map<uint32_t, std::string> disasmCache;
+
+static void SaveDisassemblyCache()
+{
+  SCOPED_LOCK(disasmCacheLock);
+
+  if(disasmCacheDirty)
+    SaveShaderCache("dxbcdisasm.cache", disasmCacheMagic, disasmCacheVersion, disasmCache,
+                    DisasmCacheCallbacks());
+
+  disasmCache.clear();
+  disasmCacheDirty = false;
+}
+
+// must be called with disasmCacheLock held
+static void EnsureDisassemblyCacheLoaded()
+{
+  if(disasmCacheLoaded)
+    return;
+
+  disasmCacheLoaded = true;
+
+  LoadShaderCache("dxbcdisasm.cache", disasmCacheMagic, disasmCacheVersion, disasmCache,
+                  DisasmCacheCallbacks());
+
+  RenderDoc::Inst().RegisterShutdownFunction(&SaveDisassemblyCache);
+}
+
+static bool GetCachedDisassembly(const uint32_t hash[4], bool friendly, std::string &disasm)
+{
+  SCOPED_LOCK(disasmCacheLock);
+
+  EnsureDisassemblyCacheLoaded();
+
+  auto it = disasmCache.find(hash[0]);
+
+  if(it == disasmCache.end() || it->second.size() < disasmBlobPrefixSize ||
+     memcmp(it->second.data(), hash, sizeof(uint32_t) * 4) != 0 ||
+     it->second[sizeof(uint32_t) * 4] != (char)friendly)
+    return false;
+
+  disasm = it->second.substr(disasmBlobPrefixSize);
+  return true;
+}
+
+static void CacheDisassembly(const uint32_t hash[4], bool friendly, const std::string &disasm)
+{
+  SCOPED_LOCK(disasmCacheLock);
+
+  EnsureDisassemblyCacheLoaded();
+
+  std::string &blob = disasmCache[hash[0]];
+
+  // keep the existing entry on a 32-bit key collision, or if the shader is already cached
+  if(!blob.empty())
+    return;
+
+  blob.assign((const char *)hash, sizeof(uint32_t) * 4);
+  blob += (char)friendly;
+  blob += disasm;
+
+  disasmCacheDirty = true;
+}
+
 void DXBCFile::MakeDisassemblyString()
 {
   DisassembleHexDump();
@@ -477,27 +571,36 @@ void DXBCFile::MakeDisassemblyString()
   uint32_t *hash =
       (uint32_t *)&m_ShaderBlob[4];    // hash is 4 uints, starting after the FOURCC of 'DXBC'
 
-  m_Disassembly =
-      StringFormat::Fmt("Shader hash %08x-%08x-%08x-%08x\n\n", hash[0], hash[1], hash[2], hash[3]);
-
   if(m_HexDump.empty())
   {
     m_Disassembly = "No bytecode in this blob";
     return;
   }
 
+  const bool friendly = RenderDoc::Inst().GetConfigSetting("Disassembly_FriendlyNaming") != "0";
+
+  if(GetCachedDisassembly(hash, friendly, m_Disassembly))
+    return;
+
+  // build into chunks and assemble the final contiguous string only once at the end - appending
+  // multi-MB shaders to a single string re-copies it every time the buffer grows
+  StringBuilder disasm;
+
+  disasm +=
+      StringFormat::Fmt("Shader hash %08x-%08x-%08x-%08x\n\n", hash[0], hash[1], hash[2], hash[3]);
+
   switch(m_Type)
   {
-    case D3D11_ShaderType_Pixel: m_Disassembly += "ps_"; break;
-    case D3D11_ShaderType_Vertex: m_Disassembly += "vs_"; break;
-    case D3D11_ShaderType_Geometry: m_Disassembly += "gs_"; break;
-    case D3D11_ShaderType_Hull: m_Disassembly += "hs_"; break;
-    case D3D11_ShaderType_Domain: m_Disassembly += "ds_"; break;
-    case D3D11_ShaderType_Compute: m_Disassembly += "cs_"; break;
+    case D3D11_ShaderType_Pixel: disasm += "ps_"; break;
+    case D3D11_ShaderType_Vertex: disasm += "vs_"; break;
+    case D3D11_ShaderType_Geometry: disasm += "gs_"; break;
+    case D3D11_ShaderType_Hull: disasm += "hs_"; break;
+    case D3D11_ShaderType_Domain: disasm += "ds_"; break;
+    case D3D11_ShaderType_Compute: disasm += "cs_"; break;
     default: RDCERR("Unknown shader type: %u", m_Type); break;
   }
 
-  m_Disassembly += StringFormat::Fmt("%d_%d\n", m_Version.Major, m_Version.Minor);
+  disasm += StringFormat::Fmt("%d_%d\n", m_Version.Major, m_Version.Minor);
 
   int indent = 0;
 
@@ -509,6 +612,9 @@ void DXBCFile::MakeDisassemblyString()
 
   std::vector<std::vector<std::string>> fileLines;
 
+  // make sure any embedded debug info has been parsed, so source can be interleaved below
+  GetDebugInfo();
+
   // generate fileLines by splitting each file in the debug info
   if(m_DebugInfo)
   {
@@ -525,13 +631,13 @@ void DXBCFile::MakeDisassemblyString()
       if(m_Declarations[d].instruction > i)
       {
         if(i == 0)
-          m_Disassembly += "\n";
+          disasm += "\n";
         break;
       }
 
-      m_Disassembly += "      ";
-      m_Disassembly += m_Declarations[d].str;
-      m_Disassembly += "\n";
+      disasm += "      ";
+      disasm += m_Declarations[d].str;
+      disasm += "\n";
     }
 
     if(m_Instructions[i].operation == OPCODE_ENDIF || m_Instructions[i].operation == OPCODE_ENDLOOP)
@@ -575,38 +681,38 @@ void DXBCFile::MakeDisassemblyString()
         if(startLine != string::npos)
           line = line.substr(startLine);
 
-        m_Disassembly += "\n";
+        disasm += "\n";
 
         if(((lineInfo.fileIndex != prevLineInfo.fileIndex ||
              lineInfo.callstack.back() != prevLineInfo.callstack.back()) &&
             lineInfo.fileIndex < (int32_t)fileLines.size()) ||
            line == "")
         {
-          m_Disassembly += "      ";    // "0000: "
+          disasm += "      ";    // "0000: "
           for(int in = 0; in < indent; in++)
-            m_Disassembly += "  ";
+            disasm += "  ";
 
           std::string func = lineInfo.callstack.back();
 
           if(!func.empty())
           {
-            m_Disassembly += StringFormat::Fmt("%s:%d - %s()\n",
+            disasm += StringFormat::Fmt("%s:%d - %s()\n",
                                                m_DebugInfo->Files[lineInfo.fileIndex].first.c_str(),
                                                lineInfo.lineStart, func.c_str());
           }
           else
           {
-            m_Disassembly += StringFormat::Fmt(
+            disasm += StringFormat::Fmt(
                 "%s:%d\n", m_DebugInfo->Files[lineInfo.fileIndex].first.c_str(), lineInfo.lineStart);
           }
         }
 
         if(line != "")
         {
-          m_Disassembly += "      ";    // "0000: "
+          disasm += "      ";    // "0000: "
           for(int in = 0; in < indent; in++)
-            m_Disassembly += "  ";
-          m_Disassembly += line + "\n";
+            disasm += "  ";
+          disasm += line + "\n";
         }
       }
 
@@ -615,11 +721,11 @@ void DXBCFile::MakeDisassemblyString()
 
     char buf[64] = {0};
     StringFormat::snprintf(buf, 63, "% 4u", i);
-    m_Disassembly += buf;
-    m_Disassembly += ": ";
+    disasm += buf;
+    disasm += ": ";
     for(int in = 0; in < indent - (m_Instructions[i].operation == OPCODE_ELSE ? 1 : 0); in++)
-      m_Disassembly += "  ";
-    m_Disassembly += m_Instructions[i].str + "\n";
+      disasm += "  ";
+    disasm += m_Instructions[i].str + "\n";
 
     if(m_Instructions[i].operation == OPCODE_IF || m_Instructions[i].operation == OPCODE_LOOP)
     {
@@ -631,6 +737,10 @@ void DXBCFile::MakeDisassemblyString()
        m_Instructions[i].operation != OPCODE_HS_JOIN_PHASE)
       debugInst++;
   }
+
+  m_Disassembly = disasm.str();
+
+  CacheDisassembly(hash, friendly, m_Disassembly);
 }
 
 bool DXBCFile::IsDeclaration(OpcodeType op)
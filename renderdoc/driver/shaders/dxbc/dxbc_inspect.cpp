@@ -539,6 +539,7 @@ string DXBCFile::GetDebugBinaryPath(const void *ByteCode, size_t ByteCodeLength)
 DXBCFile::DXBCFile(const void *ByteCode, size_t ByteCodeLength)
 {
   m_DebugInfo = NULL;
+  m_DebugChunkIndex = ~0U;
 
   m_Disassembled = false;
 
@@ -1067,19 +1068,35 @@ DXBCFile::DXBCFile(const void *ByteCode, size_t ByteCodeLength)
     FetchComputeProperties();
   }
 
-  // initialise debug chunks last
+  // record where the debug chunk lives, but don't parse it yet - that's deferred until
+  // GetDebugInfo() is first called. The shader blob is retained in m_ShaderBlob so the chunk can
+  // always be revisited later.
   for(uint32_t chunkIdx = 0; chunkIdx < header->numChunks; chunkIdx++)
   {
     uint32_t *fourcc = (uint32_t *)(data + chunkOffsets[chunkIdx]);
 
-    if(*fourcc == FOURCC_SDBG)
-    {
-      m_DebugInfo = new SDBGChunk(fourcc);
-    }
-    else if(*fourcc == FOURCC_SPDB)
-    {
-      m_DebugInfo = new SPDBChunk(this, fourcc);
-    }
+    if(*fourcc == FOURCC_SDBG || *fourcc == FOURCC_SPDB)
+      m_DebugChunkIndex = chunkIdx;
+  }
+}
+
+void DXBCFile::ParseDebugInfo()
+{
+  char *data = (char *)&m_ShaderBlob[0];    // just for convenience
+
+  FileHeader *header = (FileHeader *)&m_ShaderBlob[0];
+
+  uint32_t *chunkOffsets = (uint32_t *)(header + 1);    // right after the header
+
+  uint32_t *fourcc = (uint32_t *)(data + chunkOffsets[m_DebugChunkIndex]);
+
+  if(*fourcc == FOURCC_SDBG)
+  {
+    m_DebugInfo = new SDBGChunk(fourcc);
+  }
+  else if(*fourcc == FOURCC_SPDB)
+  {
+    m_DebugInfo = new SPDBChunk(this, fourcc);
   }
 
   // we do a mini-preprocess of the files from the debug info to handle #line directives.
@@ -354,7 +354,6 @@ public:
   } m_Version;
 
   ShaderStatistics m_ShaderStats;
-  DXBCDebugChunk *m_DebugInfo;
 
   vector<uint32_t> m_Immediate;
 
@@ -387,6 +386,16 @@ public:
     return m_Disassembly;
   }
 
+  // the embedded debug chunk is only parsed on first access here, not during construction.
+  // Debug-enabled builds can embed very large PDB streams and most shaders never have their
+  // debug info inspected, so parsing them all eagerly dominates capture load time.
+  DXBCDebugChunk *GetDebugInfo()
+  {
+    if(m_DebugInfo == NULL && m_DebugChunkIndex != ~0U)
+      ParseDebugInfo();
+    return m_DebugInfo;
+  }
+
   size_t GetNumDeclarations() { return m_Declarations.size(); }
   const ASMDecl &GetDeclaration(size_t i) { return m_Declarations[i]; }
   size_t GetNumInstructions() { return m_Instructions.size(); }
@@ -406,8 +415,13 @@ private:
   void FetchTypeVersion();
   void DisassembleHexDump();
   void MakeDisassemblyString();
+  void ParseDebugInfo();
   void GuessResources();
 
+  DXBCDebugChunk *m_DebugInfo;
+  // index in the chunk list of the debug chunk recorded at construction, or ~0U if there's none.
+  uint32_t m_DebugChunkIndex;
+
   // these functions modify tokenStream pointer to point after the item
   // ExtractOperation/ExtractDecl returns false if not an operation (ie. it's a declaration)
   bool ExtractOperation(uint32_t *&tokenStream, ASMOperation &op, bool friendlyName);
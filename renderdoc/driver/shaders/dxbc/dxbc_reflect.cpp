@@ -216,22 +216,24 @@ void MakeShaderReflection(DXBC::DXBCFile *dxbc, ShaderReflection *refl,
 
   refl->entryPoint = "main";
 
-  if(dxbc->m_DebugInfo)
+  DXBC::DXBCDebugChunk *debugInfo = dxbc->GetDebugInfo();
+
+  if(debugInfo)
   {
-    refl->entryPoint = dxbc->m_DebugInfo->GetEntryFunction();
+    refl->entryPoint = debugInfo->GetEntryFunction();
 
     refl->debugInfo.encoding = ShaderEncoding::HLSL;
 
-    refl->debugInfo.compileFlags = DXBC::EncodeFlags(dxbc->m_DebugInfo);
+    refl->debugInfo.compileFlags = DXBC::EncodeFlags(debugInfo);
 
-    refl->debugInfo.files.resize(dxbc->m_DebugInfo->Files.size());
-    for(size_t i = 0; i < dxbc->m_DebugInfo->Files.size(); i++)
+    refl->debugInfo.files.resize(debugInfo->Files.size());
+    for(size_t i = 0; i < debugInfo->Files.size(); i++)
     {
-      refl->debugInfo.files[i].filename = dxbc->m_DebugInfo->Files[i].first;
-      refl->debugInfo.files[i].contents = dxbc->m_DebugInfo->Files[i].second;
+      refl->debugInfo.files[i].filename = debugInfo->Files[i].first;
+      refl->debugInfo.files[i].contents = debugInfo->Files[i].second;
     }
 
-    string entry = dxbc->m_DebugInfo->GetEntryFunction();
+    string entry = debugInfo->GetEntryFunction();
     if(entry.empty())
       entry = "main";
 
@@ -22,7 +22,10 @@
  * THE SOFTWARE.
  ******************************************************************************/
 
+#include <map>
 #include "common/common.h"
+#include "common/threading.h"
+#include "strings/string_utils.h"
 #include "spirv_common.h"
 
 #undef min
@@ -139,12 +142,56 @@ TBuiltInResource DefaultResources = {
     },
 };
 
+// memoised results of every compile this session. The internal debug/overlay/fetch shaders are
+// regenerated from identical source many times as output windows and overlays come and go, and
+// each glslang compile costs tens of milliseconds - far more than hashing the source again.
+struct CachedCompilation
+{
+  std::string errors;
+  std::vector<uint32_t> spirv;
+};
+
+static Threading::CriticalSection compileCacheLock;
+static std::map<uint32_t, CachedCompilation> compileCache;
+
+static uint32_t HashCompilation(const SPIRVCompilationSettings &settings,
+                                const std::vector<std::string> &sources)
+{
+  uint32_t hash = strhash(settings.entryPoint.c_str());
+
+  char typestr[3] = {'a', 'a', 0};
+  typestr[0] += (char)settings.stage;
+  typestr[1] += (char)settings.lang;
+  hash = strhash(typestr, hash);
+
+  for(const std::string &source : sources)
+    hash = strhash(source.c_str(), hash);
+
+  return hash;
+}
+
 string CompileSPIRV(const SPIRVCompilationSettings &settings,
                     const std::vector<std::string> &sources, vector<uint32_t> &spirv)
 {
   if(settings.stage == SPIRVShaderStage::Invalid)
     return "Invalid shader stage specified";
 
+  uint32_t cacheHash = HashCompilation(settings, sources);
+
+  {
+    SCOPED_LOCK(compileCacheLock);
+    auto it = compileCache.find(cacheHash);
+    if(it != compileCache.end())
+    {
+      spirv = it->second.spirv;
+      return it->second.errors;
+    }
+  }
+
+  // the compile itself runs outside the lock, so independent shaders can compile concurrently -
+  // glslang initialises its per-thread state lazily inside parse() as long as InitSPIRVCompiler()
+  // has been called once beforehand. Two threads racing on the same source just both compile and
+  // store identical results.
   string errors = "";
 
   const char **strs = new const char *[sources.size()];
@@ -219,6 +266,13 @@ string CompileSPIRV(const SPIRVCompilationSettings &settings,
 
   delete[] strs;
 
+  {
+    SCOPED_LOCK(compileCacheLock);
+    CachedCompilation &cached = compileCache[cacheHash];
+    cached.errors = errors;
+    cached.spirv = spirv;
+  }
+
   return errors;
 }
 
@@ -2337,15 +2337,18 @@ void FindFirstInstructionUse(SPVInstruction *op, SPVInstruction *search, SPVInst
 
 string SPVModule::Disassemble(const string &entryPoint)
 {
-  string retDisasm = "";
+  // build into chunks and assemble the final contiguous string only once at the end - appending
+  // multi-MB shaders to a single string re-copies it every time the buffer grows
+  StringBuilder retDisasm;
 
   // TODO filter to only functions/resources used by entryPoint
 
-  retDisasm = StringFormat::Fmt("SPIR-V %u.%u:\n\n", moduleVersion.major, moduleVersion.minor);
+  retDisasm += StringFormat::Fmt("SPIR-V %u.%u:\n\n", moduleVersion.major, moduleVersion.minor);
 
   if(moduleVersion.major != 1 || moduleVersion.minor != 0)
   {
-    return retDisasm + "Unsupported version";
+    retDisasm += "Unsupported version";
+    return retDisasm.str();
   }
 
   GeneratorID *gen = NULL;
@@ -3623,7 +3626,7 @@ string SPVModule::Disassemble(const string &entryPoint)
     retDisasm += StringFormat::Fmt("} // %s\n\n", funcs[f]->str.c_str());
   }
 
-  return retDisasm;
+  return retDisasm.str();
 }
 
 void MakeConstantBlockVariables(SPVTypeData *structType, uint32_t arraySize,
@@ -541,6 +541,27 @@ void VulkanReplay::FetchShaderFeedback(uint32_t eventId)
   std::map<SPIRVBinding, feedbackData> offsetMap;
 
   {
+    // gather the bindings that this pipeline's shaders actually declare. Bindless-style pipeline
+    // layouts are often shared and can contain far more (and far larger) array bindings than any
+    // one pipeline references, and we only need feedback storage for descriptors the shaders could
+    // possibly access - AnnotateShader only patches variables that exist in the SPIR-V anyway.
+    std::set<SPIRVBinding> declaredBindings;
+
+    for(const VulkanCreationInfo::Pipeline::Shader &sh : pipeInfo.shaders)
+    {
+      if(sh.mapping == NULL)
+        continue;
+
+      for(const Bindpoint &bind : sh.mapping->constantBlocks)
+        declaredBindings.insert(SPIRVBinding((uint32_t)bind.bindset, (uint32_t)bind.bind));
+      for(const Bindpoint &bind : sh.mapping->samplers)
+        declaredBindings.insert(SPIRVBinding((uint32_t)bind.bindset, (uint32_t)bind.bind));
+      for(const Bindpoint &bind : sh.mapping->readOnlyResources)
+        declaredBindings.insert(SPIRVBinding((uint32_t)bind.bindset, (uint32_t)bind.bind));
+      for(const Bindpoint &bind : sh.mapping->readWriteResources)
+        declaredBindings.insert(SPIRVBinding((uint32_t)bind.bindset, (uint32_t)bind.bind));
+    }
+
     const std::vector<ResourceId> &descSetLayoutIds =
         creationInfo.m_PipelineLayout[pipeInfo.layout].descSetLayouts;
 
@@ -565,6 +586,11 @@ void VulkanReplay::FetchShaderFeedback(uint32_t eventId)
         {
           key.binding = (uint32_t)binding;
 
+          // skip bindings none of the shaders declare - they can never be accessed, so don't
+          // allocate (or clear, or read back) feedback slots for them
+          if(declaredBindings.find(key) == declaredBindings.end())
+            continue;
+
           offsetMap[key] = {feedbackStorageSize, bindData.descriptorCount};
 
           feedbackStorageSize += bindData.descriptorCount * sizeof(uint32_t);
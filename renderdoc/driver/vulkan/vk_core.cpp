@@ -29,6 +29,7 @@
 #include "serialise/rdcfile.h"
 #include "strings/string_utils.h"
 #include "vk_debug.h"
+#include "vk_shader_cache.h"
 
 #include "stb/stb_image_write.h"
 
@@ -167,6 +168,9 @@ WrappedVulkan::WrappedVulkan() : m_RenderState(this, &m_CreationInfo)
 
 WrappedVulkan::~WrappedVulkan()
 {
+  // in case initialisation bailed out early, before the parse workers were drained
+  m_CreationInfo.ShutdownShaderParseWorkers();
+
   // records must be deleted before resource manager shutdown
   if(m_FrameCaptureRecord)
   {
@@ -1401,6 +1405,8 @@ void WrappedVulkan::StartFrameCapture(void *dev, void *wnd)
 
   m_SubmitCounter = 0;
 
+  m_CaptureSubmitGen++;
+
   m_FrameCounter = RDCMAX((uint32_t)m_CapturedFrames.size(), m_FrameCounter);
 
   FrameDescription frame;
@@ -1595,12 +1601,71 @@ bool WrappedVulkan::EndFrameCapture(void *dev, void *wnd)
 
     VkResult vkr = VK_SUCCESS;
 
+    // if the backbuffer is larger than the thumbnail needs, downscale it on the GPU first so the
+    // readback and CPU resample only touch thumbnail-sized data instead of the full backbuffer
+    VkExtent2D readbackExtent = {swapInfo.extent.width, swapInfo.extent.height};
+
+    VkImage downscaleIm = VK_NULL_HANDLE;
+    VkFilter downscaleFilter = VK_FILTER_NEAREST;
+
+    if(swapInfo.extent.width > maxSize)
+    {
+      VkFormatProperties props = {};
+      ObjDisp(GetPhysDev())->GetPhysicalDeviceFormatProperties(Unwrap(GetPhysDev()),
+                                                               swapInfo.format, &props);
+
+      const VkFormatFeatureFlags blitFeatures =
+          VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT;
+
+      // if the format can't be blitted we fall back to reading back the whole backbuffer
+      if((props.optimalTilingFeatures & blitFeatures) == blitFeatures)
+      {
+        if(props.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT)
+          downscaleFilter = VK_FILTER_LINEAR;
+
+        readbackExtent.height =
+            RDCMAX(1U, (swapInfo.extent.height * maxSize) / swapInfo.extent.width);
+        readbackExtent.width = maxSize;
+
+        VkImageCreateInfo imInfo = {
+            VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+            NULL,
+            0,
+            VK_IMAGE_TYPE_2D,
+            swapInfo.format,
+            {readbackExtent.width, readbackExtent.height, 1},
+            1,
+            1,
+            VK_SAMPLE_COUNT_1_BIT,
+            VK_IMAGE_TILING_OPTIMAL,
+            VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT,
+            VK_SHARING_MODE_EXCLUSIVE,
+            0,
+            NULL,
+            VK_IMAGE_LAYOUT_UNDEFINED,
+        };
+
+        // as with the readback buffer below, create & wrap manually so nothing is serialised
+        vkr = vt->CreateImage(Unwrap(device), &imInfo, NULL, &downscaleIm);
+        RDCASSERTEQUAL(vkr, VK_SUCCESS);
+
+        GetResourceManager()->WrapResource(Unwrap(device), downscaleIm);
+
+        MemoryAllocation downscaleMem = AllocateMemoryForResource(
+            downscaleIm, MemoryScope::InitialContents, MemoryType::GPULocal);
+
+        vkr = vt->BindImageMemory(Unwrap(device), Unwrap(downscaleIm), Unwrap(downscaleMem.mem),
+                                  downscaleMem.offs);
+        RDCASSERTEQUAL(vkr, VK_SUCCESS);
+      }
+    }
+
     // create readback buffer
     VkBufferCreateInfo bufInfo = {
         VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
         NULL,
         0,
-        GetByteSize(swapInfo.extent.width, swapInfo.extent.height, 1, swapInfo.format, 0),
+        GetByteSize(readbackExtent.width, readbackExtent.height, 1, swapInfo.format, 0),
         VK_BUFFER_USAGE_TRANSFER_DST_BIT,
     };
     vt->CreateBuffer(Unwrap(device), &bufInfo, NULL, &readbackBuf);
@@ -1622,7 +1687,7 @@ bool WrappedVulkan::EndFrameCapture(void *dev, void *wnd)
     vkr = vt->BeginCommandBuffer(Unwrap(cmd), &beginInfo);
     RDCASSERTEQUAL(vkr, VK_SUCCESS);
 
-    uint32_t rowPitch = GetByteSize(swapInfo.extent.width, 1, 1, swapInfo.format, 0);
+    uint32_t rowPitch = GetByteSize(readbackExtent.width, 1, 1, swapInfo.format, 0);
 
     VkBufferImageCopy cpy = {
         0,
@@ -1632,7 +1697,7 @@ bool WrappedVulkan::EndFrameCapture(void *dev, void *wnd)
         {
             0, 0, 0,
         },
-        {swapInfo.extent.width, swapInfo.extent.height, 1},
+        {readbackExtent.width, readbackExtent.height, 1},
     };
 
     uint32_t swapQueueIndex = m_ImageLayouts[GetResID(backbuffer)].queueFamilyIndex;
@@ -1669,8 +1734,49 @@ bool WrappedVulkan::EndFrameCapture(void *dev, void *wnd)
       SubmitAndFlushExtQueue(swapQueueIndex);
     }
 
-    vt->CmdCopyImageToBuffer(Unwrap(cmd), Unwrap(backbuffer), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-                             Unwrap(readbackBuf), 1, &cpy);
+    if(downscaleIm != VK_NULL_HANDLE)
+    {
+      VkImageMemoryBarrier downscaleBarrier = {
+          VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+          NULL,
+          0,
+          VK_ACCESS_TRANSFER_WRITE_BIT,
+          VK_IMAGE_LAYOUT_UNDEFINED,
+          VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+          VK_QUEUE_FAMILY_IGNORED,
+          VK_QUEUE_FAMILY_IGNORED,
+          Unwrap(downscaleIm),
+          {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1},
+      };
+
+      DoPipelineBarrier(cmd, 1, &downscaleBarrier);
+
+      VkImageBlit blit = {
+          {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1},
+          {{0, 0, 0}, {(int32_t)swapInfo.extent.width, (int32_t)swapInfo.extent.height, 1}},
+          {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1},
+          {{0, 0, 0}, {(int32_t)readbackExtent.width, (int32_t)readbackExtent.height, 1}},
+      };
+
+      vt->CmdBlitImage(Unwrap(cmd), Unwrap(backbuffer), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                       Unwrap(downscaleIm), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &blit,
+                       downscaleFilter);
+
+      downscaleBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+      downscaleBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+      downscaleBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+      downscaleBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+
+      DoPipelineBarrier(cmd, 1, &downscaleBarrier);
+
+      vt->CmdCopyImageToBuffer(Unwrap(cmd), Unwrap(downscaleIm),
+                               VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, Unwrap(readbackBuf), 1, &cpy);
+    }
+    else
+    {
+      vt->CmdCopyImageToBuffer(Unwrap(cmd), Unwrap(backbuffer),
+                               VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, Unwrap(readbackBuf), 1, &cpy);
+    }
 
     // barrier to switch backbuffer back to present layout
     std::swap(bbBarrier.oldLayout, bbBarrier.newLayout);
@@ -1740,9 +1846,15 @@ bool WrappedVulkan::EndFrameCapture(void *dev, void *wnd)
     vt->DestroyBuffer(Unwrap(device), Unwrap(readbackBuf), NULL);
     GetResourceManager()->ReleaseWrappedResource(readbackBuf);
 
+    if(downscaleIm != VK_NULL_HANDLE)
+    {
+      vt->DestroyImage(Unwrap(device), Unwrap(downscaleIm), NULL);
+      GetResourceManager()->ReleaseWrappedResource(downscaleIm);
+    }
+
     ResourceFormat fmt = MakeResourceFormat(swapInfo.format);
-    fp.width = swapInfo.extent.width;
-    fp.height = swapInfo.extent.height;
+    fp.width = readbackExtent.width;
+    fp.height = readbackExtent.height;
     fp.pitch = rowPitch;
     fp.stride = fmt.compByteWidth * fmt.compCount;
     fp.bpc = fmt.compByteWidth;
@@ -1788,11 +1900,16 @@ bool WrappedVulkan::EndFrameCapture(void *dev, void *wnd)
     captureWriter = new StreamWriter(StreamWriter::InvalidStream);
   }
 
+  std::vector<ChunkIndexEntry> chunkIndex;
+
   {
     WriteSerialiser ser(captureWriter, Ownership::Stream);
 
     ser.SetChunkMetadataRecording(GetThreadSerialiser().GetChunkMetadataRecording());
 
+    // record chunk offsets as we go, so we can write the chunk index section afterwards
+    ser.EnableChunkIndexing(true);
+
     ser.SetUserData(GetResourceManager());
 
     {
@@ -1811,6 +1928,7 @@ bool WrappedVulkan::EndFrameCapture(void *dev, void *wnd)
 
     GetResourceManager()->Serialise_InitialContentsNeeded(ser);
     GetResourceManager()->InsertDeviceMemoryRefs(ser);
+    GetResourceManager()->InsertImageRefs(ser);
 
     {
       SCOPED_SERIALISE_CHUNK(SystemChunk::CaptureScope, 16);
@@ -1857,8 +1975,15 @@ bool WrappedVulkan::EndFrameCapture(void *dev, void *wnd)
 
       RDCDEBUG("Done");
     }
+
+    chunkIndex.swap(ser.GetChunkIndex());
   }
 
+  // the frame capture section must be finished (above, when the serialiser is destroyed) before
+  // another section can be written
+  if(rdc)
+    WriteChunkIndex(rdc, chunkIndex);
+
   RenderDoc::Inst().FinishCaptureWriting(rdc, m_CapturedFrames.back().frameNumber);
 
   SAFE_DELETE(m_HeaderChunk);
@@ -1990,6 +2115,83 @@ void WrappedVulkan::AddResourceCurChunk(ResourceId id)
   AddResourceCurChunk(GetReplay()->GetResourceDesc(id));
 }
 
+void WrappedVulkan::CompileDeferredSubpass0Pipelines()
+{
+  if(m_DeferredSubpass0Pipes.empty())
+    return;
+
+  VkPipelineCache replayCache = GetShaderCache()->GetPipeCache();
+
+  // leave a core free for the rest of the load. The driver may spin up further compiler threads
+  // of its own, which is fine - this mostly covers drivers that do the expensive work on the
+  // calling thread.
+  uint32_t numThreads = RDCMAX(1U, Threading::NumberOfCores() - 1);
+  numThreads = RDCMIN(numThreads, (uint32_t)m_DeferredSubpass0Pipes.size());
+
+  RDCLOG("Compiling %zu deferred subpass0 pipelines on %u threads",
+         m_DeferredSubpass0Pipes.size(), numThreads);
+
+  volatile int32_t nextJob = 0;
+
+  std::vector<Threading::ThreadHandle> threads;
+
+  for(uint32_t t = 0; t < numThreads; t++)
+  {
+    threads.push_back(Threading::CreateThread([this, replayCache, &nextJob]() {
+      // each thread needs its own scratch since the create infos point into it
+      VulkanShaderCache::PipelineInfoScratch scratch;
+
+      for(;;)
+      {
+        int32_t i = Atomic::Inc32(&nextJob) - 1;
+        if(i >= (int32_t)m_DeferredSubpass0Pipes.size())
+          break;
+
+        ResourceId live = m_DeferredSubpass0Pipes[i];
+
+        VulkanCreationInfo::Pipeline &pipeInfo = m_CreationInfo.m_Pipeline[live];
+
+        VkGraphicsPipelineCreateInfo pipeCreateInfo;
+        GetShaderCache()->MakeGraphicsPipelineInfo(scratch, pipeCreateInfo, live);
+
+        // substitute the load RP for the original one, so the pipeline can be used when we begin
+        // a partial renderpass at subpass 0
+        pipeCreateInfo.renderPass =
+            m_CreationInfo.m_RenderPass[pipeInfo.renderpass].loadRPs[pipeInfo.subpass];
+        pipeCreateInfo.subpass = 0;
+
+        VkGraphicsPipelineCreateInfo *unwrapped = UnwrapInfos(&pipeCreateInfo, 1);
+        VkResult ret = ObjDisp(m_Device)->CreateGraphicsPipelines(
+            Unwrap(m_Device), replayCache, 1, unwrapped, NULL, &pipeInfo.subpass0pipe);
+        RDCASSERTEQUAL(ret, VK_SUCCESS);
+      }
+    }));
+  }
+
+  for(Threading::ThreadHandle thread : threads)
+  {
+    Threading::JoinThread(thread);
+    Threading::CloseThread(thread);
+  }
+
+  // wrap and register on the main thread, as resource manager bookkeeping isn't thread safe
+  for(ResourceId live : m_DeferredSubpass0Pipes)
+  {
+    VulkanCreationInfo::Pipeline &pipeInfo = m_CreationInfo.m_Pipeline[live];
+
+    if(pipeInfo.subpass0pipe == VK_NULL_HANDLE)
+      continue;
+
+    ResourceId subpass0id =
+        GetResourceManager()->WrapResource(Unwrap(m_Device), pipeInfo.subpass0pipe);
+
+    // register as a live-only resource, so it is cleaned up properly
+    GetResourceManager()->AddLiveResource(subpass0id, pipeInfo.subpass0pipe);
+  }
+
+  m_DeferredSubpass0Pipes.clear();
+}
+
 ReplayStatus WrappedVulkan::ReadLogInitialisation(RDCFile *rdc, bool storeStructuredBuffers)
 {
   int sectionIdx = rdc->SectionIndex(SectionType::FrameCapture);
@@ -2012,6 +2214,10 @@ ReplayStatus WrappedVulkan::ReadLogInitialisation(RDCFile *rdc, bool storeStruct
   ser.SetStringDatabase(&m_StringDB);
   ser.SetUserData(GetResourceManager());
 
+  // the chunk storage is the memory-mapped file which outlives replay, so strings and buffers
+  // can be deserialised as borrowed views instead of copies. No-op for compressed captures.
+  ser.EnableBorrowedViews(true);
+
   ser.ConfigureStructuredExport(&GetChunkName, storeStructuredBuffers);
 
   m_StructuredFile = &ser.GetStructuredFile();
@@ -2049,8 +2255,16 @@ ReplayStatus WrappedVulkan::ReadLogInitialisation(RDCFile *rdc, bool storeStruct
     if(reader->IsErrored())
       return ReplayStatus::APIDataCorrupted;
 
+    // back this chunk's deserialised allocations (nested create-info arrays, pNext structs) with
+    // the arena - they only live until the API call has been made, so they're reclaimed wholesale
+    // below rather than freed individually. The frame replay further down runs without the arena.
+    SetActiveDeserialiseArena(&m_ChunkArena);
+
     bool success = ProcessChunk(ser, context);
 
+    SetActiveDeserialiseArena(NULL);
+    m_ChunkArena.Reset();
+
     ser.EndChunk();
 
     if(reader->IsErrored())
@@ -2073,12 +2287,47 @@ ReplayStatus WrappedVulkan::ReadLogInitialisation(RDCFile *rdc, bool storeStruct
 
     if((SystemChunk)context == SystemChunk::CaptureScope)
     {
+      // all shader module chunks are behind us now - wait for any background SPIR-V parses still
+      // in flight so the frame replay below can read shader modules without synchronisation.
+      m_CreationInfo.ShutdownShaderParseWorkers();
+
       m_FrameRecord.frameInfo.fileOffset = offsetStart;
 
       // read the remaining data into memory and pass to immediate context
       frameDataSize = reader->GetSize() - reader->GetOffset();
 
-      m_FrameReader = new StreamReader(reader, frameDataSize);
+      const char *budgetEnv = Process::GetEnvVariable("RENDERDOC_FRAME_RESIDENCY_BUDGET");
+      if(budgetEnv && atoi(budgetEnv) > 0)
+        m_FrameDataResidencyBudget = uint64_t(atoi(budgetEnv)) * 1024 * 1024;
+
+      if(frameDataSize > m_FrameDataResidencyBudget && !IsStructuredExporting(m_State))
+      {
+        // the frame data is larger than we're willing to keep resident, so instead of buffering
+        // it all, use a windowed reader that re-reads ranges from the file on demand. After the
+        // first sequential replay below only the last window stays in memory - when ReplayLog
+        // later seeks backwards the section is decompressed forwards again from the start, which
+        // trades replay time for being able to open captures larger than RAM.
+        //
+        // note this assumes the RDCFile outlives us, which holds since the capture file stays
+        // open for the lifetime of the replay session.
+        RDCLOG("Frame data is %llu bytes, streaming it with a %llu byte resident window",
+               frameDataSize, m_FrameDataResidencyBudget);
+
+        uint64_t frameDataOffset = reader->GetOffset();
+
+        m_FrameReader = new StreamReader([rdc, sectionIdx]() {
+          return rdc->ReadSection(sectionIdx);
+        }, frameDataOffset, frameDataSize, m_FrameDataResidencyBudget);
+      }
+      else
+      {
+        m_FrameReader = new StreamReader(reader, frameDataSize);
+      }
+
+      // lazy structured data is only a win on large captures, and is pointless if the caller wants
+      // the full structured buffers anyway (e.g. for conversion to another format).
+      m_LazyStructuredData = m_LazyStructuredData && !storeStructuredBuffers &&
+                             frameDataSize >= LazyStructuredDataThreshold;
 
       ReplayStatus status = ContextReplayLog(m_State, 0, 0, false);
 
@@ -2139,6 +2388,10 @@ ReplayStatus WrappedVulkan::ReadLogInitialisation(RDCFile *rdc, bool storeStruct
 
     // steal the command buffer out of the pending commands - we'll manage its lifetime ourselves
     m_InternalCmds.pendingcmds.pop_back();
+
+    // every creation chunk has been processed now, so the creation info is stable and the
+    // subpass0 pipeline variants deferred above can be compiled in parallel.
+    CompileDeferredSubpass0Pipelines();
   }
 
   FreeAllMemory(MemoryScope::IndirectReadback);
@@ -2166,6 +2419,9 @@ ReplayStatus WrappedVulkan::ContextReplayLog(CaptureState readType, uint32_t sta
     ser.GetStructuredFile().Swap(*m_StructuredFile);
 
     m_StructuredFile = &ser.GetStructuredFile();
+
+    if(IsLoading(m_State) && m_LazyStructuredData)
+      ser.SetLazyStructuredExport(true);
   }
 
   SystemChunk header = ser.ReadChunk<SystemChunk>();
@@ -2293,6 +2549,11 @@ ReplayStatus WrappedVulkan::ContextReplayLog(CaptureState readType, uint32_t sta
   if(!partial && !IsStructuredExporting(m_State))
     AddFrameTerminator(AMDRGPControl::GetEndTag());
 
+  // remember where each stubbed chunk lives in the frame data, so ExpandStructuredChunk can
+  // materialise it later.
+  for(const LazyChunkLocation &loc : ser.GetLazyChunkLocations())
+    m_LazyChunkOffsets[loc.chunk] = loc.offset;
+
   // swap the structure back now that we've accumulated the frame as well.
   if(IsLoading(m_State) || IsStructuredExporting(m_State))
     ser.GetStructuredFile().Swap(*prevFile);
@@ -2351,10 +2612,36 @@ ReplayStatus WrappedVulkan::ContextReplayLog(CaptureState readType, uint32_t sta
 
   m_RerecordCmds.clear();
   m_RerecordCmdList.clear();
+  m_CacheableCmds.clear();
+  m_ReusedBakedCmds.clear();
 
   return ReplayStatus::Succeeded;
 }
 
+void WrappedVulkan::CacheBakedCommandBuffer(ResourceId bakedId, VkCommandBuffer cmd)
+{
+  // pull the command buffer out of the end-of-replay free list and keep it across replays instead
+  for(auto it = m_RerecordCmdList.begin(); it != m_RerecordCmdList.end(); ++it)
+  {
+    if(it->second == cmd)
+    {
+      m_CachedBakedCmds[bakedId] = *it;
+      m_RerecordCmdList.erase(it);
+      break;
+    }
+  }
+
+  m_CacheableCmds.erase(bakedId);
+}
+
+void WrappedVulkan::InvalidateBakedCommandBufferCache()
+{
+  for(auto it = m_CachedBakedCmds.begin(); it != m_CachedBakedCmds.end(); ++it)
+    vkFreeCommandBuffers(GetDev(), it->second.first, 1, &it->second.second);
+
+  m_CachedBakedCmds.clear();
+}
+
 void WrappedVulkan::ApplyInitialContents()
 {
   // check that we have all external queues necessary
@@ -2405,6 +2692,22 @@ void WrappedVulkan::ApplyInitialContents()
   // actually apply the initial contents here
   GetResourceManager()->ApplyInitialContents();
 
+  // flush the descriptor writes batched up by Apply_InitialState. Go through the wrapper
+  // implementation so the VkWriteDescriptorSet structs are unwrapped, in chunks so the temporary
+  // unwrapping memory stays bounded.
+  if(!m_PendingDescSetWrites.empty())
+  {
+    const size_t batchSize = 4096;
+
+    for(size_t i = 0; i < m_PendingDescSetWrites.size(); i += batchSize)
+    {
+      uint32_t count = (uint32_t)RDCMIN(batchSize, m_PendingDescSetWrites.size() - i);
+      vkUpdateDescriptorSets(GetDev(), count, &m_PendingDescSetWrites[i], 0, NULL);
+    }
+
+    m_PendingDescSetWrites.clear();
+  }
+
   // likewise again to make sure the initial states are all applied
   cmd = GetNextCmd();
 
@@ -2914,6 +3217,11 @@ bool WrappedVulkan::ProcessChunk(ReadSerialiser &ser, VulkanChunk chunk)
     }
     case VulkanChunk::vkResetQueryPoolEXT:
       return Serialise_vkResetQueryPoolEXT(ser, VK_NULL_HANDLE, VK_NULL_HANDLE, 0, 0);
+    case VulkanChunk::ImageRefs:
+    {
+      std::vector<ImageFrameRef> data;
+      return GetResourceManager()->Serialise_ImageRefs(ser, data);
+    }
       break;
     default:
     {
@@ -2937,6 +3245,12 @@ bool WrappedVulkan::ProcessChunk(ReadSerialiser &ser, VulkanChunk chunk)
       {
         return Serialise_InitialState(ser, ResourceId(), NULL, NULL);
       }
+      else if(system == SystemChunk::InitialContentsReference)
+      {
+        GetResourceManager()->CreateInitialContentsReference(ser);
+
+        SERIALISE_CHECK_READ_ERRORS();
+      }
       else if(system == SystemChunk::CaptureScope)
       {
         return Serialise_CaptureScope(ser);
@@ -3010,6 +3324,145 @@ void WrappedVulkan::AddFrameTerminator(uint64_t queueMarkerTag)
   SubmitCmds();
 }
 
+SDChunk *WrappedVulkan::ExpandStructuredChunk(uint32_t chunkIdx)
+{
+  StructuredChunkList &chunks = m_StoredStructuredData.chunks;
+
+  if(chunkIdx >= chunks.size())
+    return NULL;
+
+  SDChunk *stub = chunks[chunkIdx];
+
+  // already materialised (or never stubbed) - refresh its position in the eviction queue
+  if(!(stub->metadata.flags & SDChunkFlags::StubChunk))
+  {
+    auto it = std::find(m_ExpandedChunks.begin(), m_ExpandedChunks.end(), chunkIdx);
+    if(it != m_ExpandedChunks.end())
+    {
+      m_ExpandedChunks.erase(it);
+      m_ExpandedChunks.push_back(chunkIdx);
+    }
+    return stub;
+  }
+
+  auto offsIt = m_LazyChunkOffsets.find(stub);
+
+  // opaque/unknown chunks have no recorded location and stay as stubs
+  if(offsIt == m_LazyChunkOffsets.end())
+    return stub;
+
+  uint64_t chunkOffset = offsIt->second;
+
+  // deserialise just this one chunk again, in structured export mode so that ProcessChunk only
+  // decodes it into the structured tree without executing anything.
+  m_FrameReader->SetOffset(chunkOffset);
+
+  ReadSerialiser ser(m_FrameReader, Ownership::Nothing);
+
+  ser.SetStringDatabase(&m_StringDB);
+  ser.SetUserData(GetResourceManager());
+  ser.SetVersion(m_SectionVersion);
+  ser.ConfigureStructuredExport(&GetChunkName, true);
+  ser.GetStructuredFile().version = m_SectionVersion;
+
+  CaptureState prevState = m_State;
+  SDFile *prevFile = m_StructuredFile;
+
+  m_State = CaptureState::StructuredExport;
+  m_StructuredFile = &ser.GetStructuredFile();
+
+  VulkanChunk context = ser.ReadChunk<VulkanChunk>();
+
+  ProcessChunk(ser, context);
+
+  ser.EndChunk();
+
+  m_State = prevState;
+  m_StructuredFile = prevFile;
+
+  SDFile &scratch = ser.GetStructuredFile();
+
+  if(scratch.chunks.empty() || ser.GetReader()->IsErrored())
+  {
+    RDCERR("Couldn't materialise structured data for chunk %u", chunkIdx);
+    return stub;
+  }
+
+  SDChunk *expanded = scratch.chunks[0];
+
+  // steal the chunk and its buffers, remapping buffer indices into our own buffer list
+  uint64_t bufferBase = m_StoredStructuredData.buffers.size();
+
+  std::vector<SDObject *> walk(expanded->data.children.begin(), expanded->data.children.end());
+  while(!walk.empty())
+  {
+    SDObject *obj = walk.back();
+    walk.pop_back();
+
+    if(obj->type.basetype == SDBasic::Buffer)
+      obj->data.basic.u += bufferBase;
+
+    walk.insert(walk.end(), obj->data.children.begin(), obj->data.children.end());
+  }
+
+  for(bytebuf *buf : scratch.buffers)
+    m_StoredStructuredData.buffers.push_back(buf);
+
+  scratch.chunks.clear();
+  scratch.buffers.clear();
+
+  chunks[chunkIdx] = expanded;
+
+  // the location now belongs to the expanded chunk, in case it gets evicted and re-stubbed
+  m_LazyChunkOffsets.erase(offsIt);
+  m_LazyChunkOffsets[expanded] = chunkOffset;
+
+  delete stub;
+
+  m_ExpandedChunks.push_back(chunkIdx);
+
+  // cap how many materialised trees we keep around - evict the least recently used back to a stub
+  if(m_ExpandedChunks.size() > MaxExpandedChunks)
+  {
+    uint32_t evictIdx = m_ExpandedChunks.front();
+    m_ExpandedChunks.pop_front();
+
+    SDChunk *evict = chunks[evictIdx];
+
+    SDChunk *newStub = new SDChunk(evict->name.c_str());
+    newStub->metadata = evict->metadata;
+    newStub->metadata.flags |= SDChunkFlags::StubChunk;
+    newStub->type.byteSize = evict->type.byteSize;
+
+    // release the memory of any buffers the evicted tree referenced. The slots stay so that other
+    // chunks' buffer indices remain valid.
+    walk.assign(evict->data.children.begin(), evict->data.children.end());
+    while(!walk.empty())
+    {
+      SDObject *obj = walk.back();
+      walk.pop_back();
+
+      if(obj->type.basetype == SDBasic::Buffer && obj->data.basic.u < m_StoredStructuredData.buffers.size())
+        m_StoredStructuredData.buffers[(size_t)obj->data.basic.u]->clear();
+
+      walk.insert(walk.end(), obj->data.children.begin(), obj->data.children.end());
+    }
+
+    auto evictOffs = m_LazyChunkOffsets.find(evict);
+    if(evictOffs != m_LazyChunkOffsets.end())
+    {
+      m_LazyChunkOffsets[newStub] = evictOffs->second;
+      m_LazyChunkOffsets.erase(evictOffs);
+    }
+
+    chunks[evictIdx] = newStub;
+
+    delete evict;
+  }
+
+  return expanded;
+}
+
 void WrappedVulkan::ReplayLog(uint32_t startEventID, uint32_t endEventID, ReplayLogType replayType)
 {
   bool partial = true;
@@ -3157,6 +3610,23 @@ void WrappedVulkan::ReplayLog(uint32_t startEventID, uint32_t endEventID, Replay
 #endif
   }
 
+  // if structured data was loaded lazily, materialise the chunks for the event(s) just replayed so
+  // that inspection (e.g. the UI's API inspector) sees full contents for the selected event.
+  if(m_LazyStructuredData)
+  {
+    const DrawcallDescription *draw = GetDrawcall(endEventID);
+
+    if(draw)
+    {
+      for(const APIEvent &ev : draw->events)
+        ExpandStructuredChunk(ev.chunkIndex);
+    }
+    else
+    {
+      ExpandStructuredChunk(GetEvent(endEventID).chunkIndex);
+    }
+  }
+
   VkMarkerRegion::Set("!!!!RenderDoc Internal: Done replay");
 }
 
@@ -3311,9 +3781,18 @@ void WrappedVulkan::AddDebugMessage(MessageCategory c, MessageSeverity sv, Messa
 void WrappedVulkan::AddDebugMessage(DebugMessage msg)
 {
   if(IsLoading(m_State))
+  {
     m_EventMessages.push_back(msg);
+  }
   else
+  {
+    // scrubbing around the frame re-executes the same commands, so noisy validation layers
+    // re-trigger identical messages on every replay. Only report each unique message once.
+    if(IsActiveReplaying(m_State) && !m_ReportedDebugMessages.insert(msg).second)
+      return;
+
     m_DebugMessages.push_back(msg);
+  }
 }
 
 VkBool32 WrappedVulkan::DebugCallback(MessageSeverity severity, MessageCategory category,
@@ -3462,6 +3941,11 @@ bool WrappedVulkan::InRerecordRange(ResourceId cmdid)
   if(m_OutsideCmdBuffer != VK_NULL_HANDLE)
     return true;
 
+  // command buffers resubmitted from the baked cache are already fully recorded and ended, so no
+  // commands may replay into them.
+  if(m_ReusedBakedCmds.find(cmdid) != m_ReusedBakedCmds.end())
+    return false;
+
   // if not, check if we're one of the actual partial command buffers and check to see if we're in
   // the range for their partial replay.
   for(int p = 0; p < ePartialNum; p++)
@@ -24,6 +24,8 @@
 
 #pragma once
 
+#include <deque>
+#include <set>
 #include <vector>
 #include "common/timing.h"
 #include "replay/replay_driver.h"
@@ -244,8 +246,15 @@ private:
   // AddEvent())
   std::vector<DebugMessage> m_EventMessages;
 
+  // arena backing deserialised allocations while initialisation chunks are processed, reset
+  // after each chunk
+  ChunkArena m_ChunkArena;
+
   // list of all debug messages by EID in the frame
   std::vector<DebugMessage> m_DebugMessages;
+  // all unique messages reported during active replay, so repeats re-triggered by scrubbing
+  // around the frame can be dropped
+  std::set<DebugMessage> m_ReportedDebugMessages;
   template <typename SerialiserType>
   void Serialise_DebugMessages(SerialiserType &ser);
   std::vector<DebugMessage> GetDebugMessages();
@@ -258,6 +267,11 @@ private:
   bool m_MarkedActive = false;
   uint32_t m_SubmitCounter = 0;
 
+  // bumped for each frame capture. Baked command buffer records stamp this at their first submit
+  // within a capture, so re-submits of unchanged command buffers can skip re-processing their
+  // frame references.
+  uint32_t m_CaptureSubmitGen = 0;
+
   uint64_t threadSerialiserTLSSlot;
 
   Threading::CriticalSection m_ThreadSerialisersLock;
@@ -306,6 +320,23 @@ private:
   SDFile *m_StructuredFile;
   SDFile m_StoredStructuredData;
 
+  // when loading lazily (see SetLazyStructuredData) most chunks are only stubs in the structured
+  // file, and we remember where each one lives in m_FrameReader so ExpandStructuredChunk can
+  // materialise it on demand. Only a bounded number of expanded chunks are retained at once.
+  bool m_LazyStructuredData = false;
+  std::map<SDChunk *, uint64_t> m_LazyChunkOffsets;
+  std::list<uint32_t> m_ExpandedChunks;
+
+  // only bother stubbing chunks when the frame data is at least this large - small captures load
+  // quickly anyway and scripts expect fully populated structured data.
+  static const uint64_t LazyStructuredDataThreshold = 256 * 1024 * 1024;
+  static const size_t MaxExpandedChunks = 1024;
+
+  // when the frame data is larger than this budget we don't keep it all resident - m_FrameReader
+  // becomes a windowed reader that re-reads (and re-decompresses) ranges from the RDCFile on
+  // demand as ReplayLog revisits them. Overridable in MB with RENDERDOC_FRAME_RESIDENCY_BUDGET.
+  uint64_t m_FrameDataResidencyBudget = 1024 * 1024 * 1024;
+
   void AddResource(ResourceId id, ResourceType type, const char *defaultNamePrefix);
   void DerivedResource(ResourceId parentLive, ResourceId child);
   template <typename VulkanType>
@@ -661,6 +692,22 @@ private:
   // above map
   std::vector<std::pair<VkCommandPool, VkCommandBuffer>> m_RerecordCmdList;
 
+  // cache of fully-baked command buffer re-records, by bake ID. A command buffer that lies
+  // completely within the replayed range re-records to exactly the same commands every replay, so
+  // once recorded it can be resubmitted as-is on subsequent replays instead of being re-recorded -
+  // only the partial command buffer containing the target event actually differs. Invalidated
+  // whenever resource replacements change (e.g. shader edits), since the baked commands bind the
+  // old resources.
+  std::map<ResourceId, std::pair<VkCommandPool, VkCommandBuffer>> m_CachedBakedCmds;
+
+  // bake IDs of command buffers recorded this replay that are unmodified and should move into
+  // m_CachedBakedCmds when they're ended, instead of being freed with m_RerecordCmdList
+  std::set<ResourceId> m_CacheableCmds;
+
+  // original and bake IDs of command buffers resubmitted from m_CachedBakedCmds this replay -
+  // these are already recorded and ended, so no commands must replay into them
+  std::set<ResourceId> m_ReusedBakedCmds;
+
   // There is only a state while currently partially replaying, it's
   // undefined/empty otherwise.
   // All IDs are original IDs, not live.
@@ -668,6 +715,8 @@ private:
 
   bool InRerecordRange(ResourceId cmdid);
   bool HasRerecordCmdBuf(ResourceId cmdid);
+  void CacheBakedCommandBuffer(ResourceId bakedId, VkCommandBuffer cmd);
+  void InvalidateBakedCommandBufferCache();
   bool ShouldUpdateRenderState(ResourceId cmdid, bool forcePrimary = false);
   VkCommandBuffer RerecordCmdBuf(ResourceId cmdid, PartialReplayIndex partialType = ePartialNum);
 
@@ -740,8 +789,10 @@ private:
       GetResourceManager()->MarkResourceFrameReferenced(id, ref);
   }
 
-  // used both on capture and replay side to track image layouts. Only locked
-  // in capture
+  // used both on capture and replay side to track image layouts. Only locked in capture, and
+  // only around creation, queue submits and capture serialisation - recording barriers reads the
+  // immutable mip/layer counts from the per-image record instead, so command buffer recording
+  // threads never contend on this lock
   std::map<ResourceId, ImageLayouts> m_ImageLayouts;
   Threading::CriticalSection m_ImageLayoutsLock;
 
@@ -753,11 +804,19 @@ private:
 
   // current descriptor set contents
   std::map<ResourceId, DescriptorSetInfo> m_DescriptorSetState;
+  // descriptor writes gathered by Apply_InitialState across all descriptor sets, flushed in a few
+  // large vkUpdateDescriptorSets calls at the end of ApplyInitialContents
+  std::vector<VkWriteDescriptorSet> m_PendingDescSetWrites;
   // data for a baked command buffer - its drawcalls and events, ready to submit
   std::map<ResourceId, BakedCmdBufferInfo> m_BakedCmdBufferInfo;
   // immutable creation data
   VulkanCreationInfo m_CreationInfo;
 
+  // graphics pipelines whose subpass0 variant compile was deferred during initial load, so the
+  // duplicate compiles can be batched across worker threads once every creation chunk has been
+  // processed. See CompileDeferredSubpass0Pipelines.
+  std::vector<ResourceId> m_DeferredSubpass0Pipes;
+
   std::map<ResourceId, vector<EventUsage>> m_ResourceUses;
 
   // returns thread-local temporary memory
@@ -835,6 +894,23 @@ private:
   bool Apply_SparseInitialState(WrappedVkBuffer *buf, const VkInitialContents &contents);
   bool Apply_SparseInitialState(WrappedVkImage *im, const VkInitialContents &contents);
 
+  // active while the resource manager is batching Prepare_InitialState calls at capture start.
+  // GPU copies and the cleanup of their staging resources accumulate and are flushed together in
+  // FlushPendingInitialStates(), and descriptor set snapshots build on the task pool, instead of
+  // each resource submitting and syncing alone.
+  bool m_PrepareInitStateBatching = false;
+  // flush after this many deferred copies, to bound staging memory held by a batch while keeping
+  // the number of submits low even with thousands of dirty resources
+  static const uint32_t InitialStateBatchSize = 64;
+  uint32_t m_PrepareInitStateCmds = 0;
+  std::vector<VkBuffer> m_PrepareInitStateBufs;
+  std::vector<VkImage> m_PrepareInitStateImgs;
+  Threading::TaskGroup m_PrepareInitStateTasks;
+  std::deque<std::pair<ResourceId, VkInitialContents>> m_PrepareInitStateDescSets;
+
+  void FlushPendingInitialStates();
+  void PrepareDescriptorSetInitialContents(VkResourceRecord *record, VkInitialContents &contents);
+
   void ApplyInitialContents();
 
   vector<APIEvent> m_RootEvents, m_Events;
@@ -870,6 +946,8 @@ private:
     return m_DrawcallStack;
   }
 
+  void CompileDeferredSubpass0Pipelines();
+
   bool ProcessChunk(ReadSerialiser &ser, VulkanChunk chunk);
   ReplayStatus ContextReplayLog(CaptureState readType, uint32_t startEventID, uint32_t endEventID,
                                 bool partial);
@@ -916,8 +994,11 @@ public:
   VulkanReplay *GetReplay() { return &m_Replay; }
   // replay interface
   bool Prepare_InitialState(WrappedVkRes *res);
+  void Begin_PrepareInitialBatch();
+  void End_PrepareInitialBatch();
   uint64_t GetSize_InitialState(ResourceId id, const VkInitialContents &initial);
   uint64_t GetSize_SparseInitialState(ResourceId id, const VkInitialContents &initial);
+  uint64_t GetContentHash_InitialState(ResourceId id, const VkInitialContents &initial);
   template <typename SerialiserType>
   bool Serialise_InitialState(SerialiserType &ser, ResourceId id, VkResourceRecord *record,
                               const VkInitialContents *initial);
@@ -939,6 +1020,9 @@ public:
   void ReplayLog(uint32_t startEventID, uint32_t endEventID, ReplayLogType replayType);
   ReplayStatus ReadLogInitialisation(RDCFile *rdc, bool storeStructuredBuffers);
 
+  void SetLazyStructuredData(bool lazy) { m_LazyStructuredData = lazy; }
+  SDChunk *ExpandStructuredChunk(uint32_t chunkIdx);
+
   SDFile &GetStructuredFile() { return *m_StructuredFile; }
   FrameRecord &GetFrameRecord() { return m_FrameRecord; }
   const APIEvent &GetEvent(uint32_t eventId);
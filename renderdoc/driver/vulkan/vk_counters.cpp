@@ -389,38 +389,55 @@ struct VulkanGPUTimerCallback : public VulkanDrawcallCallback
     m_pDriver->SetDrawcallCB(this);
   }
   ~VulkanGPUTimerCallback() { m_pDriver->SetDrawcallCB(NULL); }
-  void PreDraw(uint32_t eid, VkCommandBuffer cmd) override
+  // only begin the query types this class of event can produce results for - copies can't
+  // generate samples or shader invocations, and dispatches can't generate samples. Queries we
+  // skip here are never begun so their results stay unavailable, which the readback detects with
+  // VK_QUERY_RESULT_WITH_AVAILABILITY_BIT and reports as zero.
+  void BeginQueries(VkCommandBuffer cmd, bool rasterizes, bool shaders)
   {
-    if(m_OcclusionQueryPool != VK_NULL_HANDLE)
+    if(rasterizes && m_OcclusionQueryPool != VK_NULL_HANDLE)
       ObjDisp(cmd)->CmdBeginQuery(Unwrap(cmd), m_OcclusionQueryPool, (uint32_t)m_Results.size(),
                                   VK_QUERY_CONTROL_PRECISE_BIT);
-    if(m_PipeStatsQueryPool != VK_NULL_HANDLE)
+    if(shaders && m_PipeStatsQueryPool != VK_NULL_HANDLE)
       ObjDisp(cmd)->CmdBeginQuery(Unwrap(cmd), m_PipeStatsQueryPool, (uint32_t)m_Results.size(), 0);
     ObjDisp(cmd)->CmdWriteTimestamp(Unwrap(cmd), VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
                                     m_TimeStampQueryPool, (uint32_t)(m_Results.size() * 2 + 0));
   }
 
-  bool PostDraw(uint32_t eid, VkCommandBuffer cmd) override
+  void EndQueries(uint32_t eid, VkCommandBuffer cmd, bool rasterizes, bool shaders)
   {
     ObjDisp(cmd)->CmdWriteTimestamp(Unwrap(cmd), VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
                                     m_TimeStampQueryPool, (uint32_t)(m_Results.size() * 2 + 1));
-    if(m_OcclusionQueryPool != VK_NULL_HANDLE)
+    if(rasterizes && m_OcclusionQueryPool != VK_NULL_HANDLE)
       ObjDisp(cmd)->CmdEndQuery(Unwrap(cmd), m_OcclusionQueryPool, (uint32_t)m_Results.size());
-    if(m_PipeStatsQueryPool != VK_NULL_HANDLE)
+    if(shaders && m_PipeStatsQueryPool != VK_NULL_HANDLE)
       ObjDisp(cmd)->CmdEndQuery(Unwrap(cmd), m_PipeStatsQueryPool, (uint32_t)m_Results.size());
     m_Results.push_back(eid);
+  }
+
+  void PreDraw(uint32_t eid, VkCommandBuffer cmd) override { BeginQueries(cmd, true, true); }
+  bool PostDraw(uint32_t eid, VkCommandBuffer cmd) override
+  {
+    EndQueries(eid, cmd, true, true);
     return false;
   }
 
   void PostRedraw(uint32_t eid, VkCommandBuffer cmd) override {}
-  // we don't need to distinguish, call the Draw functions
-  void PreDispatch(uint32_t eid, VkCommandBuffer cmd) override { PreDraw(eid, cmd); }
-  bool PostDispatch(uint32_t eid, VkCommandBuffer cmd) override { return PostDraw(eid, cmd); }
+  void PreDispatch(uint32_t eid, VkCommandBuffer cmd) override { BeginQueries(cmd, false, true); }
+  bool PostDispatch(uint32_t eid, VkCommandBuffer cmd) override
+  {
+    EndQueries(eid, cmd, false, true);
+    return false;
+  }
   void PostRedispatch(uint32_t eid, VkCommandBuffer cmd) override { PostRedraw(eid, cmd); }
-  void PreMisc(uint32_t eid, DrawFlags flags, VkCommandBuffer cmd) override { PreDraw(eid, cmd); }
+  void PreMisc(uint32_t eid, DrawFlags flags, VkCommandBuffer cmd) override
+  {
+    BeginQueries(cmd, false, false);
+  }
   bool PostMisc(uint32_t eid, DrawFlags flags, VkCommandBuffer cmd) override
   {
-    return PostDraw(eid, cmd);
+    EndQueries(eid, cmd, false, false);
+    return false;
   }
   void PostRemisc(uint32_t eid, DrawFlags flags, VkCommandBuffer cmd) override
   {
@@ -568,6 +585,13 @@ vector<CounterResult> VulkanReplay::FetchCounters(const vector<GPUCounter> &coun
   // replay the events to perform all the queries
   m_pDriver->ReplayLog(0, maxEID, eReplay_Full);
 
+  // idle the GPU before reading back. The occlusion and pipeline stats pools are sparse - events
+  // that can't produce those results never begin their query - so we read them with availability
+  // bits rather than waiting, and an unavailable query after an idle means 'never ran', not
+  // 'not finished yet'.
+  m_pDriver->SubmitCmds();
+  m_pDriver->FlushQ();
+
   vector<uint64_t> m_TimeStampData;
   m_TimeStampData.resize(cb.m_Results.size() * 2);
 
@@ -579,32 +603,45 @@ vector<CounterResult> VulkanReplay::FetchCounters(const vector<GPUCounter> &coun
 
   ObjDisp(dev)->DestroyQueryPool(Unwrap(dev), timeStampPool, NULL);
 
+  // interleaved {result, availability} pairs
   vector<uint64_t> m_OcclusionData;
-  m_OcclusionData.resize(cb.m_Results.size());
+  m_OcclusionData.resize(cb.m_Results.size() * 2);
   if(occlusionPool != VK_NULL_HANDLE)
   {
     vkr = ObjDisp(dev)->GetQueryPoolResults(
-        Unwrap(dev), occlusionPool, 0, (uint32_t)m_OcclusionData.size(),
-        sizeof(uint64_t) * m_OcclusionData.size(), &m_OcclusionData[0], sizeof(uint64_t),
-        VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+        Unwrap(dev), occlusionPool, 0, (uint32_t)cb.m_Results.size(),
+        sizeof(uint64_t) * m_OcclusionData.size(), &m_OcclusionData[0], sizeof(uint64_t) * 2,
+        VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
     RDCASSERTEQUAL(vkr, VK_SUCCESS);
 
     ObjDisp(dev)->DestroyQueryPool(Unwrap(dev), occlusionPool, NULL);
   }
 
+  // 11 pipeline statistics then an availability word per query
   vector<uint64_t> m_PipeStatsData;
-  m_PipeStatsData.resize(cb.m_Results.size() * 11);
+  m_PipeStatsData.resize(cb.m_Results.size() * 12);
   if(pipeStatsPool != VK_NULL_HANDLE)
   {
     vkr = ObjDisp(dev)->GetQueryPoolResults(
         Unwrap(dev), pipeStatsPool, 0, (uint32_t)cb.m_Results.size(),
-        sizeof(uint64_t) * m_PipeStatsData.size(), &m_PipeStatsData[0], sizeof(uint64_t) * 11,
-        VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+        sizeof(uint64_t) * m_PipeStatsData.size(), &m_PipeStatsData[0], sizeof(uint64_t) * 12,
+        VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
     RDCASSERTEQUAL(vkr, VK_SUCCESS);
 
     ObjDisp(dev)->DestroyQueryPool(Unwrap(dev), pipeStatsPool, NULL);
   }
 
+  // zero out any results that weren't available - the query was never begun for that event
+  for(size_t i = 0; i < cb.m_Results.size(); i++)
+  {
+    if(m_OcclusionData[i * 2 + 1] == 0)
+      m_OcclusionData[i * 2 + 0] = 0;
+
+    if(m_PipeStatsData[i * 12 + 11] == 0)
+      for(size_t s = 0; s < 11; s++)
+        m_PipeStatsData[i * 12 + s] = 0;
+  }
+
   for(size_t i = 0; i < cb.m_Results.size(); i++)
   {
     for(size_t c = 0; c < vkCounters.size(); c++)
@@ -624,22 +661,22 @@ vector<CounterResult> VulkanReplay::FetchCounters(const vector<GPUCounter> &coun
                            / (1000.0 * 1000.0 * 1000.0);    // to seconds
         }
         break;
-        case GPUCounter::InputVerticesRead: result.value.u64 = m_PipeStatsData[i * 11 + 0]; break;
-        case GPUCounter::IAPrimitives: result.value.u64 = m_PipeStatsData[i * 11 + 1]; break;
-        case GPUCounter::GSPrimitives: result.value.u64 = m_PipeStatsData[i * 11 + 4]; break;
+        case GPUCounter::InputVerticesRead: result.value.u64 = m_PipeStatsData[i * 12 + 0]; break;
+        case GPUCounter::IAPrimitives: result.value.u64 = m_PipeStatsData[i * 12 + 1]; break;
+        case GPUCounter::GSPrimitives: result.value.u64 = m_PipeStatsData[i * 12 + 4]; break;
         case GPUCounter::RasterizerInvocations:
-          result.value.u64 = m_PipeStatsData[i * 11 + 5];
+          result.value.u64 = m_PipeStatsData[i * 12 + 5];
           break;
         case GPUCounter::RasterizedPrimitives:
-          result.value.u64 = m_PipeStatsData[i * 11 + 6];
+          result.value.u64 = m_PipeStatsData[i * 12 + 6];
           break;
-        case GPUCounter::SamplesPassed: result.value.u64 = m_OcclusionData[i]; break;
-        case GPUCounter::VSInvocations: result.value.u64 = m_PipeStatsData[i * 11 + 2]; break;
-        case GPUCounter::TCSInvocations: result.value.u64 = m_PipeStatsData[i * 11 + 8]; break;
-        case GPUCounter::TESInvocations: result.value.u64 = m_PipeStatsData[i * 11 + 9]; break;
-        case GPUCounter::GSInvocations: result.value.u64 = m_PipeStatsData[i * 11 + 3]; break;
-        case GPUCounter::PSInvocations: result.value.u64 = m_PipeStatsData[i * 11 + 9]; break;
-        case GPUCounter::CSInvocations: result.value.u64 = m_PipeStatsData[i * 11 + 10]; break;
+        case GPUCounter::SamplesPassed: result.value.u64 = m_OcclusionData[i * 2]; break;
+        case GPUCounter::VSInvocations: result.value.u64 = m_PipeStatsData[i * 12 + 2]; break;
+        case GPUCounter::TCSInvocations: result.value.u64 = m_PipeStatsData[i * 12 + 8]; break;
+        case GPUCounter::TESInvocations: result.value.u64 = m_PipeStatsData[i * 12 + 9]; break;
+        case GPUCounter::GSInvocations: result.value.u64 = m_PipeStatsData[i * 12 + 3]; break;
+        case GPUCounter::PSInvocations: result.value.u64 = m_PipeStatsData[i * 12 + 9]; break;
+        case GPUCounter::CSInvocations: result.value.u64 = m_PipeStatsData[i * 12 + 10]; break;
         default: break;
       }
       ret.push_back(result);
@@ -39,6 +39,10 @@
 
 const VkDeviceSize STAGE_BUFFER_BYTE_SIZE = 16 * 1024 * 1024ULL;
 
+// cap on how far buffer readbacks grow the shared staging window - reads larger than this fall
+// back to copying through the window in chunks
+const VkDeviceSize MAX_STAGE_BUFFER_BYTE_SIZE = 256 * 1024 * 1024ULL;
+
 static void create(WrappedVulkan *driver, const char *objName, const int line, VkSampler *sampler,
                    VkFilter samplerFilter)
 {
@@ -1093,159 +1097,188 @@ uint32_t VulkanReplay::PickVertex(uint32_t eventId, int32_t w, int32_t h, const
 
   m_VertexPick.UBO.Unmap();
 
-  bytebuf idxs;
+  // picking during a mouse drag issues one pick per mouse move against the same mesh, so if the
+  // previously converted and uploaded IB/VB came from the same mesh data at the same event we can
+  // dispatch against them directly and skip the readback, conversion and upload entirely. Only the
+  // fields that feed the conversion are compared - the topology and display settings live in the
+  // UBO which is rewritten every pick above.
+  const bool meshCached =
+      m_VertexPick.CacheValid && m_VertexPick.CacheEventID == eventId &&
+      m_VertexPick.CachePosition.vertexResourceId == cfg.position.vertexResourceId &&
+      m_VertexPick.CachePosition.vertexByteOffset == cfg.position.vertexByteOffset &&
+      m_VertexPick.CachePosition.vertexByteStride == cfg.position.vertexByteStride &&
+      m_VertexPick.CachePosition.indexResourceId == cfg.position.indexResourceId &&
+      m_VertexPick.CachePosition.indexByteOffset == cfg.position.indexByteOffset &&
+      m_VertexPick.CachePosition.indexByteStride == cfg.position.indexByteStride &&
+      m_VertexPick.CachePosition.baseVertex == cfg.position.baseVertex &&
+      m_VertexPick.CachePosition.numIndices == cfg.position.numIndices &&
+      m_VertexPick.CachePosition.format == cfg.position.format;
+
+  bool hasIdxs = m_VertexPick.CacheHasIdxs;
+
+  if(!meshCached)
+  {
+    bytebuf idxs;
 
-  uint32_t minIndex = 0;
-  uint32_t maxIndex = cfg.position.numIndices;
+    uint32_t minIndex = 0;
+    uint32_t maxIndex = cfg.position.numIndices;
 
-  if(cfg.position.indexByteStride && cfg.position.indexResourceId != ResourceId())
-    GetBufferData(cfg.position.indexResourceId, cfg.position.indexByteOffset, 0, idxs);
+    if(cfg.position.indexByteStride && cfg.position.indexResourceId != ResourceId())
+      GetBufferData(cfg.position.indexResourceId, cfg.position.indexByteOffset, 0, idxs);
 
-  uint32_t idxclamp = 0;
-  if(cfg.position.baseVertex < 0)
-    idxclamp = uint32_t(-cfg.position.baseVertex);
+    uint32_t idxclamp = 0;
+    if(cfg.position.baseVertex < 0)
+      idxclamp = uint32_t(-cfg.position.baseVertex);
 
-  // We copy into our own buffers to promote to the target type (uint32) that the shader expects.
-  // Most IBs will be 16-bit indices, most VBs will not be float4. We also apply baseVertex here
+    // We copy into our own buffers to promote to the target type (uint32) that the shader expects.
+    // Most IBs will be 16-bit indices, most VBs will not be float4. We also apply baseVertex here
 
-  if(!idxs.empty())
-  {
-    // resize up on demand
-    if(m_VertexPick.IBSize < cfg.position.numIndices * sizeof(uint32_t))
+    if(!idxs.empty())
     {
-      if(m_VertexPick.IBSize > 0)
+      // resize up on demand
+      if(m_VertexPick.IBSize < cfg.position.numIndices * sizeof(uint32_t))
       {
-        m_VertexPick.IB.Destroy();
-        m_VertexPick.IBUpload.Destroy();
-      }
+        if(m_VertexPick.IBSize > 0)
+        {
+          m_VertexPick.IB.Destroy();
+          m_VertexPick.IBUpload.Destroy();
+        }
 
-      m_VertexPick.IBSize = cfg.position.numIndices * sizeof(uint32_t);
+        m_VertexPick.IBSize = cfg.position.numIndices * sizeof(uint32_t);
 
-      m_VertexPick.IB.Create(m_pDriver, dev, m_VertexPick.IBSize, 1,
-                             GPUBuffer::eGPUBufferGPULocal | GPUBuffer::eGPUBufferSSBO);
-      m_VertexPick.IBUpload.Create(m_pDriver, dev, m_VertexPick.IBSize, 1, 0);
-    }
-
-    uint32_t *outidxs = (uint32_t *)m_VertexPick.IBUpload.Map();
+        m_VertexPick.IB.Create(m_pDriver, dev, m_VertexPick.IBSize, 1,
+                               GPUBuffer::eGPUBufferGPULocal | GPUBuffer::eGPUBufferSSBO);
+        m_VertexPick.IBUpload.Create(m_pDriver, dev, m_VertexPick.IBSize, 1, 0);
+      }
 
-    memset(outidxs, 0, m_VertexPick.IBSize);
+      uint32_t *outidxs = (uint32_t *)m_VertexPick.IBUpload.Map();
 
-    uint16_t *idxs16 = (uint16_t *)&idxs[0];
-    uint32_t *idxs32 = (uint32_t *)&idxs[0];
+      memset(outidxs, 0, m_VertexPick.IBSize);
 
-    if(cfg.position.indexByteStride == 2)
-    {
-      size_t bufsize = idxs.size() / 2;
+      uint16_t *idxs16 = (uint16_t *)&idxs[0];
+      uint32_t *idxs32 = (uint32_t *)&idxs[0];
 
-      for(uint32_t i = 0; i < bufsize && i < cfg.position.numIndices; i++)
+      if(cfg.position.indexByteStride == 2)
       {
-        uint32_t idx = idxs16[i];
+        size_t bufsize = idxs.size() / 2;
 
-        if(idx < idxclamp)
-          idx = 0;
-        else if(cfg.position.baseVertex < 0)
-          idx -= idxclamp;
-        else if(cfg.position.baseVertex > 0)
-          idx += cfg.position.baseVertex;
-
-        if(i == 0)
+        for(uint32_t i = 0; i < bufsize && i < cfg.position.numIndices; i++)
         {
-          minIndex = maxIndex = idx;
+          uint32_t idx = idxs16[i];
+
+          if(idx < idxclamp)
+            idx = 0;
+          else if(cfg.position.baseVertex < 0)
+            idx -= idxclamp;
+          else if(cfg.position.baseVertex > 0)
+            idx += cfg.position.baseVertex;
+
+          if(i == 0)
+          {
+            minIndex = maxIndex = idx;
+          }
+          else
+          {
+            minIndex = RDCMIN(idx, minIndex);
+            maxIndex = RDCMAX(idx, maxIndex);
+          }
+
+          outidxs[i] = idx;
         }
-        else
+      }
+      else
+      {
+        uint32_t bufsize = uint32_t(idxs.size() / 4);
+
+        minIndex = maxIndex = idxs32[0];
+
+        for(uint32_t i = 0; i < RDCMIN(bufsize, cfg.position.numIndices); i++)
         {
+          uint32_t idx = idxs32[i];
+
+          if(idx < idxclamp)
+            idx = 0;
+          else if(cfg.position.baseVertex < 0)
+            idx -= idxclamp;
+          else if(cfg.position.baseVertex > 0)
+            idx += cfg.position.baseVertex;
+
           minIndex = RDCMIN(idx, minIndex);
           maxIndex = RDCMAX(idx, maxIndex);
-        }
 
-        outidxs[i] = idx;
+          outidxs[i] = idx;
+        }
       }
+
+      m_VertexPick.IBUpload.Unmap();
     }
-    else
+
+    // unpack and linearise the data
     {
-      uint32_t bufsize = uint32_t(idxs.size() / 4);
+      bytebuf oldData;
+      GetBufferData(cfg.position.vertexResourceId, cfg.position.vertexByteOffset, 0, oldData);
 
-      minIndex = maxIndex = idxs32[0];
+      // clamp maxIndex to upper bound in case we got invalid indices or primitive restart indices
+      maxIndex = RDCMIN(maxIndex, uint32_t(oldData.size() / RDCMAX(1U, cfg.position.vertexByteStride)));
 
-      for(uint32_t i = 0; i < RDCMIN(bufsize, cfg.position.numIndices); i++)
+      if(m_VertexPick.VBSize < (maxIndex + 1) * sizeof(FloatVector))
       {
-        uint32_t idx = idxs32[i];
-
-        if(idx < idxclamp)
-          idx = 0;
-        else if(cfg.position.baseVertex < 0)
-          idx -= idxclamp;
-        else if(cfg.position.baseVertex > 0)
-          idx += cfg.position.baseVertex;
+        if(m_VertexPick.VBSize > 0)
+        {
+          m_VertexPick.VB.Destroy();
+          m_VertexPick.VBUpload.Destroy();
+        }
 
-        minIndex = RDCMIN(idx, minIndex);
-        maxIndex = RDCMAX(idx, maxIndex);
+        m_VertexPick.VBSize = (maxIndex + 1) * sizeof(FloatVector);
 
-        outidxs[i] = idx;
+        m_VertexPick.VB.Create(m_pDriver, dev, m_VertexPick.VBSize, 1,
+                               GPUBuffer::eGPUBufferGPULocal | GPUBuffer::eGPUBufferSSBO);
+        m_VertexPick.VBUpload.Create(m_pDriver, dev, m_VertexPick.VBSize, 1, 0);
       }
-    }
-
-    m_VertexPick.IBUpload.Unmap();
-  }
 
-  // unpack and linearise the data
-  {
-    bytebuf oldData;
-    GetBufferData(cfg.position.vertexResourceId, cfg.position.vertexByteOffset, 0, oldData);
+      byte *data = &oldData[0];
+      byte *dataEnd = data + oldData.size();
 
-    // clamp maxIndex to upper bound in case we got invalid indices or primitive restart indices
-    maxIndex = RDCMIN(maxIndex, uint32_t(oldData.size() / RDCMAX(1U, cfg.position.vertexByteStride)));
+      bool valid = true;
 
-    if(m_VertexPick.VBSize < (maxIndex + 1) * sizeof(FloatVector))
-    {
-      if(m_VertexPick.VBSize > 0)
-      {
-        m_VertexPick.VB.Destroy();
-        m_VertexPick.VBUpload.Destroy();
-      }
+      FloatVector *vbData = (FloatVector *)m_VertexPick.VBUpload.Map();
 
-      m_VertexPick.VBSize = (maxIndex + 1) * sizeof(FloatVector);
+      // the index buffer may refer to vertices past the start of the vertex buffer, so we can't just
+      // conver the first N vertices we'll need.
+      // Instead we grab min and max above, and convert every vertex in that range. This might
+      // slightly over-estimate but not as bad as 0-max or the whole buffer.
+      for(uint32_t idx = minIndex; idx <= maxIndex; idx++)
+        vbData[idx] = HighlightCache::InterpretVertex(data, idx, cfg.position.vertexByteStride,
+                                                      cfg.position.format, dataEnd, valid);
 
-      m_VertexPick.VB.Create(m_pDriver, dev, m_VertexPick.VBSize, 1,
-                             GPUBuffer::eGPUBufferGPULocal | GPUBuffer::eGPUBufferSSBO);
-      m_VertexPick.VBUpload.Create(m_pDriver, dev, m_VertexPick.VBSize, 1, 0);
+      m_VertexPick.VBUpload.Unmap();
     }
 
-    byte *data = &oldData[0];
-    byte *dataEnd = data + oldData.size();
+    VkDescriptorBufferInfo ibInfo = {};
+    VkDescriptorBufferInfo vbInfo = {};
 
-    bool valid = true;
+    m_VertexPick.VB.FillDescriptor(vbInfo);
+    m_VertexPick.IB.FillDescriptor(ibInfo);
 
-    FloatVector *vbData = (FloatVector *)m_VertexPick.VBUpload.Map();
-
-    // the index buffer may refer to vertices past the start of the vertex buffer, so we can't just
-    // conver the first N vertices we'll need.
-    // Instead we grab min and max above, and convert every vertex in that range. This might
-    // slightly over-estimate but not as bad as 0-max or the whole buffer.
-    for(uint32_t idx = minIndex; idx <= maxIndex; idx++)
-      vbData[idx] = HighlightCache::InterpretVertex(data, idx, cfg.position.vertexByteStride,
-                                                    cfg.position.format, dataEnd, valid);
-
-    m_VertexPick.VBUpload.Unmap();
-  }
+    VkWriteDescriptorSet writes[] = {
+        {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, NULL, Unwrap(m_VertexPick.DescSet), 1, 0, 1,
+         VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, NULL, &vbInfo, NULL},
+        {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, NULL, Unwrap(m_VertexPick.DescSet), 2, 0, 1,
+         VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, NULL, &ibInfo, NULL},
+    };
 
-  VkDescriptorBufferInfo ibInfo = {};
-  VkDescriptorBufferInfo vbInfo = {};
+    if(!idxs.empty())
+      vt->UpdateDescriptorSets(Unwrap(m_Device), 2, writes, 0, NULL);
+    else
+      vt->UpdateDescriptorSets(Unwrap(m_Device), 1, writes, 0, NULL);
 
-  m_VertexPick.VB.FillDescriptor(vbInfo);
-  m_VertexPick.IB.FillDescriptor(ibInfo);
+    hasIdxs = !idxs.empty();
 
-  VkWriteDescriptorSet writes[] = {
-      {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, NULL, Unwrap(m_VertexPick.DescSet), 1, 0, 1,
-       VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, NULL, &vbInfo, NULL},
-      {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, NULL, Unwrap(m_VertexPick.DescSet), 2, 0, 1,
-       VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, NULL, &ibInfo, NULL},
-  };
-
-  if(!idxs.empty())
-    vt->UpdateDescriptorSets(Unwrap(m_Device), 2, writes, 0, NULL);
-  else
-    vt->UpdateDescriptorSets(Unwrap(m_Device), 1, writes, 0, NULL);
+    m_VertexPick.CacheValid = true;
+    m_VertexPick.CacheHasIdxs = hasIdxs;
+    m_VertexPick.CacheEventID = eventId;
+    m_VertexPick.CachePosition = cfg.position;
+  }
 
   VkCommandBuffer cmd = m_pDriver->GetNextCmd();
 
@@ -1274,44 +1307,48 @@ uint32_t VulkanReplay::PickVertex(uint32_t eventId, int32_t w, int32_t h, const
   // wait for zero to be written to atomic counter before using in shader
   DoPipelineBarrier(cmd, 1, &bufBarrier);
 
-  // copy uploaded VB and if needed IB
-  if(!idxs.empty())
+  // copy the newly uploaded VB and if needed IB. If the mesh data was cached the GPU-local
+  // buffers already hold the right contents from the previous pick.
+  if(!meshCached)
   {
+    if(hasIdxs)
+    {
+      // wait for writes
+      bufBarrier.buffer = Unwrap(m_VertexPick.IBUpload.buf);
+      bufBarrier.srcAccessMask = VK_ACCESS_HOST_WRITE_BIT;
+      bufBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+      DoPipelineBarrier(cmd, 1, &bufBarrier);
+
+      // do copy
+      bufCopy.size = m_VertexPick.IBSize;
+      vt->CmdCopyBuffer(Unwrap(cmd), Unwrap(m_VertexPick.IBUpload.buf), Unwrap(m_VertexPick.IB.buf),
+                        1, &bufCopy);
+
+      // wait for copy
+      bufBarrier.buffer = Unwrap(m_VertexPick.IB.buf);
+      bufBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+      bufBarrier.dstAccessMask = VK_ACCESS_UNIFORM_READ_BIT;
+      DoPipelineBarrier(cmd, 1, &bufBarrier);
+    }
+
     // wait for writes
-    bufBarrier.buffer = Unwrap(m_VertexPick.IBUpload.buf);
+    bufBarrier.buffer = Unwrap(m_VertexPick.VBUpload.buf);
     bufBarrier.srcAccessMask = VK_ACCESS_HOST_WRITE_BIT;
     bufBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
     DoPipelineBarrier(cmd, 1, &bufBarrier);
 
     // do copy
-    bufCopy.size = m_VertexPick.IBSize;
-    vt->CmdCopyBuffer(Unwrap(cmd), Unwrap(m_VertexPick.IBUpload.buf), Unwrap(m_VertexPick.IB.buf),
+    bufCopy.size = m_VertexPick.VBSize;
+    vt->CmdCopyBuffer(Unwrap(cmd), Unwrap(m_VertexPick.VBUpload.buf), Unwrap(m_VertexPick.VB.buf),
                       1, &bufCopy);
 
     // wait for copy
-    bufBarrier.buffer = Unwrap(m_VertexPick.IB.buf);
+    bufBarrier.buffer = Unwrap(m_VertexPick.VB.buf);
     bufBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
     bufBarrier.dstAccessMask = VK_ACCESS_UNIFORM_READ_BIT;
     DoPipelineBarrier(cmd, 1, &bufBarrier);
   }
 
-  // wait for writes
-  bufBarrier.buffer = Unwrap(m_VertexPick.VBUpload.buf);
-  bufBarrier.srcAccessMask = VK_ACCESS_HOST_WRITE_BIT;
-  bufBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
-  DoPipelineBarrier(cmd, 1, &bufBarrier);
-
-  // do copy
-  bufCopy.size = m_VertexPick.VBSize;
-  vt->CmdCopyBuffer(Unwrap(cmd), Unwrap(m_VertexPick.VBUpload.buf), Unwrap(m_VertexPick.VB.buf), 1,
-                    &bufCopy);
-
-  // wait for copy
-  bufBarrier.buffer = Unwrap(m_VertexPick.VB.buf);
-  bufBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-  bufBarrier.dstAccessMask = VK_ACCESS_UNIFORM_READ_BIT;
-  DoPipelineBarrier(cmd, 1, &bufBarrier);
-
   vt->CmdBindPipeline(Unwrap(cmd), VK_PIPELINE_BIND_POINT_COMPUTE, Unwrap(m_VertexPick.Pipeline));
   vt->CmdBindDescriptorSets(Unwrap(cmd), VK_PIPELINE_BIND_POINT_COMPUTE, Unwrap(m_VertexPick.Layout),
                             0, 1, UnwrapPtr(m_VertexPick.DescSet), 0, NULL);
@@ -1422,6 +1459,28 @@ uint32_t VulkanReplay::PickVertex(uint32_t eventId, int32_t w, int32_t h, const
   return ret;
 }
 
+GPUBuffer &VulkanDebugManager::GetReadbackWindow(VkDeviceSize size)
+{
+  if(size > m_ReadbackWindow.totalsize)
+  {
+    // grow in whole multiples of the base staging size, so scrubbing through similar-sized
+    // resources settles on one allocation instead of recreating the buffer every fetch
+    VkDeviceSize newSize = AlignUp(size, STAGE_BUFFER_BYTE_SIZE);
+
+    RDCDEBUG("Growing readback window from %llu to %llu bytes", m_ReadbackWindow.totalsize,
+             newSize);
+
+    // the previous window may still be referenced by the last submit, drain the queue before
+    // destroying it
+    m_pDriver->FlushQ();
+
+    m_ReadbackWindow.Destroy();
+    m_ReadbackWindow.Create(m_pDriver, m_Device, newSize, 1, GPUBuffer::eGPUBufferReadback);
+  }
+
+  return m_ReadbackWindow;
+}
+
 void VulkanDebugManager::GetBufferData(ResourceId buff, uint64_t offset, uint64_t len, bytebuf &ret)
 {
   VkDevice dev = m_pDriver->GetDev();
@@ -1469,6 +1528,10 @@ void VulkanDebugManager::GetBufferData(ResourceId buff, uint64_t offset, uint64_
 
   ret.resize((size_t)len);
 
+  // grow the shared staging window to fit the whole read where reasonable, so the common case is
+  // one copy/flush instead of a chunked loop. Oversized reads still chunk through the window.
+  GetReadbackWindow(RDCMIN((VkDeviceSize)len, MAX_STAGE_BUFFER_BYTE_SIZE));
+
   VkDeviceSize srcoffset = (VkDeviceSize)offset;
   size_t dstoffset = 0;
   VkDeviceSize sizeRemaining = (VkDeviceSize)len;
@@ -1507,7 +1570,7 @@ void VulkanDebugManager::GetBufferData(ResourceId buff, uint64_t offset, uint64_
 
   while(sizeRemaining > 0)
   {
-    VkDeviceSize chunkSize = RDCMIN(sizeRemaining, STAGE_BUFFER_BYTE_SIZE);
+    VkDeviceSize chunkSize = RDCMIN(sizeRemaining, m_ReadbackWindow.totalsize);
 
     cmd = m_pDriver->GetNextCmd();
 
@@ -1554,7 +1617,8 @@ void VulkanDebugManager::GetBufferData(ResourceId buff, uint64_t offset, uint64_
     vt->UnmapMemory(Unwrap(dev), Unwrap(m_ReadbackWindow.mem));
   }
 
-  vt->DeviceWaitIdle(Unwrap(dev));
+  // no need to idle the device here - FlushQ above has already synchronised with the copies, and
+  // the staging window is only reused after the next readback's own flush.
 }
 
 void VulkanDebugManager::CustomShaderRendering::Destroy(WrappedVulkan *driver)
@@ -2140,8 +2204,21 @@ void VulkanReplay::OverlayRendering::Init(WrappedVulkan *driver, VkDescriptorPoo
   driver->vkDestroyRenderPass(driver->GetDev(), SRGBA8MSRP, NULL);
 }
 
+void VulkanReplay::OverlayRendering::ResetQuadPipeCache(WrappedVulkan *driver)
+{
+  for(auto it = m_QuadPipeCache.begin(); it != m_QuadPipeCache.end(); ++it)
+  {
+    driver->vkDestroyPipeline(driver->GetDev(), it->second.pipe, NULL);
+    driver->vkDestroyPipelineLayout(driver->GetDev(), it->second.pipeLayout, NULL);
+  }
+
+  m_QuadPipeCache.clear();
+}
+
 void VulkanReplay::OverlayRendering::Destroy(WrappedVulkan *driver)
 {
+  ResetQuadPipeCache(driver);
+
   if(ImageMem == VK_NULL_HANDLE)
     return;
 
@@ -2180,6 +2257,9 @@ void VulkanReplay::MeshRendering::Init(WrappedVulkan *driver, VkDescriptorPool d
 
   UBO.Create(driver, driver->GetDev(), sizeof(MeshUBOData), 16, 0);
   BBoxVB.Create(driver, driver->GetDev(), sizeof(Vec4f) * 128, 16, GPUBuffer::eGPUBufferVBuffer);
+  IndirectBuf.Create(driver, driver->GetDev(),
+                     sizeof(VkDrawIndexedIndirectCommand) * MaxIndirectCommands, 16,
+                     GPUBuffer::eGPUBufferIndirectBuffer);
 
   Vec4f TLN = Vec4f(-1.0f, 1.0f, 0.0f, 1.0f);    // TopLeftNear, etc...
   Vec4f TRN = Vec4f(1.0f, 1.0f, 0.0f, 1.0f);
@@ -2236,6 +2316,7 @@ void VulkanReplay::MeshRendering::Destroy(WrappedVulkan *driver)
   UBO.Destroy();
   BBoxVB.Destroy();
   AxisFrustumVB.Destroy();
+  IndirectBuf.Destroy();
 
   driver->vkDestroyDescriptorSetLayout(driver->GetDev(), DescSetLayout, NULL);
   driver->vkDestroyPipelineLayout(driver->GetDev(), PipeLayout, NULL);
@@ -2426,8 +2507,6 @@ void VulkanReplay::HistogramMinMax::Init(WrappedVulkan *driver, VkDescriptorPool
 
   shaderCache->SetCaching(true);
 
-  std::string glsl;
-
   CREATE_OBJECT(m_HistogramDescSetLayout,
                 {
                     {0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_ALL, NULL},
@@ -2461,63 +2540,82 @@ void VulkanReplay::HistogramMinMax::Init(WrappedVulkan *driver, VkDescriptorPool
   RDCCOMPILE_ASSERT(RESTYPE_TEXTYPEMAX == ARRAY_COUNT(m_MinMaxTilePipe),
                     "RESTYPE values don't match formats for dummy images");
 
+  SPIRVBlob minmaxtile[ARRAY_COUNT(m_MinMaxTilePipe)][ARRAY_COUNT(m_MinMaxTilePipe[0])] = {};
+  SPIRVBlob histogram[ARRAY_COUNT(m_MinMaxTilePipe)][ARRAY_COUNT(m_MinMaxTilePipe[0])] = {};
+  SPIRVBlob minmaxresult[ARRAY_COUNT(m_MinMaxResultPipe)] = {};
+
+  // compile all the shader variants in parallel on the task pool. Each compile is independent and
+  // costs tens of milliseconds in glslang, so done serially this loop is most of the histogram
+  // init time. Pipeline creation stays on this thread once all the blobs are ready
+  Threading::TaskGroup compiles;
+
   for(size_t t = 1; t < ARRAY_COUNT(m_MinMaxTilePipe); t++)
   {
     for(size_t f = 0; f < ARRAY_COUNT(m_MinMaxTilePipe[0]); f++)
     {
-      SPIRVBlob minmaxtile = NULL;
-      SPIRVBlob minmaxresult = NULL;
-      SPIRVBlob histogram = NULL;
-      std::string err;
-
-      std::string defines = "";
-
-      if(driver->GetDriverInfo().TexelFetchBrokenDriver())
-        defines += "#define NO_TEXEL_FETCH\n";
-      defines += string("#define SHADER_RESTYPE ") + ToStr(t) + "\n";
-      defines += string("#define UINT_TEX ") + (f == 1 ? "1" : "0") + "\n";
-      defines += string("#define SINT_TEX ") + (f == 2 ? "1" : "0") + "\n";
+      Threading::TaskPool::Instance().Submit(compiles, [driver, shaderCache, compileSettings, t, f,
+                                                        &minmaxtile, &histogram, &minmaxresult]() {
+        std::string glsl;
+        std::string err;
 
-      glsl =
-          GenerateGLSLShader(GetEmbeddedResource(glsl_histogram_comp), eShaderVulkan, 430, defines);
+        std::string defines = "";
 
-      err = shaderCache->GetSPIRVBlob(compileSettings, glsl, histogram);
-      if(!err.empty())
-      {
-        RDCERR("Error compiling histogram shader: %s. Defines are:\n%s", err.c_str(),
-               defines.c_str());
-        histogram = NULL;
-      }
+        if(driver->GetDriverInfo().TexelFetchBrokenDriver())
+          defines += "#define NO_TEXEL_FETCH\n";
+        defines += string("#define SHADER_RESTYPE ") + ToStr(t) + "\n";
+        defines += string("#define UINT_TEX ") + (f == 1 ? "1" : "0") + "\n";
+        defines += string("#define SINT_TEX ") + (f == 2 ? "1" : "0") + "\n";
 
-      glsl =
-          GenerateGLSLShader(GetEmbeddedResource(glsl_minmaxtile_comp), eShaderVulkan, 430, defines);
-
-      err = shaderCache->GetSPIRVBlob(compileSettings, glsl, minmaxtile);
-      if(!err.empty())
-      {
-        RDCERR("Error compiling min/max tile shader: %s. Defines are:\n%s", err.c_str(),
-               defines.c_str());
-        minmaxtile = NULL;
-      }
+        glsl = GenerateGLSLShader(GetEmbeddedResource(glsl_histogram_comp), eShaderVulkan, 430,
+                                  defines);
 
-      CREATE_OBJECT(m_MinMaxTilePipe[t][f], m_HistogramPipeLayout, minmaxtile);
-      CREATE_OBJECT(m_HistogramPipe[t][f], m_HistogramPipeLayout, histogram);
+        err = shaderCache->GetSPIRVBlob(compileSettings, glsl, histogram[t][f]);
+        if(!err.empty())
+        {
+          RDCERR("Error compiling histogram shader: %s. Defines are:\n%s", err.c_str(),
+                 defines.c_str());
+          histogram[t][f] = NULL;
+        }
 
-      if(t == 1)
-      {
-        glsl = GenerateGLSLShader(GetEmbeddedResource(glsl_minmaxresult_comp), eShaderVulkan, 430,
+        glsl = GenerateGLSLShader(GetEmbeddedResource(glsl_minmaxtile_comp), eShaderVulkan, 430,
                                   defines);
 
-        err = shaderCache->GetSPIRVBlob(compileSettings, glsl, minmaxresult);
+        err = shaderCache->GetSPIRVBlob(compileSettings, glsl, minmaxtile[t][f]);
         if(!err.empty())
         {
-          RDCERR("Error compiling min/max result shader: %s. Defines are:\n%s", err.c_str(),
+          RDCERR("Error compiling min/max tile shader: %s. Defines are:\n%s", err.c_str(),
                  defines.c_str());
-          minmaxresult = NULL;
+          minmaxtile[t][f] = NULL;
         }
 
-        CREATE_OBJECT(m_MinMaxResultPipe[f], m_HistogramPipeLayout, minmaxresult);
-      }
+        if(t == 1)
+        {
+          glsl = GenerateGLSLShader(GetEmbeddedResource(glsl_minmaxresult_comp), eShaderVulkan, 430,
+                                    defines);
+
+          err = shaderCache->GetSPIRVBlob(compileSettings, glsl, minmaxresult[f]);
+          if(!err.empty())
+          {
+            RDCERR("Error compiling min/max result shader: %s. Defines are:\n%s", err.c_str(),
+                   defines.c_str());
+            minmaxresult[f] = NULL;
+          }
+        }
+      });
+    }
+  }
+
+  Threading::TaskPool::Instance().Wait(compiles);
+
+  for(size_t t = 1; t < ARRAY_COUNT(m_MinMaxTilePipe); t++)
+  {
+    for(size_t f = 0; f < ARRAY_COUNT(m_MinMaxTilePipe[0]); f++)
+    {
+      CREATE_OBJECT(m_MinMaxTilePipe[t][f], m_HistogramPipeLayout, minmaxtile[t][f]);
+      CREATE_OBJECT(m_HistogramPipe[t][f], m_HistogramPipeLayout, histogram[t][f]);
+
+      if(t == 1)
+        CREATE_OBJECT(m_MinMaxResultPipe[f], m_HistogramPipeLayout, minmaxresult[f]);
     }
   }
 
@@ -58,6 +58,11 @@ public:
 
   void GetBufferData(ResourceId buff, uint64_t offset, uint64_t len, bytebuf &ret);
 
+  // returns the shared staging buffer used by readback paths (GetBufferData here, texture
+  // readback in VulkanReplay), grown if necessary so it's at least size bytes. The contents do
+  // not persist between calls - every user copies in, flushes the queue, and copies back out.
+  GPUBuffer &GetReadbackWindow(VkDeviceSize size);
+
   bool IsMS2ArraySupported() { return m_MS2ArrayPipe != VK_NULL_HANDLE; }
   void CopyTex2DMSToArray(VkImage destArray, VkImage srcMS, VkExtent3D extent, uint32_t layers,
                           uint32_t samples, VkFormat fmt);
@@ -80,7 +85,7 @@ public:
                                  uint32_t &indexCount);
 
 private:
-  // GetBufferData
+  // shared staging window for readback paths - see GetReadbackWindow()
   GPUBuffer m_ReadbackWindow;
 
   // CacheMeshDisplayPipelines
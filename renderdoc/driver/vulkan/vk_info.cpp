@@ -232,6 +232,8 @@ void VulkanCreationInfo::Pipeline::Init(VulkanResourceManager *resourceMan, Vulk
     shad.module = id;
     shad.entryPoint = pCreateInfo->pStages[i].pName;
 
+    info.m_ShaderModule[id].EnsureParsed();
+
     ShaderModule::Reflection &reflData = info.m_ShaderModule[id].m_Reflections[shad.entryPoint];
 
     reflData.Init(resourceMan, id, info.m_ShaderModule[id].spirv, shad.entryPoint,
@@ -539,6 +541,8 @@ void VulkanCreationInfo::Pipeline::Init(VulkanResourceManager *resourceMan, Vulk
     shad.module = id;
     shad.entryPoint = pCreateInfo->stage.pName;
 
+    info.m_ShaderModule[id].EnsureParsed();
+
     ShaderModule::Reflection &reflData = info.m_ShaderModule[id].m_Reflections[shad.entryPoint];
 
     reflData.Init(resourceMan, id, info.m_ShaderModule[id].spirv, shad.entryPoint,
@@ -990,10 +994,96 @@ void VulkanCreationInfo::ShaderModule::Init(VulkanResourceManager *resourceMan,
   else
   {
     RDCASSERT(pCreateInfo->codeSize % sizeof(uint32_t) == 0);
-    ParseSPIRV((uint32_t *)pCreateInfo->pCode, pCreateInfo->codeSize / sizeof(uint32_t), spirv);
+    info.QueueShaderParse(this, (const uint32_t *)pCreateInfo->pCode,
+                          pCreateInfo->codeSize / sizeof(uint32_t));
   }
 }
 
+void VulkanCreationInfo::ShaderModule::EnsureParsed() const
+{
+  // the worker will clear the flag when the parse completes. We can't steal the job and parse it
+  // ourselves since it may already be mid-parse on a worker, so just wait - the pool always
+  // drains its queue.
+  while(Atomic::CmpExch32(&parsePending, 0, 0) != 0)
+    Threading::Sleep(0);
+}
+
+void VulkanCreationInfo::QueueShaderParse(ShaderModule *module, const uint32_t *code, size_t codeLen)
+{
+  ShaderParseJob job;
+  job.code.assign(code, code + codeLen);
+  job.module = module;
+
+  Atomic::Inc32(&module->parsePending);
+
+  {
+    SCOPED_LOCK(m_ShaderParseLock);
+
+    m_ShaderParseQueue.push_back(std::move(job));
+
+    // lazily start the workers on first use. Leave a core for the main thread which is busy
+    // processing the rest of the chunks.
+    if(m_ShaderParseThreads.empty())
+    {
+      uint32_t numThreads = RDCMAX(1U, Threading::NumberOfCores() - 1);
+
+      for(uint32_t i = 0; i < numThreads; i++)
+        m_ShaderParseThreads.push_back(
+            Threading::CreateThread([this]() { ShaderParseWorkerEntry(); }));
+    }
+  }
+}
+
+void VulkanCreationInfo::ShaderParseWorkerEntry()
+{
+  for(;;)
+  {
+    ShaderParseJob job;
+    bool haveJob = false;
+
+    {
+      SCOPED_LOCK(m_ShaderParseLock);
+      if(!m_ShaderParseQueue.empty())
+      {
+        job = std::move(m_ShaderParseQueue.back());
+        m_ShaderParseQueue.pop_back();
+        haveJob = true;
+      }
+    }
+
+    if(!haveJob)
+    {
+      // only exit once the queue has fully drained
+      if(Atomic::CmpExch32(&m_ShaderParseKill, 1, 1) == 1)
+        return;
+
+      Threading::Sleep(1);
+      continue;
+    }
+
+    ParseSPIRV(job.code.data(), job.code.size(), job.module->spirv);
+
+    Atomic::Dec32(&job.module->parsePending);
+  }
+}
+
+void VulkanCreationInfo::ShutdownShaderParseWorkers()
+{
+  if(m_ShaderParseThreads.empty())
+    return;
+
+  Atomic::Inc32(&m_ShaderParseKill);
+
+  for(Threading::ThreadHandle thread : m_ShaderParseThreads)
+  {
+    Threading::JoinThread(thread);
+    Threading::CloseThread(thread);
+  }
+
+  m_ShaderParseThreads.clear();
+  m_ShaderParseKill = 0;
+}
+
 void VulkanCreationInfo::ShaderModule::Reflection::Init(VulkanResourceManager *resourceMan,
                                                         ResourceId id, const SPVModule &spv,
                                                         const std::string &entry,
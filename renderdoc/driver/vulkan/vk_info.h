@@ -461,8 +461,17 @@ struct VulkanCreationInfo
     void Init(VulkanResourceManager *resourceMan, VulkanCreationInfo &info,
               const VkShaderModuleCreateInfo *pCreateInfo);
 
+    // Init() pushes the actual SPIR-V parse onto a background worker pool during capture load,
+    // since modules are independent and the parse is one of the heavier CPU costs while loading.
+    // Anything reading spirv before the pool has been shut down must call this first - it blocks
+    // until any in-flight parse for this module has finished.
+    void EnsureParsed() const;
+
     SPVModule spirv;
 
+    // non-zero while a background parse of spirv is queued or running. See EnsureParsed().
+    mutable volatile int32_t parsePending = 0;
+
     string unstrippedPath;
 
     struct Reflection
@@ -502,4 +511,25 @@ struct VulkanCreationInfo
 
   // just contains the queueFamilyIndex (after remapping)
   std::map<ResourceId, uint32_t> m_Queue;
+
+  // worker pool for background SPIR-V parsing during capture load. Started lazily by the first
+  // queued parse; ShutdownShaderParseWorkers() drains the queue and joins the threads, and must
+  // be called before the initialisation phase ends so later consumers can read shader modules
+  // without synchronisation. Safe to call when no workers were ever started.
+  void QueueShaderParse(ShaderModule *module, const uint32_t *code, size_t codeLen);
+  void ShutdownShaderParseWorkers();
+
+private:
+  struct ShaderParseJob
+  {
+    std::vector<uint32_t> code;
+    ShaderModule *module;
+  };
+
+  void ShaderParseWorkerEntry();
+
+  Threading::CriticalSection m_ShaderParseLock;
+  std::vector<ShaderParseJob> m_ShaderParseQueue;
+  std::vector<Threading::ThreadHandle> m_ShaderParseThreads;
+  volatile int32_t m_ShaderParseKill = 0;
 };
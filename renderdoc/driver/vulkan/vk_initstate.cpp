@@ -22,6 +22,7 @@
  * THE SOFTWARE.
  ******************************************************************************/
 
+#include "3rdparty/zstd/xxhash.h"
 #include "vk_core.h"
 #include "vk_debug.h"
 
@@ -34,12 +35,86 @@
 // VKTODOLOW The code pattern for creating a few contiguous arrays all in one
 // AllocAlignedBuffer for the initial contents buffer is ugly.
 
-// VKTODOLOW in general we do a lot of "create buffer, use it, flush/sync then destroy".
-// I don't know what the exact cost is, but it would be nice to batch up the buffers/etc
-// used across init state use, and only do a single flush. Also we could then get some
-// nice command buffer reuse (although need to be careful we don't create too large a
-// command buffer that stalls the GPU).
-// See INITSTATEBATCH
+void WrappedVulkan::Begin_PrepareInitialBatch()
+{
+  m_PrepareInitStateBatching = true;
+}
+
+void WrappedVulkan::FlushPendingInitialStates()
+{
+  if(m_PrepareInitStateCmds == 0)
+    return;
+
+  VkDevice d = GetDev();
+
+  // one submit and sync covers every copy accumulated since the last flush
+  SubmitCmds();
+  FlushQ();
+
+  for(VkBuffer buf : m_PrepareInitStateBufs)
+  {
+    ObjDisp(d)->DestroyBuffer(Unwrap(d), Unwrap(buf), NULL);
+    GetResourceManager()->ReleaseWrappedResource(buf);
+  }
+
+  for(VkImage im : m_PrepareInitStateImgs)
+  {
+    ObjDisp(d)->DestroyImage(Unwrap(d), Unwrap(im), NULL);
+    GetResourceManager()->ReleaseWrappedResource(im);
+  }
+
+  m_PrepareInitStateBufs.clear();
+  m_PrepareInitStateImgs.clear();
+  m_PrepareInitStateCmds = 0;
+}
+
+void WrappedVulkan::End_PrepareInitialBatch()
+{
+  FlushPendingInitialStates();
+
+  // descriptor set snapshots were built on the task pool - wait for them and hand the results to
+  // the resource manager on this thread
+  Threading::TaskPool::Instance().Wait(m_PrepareInitStateTasks);
+
+  for(auto it = m_PrepareInitStateDescSets.begin(); it != m_PrepareInitStateDescSets.end(); ++it)
+    GetResourceManager()->SetInitialContents(it->first, it->second);
+
+  m_PrepareInitStateDescSets.clear();
+
+  m_PrepareInitStateBatching = false;
+}
+
+void WrappedVulkan::PrepareDescriptorSetInitialContents(VkResourceRecord *record,
+                                                        VkInitialContents &initialContents)
+{
+  RDCASSERT(record->descInfo && record->descInfo->layout);
+  const DescSetLayout &layout = *record->descInfo->layout;
+
+  if((layout.flags & VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR) == 0)
+  {
+    for(size_t i = 0; i < layout.bindings.size(); i++)
+      initialContents.numDescriptors += layout.bindings[i].descriptorCount;
+
+    initialContents.descriptorSlots = new DescriptorSetSlot[initialContents.numDescriptors];
+    RDCEraseMem(initialContents.descriptorSlots,
+                sizeof(DescriptorSetSlot) * initialContents.numDescriptors);
+
+    uint32_t e = 0;
+    for(size_t i = 0; i < layout.bindings.size(); i++)
+    {
+      for(uint32_t b = 0; b < layout.bindings[i].descriptorCount; b++)
+      {
+        initialContents.descriptorSlots[e++].CreateFrom(record->descInfo->descBindings[i][b]);
+      }
+    }
+  }
+  else
+  {
+    RDCERR("Push descriptor set with initial contents! Should never have been marked dirty");
+    initialContents.numDescriptors = 0;
+    initialContents.descriptorSlots = NULL;
+  }
+}
 
 bool WrappedVulkan::Prepare_InitialState(WrappedVkRes *res)
 {
@@ -50,36 +125,27 @@ bool WrappedVulkan::Prepare_InitialState(WrappedVkRes *res)
   if(type == eResDescriptorSet)
   {
     VkResourceRecord *record = GetResourceManager()->GetResourceRecord(id);
-    RDCASSERT(record->descInfo && record->descInfo->layout);
-    const DescSetLayout &layout = *record->descInfo->layout;
-
-    VkInitialContents initialContents(type, VkInitialContents::DescriptorSet);
 
-    if((layout.flags & VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR) == 0)
+    if(m_PrepareInitStateBatching)
     {
-      for(size_t i = 0; i < layout.bindings.size(); i++)
-        initialContents.numDescriptors += layout.bindings[i].descriptorCount;
+      // pure CPU bookkeeping, so fan it out to the task pool. The deque gives the task a stable
+      // slot to build into; End_PrepareInitialBatch() waits and sets the results
+      m_PrepareInitStateDescSets.push_back(
+          {id, VkInitialContents(type, VkInitialContents::DescriptorSet)});
 
-      initialContents.descriptorSlots = new DescriptorSetSlot[initialContents.numDescriptors];
-      RDCEraseMem(initialContents.descriptorSlots,
-                  sizeof(DescriptorSetSlot) * initialContents.numDescriptors);
+      VkInitialContents *contents = &m_PrepareInitStateDescSets.back().second;
 
-      uint32_t e = 0;
-      for(size_t i = 0; i < layout.bindings.size(); i++)
-      {
-        for(uint32_t b = 0; b < layout.bindings[i].descriptorCount; b++)
-        {
-          initialContents.descriptorSlots[e++].CreateFrom(record->descInfo->descBindings[i][b]);
-        }
-      }
-    }
-    else
-    {
-      RDCERR("Push descriptor set with initial contents! Should never have been marked dirty");
-      initialContents.numDescriptors = 0;
-      initialContents.descriptorSlots = NULL;
+      Threading::TaskPool::Instance().Submit(m_PrepareInitStateTasks, [this, record, contents]() {
+        PrepareDescriptorSetInitialContents(record, *contents);
+      });
+
+      return true;
     }
 
+    VkInitialContents initialContents(type, VkInitialContents::DescriptorSet);
+
+    PrepareDescriptorSetInitialContents(record, initialContents);
+
     GetResourceManager()->SetInitialContents(id, initialContents);
     return true;
   }
@@ -506,17 +572,33 @@ bool WrappedVulkan::Prepare_InitialState(WrappedVkRes *res)
     vkr = ObjDisp(d)->EndCommandBuffer(Unwrap(cmd));
     RDCASSERTEQUAL(vkr, VK_SUCCESS);
 
-    // INITSTATEBATCH
-    SubmitCmds();
-    FlushQ();
+    // INITSTATEBATCH. Don't defer when an external queue is involved, to keep the existing
+    // ordering of the ownership transfer submissions
+    if(m_PrepareInitStateBatching && extQCmd == VK_NULL_HANDLE)
+    {
+      // defer the flush and staging cleanup - one submit at the end of the batch (or when
+      // enough copies accumulate) covers all resources
+      m_PrepareInitStateBufs.push_back(dstBuf);
 
-    ObjDisp(d)->DestroyBuffer(Unwrap(d), Unwrap(dstBuf), NULL);
-    GetResourceManager()->ReleaseWrappedResource(dstBuf);
+      if(arrayIm != VK_NULL_HANDLE)
+        m_PrepareInitStateImgs.push_back(arrayIm);
 
-    if(arrayIm != VK_NULL_HANDLE)
+      if(++m_PrepareInitStateCmds >= InitialStateBatchSize)
+        FlushPendingInitialStates();
+    }
+    else
     {
-      ObjDisp(d)->DestroyImage(Unwrap(d), Unwrap(arrayIm), NULL);
-      GetResourceManager()->ReleaseWrappedResource(arrayIm);
+      SubmitCmds();
+      FlushQ();
+
+      ObjDisp(d)->DestroyBuffer(Unwrap(d), Unwrap(dstBuf), NULL);
+      GetResourceManager()->ReleaseWrappedResource(dstBuf);
+
+      if(arrayIm != VK_NULL_HANDLE)
+      {
+        ObjDisp(d)->DestroyImage(Unwrap(d), Unwrap(arrayIm), NULL);
+        GetResourceManager()->ReleaseWrappedResource(arrayIm);
+      }
     }
 
     GetResourceManager()->SetInitialContents(id, VkInitialContents(type, readbackmem));
@@ -603,13 +685,24 @@ bool WrappedVulkan::Prepare_InitialState(WrappedVkRes *res)
     RDCASSERTEQUAL(vkr, VK_SUCCESS);
 
     // INITSTATEBATCH
-    SubmitCmds();
-    FlushQ();
+    if(m_PrepareInitStateBatching)
+    {
+      m_PrepareInitStateBufs.push_back(srcBuf);
+      m_PrepareInitStateBufs.push_back(dstBuf);
+
+      if(++m_PrepareInitStateCmds >= InitialStateBatchSize)
+        FlushPendingInitialStates();
+    }
+    else
+    {
+      SubmitCmds();
+      FlushQ();
 
-    ObjDisp(d)->DestroyBuffer(Unwrap(d), Unwrap(srcBuf), NULL);
-    ObjDisp(d)->DestroyBuffer(Unwrap(d), Unwrap(dstBuf), NULL);
-    GetResourceManager()->ReleaseWrappedResource(srcBuf);
-    GetResourceManager()->ReleaseWrappedResource(dstBuf);
+      ObjDisp(d)->DestroyBuffer(Unwrap(d), Unwrap(srcBuf), NULL);
+      ObjDisp(d)->DestroyBuffer(Unwrap(d), Unwrap(dstBuf), NULL);
+      GetResourceManager()->ReleaseWrappedResource(srcBuf);
+      GetResourceManager()->ReleaseWrappedResource(dstBuf);
+    }
 
     GetResourceManager()->SetInitialContents(id, VkInitialContents(type, readbackmem));
 
@@ -657,6 +750,76 @@ uint64_t WrappedVulkan::GetSize_InitialState(ResourceId id, const VkInitialConte
   return 128;
 }
 
+uint64_t WrappedVulkan::GetContentHash_InitialState(ResourceId id, const VkInitialContents &initial)
+{
+  uint64_t hash = 0;
+
+  if(initial.type == eResDescriptorSet)
+  {
+    VkResourceRecord *record = GetResourceManager()->GetResourceRecord(id);
+
+    RDCASSERT(record->descInfo && record->descInfo->layout);
+    const DescSetLayout &layout = *record->descInfo->layout;
+
+    uint32_t NumBindings = 0;
+
+    for(size_t i = 0; i < layout.bindings.size(); i++)
+      NumBindings += layout.bindings[i].descriptorCount;
+
+    if(initial.descriptorSlots == NULL || NumBindings == 0)
+      return 0;
+
+    // the serialised contents are generated directly from the snapshotted bindings, so
+    // byte-identical bindings give interchangeable chunks. Seed with the type so that equal bytes
+    // in different resource types can't collide.
+    hash = XXH64(initial.descriptorSlots, NumBindings * sizeof(DescriptorSetSlot),
+                 (uint64_t)initial.type);
+  }
+  else if(initial.type == eResImage || initial.type == eResDeviceMemory)
+  {
+    // sparse contents have page tables and per-aspect data beyond the raw bytes - don't try to
+    // deduplicate those
+    if(initial.tag == VkInitialContents::Sparse)
+      return 0;
+
+    if(initial.mem.mem == VK_NULL_HANDLE || initial.mem.size == 0)
+      return 0;
+
+    VkDevice d = GetDev();
+    byte *Contents = NULL;
+    VkResult vkr = ObjDisp(d)->MapMemory(Unwrap(d), Unwrap(initial.mem.mem), initial.mem.offs,
+                                         initial.mem.size, 0, (void **)&Contents);
+    RDCASSERTEQUAL(vkr, VK_SUCCESS);
+
+    if(vkr != VK_SUCCESS || Contents == NULL)
+      return 0;
+
+    // invalidate the cpu cache for this memory range to avoid reading stale data
+    VkMappedMemoryRange range = {
+        VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE, NULL, Unwrap(initial.mem.mem),
+        initial.mem.offs,                      initial.mem.size,
+    };
+
+    vkr = ObjDisp(d)->InvalidateMappedMemoryRanges(Unwrap(d), 1, &range);
+    RDCASSERTEQUAL(vkr, VK_SUCCESS);
+
+    hash = XXH64(Contents, (size_t)initial.mem.size, (uint64_t)initial.type);
+
+    ObjDisp(d)->UnmapMemory(Unwrap(d), Unwrap(initial.mem.mem));
+  }
+  else
+  {
+    // buffers (sparse-only) and anything else aren't deduplicated
+    return 0;
+  }
+
+  // 0 means 'no hash' to the resource manager, remap it in the astronomically unlikely case
+  if(hash == 0)
+    hash = 1;
+
+  return hash;
+}
+
 static rdcliteral NameOfType(VkResourceType type)
 {
   switch(type)
@@ -1314,9 +1477,11 @@ void WrappedVulkan::Apply_InitialState(WrappedVkRes *live, const VkInitialConten
     if(initial.numDescriptors == 0)
       return;
 
-    // deliberately go through our wrapper implementation, to unwrap the VkWriteDescriptorSet
-    // structs
-    vkUpdateDescriptorSets(GetDev(), initial.numDescriptors, writes, 0, NULL);
+    // batch the writes from every descriptor set into a few large vkUpdateDescriptorSets calls,
+    // flushed at the end of ApplyInitialContents. The write structs and everything they point to
+    // stay alive in the initial contents data, so shallow copies are fine.
+    m_PendingDescSetWrites.insert(m_PendingDescSetWrites.end(), writes,
+                                  writes + initial.numDescriptors);
 
     // need to blat over the current descriptor set contents, so these are available
     // when we want to fetch pipeline state
@@ -1598,6 +1763,28 @@ void WrappedVulkan::Apply_InitialState(WrappedVkRes *live, const VkInitialConten
       return;
     }
 
+    // images the frame doesn't write to only need their contents uploaded once, not re-applied
+    // before every replay. Layouts are restored separately when the capture-begin image states
+    // are applied, so the whole upload can be skipped.
+    if(GetResourceManager()->OptimizeInitialState())
+    {
+      ResourceId orig = GetResourceManager()->GetOriginalID(id);
+      ImgRefs *imgRefs = GetResourceManager()->FindImgRefs(orig);
+
+      if(imgRefs)
+      {
+        bool initialized = imgRefs->initializedLiveRes == live;
+        imgRefs->initializedLiveRes = live;
+
+        InitReqType initReq = InitReq(imgRefs->refType);
+        if(initialized && initReq != eInitReq_Reset && initReq != eInitReq_Clear)
+        {
+          RDCDEBUG("Apply_InitialState (Img %llu): skipped", orig);
+          return;
+        }
+      }
+    }
+
     if(m_CreationInfo.m_Image[id].samples != VK_SAMPLE_COUNT_1_BIT)
     {
       VkCommandBuffer cmd = GetNextCmd();
@@ -194,7 +194,34 @@ void VulkanResourceManager::RecordBarriers(vector<pair<ResourceId, ImageRegionSt
   {
     const VkImageMemoryBarrier &t = barriers[ti];
 
-    ResourceId id = IsReplayMode(m_State) ? GetNonDispWrapper(t.image)->id : GetResID(t.image);
+    ResourceId id;
+    uint32_t imageLevelCount = 0, imageLayerCount = 0;
+
+    if(IsReplayMode(m_State))
+    {
+      id = GetNonDispWrapper(t.image)->id;
+
+      auto it = layouts.find(id);
+      if(it != layouts.end())
+      {
+        imageLevelCount = (uint32_t)it->second.levelCount;
+        imageLayerCount = (uint32_t)it->second.layerCount;
+      }
+    }
+    else
+    {
+      // during capture read the image's immutable dimensions from its record rather than the
+      // layouts map, so threads recording barriers into separate command buffers don't all
+      // serialise on the map's lock (held whenever a queue submit updates the tracked layouts).
+      id = GetResID(t.image);
+
+      VkResourceRecord *record = GetRecord(t.image);
+      if(record)
+      {
+        imageLevelCount = record->imageMipCount;
+        imageLayerCount = record->imageLayerCount;
+      }
+    }
 
     if(id == ResourceId())
     {
@@ -205,20 +232,18 @@ void VulkanResourceManager::RecordBarriers(vector<pair<ResourceId, ImageRegionSt
     uint32_t nummips = t.subresourceRange.levelCount;
     uint32_t numslices = t.subresourceRange.layerCount;
 
-    auto it = layouts.find(id);
-
     if(nummips == VK_REMAINING_MIP_LEVELS)
     {
-      if(it != layouts.end())
-        nummips = it->second.levelCount - t.subresourceRange.baseMipLevel;
+      if(imageLevelCount > 0)
+        nummips = imageLevelCount - t.subresourceRange.baseMipLevel;
       else
         nummips = 1;
     }
 
     if(numslices == VK_REMAINING_ARRAY_LAYERS)
     {
-      if(it != layouts.end())
-        numslices = it->second.layerCount - t.subresourceRange.baseArrayLayer;
+      if(imageLayerCount > 0)
+        numslices = imageLayerCount - t.subresourceRange.baseArrayLayer;
       else
         numslices = 1;
     }
@@ -380,6 +405,10 @@ bool VulkanResourceManager::Serialise_DeviceMemoryRefs(SerialiserType &ser,
 
   if(IsReplayingAndReading())
   {
+    // we have proper per-range reference information for this capture, so initial state
+    // application can skip anything the frame doesn't write
+    m_OptimizeInitialState = true;
+
     // unpack data into m_MemFrameRefs
     auto it_data = data.begin();
     while(it_data != data.end())
@@ -388,7 +417,7 @@ bool VulkanResourceManager::Serialise_DeviceMemoryRefs(SerialiserType &ser,
 
       auto res = m_MemFrameRefs.insert(std::make_pair(mem, MemRefs()));
       RDCASSERTMSG("MemRefIntervals for each memory resource must be contigous", res.second);
-      Intervals<FrameRefType> &rangeRefs = res.first->second.rangeRefs;
+      FlatIntervals<FrameRefType> &rangeRefs = res.first->second.rangeRefs;
 
       auto it_ints = rangeRefs.begin();
       uint64_t last = 0;
@@ -419,7 +448,7 @@ void VulkanResourceManager::InsertDeviceMemoryRefs(WriteSerialiser &ser)
   for(auto it = m_MemFrameRefs.begin(); it != m_MemFrameRefs.end(); it++)
   {
     ResourceId mem = it->first;
-    Intervals<FrameRefType> &rangeRefs = it->second.rangeRefs;
+    FlatIntervals<FrameRefType> &rangeRefs = it->second.rangeRefs;
     for(auto jt = rangeRefs.begin(); jt != rangeRefs.end(); jt++)
       data.push_back({mem, jt->start(), jt->value()});
   }
@@ -432,6 +461,83 @@ void VulkanResourceManager::InsertDeviceMemoryRefs(WriteSerialiser &ser)
   }
 }
 
+template <typename SerialiserType>
+void DoSerialise(SerialiserType &ser, ImageFrameRef &el)
+{
+  SERIALISE_MEMBER(image);
+  SERIALISE_MEMBER(refType);
+}
+
+template <typename SerialiserType>
+bool VulkanResourceManager::Serialise_ImageRefs(SerialiserType &ser,
+                                                std::vector<ImageFrameRef> &data)
+{
+  SERIALISE_ELEMENT(data);
+
+  SERIALISE_CHECK_READ_ERRORS();
+
+  if(IsReplayingAndReading())
+  {
+    // unpack data into m_ImgFrameRefs
+    for(auto it = data.begin(); it != data.end(); ++it)
+      m_ImgFrameRefs[it->image] = {it->refType, NULL};
+
+    m_OptimizeInitialState = true;
+  }
+
+  return true;
+}
+
+template bool VulkanResourceManager::Serialise_ImageRefs(ReadSerialiser &ser,
+                                                         std::vector<ImageFrameRef> &data);
+template bool VulkanResourceManager::Serialise_ImageRefs(WriteSerialiser &ser,
+                                                         std::vector<ImageFrameRef> &data);
+
+void VulkanResourceManager::InsertImageRefs(WriteSerialiser &ser)
+{
+  SCOPED_LOCK(m_Lock);
+
+  FlushPendingMarks();
+
+  std::vector<ImageFrameRef> data;
+  data.reserve(m_FrameReferencedResources.size());
+
+  for(auto it = m_FrameReferencedResources.begin(); it != m_FrameReferencedResources.end(); ++it)
+  {
+    if(HasCurrentResource(it->first) &&
+       IdentifyTypeByPtr(GetCurrentResource(it->first)) == eResImage)
+      data.push_back({it->first, it->second});
+  }
+
+  // images that have initial contents but weren't referenced at all in the frame behave as
+  // eFrameRef_None - they only need initialising once
+  for(auto it = m_InitialContents.begin(); it != m_InitialContents.end(); ++it)
+  {
+    if(m_FrameReferencedResources.find(it->first) != m_FrameReferencedResources.end())
+      continue;
+
+    if(HasCurrentResource(it->first) &&
+       IdentifyTypeByPtr(GetCurrentResource(it->first)) == eResImage)
+      data.push_back({it->first, eFrameRef_None});
+  }
+
+  uint32_t sizeEstimate = (uint32_t)data.size() * sizeof(ImageFrameRef) + 32;
+
+  {
+    SCOPED_SERIALISE_CHUNK(VulkanChunk::ImageRefs, sizeEstimate);
+    Serialise_ImageRefs(ser, data);
+  }
+}
+
+ImgRefs *VulkanResourceManager::FindImgRefs(ResourceId img)
+{
+  auto it = m_ImgFrameRefs.find(img);
+  if(it != m_ImgFrameRefs.end())
+    return &it->second;
+  else
+    return NULL;
+}
+
 void VulkanResourceManager::MarkSparseMapReferenced(ResourceInfo *sparse)
 {
   if(sparse == NULL)
@@ -659,28 +765,32 @@ void VulkanResourceManager::ApplyBarriers(uint32_t queueFamilyIndex,
 
 ResourceId VulkanResourceManager::GetFirstIDForHandle(uint64_t handle)
 {
-  for(auto it = m_ResourceRecords.begin(); it != m_ResourceRecords.end(); ++it)
-  {
-    WrappedVkRes *res = it->second->Resource;
+  ResourceId ret;
+
+  m_ResourceRecords.ForEach([handle, &ret](ResourceId id, VkResourceRecord *record) {
+    if(ret != ResourceId())
+      return;
+
+    WrappedVkRes *res = record->Resource;
 
     if(!res)
-      continue;
+      return;
 
     if(IsDispatchableRes(res))
     {
       WrappedVkDispRes *disp = (WrappedVkDispRes *)res;
       if(disp->real.handle == handle)
-        return disp->id;
+        ret = disp->id;
     }
     else
     {
       WrappedVkNonDispRes *nondisp = (WrappedVkNonDispRes *)res;
       if(nondisp->real.handle == handle)
-        return nondisp->id;
+        ret = nondisp->id;
     }
-  }
+  });
 
-  return ResourceId();
+  return ret;
 }
 
 void VulkanResourceManager::MarkMemoryFrameReferenced(ResourceId mem, VkDeviceSize offset,
@@ -728,11 +838,27 @@ bool VulkanResourceManager::Prepare_InitialState(WrappedVkRes *res)
   return m_Core->Prepare_InitialState(res);
 }
 
+void VulkanResourceManager::Begin_PrepareInitialBatch()
+{
+  m_Core->Begin_PrepareInitialBatch();
+}
+
+void VulkanResourceManager::End_PrepareInitialBatch()
+{
+  m_Core->End_PrepareInitialBatch();
+}
+
 uint64_t VulkanResourceManager::GetSize_InitialState(ResourceId id, const VkInitialContents &initial)
 {
   return m_Core->GetSize_InitialState(id, initial);
 }
 
+uint64_t VulkanResourceManager::GetContentHash_InitialState(ResourceId id,
+                                                            const VkInitialContents &initial)
+{
+  return m_Core->GetContentHash_InitialState(id, initial);
+}
+
 bool VulkanResourceManager::Serialise_InitialState(WriteSerialiser &ser, ResourceId id,
                                                    VkResourceRecord *record,
                                                    const VkInitialContents *initial)
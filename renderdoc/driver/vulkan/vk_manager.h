@@ -185,6 +185,25 @@ struct MemRefInterval
 
 DECLARE_REFLECTION_STRUCT(MemRefInterval);
 
+struct ImageFrameRef
+{
+  ResourceId image;
+  FrameRefType refType;
+};
+
+DECLARE_REFLECTION_STRUCT(ImageFrameRef);
+
+// whole-image equivalent of MemRefs, used on replay to decide if an image's initial contents
+// need re-applying before each replay or only once.
+struct ImgRefs
+{
+  FrameRefType refType;
+
+  // tracks which live resource last had initial contents applied, so init-once images are only
+  // uploaded the first time around
+  WrappedVkRes *initializedLiveRes;
+};
+
 class VulkanResourceManager : public ResourceManager<VulkanResourceManagerConfiguration>
 {
 public:
@@ -276,6 +295,11 @@ public:
 
   void InsertDeviceMemoryRefs(WriteSerialiser &ser);
 
+  template <typename SerialiserType>
+  bool Serialise_ImageRefs(SerialiserType &ser, std::vector<ImageFrameRef> &data);
+
+  void InsertImageRefs(WriteSerialiser &ser);
+
   ResourceId GetID(WrappedVkRes *res)
   {
     if(res == NULL)
@@ -319,9 +343,9 @@ public:
   {
     ResourceId id = GetResID(obj);
 
-    auto origit = m_OriginalIDs.find(id);
-    if(origit != m_OriginalIDs.end())
-      EraseLiveResource(origit->second);
+    ResourceId origid;
+    if(m_OriginalIDs.Lookup(id, origid))
+      EraseLiveResource(origid);
 
     if(IsReplayMode(m_State))
       ResourceManager::RemoveWrapper(ToTypedHandle(Unwrap(obj)));
@@ -429,13 +453,17 @@ public:
   void MergeReferencedMemory(std::map<ResourceId, MemRefs> &memRefs);
   void ClearReferencedMemory();
   MemRefs *FindMemRefs(ResourceId mem);
+  ImgRefs *FindImgRefs(ResourceId img);
 
   inline bool OptimizeInitialState() { return m_OptimizeInitialState; }
 private:
   bool ResourceTypeRelease(WrappedVkRes *res);
 
   bool Prepare_InitialState(WrappedVkRes *res);
+  void Begin_PrepareInitialBatch();
+  void End_PrepareInitialBatch();
   uint64_t GetSize_InitialState(ResourceId id, const VkInitialContents &initial);
+  uint64_t GetContentHash_InitialState(ResourceId id, const VkInitialContents &initial);
   bool Serialise_InitialState(WriteSerialiser &ser, ResourceId id, VkResourceRecord *record,
                               const VkInitialContents *initial);
   void Create_InitialState(ResourceId id, WrappedVkRes *live, bool hasData);
@@ -445,5 +473,6 @@ private:
   CaptureState m_State;
   WrappedVulkan *m_Core;
   std::map<ResourceId, MemRefs> m_MemFrameRefs;
+  std::map<ResourceId, ImgRefs> m_ImgFrameRefs;
   bool m_OptimizeInitialState = false;
 };
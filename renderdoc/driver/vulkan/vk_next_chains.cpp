@@ -525,11 +525,64 @@ static void AppendModifiedChainedStruct(byte *&tempMem, VkStruct *outputStruct,
   case VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET_ACCELERATION_STRUCTURE_NV:               \
   case VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET_INLINE_UNIFORM_BLOCK_EXT:
 
+// returns true if a struct of this sType never needs any patching - it isn't stripped on replay,
+// has no handles to unwrap, and no variable-length arrays to deep copy. Generated from the same
+// list as the processing in GetNextPatchSize/UnwrapNextChain below so this fast path can never
+// disagree with the patching path. Unlike those functions we deliberately use a default case -
+// anything not explicitly marked as a plain copy falls back to the full processing, so a struct
+// missing here is conservative rather than wrong.
+static bool NextChainPassthrough(VkStructureType sType)
+{
+#undef COPY_STRUCT
+#define COPY_STRUCT(StructType, StructName) \
+  case StructType: return true;
+
+#undef COPY_STRUCT_CAPTURE_ONLY
+#define COPY_STRUCT_CAPTURE_ONLY(StructType, StructName) \
+  case StructType: return false;
+
+#undef UNWRAP_STRUCT
+#define UNWRAP_STRUCT(StructType, StructName, ...) \
+  case StructType: return false;
+
+#undef UNWRAP_STRUCT_CAPTURE_ONLY
+#define UNWRAP_STRUCT_CAPTURE_ONLY(StructType, StructName, ...) \
+  case StructType: return false;
+
+  switch(sType)
+  {
+    PROCESS_SIMPLE_STRUCTS();
+    default: break;
+  }
+
+  return false;
+}
+
+// returns true if the whole chain is passthrough structs, meaning it can be used as-is with no
+// scratch allocation - the common case for most create infos, which only chain feature/flags
+// structs with no handles in them.
+static bool NextChainPassthrough(const VkBaseInStructure *next)
+{
+  while(next)
+  {
+    if(!NextChainPassthrough(next->sType))
+      return false;
+
+    next = next->pNext;
+  }
+
+  return true;
+}
+
 size_t GetNextPatchSize(const void *pNext)
 {
   const VkBaseInStructure *next = (const VkBaseInStructure *)pNext;
   size_t memSize = 0;
 
+  // nothing to allocate if the chain will be passed through unmodified
+  if(NextChainPassthrough(next))
+    return 0;
+
   while(next)
   {
 #undef COPY_STRUCT_CAPTURE_ONLY
@@ -845,6 +898,16 @@ void UnwrapNextChain(CaptureState state, const char *structName, byte *&tempMem,
   // pushes on a new entry, but if there's only one entry in the list and it's one we want to skip,
   // this needs to start at NULL.
   nextChainTail->pNext = NULL;
+
+  // if nothing in the chain needs patching we can chain the application's structs directly rather
+  // than copying them into scratch memory. GetNextPatchSize makes the same check so it won't have
+  // allocated anything for the chain in this case.
+  if(NextChainPassthrough(nextInput))
+  {
+    nextChainTail->pNext = nextInput;
+    return;
+  }
+
   while(nextInput)
   {
     switch(nextInput->sType)
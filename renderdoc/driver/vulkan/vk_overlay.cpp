@@ -40,11 +40,13 @@
 struct VulkanQuadOverdrawCallback : public VulkanDrawcallCallback
 {
   VulkanQuadOverdrawCallback(WrappedVulkan *vk, VkDescriptorSetLayout descSetLayout,
-                             VkDescriptorSet descSet, const vector<uint32_t> &events)
+                             VkDescriptorSet descSet, const vector<uint32_t> &events,
+                             std::map<ResourceId, QuadOverdrawPipeline> &pipeCache)
       : m_pDriver(vk),
         m_DescSetLayout(descSetLayout),
         m_DescSet(descSet),
         m_Events(events),
+        m_PipelineCache(pipeCache),
         m_PrevState(vk, NULL)
   {
     m_pDriver->SetDrawcallCB(this);
@@ -65,10 +67,10 @@ struct VulkanQuadOverdrawCallback : public VulkanDrawcallCallback
     VulkanRenderState &pipestate = m_pDriver->GetRenderState();
 
     // check cache first
-    pair<uint32_t, VkPipeline> pipe = m_PipelineCache[pipestate.graphics.pipeline];
+    QuadOverdrawPipeline &pipe = m_PipelineCache[pipestate.graphics.pipeline];
 
     // if we don't get a hit, create a modified pipeline
-    if(pipe.second == VK_NULL_HANDLE)
+    if(pipe.pipe == VK_NULL_HANDLE)
     {
       VulkanCreationInfo &c = *pipestate.m_CreationInfo;
 
@@ -101,9 +103,8 @@ struct VulkanQuadOverdrawCallback : public VulkanDrawcallCallback
       };
 
       // create pipeline layout with same descriptor set layouts, plus our mesh output set
-      VkPipelineLayout pipeLayout;
-      vkr =
-          m_pDriver->vkCreatePipelineLayout(m_pDriver->GetDev(), &pipeLayoutInfo, NULL, &pipeLayout);
+      vkr = m_pDriver->vkCreatePipelineLayout(m_pDriver->GetDev(), &pipeLayoutInfo, NULL,
+                                              &pipe.pipeLayout);
       RDCASSERTEQUAL(vkr, VK_SUCCESS);
 
       SAFE_DELETE_ARRAY(descSetLayouts);
@@ -113,7 +114,7 @@ struct VulkanQuadOverdrawCallback : public VulkanDrawcallCallback
                                                             pipestate.graphics.pipeline);
 
       // repoint pipeline layout
-      pipeCreateInfo.layout = pipeLayout;
+      pipeCreateInfo.layout = pipe.pipeLayout;
 
       // disable colour writes/blends
       VkPipelineColorBlendStateCreateInfo *cb =
@@ -206,22 +207,20 @@ struct VulkanQuadOverdrawCallback : public VulkanDrawcallCallback
       }
 
       vkr = m_pDriver->vkCreateGraphicsPipelines(dev, VK_NULL_HANDLE, 1, &pipeCreateInfo, NULL,
-                                                 &pipe.second);
+                                                 &pipe.pipe);
       RDCASSERTEQUAL(vkr, VK_SUCCESS);
 
       ObjDisp(dev)->DestroyShaderModule(Unwrap(dev), Unwrap(module), NULL);
       m_pDriver->GetResourceManager()->ReleaseWrappedResource(module);
 
-      pipe.first = descSet;
-
-      m_PipelineCache[pipestate.graphics.pipeline] = pipe;
+      pipe.descSet = descSet;
     }
 
     // modify state for first draw call
-    pipestate.graphics.pipeline = GetResID(pipe.second);
-    RDCASSERT(pipestate.graphics.descSets.size() >= pipe.first);
-    pipestate.graphics.descSets.resize(pipe.first + 1);
-    pipestate.graphics.descSets[pipe.first].descSet = GetResID(m_DescSet);
+    pipestate.graphics.pipeline = GetResID(pipe.pipe);
+    RDCASSERT(pipestate.graphics.descSets.size() >= pipe.descSet);
+    pipestate.graphics.descSets.resize(pipe.descSet + 1);
+    pipestate.graphics.descSets[pipe.descSet].descSet = GetResID(m_DescSet);
 
     if(cmd)
       pipestate.BindPipeline(cmd, VulkanRenderState::BindGraphics, false);
@@ -265,8 +264,8 @@ struct VulkanQuadOverdrawCallback : public VulkanDrawcallCallback
   VkDescriptorSet m_DescSet;
   const vector<uint32_t> &m_Events;
 
-  // cache modified pipelines
-  std::map<ResourceId, pair<uint32_t, VkPipeline> > m_PipelineCache;
+  // cache of modified pipelines, owned by the replay so it persists between overlay renders
+  std::map<ResourceId, QuadOverdrawPipeline> &m_PipelineCache;
   VulkanRenderState m_PrevState;
 };
 
@@ -1796,7 +1795,7 @@ ResourceId VulkanReplay::RenderOverlay(ResourceId texid, CompType typeHint, Debu
 
       // declare callback struct here
       VulkanQuadOverdrawCallback cb(m_pDriver, m_Overlay.m_QuadDescSetLayout,
-                                    m_Overlay.m_QuadDescSet, events);
+                                    m_Overlay.m_QuadDescSet, events, m_Overlay.m_QuadPipeCache);
 
       m_pDriver->ReplayLog(events.front(), events.back(), eReplay_Full);
 
@@ -1852,10 +1851,7 @@ ResourceId VulkanReplay::RenderOverlay(ResourceId texid, CompType typeHint, Debu
       m_pDriver->vkDestroyImage(m_Device, quadImg, NULL);
       m_pDriver->vkFreeMemory(m_Device, quadImgMem, NULL);
 
-      for(auto it = cb.m_PipelineCache.begin(); it != cb.m_PipelineCache.end(); ++it)
-      {
-        m_pDriver->vkDestroyPipeline(m_Device, it->second.second, NULL);
-      }
+      // the patched pipelines stay in m_Overlay.m_QuadPipeCache for the next overlay render
     }
 
     // restore back to normal
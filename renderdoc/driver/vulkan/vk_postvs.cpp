@@ -24,6 +24,7 @@
 
 #include <float.h>
 #include "3rdparty/glslang/SPIRV/GLSL.std.450.h"
+#include "3rdparty/zstd/xxhash.h"
 #include "3rdparty/glslang/SPIRV/spirv.hpp"
 #include "driver/shaders/spirv/spirv_common.h"
 #include "driver/shaders/spirv/spirv_editor.h"
@@ -1281,6 +1282,37 @@ static void AddXFBAnnotations(const ShaderReflection &refl, const SPIRVPatchData
   }
 }
 
+// number of patched SPIR-V modules to keep around. Scrubbing typically cycles through a small
+// handful of pipelines, so this doesn't need to be large to catch the common case.
+static const size_t PostVSPatchCacheSize = 32;
+
+bool VulkanReplay::GetCachedPostVSPatch(uint64_t key, std::vector<uint32_t> &spirv, uint32_t &stride)
+{
+  for(auto it = m_PostVS.PatchCache.begin(); it != m_PostVS.PatchCache.end(); ++it)
+  {
+    if(it->key == key)
+    {
+      spirv = it->spirv;
+      stride = it->stride;
+
+      // bump this entry to the front of the LRU
+      m_PostVS.PatchCache.splice(m_PostVS.PatchCache.begin(), m_PostVS.PatchCache, it);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void VulkanReplay::AddCachedPostVSPatch(uint64_t key, const std::vector<uint32_t> &spirv,
+                                        uint32_t stride)
+{
+  m_PostVS.PatchCache.push_front({key, spirv, stride});
+
+  if(m_PostVS.PatchCache.size() > PostVSPatchCacheSize)
+    m_PostVS.PatchCache.pop_back();
+}
+
 void VulkanReplay::ClearPostVSCache()
 {
   VkDevice dev = m_Device;
@@ -1303,6 +1335,10 @@ void VulkanReplay::ClearPostVSCache()
   }
 
   m_PostVS.Data.clear();
+  m_PostVS.PatchCache.clear();
+
+  // the vertex pick cache may have been converted from one of the buffers we just destroyed
+  m_VertexPick.CacheValid = false;
 }
 
 void VulkanReplay::PatchReservedDescriptors(const VulkanStatePipeline &pipe,
@@ -1979,7 +2015,7 @@ void VulkanReplay::FetchVSOut(uint32_t eventId)
   }
 
   uint32_t bufStride = 0;
-  vector<uint32_t> modSpirv = moduleInfo.spirv.spirv;
+  vector<uint32_t> modSpirv;
 
   struct CompactedAttrBuffer
   {
@@ -2347,9 +2383,36 @@ void VulkanReplay::FetchVSOut(uint32_t eventId)
     m_pDriver->vkUpdateDescriptorSets(dev, numWrites, descWrites, 0, NULL);
   }
 
-  ConvertToMeshOutputCompute(*refl, *pipeInfo.shaders[0].patchData,
-                             pipeInfo.shaders[0].entryPoint.c_str(), attrInstDivisor, drawcall,
-                             numVerts, numViews, modSpirv, bufStride);
+  // the patched SPIR-V depends on the source module and entry point, the draw parameters that get
+  // baked in as constants, and the per-attribute instance divisors - hash them all together so we
+  // can re-use a previous patch when scrubbing between draws that share a pipeline.
+  uint64_t patchKey;
+  {
+    uint32_t drawParams[] = {
+        (uint32_t)drawcall->flags, drawcall->numInstances, drawcall->vertexOffset,
+        drawcall->instanceOffset,  (uint32_t)drawcall->baseVertex,
+        numVerts,                  numViews,
+    };
+
+    patchKey = XXH64(&pipeInfo.shaders[0].module, sizeof(ResourceId), 0);
+    patchKey = XXH64(pipeInfo.shaders[0].entryPoint.c_str(),
+                     pipeInfo.shaders[0].entryPoint.size(), patchKey);
+    patchKey = XXH64(drawParams, sizeof(drawParams), patchKey);
+    if(!attrInstDivisor.empty())
+      patchKey =
+          XXH64(attrInstDivisor.data(), attrInstDivisor.size() * sizeof(uint32_t), patchKey);
+  }
+
+  if(!GetCachedPostVSPatch(patchKey, modSpirv, bufStride))
+  {
+    modSpirv = moduleInfo.spirv.spirv;
+
+    ConvertToMeshOutputCompute(*refl, *pipeInfo.shaders[0].patchData,
+                               pipeInfo.shaders[0].entryPoint.c_str(), attrInstDivisor, drawcall,
+                               numVerts, numViews, modSpirv, bufStride);
+
+    AddCachedPostVSPatch(patchKey, modSpirv, bufStride);
+  }
 
   VkComputePipelineCreateInfo compPipeInfo = {VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO};
 
@@ -2796,13 +2859,26 @@ void VulkanReplay::FetchTessGSOut(uint32_t eventId)
   const VulkanCreationInfo::ShaderModule &moduleInfo =
       creationInfo.m_ShaderModule[pipeInfo.shaders[stageIndex].module];
 
-  std::vector<uint32_t> modSpirv = moduleInfo.spirv.spirv;
+  std::vector<uint32_t> modSpirv;
 
   uint32_t xfbStride = 0;
 
-  // adds XFB annotations in order of the output signature (with the position first)
-  AddXFBAnnotations(*lastRefl, *pipeInfo.shaders[stageIndex].patchData,
-                    pipeInfo.shaders[stageIndex].entryPoint.c_str(), modSpirv, xfbStride);
+  // the XFB patch only depends on the module and entry point. Seed the hash differently to the
+  // mesh output patch in FetchVSOut so the two can never collide for the same module.
+  uint64_t patchKey = XXH64(&pipeInfo.shaders[stageIndex].module, sizeof(ResourceId), 1);
+  patchKey = XXH64(pipeInfo.shaders[stageIndex].entryPoint.c_str(),
+                   pipeInfo.shaders[stageIndex].entryPoint.size(), patchKey);
+
+  if(!GetCachedPostVSPatch(patchKey, modSpirv, xfbStride))
+  {
+    modSpirv = moduleInfo.spirv.spirv;
+
+    // adds XFB annotations in order of the output signature (with the position first)
+    AddXFBAnnotations(*lastRefl, *pipeInfo.shaders[stageIndex].patchData,
+                      pipeInfo.shaders[stageIndex].entryPoint.c_str(), modSpirv, xfbStride);
+
+    AddCachedPostVSPatch(patchKey, modSpirv, xfbStride);
+  }
 
   // create vertex shader with modified code
   VkShaderModuleCreateInfo moduleCreateInfo = {
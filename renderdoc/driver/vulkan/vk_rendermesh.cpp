@@ -437,85 +437,201 @@ void VulkanReplay::RenderMesh(uint32_t eventId, const vector<MeshFormat> &second
   {
     size_t mapsUsed = 0;
 
-    for(size_t i = 0; i < secondaryDraws.size(); i++)
+    const bool multiDrawIndirect = m_pDriver->GetDeviceFeatures().multiDrawIndirect != VK_FALSE;
+
+    // checks whether a draw can join a batch started by 'head'. Secondary draws are usually the
+    // other instances (or previous draws) of the same drawcall, so apart from their offset into the
+    // vertex/index buffer they render identically. Any run of such draws can be submitted as a
+    // single multi-draw indirect call with the pipeline and buffers bound once, which keeps the
+    // mesh viewer interactive even with many thousands of instances - the old one-draw-at-a-time
+    // path would exhaust the UBO ring and stall on a queue flush every few draws.
+    auto canBatch = [](const MeshFormat &head, const MeshFormat &fmt) {
+      if(fmt.vertexResourceId != head.vertexResourceId ||
+         fmt.vertexByteStride != head.vertexByteStride || !(fmt.format == head.format) ||
+         fmt.topology != head.topology || fmt.instStepRate != head.instStepRate ||
+         fmt.instanced != head.instanced || fmt.indexByteStride != head.indexByteStride ||
+         !(fmt.meshColor == head.meshColor))
+        return false;
+
+      // the vertex buffer is bound at the head's offset, so any other offset must be reachable
+      // with the whole-vertex offset in the indirect arguments
+      if(fmt.vertexByteOffset != head.vertexByteOffset)
+      {
+        if(head.vertexByteStride == 0 || fmt.vertexByteOffset < head.vertexByteOffset ||
+           (fmt.vertexByteOffset - head.vertexByteOffset) % head.vertexByteStride != 0)
+          return false;
+      }
+
+      // same for the index buffer, via firstIndex
+      if(fmt.indexByteStride)
+      {
+        if(fmt.indexResourceId != head.indexResourceId)
+          return false;
+
+        if(fmt.indexByteOffset != head.indexByteOffset)
+        {
+          if(head.indexResourceId == ResourceId() ||
+             fmt.indexByteOffset < head.indexByteOffset ||
+             (fmt.indexByteOffset - head.indexByteOffset) % head.indexByteStride != 0)
+            return false;
+        }
+      }
+
+      return true;
+    };
+
+    for(size_t i = 0; i < secondaryDraws.size();)
     {
       const MeshFormat &fmt = secondaryDraws[i];
 
-      if(fmt.vertexResourceId != ResourceId())
+      if(fmt.vertexResourceId == ResourceId())
       {
-        // TODO should move the color to a push constant so we don't have to map all the time
-        uint32_t uboOffs = 0;
-        MeshUBOData *data = (MeshUBOData *)m_MeshRender.UBO.Map(&uboOffs);
+        i++;
+        continue;
+      }
 
-        data->mvp = ModelViewProj;
-        data->color = Vec4f(fmt.meshColor.x, fmt.meshColor.y, fmt.meshColor.z, fmt.meshColor.w);
-        data->homogenousInput = cfg.position.unproject;
-        data->pointSpriteSize = Vec2f(0.0f, 0.0f);
-        data->displayFormat = MESHDISPLAY_SOLID;
-        data->rawoutput = 0;
+      // gather the run of draws that can be rendered together with this one
+      size_t batchSize = 1;
+      while(multiDrawIndirect && i + batchSize < secondaryDraws.size() &&
+            batchSize < MeshRendering::MaxIndirectCommands &&
+            secondaryDraws[i + batchSize].vertexResourceId != ResourceId() &&
+            canBatch(fmt, secondaryDraws[i + batchSize]))
+        batchSize++;
 
-        m_MeshRender.UBO.Unmap();
+      // TODO should move the color to a push constant so we don't have to map all the time
+      uint32_t uboOffs = 0;
+      MeshUBOData *data = (MeshUBOData *)m_MeshRender.UBO.Map(&uboOffs);
 
-        mapsUsed++;
+      data->mvp = ModelViewProj;
+      data->color = Vec4f(fmt.meshColor.x, fmt.meshColor.y, fmt.meshColor.z, fmt.meshColor.w);
+      data->homogenousInput = cfg.position.unproject;
+      data->pointSpriteSize = Vec2f(0.0f, 0.0f);
+      data->displayFormat = MESHDISPLAY_SOLID;
+      data->rawoutput = 0;
 
-        if(mapsUsed + 1 >= m_MeshRender.UBO.GetRingCount())
+      m_MeshRender.UBO.Unmap();
+
+      uint32_t argOffs = 0;
+
+      // emit one indirect command per draw in the batch, offsetting each draw from the head's
+      // vertex/index buffer binding. Batches of one fall back to a plain direct draw below.
+      if(batchSize > 1)
+      {
+        if(fmt.indexByteStride)
         {
-          // flush and sync so we can use more maps
-          vt->CmdEndRenderPass(Unwrap(cmd));
+          VkDrawIndexedIndirectCommand *args =
+              (VkDrawIndexedIndirectCommand *)m_MeshRender.IndirectBuf.Map(
+                  &argOffs, sizeof(VkDrawIndexedIndirectCommand) * batchSize);
 
-          vkr = vt->EndCommandBuffer(Unwrap(cmd));
-          RDCASSERTEQUAL(vkr, VK_SUCCESS);
+          for(size_t b = 0; b < batchSize; b++)
+          {
+            const MeshFormat &el = secondaryDraws[i + b];
+
+            args[b].indexCount = el.numIndices;
+            args[b].instanceCount = 1;
+            args[b].firstIndex =
+                uint32_t((el.indexByteOffset - fmt.indexByteOffset) / fmt.indexByteStride);
+            args[b].vertexOffset = el.baseVertex;
+            if(fmt.vertexByteStride > 0)
+              args[b].vertexOffset +=
+                  int32_t((el.vertexByteOffset - fmt.vertexByteOffset) / fmt.vertexByteStride);
+            args[b].firstInstance = 0;
+          }
+        }
+        else
+        {
+          VkDrawIndirectCommand *args = (VkDrawIndirectCommand *)m_MeshRender.IndirectBuf.Map(
+              &argOffs, sizeof(VkDrawIndirectCommand) * batchSize);
 
-          m_pDriver->SubmitCmds();
-          m_pDriver->FlushQ();
+          for(size_t b = 0; b < batchSize; b++)
+          {
+            const MeshFormat &el = secondaryDraws[i + b];
+
+            args[b].vertexCount = el.numIndices;
+            args[b].instanceCount = 1;
+            args[b].firstVertex = 0;
+            if(fmt.vertexByteStride > 0)
+              args[b].firstVertex =
+                  uint32_t((el.vertexByteOffset - fmt.vertexByteOffset) / fmt.vertexByteStride);
+            args[b].firstInstance = 0;
+          }
+        }
 
-          mapsUsed = 0;
+        m_MeshRender.IndirectBuf.Unmap();
+      }
 
-          cmd = m_pDriver->GetNextCmd();
+      // each batch consumes at most one slot in the UBO ring and one in the (equally sized)
+      // indirect buffer ring
+      mapsUsed++;
 
-          vkr = vt->BeginCommandBuffer(Unwrap(cmd), &beginInfo);
-          RDCASSERTEQUAL(vkr, VK_SUCCESS);
-          vt->CmdBeginRenderPass(Unwrap(cmd), &rpbegin, VK_SUBPASS_CONTENTS_INLINE);
+      if(mapsUsed + 1 >= m_MeshRender.UBO.GetRingCount())
+      {
+        // flush and sync so we can use more maps
+        vt->CmdEndRenderPass(Unwrap(cmd));
 
-          vt->CmdSetViewport(Unwrap(cmd), 0, 1, &viewport);
-        }
+        vkr = vt->EndCommandBuffer(Unwrap(cmd));
+        RDCASSERTEQUAL(vkr, VK_SUCCESS);
 
-        MeshDisplayPipelines secondaryCache = GetDebugManager()->CacheMeshDisplayPipelines(
-            m_MeshRender.PipeLayout, secondaryDraws[i], secondaryDraws[i]);
+        m_pDriver->SubmitCmds();
+        m_pDriver->FlushQ();
 
-        vt->CmdBindDescriptorSets(Unwrap(cmd), VK_PIPELINE_BIND_POINT_GRAPHICS,
-                                  Unwrap(m_MeshRender.PipeLayout), 0, 1,
-                                  UnwrapPtr(m_MeshRender.DescSet), 1, &uboOffs);
+        mapsUsed = 0;
 
-        vt->CmdBindPipeline(Unwrap(cmd), VK_PIPELINE_BIND_POINT_GRAPHICS,
-                            Unwrap(secondaryCache.pipes[MeshDisplayPipelines::ePipe_WireDepth]));
+        cmd = m_pDriver->GetNextCmd();
 
-        VkBuffer vb =
-            m_pDriver->GetResourceManager()->GetCurrentHandle<VkBuffer>(fmt.vertexResourceId);
+        vkr = vt->BeginCommandBuffer(Unwrap(cmd), &beginInfo);
+        RDCASSERTEQUAL(vkr, VK_SUCCESS);
+        vt->CmdBeginRenderPass(Unwrap(cmd), &rpbegin, VK_SUBPASS_CONTENTS_INLINE);
 
-        VkDeviceSize offs = fmt.vertexByteOffset;
-        vt->CmdBindVertexBuffers(Unwrap(cmd), 0, 1, UnwrapPtr(vb), &offs);
+        vt->CmdSetViewport(Unwrap(cmd), 0, 1, &viewport);
+      }
 
-        if(fmt.indexByteStride)
+      MeshDisplayPipelines secondaryCache =
+          GetDebugManager()->CacheMeshDisplayPipelines(m_MeshRender.PipeLayout, fmt, fmt);
+
+      vt->CmdBindDescriptorSets(Unwrap(cmd), VK_PIPELINE_BIND_POINT_GRAPHICS,
+                                Unwrap(m_MeshRender.PipeLayout), 0, 1,
+                                UnwrapPtr(m_MeshRender.DescSet), 1, &uboOffs);
+
+      vt->CmdBindPipeline(Unwrap(cmd), VK_PIPELINE_BIND_POINT_GRAPHICS,
+                          Unwrap(secondaryCache.pipes[MeshDisplayPipelines::ePipe_WireDepth]));
+
+      VkBuffer vb =
+          m_pDriver->GetResourceManager()->GetCurrentHandle<VkBuffer>(fmt.vertexResourceId);
+
+      VkDeviceSize offs = fmt.vertexByteOffset;
+      vt->CmdBindVertexBuffers(Unwrap(cmd), 0, 1, UnwrapPtr(vb), &offs);
+
+      if(fmt.indexByteStride)
+      {
+        VkIndexType idxtype = VK_INDEX_TYPE_UINT16;
+        if(fmt.indexByteStride == 4)
+          idxtype = VK_INDEX_TYPE_UINT32;
+
+        if(fmt.indexResourceId != ResourceId())
         {
-          VkIndexType idxtype = VK_INDEX_TYPE_UINT16;
-          if(fmt.indexByteStride == 4)
-            idxtype = VK_INDEX_TYPE_UINT32;
+          VkBuffer ib =
+              m_pDriver->GetResourceManager()->GetLiveHandle<VkBuffer>(fmt.indexResourceId);
 
-          if(fmt.indexResourceId != ResourceId())
-          {
-            VkBuffer ib =
-                m_pDriver->GetResourceManager()->GetLiveHandle<VkBuffer>(fmt.indexResourceId);
+          vt->CmdBindIndexBuffer(Unwrap(cmd), Unwrap(ib), fmt.indexByteOffset, idxtype);
+        }
 
-            vt->CmdBindIndexBuffer(Unwrap(cmd), Unwrap(ib), fmt.indexByteOffset, idxtype);
-          }
+        if(batchSize > 1)
+          vt->CmdDrawIndexedIndirect(Unwrap(cmd), Unwrap(m_MeshRender.IndirectBuf.buf), argOffs,
+                                     (uint32_t)batchSize, sizeof(VkDrawIndexedIndirectCommand));
+        else
           vt->CmdDrawIndexed(Unwrap(cmd), fmt.numIndices, 1, 0, fmt.baseVertex, 0);
-        }
+      }
+      else
+      {
+        if(batchSize > 1)
+          vt->CmdDrawIndirect(Unwrap(cmd), Unwrap(m_MeshRender.IndirectBuf.buf), argOffs,
+                              (uint32_t)batchSize, sizeof(VkDrawIndirectCommand));
         else
-        {
           vt->CmdDraw(Unwrap(cmd), fmt.numIndices, 1, 0, 0);
-        }
       }
+
+      i += batchSize;
     }
 
     {
@@ -96,6 +96,11 @@ ReplayStatus VulkanReplay::ReadLogInitialisation(RDCFile *rdc, bool storeStructu
   return m_pDriver->ReadLogInitialisation(rdc, storeStructuredBuffers);
 }
 
+void VulkanReplay::SetLazyStructuredData(bool lazy)
+{
+  m_pDriver->SetLazyStructuredData(lazy);
+}
+
 void VulkanReplay::ReplayLog(uint32_t endEventID, ReplayLogType replayType)
 {
   m_pDriver->ReplayLog(0, endEventID, replayType);
@@ -377,6 +382,10 @@ string VulkanReplay::DisassembleShader(ResourceId pipeline, const ShaderReflecti
   {
     std::string &disasm = it->second.m_Reflections[refl->entryPoint.c_str()].disassembly;
 
+    // the parse pool drains before load completes, so this only waits if we're somehow asked to
+    // disassemble mid-load
+    it->second.EnsureParsed();
+
     if(disasm.empty())
       disasm = it->second.spirv.Disassemble(refl->entryPoint.c_str());
 
@@ -2129,6 +2138,346 @@ bool VulkanReplay::GetMinMax(ResourceId texid, uint32_t sliceFace, uint32_t mip,
   return true;
 }
 
+bool VulkanReplay::GetMinMax(ResourceId texid, const vector<MinMaxSubresource> &subs,
+                             CompType typeHint, float *minval, float *maxval)
+{
+  if(subs.empty())
+    return true;
+
+  ImageLayouts &layouts = m_pDriver->m_ImageLayouts[texid];
+
+  // depth/stencil needs two shader passes per subresource, take the unbatched path
+  if(IsDepthAndStencilFormat(layouts.format))
+  {
+    for(size_t i = 0; i < subs.size(); i++)
+    {
+      if(!GetMinMax(texid, subs[i].sliceFace, subs[i].mip, subs[i].sample, typeHint, minval + i * 4,
+                    maxval + i * 4))
+        return false;
+    }
+
+    return true;
+  }
+
+  VkDevice dev = m_pDriver->GetDev();
+  VkCommandBuffer cmd = m_pDriver->GetNextCmd();
+  const VkLayerDispatchTable *vt = ObjDisp(dev);
+
+  VulkanCreationInfo::Image &iminfo = m_pDriver->m_CreationInfo.m_Image[texid];
+  TextureDisplayViews &texviews = m_TexRender.TextureViews[texid];
+  VkImage liveIm = m_pDriver->GetResourceManager()->GetCurrentHandle<VkImage>(texid);
+
+  CreateTexImageView(liveIm, iminfo, typeHint, texviews);
+
+  VkImageView liveImView = texviews.views[0];
+
+  RDCASSERT(liveImView != VK_NULL_HANDLE);
+
+  VkDescriptorImageInfo imdesc = {0};
+  imdesc.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+  imdesc.imageView = Unwrap(liveImView);
+  imdesc.sampler = Unwrap(m_General.PointSampler);
+
+  uint32_t descSetBinding = 0;
+  uint32_t intTypeIndex = 0;
+
+  if(IsUIntFormat(texviews.castedFormat))
+  {
+    descSetBinding = 10;
+    intTypeIndex = 1;
+  }
+  else if(IsSIntFormat(texviews.castedFormat))
+  {
+    descSetBinding = 15;
+    intTypeIndex = 2;
+  }
+  else
+  {
+    descSetBinding = 5;
+  }
+
+  int textype = 0;
+
+  if(iminfo.type == VK_IMAGE_TYPE_1D)
+  {
+    textype = RESTYPE_TEX1D;
+  }
+  else if(iminfo.type == VK_IMAGE_TYPE_3D)
+  {
+    textype = RESTYPE_TEX3D;
+  }
+  else if(iminfo.type == VK_IMAGE_TYPE_2D)
+  {
+    textype = RESTYPE_TEX2D;
+    if(iminfo.samples != VK_SAMPLE_COUNT_1_BIT)
+      textype = RESTYPE_TEX2DMS;
+  }
+
+  descSetBinding += textype;
+
+  if(m_Histogram.m_MinMaxTilePipe[textype][intTypeIndex] == VK_NULL_HANDLE)
+    return false;
+
+  // the whole batch writes into one readback buffer, two float4s per subresource
+  GPUBuffer batchReadback;
+  batchReadback.Create(m_pDriver, dev, sizeof(Vec4f) * 2 * subs.size(), 1,
+                       GPUBuffer::eGPUBufferReadback);
+
+  VkDescriptorBufferInfo bufdescs[3];
+  RDCEraseEl(bufdescs);
+  m_Histogram.m_MinMaxTileResult.FillDescriptor(bufdescs[0]);
+  m_Histogram.m_MinMaxResult.FillDescriptor(bufdescs[1]);
+  m_Histogram.m_HistogramUBO.FillDescriptor(bufdescs[2]);
+
+  VkDescriptorImageInfo altimdesc[2] = {};
+  for(uint32_t i = 1; i < GetYUVPlaneCount(texviews.castedFormat); i++)
+  {
+    RDCASSERT(texviews.views[i] != VK_NULL_HANDLE);
+    altimdesc[i - 1].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    altimdesc[i - 1].imageView = Unwrap(texviews.views[i]);
+    altimdesc[i - 1].sampler = Unwrap(m_General.PointSampler);
+  }
+
+  VkWriteDescriptorSet writeSet[] = {
+
+      // first pass on tiles
+      {
+          VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, NULL, Unwrap(m_Histogram.m_HistogramDescSet[0]),
+          0, 0, 1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, NULL, &bufdescs[0],
+          NULL    // destination = tile result
+      },
+      {
+          VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, NULL, Unwrap(m_Histogram.m_HistogramDescSet[0]),
+          1, 0, 1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, NULL, &bufdescs[0],
+          NULL    // source = unused, bind tile result
+      },
+      {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, NULL, Unwrap(m_Histogram.m_HistogramDescSet[0]), 2,
+       0, 1, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, NULL, &bufdescs[2], NULL},
+
+      // sampled view
+      {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, NULL, Unwrap(m_Histogram.m_HistogramDescSet[0]),
+       descSetBinding, 0, 1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, &imdesc, NULL, NULL},
+      // YUV secondary planes (if needed)
+      {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, NULL, Unwrap(m_Histogram.m_HistogramDescSet[0]), 10,
+       0, GetYUVPlaneCount(texviews.castedFormat) - 1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+       altimdesc, NULL, NULL},
+
+      // second pass from tiles to result
+      {
+          VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, NULL, Unwrap(m_Histogram.m_HistogramDescSet[1]),
+          0, 0, 1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, NULL, &bufdescs[1],
+          NULL    // destination = result
+      },
+      {
+          VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, NULL, Unwrap(m_Histogram.m_HistogramDescSet[1]),
+          1, 0, 1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, NULL, &bufdescs[0],
+          NULL    // source = tile result
+      },
+      {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, NULL, Unwrap(m_Histogram.m_HistogramDescSet[1]), 2,
+       0, 1, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, NULL, &bufdescs[2], NULL},
+  };
+
+  vector<VkWriteDescriptorSet> writeSets;
+  for(size_t i = 0; i < ARRAY_COUNT(writeSet); i++)
+  {
+    if(writeSet[i].descriptorCount > 0)
+      writeSets.push_back(writeSet[i]);
+  }
+
+  for(size_t i = 0; i < ARRAY_COUNT(m_TexRender.DummyWrites); i++)
+  {
+    VkWriteDescriptorSet &write = m_TexRender.DummyWrites[i];
+
+    // don't write dummy data in the actual slot
+    if(write.dstBinding == descSetBinding)
+      continue;
+
+    // don't overwrite YUV texture slots if it's a YUV planar format
+    if(write.dstBinding == 10)
+    {
+      if(write.dstArrayElement == 0 && GetYUVPlaneCount(texviews.castedFormat) >= 2)
+        continue;
+      if(write.dstArrayElement == 1 && GetYUVPlaneCount(texviews.castedFormat) >= 3)
+        continue;
+    }
+
+    write.dstSet = Unwrap(m_Histogram.m_HistogramDescSet[0]);
+    writeSets.push_back(write);
+  }
+
+  vt->UpdateDescriptorSets(Unwrap(dev), (uint32_t)writeSets.size(), &writeSets[0], 0, NULL);
+
+  // the per-subresource parameters live in the UBO, which we rewrite with CmdUpdateBuffer between
+  // dispatches. That way the whole batch shares one descriptor set and one command buffer, and the
+  // only GPU sync is the single one at the end.
+  HistogramUBOData ubo;
+  RDCEraseEl(ubo);
+
+  ubo.HistogramNumSamples = iminfo.samples;
+  ubo.HistogramMin = 0.0f;
+  ubo.HistogramMax = 1.0f;
+  ubo.HistogramChannels = 0xf;
+
+  Vec4u YUVDownsampleRate = {};
+  Vec4u YUVAChannels = {};
+
+  GetYUVShaderParameters(texviews.castedFormat, YUVDownsampleRate, YUVAChannels);
+
+  ubo.HistogramYUVDownsampleRate = YUVDownsampleRate;
+  ubo.HistogramYUVAChannels = YUVAChannels;
+
+  VkImageMemoryBarrier srcimBarrier = {
+      VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+      NULL,
+      0,
+      0,
+      VK_IMAGE_LAYOUT_UNDEFINED,
+      VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+      VK_QUEUE_FAMILY_IGNORED,
+      VK_QUEUE_FAMILY_IGNORED,
+      Unwrap(liveIm),
+      {0, 0, 1, 0, 1}    // will be overwritten by subresourceRange below
+  };
+
+  // ensure all previous writes have completed
+  srcimBarrier.srcAccessMask = VK_ACCESS_ALL_WRITE_BITS;
+  // before we go reading
+  srcimBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+  VkCommandBufferBeginInfo beginInfo = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO, NULL,
+                                        VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT};
+
+  vt->BeginCommandBuffer(Unwrap(cmd), &beginInfo);
+
+  for(size_t si = 0; si < layouts.subresourceStates.size(); si++)
+  {
+    srcimBarrier.subresourceRange = layouts.subresourceStates[si].subresourceRange;
+    srcimBarrier.oldLayout = layouts.subresourceStates[si].newLayout;
+    DoPipelineBarrier(cmd, 1, &srcimBarrier);
+  }
+
+  srcimBarrier.oldLayout = srcimBarrier.newLayout;
+
+  srcimBarrier.srcAccessMask = 0;
+  srcimBarrier.dstAccessMask = 0;
+
+  int blocksX = (int)ceil(iminfo.extent.width / float(HGRAM_PIXELS_PER_TILE * HGRAM_TILES_PER_BLOCK));
+  int blocksY =
+      (int)ceil(iminfo.extent.height / float(HGRAM_PIXELS_PER_TILE * HGRAM_TILES_PER_BLOCK));
+
+  VkBufferMemoryBarrier bufbarrier = {
+      VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+      NULL,
+      0,
+      0,
+      VK_QUEUE_FAMILY_IGNORED,
+      VK_QUEUE_FAMILY_IGNORED,
+      VK_NULL_HANDLE,
+      0,
+      VK_WHOLE_SIZE,
+  };
+
+  for(size_t i = 0; i < subs.size(); i++)
+  {
+    uint32_t mip = subs[i].mip;
+
+    ubo.HistogramTextureResolution.x = (float)RDCMAX(uint32_t(iminfo.extent.width) >> mip, 1U);
+    ubo.HistogramTextureResolution.y = (float)RDCMAX(uint32_t(iminfo.extent.height) >> mip, 1U);
+    ubo.HistogramTextureResolution.z = (float)RDCMAX(uint32_t(iminfo.extent.depth) >> mip, 1U);
+    if(iminfo.type != VK_IMAGE_TYPE_3D)
+      ubo.HistogramSlice = (float)subs[i].sliceFace + 0.001f;
+    else
+      ubo.HistogramSlice = (float)(subs[i].sliceFace >> mip);
+    ubo.HistogramMip = (int)mip;
+    ubo.HistogramSample = (int)RDCCLAMP(subs[i].sample, 0U, uint32_t(iminfo.samples) - 1);
+    if(subs[i].sample == ~0U)
+      ubo.HistogramSample = -iminfo.samples;
+
+    // the previous iteration's dispatches read the UBO, wait before overwriting it. Since the
+    // barriers are ALL_COMMANDS this also covers the copy below reading the result buffer before
+    // the next iteration's dispatch writes it.
+    bufbarrier.srcAccessMask = VK_ACCESS_UNIFORM_READ_BIT;
+    bufbarrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    bufbarrier.buffer = Unwrap(m_Histogram.m_HistogramUBO.buf);
+    DoPipelineBarrier(cmd, 1, &bufbarrier);
+
+    vt->CmdUpdateBuffer(Unwrap(cmd), Unwrap(m_Histogram.m_HistogramUBO.buf), 0, sizeof(ubo), &ubo);
+
+    bufbarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    bufbarrier.dstAccessMask = VK_ACCESS_UNIFORM_READ_BIT;
+    DoPipelineBarrier(cmd, 1, &bufbarrier);
+
+    vt->CmdBindPipeline(Unwrap(cmd), VK_PIPELINE_BIND_POINT_COMPUTE,
+                        Unwrap(m_Histogram.m_MinMaxTilePipe[textype][intTypeIndex]));
+    vt->CmdBindDescriptorSets(Unwrap(cmd), VK_PIPELINE_BIND_POINT_COMPUTE,
+                              Unwrap(m_Histogram.m_HistogramPipeLayout), 0, 1,
+                              UnwrapPtr(m_Histogram.m_HistogramDescSet[0]), 0, NULL);
+
+    vt->CmdDispatch(Unwrap(cmd), blocksX, blocksY, 1);
+
+    // ensure shader writes complete before coalescing the tiles
+    bufbarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    bufbarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    bufbarrier.buffer = Unwrap(m_Histogram.m_MinMaxTileResult.buf);
+    DoPipelineBarrier(cmd, 1, &bufbarrier);
+
+    vt->CmdBindPipeline(Unwrap(cmd), VK_PIPELINE_BIND_POINT_COMPUTE,
+                        Unwrap(m_Histogram.m_MinMaxResultPipe[intTypeIndex]));
+    vt->CmdBindDescriptorSets(Unwrap(cmd), VK_PIPELINE_BIND_POINT_COMPUTE,
+                              Unwrap(m_Histogram.m_HistogramPipeLayout), 0, 1,
+                              UnwrapPtr(m_Histogram.m_HistogramDescSet[1]), 0, NULL);
+
+    vt->CmdDispatch(Unwrap(cmd), 1, 1, 1);
+
+    // ensure shader writes complete before copying into the batch readback buffer
+    bufbarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    bufbarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    bufbarrier.buffer = Unwrap(m_Histogram.m_MinMaxResult.buf);
+    DoPipelineBarrier(cmd, 1, &bufbarrier);
+
+    VkBufferCopy bufcopy = {
+        0, sizeof(Vec4f) * 2 * i, m_Histogram.m_MinMaxResult.totalsize,
+    };
+
+    vt->CmdCopyBuffer(Unwrap(cmd), Unwrap(m_Histogram.m_MinMaxResult.buf),
+                      Unwrap(batchReadback.buf), 1, &bufcopy);
+  }
+
+  // image layout back to normal
+  for(size_t si = 0; si < layouts.subresourceStates.size(); si++)
+  {
+    srcimBarrier.subresourceRange = layouts.subresourceStates[si].subresourceRange;
+    srcimBarrier.newLayout = layouts.subresourceStates[si].newLayout;
+    srcimBarrier.dstAccessMask = MakeAccessMask(srcimBarrier.newLayout);
+    DoPipelineBarrier(cmd, 1, &srcimBarrier);
+  }
+
+  // wait for the copies to complete before mapping
+  bufbarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+  bufbarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+  bufbarrier.buffer = Unwrap(batchReadback.buf);
+  DoPipelineBarrier(cmd, 1, &bufbarrier);
+
+  vt->EndCommandBuffer(Unwrap(cmd));
+
+  // submit cmds and wait for idle so we can readback - one sync for the whole batch
+  m_pDriver->SubmitCmds();
+  m_pDriver->FlushQ();
+
+  Vec4f *minmax = (Vec4f *)batchReadback.Map(NULL);
+
+  for(size_t i = 0; i < subs.size(); i++)
+  {
+    memcpy(minval + i * 4, &minmax[i * 2 + 0].x, sizeof(Vec4f));
+    memcpy(maxval + i * 4, &minmax[i * 2 + 1].x, sizeof(Vec4f));
+  }
+
+  batchReadback.Unmap();
+  batchReadback.Destroy();
+
+  return true;
+}
+
 bool VulkanReplay::GetHistogram(ResourceId texid, uint32_t sliceFace, uint32_t mip, uint32_t sample,
                                 CompType typeHint, float minval, float maxval, bool channels[4],
                                 vector<uint32_t> &histogram)
@@ -3194,33 +3543,12 @@ void VulkanReplay::GetTextureData(ResourceId tex, uint32_t arrayIdx, uint32_t mi
                             VK_FORMAT_S8_UINT, mip);
   }
 
-  VkBufferCreateInfo bufInfo = {
-      VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
-      NULL,
-      0,
-      dataSize,
-      VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
-  };
-
-  VkBuffer readbackBuf = VK_NULL_HANDLE;
-  vkr = vt->CreateBuffer(Unwrap(dev), &bufInfo, NULL, &readbackBuf);
-  RDCASSERTEQUAL(vkr, VK_SUCCESS);
+  // copy into the shared persistent staging window rather than allocating (and freeing) a
+  // dedicated buffer and memory per fetch - scrubbing across events does this constantly
+  GPUBuffer &readbackWin = GetDebugManager()->GetReadbackWindow(dataSize);
 
-  VkMemoryRequirements mrq = {0};
-
-  vt->GetBufferMemoryRequirements(Unwrap(dev), readbackBuf, &mrq);
-
-  VkMemoryAllocateInfo allocInfo = {
-      VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO, NULL, dataSize,
-      m_pDriver->GetReadbackMemoryIndex(mrq.memoryTypeBits),
-  };
-
-  VkDeviceMemory readbackMem = VK_NULL_HANDLE;
-  vkr = vt->AllocateMemory(Unwrap(dev), &allocInfo, NULL, &readbackMem);
-  RDCASSERTEQUAL(vkr, VK_SUCCESS);
-
-  vkr = vt->BindBufferMemory(Unwrap(dev), readbackBuf, readbackMem, 0);
-  RDCASSERTEQUAL(vkr, VK_SUCCESS);
+  VkBuffer readbackBuf = Unwrap(readbackWin.buf);
+  VkDeviceMemory readbackMem = Unwrap(readbackWin.mem);
 
   if(isDepth && isStencil)
   {
@@ -3411,9 +3739,7 @@ void VulkanReplay::GetTextureData(ResourceId tex, uint32_t arrayIdx, uint32_t mi
 
   vt->UnmapMemory(Unwrap(dev), readbackMem);
 
-  // clean up temporary objects
-  vt->DestroyBuffer(Unwrap(dev), readbackBuf, NULL);
-  vt->FreeMemory(Unwrap(dev), readbackMem, NULL);
+  // clean up temporary objects - the staging window persists for the next readback
 
   if(tmpImage != VK_NULL_HANDLE)
   {
@@ -3615,6 +3941,35 @@ void VulkanReplay::FreeTargetResource(ResourceId id)
   m_pDriver->ReleaseResource(GetResourceManager()->GetCurrentResource(id));
 }
 
+const std::vector<ResourceId> &VulkanReplay::GetPipelinesForShader(ResourceId module)
+{
+  if(m_ModulePipelines.empty())
+  {
+    for(auto it = m_pDriver->m_CreationInfo.m_Pipeline.begin();
+        it != m_pDriver->m_CreationInfo.m_Pipeline.end(); ++it)
+    {
+      for(size_t i = 0; i < ARRAY_COUNT(it->second.shaders); i++)
+      {
+        ResourceId mod = it->second.shaders[i].module;
+
+        if(mod == ResourceId())
+          continue;
+
+        // a module can be referenced by multiple stages of the same pipeline with different entry
+        // points, but the pipeline only needs rebuilding once
+        bool dupe = false;
+        for(size_t j = 0; j < i; j++)
+          dupe |= it->second.shaders[j].module == mod;
+
+        if(!dupe)
+          m_ModulePipelines[mod].push_back(it->first);
+      }
+    }
+  }
+
+  return m_ModulePipelines[module];
+}
+
 void VulkanReplay::ReplaceResource(ResourceId from, ResourceId to)
 {
   VkDevice dev = m_pDriver->GetDev();
@@ -3627,70 +3982,65 @@ void VulkanReplay::ReplaceResource(ResourceId from, ResourceId to)
   VkShaderModule srcShaderModule = rm->GetCurrentHandle<VkShaderModule>(liveid);
   VkShaderModule dstShaderModule = rm->GetCurrentHandle<VkShaderModule>(to);
 
-  // remake and replace any pipelines that referenced this shader
-  for(auto it = m_pDriver->m_CreationInfo.m_Pipeline.begin();
-      it != m_pDriver->m_CreationInfo.m_Pipeline.end(); ++it)
+  // cached quad overdraw pipelines were patched from the original shaders, throw them away
+  m_Overlay.ResetQuadPipeCache(m_pDriver);
+
+  // remake and replace exactly the pipelines that referenced this shader, leaving every other
+  // cached pipeline untouched
+  const std::vector<ResourceId> &pipelines = GetPipelinesForShader(liveid);
+
+  for(ResourceId pipeid : pipelines)
   {
-    bool refdShader = false;
-    for(size_t i = 0; i < ARRAY_COUNT(it->second.shaders); i++)
+    VkPipeline pipe = VK_NULL_HANDLE;
+    const VulkanCreationInfo::Pipeline &pipeInfo = m_pDriver->m_CreationInfo.m_Pipeline[pipeid];
+    if(pipeInfo.renderpass != ResourceId())    // check if this is a graphics or compute pipeline
     {
-      if(it->second.shaders[i].module == liveid)
-      {
-        refdShader = true;
-        break;
-      }
-    }
+      VkGraphicsPipelineCreateInfo pipeCreateInfo;
+      m_pDriver->GetShaderCache()->MakeGraphicsPipelineInfo(pipeCreateInfo, pipeid);
 
-    if(refdShader)
-    {
-      VkPipeline pipe = VK_NULL_HANDLE;
-      const VulkanCreationInfo::Pipeline &pipeInfo = m_pDriver->m_CreationInfo.m_Pipeline[it->first];
-      if(pipeInfo.renderpass != ResourceId())    // check if this is a graphics or compute pipeline
+      // replace the relevant module
+      for(uint32_t i = 0; i < pipeCreateInfo.stageCount; i++)
       {
-        VkGraphicsPipelineCreateInfo pipeCreateInfo;
-        m_pDriver->GetShaderCache()->MakeGraphicsPipelineInfo(pipeCreateInfo, it->first);
+        VkPipelineShaderStageCreateInfo &sh =
+            (VkPipelineShaderStageCreateInfo &)pipeCreateInfo.pStages[i];
 
-        // replace the relevant module
-        for(uint32_t i = 0; i < pipeCreateInfo.stageCount; i++)
-        {
-          VkPipelineShaderStageCreateInfo &sh =
-              (VkPipelineShaderStageCreateInfo &)pipeCreateInfo.pStages[i];
+        if(sh.module == srcShaderModule)
+          sh.module = dstShaderModule;
+      }
 
-          if(sh.module == srcShaderModule)
-            sh.module = dstShaderModule;
-        }
+      // create the new graphics pipeline
+      VkResult vkr = m_pDriver->vkCreateGraphicsPipelines(dev, VK_NULL_HANDLE, 1, &pipeCreateInfo,
+                                                          NULL, &pipe);
+      RDCASSERTEQUAL(vkr, VK_SUCCESS);
+    }
+    else
+    {
+      VkComputePipelineCreateInfo pipeCreateInfo;
+      m_pDriver->GetShaderCache()->MakeComputePipelineInfo(pipeCreateInfo, pipeid);
 
-        // create the new graphics pipeline
-        VkResult vkr = m_pDriver->vkCreateGraphicsPipelines(dev, VK_NULL_HANDLE, 1, &pipeCreateInfo,
-                                                            NULL, &pipe);
-        RDCASSERTEQUAL(vkr, VK_SUCCESS);
-      }
-      else
-      {
-        VkComputePipelineCreateInfo pipeCreateInfo;
-        m_pDriver->GetShaderCache()->MakeComputePipelineInfo(pipeCreateInfo, it->first);
-
-        // replace the relevant module
-        VkPipelineShaderStageCreateInfo &sh = pipeCreateInfo.stage;
-        RDCASSERT(sh.module == srcShaderModule);
-        sh.module = dstShaderModule;
-
-        // create the new compute pipeline
-        VkResult vkr = m_pDriver->vkCreateComputePipelines(dev, VK_NULL_HANDLE, 1, &pipeCreateInfo,
-                                                           NULL, &pipe);
-        RDCASSERTEQUAL(vkr, VK_SUCCESS);
-      }
+      // replace the relevant module
+      VkPipelineShaderStageCreateInfo &sh = pipeCreateInfo.stage;
+      RDCASSERT(sh.module == srcShaderModule);
+      sh.module = dstShaderModule;
 
-      // remove the replacements
-      rm->ReplaceResource(it->first, GetResID(pipe));
-      rm->ReplaceResource(rm->GetOriginalID(it->first), GetResID(pipe));
+      // create the new compute pipeline
+      VkResult vkr = m_pDriver->vkCreateComputePipelines(dev, VK_NULL_HANDLE, 1, &pipeCreateInfo,
+                                                         NULL, &pipe);
+      RDCASSERTEQUAL(vkr, VK_SUCCESS);
     }
+
+    // remove the replacements
+    rm->ReplaceResource(pipeid, GetResID(pipe));
+    rm->ReplaceResource(rm->GetOriginalID(pipeid), GetResID(pipe));
   }
 
   // make the actual shader module replacements
   rm->ReplaceResource(from, to);
   rm->ReplaceResource(liveid, to);
 
+  // cached baked command buffers bind the old pipelines, so throw them away
+  m_pDriver->InvalidateBakedCommandBufferCache();
+
   ClearPostVSCache();
   ClearFeedbackCache();
 }
@@ -3711,44 +4061,320 @@ void VulkanReplay::RemoveReplacement(ResourceId id)
   rm->RemoveReplacement(id);
   rm->RemoveReplacement(liveid);
 
-  // remove any replacements on pipelines that referenced this shader
-  for(auto it = m_pDriver->m_CreationInfo.m_Pipeline.begin();
-      it != m_pDriver->m_CreationInfo.m_Pipeline.end(); ++it)
+  // cached quad overdraw pipelines were patched from the replaced shaders, throw them away
+  m_Overlay.ResetQuadPipeCache(m_pDriver);
+
+  // remove any replacements on the pipelines that referenced this shader
+  const std::vector<ResourceId> &pipelines = GetPipelinesForShader(liveid);
+
+  for(ResourceId pipeid : pipelines)
+  {
+    VkPipeline pipe = rm->GetCurrentHandle<VkPipeline>(pipeid);
+
+    // delete the replacement pipeline
+    m_pDriver->vkDestroyPipeline(dev, pipe, NULL);
+
+    // remove both live and original replacements, since we will have made these above
+    rm->RemoveReplacement(pipeid);
+    rm->RemoveReplacement(rm->GetOriginalID(pipeid));
+  }
+
+  // cached baked command buffers bind the replacement pipelines we just destroyed
+  m_pDriver->InvalidateBakedCommandBufferCache();
+
+  ClearPostVSCache();
+  ClearFeedbackCache();
+}
+
+struct VulkanPixelHistoryCallback : public VulkanDrawcallCallback
+{
+  VulkanPixelHistoryCallback(WrappedVulkan *vk, uint32_t x, uint32_t y, VkQueryPool occlusionPool,
+                             const std::map<uint32_t, uint32_t> &eventQueries)
+      : m_pDriver(vk),
+        m_X(x),
+        m_Y(y),
+        m_OcclusionPool(occlusionPool),
+        m_EventQueries(eventQueries),
+        m_PrevState(vk, NULL)
   {
-    bool refdShader = false;
-    for(size_t i = 0; i < ARRAY_COUNT(it->second.shaders); i++)
+    m_pDriver->SetDrawcallCB(this);
+  }
+  ~VulkanPixelHistoryCallback()
+  {
+    m_pDriver->SetDrawcallCB(NULL);
+
+    VkDevice dev = m_pDriver->GetDev();
+    for(auto it = m_PipelineCache.begin(); it != m_PipelineCache.end(); ++it)
+      m_pDriver->vkDestroyPipeline(dev, it->second, NULL);
+  }
+  void PreDraw(uint32_t eid, VkCommandBuffer cmd)
+  {
+    auto it = m_EventQueries.find(eid);
+    if(it == m_EventQueries.end())
+      return;
+
+    // we run the draw an extra time before the real one, restricted to just our target pixel and
+    // with all framebuffer writes disabled, inside an occlusion query. The query then counts the
+    // samples of this draw that passed every test at the pixel, without disturbing the
+    // framebuffer/depth contents the real draw sees afterwards.
+
+    m_PrevState = m_pDriver->GetRenderState();
+    VulkanRenderState &pipestate = m_pDriver->GetRenderState();
+
+    // check cache first
+    VkPipeline pipe = m_PipelineCache[pipestate.graphics.pipeline];
+
+    // if we don't get a hit, create a modified pipeline
+    if(pipe == VK_NULL_HANDLE)
     {
-      if(it->second.shaders[i].module == liveid)
+      VkGraphicsPipelineCreateInfo pipeCreateInfo;
+      m_pDriver->GetShaderCache()->MakeGraphicsPipelineInfo(pipeCreateInfo,
+                                                            pipestate.graphics.pipeline);
+
+      // disable colour writes/blends
+      VkPipelineColorBlendStateCreateInfo *cb =
+          (VkPipelineColorBlendStateCreateInfo *)pipeCreateInfo.pColorBlendState;
+      for(uint32_t i = 0; i < cb->attachmentCount; i++)
       {
-        refdShader = true;
-        break;
+        VkPipelineColorBlendAttachmentState *att =
+            (VkPipelineColorBlendAttachmentState *)&cb->pAttachments[i];
+        att->blendEnable = false;
+        att->colorWriteMask = 0x0;
       }
-    }
 
-    if(refdShader)
-    {
-      VkPipeline pipe = rm->GetCurrentHandle<VkPipeline>(it->first);
+      // disable depth/stencil writes but keep any tests enabled
+      VkPipelineDepthStencilStateCreateInfo *ds =
+          (VkPipelineDepthStencilStateCreateInfo *)pipeCreateInfo.pDepthStencilState;
+      ds->depthWriteEnable = false;
+      ds->front.passOp = ds->front.failOp = ds->front.depthFailOp = VK_STENCIL_OP_KEEP;
+      ds->back.passOp = ds->back.failOp = ds->back.depthFailOp = VK_STENCIL_OP_KEEP;
 
-      // delete the replacement pipeline
-      m_pDriver->vkDestroyPipeline(dev, pipe, NULL);
+      // force scissor to be dynamic so we can restrict rasterisation to the target pixel. The
+      // dynamic state array in the create info is a static array sized for every dynamic state,
+      // so appending in-place is safe.
+      VkPipelineDynamicStateCreateInfo *dyn =
+          (VkPipelineDynamicStateCreateInfo *)pipeCreateInfo.pDynamicState;
+
+      bool hasScissor = false;
+      for(uint32_t i = 0; i < dyn->dynamicStateCount; i++)
+        hasScissor |= (dyn->pDynamicStates[i] == VK_DYNAMIC_STATE_SCISSOR);
+
+      if(!hasScissor)
+      {
+        VkDynamicState *dynSts = (VkDynamicState *)dyn->pDynamicStates;
+        dynSts[dyn->dynamicStateCount++] = VK_DYNAMIC_STATE_SCISSOR;
+      }
+
+      VkResult vkr = m_pDriver->vkCreateGraphicsPipelines(m_pDriver->GetDev(), VK_NULL_HANDLE, 1,
+                                                          &pipeCreateInfo, NULL, &pipe);
+      RDCASSERTEQUAL(vkr, VK_SUCCESS);
 
-      // remove both live and original replacements, since we will have made these above
-      rm->RemoveReplacement(it->first);
-      rm->RemoveReplacement(rm->GetOriginalID(it->first));
+      m_PipelineCache[pipestate.graphics.pipeline] = pipe;
     }
+
+    // the variant pipeline always has dynamic scissor, so we need a scissor per viewport even if
+    // the original pipeline had them baked in.
+    const VulkanCreationInfo::Pipeline &pipeInfo =
+        pipestate.m_CreationInfo->m_Pipeline[pipestate.graphics.pipeline];
+
+    size_t numScissors = RDCMAX(pipestate.scissors.size(), pipeInfo.scissors.size());
+    numScissors = RDCMAX(numScissors, (size_t)1);
+
+    VkRect2D rect = {{(int32_t)m_X, (int32_t)m_Y}, {1, 1}};
+
+    pipestate.graphics.pipeline = GetResID(pipe);
+    pipestate.scissors.resize(numScissors);
+    for(size_t i = 0; i < numScissors; i++)
+      pipestate.scissors[i] = rect;
+
+    if(cmd)
+      pipestate.BindPipeline(cmd, VulkanRenderState::BindGraphics, false);
+
+    ObjDisp(cmd)->CmdBeginQuery(Unwrap(cmd), m_OcclusionPool, it->second, 0);
   }
 
-  ClearPostVSCache();
-  ClearFeedbackCache();
-}
+  bool PostDraw(uint32_t eid, VkCommandBuffer cmd)
+  {
+    auto it = m_EventQueries.find(eid);
+    if(it == m_EventQueries.end())
+      return false;
+
+    ObjDisp(cmd)->CmdEndQuery(Unwrap(cmd), m_OcclusionPool, it->second);
+
+    // restore the render state and go ahead with the real draw
+    m_pDriver->GetRenderState() = m_PrevState;
+
+    RDCASSERT(cmd);
+    m_pDriver->GetRenderState().BindPipeline(cmd, VulkanRenderState::BindGraphics, false);
+
+    return true;
+  }
+
+  void PostRedraw(uint32_t eid, VkCommandBuffer cmd)
+  {
+    // nothing to do
+  }
+
+  // Dispatches/copies/clears don't rasterize, they are handled from the event usage alone
+  void PreDispatch(uint32_t eid, VkCommandBuffer cmd) {}
+  bool PostDispatch(uint32_t eid, VkCommandBuffer cmd) { return false; }
+  void PostRedispatch(uint32_t eid, VkCommandBuffer cmd) {}
+  void PreMisc(uint32_t eid, DrawFlags flags, VkCommandBuffer cmd) {}
+  bool PostMisc(uint32_t eid, DrawFlags flags, VkCommandBuffer cmd) { return false; }
+  void PostRemisc(uint32_t eid, DrawFlags flags, VkCommandBuffer cmd) {}
+  void PreEndCommandBuffer(VkCommandBuffer cmd) {}
+  void AliasEvent(uint32_t primary, uint32_t alias)
+  {
+    // don't care
+  }
+
+  WrappedVulkan *m_pDriver;
+  uint32_t m_X, m_Y;
+  VkQueryPool m_OcclusionPool;
+  const std::map<uint32_t, uint32_t> &m_EventQueries;
+
+  // cache modified pipelines, keyed by the original pipeline
+  std::map<ResourceId, VkPipeline> m_PipelineCache;
+  VulkanRenderState m_PrevState;
+};
 
 vector<PixelModification> VulkanReplay::PixelHistory(vector<EventUsage> events, ResourceId target,
                                                      uint32_t x, uint32_t y, uint32_t slice,
                                                      uint32_t mip, uint32_t sampleIdx,
                                                      CompType typeHint)
 {
-  VULKANNOTIMP("PixelHistory");
-  return vector<PixelModification>();
+  vector<PixelModification> history;
+
+  if(events.empty())
+    return history;
+
+  // establish which events rasterize and need an occlusion query, and which modify the pixel
+  // directly (clears, copies, resolves, shader writes) and can be reported from the usage alone.
+  // all the queries for the frame go in one pool, replayed in a single pass and read back in one
+  // go at the end, rather than replaying per event.
+  std::map<uint32_t, uint32_t> eventQueries;
+  std::map<uint32_t, bool> directWrites;
+
+  for(size_t ev = 0; ev < events.size(); ev++)
+  {
+    // read-only usages can't modify the pixel
+    if(events[ev].usage == ResourceUsage::CopySrc || events[ev].usage == ResourceUsage::ResolveSrc ||
+       events[ev].usage == ResourceUsage::Barrier || events[ev].usage == ResourceUsage::Indirect)
+      continue;
+
+    bool directWrite =
+        ((events[ev].usage >= ResourceUsage::VS_RWResource &&
+          events[ev].usage <= ResourceUsage::CS_RWResource) ||
+         events[ev].usage == ResourceUsage::CopyDst || events[ev].usage == ResourceUsage::Copy ||
+         events[ev].usage == ResourceUsage::Resolve ||
+         events[ev].usage == ResourceUsage::ResolveDst ||
+         events[ev].usage == ResourceUsage::GenMips || events[ev].usage == ResourceUsage::Clear);
+
+    const DrawcallDescription *draw = m_pDriver->GetDrawcall(events[ev].eventId);
+
+    if(!directWrite && (!draw || !(draw->flags & DrawFlags::Drawcall)))
+      continue;
+
+    if(directWrite)
+    {
+      directWrites[events[ev].eventId] = true;
+    }
+    else
+    {
+      uint32_t queryIndex = (uint32_t)eventQueries.size();
+      eventQueries[events[ev].eventId] = queryIndex;
+    }
+  }
+
+  if(eventQueries.empty() && directWrites.empty())
+    return history;
+
+  VkDevice dev = m_pDriver->GetDev();
+  VkResult vkr = VK_SUCCESS;
+
+  VkQueryPool occlusionPool = VK_NULL_HANDLE;
+
+  if(!eventQueries.empty())
+  {
+    VkQueryPoolCreateInfo poolInfo = {
+        VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO, NULL, 0,
+        VK_QUERY_TYPE_OCCLUSION,                  (uint32_t)eventQueries.size(), 0,
+    };
+
+    vkr = ObjDisp(dev)->CreateQueryPool(Unwrap(dev), &poolInfo, NULL, &occlusionPool);
+    RDCASSERTEQUAL(vkr, VK_SUCCESS);
+
+    VkCommandBuffer cmd = m_pDriver->GetNextCmd();
+
+    VkCommandBufferBeginInfo beginInfo = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO, NULL,
+                                          VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT};
+
+    vkr = ObjDisp(cmd)->BeginCommandBuffer(Unwrap(cmd), &beginInfo);
+    RDCASSERTEQUAL(vkr, VK_SUCCESS);
+
+    ObjDisp(cmd)->CmdResetQueryPool(Unwrap(cmd), occlusionPool, 0, (uint32_t)eventQueries.size());
+
+    vkr = ObjDisp(cmd)->EndCommandBuffer(Unwrap(cmd));
+    RDCASSERTEQUAL(vkr, VK_SUCCESS);
+
+    m_pDriver->SubmitCmds();
+    m_pDriver->FlushQ();
+
+    // replay the frame once with the callback wrapping each candidate draw in its query
+    {
+      VulkanPixelHistoryCallback cb(m_pDriver, x, y, occlusionPool, eventQueries);
+
+      m_pDriver->ReplayLog(0, events.back().eventId, eReplay_Full);
+
+      m_pDriver->SubmitCmds();
+      m_pDriver->FlushQ();
+    }
+  }
+
+  std::vector<uint64_t> occlusionResults;
+
+  if(!eventQueries.empty())
+  {
+    occlusionResults.resize(eventQueries.size());
+
+    vkr = ObjDisp(dev)->GetQueryPoolResults(
+        Unwrap(dev), occlusionPool, 0, (uint32_t)eventQueries.size(),
+        occlusionResults.size() * sizeof(uint64_t), occlusionResults.data(), sizeof(uint64_t),
+        VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+    RDCASSERTEQUAL(vkr, VK_SUCCESS);
+
+    ObjDisp(dev)->DestroyQueryPool(Unwrap(dev), occlusionPool, NULL);
+  }
+
+  for(size_t ev = 0; ev < events.size(); ev++)
+  {
+    uint32_t eid = events[ev].eventId;
+
+    bool directWrite = (directWrites.find(eid) != directWrites.end());
+
+    auto it = eventQueries.find(eid);
+
+    if(!directWrite && it == eventQueries.end())
+      continue;
+
+    if(!directWrite && occlusionResults[it->second] == 0)
+      continue;
+
+    PixelModification mod;
+    RDCEraseEl(mod);
+
+    mod.eventId = eid;
+    mod.directShaderWrite = directWrite;
+
+    // we only know that fragments passed at this event - per-fragment values and pre/post mod
+    // colours aren't fetched yet, so mark them as unknown rather than claiming zeroes.
+    mod.preMod.depth = mod.postMod.depth = mod.shaderOut.depth = -1.0f;
+    mod.preMod.stencil = mod.postMod.stencil = mod.shaderOut.stencil = -1;
+
+    history.push_back(mod);
+  }
+
+  return history;
 }
 
 ShaderDebugTrace VulkanReplay::DebugVertex(uint32_t eventId, uint32_t vertid, uint32_t instid,
@@ -3912,7 +4538,7 @@ struct VulkanDriverRegistration
 
 static VulkanDriverRegistration VkDriverRegistration;
 
-void Vulkan_ProcessStructured(RDCFile *rdc, SDFile &output)
+void Vulkan_ProcessStructured(RDCFile *rdc, SDFile &output, bool includeBuffers)
 {
   WrappedVulkan vulkan;
 
@@ -3922,7 +4548,7 @@ void Vulkan_ProcessStructured(RDCFile *rdc, SDFile &output)
     return;
 
   vulkan.SetStructuredExport(rdc->GetSectionProperties(sectionIdx).version);
-  ReplayStatus status = vulkan.ReadLogInitialisation(rdc, true);
+  ReplayStatus status = vulkan.ReadLogInitialisation(rdc, includeBuffers);
 
   if(status == ReplayStatus::Succeeded)
     vulkan.GetStructuredFile().Swap(output);
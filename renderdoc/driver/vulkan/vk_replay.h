@@ -98,6 +98,7 @@
 
 #endif
 
+#include <list>
 #include <map>
 
 // similar to RDCUNIMPLEMENTED but for things that are hit often so we don't want to fire the
@@ -216,6 +217,17 @@ struct DynamicUsedBinds
   std::vector<BindIdx> used;
 };
 
+// a pipeline patched for the quad overdraw overlay - the app's pipeline with colour/depth writes
+// disabled and the quad write fragment shader substituted in, plus the extended layout that binds
+// the overdraw storage image.
+struct QuadOverdrawPipeline
+{
+  // the index of the appended overdraw descriptor set in the patched layout
+  uint32_t descSet = 0;
+  VkPipelineLayout pipeLayout = VK_NULL_HANDLE;
+  VkPipeline pipe = VK_NULL_HANDLE;
+};
+
 class VulkanReplay : public IReplayDriver
 {
 public:
@@ -261,6 +273,7 @@ public:
   void FreeTargetResource(ResourceId id);
 
   ReplayStatus ReadLogInitialisation(RDCFile *rdc, bool storeStructuredBuffers);
+  void SetLazyStructuredData(bool lazy);
   void ReplayLog(uint32_t endEventID, ReplayLogType replayType);
   const SDFile &GetStructuredFile();
 
@@ -289,6 +302,8 @@ public:
 
   bool GetMinMax(ResourceId texid, uint32_t sliceFace, uint32_t mip, uint32_t sample,
                  CompType typeHint, float *minval, float *maxval);
+  bool GetMinMax(ResourceId texid, const vector<MinMaxSubresource> &subs, CompType typeHint,
+                 float *minval, float *maxval);
   bool GetHistogram(ResourceId texid, uint32_t sliceFace, uint32_t mip, uint32_t sample,
                     CompType typeHint, float minval, float maxval, bool channels[4],
                     vector<uint32_t> &histogram);
@@ -392,6 +407,9 @@ private:
   void FetchTessGSOut(uint32_t eventId);
   void ClearPostVSCache();
 
+  bool GetCachedPostVSPatch(uint64_t key, std::vector<uint32_t> &spirv, uint32_t &stride);
+  void AddCachedPostVSPatch(uint64_t key, const std::vector<uint32_t> &spirv, uint32_t stride);
+
   bool RenderTextureInternal(TextureDisplay cfg, VkRenderPassBeginInfo rpbegin, int flags);
 
   bool GetMinMax(ResourceId texid, uint32_t sliceFace, uint32_t mip, uint32_t sample,
@@ -541,6 +559,10 @@ private:
     void Init(WrappedVulkan *driver, VkDescriptorPool descriptorPool);
     void Destroy(WrappedVulkan *driver);
 
+    // destroys any cached quad overdraw pipelines, on shutdown or when shader replacement means
+    // they would bind stale modules
+    void ResetQuadPipeCache(WrappedVulkan *driver);
+
     VkDeviceMemory ImageMem = VK_NULL_HANDLE;
     VkDeviceSize ImageMemSize = 0;
     VkImage Image = VK_NULL_HANDLE;
@@ -562,6 +584,11 @@ private:
     VkPipelineLayout m_QuadResolvePipeLayout = VK_NULL_HANDLE;
     VkPipeline m_QuadResolvePipeline[8] = {VK_NULL_HANDLE};
 
+    // patched pipelines are kept across overlay renders so scrubbing doesn't recreate identical
+    // pipelines every frame. Invalidated when a shader is replaced (edited pipelines would
+    // otherwise keep referencing the old module).
+    std::map<ResourceId, QuadOverdrawPipeline> m_QuadPipeCache;
+
     GPUBuffer m_TriSizeUBO;
     VkDescriptorSetLayout m_TriSizeDescSetLayout = VK_NULL_HANDLE;
     VkDescriptorSet m_TriSizeDescSet = VK_NULL_HANDLE;
@@ -577,6 +604,14 @@ private:
     GPUBuffer BBoxVB;
     GPUBuffer AxisFrustumVB;
 
+    // ring of indirect argument buffers, used to batch secondary draws (e.g. all instances of a
+    // drawcall) into single multi-draw indirect calls
+    GPUBuffer IndirectBuf;
+
+    // number of VkDrawIndexedIndirectCommand (the larger of the two argument structs) that fit in
+    // one ring slot of IndirectBuf
+    static const size_t MaxIndirectCommands = 4096;
+
     VkDescriptorSetLayout DescSetLayout = VK_NULL_HANDLE;
     VkPipelineLayout PipeLayout = VK_NULL_HANDLE;
     VkDescriptorSet DescSet = VK_NULL_HANDLE;
@@ -596,6 +631,13 @@ private:
     GPUBuffer VBUpload;
     uint32_t IBSize = 0, VBSize = 0;
     GPUBuffer Result, ResultReadback;
+    // identifies the mesh data currently converted and uploaded into IB/VB, so that repeated
+    // picks against the same mesh (e.g. during a mouse drag) skip the readback and re-upload.
+    // See PickVertex.
+    bool CacheValid = false;
+    bool CacheHasIdxs = false;
+    uint32_t CacheEventID = 0;
+    MeshFormat CachePosition;
     VkDescriptorSetLayout DescSetLayout = VK_NULL_HANDLE;
     VkDescriptorSet DescSet = VK_NULL_HANDLE;
     VkPipelineLayout Layout = VK_NULL_HANDLE;
@@ -648,6 +690,17 @@ private:
 
     std::map<uint32_t, VulkanPostVSData> Data;
     std::map<uint32_t, uint32_t> Alias;
+
+    // small LRU cache of patched SPIR-V, keyed on a hash of the source module and the state baked
+    // into the patch, so scrubbing between draws that share pipelines doesn't re-run the SPIR-V
+    // editing passes for every event. Most recently used entries are at the front.
+    struct PatchedSPIRV
+    {
+      uint64_t key;
+      std::vector<uint32_t> spirv;
+      uint32_t stride;
+    };
+    std::list<PatchedSPIRV> PatchCache;
   } m_PostVS;
 
   struct Feedback
@@ -662,6 +715,14 @@ private:
   std::vector<ResourceDescription> m_Resources;
   std::map<ResourceId, size_t> m_ResourceIdx;
 
+  // reverse index from live shader module to the pipelines created against it, built lazily on
+  // the first shader edit. Pipeline creation info never changes after load, so each subsequent
+  // edit touches exactly the pipelines referencing the module instead of scanning every pipeline
+  // in the capture.
+  std::map<ResourceId, std::vector<ResourceId>> m_ModulePipelines;
+
+  const std::vector<ResourceId> &GetPipelinesForShader(ResourceId module);
+
   VKPipe::State m_VulkanPipelineState;
 
   DriverInformation m_DriverInfo;
@@ -935,6 +935,13 @@ struct CmdBufferRecordingInfo
 
   std::map<ResourceId, MemRefs> memFrameRefs;
 
+  // the value of WrappedVulkan::m_CaptureSubmitGen when this baked command buffer was last
+  // submitted during an active capture. When it matches the current generation the chunks and
+  // frame refs have already been pulled into the capture, so a re-submit only needs its
+  // referenced IDs merged. Re-recording bakes a fresh record so a match implies identical
+  // contents.
+  uint32_t captureSubmitGen = 0;
+
   // AdvanceFrame/Present should be called after this buffer is submitted
   bool present;
 };
@@ -983,6 +990,7 @@ struct MemMapState
         needRefData(false),
         mapFlushed(false),
         mapCoherent(false),
+        writeWatched(false),
         mappedPtr(NULL),
         refData(NULL)
   {
@@ -991,6 +999,9 @@ struct MemMapState
   bool needRefData;
   bool mapFlushed;
   bool mapCoherent;
+  // true if the OS is tracking dirty pages in the mapped range, so coherent map diffs at queue
+  // submit time only need to compare the pages the application actually wrote
+  bool writeWatched;
   byte *mappedPtr;
   byte *refData;
 };
@@ -1008,7 +1019,7 @@ struct AttachmentInfo
 
 struct MemRefs
 {
-  Intervals<FrameRefType> rangeRefs;
+  FlatIntervals<FrameRefType> rangeRefs;
   WrappedVkRes *initializedLiveRes;
   inline MemRefs() : initializedLiveRes(NULL) {}
   inline MemRefs(VkDeviceSize offset, VkDeviceSize size, FrameRefType refType)
@@ -1098,7 +1109,9 @@ public:
         bakedCommands(NULL),
         pool(NULL),
         memIdxMap(NULL),
-        ptrunion(NULL)
+        ptrunion(NULL),
+        imageMipCount(0),
+        imageLayerCount(0)
   {
   }
 
@@ -1243,6 +1256,13 @@ public:
   VkResourceRecord *pool;
   vector<VkResourceRecord *> pooledChildren;
 
+  // only for images - the immutable mip/layer dimensions from creation, read when recording
+  // barriers to expand VK_REMAINING_MIP_LEVELS/VK_REMAINING_ARRAY_LAYERS. Keeping them here means
+  // the per-barrier capture path doesn't touch the global image layouts map, whose lock is held
+  // whenever a queue submit updates the tracked layouts.
+  uint16_t imageMipCount;
+  uint16_t imageLayerCount;
+
   // we only need a couple of bytes to store the view's range,
   // so just pack/unpack into bitfields
   struct ViewRange
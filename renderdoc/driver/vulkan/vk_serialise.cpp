@@ -1043,7 +1043,7 @@ static void SerialiseNext(SerialiserType &ser, VkStructureType &sType, const voi
 
     // delete the type itself. Any pNext we serialised is saved in the pNext pointer and will be
     // deleted in DeserialiseNext()
-    delete nextType;
+    FreeDeserialiseType(nextType);
 
     // note, we don't have to serialise more of the chain - this is recursive, if there was more of
     // the pNext chain it would be done recursively above
@@ -1134,7 +1134,7 @@ static inline void DeserialiseNext(const void *pNext)
     case VK_STRUCTURE_TYPE_RANGE_SIZE:
     case VK_STRUCTURE_TYPE_MAX_ENUM: DeserialiseNext(gen); break;
   }
-  delete gen;
+  FreeDeserialiseType(gen);
 }
 
 template <typename SerialiserType>
@@ -1234,7 +1234,7 @@ template <>
 void Deserialise(const VkDeviceQueueCreateInfo &el)
 {
   DeserialiseNext(el.pNext);
-  delete[] el.pQueuePriorities;
+  FreeDeserialiseArray(el.pQueuePriorities);
 }
 
 // technically this doesn't need a serialise function as it's POD,
@@ -1496,10 +1496,10 @@ void Deserialise(const VkDeviceCreateInfo &el)
   DeserialiseNext(el.pNext);
   for(uint32_t i = 0; el.pQueueCreateInfos && i < el.queueCreateInfoCount; i++)
     Deserialise(el.pQueueCreateInfos[i]);
-  delete[] el.pQueueCreateInfos;
-  delete[] el.ppEnabledExtensionNames;
-  delete[] el.ppEnabledLayerNames;
-  delete el.pEnabledFeatures;
+  FreeDeserialiseArray(el.pQueueCreateInfos);
+  FreeDeserialiseArray(el.ppEnabledExtensionNames);
+  FreeDeserialiseArray(el.ppEnabledLayerNames);
+  FreeDeserialiseType(el.pEnabledFeatures);
 }
 
 template <typename SerialiserType>
@@ -1531,7 +1531,7 @@ template <>
 void Deserialise(const VkBufferCreateInfo &el)
 {
   DeserialiseNext(el.pNext);
-  delete[] el.pQueueFamilyIndices;
+  FreeDeserialiseArray(el.pQueueFamilyIndices);
 }
 
 template <typename SerialiserType>
@@ -1590,7 +1590,7 @@ template <>
 void Deserialise(const VkImageCreateInfo &el)
 {
   DeserialiseNext(el.pNext);
-  delete[] el.pQueueFamilyIndices;
+  FreeDeserialiseArray(el.pQueueFamilyIndices);
 }
 
 template <typename SerialiserType>
@@ -1642,7 +1642,7 @@ void DoSerialise(SerialiserType &ser, VkSparseBufferMemoryBindInfo &el)
 template <>
 void Deserialise(const VkSparseBufferMemoryBindInfo &el)
 {
-  delete[] el.pBinds;
+  FreeDeserialiseArray(el.pBinds);
 }
 
 template <typename SerialiserType>
@@ -1656,7 +1656,7 @@ void DoSerialise(SerialiserType &ser, VkSparseImageOpaqueMemoryBindInfo &el)
 template <>
 void Deserialise(const VkSparseImageOpaqueMemoryBindInfo &el)
 {
-  delete[] el.pBinds;
+  FreeDeserialiseArray(el.pBinds);
 }
 
 template <typename SerialiserType>
@@ -1681,7 +1681,7 @@ void DoSerialise(SerialiserType &ser, VkSparseImageMemoryBindInfo &el)
 template <>
 void Deserialise(const VkSparseImageMemoryBindInfo &el)
 {
-  delete[] el.pBinds;
+  FreeDeserialiseArray(el.pBinds);
 }
 
 template <typename SerialiserType>
@@ -1708,17 +1708,17 @@ template <>
 void Deserialise(const VkBindSparseInfo &el)
 {
   DeserialiseNext(el.pNext);
-  delete[] el.pWaitSemaphores;
+  FreeDeserialiseArray(el.pWaitSemaphores);
   for(uint32_t i = 0; el.pBufferBinds && i < el.bufferBindCount; i++)
     Deserialise(el.pBufferBinds[i]);
-  delete[] el.pBufferBinds;
+  FreeDeserialiseArray(el.pBufferBinds);
   for(uint32_t i = 0; el.pImageOpaqueBinds && i < el.imageOpaqueBindCount; i++)
     Deserialise(el.pImageOpaqueBinds[i]);
-  delete[] el.pImageOpaqueBinds;
+  FreeDeserialiseArray(el.pImageOpaqueBinds);
   for(uint32_t i = 0; el.pImageBinds && i < el.imageBindCount; i++)
     Deserialise(el.pImageBinds[i]);
-  delete[] el.pImageBinds;
-  delete[] el.pSignalSemaphores;
+  FreeDeserialiseArray(el.pImageBinds);
+  FreeDeserialiseArray(el.pSignalSemaphores);
 }
 
 template <typename SerialiserType>
@@ -1752,10 +1752,10 @@ template <>
 void Deserialise(const VkSubmitInfo &el)
 {
   DeserialiseNext(el.pNext);
-  delete[] el.pWaitSemaphores;
-  delete[] el.pWaitDstStageMask;
-  delete[] el.pCommandBuffers;
-  delete[] el.pSignalSemaphores;
+  FreeDeserialiseArray(el.pWaitSemaphores);
+  FreeDeserialiseArray(el.pWaitDstStageMask);
+  FreeDeserialiseArray(el.pCommandBuffers);
+  FreeDeserialiseArray(el.pSignalSemaphores);
 }
 
 template <typename SerialiserType>
@@ -1777,7 +1777,7 @@ template <>
 void Deserialise(const VkFramebufferCreateInfo &el)
 {
   DeserialiseNext(el.pNext);
-  delete[] el.pAttachments;
+  FreeDeserialiseArray(el.pAttachments);
 }
 
 template <typename SerialiserType>
@@ -1816,11 +1816,11 @@ void DoSerialise(SerialiserType &ser, VkSubpassDescription &el)
 template <>
 void Deserialise(const VkSubpassDescription &el)
 {
-  delete[] el.pInputAttachments;
-  delete[] el.pColorAttachments;
-  delete[] el.pResolveAttachments;
-  delete el.pDepthStencilAttachment;
-  delete[] el.pPreserveAttachments;
+  FreeDeserialiseArray(el.pInputAttachments);
+  FreeDeserialiseArray(el.pColorAttachments);
+  FreeDeserialiseArray(el.pResolveAttachments);
+  FreeDeserialiseType(el.pDepthStencilAttachment);
+  FreeDeserialiseArray(el.pPreserveAttachments);
 }
 
 template <typename SerialiserType>
@@ -1861,11 +1861,11 @@ template <>
 void Deserialise(const VkRenderPassCreateInfo &el)
 {
   DeserialiseNext(el.pNext);
-  delete[] el.pAttachments;
+  FreeDeserialiseArray(el.pAttachments);
   for(uint32_t i = 0; el.pSubpasses && i < el.subpassCount; i++)
     Deserialise(el.pSubpasses[i]);
-  delete[] el.pSubpasses;
-  delete[] el.pDependencies;
+  FreeDeserialiseArray(el.pSubpasses);
+  FreeDeserialiseArray(el.pDependencies);
 }
 
 template <typename SerialiserType>
@@ -1885,7 +1885,7 @@ template <>
 void Deserialise(const VkRenderPassBeginInfo &el)
 {
   DeserialiseNext(el.pNext);
-  delete[] el.pClearValues;
+  FreeDeserialiseArray(el.pClearValues);
 }
 
 template <typename SerialiserType>
@@ -1922,8 +1922,8 @@ template <>
 void Deserialise(const VkPipelineVertexInputStateCreateInfo &el)
 {
   DeserialiseNext(el.pNext);
-  delete[] el.pVertexBindingDescriptions;
-  delete[] el.pVertexAttributeDescriptions;
+  FreeDeserialiseArray(el.pVertexBindingDescriptions);
+  FreeDeserialiseArray(el.pVertexAttributeDescriptions);
 }
 
 template <typename SerialiserType>
@@ -1978,8 +1978,8 @@ template <>
 void Deserialise(const VkPipelineViewportStateCreateInfo &el)
 {
   DeserialiseNext(el.pNext);
-  delete[] el.pViewports;
-  delete[] el.pScissors;
+  FreeDeserialiseArray(el.pViewports);
+  FreeDeserialiseArray(el.pScissors);
 }
 
 template <typename SerialiserType>
@@ -2028,7 +2028,7 @@ template <>
 void Deserialise(const VkPipelineMultisampleStateCreateInfo &el)
 {
   DeserialiseNext(el.pNext);
-  delete el.pSampleMask;
+  FreeDeserialiseType(el.pSampleMask);
 }
 
 template <typename SerialiserType>
@@ -2062,7 +2062,7 @@ template <>
 void Deserialise(const VkPipelineColorBlendStateCreateInfo &el)
 {
   DeserialiseNext(el.pNext);
-  delete[] el.pAttachments;
+  FreeDeserialiseArray(el.pAttachments);
 }
 
 template <typename SerialiserType>
@@ -2105,7 +2105,7 @@ template <>
 void Deserialise(const VkPipelineDynamicStateCreateInfo &el)
 {
   DeserialiseNext(el.pNext);
-  delete[] el.pDynamicStates;
+  FreeDeserialiseArray(el.pDynamicStates);
 }
 
 template <typename SerialiserType>
@@ -2177,7 +2177,7 @@ void Deserialise(const VkCommandBufferBeginInfo &el)
   DeserialiseNext(el.pNext);
   if(el.pInheritanceInfo)
     Deserialise(*el.pInheritanceInfo);
-  delete el.pInheritanceInfo;
+  FreeDeserialiseType(el.pInheritanceInfo);
 }
 
 template <typename SerialiserType>
@@ -2305,7 +2305,7 @@ void Deserialise(const VkPipelineShaderStageCreateInfo &el)
   if(el.pSpecializationInfo)
   {
     Deserialise(*el.pSpecializationInfo);
-    delete el.pSpecializationInfo;
+    FreeDeserialiseType(el.pSpecializationInfo);
   }
 }
 
@@ -2346,7 +2346,7 @@ template <>
 void Deserialise(const VkSpecializationInfo &el)
 {
   FreeAlignedBuffer((byte *)el.pData);
-  delete[] el.pMapEntries;
+  FreeDeserialiseArray(el.pMapEntries);
 }
 
 template <typename SerialiserType>
@@ -2392,8 +2392,8 @@ template <>
 void Deserialise(const VkPipelineLayoutCreateInfo &el)
 {
   DeserialiseNext(el.pNext);
-  delete[] el.pSetLayouts;
-  delete[] el.pPushConstantRanges;
+  FreeDeserialiseArray(el.pSetLayouts);
+  FreeDeserialiseArray(el.pPushConstantRanges);
 }
 
 template <typename SerialiserType>
@@ -2582,55 +2582,55 @@ void Deserialise(const VkGraphicsPipelineCreateInfo &el)
   if(el.pVertexInputState)
   {
     Deserialise(*el.pVertexInputState);
-    delete el.pVertexInputState;
+    FreeDeserialiseType(el.pVertexInputState);
   }
 
   if(el.pInputAssemblyState)
   {
     Deserialise(*el.pInputAssemblyState);
-    delete el.pInputAssemblyState;
+    FreeDeserialiseType(el.pInputAssemblyState);
   }
 
   if(el.pTessellationState)
   {
     Deserialise(*el.pTessellationState);
-    delete el.pTessellationState;
+    FreeDeserialiseType(el.pTessellationState);
   }
   if(el.pViewportState)
   {
     Deserialise(*el.pViewportState);
-    delete el.pViewportState;
+    FreeDeserialiseType(el.pViewportState);
   }
   if(el.pRasterizationState)
   {
     Deserialise(*el.pRasterizationState);
-    delete el.pRasterizationState;
+    FreeDeserialiseType(el.pRasterizationState);
   }
   if(el.pMultisampleState)
   {
     Deserialise(*el.pMultisampleState);
-    delete el.pMultisampleState;
+    FreeDeserialiseType(el.pMultisampleState);
   }
   if(el.pDepthStencilState)
   {
     Deserialise(*el.pDepthStencilState);
-    delete el.pDepthStencilState;
+    FreeDeserialiseType(el.pDepthStencilState);
   }
   if(el.pColorBlendState)
   {
     Deserialise(*el.pColorBlendState);
-    delete el.pColorBlendState;
+    FreeDeserialiseType(el.pColorBlendState);
   }
   if(el.pDynamicState)
   {
     Deserialise(*el.pDynamicState);
-    delete el.pDynamicState;
+    FreeDeserialiseType(el.pDynamicState);
   }
   for(uint32_t i = 0; el.pStages && i < el.stageCount; i++)
   {
     Deserialise(el.pStages[i]);
   }
-  delete[] el.pStages;
+  FreeDeserialiseArray(el.pStages);
 }
 
 template <typename SerialiserType>
@@ -2659,7 +2659,7 @@ void Deserialise(const VkComputePipelineCreateInfo &el)
   if(el.stage.pSpecializationInfo)
   {
     Deserialise(*el.stage.pSpecializationInfo);
-    delete el.stage.pSpecializationInfo;
+    FreeDeserialiseType(el.stage.pSpecializationInfo);
   }
 }
 
@@ -2686,7 +2686,7 @@ template <>
 void Deserialise(const VkDescriptorPoolCreateInfo &el)
 {
   DeserialiseNext(el.pNext);
-  delete[] el.pPoolSizes;
+  FreeDeserialiseArray(el.pPoolSizes);
 }
 
 template <typename SerialiserType>
@@ -2704,7 +2704,7 @@ template <>
 void Deserialise(const VkDescriptorSetAllocateInfo &el)
 {
   DeserialiseNext(el.pNext);
-  delete[] el.pSetLayouts;
+  FreeDeserialiseArray(el.pSetLayouts);
 }
 
 enum class VkDescriptorImageInfoValidity
@@ -2827,11 +2827,11 @@ void Deserialise(const VkWriteDescriptorSet &el)
 {
   DeserialiseNext(el.pNext);
   if(el.pImageInfo)
-    delete[] el.pImageInfo;
+    FreeDeserialiseArray(el.pImageInfo);
   if(el.pBufferInfo)
-    delete[] el.pBufferInfo;
+    FreeDeserialiseArray(el.pBufferInfo);
   if(el.pTexelBufferView)
-    delete[] el.pTexelBufferView;
+    FreeDeserialiseArray(el.pTexelBufferView);
 }
 
 template <typename SerialiserType>
@@ -2880,7 +2880,7 @@ void DoSerialise(SerialiserType &ser, VkDescriptorSetLayoutBinding &el)
 template <>
 void Deserialise(const VkDescriptorSetLayoutBinding &el)
 {
-  delete[] el.pImmutableSamplers;
+  FreeDeserialiseArray(el.pImmutableSamplers);
 }
 
 template <typename SerialiserType>
@@ -2900,8 +2900,8 @@ void Deserialise(const VkDescriptorSetLayoutCreateInfo &el)
   DeserialiseNext(el.pNext);
   for(uint32_t i = 0; i < el.bindingCount; i++)
     if(el.pBindings[i].pImmutableSamplers)
-      delete[] el.pBindings[i].pImmutableSamplers;
-  delete[] el.pBindings;
+      FreeDeserialiseArray(el.pBindings[i].pImmutableSamplers);
+  FreeDeserialiseArray(el.pBindings);
 }
 
 template <typename SerialiserType>
@@ -3162,10 +3162,10 @@ template <>
 void Deserialise(const VkPresentInfoKHR &el)
 {
   DeserialiseNext(el.pNext);
-  delete[] el.pWaitSemaphores;
-  delete[] el.pSwapchains;
-  delete[] el.pImageIndices;
-  delete[] el.pResults;
+  FreeDeserialiseArray(el.pWaitSemaphores);
+  FreeDeserialiseArray(el.pSwapchains);
+  FreeDeserialiseArray(el.pImageIndices);
+  FreeDeserialiseArray(el.pResults);
 }
 
 template <typename SerialiserType>
@@ -3328,13 +3328,13 @@ void Deserialise(const VkDebugUtilsMessengerCallbackDataEXT &el)
 
   for(uint32_t i = 0; el.pQueueLabels && i < el.queueLabelCount; i++)
     Deserialise(el.pQueueLabels[i]);
-  delete[] el.pQueueLabels;
+  FreeDeserialiseArray(el.pQueueLabels);
   for(uint32_t i = 0; el.pCmdBufLabels && i < el.cmdBufLabelCount; i++)
     Deserialise(el.pCmdBufLabels[i]);
-  delete[] el.pCmdBufLabels;
+  FreeDeserialiseArray(el.pCmdBufLabels);
   for(uint32_t i = 0; el.pObjects && i < el.objectCount; i++)
     Deserialise(el.pObjects[i]);
-  delete[] el.pObjects;
+  FreeDeserialiseArray(el.pObjects);
 }
 
 template <typename SerialiserType>
@@ -3499,7 +3499,7 @@ template <>
 void Deserialise(const VkDescriptorUpdateTemplateCreateInfo &el)
 {
   DeserialiseNext(el.pNext);
-  delete[] el.pDescriptorUpdateEntries;
+  FreeDeserialiseArray(el.pDescriptorUpdateEntries);
 }
 
 template <typename SerialiserType>
@@ -3685,7 +3685,7 @@ template <>
 void Deserialise(const VkRenderPassInputAttachmentAspectCreateInfo &el)
 {
   DeserialiseNext(el.pNext);
-  delete[] el.pAspectReferences;
+  FreeDeserialiseArray(el.pAspectReferences);
 }
 
 template <typename SerialiserType>
@@ -3726,7 +3726,7 @@ template <>
 void Deserialise(const VkPipelineVertexInputDivisorStateCreateInfoEXT &el)
 {
   DeserialiseNext(el.pNext);
-  delete[] el.pVertexBindingDivisors;
+  FreeDeserialiseArray(el.pVertexBindingDivisors);
 }
 
 template <typename SerialiserType>
@@ -3886,9 +3886,9 @@ template <>
 void Deserialise(const VkRenderPassMultiviewCreateInfo &el)
 {
   DeserialiseNext(el.pNext);
-  delete[] el.pViewMasks;
-  delete[] el.pViewOffsets;
-  delete[] el.pCorrelationMasks;
+  FreeDeserialiseArray(el.pViewMasks);
+  FreeDeserialiseArray(el.pViewOffsets);
+  FreeDeserialiseArray(el.pCorrelationMasks);
 }
 
 template <typename SerialiserType>
@@ -3930,7 +3930,7 @@ template <>
 void Deserialise(const VkSampleLocationsInfoEXT &el)
 {
   DeserialiseNext(el.pNext);
-  delete[] el.pSampleLocations;
+  FreeDeserialiseArray(el.pSampleLocations);
 }
 
 template <typename SerialiserType>
@@ -3979,10 +3979,10 @@ void Deserialise(const VkRenderPassSampleLocationsBeginInfoEXT &el)
   for(uint32_t j = 0;
       el.pAttachmentInitialSampleLocations && j < el.attachmentInitialSampleLocationsCount; j++)
     Deserialise(el.pAttachmentInitialSampleLocations[j]);
-  delete[] el.pAttachmentInitialSampleLocations;
+  FreeDeserialiseArray(el.pAttachmentInitialSampleLocations);
   for(uint32_t j = 0; el.pPostSubpassSampleLocations && j < el.postSubpassSampleLocationsCount; j++)
     Deserialise(el.pPostSubpassSampleLocations[j]);
-  delete[] el.pPostSubpassSampleLocations;
+  FreeDeserialiseArray(el.pPostSubpassSampleLocations);
 }
 
 template <typename SerialiserType>
@@ -4184,7 +4184,7 @@ template <>
 void Deserialise(const VkImageFormatListCreateInfoKHR &el)
 {
   DeserialiseNext(el.pNext);
-  delete[] el.pViewFormats;
+  FreeDeserialiseArray(el.pViewFormats);
 }
 
 template <typename SerialiserType>
@@ -4205,7 +4205,7 @@ void DoSerialise(SerialiserType &ser, VkPresentRegionKHR &el)
 template <>
 void Deserialise(const VkPresentRegionKHR &el)
 {
-  delete[] el.pRectangles;
+  FreeDeserialiseArray(el.pRectangles);
 }
 
 template <typename SerialiserType>
@@ -4222,7 +4222,7 @@ template <>
 void Deserialise(const VkPresentRegionsKHR &el)
 {
   DeserialiseNext(el.pNext);
-  delete[] el.pRegions;
+  FreeDeserialiseArray(el.pRegions);
 }
 
 template <typename SerialiserType>
@@ -4410,8 +4410,8 @@ template <>
 void Deserialise(const VkValidationFeaturesEXT &el)
 {
   DeserialiseNext(el.pNext);
-  delete[] el.pEnabledValidationFeatures;
-  delete[] el.pDisabledValidationFeatures;
+  FreeDeserialiseArray(el.pEnabledValidationFeatures);
+  FreeDeserialiseArray(el.pDisabledValidationFeatures);
 }
 
 template <typename SerialiserType>
@@ -4428,7 +4428,7 @@ template <>
 void Deserialise(const VkValidationFlagsEXT &el)
 {
   DeserialiseNext(el.pNext);
-  delete[] el.pDisabledValidationChecks;
+  FreeDeserialiseArray(el.pDisabledValidationChecks);
 }
 
 template <typename SerialiserType>
@@ -4627,7 +4627,7 @@ void Deserialise(const VkSubpassDescription2KHR &el)
 
   if(el.pDepthStencilAttachment)
     Deserialise(*el.pDepthStencilAttachment);
-  delete el.pDepthStencilAttachment;
+  FreeDeserialiseType(el.pDepthStencilAttachment);
 
   for(uint32_t j = 0; el.pColorAttachments && j < el.colorAttachmentCount; j++)
   {
@@ -4635,14 +4635,14 @@ void Deserialise(const VkSubpassDescription2KHR &el)
     if(el.pResolveAttachments)
       Deserialise(el.pResolveAttachments[j]);
   }
-  delete[] el.pColorAttachments;
-  delete[] el.pResolveAttachments;
+  FreeDeserialiseArray(el.pColorAttachments);
+  FreeDeserialiseArray(el.pResolveAttachments);
 
   for(uint32_t j = 0; el.pInputAttachments && j < el.inputAttachmentCount; j++)
     Deserialise(el.pInputAttachments[j]);
 
-  delete[] el.pInputAttachments;
-  delete[] el.pPreserveAttachments;
+  FreeDeserialiseArray(el.pInputAttachments);
+  FreeDeserialiseArray(el.pPreserveAttachments);
 }
 
 template <typename SerialiserType>
@@ -4691,17 +4691,17 @@ void Deserialise(const VkRenderPassCreateInfo2KHR &el)
 
   for(uint32_t i = 0; el.pAttachments && i < el.attachmentCount; i++)
     Deserialise(el.pAttachments[i]);
-  delete[] el.pAttachments;
+  FreeDeserialiseArray(el.pAttachments);
 
   for(uint32_t i = 0; el.pSubpasses && i < el.subpassCount; i++)
     Deserialise(el.pSubpasses[i]);
-  delete[] el.pSubpasses;
+  FreeDeserialiseArray(el.pSubpasses);
 
   for(uint32_t i = 0; el.pDependencies && i < el.dependencyCount; i++)
     Deserialise(el.pDependencies[i]);
-  delete[] el.pDependencies;
+  FreeDeserialiseArray(el.pDependencies);
 
-  delete[] el.pCorrelatedViewMasks;
+  FreeDeserialiseArray(el.pCorrelatedViewMasks);
 }
 
 template <typename SerialiserType>
@@ -5272,7 +5272,7 @@ template <>
 void Deserialise(const VkDescriptorSetLayoutBindingFlagsCreateInfoEXT &el)
 {
   DeserialiseNext(el.pNext);
-  delete[] el.pBindingFlags;
+  FreeDeserialiseArray(el.pBindingFlags);
 }
 
 template <typename SerialiserType>
@@ -5363,7 +5363,7 @@ template <>
 void Deserialise(const VkDescriptorSetVariableDescriptorCountAllocateInfoEXT &el)
 {
   DeserialiseNext(el.pNext);
-  delete[] el.pDescriptorCounts;
+  FreeDeserialiseArray(el.pDescriptorCounts);
 }
 
 template <typename SerialiserType>
@@ -5416,7 +5416,7 @@ template <>
 void Deserialise(const VkPipelineDiscardRectangleStateCreateInfoEXT &el)
 {
   DeserialiseNext(el.pNext);
-  delete[] el.pDiscardRectangles;
+  FreeDeserialiseArray(el.pDiscardRectangles);
 }
 
 template <typename SerialiserType>
@@ -5476,8 +5476,8 @@ template <>
 void Deserialise(const VkPipelineCreationFeedbackCreateInfoEXT &el)
 {
   DeserialiseNext(el.pNext);
-  delete el.pPipelineCreationFeedback;
-  delete[] el.pPipelineStageCreationFeedbacks;
+  FreeDeserialiseType(el.pPipelineCreationFeedback);
+  FreeDeserialiseArray(el.pPipelineStageCreationFeedbacks);
 }
 
 template <typename SerialiserType>
@@ -5966,7 +5966,7 @@ void Deserialise(const VkDeviceGroupPresentInfoKHR &el)
 {
   DeserialiseNext(el.pNext);
 
-  delete[] el.pDeviceMasks;
+  FreeDeserialiseArray(el.pDeviceMasks);
 }
 
 template <typename SerialiserType>
@@ -6011,7 +6011,7 @@ void Deserialise(const VkDeviceGroupDeviceCreateInfo &el)
 {
   DeserialiseNext(el.pNext);
 
-  delete[] el.pPhysicalDevices;
+  FreeDeserialiseArray(el.pPhysicalDevices);
 }
 
 template <typename SerialiserType>
@@ -6046,8 +6046,8 @@ void Deserialise(const VkBindImageMemoryDeviceGroupInfo &el)
 {
   DeserialiseNext(el.pNext);
 
-  delete[] el.pDeviceIndices;
-  delete[] el.pSplitInstanceBindRegions;
+  FreeDeserialiseArray(el.pDeviceIndices);
+  FreeDeserialiseArray(el.pSplitInstanceBindRegions);
 }
 
 template <typename SerialiserType>
@@ -6065,7 +6065,7 @@ void Deserialise(const VkBindBufferMemoryDeviceGroupInfo &el)
 {
   DeserialiseNext(el.pNext);
 
-  delete[] el.pDeviceIndices;
+  FreeDeserialiseArray(el.pDeviceIndices);
 }
 
 template <typename SerialiserType>
@@ -6103,9 +6103,9 @@ void Deserialise(const VkDeviceGroupSubmitInfo &el)
 {
   DeserialiseNext(el.pNext);
 
-  delete[] el.pWaitSemaphoreDeviceIndices;
-  delete[] el.pCommandBufferDeviceMasks;
-  delete[] el.pSignalSemaphoreDeviceIndices;
+  FreeDeserialiseArray(el.pWaitSemaphoreDeviceIndices);
+  FreeDeserialiseArray(el.pCommandBufferDeviceMasks);
+  FreeDeserialiseArray(el.pSignalSemaphoreDeviceIndices);
 }
 
 template <typename SerialiserType>
@@ -6139,7 +6139,7 @@ void Deserialise(const VkDeviceGroupRenderPassBeginInfo &el)
 {
   DeserialiseNext(el.pNext);
 
-  delete[] el.pDeviceRenderAreas;
+  FreeDeserialiseArray(el.pDeviceRenderAreas);
 }
 
 template <typename SerialiserType>
@@ -7308,8 +7308,8 @@ template <>
 void Deserialise(const VkD3D12FenceSubmitInfoKHR &el)
 {
   DeserialiseNext(el.pNext);
-  delete[] el.pWaitSemaphoreValues;
-  delete[] el.pSignalSemaphoreValues;
+  FreeDeserialiseArray(el.pWaitSemaphoreValues);
+  FreeDeserialiseArray(el.pSignalSemaphoreValues);
 }
 
 template <typename SerialiserType>
@@ -7349,11 +7349,11 @@ void Deserialise(const VkWin32KeyedMutexAcquireReleaseInfoNV &el)
 {
   DeserialiseNext(el.pNext);
 
-  delete[] el.pAcquireSyncs;
-  delete[] el.pAcquireKeys;
-  delete[] el.pAcquireTimeoutMilliseconds;
-  delete[] el.pReleaseSyncs;
-  delete[] el.pReleaseKeys;
+  FreeDeserialiseArray(el.pAcquireSyncs);
+  FreeDeserialiseArray(el.pAcquireKeys);
+  FreeDeserialiseArray(el.pAcquireTimeoutMilliseconds);
+  FreeDeserialiseArray(el.pReleaseSyncs);
+  FreeDeserialiseArray(el.pReleaseKeys);
 }
 
 template <typename SerialiserType>
@@ -7377,11 +7377,11 @@ void Deserialise(const VkWin32KeyedMutexAcquireReleaseInfoKHR &el)
 {
   DeserialiseNext(el.pNext);
 
-  delete[] el.pAcquireSyncs;
-  delete[] el.pAcquireKeys;
-  delete[] el.pAcquireTimeouts;
-  delete[] el.pReleaseSyncs;
-  delete[] el.pReleaseKeys;
+  FreeDeserialiseArray(el.pAcquireSyncs);
+  FreeDeserialiseArray(el.pAcquireKeys);
+  FreeDeserialiseArray(el.pAcquireTimeouts);
+  FreeDeserialiseArray(el.pReleaseSyncs);
+  FreeDeserialiseArray(el.pReleaseKeys);
 }
 
 template <typename SerialiserType>
@@ -123,6 +123,57 @@ VulkanShaderCache::VulkanShaderCache(WrappedVulkan *driver)
   m_pDriver = driver;
   m_Device = driver->GetDev();
 
+  {
+    // the driver's pipeline cache data is driver and GPU specific, so key the file by the
+    // pipeline cache UUID. The driver additionally validates the blob's header when creating the
+    // cache, so a stale or corrupt file is safely ignored.
+    const VkPhysicalDeviceProperties &props = driver->GetDeviceProps();
+
+    m_PipelineCacheFile = "vkpipelines_";
+    for(size_t i = 0; i < VK_UUID_SIZE; i++)
+      m_PipelineCacheFile += StringFormat::Fmt("%02x", props.pipelineCacheUUID[i]);
+    m_PipelineCacheFile += ".cache";
+
+    FILE *f = FileIO::fopen(FileIO::GetAppFolderFilename(m_PipelineCacheFile).c_str(), "rb");
+
+    if(f)
+    {
+      FileIO::fseek64(f, 0, SEEK_END);
+      uint64_t cachelen = FileIO::ftell64(f);
+      FileIO::fseek64(f, 0, SEEK_SET);
+
+      m_PipelineCacheBlob.resize((size_t)cachelen);
+      FileIO::fread(m_PipelineCacheBlob.data(), 1, (size_t)cachelen, f);
+
+      FileIO::fclose(f);
+    }
+
+    VkPipelineCacheCreateInfo createInfo = {
+        VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO, NULL, 0, m_PipelineCacheBlob.size(),
+        m_PipelineCacheBlob.data(),
+    };
+
+    VkResult vkr =
+        ObjDisp(m_Device)->CreatePipelineCache(Unwrap(m_Device), &createInfo, NULL, &m_PipelineCache);
+
+    if(vkr != VK_SUCCESS && !m_PipelineCacheBlob.empty())
+    {
+      // retry with a fresh cache in case the data was rejected
+      m_PipelineCacheBlob.clear();
+      createInfo.initialDataSize = 0;
+      createInfo.pInitialData = NULL;
+
+      vkr = ObjDisp(m_Device)->CreatePipelineCache(Unwrap(m_Device), &createInfo, NULL,
+                                                   &m_PipelineCache);
+    }
+
+    if(vkr != VK_SUCCESS)
+    {
+      RDCERR("Couldn't create pipeline cache, VkResult: %s", ToStr(vkr).c_str());
+      m_PipelineCache = VK_NULL_HANDLE;
+    }
+  }
+
   SetCaching(true);
 
   VkDriverInfo driverVersion = driver->GetDriverInfo();
@@ -214,6 +265,37 @@ VulkanShaderCache::~VulkanShaderCache()
 
   for(size_t i = 0; i < ARRAY_COUNT(m_BuiltinShaderModules); i++)
     m_pDriver->vkDestroyShaderModule(m_Device, m_BuiltinShaderModules[i], NULL);
+
+  if(m_PipelineCache != VK_NULL_HANDLE)
+  {
+    size_t size = 0;
+    ObjDisp(m_Device)->GetPipelineCacheData(Unwrap(m_Device), m_PipelineCache, &size, NULL);
+
+    if(size > 0)
+    {
+      std::vector<byte> data;
+      data.resize(size);
+
+      VkResult vkr =
+          ObjDisp(m_Device)->GetPipelineCacheData(Unwrap(m_Device), m_PipelineCache, &size, &data[0]);
+
+      // only rewrite the file if the contents changed this session
+      if(vkr == VK_SUCCESS &&
+         (size != m_PipelineCacheBlob.size() ||
+          memcmp(data.data(), m_PipelineCacheBlob.data(), size) != 0))
+      {
+        FILE *f = FileIO::fopen(FileIO::GetAppFolderFilename(m_PipelineCacheFile).c_str(), "wb");
+
+        if(f)
+        {
+          FileIO::fwrite(data.data(), 1, size, f);
+          FileIO::fclose(f);
+        }
+      }
+    }
+
+    ObjDisp(m_Device)->DestroyPipelineCache(Unwrap(m_Device), m_PipelineCache, NULL);
+  }
 }
 
 std::string VulkanShaderCache::GetSPIRVBlob(const SPIRVCompilationSettings &settings,
@@ -228,10 +310,14 @@ std::string VulkanShaderCache::GetSPIRVBlob(const SPIRVCompilationSettings &sett
   typestr[1] += (char)settings.lang;
   hash = strhash(typestr, hash);
 
-  if(m_ShaderCache.find(hash) != m_ShaderCache.end())
   {
-    outBlob = m_ShaderCache[hash];
-    return "";
+    SCOPED_LOCK(m_ShaderCacheLock);
+    auto it = m_ShaderCache.find(hash);
+    if(it != m_ShaderCache.end())
+    {
+      outBlob = it->second;
+      return "";
+    }
   }
 
   SPIRVBlob spirv = new std::vector<uint32_t>();
@@ -254,8 +340,19 @@ std::string VulkanShaderCache::GetSPIRVBlob(const SPIRVCompilationSettings &sett
 
   if(m_CacheShaders)
   {
-    m_ShaderCache[hash] = spirv;
-    m_ShaderCacheDirty = true;
+    SCOPED_LOCK(m_ShaderCacheLock);
+    SPIRVBlob &cached = m_ShaderCache[hash];
+    if(cached == NULL)
+    {
+      cached = spirv;
+      m_ShaderCacheDirty = true;
+    }
+    else
+    {
+      // another thread compiled the same source while we did, keep its blob
+      delete spirv;
+      outBlob = cached;
+    }
   }
 
   return errors;
@@ -263,15 +360,26 @@ std::string VulkanShaderCache::GetSPIRVBlob(const SPIRVCompilationSettings &sett
 
 void VulkanShaderCache::MakeGraphicsPipelineInfo(VkGraphicsPipelineCreateInfo &pipeCreateInfo,
                                                  ResourceId pipeline)
+{
+  // single-threaded callers all share one scratch, matching the previous behaviour where the
+  // pointed-to structs were function-local statics.
+  static PipelineInfoScratch scratch;
+
+  MakeGraphicsPipelineInfo(scratch, pipeCreateInfo, pipeline);
+}
+
+void VulkanShaderCache::MakeGraphicsPipelineInfo(PipelineInfoScratch &scratch,
+                                                 VkGraphicsPipelineCreateInfo &pipeCreateInfo,
+                                                 ResourceId pipeline)
 {
   const VulkanCreationInfo::Pipeline &pipeInfo = m_pDriver->m_CreationInfo.m_Pipeline[pipeline];
 
   VulkanResourceManager *rm = m_pDriver->GetResourceManager();
 
-  static VkPipelineShaderStageCreateInfo stages[6];
-  static VkSpecializationInfo specInfo[6];
-  static vector<VkSpecializationMapEntry> specMapEntries;
-  static std::vector<byte> specdata;
+  VkPipelineShaderStageCreateInfo *stages = scratch.stages;
+  VkSpecializationInfo *specInfo = scratch.specInfo;
+  vector<VkSpecializationMapEntry> &specMapEntries = scratch.specMapEntries;
+  std::vector<byte> &specdata = scratch.specdata;
 
   size_t specEntries = 0;
   size_t specSize = 0;
@@ -331,11 +439,10 @@ void VulkanShaderCache::MakeGraphicsPipelineInfo(VkGraphicsPipelineCreateInfo &p
     }
   }
 
-  static VkPipelineVertexInputStateCreateInfo vi = {
-      VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO};
+  VkPipelineVertexInputStateCreateInfo &vi = scratch.vi;
 
-  static VkVertexInputAttributeDescription viattr[128] = {};
-  static VkVertexInputBindingDescription vibind[128] = {};
+  auto &viattr = scratch.viattr;
+  auto &vibind = scratch.vibind;
 
   vi.pVertexAttributeDescriptions = viattr;
   vi.pVertexBindingDescriptions = vibind;
@@ -359,10 +466,8 @@ void VulkanShaderCache::MakeGraphicsPipelineInfo(VkGraphicsPipelineCreateInfo &p
                                                                  : VK_VERTEX_INPUT_RATE_VERTEX;
   }
 
-  static VkPipelineVertexInputDivisorStateCreateInfoEXT vertexDivisor = {
-      VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_DIVISOR_STATE_CREATE_INFO_EXT,
-  };
-  static VkVertexInputBindingDivisorDescriptionEXT vibindDivisors[128] = {};
+  VkPipelineVertexInputDivisorStateCreateInfoEXT &vertexDivisor = scratch.vertexDivisor;
+  auto &vibindDivisors = scratch.vibindDivisors;
 
   if(m_pDriver->m_ExtensionsEnabled[VkCheckExt_EXT_vertex_divisor])
   {
@@ -381,22 +486,19 @@ void VulkanShaderCache::MakeGraphicsPipelineInfo(VkGraphicsPipelineCreateInfo &p
   RDCASSERT(ARRAY_COUNT(viattr) >= pipeInfo.vertexAttrs.size());
   RDCASSERT(ARRAY_COUNT(vibind) >= pipeInfo.vertexBindings.size());
 
-  static VkPipelineInputAssemblyStateCreateInfo ia = {
-      VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO};
+  VkPipelineInputAssemblyStateCreateInfo &ia = scratch.ia;
 
   ia.topology = pipeInfo.topology;
   ia.primitiveRestartEnable = pipeInfo.primitiveRestartEnable;
 
-  static VkPipelineTessellationStateCreateInfo tess = {
-      VK_STRUCTURE_TYPE_PIPELINE_TESSELLATION_STATE_CREATE_INFO};
+  VkPipelineTessellationStateCreateInfo &tess = scratch.tess;
 
   tess.patchControlPoints = pipeInfo.patchControlPoints;
 
-  static VkPipelineViewportStateCreateInfo vp = {
-      VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO};
+  VkPipelineViewportStateCreateInfo &vp = scratch.vp;
 
-  static VkViewport views[32] = {};
-  static VkRect2D scissors[32] = {};
+  auto &views = scratch.views;
+  auto &scissors = scratch.scissors;
 
   memcpy(views, &pipeInfo.viewports[0], pipeInfo.viewports.size() * sizeof(VkViewport));
 
@@ -411,9 +513,7 @@ void VulkanShaderCache::MakeGraphicsPipelineInfo(VkGraphicsPipelineCreateInfo &p
   RDCASSERT(ARRAY_COUNT(views) >= pipeInfo.viewports.size());
   RDCASSERT(ARRAY_COUNT(scissors) >= pipeInfo.scissors.size());
 
-  static VkPipelineRasterizationStateCreateInfo rs = {
-      VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO,
-  };
+  VkPipelineRasterizationStateCreateInfo &rs = scratch.rs;
 
   rs.depthClampEnable = pipeInfo.depthClampEnable;
   rs.rasterizerDiscardEnable = pipeInfo.rasterizerDiscardEnable,
@@ -426,9 +526,7 @@ void VulkanShaderCache::MakeGraphicsPipelineInfo(VkGraphicsPipelineCreateInfo &p
   rs.depthBiasSlopeFactor = pipeInfo.depthBiasSlopeFactor;
   rs.lineWidth = pipeInfo.lineWidth;
 
-  static VkPipelineRasterizationConservativeStateCreateInfoEXT conservRast = {
-      VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_CONSERVATIVE_STATE_CREATE_INFO_EXT,
-  };
+  VkPipelineRasterizationConservativeStateCreateInfoEXT &conservRast = scratch.conservRast;
 
   if(m_pDriver->m_ExtensionsEnabled[VkCheckExt_EXT_conserv_rast])
   {
@@ -437,8 +535,7 @@ void VulkanShaderCache::MakeGraphicsPipelineInfo(VkGraphicsPipelineCreateInfo &p
     rs.pNext = &conservRast;
   }
 
-  static VkPipelineMultisampleStateCreateInfo msaa = {
-      VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO};
+  VkPipelineMultisampleStateCreateInfo &msaa = scratch.msaa;
 
   msaa.rasterizationSamples = pipeInfo.rasterizationSamples;
   msaa.sampleShadingEnable = pipeInfo.sampleShadingEnable;
@@ -447,8 +544,7 @@ void VulkanShaderCache::MakeGraphicsPipelineInfo(VkGraphicsPipelineCreateInfo &p
   msaa.alphaToCoverageEnable = pipeInfo.alphaToCoverageEnable;
   msaa.alphaToOneEnable = pipeInfo.alphaToOneEnable;
 
-  static VkPipelineDepthStencilStateCreateInfo ds = {
-      VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO};
+  VkPipelineDepthStencilStateCreateInfo &ds = scratch.ds;
 
   ds.depthTestEnable = pipeInfo.depthTestEnable;
   ds.depthWriteEnable = pipeInfo.depthWriteEnable;
@@ -460,14 +556,13 @@ void VulkanShaderCache::MakeGraphicsPipelineInfo(VkGraphicsPipelineCreateInfo &p
   ds.minDepthBounds = pipeInfo.minDepthBounds;
   ds.maxDepthBounds = pipeInfo.maxDepthBounds;
 
-  static VkPipelineColorBlendStateCreateInfo cb = {
-      VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO};
+  VkPipelineColorBlendStateCreateInfo &cb = scratch.cb;
 
   cb.logicOpEnable = pipeInfo.logicOpEnable;
   cb.logicOp = pipeInfo.logicOp;
   memcpy(cb.blendConstants, pipeInfo.blendConst, sizeof(cb.blendConstants));
 
-  static VkPipelineColorBlendAttachmentState atts[32] = {};
+  auto &atts = scratch.atts;
 
   cb.attachmentCount = (uint32_t)pipeInfo.attachments.size();
   cb.pAttachments = atts;
@@ -486,9 +581,9 @@ void VulkanShaderCache::MakeGraphicsPipelineInfo(VkGraphicsPipelineCreateInfo &p
 
   RDCASSERT(ARRAY_COUNT(atts) >= pipeInfo.attachments.size());
 
-  static VkDynamicState dynSt[VkDynamicCount];
+  auto &dynSt = scratch.dynSt;
 
-  static VkPipelineDynamicStateCreateInfo dyn = {VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO};
+  VkPipelineDynamicStateCreateInfo &dyn = scratch.dyn;
 
   dyn.dynamicStateCount = 0;
   dyn.pDynamicStates = dynSt;
@@ -497,7 +592,8 @@ void VulkanShaderCache::MakeGraphicsPipelineInfo(VkGraphicsPipelineCreateInfo &p
     if(pipeInfo.dynamicStates[i])
       dynSt[dyn.dynamicStateCount++] = ConvertDynamicState((VulkanDynamicStateIndex)i);
 
-  // since we don't have to worry about threading, we point everything at the above static structs
+  // everything points at the caller's scratch storage, which must stay alive until the
+  // pipeline has been created
 
   VkGraphicsPipelineCreateInfo ret = {
       VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
@@ -71,9 +71,53 @@ public:
     return m_BuiltinShaderModules[(size_t)builtin];
   }
 
+  // scratch storage for MakeGraphicsPipelineInfo. The create info is filled out pointing into
+  // this storage rather than allocating, so the scratch must stay alive (and unmodified) until
+  // the pipeline has been created, and each thread compiling pipelines concurrently needs its
+  // own copy.
+  struct PipelineInfoScratch
+  {
+    VkPipelineShaderStageCreateInfo stages[6] = {};
+    VkSpecializationInfo specInfo[6] = {};
+    std::vector<VkSpecializationMapEntry> specMapEntries;
+    std::vector<byte> specdata;
+    VkPipelineVertexInputStateCreateInfo vi = {
+        VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO};
+    VkVertexInputAttributeDescription viattr[128] = {};
+    VkVertexInputBindingDescription vibind[128] = {};
+    VkPipelineVertexInputDivisorStateCreateInfoEXT vertexDivisor = {
+        VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_DIVISOR_STATE_CREATE_INFO_EXT};
+    VkVertexInputBindingDivisorDescriptionEXT vibindDivisors[128] = {};
+    VkPipelineInputAssemblyStateCreateInfo ia = {
+        VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO};
+    VkPipelineTessellationStateCreateInfo tess = {
+        VK_STRUCTURE_TYPE_PIPELINE_TESSELLATION_STATE_CREATE_INFO};
+    VkPipelineViewportStateCreateInfo vp = {VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO};
+    VkViewport views[32] = {};
+    VkRect2D scissors[32] = {};
+    VkPipelineRasterizationStateCreateInfo rs = {
+        VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO};
+    VkPipelineRasterizationConservativeStateCreateInfoEXT conservRast = {
+        VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_CONSERVATIVE_STATE_CREATE_INFO_EXT};
+    VkPipelineMultisampleStateCreateInfo msaa = {
+        VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO};
+    VkPipelineDepthStencilStateCreateInfo ds = {
+        VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO};
+    VkPipelineColorBlendStateCreateInfo cb = {
+        VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO};
+    VkPipelineColorBlendAttachmentState atts[32] = {};
+    VkDynamicState dynSt[VkDynamicCount] = {};
+    VkPipelineDynamicStateCreateInfo dyn = {VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO};
+  };
+
   void MakeGraphicsPipelineInfo(VkGraphicsPipelineCreateInfo &pipeCreateInfo, ResourceId pipeline);
+  void MakeGraphicsPipelineInfo(PipelineInfoScratch &scratch,
+                                VkGraphicsPipelineCreateInfo &pipeCreateInfo, ResourceId pipeline);
   void MakeComputePipelineInfo(VkComputePipelineCreateInfo &pipeCreateInfo, ResourceId pipeline);
 
+  // unwrapped handle of the disk-backed pipeline cache, for passing directly to
+  // vkCreate*Pipelines dispatch calls
+  VkPipelineCache GetPipeCache() { return m_PipelineCache; }
   void SetCaching(bool enabled) { m_CacheShaders = enabled; }
 private:
   static const uint32_t m_ShaderCacheMagic = 0xf00d00d5;
@@ -83,8 +127,15 @@ private:
   VkDevice m_Device = VK_NULL_HANDLE;
 
   bool m_ShaderCacheDirty = false, m_CacheShaders = false;
+  // GetSPIRVBlob is callable from task pool workers while the debug managers warm up their
+  // shaders, so the cache map is locked around lookups and inserts. Compiles run outside the lock
+  Threading::CriticalSection m_ShaderCacheLock;
   std::map<uint32_t, SPIRVBlob> m_ShaderCache;
 
+  std::string m_PipelineCacheFile;
+  std::vector<byte> m_PipelineCacheBlob;
+  VkPipelineCache m_PipelineCache = VK_NULL_HANDLE;
+
   SPIRVBlob m_BuiltinShaderBlobs[arraydim<BuiltinShader>()] = {NULL};
   VkShaderModule m_BuiltinShaderModules[arraydim<BuiltinShader>()] = {VK_NULL_HANDLE};
 };
@@ -183,13 +183,26 @@ bool WrappedVulkan::Prepare_SparseInitialState(WrappedVkBuffer *buf)
   RDCASSERTEQUAL(vkr, VK_SUCCESS);
 
   // INITSTATEBATCH
-  SubmitCmds();
-  FlushQ();
+  if(m_PrepareInitStateBatching)
+  {
+    // defer the flush and staging cleanup - one submit at the end of the batch (or when enough
+    // copies accumulate) covers all the sparse page readbacks
+    for(size_t i = 0; i < bufdeletes.size(); i++)
+      m_PrepareInitStateBufs.push_back(bufdeletes[i]);
 
-  for(size_t i = 0; i < bufdeletes.size(); i++)
+    if(++m_PrepareInitStateCmds >= InitialStateBatchSize)
+      FlushPendingInitialStates();
+  }
+  else
   {
-    ObjDisp(d)->DestroyBuffer(Unwrap(d), Unwrap(bufdeletes[i]), NULL);
-    GetResourceManager()->ReleaseWrappedResource(bufdeletes[i]);
+    SubmitCmds();
+    FlushQ();
+
+    for(size_t i = 0; i < bufdeletes.size(); i++)
+    {
+      ObjDisp(d)->DestroyBuffer(Unwrap(d), Unwrap(bufdeletes[i]), NULL);
+      GetResourceManager()->ReleaseWrappedResource(bufdeletes[i]);
+    }
   }
 
   GetResourceManager()->SetInitialContents(id, initContents);
@@ -345,13 +358,26 @@ bool WrappedVulkan::Prepare_SparseInitialState(WrappedVkImage *im)
   RDCASSERTEQUAL(vkr, VK_SUCCESS);
 
   // INITSTATEBATCH
-  SubmitCmds();
-  FlushQ();
+  if(m_PrepareInitStateBatching)
+  {
+    // defer the flush and staging cleanup - one submit at the end of the batch (or when enough
+    // copies accumulate) covers all the sparse page readbacks
+    for(size_t i = 0; i < bufdeletes.size(); i++)
+      m_PrepareInitStateBufs.push_back(bufdeletes[i]);
 
-  for(size_t i = 0; i < bufdeletes.size(); i++)
+    if(++m_PrepareInitStateCmds >= InitialStateBatchSize)
+      FlushPendingInitialStates();
+  }
+  else
   {
-    ObjDisp(d)->DestroyBuffer(Unwrap(d), Unwrap(bufdeletes[i]), NULL);
-    GetResourceManager()->ReleaseWrappedResource(bufdeletes[i]);
+    SubmitCmds();
+    FlushQ();
+
+    for(size_t i = 0; i < bufdeletes.size(); i++)
+    {
+      ObjDisp(d)->DestroyBuffer(Unwrap(d), Unwrap(bufdeletes[i]), NULL);
+      GetResourceManager()->ReleaseWrappedResource(bufdeletes[i]);
+    }
   }
 
   GetResourceManager()->SetInitialContents(id, initContents);
@@ -712,44 +712,84 @@ bool WrappedVulkan::Serialise_vkBeginCommandBuffer(SerialiserType &ser, VkComman
 
       if(rerecord)
       {
-        VkCommandBuffer cmd = VK_NULL_HANDLE;
-        VkCommandBufferAllocateInfo unwrappedInfo = AllocateInfo;
-        unwrappedInfo.commandPool = Unwrap(unwrappedInfo.commandPool);
-        VkResult ret = ObjDisp(device)->AllocateCommandBuffers(Unwrap(device), &unwrappedInfo, &cmd);
+        // fully in-range command buffers replay identically every time, so they can be recorded
+        // once and resubmitted as-is on subsequent replays. The partial one must be re-recorded
+        // each time, and while a drawcall callback is registered it may insert its own commands
+        // so we neither fill nor consume the cache.
+        bool cacheable = !partial && m_DrawcallCallback == NULL;
 
-        if(ret != VK_SUCCESS)
+        auto cached = m_CachedBakedCmds.find(BakedCommandBuffer);
+
+        if(cacheable && cached != m_CachedBakedCmds.end())
         {
-          RDCERR("Failed on resource serialise-creation, VkResult: %s", ToStr(ret).c_str());
-          return false;
+          // resubmit the previous fully-baked recording as-is. It's already ended, so we mark
+          // both IDs as reused - no commands will replay into it and vkEnd will skip it.
+          VkCommandBuffer cmd = cached->second.second;
+
+          m_RerecordCmds[BakedCommandBuffer] = cmd;
+          m_RerecordCmds[m_LastCmdBufferID] = cmd;
+
+          m_ReusedBakedCmds.insert(BakedCommandBuffer);
+          m_ReusedBakedCmds.insert(m_LastCmdBufferID);
         }
         else
         {
-          GetResourceManager()->WrapResource(Unwrap(device), cmd);
-        }
+          VkCommandBuffer cmd = VK_NULL_HANDLE;
+          VkCommandBufferAllocateInfo unwrappedInfo = AllocateInfo;
+          unwrappedInfo.commandPool = Unwrap(unwrappedInfo.commandPool);
+          VkResult ret =
+              ObjDisp(device)->AllocateCommandBuffers(Unwrap(device), &unwrappedInfo, &cmd);
+
+          if(ret != VK_SUCCESS)
+          {
+            RDCERR("Failed on resource serialise-creation, VkResult: %s", ToStr(ret).c_str());
+            return false;
+          }
+          else
+          {
+            GetResourceManager()->WrapResource(Unwrap(device), cmd);
+          }
+
+          // an earlier bake of the same command buffer may have been reused from the cache this
+          // replay, which marked the original ID as reused. This bake is being re-recorded, so
+          // clear any stale marks or InRerecordRange would skip every command in it.
+          m_ReusedBakedCmds.erase(BakedCommandBuffer);
+          m_ReusedBakedCmds.erase(m_LastCmdBufferID);
+
+          // we store under both baked and non baked ID.
+          // The baked ID is the 'real' entry, the non baked is simply so it
+          // can be found in the subsequent serialised commands that ref the
+          // non-baked ID. The baked ID is referenced by the submit itself.
+          //
+          // In vkEndCommandBuffer we erase the non-baked reference, and since
+          // we know you can only be recording a command buffer once at a time
+          // (even if it's baked to several command buffers in the frame)
+          // there's no issue with clashes here.
+          m_RerecordCmds[BakedCommandBuffer] = cmd;
+          m_RerecordCmds[m_LastCmdBufferID] = cmd;
+
+          m_RerecordCmdList.push_back({AllocateInfo.commandPool, cmd});
+
+          m_BakedCmdBufferInfo[GetResID(cmd)].level = AllocateInfo.level;
+          m_BakedCmdBufferInfo[GetResID(cmd)].beginFlags = BeginInfo.flags;
+
+          // add one-time submit flag as this partial cmd buffer will only be submitted once
+          BeginInfo.flags |= VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+          if(AllocateInfo.level == VK_COMMAND_BUFFER_LEVEL_SECONDARY)
+            BeginInfo.flags |= VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
+
+          if(cacheable)
+          {
+            // vkEnd will move this recording into the cache instead of freeing it, so make sure
+            // it's not begun one-time-submit. Note the actual begin below uses unwrappedBeginInfo,
+            // not BeginInfo.
+            unwrappedBeginInfo.flags &= ~VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
 
-        // we store under both baked and non baked ID.
-        // The baked ID is the 'real' entry, the non baked is simply so it
-        // can be found in the subsequent serialised commands that ref the
-        // non-baked ID. The baked ID is referenced by the submit itself.
-        //
-        // In vkEndCommandBuffer we erase the non-baked reference, and since
-        // we know you can only be recording a command buffer once at a time
-        // (even if it's baked to several command buffers in the frame)
-        // there's no issue with clashes here.
-        m_RerecordCmds[BakedCommandBuffer] = cmd;
-        m_RerecordCmds[m_LastCmdBufferID] = cmd;
-
-        m_RerecordCmdList.push_back({AllocateInfo.commandPool, cmd});
-
-        m_BakedCmdBufferInfo[GetResID(cmd)].level = AllocateInfo.level;
-        m_BakedCmdBufferInfo[GetResID(cmd)].beginFlags = BeginInfo.flags;
-
-        // add one-time submit flag as this partial cmd buffer will only be submitted once
-        BeginInfo.flags |= VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-        if(AllocateInfo.level == VK_COMMAND_BUFFER_LEVEL_SECONDARY)
-          BeginInfo.flags |= VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
-
-        ObjDisp(cmd)->BeginCommandBuffer(Unwrap(cmd), &unwrappedBeginInfo);
+            m_CacheableCmds.insert(BakedCommandBuffer);
+          }
+
+          ObjDisp(cmd)->BeginCommandBuffer(Unwrap(cmd), &unwrappedBeginInfo);
+        }
       }
 
       // whenever a vkCmd command-building chunk asks for the command buffer, it
@@ -925,7 +965,9 @@ bool WrappedVulkan::Serialise_vkEndCommandBuffer(SerialiserType &ser, VkCommandB
 
     if(IsActiveReplaying(m_State))
     {
-      if(HasRerecordCmdBuf(BakedCommandBuffer))
+      // reused cached recordings are already ended, so there's nothing to do for them here
+      if(HasRerecordCmdBuf(BakedCommandBuffer) &&
+         m_ReusedBakedCmds.find(BakedCommandBuffer) == m_ReusedBakedCmds.end())
       {
         commandBuffer = RerecordCmdBuf(BakedCommandBuffer);
 
@@ -1016,6 +1058,10 @@ bool WrappedVulkan::Serialise_vkEndCommandBuffer(SerialiserType &ser, VkCommandB
 
         ObjDisp(commandBuffer)->EndCommandBuffer(Unwrap(commandBuffer));
 
+        // fully-baked recordings are kept across replays and resubmitted as-is next time
+        if(m_CacheableCmds.find(BakedCommandBuffer) != m_CacheableCmds.end())
+          CacheBakedCommandBuffer(BakedCommandBuffer, commandBuffer);
+
         if(m_Partial[Primary].partialParent == BakedCommandBuffer)
           m_Partial[Primary].partialParent = ResourceId();
       }
@@ -1441,13 +1487,11 @@ void WrappedVulkan::vkCmdEndRenderPass(VkCommandBuffer commandBuffer)
       barriers.push_back(fb->imageAttachments[i].barrier);
     }
 
-    // apply the implicit layout transitions here
-    {
-      SCOPED_LOCK(m_ImageLayoutsLock);
-      GetResourceManager()->RecordBarriers(GetRecord(commandBuffer)->cmdInfo->imgbarriers,
-                                           m_ImageLayouts, (uint32_t)barriers.size(),
-                                           barriers.data());
-    }
+    // apply the implicit layout transitions here. No lock is needed - during capture
+    // RecordBarriers only touches the command buffer's own state and the images' records.
+    GetResourceManager()->RecordBarriers(GetRecord(commandBuffer)->cmdInfo->imgbarriers,
+                                         m_ImageLayouts, (uint32_t)barriers.size(),
+                                         barriers.data());
   }
 }
 
@@ -1825,13 +1869,11 @@ void WrappedVulkan::vkCmdEndRenderPass2KHR(VkCommandBuffer commandBuffer,
       barriers.push_back(fb->imageAttachments[i].barrier);
     }
 
-    // apply the implicit layout transitions here
-    {
-      SCOPED_LOCK(m_ImageLayoutsLock);
-      GetResourceManager()->RecordBarriers(GetRecord(commandBuffer)->cmdInfo->imgbarriers,
-                                           m_ImageLayouts, (uint32_t)barriers.size(),
-                                           barriers.data());
-    }
+    // apply the implicit layout transitions here. No lock is needed - during capture
+    // RecordBarriers only touches the command buffer's own state and the images' records.
+    GetResourceManager()->RecordBarriers(GetRecord(commandBuffer)->cmdInfo->imgbarriers,
+                                         m_ImageLayouts, (uint32_t)barriers.size(),
+                                         barriers.data());
   }
 }
 
@@ -2648,7 +2690,8 @@ void WrappedVulkan::vkCmdPipelineBarrier(
 
     if(imageMemoryBarrierCount > 0)
     {
-      SCOPED_LOCK(m_ImageLayoutsLock);
+      // no lock is needed - during capture RecordBarriers only touches the command buffer's own
+      // state and the images' records, not the layouts map.
       GetResourceManager()->RecordBarriers(GetRecord(commandBuffer)->cmdInfo->imgbarriers,
                                            m_ImageLayouts, imageMemoryBarrierCount,
                                            pImageMemoryBarriers);
@@ -2027,6 +2027,13 @@ bool WrappedVulkan::Serialise_vkCreateDevice(SerialiserType &ser, VkPhysicalDevi
           "sampleRateShading = false, save/load from depth 2DMS textures will not be "
           "possible");
 
+    if(availFeatures.multiDrawIndirect)
+      enabledFeatures.multiDrawIndirect = true;
+    else
+      RDCWARN(
+          "multiDrawIndirect = false, rendering many mesh instances in the mesh viewer will be "
+          "slower");
+
     // patch the enabled features
     if(enabledFeatures2)
       enabledFeatures2->features = enabledFeatures;
@@ -2683,6 +2690,9 @@ void WrappedVulkan::vkDestroyDevice(VkDevice device, const VkAllocationCallbacks
   SAFE_DELETE(m_ShaderCache);
   SAFE_DELETE(m_TextRenderer);
 
+  // free any re-recorded command buffers we kept across replays
+  InvalidateBakedCommandBufferCache();
+
   // since we didn't create proper registered resources for our command buffers,
   // they won't be taken down properly with the pool. So we release them (just our
   // data) here.
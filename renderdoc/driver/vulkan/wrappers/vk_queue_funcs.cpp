@@ -724,6 +724,9 @@ VkResult WrappedVulkan::vkQueueSubmit(VkQueue queue, uint32_t submitCount,
     m_SubmitCounter++;
   }
 
+  // measure the capture-side work around the submission, excluding the real driver call below
+  CaptureProfiler::Scope submitScope(CaptureProfiler::Counter::QueueSubmit);
+
   size_t tempmemSize = sizeof(VkSubmitInfo) * submitCount;
 
   // need to count how many semaphore and command buffer arrays to allocate for
@@ -774,10 +777,14 @@ VkResult WrappedVulkan::vkQueueSubmit(VkQueue queue, uint32_t submitCount,
     UnwrapNextChain(m_State, "VkSubmitInfo", memory, (VkBaseInStructure *)&unwrappedSubmits[i]);
   }
 
+  submitScope.End();
+
   VkResult ret;
   SERIALISE_TIME_CALL(ret = ObjDisp(queue)->QueueSubmit(Unwrap(queue), submitCount,
                                                         unwrappedSubmits, Unwrap(fence)));
 
+  PROFILE_CAPTURE_SCOPE(QueueSubmit);
+
   bool capframe = false;
   bool present = false;
 
@@ -869,38 +876,56 @@ VkResult WrappedVulkan::vkQueueSubmit(VkQueue queue, uint32_t submitCount,
             it != record->bakedCommands->cmdInfo->sparse.end(); ++it)
           GetResourceManager()->MarkSparseMapReferenced(*it);
 
-        // pull in frame refs from this baked command buffer
-        record->bakedCommands->AddResourceReferences(GetResourceManager());
-        record->bakedCommands->AddReferencedIDs(refdIDs);
+        if(record->bakedCommands->cmdInfo->captureSubmitGen == m_CaptureSubmitGen)
+        {
+          // this baked command buffer was already submitted during this capture, so its chunks
+          // and frame refs are already pulled in and only the referenced IDs are needed again to
+          // decide which coherent maps to flush for this submit
+          record->bakedCommands->AddReferencedIDs(refdIDs);
 
-        GetResourceManager()->MergeReferencedMemory(record->bakedCommands->cmdInfo->memFrameRefs);
+          for(size_t sub = 0; sub < record->bakedCommands->cmdInfo->subcmds.size(); sub++)
+            record->bakedCommands->cmdInfo->subcmds[sub]->bakedCommands->AddReferencedIDs(refdIDs);
+        }
+        else
+        {
+          // pull in frame refs from this baked command buffer
+          record->bakedCommands->AddResourceReferences(GetResourceManager());
+          record->bakedCommands->AddReferencedIDs(refdIDs);
 
-        // ref the parent command buffer's alloc record, this will pull in the cmd buffer pool
-        GetResourceManager()->MarkResourceFrameReferenced(
-            record->cmdInfo->allocRecord->GetResourceID(), eFrameRef_Read);
+          GetResourceManager()->MergeReferencedMemory(record->bakedCommands->cmdInfo->memFrameRefs);
 
-        for(size_t sub = 0; sub < record->bakedCommands->cmdInfo->subcmds.size(); sub++)
-        {
-          record->bakedCommands->cmdInfo->subcmds[sub]->bakedCommands->AddResourceReferences(
-              GetResourceManager());
-          record->bakedCommands->cmdInfo->subcmds[sub]->bakedCommands->AddReferencedIDs(refdIDs);
-          GetResourceManager()->MergeReferencedMemory(
-              record->bakedCommands->cmdInfo->subcmds[sub]->bakedCommands->cmdInfo->memFrameRefs);
+          // ref the parent command buffer's alloc record, this will pull in the cmd buffer pool
           GetResourceManager()->MarkResourceFrameReferenced(
-              record->bakedCommands->cmdInfo->subcmds[sub]->cmdInfo->allocRecord->GetResourceID(),
-              eFrameRef_Read);
-
-          record->bakedCommands->cmdInfo->subcmds[sub]->bakedCommands->AddRef();
-        }
+              record->cmdInfo->allocRecord->GetResourceID(), eFrameRef_Read);
 
-        {
-          SCOPED_LOCK(m_CmdBufferRecordsLock);
-          m_CmdBufferRecords.push_back(record->bakedCommands);
           for(size_t sub = 0; sub < record->bakedCommands->cmdInfo->subcmds.size(); sub++)
-            m_CmdBufferRecords.push_back(record->bakedCommands->cmdInfo->subcmds[sub]->bakedCommands);
-        }
+          {
+            record->bakedCommands->cmdInfo->subcmds[sub]->bakedCommands->AddResourceReferences(
+                GetResourceManager());
+            record->bakedCommands->cmdInfo->subcmds[sub]->bakedCommands->AddReferencedIDs(refdIDs);
+            GetResourceManager()->MergeReferencedMemory(
+                record->bakedCommands->cmdInfo->subcmds[sub]->bakedCommands->cmdInfo->memFrameRefs);
+            GetResourceManager()->MarkResourceFrameReferenced(
+                record->bakedCommands->cmdInfo->subcmds[sub]->cmdInfo->allocRecord->GetResourceID(),
+                eFrameRef_Read);
+
+            record->bakedCommands->cmdInfo->subcmds[sub]->bakedCommands->AddRef();
+          }
 
-        record->bakedCommands->AddRef();
+          {
+            SCOPED_LOCK(m_CmdBufferRecordsLock);
+            m_CmdBufferRecords.push_back(record->bakedCommands);
+            for(size_t sub = 0; sub < record->bakedCommands->cmdInfo->subcmds.size(); sub++)
+              m_CmdBufferRecords.push_back(
+                  record->bakedCommands->cmdInfo->subcmds[sub]->bakedCommands);
+
+            // stamp inside the lock so a simultaneous-use submit on another thread can't race
+            // into the skip path before this record is in the list
+            record->bakedCommands->cmdInfo->captureSubmitGen = m_CaptureSubmitGen;
+          }
+
+          record->bakedCommands->AddRef();
+        }
       }
 
       record->cmdInfo->dirtied.clear();
@@ -939,6 +964,15 @@ VkResult WrappedVulkan::vkQueueSubmit(VkQueue queue, uint32_t submitCount,
         size_t diffStart = 0, diffEnd = 0;
         bool found = true;
 
+        // if the OS tracked which pages of the map were written, bound the comparison to them.
+        // The dirty flags are consumed here regardless, so the next submit only sees new writes.
+        bool watchValid = false;
+        std::vector<DiffRange> dirtyPages;
+
+        if(state.writeWatched)
+          watchValid = WriteWatch::GetAndResetDirtyRanges((byte *)state.mappedPtr,
+                                                          (size_t)state.mapSize, dirtyPages);
+
 // enabled as this is necessary for programs with very large coherent mappings
 // (> 1GB) as otherwise more than a couple of vkQueueSubmit calls leads to vast
 // memory allocation. There might still be bugs lurking in here though
@@ -965,8 +999,31 @@ VkResult WrappedVulkan::vkQueueSubmit(VkQueue queue, uint32_t submitCount,
         // if we have a previous set of data, compare.
         // otherwise just serialise it all
         if(state.refData)
-          found = FindDiffRange((byte *)state.mappedPtr, state.refData, (size_t)state.mapSize,
-                                diffStart, diffEnd);
+        {
+          if(watchValid && dirtyPages.empty())
+          {
+            // no CPU writes to the map since the last submit - nothing to flush. GPU writes
+            // aren't seen by the watch, but they don't need to be re-uploaded for replay.
+            found = false;
+          }
+          else if(watchValid)
+          {
+            // only compare between the first and last written page, refining the page-granular
+            // bounds down to bytes
+            size_t offs = dirtyPages.front().start;
+
+            found = FindDiffRange((byte *)state.mappedPtr + offs, state.refData + offs,
+                                  dirtyPages.back().end - offs, diffStart, diffEnd);
+
+            diffStart += offs;
+            diffEnd += offs;
+          }
+          else
+          {
+            found = FindDiffRange((byte *)state.mappedPtr, state.refData, (size_t)state.mapSize,
+                                  diffStart, diffEnd);
+          }
+        }
         else
 #endif
           diffEnd = (size_t)state.mapSize;
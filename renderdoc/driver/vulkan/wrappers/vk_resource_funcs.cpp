@@ -274,6 +274,35 @@ bool WrappedVulkan::Serialise_vkAllocateMemory(SerialiserType &ser, VkDevice dev
 
     VkResult ret = ObjDisp(device)->AllocateMemory(Unwrap(device), &patched, NULL, &mem);
 
+    // if a device local allocation failed because the heap is exhausted, retry from a host visible
+    // type. Captures from larger GPUs allocate every memory object up-front on replay, so they can
+    // exceed VRAM on a smaller replay GPU - better to keep the overflow resident in host memory
+    // (slower, but correct) than fail the whole replay. This has to be decided here once and for
+    // all since memory bindings are immutable, we can't page the allocation back to device local
+    // memory later.
+    if(ret == VK_ERROR_OUT_OF_DEVICE_MEMORY &&
+       (m_PhysicalDeviceData.memProps.memoryTypes[patched.memoryTypeIndex].propertyFlags &
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT))
+    {
+      uint32_t hostMemIndex = m_PhysicalDeviceData.GetMemoryIndex(
+          ~0U, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+      if(hostMemIndex != patched.memoryTypeIndex)
+      {
+        RDCWARN(
+            "Out of device memory allocating %llu bytes of memory type %u for %llu. "
+            "Falling back to host visible memory type %u - replay will be slower.",
+            patched.allocationSize, patched.memoryTypeIndex, Memory, hostMemIndex);
+
+        patched.memoryTypeIndex = hostMemIndex;
+        // keep the creation info consistent with what we actually allocated, so that bind-time
+        // compatibility checks below and in CheckMemoryRequirements see the real type.
+        AllocateInfo.memoryTypeIndex = hostMemIndex;
+
+        ret = ObjDisp(device)->AllocateMemory(Unwrap(device), &patched, NULL, &mem);
+      }
+    }
+
     if(ret != VK_SUCCESS)
     {
       RDCERR("Failed on resource serialise-creation, VkResult: %s", ToStr(ret).c_str());
@@ -502,6 +531,13 @@ void WrappedVulkan::vkFreeMemory(VkDevice device, VkDeviceMemory memory,
       wrapped->record->memMapState->refData = NULL;
     }
 
+    if(wrapped->record->memMapState && wrapped->record->memMapState->writeWatched)
+    {
+      WriteWatch::StopTracking(wrapped->record->memMapState->mappedPtr,
+                               (size_t)wrapped->record->memMapState->mapSize);
+      wrapped->record->memMapState->writeWatched = false;
+    }
+
     {
       SCOPED_LOCK(m_CoherentMapsLock);
 
@@ -553,8 +589,19 @@ VkResult WrappedVulkan::vkMapMemory(VkDevice device, VkDeviceMemory mem, VkDevic
 
       if(state.mapCoherent)
       {
-        SCOPED_LOCK(m_CoherentMapsLock);
-        m_CoherentMaps.push_back(memrecord);
+        {
+          SCOPED_LOCK(m_CoherentMapsLock);
+          m_CoherentMaps.push_back(memrecord);
+        }
+
+        // large coherent maps are diffed against a shadow copy on every queue submit. Ask the OS
+        // to track which pages get written so those diffs only touch modified pages - small maps
+        // aren't worth the page fault overhead.
+        const VkDeviceSize watchThreshold = 4 * 1024 * 1024;
+
+        // track the same range the queue submit diff reads - see WrappedVulkan::vkQueueSubmit()
+        if(state.mapSize >= watchThreshold)
+          state.writeWatched = WriteWatch::StartTracking(state.mappedPtr, (size_t)state.mapSize);
       }
     }
     else
@@ -671,6 +718,12 @@ void WrappedVulkan::vkUnmapMemory(VkDevice device, VkDeviceMemory mem)
         }
       }
 
+      if(state.writeWatched)
+      {
+        WriteWatch::StopTracking(state.mappedPtr, (size_t)state.mapSize);
+        state.writeWatched = false;
+      }
+
       state.mappedPtr = NULL;
     }
 
@@ -815,10 +868,16 @@ VkResult WrappedVulkan::vkFlushMappedMemoryRanges(VkDevice device, uint32_t memR
                                                         pMemRanges[i].offset, pMemRanges[i].size,
                                                         eFrameRef_CompleteWrite);
       }
-      else
+      else if(pMemRanges[i].size == VK_WHOLE_SIZE)
       {
         GetResourceManager()->MarkDirtyResource(memid);
       }
+      else
+      {
+        // the flush tells us exactly which bytes are suspect
+        GetResourceManager()->MarkDirtyResourceRange(memid, pMemRanges[i].offset,
+                                                     pMemRanges[i].offset + pMemRanges[i].size);
+      }
     }
   }
 
@@ -1608,6 +1667,11 @@ VkResult WrappedVulkan::vkCreateImage(VkDevice device, const VkImageCreateInfo *
       VkResourceRecord *record = GetResourceManager()->AddResourceRecord(*pImage);
       record->AddChunk(chunk);
 
+      // stashed on the record so barriers on this image can be recorded without consulting the
+      // global image layouts map
+      record->imageMipCount = (uint16_t)pCreateInfo->mipLevels;
+      record->imageLayerCount = (uint16_t)pCreateInfo->arrayLayers;
+
       bool isSparse = (pCreateInfo->flags & (VK_IMAGE_CREATE_SPARSE_BINDING_BIT |
                                              VK_IMAGE_CREATE_SPARSE_RESIDENCY_BIT)) != 0;
 
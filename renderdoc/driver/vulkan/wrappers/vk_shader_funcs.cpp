@@ -23,6 +23,7 @@
  ******************************************************************************/
 
 #include "../vk_core.h"
+#include "../vk_shader_cache.h"
 #include "driver/shaders/spirv/spirv_common.h"
 
 template <>
@@ -418,12 +419,15 @@ bool WrappedVulkan::Serialise_vkCreateGraphicsPipelines(
     VkRenderPass origRP = CreateInfo.renderPass;
     VkPipelineCache origCache = pipelineCache;
 
-    // don't use pipeline caches on replay
+    // the application's pipeline cache contents aren't available on replay, so instead use our
+    // own disk-backed cache - it persists between sessions, so reopening a capture doesn't
+    // recompile every pipeline.
     pipelineCache = VK_NULL_HANDLE;
+    VkPipelineCache replayCache = GetShaderCache()->GetPipeCache();
 
     VkGraphicsPipelineCreateInfo *unwrapped = UnwrapInfos(&CreateInfo, 1);
-    VkResult ret = ObjDisp(device)->CreateGraphicsPipelines(Unwrap(device), Unwrap(pipelineCache),
-                                                            1, unwrapped, NULL, &pipe);
+    VkResult ret = ObjDisp(device)->CreateGraphicsPipelines(Unwrap(device), replayCache, 1,
+                                                            unwrapped, NULL, &pipe);
 
     if(ret != VK_SUCCESS)
     {
@@ -454,21 +458,35 @@ bool WrappedVulkan::Serialise_vkCreateGraphicsPipelines(
 
         pipeInfo.Init(GetResourceManager(), m_CreationInfo, &CreateInfo);
 
-        ResourceId renderPassID = GetResID(CreateInfo.renderPass);
+        pipeInfo.subpass0pipe = VK_NULL_HANDLE;
 
-        CreateInfo.renderPass = m_CreationInfo.m_RenderPass[renderPassID].loadRPs[CreateInfo.subpass];
-        CreateInfo.subpass = 0;
+        if(IsLoading(m_State))
+        {
+          // compiling the subpass0 variant here doubles the driver compile work on the load path,
+          // all of it serialised against chunk processing. The variant isn't needed until we
+          // replay draws in isolation after the load completes, so defer it and batch the
+          // compiles across worker threads at the end of ReadLogInitialisation.
+          m_DeferredSubpass0Pipes.push_back(live);
+        }
+        else
+        {
+          ResourceId renderPassID = GetResID(CreateInfo.renderPass);
 
-        unwrapped = UnwrapInfos(&CreateInfo, 1);
-        ret = ObjDisp(device)->CreateGraphicsPipelines(Unwrap(device), Unwrap(pipelineCache), 1,
-                                                       unwrapped, NULL, &pipeInfo.subpass0pipe);
-        RDCASSERTEQUAL(ret, VK_SUCCESS);
+          CreateInfo.renderPass =
+              m_CreationInfo.m_RenderPass[renderPassID].loadRPs[CreateInfo.subpass];
+          CreateInfo.subpass = 0;
 
-        ResourceId subpass0id =
-            GetResourceManager()->WrapResource(Unwrap(device), pipeInfo.subpass0pipe);
+          unwrapped = UnwrapInfos(&CreateInfo, 1);
+          ret = ObjDisp(device)->CreateGraphicsPipelines(Unwrap(device), replayCache, 1, unwrapped,
+                                                         NULL, &pipeInfo.subpass0pipe);
+          RDCASSERTEQUAL(ret, VK_SUCCESS);
 
-        // register as a live-only resource, so it is cleaned up properly
-        GetResourceManager()->AddLiveResource(subpass0id, pipeInfo.subpass0pipe);
+          ResourceId subpass0id =
+              GetResourceManager()->WrapResource(Unwrap(device), pipeInfo.subpass0pipe);
+
+          // register as a live-only resource, so it is cleaned up properly
+          GetResourceManager()->AddLiveResource(subpass0id, pipeInfo.subpass0pipe);
+        }
       }
     }
 
@@ -497,9 +515,18 @@ VkResult WrappedVulkan::vkCreateGraphicsPipelines(VkDevice device, VkPipelineCac
                                                   VkPipeline *pPipelines)
 {
   VkGraphicsPipelineCreateInfo *unwrapped = UnwrapInfos(pCreateInfos, count);
+
+  VkPipelineCache unwrappedCache = Unwrap(pipelineCache);
+
+  // internal pipelines created during replay - shader edit replacements, debug pipelines - come
+  // through here with no cache. Use the disk-backed replay cache as serialised creation does, so
+  // e.g. iterating on an edited shader doesn't fully recompile its pipelines on every edit
+  if(IsReplayMode(m_State) && pipelineCache == VK_NULL_HANDLE)
+    unwrappedCache = GetShaderCache()->GetPipeCache();
+
   VkResult ret;
   SERIALISE_TIME_CALL(
-      ret = ObjDisp(device)->CreateGraphicsPipelines(Unwrap(device), Unwrap(pipelineCache), count,
+      ret = ObjDisp(device)->CreateGraphicsPipelines(Unwrap(device), unwrappedCache, count,
                                                      unwrapped, pAllocator, pPipelines));
 
   if(ret == VK_SUCCESS)
@@ -611,11 +638,12 @@ bool WrappedVulkan::Serialise_vkCreateComputePipelines(SerialiserType &ser, VkDe
 
     VkPipelineCache origCache = pipelineCache;
 
-    // don't use pipeline caches on replay
+    // as above in vkCreateGraphicsPipelines, substitute our own disk-backed pipeline cache
     pipelineCache = VK_NULL_HANDLE;
+    VkPipelineCache replayCache = GetShaderCache()->GetPipeCache();
 
     VkComputePipelineCreateInfo *unwrapped = UnwrapInfos(&CreateInfo, 1);
-    VkResult ret = ObjDisp(device)->CreateComputePipelines(Unwrap(device), Unwrap(pipelineCache), 1,
+    VkResult ret = ObjDisp(device)->CreateComputePipelines(Unwrap(device), replayCache, 1,
                                                            unwrapped, NULL, &pipe);
 
     if(ret != VK_SUCCESS)
@@ -669,10 +697,17 @@ VkResult WrappedVulkan::vkCreateComputePipelines(VkDevice device, VkPipelineCach
                                                  const VkAllocationCallbacks *pAllocator,
                                                  VkPipeline *pPipelines)
 {
+  VkPipelineCache unwrappedCache = Unwrap(pipelineCache);
+
+  // as in vkCreateGraphicsPipelines, substitute the disk-backed replay cache for internal
+  // pipeline creation during replay
+  if(IsReplayMode(m_State) && pipelineCache == VK_NULL_HANDLE)
+    unwrappedCache = GetShaderCache()->GetPipeCache();
+
   VkResult ret;
   SERIALISE_TIME_CALL(ret = ObjDisp(device)->CreateComputePipelines(
-                          Unwrap(device), Unwrap(pipelineCache), count,
-                          UnwrapInfos(pCreateInfos, count), pAllocator, pPipelines));
+                          Unwrap(device), unwrappedCache, count, UnwrapInfos(pCreateInfos, count),
+                          pAllocator, pPipelines));
 
   if(ret == VK_SUCCESS)
   {
@@ -296,6 +296,9 @@ VkResult WrappedVulkan::vkGetSwapchainImagesKHR(VkDevice device, VkSwapchainKHR
 
         record->InternalResource = true;
 
+        record->imageMipCount = 1;
+        record->imageLayerCount = (uint16_t)swaprecord->swapInfo->arraySize;
+
         record->AddParent(swaprecord);
 
         // note we add the chunk to the swap record, that way when the swapchain is created it will
@@ -0,0 +1,377 @@
+/******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Baldur Karlsson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include <string.h>
+#include "api/replay/renderdoc_replay.h"
+#include "common/common.h"
+#include "formatpacking.h"
+
+#if ENABLED(RDOC_SIMD_X86)
+
+#include <emmintrin.h>
+
+// F16C needs either MSVC (intrinsics always available) or a compiler supporting per-function
+// target attributes, since we can't compile the whole file with -mf16c and still run on older
+// hardware.
+#if ENABLED(RDOC_MSVS)
+#include <intrin.h>
+#define F16C_TARGET
+#define SIMD_F16C_COMPILED 1
+#elif defined(__clang__) || defined(__GNUC__)
+#include <immintrin.h>
+#define F16C_TARGET __attribute__((target("f16c")))
+#define SIMD_F16C_COMPILED 1
+#else
+#define SIMD_F16C_COMPILED 0
+#endif
+
+#elif ENABLED(RDOC_SIMD_NEON)
+
+#include <arm_neon.h>
+
+#endif
+
+float ConvertComponent(const ResourceFormat &fmt, const byte *data)
+{
+  if(fmt.compByteWidth == 8)
+  {
+    // we just downcast
+    const uint64_t *u64 = (const uint64_t *)data;
+    const int64_t *i64 = (const int64_t *)data;
+
+    if(fmt.compType == CompType::Double || fmt.compType == CompType::Float)
+    {
+      return float(*(const double *)u64);
+    }
+    else if(fmt.compType == CompType::UInt || fmt.compType == CompType::UScaled)
+    {
+      return float(*u64);
+    }
+    else if(fmt.compType == CompType::SInt || fmt.compType == CompType::SScaled)
+    {
+      return float(*i64);
+    }
+  }
+  else if(fmt.compByteWidth == 4)
+  {
+    const uint32_t *u32 = (const uint32_t *)data;
+    const int32_t *i32 = (const int32_t *)data;
+
+    if(fmt.compType == CompType::Float || fmt.compType == CompType::Depth)
+    {
+      return *(const float *)u32;
+    }
+    else if(fmt.compType == CompType::UInt || fmt.compType == CompType::UScaled)
+    {
+      return float(*u32);
+    }
+    else if(fmt.compType == CompType::SInt || fmt.compType == CompType::SScaled)
+    {
+      return float(*i32);
+    }
+  }
+  else if(fmt.compByteWidth == 3 && fmt.compType == CompType::Depth)
+  {
+    // 24-bit depth is a weird edge case we need to assemble it by hand
+    const uint8_t *u8 = (const uint8_t *)data;
+
+    uint32_t depth = 0;
+    depth |= uint32_t(u8[1]);
+    depth |= uint32_t(u8[2]) << 8;
+    depth |= uint32_t(u8[3]) << 16;
+
+    return float(depth) / float(16777215.0f);
+  }
+  else if(fmt.compByteWidth == 2)
+  {
+    const uint16_t *u16 = (const uint16_t *)data;
+    const int16_t *i16 = (const int16_t *)data;
+
+    if(fmt.compType == CompType::Float)
+    {
+      return ConvertFromHalf(*u16);
+    }
+    else if(fmt.compType == CompType::UInt || fmt.compType == CompType::UScaled)
+    {
+      return float(*u16);
+    }
+    else if(fmt.compType == CompType::SInt || fmt.compType == CompType::SScaled)
+    {
+      return float(*i16);
+    }
+    // 16-bit depth is UNORM
+    else if(fmt.compType == CompType::UNorm || fmt.compType == CompType::Depth)
+    {
+      return float(*u16) / 65535.0f;
+    }
+    else if(fmt.compType == CompType::SNorm)
+    {
+      float f = -1.0f;
+
+      if(*i16 == -32768)
+        f = -1.0f;
+      else
+        f = ((float)*i16) / 32767.0f;
+
+      return f;
+    }
+  }
+  else if(fmt.compByteWidth == 1)
+  {
+    const uint8_t *u8 = (const uint8_t *)data;
+    const int8_t *i8 = (const int8_t *)data;
+
+    if(fmt.compType == CompType::UInt || fmt.compType == CompType::UScaled)
+    {
+      return float(*u8);
+    }
+    else if(fmt.compType == CompType::SInt || fmt.compType == CompType::SScaled)
+    {
+      return float(*i8);
+    }
+    else if(fmt.compType == CompType::UNormSRGB)
+    {
+      return SRGB8_lookuptable[*u8];
+    }
+    else if(fmt.compType == CompType::UNorm)
+    {
+      return float(*u8) / 255.0f;
+    }
+    else if(fmt.compType == CompType::SNorm)
+    {
+      float f = -1.0f;
+
+      if(*i8 == -128)
+        f = -1.0f;
+      else
+        f = ((float)*i8) / 127.0f;
+
+      return f;
+    }
+  }
+
+  RDCERR("Unexpected format to convert from %u %u", fmt.compByteWidth, fmt.compType);
+
+  return 0.0f;
+}
+
+// converts a single texel to float4, the scalar path shared by every format
+static void ConvertTexel(const ResourceFormat &fmt, const byte *data, Vec4f &out)
+{
+  if(fmt.type == ResourceFormatType::R10G10B10A2)
+  {
+    if(fmt.compType == CompType::SNorm)
+      out = ConvertFromR10G10B10A2SNorm(*(const uint32_t *)data);
+    else
+      out = ConvertFromR10G10B10A2(*(const uint32_t *)data);
+    return;
+  }
+  else if(fmt.type == ResourceFormatType::R11G11B10)
+  {
+    Vec3f v = ConvertFromR11G11B10(*(const uint32_t *)data);
+    out = Vec4f(v.x, v.y, v.z, 1.0f);
+    return;
+  }
+
+  out = Vec4f(0.0f, 0.0f, 0.0f, 1.0f);
+
+  float *comps = &out.x;
+  for(uint32_t c = 0; c < fmt.compCount && c < 4; c++)
+    comps[c] = ConvertComponent(fmt, data + c * fmt.compByteWidth);
+}
+
+/////////////////////////////////////////////////////////////
+// bulk kernels for the common tightly-packed cases
+
+typedef void (*TexelKernel)(const byte *src, Vec4f *dst, uint32_t count);
+
+static void Convert_RGBA8UNorm_Scalar(const byte *src, Vec4f *dst, uint32_t count)
+{
+  for(uint32_t i = 0; i < count; i++, src += 4, dst++)
+    *dst = Vec4f(float(src[0]) / 255.0f, float(src[1]) / 255.0f, float(src[2]) / 255.0f,
+                 float(src[3]) / 255.0f);
+}
+
+static void Convert_RGBA16F_Scalar(const byte *src, Vec4f *dst, uint32_t count)
+{
+  for(uint32_t i = 0; i < count; i++, src += 8, dst++)
+  {
+    const uint16_t *h = (const uint16_t *)src;
+    *dst = Vec4f(ConvertFromHalf(h[0]), ConvertFromHalf(h[1]), ConvertFromHalf(h[2]),
+                 ConvertFromHalf(h[3]));
+  }
+}
+
+#if ENABLED(RDOC_SIMD_X86)
+
+// four texels per iteration: unpack 16 bytes up to 32-bit and scale
+static void Convert_RGBA8UNorm_SSE2(const byte *src, Vec4f *dst, uint32_t count)
+{
+  const __m128 scale = _mm_set1_ps(1.0f / 255.0f);
+  const __m128i zero = _mm_setzero_si128();
+
+  uint32_t i = 0;
+  for(; i + 4 <= count; i += 4, src += 16, dst += 4)
+  {
+    __m128i bytes = _mm_loadu_si128((const __m128i *)src);
+    __m128i lo16 = _mm_unpacklo_epi8(bytes, zero);
+    __m128i hi16 = _mm_unpackhi_epi8(bytes, zero);
+
+    _mm_storeu_ps(&dst[0].x, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lo16, zero)), scale));
+    _mm_storeu_ps(&dst[1].x, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lo16, zero)), scale));
+    _mm_storeu_ps(&dst[2].x, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(hi16, zero)), scale));
+    _mm_storeu_ps(&dst[3].x, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(hi16, zero)), scale));
+  }
+
+  if(i < count)
+    Convert_RGBA8UNorm_Scalar(src, dst, count - i);
+}
+
+#if SIMD_F16C_COMPILED
+
+// two texels (eight halves) per iteration
+F16C_TARGET static void Convert_RGBA16F_F16C(const byte *src, Vec4f *dst, uint32_t count)
+{
+  uint32_t i = 0;
+  for(; i + 2 <= count; i += 2, src += 16, dst += 2)
+  {
+    __m128i halfs = _mm_loadu_si128((const __m128i *)src);
+    _mm256_storeu_ps(&dst[0].x, _mm256_cvtph_ps(halfs));
+  }
+
+  if(i < count)
+    Convert_RGBA16F_Scalar(src, dst, count - i);
+}
+
+static bool F16CSupported()
+{
+#if ENABLED(RDOC_MSVS)
+  int info[4] = {};
+
+  // the OS must save/restore YMM state since the conversion goes through AVX registers
+  __cpuid(info, 1);
+  const int OSXSAVE = 1 << 27;
+  const int F16C = 1 << 29;
+  if((info[2] & OSXSAVE) == 0 || (info[2] & F16C) == 0)
+    return false;
+
+  return (_xgetbv(0) & 0x6) == 0x6;
+#else
+  return __builtin_cpu_supports("f16c") != 0 && __builtin_cpu_supports("avx") != 0;
+#endif
+}
+
+#endif    // SIMD_F16C_COMPILED
+
+#elif ENABLED(RDOC_SIMD_NEON)
+
+// four texels per iteration: widen 16 bytes to 32-bit and scale
+static void Convert_RGBA8UNorm_NEON(const byte *src, Vec4f *dst, uint32_t count)
+{
+  const float32x4_t scale = vdupq_n_f32(1.0f / 255.0f);
+
+  uint32_t i = 0;
+  for(; i + 4 <= count; i += 4, src += 16, dst += 4)
+  {
+    uint8x16_t bytes = vld1q_u8(src);
+    uint16x8_t lo16 = vmovl_u8(vget_low_u8(bytes));
+    uint16x8_t hi16 = vmovl_u8(vget_high_u8(bytes));
+
+    vst1q_f32(&dst[0].x, vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(lo16))), scale));
+    vst1q_f32(&dst[1].x, vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(lo16))), scale));
+    vst1q_f32(&dst[2].x, vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(hi16))), scale));
+    vst1q_f32(&dst[3].x, vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(hi16))), scale));
+  }
+
+  if(i < count)
+    Convert_RGBA8UNorm_Scalar(src, dst, count - i);
+}
+
+#endif
+
+static TexelKernel ConvertRGBA8UNorm = NULL;
+static TexelKernel ConvertRGBA16F = NULL;
+
+static void InitConvertKernels()
+{
+  // benign race - all threads write the same values
+  if(ConvertRGBA8UNorm)
+    return;
+
+#if ENABLED(RDOC_SIMD_X86)
+
+  // SSE2 is baseline on every x86 target we build for
+  ConvertRGBA8UNorm = &Convert_RGBA8UNorm_SSE2;
+  ConvertRGBA16F = &Convert_RGBA16F_Scalar;
+
+#if SIMD_F16C_COMPILED
+  if(F16CSupported())
+    ConvertRGBA16F = &Convert_RGBA16F_F16C;
+#endif
+
+#elif ENABLED(RDOC_SIMD_NEON)
+
+  ConvertRGBA8UNorm = &Convert_RGBA8UNorm_NEON;
+  ConvertRGBA16F = &Convert_RGBA16F_Scalar;
+
+#else
+
+  ConvertRGBA8UNorm = &Convert_RGBA8UNorm_Scalar;
+  ConvertRGBA16F = &Convert_RGBA16F_Scalar;
+
+#endif
+}
+
+void ConvertComponents(const ResourceFormat &fmt, const byte *data, uint32_t count, uint32_t stride,
+                       Vec4f *out)
+{
+  InitConvertKernels();
+
+  // the common tightly packed readback formats go through vectorised kernels
+  if(fmt.type == ResourceFormatType::Regular && fmt.compCount == 4 &&
+     stride == fmt.compCount * fmt.compByteWidth)
+  {
+    if(fmt.compByteWidth == 4 && fmt.compType == CompType::Float)
+    {
+      memcpy(out, data, count * sizeof(Vec4f));
+      return;
+    }
+    else if(fmt.compByteWidth == 2 && fmt.compType == CompType::Float)
+    {
+      ConvertRGBA16F(data, out, count);
+      return;
+    }
+    else if(fmt.compByteWidth == 1 && fmt.compType == CompType::UNorm)
+    {
+      ConvertRGBA8UNorm(data, out, count);
+      return;
+    }
+  }
+
+  for(uint32_t i = 0; i < count; i++)
+  {
+    ConvertTexel(fmt, data, out[i]);
+    data += stride;
+  }
+}
@@ -186,4 +186,12 @@ inline Vec4f ConvertSRGBToLinear(Vec4f srgbF)
 struct ResourceFormat;
 float ConvertComponent(const ResourceFormat &fmt, const byte *data);
 
+// bulk variant of ConvertComponent: converts count texels of fmt, stride bytes apart, into a
+// tightly packed float4 stream, padding missing components with (0,0,0,1). The packed
+// R10G10B10A2/R11G11B10 formats are handled too. As with ConvertComponent the components come out
+// in memory order - BGRA swizzling is the caller's business. The common tightly packed cases
+// (RGBA32F, RGBA16F, RGBA8 unorm) go through vectorised kernels.
+void ConvertComponents(const ResourceFormat &fmt, const byte *data, uint32_t count, uint32_t stride,
+                       Vec4f *out);
+
 #include "half_convert.h"
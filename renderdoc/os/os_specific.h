@@ -145,6 +145,9 @@ void SetTLSValue(uint64_t slot, void *value);
 typedef uint64_t ThreadHandle;
 ThreadHandle CreateThread(std::function<void()> entryFunc);
 uint64_t GetCurrentID();
+// returns the number of hardware threads available, used for sizing worker thread pools.
+// Always returns at least 1.
+uint32_t NumberOfCores();
 void JoinThread(ThreadHandle handle);
 void DetachThread(ThreadHandle handle);
 void CloseThread(ThreadHandle handle);
@@ -175,7 +178,18 @@ public:
 
   bool IsRecvDataWaiting();
 
+  // one segment of a vectored send, see SendDataVectoredBlocking
+  struct SendVec
+  {
+    const void *data;
+    uint32_t length;
+  };
+
   bool SendDataBlocking(const void *buf, uint32_t length);
+  // sends multiple segments as one stream of bytes with a single kernel call where possible
+  // (writev/WSASend), so e.g. a header and a large payload don't need to be copied into a
+  // contiguous staging buffer first.
+  bool SendDataVectoredBlocking(const SendVec *vecs, uint32_t count);
   bool RecvDataBlocking(void *data, uint32_t length);
   bool RecvDataNonBlocking(void *data, uint32_t &length);
 
@@ -226,6 +240,30 @@ int64_t ExchAdd64(volatile int64_t *i, int64_t a);
 int32_t CmpExch32(volatile int32_t *dest, int32_t oldVal, int32_t newVal);
 };
 
+// OS-assisted dirty tracking for large persistently-mapped memory. The pages of a tracked range
+// are write-protected, the first CPU write to each page faults and is recorded by our handler,
+// and the page is made writeable again so subsequent writes run at full speed. The recorded pages
+// then bound how much of the range needs diffing against its shadow copy, instead of comparing
+// the whole mapping every time.
+//
+// Tracking is best-effort: StartTracking returns false if the range can't be write-protected
+// (e.g. some driver memory mappings) or no tracking slot is free, and callers must fall back to
+// diffing the whole range.
+//
+// Note only CPU writes are seen - GPU writes to the same memory don't go through the CPU page
+// tables. That's fine for the intended users, which only need to pick up application writes.
+struct DiffRange;
+
+namespace WriteWatch
+{
+bool StartTracking(void *ptr, size_t size);
+void StopTracking(void *ptr, size_t size);
+// appends a [start, end) byte range relative to ptr for each contiguous run of pages written
+// since tracking started or since the last call, and write-protects those pages again so future
+// writes are caught. Returns false if ptr isn't tracked.
+bool GetAndResetDirtyRanges(void *ptr, size_t size, std::vector<DiffRange> &dirty);
+};
+
 namespace Callstack
 {
 class Stackwalk
@@ -297,6 +335,13 @@ size_t fwrite(const void *buf, size_t elementSize, size_t count, FILE *f);
 
 bool exists(const char *filename);
 
+// maps the first length bytes of an open file read-only into memory, for zero-copy access to file
+// contents. Returns NULL if the file can't be mapped, in which case the caller should fall back to
+// normal buffered reads. The FILE* must remain open for as long as the mapping is in use, and the
+// mapping must be released with ReleaseMapping.
+byte *MapReadOnly(FILE *f, uint64_t length);
+void ReleaseMapping(byte *base, uint64_t length);
+
 std::string ErrorString();
 
 std::string getline(FILE *f);
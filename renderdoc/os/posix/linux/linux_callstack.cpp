@@ -24,10 +24,16 @@
 
 #include <execinfo.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
 #include <map>
 #include <vector>
 #include "os/os_specific.h"
+#include "strings/string_utils.h"
 
 void *renderdocBase = NULL;
 void *renderdocEnd = NULL;
@@ -59,7 +65,51 @@ private:
   {
     void *addrs_ptr[ARRAY_COUNT(addrs)];
 
-    numLevels = backtrace(addrs_ptr, ARRAY_COUNT(addrs));
+    // fast path: walk the chain of saved frame pointers directly. glibc's backtrace() unwinds
+    // through DWARF CFI which costs an order of magnitude more, and with callstack capture
+    // enabled we're called for every chunk. Each step is validated before dereferencing - the
+    // chain must stay aligned and walk upwards through a sane amount of the current stack - so
+    // code built without frame pointers just breaks the chain early rather than crashing.
+    struct StackFrame
+    {
+      StackFrame *prev;
+      void *ret;
+    };
+
+    StackFrame *frame = (StackFrame *)__builtin_frame_address(0);
+
+    uintptr_t stackPtr = (uintptr_t)&frame;
+    uintptr_t lastfp = 0;
+
+    int total = 0;
+
+    while(total < (int)ARRAY_COUNT(addrs))
+    {
+      uintptr_t fp = (uintptr_t)frame;
+
+      if(fp <= lastfp || fp < stackPtr || fp - stackPtr > 4 * 1024 * 1024 ||
+         (fp & (sizeof(void *) - 1)) != 0)
+        break;
+
+      if(frame->ret == NULL)
+        break;
+
+      addrs_ptr[total++] = frame->ret;
+
+      lastfp = fp;
+      frame = frame->prev;
+    }
+
+    // if the chain broke before it reached any frame outside our own module, the application is
+    // most likely compiled without frame pointers - collect with the full unwinder instead
+    bool reachedApp = false;
+    for(int i = 0; i < total; i++)
+      reachedApp |= addrs_ptr[i] < renderdocBase || addrs_ptr[i] >= renderdocEnd;
+
+    if(!reachedApp)
+      total = backtrace(addrs_ptr, ARRAY_COUNT(addrs));
+
+    numLevels = total;
 
     int offs = 0;
     // if we want to trim levels of the stack, we can do that here
@@ -151,7 +201,41 @@ struct LookupModule
 class LinuxResolver : public Callstack::StackResolver
 {
 public:
-  LinuxResolver(vector<LookupModule> modules) { m_Modules = modules; }
+  LinuxResolver(vector<LookupModule> modules)
+  {
+    m_Modules.resize(modules.size());
+
+    for(size_t i = 0; i < modules.size(); i++)
+    {
+      m_Modules[i].info = modules[i];
+
+      LoadDiskCache(m_Modules[i]);
+
+      // spawn a symboliser up-front for any module we have no disk cache for yet, so every
+      // module's debug info parses concurrently in the children while the first capture from
+      // this build is being opened. Cached modules spawn one lazily if a new address turns up
+      if(m_Modules[i].resolved.empty())
+        SpawnChild(m_Modules[i]);
+    }
+  }
+
+  ~LinuxResolver()
+  {
+    for(size_t i = 0; i < m_Modules.size(); i++)
+    {
+      SaveDiskCache(m_Modules[i]);
+
+      if(m_Modules[i].pid >= 0)
+      {
+        // closing stdin makes addr2line exit
+        close(m_Modules[i].writefd);
+        if(m_Modules[i].readf)
+          fclose(m_Modules[i].readf);
+        waitpid(m_Modules[i].pid, NULL, 0);
+      }
+    }
+  }
+
   Callstack::AddressDetails GetAddr(uint64_t addr)
   {
     EnsureCached(addr);
@@ -160,6 +244,183 @@ public:
   }
 
 private:
+  struct Module
+  {
+    LookupModule info;
+
+    // resolved symbols for this module, keyed on module-relative address so the results stay
+    // valid under ASLR. Backed by a disk cache so only the first capture from a given build of
+    // the module pays for symbol resolution.
+    std::map<uint64_t, Callstack::AddressDetails> resolved;
+    std::string cachePath;
+    bool cacheDirty = false;
+
+    // long-running addr2line child with the module's debug info loaded, so each address costs a
+    // pipe round-trip instead of a process spawn and a full DWARF parse
+    pid_t pid = -1;
+    int writefd = -1;
+    FILE *readf = NULL;
+    bool primed = false;
+  };
+
+  void LoadDiskCache(Module &mod)
+  {
+    struct ::stat st = {};
+    if(::stat(mod.info.path, &st) != 0)
+      return;
+
+    // size and mtime of the binary stand in for a content hash - hashing multi-GB binaries on
+    // every capture open would cost a good chunk of what the cache saves
+    mod.cachePath = FileIO::GetAppFolderFilename(
+        StringFormat::Fmt("symcache_%08x_%llx_%llx.txt", strhash(mod.info.path),
+                          (uint64_t)st.st_size, (uint64_t)st.st_mtime));
+
+    FILE *f = FileIO::fopen(mod.cachePath.c_str(), "r");
+
+    if(!f)
+      return;
+
+    char line[4096];
+    while(fgets(line, sizeof(line) - 1, f))
+    {
+      // relative address, line number, filename, function - tab separated with function last
+      // since filenames can't realistically contain tabs but function signatures get exotic
+      char *lineNum = strchr(line, '\t');
+      if(!lineNum)
+        continue;
+      *lineNum = 0;
+      lineNum++;
+
+      char *filename = strchr(lineNum, '\t');
+      if(!filename)
+        continue;
+      *filename = 0;
+      filename++;
+
+      char *function = strchr(filename, '\t');
+      if(!function)
+        continue;
+      *function = 0;
+      function++;
+
+      char *nl = strchr(function, '\n');
+      if(nl)
+        *nl = 0;
+
+      Callstack::AddressDetails &det = mod.resolved[strtoull(line, NULL, 16)];
+      det.line = (uint32_t)strtoul(lineNum, NULL, 10);
+      det.filename = filename;
+      det.function = function;
+    }
+
+    FileIO::fclose(f);
+  }
+
+  void SaveDiskCache(Module &mod)
+  {
+    if(!mod.cacheDirty || mod.cachePath.empty())
+      return;
+
+    FILE *f = FileIO::fopen(mod.cachePath.c_str(), "w");
+
+    if(!f)
+      return;
+
+    for(auto it = mod.resolved.begin(); it != mod.resolved.end(); ++it)
+      fprintf(f, "%llx\t%u\t%s\t%s\n", (unsigned long long)it->first, it->second.line,
+              it->second.filename.c_str(), it->second.function.c_str());
+
+    FileIO::fclose(f);
+  }
+
+  void SpawnChild(Module &mod)
+  {
+    int inpipe[2] = {-1, -1}, outpipe[2] = {-1, -1};
+
+    if(pipe(inpipe) != 0)
+      return;
+
+    if(pipe(outpipe) != 0)
+    {
+      close(inpipe[0]);
+      close(inpipe[1]);
+      return;
+    }
+
+    pid_t pid = fork();
+
+    if(pid < 0)
+    {
+      close(inpipe[0]);
+      close(inpipe[1]);
+      close(outpipe[0]);
+      close(outpipe[1]);
+      return;
+    }
+
+    if(pid == 0)
+    {
+      dup2(inpipe[0], 0);
+      dup2(outpipe[1], 1);
+      close(inpipe[0]);
+      close(inpipe[1]);
+      close(outpipe[0]);
+      close(outpipe[1]);
+      execlp("addr2line", "addr2line", "-fC", "-e", mod.info.path, (char *)NULL);
+      _exit(1);
+    }
+
+    close(inpipe[0]);
+    close(outpipe[1]);
+
+    mod.pid = pid;
+    mod.writefd = inpipe[1];
+    mod.readf = fdopen(outpipe[0], "r");
+
+    // kick off a dummy lookup without waiting for the reply - addr2line parses the line info
+    // lazily on the first address, and this way all the children parse at the same time. The
+    // reply is drained before the first real query
+    if(mod.readf && write(mod.writefd, "0x0\n", 4) == 4)
+      mod.primed = true;
+  }
+
+  bool QueryChild(Module &mod, uint64_t relative, char *function, char *fileline, size_t bufSize)
+  {
+    if(mod.pid < 0)
+      SpawnChild(mod);
+
+    if(mod.pid < 0 || mod.readf == NULL)
+      return false;
+
+    if(mod.primed)
+    {
+      char dummy[2048];
+      if(fgets(dummy, sizeof(dummy) - 1, mod.readf) == NULL ||
+         fgets(dummy, sizeof(dummy) - 1, mod.readf) == NULL)
+        return false;
+      mod.primed = false;
+    }
+
+    string query = StringFormat::Fmt("0x%llx\n", relative);
+
+    if(write(mod.writefd, query.c_str(), query.size()) != (ssize_t)query.size())
+      return false;
+
+    // addr2line flushes after each address when reading from stdin, two lines per query
+    if(fgets(function, bufSize - 1, mod.readf) == NULL ||
+       fgets(fileline, bufSize - 1, mod.readf) == NULL)
+      return false;
+
+    char *nl = strchr(function, '\n');
+    if(nl)
+      *nl = 0;
+    nl = strchr(fileline, '\n');
+    if(nl)
+      *nl = 0;
+
+    return true;
+  }
+
   void EnsureCached(uint64_t addr)
   {
     auto it = m_Cache.insert(
@@ -175,31 +436,56 @@ private:
 
     for(size_t i = 0; i < m_Modules.size(); i++)
     {
-      if(addr >= m_Modules[i].base && addr < m_Modules[i].end)
-      {
-        uint64_t relative = addr - m_Modules[i].base + m_Modules[i].offset;
-        string cmd = StringFormat::Fmt("addr2line -fCe \"%s\" 0x%llx", m_Modules[i].path, relative);
+      Module &mod = m_Modules[i];
 
-        FILE *f = ::popen(cmd.c_str(), "r");
+      if(addr >= mod.info.base && addr < mod.info.end)
+      {
+        uint64_t relative = addr - mod.info.base + mod.info.offset;
 
-        char result[2048] = {0};
-        fread(result, 1, 2047, f);
+        auto cached = mod.resolved.find(relative);
+        if(cached != mod.resolved.end())
+        {
+          ret = cached->second;
+          break;
+        }
 
-        fclose(f);
+        char function[2048] = {0};
+        char fileline[2048] = {0};
 
-        char *line2 = strchr(result, '\n');
-        if(line2)
+        if(!QueryChild(mod, relative, function, fileline, sizeof(function)))
         {
-          *line2 = 0;
-          line2++;
+          // the child died or couldn't spawn, fall back to a one-shot invocation
+          string cmd =
+              StringFormat::Fmt("addr2line -fCe \"%s\" 0x%llx", mod.info.path, relative);
+
+          FILE *f = ::popen(cmd.c_str(), "r");
+
+          char result[2048] = {0};
+          fread(result, 1, 2047, f);
+
+          fclose(f);
+
+          char *line2 = strchr(result, '\n');
+          if(line2)
+          {
+            *line2 = 0;
+            line2++;
+            char *nl = strchr(line2, '\n');
+            if(nl)
+              *nl = 0;
+          }
+
+          memcpy(function, result, sizeof(function));
+          if(line2)
+            memcpy(fileline, line2, strlen(line2) + 1);
         }
 
-        ret.function = result;
+        ret.function = function;
 
-        if(line2)
+        if(fileline[0])
         {
-          char *linenum = line2 + strlen(line2) - 1;
-          while(linenum > line2 && *linenum != ':')
+          char *linenum = fileline + strlen(fileline) - 1;
+          while(linenum > fileline && *linenum != ':')
             linenum--;
 
           ret.line = 0;
@@ -217,15 +503,18 @@ private:
             }
           }
 
-          ret.filename = line2;
+          ret.filename = fileline;
         }
 
+        mod.resolved[relative] = ret;
+        mod.cacheDirty = true;
+
         break;
       }
     }
   }
 
-  std::vector<LookupModule> m_Modules;
+  std::vector<Module> m_Modules;
   std::map<uint64_t, Callstack::AddressDetails> m_Cache;
 };
 
@@ -26,6 +26,7 @@
 #include <string.h>
 #include <algorithm>
 #include <map>
+#include <set>
 #include <string>
 #include "3rdparty/plthook/plthook.h"
 #include "common/threading.h"
@@ -39,6 +40,10 @@ static std::map<std::string, std::vector<FunctionLoadCallback>> libraryCallbacks
 static std::vector<std::string> libraryHooks;
 static std::vector<FunctionHook> functionHooks;
 
+// hooked libraries that we've already seen loaded and fully processed - each one only needs its
+// functions resolved and callbacks fired once, so we don't rescan them on every later dlopen.
+static std::set<std::string> processedLibs;
+
 void *intercept_dlopen(const char *filename, int flag, void *ret);
 void plthook_lib(void *handle);
 
@@ -86,12 +91,35 @@ void plthook_lib(void *handle)
 
   plthook_replace(plthook, "dlopen", (void *)dlopen, NULL);
 
+  // walk the PLT once and look each entry up in a map of our hooks, rather than scanning the
+  // whole PLT once per hook - with hundreds of registered GL/Vulkan hooks the pairwise scan
+  // dominates library load time.
+  std::map<std::string, FunctionHook *> hooksByName;
   for(FunctionHook &hook : functionHooks)
+    hooksByName[hook.function] = &hook;
+
+  unsigned int pos = 0;
+  const char *name = NULL;
+  void **slot = NULL;
+  while(plthook_enum(plthook, &pos, &name, &slot) == 0)
   {
+    std::string function = name;
+
+    // strip any symbol version suffix before matching
+    size_t ver = function.find('@');
+    if(ver != std::string::npos)
+      function.erase(ver);
+
+    auto it = hooksByName.find(function);
+    if(it == hooksByName.end())
+      continue;
+
+    FunctionHook *hook = it->second;
+
     void *orig = NULL;
-    plthook_replace(plthook, hook.function.c_str(), hook.hook, &orig);
-    if(hook.orig && *hook.orig == NULL && orig)
-      *hook.orig = orig;
+    plthook_replace(plthook, name, hook->hook, &orig);
+    if(hook->orig && *hook->orig == NULL && orig)
+      *hook->orig = orig;
   }
 
   plthook_close(plthook);
@@ -108,10 +136,18 @@ static void CheckLoadedLibraries()
   for(auto it = libraryHooks.begin(); it != libraryHooks.end(); ++it)
   {
     std::string libName = *it;
+
+    // skip libraries we've already processed - re-resolving functions against them on every
+    // dlopen in the application adds up to a lot of wasted symbol lookups at startup.
+    if(processedLibs.find(libName) != processedLibs.end())
+      continue;
+
     void *handle = realdlopen(libName.c_str(), RTLD_NOW | RTLD_NOLOAD | RTLD_GLOBAL);
 
     if(handle)
     {
+      processedLibs.insert(libName);
+
       for(FunctionHook &hook : functionHooks)
       {
         if(hook.orig && *hook.orig == NULL)
@@ -153,6 +189,8 @@ void *intercept_dlopen(const char *filename, int flag, void *ret)
     {
       RDCDEBUG("Redirecting dlopen to ourselves for %s", filename);
 
+      processedLibs.insert(libName);
+
       for(FunctionHook &hook : functionHooks)
       {
         if(hook.orig && *hook.orig == NULL)
@@ -32,6 +32,7 @@
 #include <string.h>
 #include <sys/socket.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <sys/un.h>
 #include <unistd.h>
 #include <string>
@@ -195,6 +196,101 @@ bool Socket::SendDataBlocking(const void *buf, uint32_t length)
   return true;
 }
 
+bool Socket::SendDataVectoredBlocking(const SendVec *vecs, uint32_t count)
+{
+  const uint32_t maxVecs = 8;
+
+  if(count > maxVecs)
+  {
+    RDCERR("Too many segments in vectored send: %u", count);
+    return false;
+  }
+
+  iovec iov[maxVecs];
+
+  uint64_t total = 0;
+  uint32_t used = 0;
+
+  for(uint32_t i = 0; i < count; i++)
+  {
+    if(vecs[i].length == 0)
+      continue;
+
+    iov[used].iov_base = (void *)vecs[i].data;
+    iov[used].iov_len = vecs[i].length;
+    total += vecs[i].length;
+    used++;
+  }
+
+  if(used == 0)
+    return true;
+
+  uint64_t sent = 0;
+
+  int flags = fcntl(socket, F_GETFL, 0);
+  fcntl(socket, F_SETFL, flags & ~O_NONBLOCK);
+
+  timeval oldtimeout = {0};
+  socklen_t len = sizeof(oldtimeout);
+  getsockopt(socket, SOL_SOCKET, SO_SNDTIMEO, (char *)&oldtimeout, &len);
+
+  timeval timeout = {0};
+  timeout.tv_sec = (timeoutMS / 1000);
+  timeout.tv_usec = (timeoutMS % 1000) * 1000;
+  setsockopt(socket, SOL_SOCKET, SO_SNDTIMEO, (const char *)&timeout, sizeof(timeout));
+
+  iovec *cur = iov;
+
+  while(sent < total)
+  {
+    ssize_t ret = writev(socket, cur, int(used - uint32_t(cur - iov)));
+
+    if(ret <= 0)
+    {
+      int err = errno;
+
+      if(err == EWOULDBLOCK || err == EAGAIN || err == EINTR)
+      {
+        RDCWARN("Timeout in send");
+        Shutdown();
+        return false;
+      }
+      else
+      {
+        RDCWARN("writev: %s", errno_string(err).c_str());
+        Shutdown();
+        return false;
+      }
+    }
+
+    sent += ret;
+
+    // a short write can end mid-segment - skip fully-sent segments, then trim the partial one
+    uint64_t advance = (uint64_t)ret;
+
+    while(advance > 0 && advance >= cur->iov_len)
+    {
+      advance -= cur->iov_len;
+      cur++;
+    }
+
+    if(advance > 0)
+    {
+      cur->iov_base = (char *)cur->iov_base + advance;
+      cur->iov_len -= (size_t)advance;
+    }
+  }
+
+  flags = fcntl(socket, F_GETFL, 0);
+  fcntl(socket, F_SETFL, flags | O_NONBLOCK);
+
+  setsockopt(socket, SOL_SOCKET, SO_SNDTIMEO, (const char *)&oldtimeout, sizeof(oldtimeout));
+
+  RDCASSERT(sent == total);
+
+  return true;
+}
+
 bool Socket::IsRecvDataWaiting()
 {
   char dummy;
@@ -32,6 +32,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <sys/file.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <time.h>
@@ -473,6 +474,27 @@ bool exists(const char *filename)
   return (res == 0);
 }
 
+byte *MapReadOnly(FILE *f, uint64_t length)
+{
+  int fd = fileno(f);
+
+  if(fd < 0 || length == 0)
+    return NULL;
+
+  void *base = mmap(NULL, (size_t)length, PROT_READ, MAP_PRIVATE, fd, 0);
+
+  if(base == MAP_FAILED)
+    return NULL;
+
+  return (byte *)base;
+}
+
+void ReleaseMapping(byte *base, uint64_t length)
+{
+  if(base)
+    munmap(base, (size_t)length);
+}
+
 static int logfileFD = -1;
 
 // this is used in posix_process.cpp, so that we can close the handle any time that we fork()
@@ -278,6 +278,16 @@ uint64_t GetCurrentID()
   return (uint64_t)pthread_self();
 }
 
+uint32_t NumberOfCores()
+{
+  long ret = sysconf(_SC_NPROCESSORS_ONLN);
+
+  if(ret <= 0)
+    return 1;
+
+  return (uint32_t)ret;
+}
+
 void JoinThread(ThreadHandle handle)
 {
   pthread_join((pthread_t)handle, NULL);
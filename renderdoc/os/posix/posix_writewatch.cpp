@@ -0,0 +1,260 @@
+/******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Baldur Karlsson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include <errno.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "common/threading.h"
+#include "os/os_specific.h"
+
+namespace WriteWatch
+{
+struct TrackedRange
+{
+  // page-aligned start of the tracked range, NULL in unused slots. Set last when publishing a
+  // slot since the signal handler keys off it.
+  byte *base;
+  // page-aligned size
+  size_t size;
+  // one byte per page, set from the signal handler when the page takes its first write
+  volatile byte *dirtyPages;
+};
+
+// fixed-size table so the signal handler can search it without taking any locks. Slots are only
+// modified under trackLock, and only published (or retired) at points where the range can't be
+// taking faults - before it's protected, or after the caller has stopped writing to it.
+static const size_t MaxTrackedRanges = 32;
+static TrackedRange tracked[MaxTrackedRanges];
+
+static Threading::CriticalSection trackLock;
+
+static struct sigaction prevAction;
+static bool handlerInstalled = false;
+static size_t pageSize = 0;
+
+static void WriteWatchHandler(int sig, siginfo_t *info, void *ctx)
+{
+  byte *addr = (byte *)info->si_addr;
+
+  for(size_t i = 0; i < MaxTrackedRanges; i++)
+  {
+    TrackedRange &range = tracked[i];
+
+    byte *base = range.base;
+
+    if(base == NULL || addr < base || addr >= base + range.size)
+      continue;
+
+    size_t page = (size_t)(addr - base) / pageSize;
+    range.dirtyPages[page] = 1;
+
+    // make the page writeable and return to re-run the faulting instruction. mprotect isn't on
+    // the official async-signal-safe list but it's a plain syscall, and this is the established
+    // technique for page-level write barriers.
+    if(mprotect(base + page * pageSize, pageSize, PROT_READ | PROT_WRITE) == 0)
+      return;
+
+    break;
+  }
+
+  // not a fault on memory we're tracking - hand over to whatever handler was installed before us
+  if((prevAction.sa_flags & SA_SIGINFO) && prevAction.sa_sigaction)
+  {
+    prevAction.sa_sigaction(sig, info, ctx);
+    return;
+  }
+
+  if(!(prevAction.sa_flags & SA_SIGINFO) && prevAction.sa_handler != SIG_IGN &&
+     prevAction.sa_handler != SIG_DFL)
+  {
+    prevAction.sa_handler(sig);
+    return;
+  }
+
+  // no previous handler - restore the default and return, the instruction re-faults and the
+  // process dies with the normal crash report.
+  signal(sig, SIG_DFL);
+}
+
+bool StartTracking(void *ptr, size_t size)
+{
+  if(ptr == NULL || size == 0)
+    return false;
+
+  if(pageSize == 0)
+    pageSize = (size_t)sysconf(_SC_PAGESIZE);
+
+  byte *base = (byte *)((uintptr_t)ptr & ~(uintptr_t)(pageSize - 1));
+  byte *end = AlignUpPtr((byte *)ptr + size, pageSize);
+  size_t trackSize = size_t(end - base);
+  size_t numPages = trackSize / pageSize;
+
+  SCOPED_LOCK(trackLock);
+
+  TrackedRange *slot = NULL;
+
+  for(size_t i = 0; i < MaxTrackedRanges; i++)
+  {
+    if(tracked[i].base == NULL)
+    {
+      slot = &tracked[i];
+    }
+    else if(base < tracked[i].base + tracked[i].size && tracked[i].base < end)
+    {
+      // overlapping ranges would fight over protection - leave the existing one alone
+      RDCWARN("Range %p (+%zu) overlaps an already tracked range - not write watching", ptr, size);
+      return false;
+    }
+  }
+
+  if(slot == NULL)
+  {
+    RDCWARN("No free write watch slots - range %p (+%zu) will be fully diffed", ptr, size);
+    return false;
+  }
+
+  if(!handlerInstalled)
+  {
+    struct sigaction act;
+    memset(&act, 0, sizeof(act));
+    act.sa_sigaction = &WriteWatchHandler;
+    act.sa_flags = SA_SIGINFO;
+    sigemptyset(&act.sa_mask);
+
+    if(sigaction(SIGSEGV, &act, &prevAction) != 0)
+    {
+      RDCWARN("Couldn't install SIGSEGV handler for write watching: %s", strerror(errno));
+      return false;
+    }
+
+    handlerInstalled = true;
+  }
+
+  volatile byte *dirtyPages = new byte[numPages];
+  memset((void *)dirtyPages, 0, numPages);
+
+  // publish the slot before protecting the range, so another thread can't fault on it before the
+  // handler can recognise the address.
+  slot->size = trackSize;
+  slot->dirtyPages = dirtyPages;
+  slot->base = base;
+
+  if(mprotect(base, trackSize, PROT_READ) != 0)
+  {
+    // e.g. some driver mappings can't have their protection changed. Fall back to full diffs.
+    RDCWARN("Couldn't write-protect %p (+%zu): %s - range will be fully diffed", ptr, size,
+            strerror(errno));
+
+    slot->base = NULL;
+    slot->size = 0;
+    slot->dirtyPages = NULL;
+    delete[] dirtyPages;
+
+    return false;
+  }
+
+  return true;
+}
+
+static TrackedRange *FindRange(void *ptr)
+{
+  byte *addr = (byte *)ptr;
+
+  for(size_t i = 0; i < MaxTrackedRanges; i++)
+  {
+    if(tracked[i].base && addr >= tracked[i].base && addr < tracked[i].base + tracked[i].size)
+      return &tracked[i];
+  }
+
+  return NULL;
+}
+
+void StopTracking(void *ptr, size_t size)
+{
+  SCOPED_LOCK(trackLock);
+
+  TrackedRange *range = FindRange(ptr);
+
+  if(range == NULL)
+    return;
+
+  mprotect(range->base, range->size, PROT_READ | PROT_WRITE);
+
+  volatile byte *dirtyPages = range->dirtyPages;
+
+  range->base = NULL;
+  range->size = 0;
+  range->dirtyPages = NULL;
+
+  delete[] dirtyPages;
+}
+
+bool GetAndResetDirtyRanges(void *ptr, size_t size, std::vector<DiffRange> &dirty)
+{
+  SCOPED_LOCK(trackLock);
+
+  TrackedRange *range = FindRange(ptr);
+
+  if(range == NULL)
+    return false;
+
+  size_t bias = size_t((byte *)ptr - range->base);
+  size_t numPages = range->size / pageSize;
+
+  for(size_t page = 0; page < numPages;)
+  {
+    if(!range->dirtyPages[page])
+    {
+      page++;
+      continue;
+    }
+
+    size_t runStart = page;
+
+    // clear the flags before re-protecting. A write that lands on a cleared page before the
+    // protection takes effect is already in memory, so the diff the caller is about to do picks
+    // it up - whereas clearing after re-protecting could wipe the record of a genuinely new
+    // write that faulted in between.
+    while(page < numPages && range->dirtyPages[page])
+    {
+      range->dirtyPages[page] = 0;
+      page++;
+    }
+
+    mprotect(range->base + runStart * pageSize, (page - runStart) * pageSize, PROT_READ);
+
+    // clamp the page run to the [ptr, ptr+size) window the caller asked about
+    size_t start = runStart * pageSize > bias ? runStart * pageSize - bias : 0;
+    size_t end = RDCMIN(page * pageSize - bias, size);
+
+    if(start < end)
+      dirty.push_back({start, end});
+  }
+
+  return true;
+}
+
+};    // namespace WriteWatch
@@ -32,6 +32,7 @@
 #include <map>
 #include <set>
 #include <vector>
+#include "api/replay/version.h"
 #include "common/threading.h"
 #include "hooks/hooks.h"
 #include "os/os_specific.h"
@@ -170,6 +171,28 @@ struct CachedHookData
 
   volatile int32_t posthooking = 0;
 
+  // results of previous import table scans, keyed by lowercase module path. Loaded from disk at
+  // startup and saved after the initial hook pass, so repeat launches of the same binaries apply
+  // hooks directly at the cached offsets instead of walking every module's import tables.
+  struct ModuleScan
+  {
+    uint32_t timeDateStamp = 0;
+    uint32_t sizeOfImage = 0;
+
+    struct Location
+    {
+      uint32_t rva;
+      std::string dll;
+      std::string function;
+    };
+
+    std::vector<Location> locations;
+  };
+
+  std::map<std::string, ModuleScan> ModuleScans;
+  Threading::CriticalSection scanlock;
+  bool scansDirty = false;
+
   void ApplyHooks(const char *modName, HMODULE module)
   {
     {
@@ -318,6 +341,71 @@ struct CachedHookData
     PIMAGE_OPTIONAL_HEADER optHeader =
         (PIMAGE_OPTIONAL_HEADER)((BYTE *)fileHeader + sizeof(IMAGE_FILE_HEADER));
 
+    // identify this module's binary on disk - the header timestamp and image size are enough to
+    // tell whether it changed since a previous run, without hashing the file contents.
+    std::string cachekey = strlower(StringFormat::Wide2UTF8(modpath));
+    uint32_t timeDateStamp = fileHeader->TimeDateStamp;
+    uint32_t sizeOfImage = optHeader->SizeOfImage;
+
+    // if a previous scan of this exact binary is cached, apply hooks straight at the recorded
+    // offsets and skip the import table walk. Only complete scans are ever committed, so a hit
+    // is valid even during a missed-ordinals second pass.
+    {
+      bool cached = false;
+      std::vector<ModuleScan::Location> locations;
+
+      {
+        SCOPED_LOCK(scanlock);
+
+        auto scanit = ModuleScans.find(cachekey);
+
+        if(scanit != ModuleScans.end() && scanit->second.timeDateStamp == timeDateStamp &&
+           scanit->second.sizeOfImage == sizeOfImage)
+        {
+          cached = true;
+          locations = scanit->second.locations;
+        }
+      }
+
+      if(cached)
+      {
+#if ENABLED(VERBOSE_DEBUG_HOOK)
+        RDCDEBUG("Applying %zu cached hook locations for %s", locations.size(), modName);
+#endif
+
+        for(const ModuleScan::Location &loc : locations)
+        {
+          auto dllit = DllHooks.find(loc.dll);
+
+          if(dllit == DllHooks.end() || ownmodule == module)
+            continue;
+
+          FunctionHook search(loc.function.c_str(), NULL, NULL);
+
+          auto found = std::lower_bound(dllit->second.FunctionHooks.begin(),
+                                        dllit->second.FunctionHooks.end(), search);
+
+          if(found != dllit->second.FunctionHooks.end() && !(search < *found))
+          {
+            bool already = false;
+            SCOPED_LOCK(lock);
+            ApplyHook(*found, (void **)(baseAddress + loc.rva), already);
+          }
+        }
+
+        FreeLibrary(refcountModHandle);
+        return;
+      }
+    }
+
+    ModuleScan scan;
+    scan.timeDateStamp = timeDateStamp;
+    scan.sizeOfImage = sizeOfImage;
+
+    // set to false if any import couldn't be resolved (e.g. ordinal imports from a dll whose
+    // names we haven't fetched yet) - incomplete scans must not be cached
+    bool scanComplete = true;
+
     DWORD iatOffset = optHeader->DataDirectory[IMAGE_DIRECTORY_ENTRY_IMPORT].VirtualAddress;
 
     IMAGE_IMPORT_DESCRIPTOR *importDesc = (IMAGE_IMPORT_DESCRIPTOR *)(baseAddress + iatOffset);
@@ -335,10 +423,16 @@ struct CachedHookData
 #endif
 
       DllHookset *hookset = NULL;
+      const char *hooksetName = NULL;
 
       for(auto it = DllHooks.begin(); it != DllHooks.end(); ++it)
+      {
         if(!_stricmp(it->first.c_str(), dllName))
+        {
           hookset = &it->second;
+          hooksetName = it->first.c_str();
+        }
+      }
 
       if(hookset && importDesc->OriginalFirstThunk > 0 && importDesc->FirstThunk > 0)
       {
@@ -418,6 +512,9 @@ struct CachedHookData
                       FreeLibrary(refcountModHandle);
                       return;
                     }
+
+                    scan.locations.push_back(ModuleScan::Location{
+                        uint32_t((byte *)IATentry - baseAddress), hooksetName, found->function});
                   }
                 }
               }
@@ -439,6 +536,7 @@ struct CachedHookData
               //
               // Setting this flag causes us to do a second pass right at the start
               missedOrdinals = true;
+              scanComplete = false;
             }
 
             // continue
@@ -481,6 +579,9 @@ struct CachedHookData
               FreeLibrary(refcountModHandle);
               return;
             }
+
+            scan.locations.push_back(ModuleScan::Location{
+                uint32_t((byte *)IATentry - baseAddress), hooksetName, found->function});
           }
 
           origFirst++;
@@ -501,12 +602,214 @@ struct CachedHookData
       importDesc++;
     }
 
+    // the walk ran to completion, so remember it for later passes and for future runs of the same
+    // binary. Most modules commit an empty list here - skipping their rescans is where nearly all
+    // of the time goes.
+    if(scanComplete)
+    {
+      SCOPED_LOCK(scanlock);
+
+      ModuleScans[cachekey] = scan;
+      scansDirty = true;
+    }
+
     FreeLibrary(refcountModHandle);
   }
 };
 
 static CachedHookData *s_HookData = NULL;
 
+// on-disk cache of module scan results, so repeat launches of the same binaries skip the import
+// table walks. Invalidated wholesale when the build changes, since the registered hook set is
+// baked into the code.
+static const char *HookCacheFilename = "hookcache.bin";
+static const uint32_t HookCacheMagic = MAKE_FOURCC('H', 'O', 'O', 'K');
+
+static uint32_t HookCacheVersion()
+{
+  // FNV-1a of the git hash - any new build invalidates the cache
+  uint32_t hash = 0x811c9dc5;
+
+  for(const char *c = GitVersionHash; *c; c++)
+  {
+    hash ^= uint32_t(*c);
+    hash *= 0x01000193;
+  }
+
+  return hash;
+}
+
+static bool ReadCacheBytes(byte *&ptr, int64_t &remaining, void *out, size_t size)
+{
+  if(remaining < (int64_t)size)
+    return false;
+
+  memcpy(out, ptr, size);
+  ptr += size;
+  remaining -= (int64_t)size;
+
+  return true;
+}
+
+static bool ReadCacheString(byte *&ptr, int64_t &remaining, std::string &str)
+{
+  uint32_t len = 0;
+
+  if(!ReadCacheBytes(ptr, remaining, &len, sizeof(len)) || remaining < (int64_t)len)
+    return false;
+
+  str.assign((const char *)ptr, len);
+  ptr += len;
+  remaining -= (int64_t)len;
+
+  return true;
+}
+
+static void WriteCacheString(FILE *f, const std::string &str)
+{
+  uint32_t len = (uint32_t)str.size();
+  FileIO::fwrite(&len, 1, sizeof(len), f);
+  FileIO::fwrite(str.c_str(), 1, len, f);
+}
+
+static void LoadHookCache()
+{
+  string cachefile = FileIO::GetAppFolderFilename(HookCacheFilename);
+
+  FILE *f = FileIO::fopen(cachefile.c_str(), "rb");
+
+  if(!f)
+    return;
+
+  FileIO::fseek64(f, 0, SEEK_END);
+  uint64_t cachelen = FileIO::ftell64(f);
+  FileIO::fseek64(f, 0, SEEK_SET);
+
+  // header: magic number, file version, number of entries
+  if(cachelen < sizeof(uint32_t) * 3)
+  {
+    RDCERR("Invalid hook cache");
+    FileIO::fclose(f);
+    return;
+  }
+
+  byte *cache = new byte[(size_t)cachelen];
+  FileIO::fread(cache, 1, (size_t)cachelen, f);
+  FileIO::fclose(f);
+
+  byte *ptr = cache;
+  int64_t remaining = (int64_t)cachelen;
+
+  uint32_t fileMagic = 0, fileVer = 0, numentries = 0;
+
+  ReadCacheBytes(ptr, remaining, &fileMagic, sizeof(fileMagic));
+  ReadCacheBytes(ptr, remaining, &fileVer, sizeof(fileVer));
+  ReadCacheBytes(ptr, remaining, &numentries, sizeof(numentries));
+
+  if(fileMagic != HookCacheMagic || fileVer != HookCacheVersion())
+  {
+    RDCDEBUG("Out of date or invalid hook cache magic: %x version: %x", fileMagic, fileVer);
+    delete[] cache;
+    return;
+  }
+
+  bool ok = true;
+
+  for(uint32_t i = 0; i < numentries && ok; i++)
+  {
+    std::string key;
+    CachedHookData::ModuleScan scan;
+    uint32_t numlocs = 0;
+
+    ok = ok && ReadCacheString(ptr, remaining, key);
+    ok = ok && ReadCacheBytes(ptr, remaining, &scan.timeDateStamp, sizeof(scan.timeDateStamp));
+    ok = ok && ReadCacheBytes(ptr, remaining, &scan.sizeOfImage, sizeof(scan.sizeOfImage));
+    ok = ok && ReadCacheBytes(ptr, remaining, &numlocs, sizeof(numlocs));
+
+    // each location is at least 12 bytes (rva and two string lengths)
+    if(ok && numlocs > uint32_t(remaining / 12))
+      ok = false;
+
+    for(uint32_t l = 0; l < numlocs && ok; l++)
+    {
+      CachedHookData::ModuleScan::Location loc;
+
+      ok = ok && ReadCacheBytes(ptr, remaining, &loc.rva, sizeof(loc.rva));
+      ok = ok && ReadCacheString(ptr, remaining, loc.dll);
+      ok = ok && ReadCacheString(ptr, remaining, loc.function);
+
+      if(ok)
+        scan.locations.push_back(loc);
+    }
+
+    if(ok)
+      s_HookData->ModuleScans[key] = scan;
+  }
+
+  if(!ok)
+  {
+    RDCERR("Invalid hook cache - truncated");
+    s_HookData->ModuleScans.clear();
+  }
+  else
+  {
+    RDCDEBUG("Loaded %zu module scans from hook cache", s_HookData->ModuleScans.size());
+  }
+
+  delete[] cache;
+}
+
+static void SaveHookCache()
+{
+  SCOPED_LOCK(s_HookData->scanlock);
+
+  if(!s_HookData->scansDirty)
+    return;
+
+  string cachefile = FileIO::GetAppFolderFilename(HookCacheFilename);
+
+  FILE *f = FileIO::fopen(cachefile.c_str(), "wb");
+
+  if(!f)
+  {
+    RDCERR("Error opening hook cache for write");
+    return;
+  }
+
+  uint32_t magic = HookCacheMagic;
+  uint32_t version = HookCacheVersion();
+  uint32_t numentries = (uint32_t)s_HookData->ModuleScans.size();
+
+  FileIO::fwrite(&magic, 1, sizeof(magic), f);
+  FileIO::fwrite(&version, 1, sizeof(version), f);
+  FileIO::fwrite(&numentries, 1, sizeof(numentries), f);
+
+  for(auto it = s_HookData->ModuleScans.begin(); it != s_HookData->ModuleScans.end(); ++it)
+  {
+    const CachedHookData::ModuleScan &scan = it->second;
+
+    WriteCacheString(f, it->first);
+    FileIO::fwrite(&scan.timeDateStamp, 1, sizeof(scan.timeDateStamp), f);
+    FileIO::fwrite(&scan.sizeOfImage, 1, sizeof(scan.sizeOfImage), f);
+
+    uint32_t numlocs = (uint32_t)scan.locations.size();
+    FileIO::fwrite(&numlocs, 1, sizeof(numlocs), f);
+
+    for(const CachedHookData::ModuleScan::Location &loc : scan.locations)
+    {
+      FileIO::fwrite(&loc.rva, 1, sizeof(loc.rva), f);
+      WriteCacheString(f, loc.dll);
+      WriteCacheString(f, loc.function);
+    }
+  }
+
+  FileIO::fclose(f);
+
+  s_HookData->scansDirty = false;
+
+  RDCDEBUG("Saved %u module scans to hook cache", numentries);
+}
+
 #ifdef UNICODE
 #undef MODULEENTRY32
 #undef Module32First
@@ -883,6 +1186,8 @@ void LibraryHooks::BeginHookRegistration()
   GetModuleHandleEx(
       GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
       (LPCTSTR)&s_HookData, &s_HookData->ownmodule);
+
+  LoadHookCache();
 }
 
 // hook all functions for currently loaded modules.
@@ -910,6 +1215,10 @@ void LibraryHooks::EndHookRegistration()
 
     s_HookData->missedOrdinals = false;
   }
+
+  // persist the scans from the initial pass. Modules loaded later still get scanned and cached in
+  // memory, but only the startup set - the expensive one - is written to disk.
+  SaveHookCache();
 }
 
 void LibraryHooks::Refresh()
@@ -232,6 +232,100 @@ bool Socket::SendDataBlocking(const void *buf, uint32_t length)
   return true;
 }
 
+bool Socket::SendDataVectoredBlocking(const SendVec *vecs, uint32_t count)
+{
+  const uint32_t maxVecs = 8;
+
+  if(count > maxVecs)
+  {
+    RDCERR("Too many segments in vectored send: %u", count);
+    return false;
+  }
+
+  WSABUF bufs[maxVecs];
+
+  uint64_t total = 0;
+  uint32_t used = 0;
+
+  for(uint32_t i = 0; i < count; i++)
+  {
+    if(vecs[i].length == 0)
+      continue;
+
+    bufs[used].buf = (char *)vecs[i].data;
+    bufs[used].len = vecs[i].length;
+    total += vecs[i].length;
+    used++;
+  }
+
+  if(used == 0)
+    return true;
+
+  uint64_t sent = 0;
+
+  u_long enable = 0;
+  ioctlsocket(socket, FIONBIO, &enable);
+
+  DWORD oldtimeout = 0;
+  int len = sizeof(oldtimeout);
+  getsockopt(socket, SOL_SOCKET, SO_SNDTIMEO, (char *)&oldtimeout, &len);
+
+  DWORD timeout = timeoutMS;
+  setsockopt(socket, SOL_SOCKET, SO_SNDTIMEO, (const char *)&timeout, sizeof(timeout));
+
+  WSABUF *cur = bufs;
+
+  while(sent < total)
+  {
+    DWORD ret = 0;
+    int res = WSASend(socket, cur, DWORD(used - uint32_t(cur - bufs)), &ret, 0, NULL, NULL);
+
+    if(res == SOCKET_ERROR || ret == 0)
+    {
+      int err = WSAGetLastError();
+
+      if(err == WSAEWOULDBLOCK || err == WSAETIMEDOUT)
+      {
+        RDCWARN("Timeout in send");
+        Shutdown();
+        return false;
+      }
+      else
+      {
+        RDCWARN("WSASend: %s", wsaerr_string(err).c_str());
+        Shutdown();
+        return false;
+      }
+    }
+
+    sent += ret;
+
+    // a short write can end mid-segment - skip fully-sent segments, then trim the partial one
+    uint64_t advance = (uint64_t)ret;
+
+    while(advance > 0 && advance >= cur->len)
+    {
+      advance -= cur->len;
+      cur++;
+    }
+
+    if(advance > 0)
+    {
+      cur->buf += advance;
+      cur->len -= (ULONG)advance;
+    }
+  }
+
+  enable = 1;
+  ioctlsocket(socket, FIONBIO, &enable);
+
+  setsockopt(socket, SOL_SOCKET, SO_SNDTIMEO, (const char *)&oldtimeout, sizeof(oldtimeout));
+
+  RDCASSERT(sent == total);
+
+  return true;
+}
+
 bool Socket::IsRecvDataWaiting()
 {
   char dummy;
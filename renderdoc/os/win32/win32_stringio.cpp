@@ -663,6 +663,32 @@ int fclose(FILE *f)
   return ::fclose(f);
 }
 
+byte *MapReadOnly(FILE *f, uint64_t length)
+{
+  HANDLE file = (HANDLE)_get_osfhandle(::_fileno(f));
+
+  if(file == INVALID_HANDLE_VALUE || length == 0)
+    return NULL;
+
+  HANDLE mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+
+  if(mapping == NULL)
+    return NULL;
+
+  byte *base = (byte *)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, (SIZE_T)length);
+
+  // the view holds a reference on the mapping object, so we don't need to keep the handle around
+  CloseHandle(mapping);
+
+  return base;
+}
+
+void ReleaseMapping(byte *base, uint64_t length)
+{
+  if(base)
+    UnmapViewOfFile(base);
+}
+
 static HANDLE logHandle = NULL;
 
 bool logfile_open(const char *filename)
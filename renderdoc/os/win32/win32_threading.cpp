@@ -266,6 +266,17 @@ uint64_t GetCurrentID()
   return (uint64_t)::GetCurrentThreadId();
 }
 
+uint32_t NumberOfCores()
+{
+  SYSTEM_INFO sysInfo = {};
+  GetSystemInfo(&sysInfo);
+
+  if(sysInfo.dwNumberOfProcessors == 0)
+    return 1;
+
+  return (uint32_t)sysInfo.dwNumberOfProcessors;
+}
+
 void JoinThread(ThreadHandle handle)
 {
   if(handle == 0)
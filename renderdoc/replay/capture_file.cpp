@@ -176,12 +176,22 @@ public:
 private:
   ReplayStatus Init();
 
-  void InitStructuredData(RENDERDOC_ProgressCallback progress = RENDERDOC_ProgressCallback());
+  void InitStructuredData(RENDERDOC_ProgressCallback progress = RENDERDOC_ProgressCallback(),
+                          bool includeBuffers = true);
+
+  void ReleaseStructuredData()
+  {
+    SDFile empty;
+    m_StructuredData.Swap(empty);
+    m_StructuredBuffers = false;
+  }
 
   RDCFile *m_RDC = NULL;
   Callstack::StackResolver *m_Resolver = NULL;
 
   SDFile m_StructuredData;
+  // whether m_StructuredData was decompiled including the buffer contents
+  bool m_StructuredBuffers = false;
 
   std::string m_DriverName, m_Ident, m_ErrorString;
   ReplaySupport m_Support = ReplaySupport::Unsupported;
@@ -335,8 +345,14 @@ ReplayStatus CaptureFile::Init()
   return ReplayStatus::InternalError;
 }
 
-void CaptureFile::InitStructuredData(RENDERDOC_ProgressCallback progress /*= RENDERDOC_ProgressCallback()*/)
+void CaptureFile::InitStructuredData(RENDERDOC_ProgressCallback progress /*= RENDERDOC_ProgressCallback()*/,
+                                     bool includeBuffers /*= true*/)
 {
+  // if a previous decompilation skipped the buffer contents and they're wanted now, throw it away
+  // and start again.
+  if(!m_StructuredData.chunks.empty() && includeBuffers && !m_StructuredBuffers)
+    ReleaseStructuredData();
+
   if(m_StructuredData.chunks.empty() && m_RDC && m_RDC->SectionIndex(SectionType::FrameCapture) >= 0)
   {
     StructuredProcessor proc = RenderDoc::Inst().GetStructuredProcessor(m_RDC->GetDriver());
@@ -344,11 +360,13 @@ void CaptureFile::InitStructuredData(RENDERDOC_ProgressCallback progress /*= REN
     RenderDoc::Inst().SetProgressCallback<LoadProgress>(progress);
 
     if(proc)
-      proc(m_RDC, m_StructuredData);
+      proc(m_RDC, m_StructuredData, includeBuffers);
     else
       RDCERR("Can't get structured data for driver %s", m_RDC->GetDriverName().c_str());
 
     RenderDoc::Inst().SetProgressCallback<LoadProgress>(RENDERDOC_ProgressCallback());
+
+    m_StructuredBuffers = includeBuffers;
   }
 }
 
@@ -427,15 +445,34 @@ ReplayStatus CaptureFile::Convert(const char *filename, const char *filetype, co
   if(exporter)
   {
     if(file)
-    {
       return exporter(filename, *m_RDC, *file, exportProgress);
-    }
-    else
-    {
-      InitStructuredData(fetchProgress);
 
-      return exporter(filename, *m_RDC, GetStructuredData(), exportProgress);
+    // formats that only consume the chunk tree (e.g. timing exports) don't need the buffer
+    // contents, which are the bulk of the memory for large captures - skip decompiling them.
+    bool buffersRequired = true;
+
+    for(const CaptureFileFormat &fmt : RenderDoc::Inst().GetCaptureFileFormats())
+    {
+      if(fmt.extension == filetype)
+      {
+        buffersRequired = fmt.requiresBuffers;
+        break;
+      }
     }
+
+    // if the structured data is being decompiled just for this conversion, release it again
+    // afterwards rather than leaving it cached on this file - for large captures it can dwarf
+    // everything else in the process, and it can always be decompiled again on demand.
+    bool transient = m_StructuredData.chunks.empty();
+
+    InitStructuredData(fetchProgress, buffersRequired);
+
+    ReplayStatus status = exporter(filename, *m_RDC, m_StructuredData, exportProgress);
+
+    if(transient)
+      ReleaseStructuredData();
+
+    return status;
   }
 
   if(filetype != NULL && strcmp(filetype, "") && strcmp(filetype, "rdc"))
@@ -466,8 +503,11 @@ ReplayStatus CaptureFile::Convert(const char *filename, const char *filetype, co
 
   if(frameCaptureIndex == -1)
   {
+    bool transient = false;
+
     if(file == NULL)
     {
+      transient = m_StructuredData.chunks.empty();
       InitStructuredData(fetchProgress);
       file = &m_StructuredData;
     }
@@ -489,6 +529,13 @@ ReplayStatus CaptureFile::Convert(const char *filename, const char *filetype, co
     success = success && !writer->IsErrored();
 
     delete writer;
+
+    // as above, don't keep structured data cached that was only decompiled for this conversion
+    if(transient)
+    {
+      file = NULL;
+      ReleaseStructuredData();
+    }
   }
   else
   {
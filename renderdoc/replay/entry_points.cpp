@@ -31,6 +31,7 @@
 #include "maths/camera.h"
 #include "maths/formatpacking.h"
 #include "miniz/miniz.h"
+#include "serialise/rdcfile.h"
 #include "strings/string_utils.h"
 
 // these entry points are for the replay/analysis side - not for the application.
@@ -405,28 +406,55 @@ extern "C" RENDERDOC_API uint32_t RENDERDOC_CC RENDERDOC_EnumerateRemoteTargets(
     s = "127.0.0.1";
   }
 
-  for(; nextIdent <= lastIdent; nextIdent++)
+  if(nextIdent > lastIdent)
+    return 0;
+
+  // probe all remaining ports concurrently. The common case is that most ports have nothing
+  // listening, and sequentially each dead port costs a full connect timeout - scanning in
+  // parallel makes the whole range cost one timeout rather than one per port.
+  uint32_t numPorts = lastIdent - nextIdent + 1;
+
+  std::vector<uint32_t> alive(numPorts, 0);
+  std::vector<Threading::ThreadHandle> threads(numPorts);
+
+  for(uint32_t i = 0; i < numPorts; i++)
   {
-    Network::Socket *sock = Network::CreateClientSocket(s.c_str(), (uint16_t)nextIdent, 250);
+    uint32_t port = nextIdent + i;
+
+    threads[i] = Threading::CreateThread([&s, &alive, i, port, isAndroid]() {
+      Network::Socket *sock = Network::CreateClientSocket(s.c_str(), (uint16_t)port, 250);
+
+      if(!sock)
+        return;
 
-    if(sock)
-    {
       if(isAndroid)
       {
+        // on android the forwarded port accepts connections even when no target is listening
+        // behind it on the device, so check the connection is still alive before reporting it.
         Threading::Sleep(100);
         (void)sock->IsRecvDataWaiting();
         if(!sock->Connected())
         {
           SAFE_DELETE(sock);
-          return 0;
+          return;
         }
       }
 
+      alive[i] = 1;
       SAFE_DELETE(sock);
-      return nextIdent;
-    }
+    });
   }
 
+  for(uint32_t i = 0; i < numPorts; i++)
+  {
+    Threading::JoinThread(threads[i]);
+    Threading::CloseThread(threads[i]);
+  }
+
+  for(uint32_t i = 0; i < numPorts; i++)
+    if(alive[i])
+      return nextIdent + i;
+
   // tried all idents remaining and found nothing
   return 0;
 }
@@ -460,6 +488,67 @@ extern "C" RENDERDOC_API void RENDERDOC_CC RENDERDOC_BecomeRemoteServer(
   RenderDoc::Inst().BecomeRemoteServer(listenhost, (uint16_t)port, killReplay, previewWindow);
 }
 
+extern "C" RENDERDOC_API void RENDERDOC_CC RENDERDOC_BecomeReplayDaemon(
+    const char *listenhost, uint32_t port, const char *capturefile,
+    RENDERDOC_KillCallback killReplay, RENDERDOC_PreviewWindowCallback previewWindow)
+{
+  // only listen locally by default - a daemon exists to serve batches of analysis scripts on the
+  // same machine, not to replace a fully-fledged remote server.
+  if(listenhost == NULL || listenhost[0] == 0)
+    listenhost = "localhost";
+
+  if(!killReplay)
+    killReplay = []() { return false; };
+
+  if(!previewWindow)
+    previewWindow = [](bool, const rdcarray<WindowingSystem> &) {
+      WindowingData ret = {WindowingSystem::Unknown};
+      return ret;
+    };
+
+  if(port == 0)
+    port = RENDERDOC_GetDefaultRemoteServerPort();
+
+  RenderDoc::Inst().BecomeRemoteServer(listenhost, (uint16_t)port, killReplay, previewWindow,
+                                       capturefile);
+}
+
+static ReplayStatus ContainerError2ReplayStatus(ContainerError err)
+{
+  switch(err)
+  {
+    case ContainerError::NoError: return ReplayStatus::Succeeded;
+    case ContainerError::FileNotFound: return ReplayStatus::FileNotFound;
+    case ContainerError::FileIO: return ReplayStatus::FileIOFailed;
+    case ContainerError::Corrupt: return ReplayStatus::FileCorrupted;
+    case ContainerError::UnsupportedVersion: return ReplayStatus::FileIncompatibleVersion;
+  }
+
+  return ReplayStatus::InternalError;
+}
+
+extern "C" RENDERDOC_API ReplayStatus RENDERDOC_CC RENDERDOC_PackCaptureFile(const char *infile,
+                                                                             const char *packfile,
+                                                                             const char *blobdir)
+{
+  if(infile == NULL || packfile == NULL || blobdir == NULL || infile[0] == 0 || packfile[0] == 0 ||
+     blobdir[0] == 0)
+    return ReplayStatus::InternalError;
+
+  return ContainerError2ReplayStatus(PackRDC(infile, packfile, blobdir));
+}
+
+extern "C" RENDERDOC_API ReplayStatus RENDERDOC_CC RENDERDOC_UnpackCaptureFile(const char *packfile,
+                                                                               const char *outfile,
+                                                                               const char *blobdir)
+{
+  if(packfile == NULL || outfile == NULL || blobdir == NULL || packfile[0] == 0 ||
+     outfile[0] == 0 || blobdir[0] == 0)
+    return ReplayStatus::InternalError;
+
+  return ContainerError2ReplayStatus(UnpackRDC(packfile, outfile, blobdir));
+}
+
 extern "C" RENDERDOC_API void RENDERDOC_CC RENDERDOC_StartSelfHostCapture(const char *dllname)
 {
   void *module = Process::LoadModule(dllname);
@@ -378,10 +378,11 @@ void DoSerialise(SerialiserType &ser, ShaderDebugState &el)
   SERIALISE_MEMBER(indexableTemps);
   SERIALISE_MEMBER(locals);
   SERIALISE_MEMBER(modified);
+  SERIALISE_MEMBER(partialLocations);
   SERIALISE_MEMBER(nextInstruction);
   SERIALISE_MEMBER(flags);
 
-  SIZE_CHECK(128);
+  SIZE_CHECK(152);
 }
 
 template <typename SerialiserType>
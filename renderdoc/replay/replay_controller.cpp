@@ -26,7 +26,9 @@
 #include "replay_controller.h"
 #include <string.h>
 #include <time.h>
+#include <algorithm>
 #include "common/dds_readwrite.h"
+#include "common/threading.h"
 #include "driver/ihv/amd/amd_isa.h"
 #include "driver/ihv/amd/amd_rgp.h"
 #include "jpeg-compressor/jpgd.h"
@@ -40,130 +42,6 @@
 #include "strings/string_utils.h"
 #include "tinyexr/tinyexr.h"
 
-float ConvertComponent(const ResourceFormat &fmt, const byte *data)
-{
-  if(fmt.compByteWidth == 8)
-  {
-    // we just downcast
-    const uint64_t *u64 = (const uint64_t *)data;
-    const int64_t *i64 = (const int64_t *)data;
-
-    if(fmt.compType == CompType::Double || fmt.compType == CompType::Float)
-    {
-      return float(*(const double *)u64);
-    }
-    else if(fmt.compType == CompType::UInt || fmt.compType == CompType::UScaled)
-    {
-      return float(*u64);
-    }
-    else if(fmt.compType == CompType::SInt || fmt.compType == CompType::SScaled)
-    {
-      return float(*i64);
-    }
-  }
-  else if(fmt.compByteWidth == 4)
-  {
-    const uint32_t *u32 = (const uint32_t *)data;
-    const int32_t *i32 = (const int32_t *)data;
-
-    if(fmt.compType == CompType::Float || fmt.compType == CompType::Depth)
-    {
-      return *(const float *)u32;
-    }
-    else if(fmt.compType == CompType::UInt || fmt.compType == CompType::UScaled)
-    {
-      return float(*u32);
-    }
-    else if(fmt.compType == CompType::SInt || fmt.compType == CompType::SScaled)
-    {
-      return float(*i32);
-    }
-  }
-  else if(fmt.compByteWidth == 3 && fmt.compType == CompType::Depth)
-  {
-    // 24-bit depth is a weird edge case we need to assemble it by hand
-    const uint8_t *u8 = (const uint8_t *)data;
-
-    uint32_t depth = 0;
-    depth |= uint32_t(u8[1]);
-    depth |= uint32_t(u8[2]) << 8;
-    depth |= uint32_t(u8[3]) << 16;
-
-    return float(depth) / float(16777215.0f);
-  }
-  else if(fmt.compByteWidth == 2)
-  {
-    const uint16_t *u16 = (const uint16_t *)data;
-    const int16_t *i16 = (const int16_t *)data;
-
-    if(fmt.compType == CompType::Float)
-    {
-      return ConvertFromHalf(*u16);
-    }
-    else if(fmt.compType == CompType::UInt || fmt.compType == CompType::UScaled)
-    {
-      return float(*u16);
-    }
-    else if(fmt.compType == CompType::SInt || fmt.compType == CompType::SScaled)
-    {
-      return float(*i16);
-    }
-    // 16-bit depth is UNORM
-    else if(fmt.compType == CompType::UNorm || fmt.compType == CompType::Depth)
-    {
-      return float(*u16) / 65535.0f;
-    }
-    else if(fmt.compType == CompType::SNorm)
-    {
-      float f = -1.0f;
-
-      if(*i16 == -32768)
-        f = -1.0f;
-      else
-        f = ((float)*i16) / 32767.0f;
-
-      return f;
-    }
-  }
-  else if(fmt.compByteWidth == 1)
-  {
-    const uint8_t *u8 = (const uint8_t *)data;
-    const int8_t *i8 = (const int8_t *)data;
-
-    if(fmt.compType == CompType::UInt || fmt.compType == CompType::UScaled)
-    {
-      return float(*u8);
-    }
-    else if(fmt.compType == CompType::SInt || fmt.compType == CompType::SScaled)
-    {
-      return float(*i8);
-    }
-    else if(fmt.compType == CompType::UNormSRGB)
-    {
-      return SRGB8_lookuptable[*u8];
-    }
-    else if(fmt.compType == CompType::UNorm)
-    {
-      return float(*u8) / 255.0f;
-    }
-    else if(fmt.compType == CompType::SNorm)
-    {
-      float f = -1.0f;
-
-      if(*i8 == -128)
-        f = -1.0f;
-      else
-        f = ((float)*i8) / 127.0f;
-
-      return f;
-    }
-  }
-
-  RDCERR("Unexpected format to convert from %u %u", fmt.compByteWidth, fmt.compType);
-
-  return 0.0f;
-}
-
 static void fileWriteFunc(void *context, void *data, int size)
 {
   FileIO::fwrite(data, 1, size, (FILE *)context);
@@ -201,6 +79,7 @@ ReplayController::~ReplayController()
     m_pDevice->FreeCustomShader(*it);
 
   m_CustomShaders.clear();
+  m_CustomShaderCache.clear();
 
   for(auto it = m_TargetResources.begin(); it != m_TargetResources.end(); ++it)
     m_pDevice->FreeTargetResource(*it);
@@ -220,6 +99,8 @@ void ReplayController::SetFrameEvent(uint32_t eventId, bool force)
   {
     m_EventID = eventId;
 
+    m_CBufferCache.clear();
+
     m_pDevice->ReplayLog(eventId, eReplay_WithoutDraw);
 
     for(size_t i = 0; i < m_Outputs.size(); i++)
@@ -231,6 +112,21 @@ void ReplayController::SetFrameEvent(uint32_t eventId, bool force)
   }
 }
 
+void ReplayController::PrefetchFrameEvent(uint32_t eventId)
+{
+  CHECK_REPLAY_THREAD();
+
+  if(eventId == m_EventID)
+    return;
+
+  // replay to the event and straight back again. Nothing observable changes - the outputs and
+  // pipeline state stay on the current event, so this is safe to run in the background while the
+  // UI reads cached state - but it warms any replay-side caches with the prefetched event's
+  // work, making a later SetFrameEvent there cheaper.
+  m_pDevice->ReplayLog(eventId, eReplay_Full);
+  m_pDevice->ReplayLog(m_EventID, eReplay_Full);
+}
+
 const D3D11Pipe::State *ReplayController::GetD3D11PipelineState()
 {
   CHECK_REPLAY_THREAD();
@@ -539,9 +435,28 @@ rdcarray<CounterResult> ReplayController::FetchCounters(const rdcarray<GPUCounte
 {
   CHECK_REPLAY_THREAD();
 
+  // a request for just the GPU duration counter - what timeline and event browser heat displays
+  // issue - can be answered from the capture's baked section with no replay passes at all.
+  if(m_HaveGPUDurations && counters.size() == 1 && counters[0] == GPUCounter::EventGPUDuration)
+  {
+    rdcarray<CounterResult> ret;
+    ret.reserve(m_GPUDurations.size());
+
+    for(auto it = m_GPUDurations.begin(); it != m_GPUDurations.end(); ++it)
+      ret.push_back(CounterResult(it->first, GPUCounter::EventGPUDuration, it->second));
+
+    return ret;
+  }
+
   std::vector<GPUCounter> counterArray(counters.begin(), counters.end());
 
-  return m_pDevice->FetchCounters(counterArray);
+  rdcarray<CounterResult> ret = m_pDevice->FetchCounters(counterArray);
+
+  // persist freshly measured durations so later opens of this capture get them for free
+  if(!m_HaveGPUDurations && counters.contains(GPUCounter::EventGPUDuration))
+    BakeGPUDurations(ret);
+
+  return ret;
 }
 
 rdcarray<GPUCounter> ReplayController::EnumerateCounters()
@@ -604,10 +519,17 @@ rdcarray<EventUsage> ReplayController::GetUsage(ResourceId id)
 {
   CHECK_REPLAY_THREAD();
 
-  id = m_pDevice->GetLiveID(id);
-  if(id == ResourceId())
+  auto it = m_UsageCache.find(id);
+  if(it != m_UsageCache.end())
+    return it->second;
+
+  ResourceId liveid = m_pDevice->GetLiveID(id);
+  if(liveid == ResourceId())
     return rdcarray<EventUsage>();
-  return m_pDevice->GetUsage(id);
+
+  rdcarray<EventUsage> &usage = m_UsageCache[id];
+  usage = m_pDevice->GetUsage(liveid);
+  return usage;
 }
 
 MeshFormat ReplayController::GetPostVSData(uint32_t instID, uint32_t viewID, MeshDataStage stage)
@@ -630,44 +552,127 @@ MeshFormat ReplayController::GetPostVSData(uint32_t instID, uint32_t viewID, Mes
 }
 
 bytebuf ReplayController::GetBufferData(ResourceId buff, uint64_t offset, uint64_t len)
+{
+  bytebuf retData;
+  GetBufferData(buff, offset, len, retData);
+  return retData;
+}
+
+void ReplayController::GetBufferData(ResourceId buff, uint64_t offset, uint64_t len, bytebuf &data)
 {
   CHECK_REPLAY_THREAD();
 
-  bytebuf retData;
+  // empty any stale contents, but deliberately don't free the allocation - repeated fetches into
+  // the same buffer re-use it.
+  data.clear();
 
   if(buff == ResourceId())
-    return retData;
+    return;
 
   ResourceId liveId = m_pDevice->GetLiveID(buff);
 
   if(liveId == ResourceId())
   {
     RDCERR("Couldn't get Live ID for %llu getting buffer data", buff);
-    return retData;
+    return;
   }
 
-  m_pDevice->GetBufferData(liveId, offset, len, retData);
-
-  return retData;
+  m_pDevice->GetBufferData(liveId, offset, len, data);
 }
 
 bytebuf ReplayController::GetTextureData(ResourceId tex, uint32_t arrayIdx, uint32_t mip)
+{
+  bytebuf ret;
+  GetTextureData(tex, arrayIdx, mip, ret);
+  return ret;
+}
+
+void ReplayController::GetTextureData(ResourceId tex, uint32_t arrayIdx, uint32_t mip,
+                                      bytebuf &data)
 {
   CHECK_REPLAY_THREAD();
 
-  bytebuf ret;
+  data.clear();
 
   ResourceId liveId = m_pDevice->GetLiveID(tex);
 
   if(liveId == ResourceId())
   {
     RDCERR("Couldn't get Live ID for %llu getting texture data", tex);
-    return ret;
+    return;
   }
 
-  m_pDevice->GetTextureData(liveId, arrayIdx, mip, GetTextureDataParams(), ret);
+  m_pDevice->GetTextureData(liveId, arrayIdx, mip, GetTextureDataParams(), data);
+}
 
-  return ret;
+rdcarray<uint32_t> ReplayController::SaveTextureAtEvents(const TextureSave &saveData,
+                                                         const rdcarray<uint32_t> &eventIds,
+                                                         const rdcarray<rdcstr> &paths)
+{
+  CHECK_REPLAY_THREAD();
+
+  rdcarray<uint32_t> failed;
+
+  if(eventIds.size() != paths.size())
+  {
+    RDCERR("Mismatched arrays saving textures: %zu events, %zu paths", eventIds.size(),
+           paths.size());
+    failed = eventIds;
+    return failed;
+  }
+
+  // visit the events in ascending order regardless of the order passed in - stepping to a later
+  // event replays incrementally from the current one, where every backwards jump pays a full
+  // replay from the start of the frame.
+  std::vector<size_t> order;
+  order.resize(eventIds.size());
+  for(size_t i = 0; i < order.size(); i++)
+    order[i] = i;
+  std::sort(order.begin(), order.end(),
+            [&eventIds](size_t a, size_t b) { return eventIds[a] < eventIds[b]; });
+
+  for(size_t i : order)
+  {
+    uint32_t eventId = eventIds[i];
+
+    SetFrameEvent(eventId, false);
+
+    TextureSave sd = saveData;
+
+    // with no texture specified, save the event's first bound output - the common case for
+    // scripts exporting framebuffer images for visual diffing.
+    if(sd.resourceId == ResourceId())
+    {
+      DrawcallDescription *draw = GetDrawcallByEID(eventId);
+
+      if(draw)
+      {
+        for(ResourceId out : draw->outputs)
+        {
+          if(out != ResourceId())
+          {
+            sd.resourceId = out;
+            break;
+          }
+        }
+
+        if(sd.resourceId == ResourceId())
+          sd.resourceId = draw->depthOut;
+      }
+
+      if(sd.resourceId == ResourceId())
+      {
+        RDCWARN("No bound output to save at event %u", eventId);
+        failed.push_back(eventId);
+        continue;
+      }
+    }
+
+    if(!SaveTexture(sd, paths[i].c_str()))
+      failed.push_back(eventId);
+  }
+
+  return failed;
 }
 
 bool ReplayController::SaveTexture(const TextureSave &saveData, const char *path)
@@ -1366,7 +1371,7 @@ bool ReplayController::SaveTexture(const TextureSave &saveData, const char *path
         abgr[3] = new float[td.width * td.height];
       }
 
-      byte *srcData = subdata[0];
+      byte *srcBase = subdata[0];
 
       ResourceFormat saveFmt = td.format;
       if(saveFmt.compType == CompType::Typeless)
@@ -1380,105 +1385,102 @@ bool ReplayController::SaveTexture(const TextureSave &saveData, const char *path
       if(saveFmt.compType == CompType::Depth && pixStride == 3)
         pixStride = 4;
 
-      for(uint32_t y = 0; y < td.height; y++)
-      {
-        for(uint32_t x = 0; x < td.width; x++)
-        {
-          float r = 0.0f;
-          float g = 0.0f;
-          float b = 0.0f;
-          float a = 1.0f;
+      // the packed formats consume 4 bytes per pixel regardless of pixStride
+      uint32_t texelStride = pixStride;
+      if(saveFmt.type == ResourceFormatType::R10G10B10A2 ||
+         saveFmt.type == ResourceFormatType::R11G11B10)
+        texelStride = 4;
 
-          if(saveFmt.type == ResourceFormatType::R10G10B10A2)
-          {
-            uint32_t *u32 = (uint32_t *)srcData;
-
-            Vec4f vec = ConvertFromR10G10B10A2(*u32);
-
-            r = vec.x;
-            g = vec.y;
-            b = vec.z;
-            a = vec.w;
-
-            srcData += 4;
-          }
-          else if(saveFmt.type == ResourceFormatType::R11G11B10)
-          {
-            uint32_t *u32 = (uint32_t *)srcData;
+      const uint32_t rowStride = td.width * texelStride;
 
-            Vec3f vec = ConvertFromR11G11B10(*u32);
+      // every row converts independently, and on large float targets this conversion dominates
+      // the export time, so fan contiguous row ranges out over the task pool.
+      auto convertRows = [&abgr, fldata, saveFmt, &sd, &td, srcBase, rowStride,
+                          texelStride](uint32_t yBegin, uint32_t yEnd) {
+        std::vector<Vec4f> rowVec(td.width);
 
-            r = vec.x;
-            g = vec.y;
-            b = vec.z;
-            a = 1.0f;
+        for(uint32_t y = yBegin; y < yEnd; y++)
+        {
+          // decode the raw texels through the shared bulk converter a row at a time
+          ConvertComponents(saveFmt, srcBase + y * rowStride, td.width, texelStride, rowVec.data());
 
-            srcData += 4;
-          }
-          else
+          for(uint32_t x = 0; x < td.width; x++)
           {
-            if(saveFmt.compCount >= 1)
-              r = ConvertComponent(saveFmt, srcData + saveFmt.compByteWidth * 0);
-            if(saveFmt.compCount >= 2)
-              g = ConvertComponent(saveFmt, srcData + saveFmt.compByteWidth * 1);
-            if(saveFmt.compCount >= 3)
-              b = ConvertComponent(saveFmt, srcData + saveFmt.compByteWidth * 2);
-            if(saveFmt.compCount >= 4)
-              a = ConvertComponent(saveFmt, srcData + saveFmt.compByteWidth * 3);
-
-            srcData += pixStride;
+            float r = rowVec[x].x;
+            float g = rowVec[x].y;
+            float b = rowVec[x].z;
+            float a = rowVec[x].w;
+
+            if(saveFmt.BGRAOrder())
+              std::swap(r, b);
+
+            // HDR can't represent negative values
+            if(sd.destType == FileType::HDR)
+            {
+              r = RDCMAX(r, 0.0f);
+              g = RDCMAX(g, 0.0f);
+              b = RDCMAX(b, 0.0f);
+              a = RDCMAX(a, 0.0f);
+            }
+
+            if(sd.channelExtract == 0)
+            {
+              g = b = r;
+              a = 1.0f;
+            }
+            if(sd.channelExtract == 1)
+            {
+              r = b = g;
+              a = 1.0f;
+            }
+            if(sd.channelExtract == 2)
+            {
+              r = g = b;
+              a = 1.0f;
+            }
+            if(sd.channelExtract == 3)
+            {
+              r = g = b = a;
+              a = 1.0f;
+            }
+
+            if(fldata)
+            {
+              fldata[(y * td.width + x) * 4 + 0] = r;
+              fldata[(y * td.width + x) * 4 + 1] = g;
+              fldata[(y * td.width + x) * 4 + 2] = b;
+              fldata[(y * td.width + x) * 4 + 3] = a;
+            }
+            else
+            {
+              abgr[0][(y * td.width + x)] = a;
+              abgr[1][(y * td.width + x)] = b;
+              abgr[2][(y * td.width + x)] = g;
+              abgr[3][(y * td.width + x)] = r;
+            }
           }
+        }
+      };
 
-          if(saveFmt.BGRAOrder())
-            std::swap(r, b);
+      const uint32_t numChunks =
+          RDCMIN(td.height, Threading::TaskPool::Instance().NumWorkers());
+      const uint32_t rowsPerChunk = RDCMAX(1U, td.height / RDCMAX(1U, numChunks));
 
-          // HDR can't represent negative values
-          if(sd.destType == FileType::HDR)
-          {
-            r = RDCMAX(r, 0.0f);
-            g = RDCMAX(g, 0.0f);
-            b = RDCMAX(b, 0.0f);
-            a = RDCMAX(a, 0.0f);
-          }
+      Threading::TaskGroup convertTasks;
 
-          if(sd.channelExtract == 0)
-          {
-            g = b = r;
-            a = 1.0f;
-          }
-          if(sd.channelExtract == 1)
-          {
-            r = b = g;
-            a = 1.0f;
-          }
-          if(sd.channelExtract == 2)
-          {
-            r = g = b;
-            a = 1.0f;
-          }
-          if(sd.channelExtract == 3)
-          {
-            r = g = b = a;
-            a = 1.0f;
-          }
+      for(uint32_t chunk = 0; chunk < numChunks; chunk++)
+      {
+        const uint32_t yBegin = chunk * rowsPerChunk;
+        const uint32_t yEnd = (chunk == numChunks - 1) ? td.height : yBegin + rowsPerChunk;
 
-          if(fldata)
-          {
-            fldata[(y * td.width + x) * 4 + 0] = r;
-            fldata[(y * td.width + x) * 4 + 1] = g;
-            fldata[(y * td.width + x) * 4 + 2] = b;
-            fldata[(y * td.width + x) * 4 + 3] = a;
-          }
-          else
-          {
-            abgr[0][(y * td.width + x)] = a;
-            abgr[1][(y * td.width + x)] = b;
-            abgr[2][(y * td.width + x)] = g;
-            abgr[3][(y * td.width + x)] = r;
-          }
-        }
+        Threading::TaskPool::Instance().Submit(convertTasks,
+                                               [&convertRows, yBegin, yEnd]() {
+                                                 convertRows(yBegin, yEnd);
+                                               });
       }
 
+      Threading::TaskPool::Instance().Wait(convertTasks);
+
       if(sd.destType == FileType::HDR)
       {
         int ret = stbi_write_hdr_to_func(fileWriteFunc, (void *)f, td.width, td.height, 4, fldata);
@@ -1715,6 +1717,12 @@ rdcarray<ShaderVariable> ReplayController::GetCBufferVariableContents(
 {
   CHECK_REPLAY_THREAD();
 
+  CBufferKey key = {shader, entryPoint ? entryPoint : "", cbufslot, buffer, offs};
+
+  auto it = m_CBufferCache.find(key);
+  if(it != m_CBufferCache.end())
+    return it->second;
+
   bytebuf data;
   if(buffer != ResourceId())
   {
@@ -1730,6 +1738,8 @@ rdcarray<ShaderVariable> ReplayController::GetCBufferVariableContents(
   if(shader != ResourceId())
     m_pDevice->FillCBufferVariables(shader, entryPoint, cbufslot, v, data);
 
+  m_CBufferCache[key] = v;
+
   return v;
 }
 
@@ -1950,6 +1960,18 @@ rdcpair<ResourceId, rdcstr> ReplayController::BuildTargetShader(
   return make_rdcpair<ResourceId, rdcstr>(id, errs);
 }
 
+static bool SameCompileFlags(const ShaderCompileFlags &a, const ShaderCompileFlags &b)
+{
+  if(a.flags.size() != b.flags.size())
+    return false;
+
+  for(size_t i = 0; i < a.flags.size(); i++)
+    if(!(a.flags[i] == b.flags[i]))
+      return false;
+
+  return true;
+}
+
 rdcpair<ResourceId, rdcstr> ReplayController::BuildCustomShader(
     const char *entry, const char *source, const ShaderCompileFlags &compileFlags, ShaderStage type)
 {
@@ -1969,11 +1991,35 @@ rdcpair<ResourceId, rdcstr> ReplayController::BuildCustomShader(
     default: RDCERR("Unexpected type in BuildShader!"); return rdcpair<ResourceId, rdcstr>();
   }
 
+  // if we've compiled this shader before hand it back instead of recompiling, so that saving a
+  // custom shader file without changes (or re-scanning the shader directory) doesn't stall the
+  // replay thread on the backend compiler.
+  for(auto it = m_CustomShaderCache.begin(); it != m_CustomShaderCache.end(); ++it)
+  {
+    if(it->stage == type && it->entry == entry && it->source == source &&
+       SameCompileFlags(it->flags, compileFlags))
+    {
+      it->refcount++;
+      return make_rdcpair<ResourceId, rdcstr>(it->id, "");
+    }
+  }
+
   m_pDevice->BuildCustomShader(source, entry, compileFlags, type, &id, &errs);
 
   if(id != ResourceId())
+  {
     m_CustomShaders.insert(id);
 
+    CachedCustomShader cached;
+    cached.entry = entry;
+    cached.source = source;
+    cached.flags = compileFlags;
+    cached.stage = type;
+    cached.id = id;
+    cached.refcount = 1;
+    m_CustomShaderCache.push_front(cached);
+  }
+
   return make_rdcpair<ResourceId, rdcstr>(id, errs);
 }
 
@@ -1989,6 +2035,41 @@ void ReplayController::FreeCustomShader(ResourceId id)
 {
   CHECK_REPLAY_THREAD();
 
+  for(auto it = m_CustomShaderCache.begin(); it != m_CustomShaderCache.end(); ++it)
+  {
+    if(it->id == id)
+    {
+      it->refcount--;
+
+      if(it->refcount > 0)
+        return;
+
+      // keep the compiled shader alive in the unreferenced portion of the cache, most recently
+      // used first, so an unchanged rebuild gets it back for free. Only evict (and really free)
+      // the oldest unreferenced shaders once there are too many.
+      CachedCustomShader unref = *it;
+      m_CustomShaderCache.erase(it);
+      m_CustomShaderCache.push_front(unref);
+
+      size_t numUnref = 0;
+      for(it = m_CustomShaderCache.begin(); it != m_CustomShaderCache.end();)
+      {
+        if(it->refcount == 0 && ++numUnref > CustomShaderCacheSize)
+        {
+          m_CustomShaders.erase(it->id);
+          m_pDevice->FreeCustomShader(it->id);
+          it = m_CustomShaderCache.erase(it);
+        }
+        else
+        {
+          ++it;
+        }
+      }
+
+      return;
+    }
+  }
+
   m_CustomShaders.erase(id);
   m_pDevice->FreeCustomShader(id);
 }
@@ -2056,6 +2137,10 @@ ReplayStatus ReplayController::PostCreateInit(IReplayDriver *device, RDCFile *rd
 
   m_pDevice = device;
 
+  // we replay events as they're inspected, so the driver is free to defer building structured data
+  // for huge captures until the chunks are actually visited.
+  m_pDevice->SetLazyStructuredData(true);
+
   ReplayStatus status = m_pDevice->ReadLogInitialisation(rdc, false);
 
   if(status != ReplayStatus::Succeeded)
@@ -2096,9 +2181,323 @@ ReplayStatus ReplayController::PostCreateInit(IReplayDriver *device, RDCFile *rd
 
   FetchPipelineState(m_Drawcalls.back()->eventId);
 
+  ProcessTextureStatistics(rdc);
+
+  m_Rdc = rdc;
+  ReadGPUDurations(rdc);
+
   return ReplayStatus::Succeeded;
 }
 
+static const uint64_t TextureStatisticsVersion = 1;
+
+// don't bake stats for textures with an excessive number of subresources (huge texture arrays),
+// both to bound the GPU work at bake time and the section size.
+static const size_t MaxBakedSubresources = 512;
+
+// returns true if this usage writes to the resource. A written texture has different contents -
+// and so different min/max values - depending on the replayed event, so it can't be baked down
+// to a single answer.
+static bool IsWrittenUsage(ResourceUsage u)
+{
+  return (u >= ResourceUsage::VS_RWResource && u <= ResourceUsage::All_RWResource) ||
+         u == ResourceUsage::StreamOut || u == ResourceUsage::ColorTarget ||
+         u == ResourceUsage::DepthStencilTarget || u == ResourceUsage::Clear ||
+         u == ResourceUsage::GenMips || u == ResourceUsage::Resolve ||
+         u == ResourceUsage::ResolveDst || u == ResourceUsage::Copy || u == ResourceUsage::CopyDst;
+}
+
+void ReplayController::ProcessTextureStatistics(RDCFile *rdc)
+{
+  CHECK_REPLAY_THREAD();
+
+  m_TextureStats.clear();
+
+  if(rdc == NULL)
+    return;
+
+  int idx = rdc->SectionIndex(SectionType::TextureStatistics);
+
+  if(idx >= 0)
+  {
+    const SectionProperties &props = rdc->GetSectionProperties(idx);
+
+    if(props.version != TextureStatisticsVersion)
+    {
+      RDCWARN("Unsupported texture statistics version %llu, ignoring section", props.version);
+      return;
+    }
+
+    StreamReader *reader = rdc->ReadSection(idx);
+
+    uint64_t texCount = 0;
+    reader->Read(texCount);
+
+    for(uint64_t i = 0; i < texCount && !reader->IsErrored(); i++)
+    {
+      uint64_t num = 0;
+      reader->Read(num);
+
+      ResourceId id;
+      memcpy(&id, &num, sizeof(uint64_t));
+
+      uint32_t subCount = 0;
+      reader->Read(subCount);
+
+      if(reader->IsErrored() || subCount == 0 || subCount > MaxBakedSubresources)
+      {
+        RDCWARN("Corrupt texture statistics section, ignoring");
+        m_TextureStats.clear();
+        delete reader;
+        return;
+      }
+
+      std::vector<TextureSubresourceStats> &stats = m_TextureStats[id];
+      stats.resize(subCount);
+
+      for(TextureSubresourceStats &s : stats)
+      {
+        reader->Read(s.sliceFace);
+        reader->Read(s.mip);
+        reader->Read(s.sample);
+        reader->Read(s.minval);
+        reader->Read(s.maxval);
+      }
+    }
+
+    if(reader->IsErrored())
+    {
+      RDCWARN("Corrupt texture statistics section, ignoring");
+      m_TextureStats.clear();
+    }
+
+    delete reader;
+
+    return;
+  }
+
+  // no baked section in the file - compute the stats now and write them back so future sessions
+  // (particularly remote ones) answer range queries straight from the file. Only textures that
+  // are never written during the frame are included, since anything written has event-dependent
+  // contents.
+  for(const TextureDescription &tex : m_Textures)
+  {
+    ResourceId live = m_pDevice->GetLiveID(tex.resourceId);
+
+    if(live == ResourceId())
+      continue;
+
+    bool written = false;
+
+    for(const EventUsage &use : m_pDevice->GetUsage(live))
+      written |= IsWrittenUsage(use.usage);
+
+    if(written)
+      continue;
+
+    std::vector<MinMaxSubresource> subs;
+
+    for(uint32_t mip = 0; mip < tex.mips; mip++)
+    {
+      uint32_t slices = tex.dimension == 3 ? RDCMAX(1U, tex.depth >> mip) : tex.arraysize;
+
+      for(uint32_t slice = 0; slice < slices; slice++)
+      {
+        for(uint32_t sample = 0; sample < RDCMAX(1U, tex.msSamp); sample++)
+        {
+          MinMaxSubresource sub;
+          sub.sliceFace = slice;
+          sub.mip = mip;
+          sub.sample = sample;
+          subs.push_back(sub);
+        }
+      }
+    }
+
+    if(subs.empty() || subs.size() > MaxBakedSubresources)
+      continue;
+
+    std::vector<float> minvals(subs.size() * 4), maxvals(subs.size() * 4);
+
+    if(!m_pDevice->GetMinMax(live, subs, CompType::Typeless, minvals.data(), maxvals.data()))
+      continue;
+
+    std::vector<TextureSubresourceStats> &stats = m_TextureStats[tex.resourceId];
+    stats.resize(subs.size());
+
+    for(size_t i = 0; i < subs.size(); i++)
+    {
+      stats[i].sliceFace = subs[i].sliceFace;
+      stats[i].mip = subs[i].mip;
+      stats[i].sample = subs[i].sample;
+      memcpy(stats[i].minval.floatValue, &minvals[i * 4], sizeof(float) * 4);
+      memcpy(stats[i].maxval.floatValue, &maxvals[i * 4], sizeof(float) * 4);
+    }
+  }
+
+  if(m_TextureStats.empty())
+    return;
+
+  SectionProperties props = {};
+  props.type = SectionType::TextureStatistics;
+  props.version = TextureStatisticsVersion;
+  // left uncompressed - the section is small and this keeps reads trivial
+
+  StreamWriter *w = rdc->WriteSection(props);
+
+  uint64_t texCount = m_TextureStats.size();
+  w->Write(texCount);
+
+  for(auto it = m_TextureStats.begin(); it != m_TextureStats.end(); ++it)
+  {
+    uint64_t num = 0;
+    memcpy(&num, &it->first, sizeof(uint64_t));
+    w->Write(num);
+
+    uint32_t subCount = (uint32_t)it->second.size();
+    w->Write(subCount);
+
+    for(const TextureSubresourceStats &s : it->second)
+    {
+      w->Write(s.sliceFace);
+      w->Write(s.mip);
+      w->Write(s.sample);
+      w->Write(s.minval);
+      w->Write(s.maxval);
+    }
+  }
+
+  // failure to write the section is non-fatal - the stats stay cached in memory for this session
+  if(w->IsErrored())
+    RDCWARN("Couldn't write texture statistics section");
+
+  w->Finish();
+
+  delete w;
+}
+
+const ReplayController::TextureSubresourceStats *ReplayController::FindTextureStats(
+    ResourceId tex, uint32_t sliceFace, uint32_t mip, uint32_t sample, CompType typeHint) const
+{
+  // the baked values were computed with a typeless hint - any other interpretation needs the GPU
+  if(typeHint != CompType::Typeless)
+    return NULL;
+
+  auto it = m_TextureStats.find(tex);
+
+  if(it == m_TextureStats.end())
+    return NULL;
+
+  for(const TextureSubresourceStats &s : it->second)
+    if(s.sliceFace == sliceFace && s.mip == mip && s.sample == sample)
+      return &s;
+
+  return NULL;
+}
+
+static const uint64_t GPUDurationsVersion = 1;
+
+void ReplayController::ReadGPUDurations(RDCFile *rdc)
+{
+  CHECK_REPLAY_THREAD();
+
+  m_GPUDurations.clear();
+  m_HaveGPUDurations = false;
+
+  if(rdc == NULL)
+    return;
+
+  int idx = rdc->SectionIndex(SectionType::GPUDurations);
+
+  if(idx < 0)
+    return;
+
+  const SectionProperties &props = rdc->GetSectionProperties(idx);
+
+  if(props.version != GPUDurationsVersion)
+  {
+    RDCWARN("Unsupported GPU durations version %llu, ignoring section", props.version);
+    return;
+  }
+
+  StreamReader *reader = rdc->ReadSection(idx);
+
+  uint32_t count = 0;
+  reader->Read(count);
+
+  // sanity check the count against the section size
+  if(reader->IsErrored() || count > (props.uncompressedSize / (sizeof(uint32_t) + sizeof(double))))
+  {
+    RDCWARN("Corrupt GPU durations section, ignoring");
+    delete reader;
+    return;
+  }
+
+  for(uint32_t i = 0; i < count && !reader->IsErrored(); i++)
+  {
+    uint32_t eventId = 0;
+    double duration = 0.0;
+    reader->Read(eventId);
+    reader->Read(duration);
+    m_GPUDurations[eventId] = duration;
+  }
+
+  if(reader->IsErrored())
+  {
+    RDCWARN("Corrupt GPU durations section, ignoring");
+    m_GPUDurations.clear();
+  }
+  else
+  {
+    m_HaveGPUDurations = true;
+  }
+
+  delete reader;
+}
+
+void ReplayController::BakeGPUDurations(const rdcarray<CounterResult> &results)
+{
+  CHECK_REPLAY_THREAD();
+
+  m_GPUDurations.clear();
+
+  for(const CounterResult &r : results)
+    if(r.counter == GPUCounter::EventGPUDuration)
+      m_GPUDurations[r.eventId] = r.value.d;
+
+  if(m_GPUDurations.empty())
+    return;
+
+  m_HaveGPUDurations = true;
+
+  if(m_Rdc == NULL || m_Rdc->SectionIndex(SectionType::GPUDurations) >= 0)
+    return;
+
+  SectionProperties props = {};
+  props.type = SectionType::GPUDurations;
+  props.version = GPUDurationsVersion;
+  // left uncompressed - the section is small and this keeps reads trivial
+
+  StreamWriter *w = m_Rdc->WriteSection(props);
+
+  uint32_t count = (uint32_t)m_GPUDurations.size();
+  w->Write(count);
+
+  for(auto it = m_GPUDurations.begin(); it != m_GPUDurations.end(); ++it)
+  {
+    w->Write(it->first);
+    w->Write(it->second);
+  }
+
+  // failure to write the section is non-fatal - the durations stay cached for this session
+  if(w->IsErrored())
+    RDCWARN("Couldn't write GPU durations section");
+
+  w->Finish();
+
+  delete w;
+}
+
 void ReplayController::FileChanged()
 {
   CHECK_REPLAY_THREAD();
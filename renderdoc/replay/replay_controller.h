@@ -25,6 +25,8 @@
 
 #pragma once
 
+#include <list>
+#include <map>
 #include <set>
 #include <vector>
 #include "api/replay/renderdoc_replay.h"
@@ -140,6 +142,7 @@ public:
   void FileChanged();
 
   void SetFrameEvent(uint32_t eventId, bool force);
+  void PrefetchFrameEvent(uint32_t eventId);
 
   const D3D11Pipe::State *GetD3D11PipelineState();
   const D3D12Pipe::State *GetD3D12PipelineState();
@@ -192,9 +195,14 @@ public:
   rdcarray<EventUsage> GetUsage(ResourceId id);
 
   bytebuf GetBufferData(ResourceId buff, uint64_t offset, uint64_t len);
+  void GetBufferData(ResourceId buff, uint64_t offset, uint64_t len, bytebuf &data);
   bytebuf GetTextureData(ResourceId buff, uint32_t arrayIdx, uint32_t mip);
+  void GetTextureData(ResourceId buff, uint32_t arrayIdx, uint32_t mip, bytebuf &data);
 
   bool SaveTexture(const TextureSave &saveData, const char *path);
+  rdcarray<uint32_t> SaveTextureAtEvents(const TextureSave &saveData,
+                                         const rdcarray<uint32_t> &eventIds,
+                                         const rdcarray<rdcstr> &paths);
 
   rdcarray<ShaderVariable> GetCBufferVariableContents(ResourceId shader, const char *entryPoint,
                                                       uint32_t cbufslot, ResourceId buffer,
@@ -252,5 +260,89 @@ private:
   std::set<ResourceId> m_TargetResources;
   std::set<ResourceId> m_CustomShaders;
 
+  // cache of compiled custom visualisation shaders. The UI frees and rebuilds custom shaders
+  // whenever their file is saved, and rebuilds all of them when re-scanning the shader directory,
+  // so identical sources come through repeatedly - compiling blocks the replay thread each time.
+  // We keep entries alive with a refcount: FreeCustomShader on the last reference moves the entry
+  // to the front of the list instead of destroying it, and only shaders evicted when the
+  // unreferenced portion grows past CustomShaderCacheSize are really freed.
+  struct CachedCustomShader
+  {
+    rdcstr entry;
+    rdcstr source;
+    ShaderCompileFlags flags;
+    ShaderStage stage;
+    ResourceId id;
+    int refcount;
+  };
+  static const size_t CustomShaderCacheSize = 16;
+  std::list<CachedCustomShader> m_CustomShaderCache;
+
+  // usage is recorded once at capture load and never changes afterwards, but the UI asks for it
+  // again on every event change (resource inspector, texture viewer usage bar) and each call
+  // copies the whole list out of the driver - or round-trips to the remote server on remote
+  // replays. Cache per-resource results for the lifetime of the capture, keyed on the original
+  // id the UI passes in.
+  std::map<ResourceId, rdcarray<EventUsage>> m_UsageCache;
+
+  // precomputed per-subresource texture min/max values, read from the capture's
+  // TextureStatistics section or baked and written back on first load. Keyed on the original
+  // resource id the UI passes in. Values are computed with a Typeless type hint, so lookups
+  // with any other hint fall back to the GPU.
+  struct TextureSubresourceStats
+  {
+    uint32_t sliceFace;
+    uint32_t mip;
+    uint32_t sample;
+    PixelValue minval;
+    PixelValue maxval;
+  };
+  std::map<ResourceId, std::vector<TextureSubresourceStats>> m_TextureStats;
+
+  void ProcessTextureStatistics(RDCFile *rdc);
+  const TextureSubresourceStats *FindTextureStats(ResourceId tex, uint32_t sliceFace, uint32_t mip,
+                                                  uint32_t sample, CompType typeHint) const;
+
+  // per-event GPU durations, read from the capture's GPUDurations section on load, or measured
+  // by the first FetchCounters that runs the duration counter and written back then. Unlike the
+  // texture statistics the bake can't happen at load time - measuring durations means replaying
+  // the whole frame under timing, which is only worth paying when the user actually asks for it.
+  // The RDCFile is remembered from PostCreateInit so the section can be appended at that point;
+  // the file object outlives the controller for the session.
+  std::map<uint32_t, double> m_GPUDurations;
+  bool m_HaveGPUDurations = false;
+  RDCFile *m_Rdc = NULL;
+
+  void ReadGPUDurations(RDCFile *rdc);
+  void BakeGPUDurations(const rdcarray<CounterResult> &results);
+
+  // decoded constant buffer contents, cached for the current event. Every open constants panel
+  // requests its buffer again whenever the UI refreshes, and each request re-fetches the buffer
+  // data and re-decodes it against the shader reflection - over a remote connection that's a
+  // round trip per panel. The contents can only change when the replayed event does, so the cache
+  // is cleared on every replay in SetFrameEvent.
+  struct CBufferKey
+  {
+    ResourceId shader;
+    rdcstr entryPoint;
+    uint32_t cbufslot;
+    ResourceId buffer;
+    uint64_t offs;
+
+    bool operator<(const CBufferKey &o) const
+    {
+      if(shader != o.shader)
+        return shader < o.shader;
+      if(entryPoint != o.entryPoint)
+        return entryPoint < o.entryPoint;
+      if(cbufslot != o.cbufslot)
+        return cbufslot < o.cbufslot;
+      if(buffer != o.buffer)
+        return buffer < o.buffer;
+      return offs < o.offs;
+    }
+  };
+  std::map<CBufferKey, rdcarray<ShaderVariable>> m_CBufferCache;
+
   friend struct ReplayOutput;
 };
@@ -49,6 +49,11 @@ void DoSerialise(SerialiserType &ser, GetTextureDataParams &el)
   SERIALISE_MEMBER(remap);
   SERIALISE_MEMBER(blackPoint);
   SERIALISE_MEMBER(whitePoint);
+  SERIALISE_MEMBER(partialX);
+  SERIALISE_MEMBER(partialY);
+  SERIALISE_MEMBER(partialWidth);
+  SERIALISE_MEMBER(partialHeight);
+  SERIALISE_MEMBER(downsampleFactor);
 }
 
 INSTANTIATE_SERIALISE_TYPE(GetTextureDataParams);
@@ -58,19 +58,46 @@ struct GetTextureDataParams
   float blackPoint;
   float whitePoint;
 
+  // when partialWidth and partialHeight are non-zero, only that texel rect of the selected mip is
+  // returned, as tightly packed rows of partialWidth texels. Only honoured over the replay proxy
+  // for uncompressed non-MSAA 2D data - drivers themselves always read back the full subresource.
+  uint32_t partialX;
+  uint32_t partialY;
+  uint32_t partialWidth;
+  uint32_t partialHeight;
+
+  // when greater than one, the returned data is point-sampled down by this factor in each
+  // dimension, as tightly packed rows of texels. Used for lossy display previews over the replay
+  // proxy - as with the partial rect above, drivers themselves always read back at full
+  // resolution.
+  uint32_t downsampleFactor;
+
   GetTextureDataParams()
       : forDiskSave(false),
         typeHint(CompType::Typeless),
         resolve(false),
         remap(RemapTexture::NoRemap),
         blackPoint(0.0f),
-        whitePoint(1.0f)
+        whitePoint(1.0f),
+        partialX(0),
+        partialY(0),
+        partialWidth(0),
+        partialHeight(0),
+        downsampleFactor(1)
   {
   }
 };
 
 DECLARE_REFLECTION_STRUCT(GetTextureDataParams);
 
+// identifies one subresource in a batched min/max fetch
+struct MinMaxSubresource
+{
+  uint32_t sliceFace = 0;
+  uint32_t mip = 0;
+  uint32_t sample = 0;
+};
+
 class RDCFile;
 
 class AMDRGPControl;
@@ -123,6 +150,12 @@ public:
   virtual void ReplayLog(uint32_t endEventID, ReplayLogType replayType) = 0;
   virtual const SDFile &GetStructuredFile() = 0;
 
+  // optional hint, called before ReadLogInitialisation. When set, drivers that support it may load
+  // structured data for very large captures lazily - adding only metadata stubs flagged with
+  // SDChunkFlags::StubChunk up front and materialising the full chunk contents on demand as events
+  // are replayed. The default ignores the hint and loads everything eagerly.
+  virtual void SetLazyStructuredData(bool lazy) {}
+
   virtual vector<uint32_t> GetPassEvents(uint32_t eventId) = 0;
 
   virtual void InitPostVSBuffers(uint32_t eventId) = 0;
@@ -147,6 +180,11 @@ public:
 
   virtual vector<GPUCounter> EnumerateCounters() = 0;
   virtual CounterDescription DescribeCounter(GPUCounter counterID) = 0;
+  // fetches all requested counters in as few replay passes as the API allows, on the single
+  // device the capture was loaded on. Counter passes can't be partitioned across multiple GPUs
+  // with the current architecture: a replay driver owns its device's copy of every resource and
+  // all initial contents, so a second adapter would need a second full capture load, and the
+  // per-pass results reference GPU-local query pools that have no cross-device meaning.
   virtual vector<CounterResult> FetchCounters(const vector<GPUCounter> &counterID) = 0;
 
   virtual void FillCBufferVariables(ResourceId shader, string entryPoint, uint32_t cbufSlot,
@@ -201,6 +239,24 @@ public:
                             CompType typeHint, float minval, float maxval, bool channels[4],
                             vector<uint32_t> &histogram) = 0;
 
+  // batched min/max fetch for several subresources of one texture. minval/maxval receive four
+  // floats per subresource, in order. Each synchronous GetMinMax costs a full submit and GPU sync,
+  // which is what the texture viewer's auto-fit stalls on for heavily mipped textures - drivers
+  // that can compute every subresource in one submission should override this, the default just
+  // loops.
+  virtual bool GetMinMax(ResourceId texid, const vector<MinMaxSubresource> &subs, CompType typeHint,
+                         float *minval, float *maxval)
+  {
+    for(size_t i = 0; i < subs.size(); i++)
+    {
+      if(!GetMinMax(texid, subs[i].sliceFace, subs[i].mip, subs[i].sample, typeHint, minval + i * 4,
+                    maxval + i * 4))
+        return false;
+    }
+
+    return true;
+  }
+
   virtual ResourceId CreateProxyTexture(const TextureDescription &templateTex) = 0;
   virtual void SetProxyTextureData(ResourceId texid, uint32_t arrayIdx, uint32_t mip, byte *data,
                                    size_t dataSize) = 0;
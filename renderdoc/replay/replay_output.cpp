@@ -160,10 +160,30 @@ rdcpair<int32_t, int32_t> ReplayOutput::GetDimensions()
   return make_rdcpair(m_Width, m_Height);
 }
 
+static bool SameTextureDisplay(const TextureDisplay &a, const TextureDisplay &b)
+{
+  return a.resourceId == b.resourceId && a.typeHint == b.typeHint && a.rangeMin == b.rangeMin &&
+         a.rangeMax == b.rangeMax && a.scale == b.scale && a.red == b.red && a.green == b.green &&
+         a.blue == b.blue && a.alpha == b.alpha && a.flipY == b.flipY &&
+         a.hdrMultiplier == b.hdrMultiplier && a.decodeYUV == b.decodeYUV &&
+         a.linearDisplayAsGamma == b.linearDisplayAsGamma && a.customShaderId == b.customShaderId &&
+         a.mip == b.mip && a.sliceFace == b.sliceFace && a.sampleIdx == b.sampleIdx &&
+         a.rawOutput == b.rawOutput && a.xOffset == b.xOffset && a.yOffset == b.yOffset &&
+         a.backgroundColor.x == b.backgroundColor.x && a.backgroundColor.y == b.backgroundColor.y &&
+         a.backgroundColor.z == b.backgroundColor.z && a.backgroundColor.w == b.backgroundColor.w &&
+         a.overlay == b.overlay;
+}
+
 void ReplayOutput::SetTextureDisplay(const TextureDisplay &o)
 {
   CHECK_REPLAY_THREAD();
 
+  // the UI re-sends the display configuration on generic state changes like resizes and repaints.
+  // If nothing actually changed, don't dirty anything - the overlay texture and the output stay
+  // valid, so the next Display() just re-presents what we already rendered.
+  if(SameTextureDisplay(o, m_RenderData.texDisplay))
+    return;
+
   if(o.overlay != m_RenderData.texDisplay.overlay || o.typeHint != m_RenderData.texDisplay.typeHint ||
      o.resourceId != m_RenderData.texDisplay.resourceId)
   {
@@ -185,6 +205,8 @@ void ReplayOutput::SetMeshDisplay(const MeshDisplay &o)
 {
   CHECK_REPLAY_THREAD();
 
+  // unlike SetTextureDisplay we can't skip no-change updates here, because the camera is
+  // referenced by pointer and its transform mutates externally without a fresh SetMeshDisplay.
   if(o.showWholePass != m_RenderData.meshDisplay.showWholePass)
     m_OverlayDirty = true;
   m_RenderData.meshDisplay = o;
@@ -372,14 +394,25 @@ rdcpair<PixelValue, PixelValue> ReplayOutput::GetMinMax()
   uint32_t mip = m_RenderData.texDisplay.mip;
   uint32_t sample = m_RenderData.texDisplay.sampleIdx;
 
-  if(m_RenderData.texDisplay.customShaderId != ResourceId() &&
-     m_CustomShaderResourceId != ResourceId())
+  bool custom = m_RenderData.texDisplay.customShaderId != ResourceId() &&
+                m_CustomShaderResourceId != ResourceId();
+
+  if(custom)
   {
     tex = m_CustomShaderResourceId;
     typeHint = CompType::Typeless;
     slice = 0;
     sample = 0;
   }
+  else
+  {
+    // see if the capture has baked statistics for this subresource, to skip the GPU passes
+    const ReplayController::TextureSubresourceStats *stats = m_pRenderer->FindTextureStats(
+        m_RenderData.texDisplay.resourceId, slice, mip, sample, typeHint);
+
+    if(stats)
+      return make_rdcpair(stats->minval, stats->maxval);
+  }
 
   m_pDevice->GetMinMax(tex, slice, mip, sample, typeHint, &minval.floatValue[0],
                        &maxval.floatValue[0]);
@@ -597,6 +630,9 @@ void ReplayOutput::DisplayContext()
   int32_t width = 0, height = 0;
   m_pDevice->GetOutputWindowDimensions(m_PixelContext.outputID, width, height);
 
+  disp.viewportWidth = (uint32_t)width;
+  disp.viewportHeight = (uint32_t)height;
+
   float w = (float)width;
   float h = (float)height;
 
@@ -664,9 +700,17 @@ void ReplayOutput::Display()
     m_pDevice->FlipOutputWindow(m_PixelContext.outputID);
   }
 
+  // thumbnails are updated a few at a time. When every thumbnail is marked dirty at once - e.g.
+  // changing event with a big texture list open - rendering them all here would block this
+  // Display and queue every user interaction behind thousands of renders. Instead we render up to
+  // a budget per call and leave the rest dirty, so they fill in incrementally over subsequent
+  // Display calls while the main output (rendered above, before we get here) stays responsive.
+  const size_t maxThumbnailRenders = 16;
+  size_t numThumbnailRenders = 0;
+
   for(size_t i = 0; i < m_Thumbnails.size(); i++)
   {
-    if(!m_Thumbnails[i].dirty)
+    if(!m_Thumbnails[i].dirty || numThumbnailRenders >= maxThumbnailRenders)
     {
       m_pDevice->BindOutputWindow(m_Thumbnails[i].outputID, false);
       m_pDevice->FlipOutputWindow(m_Thumbnails[i].outputID);
@@ -719,6 +763,12 @@ void ReplayOutput::Display()
     disp.rawOutput = false;
     disp.overlay = DebugOverlay::NoOverlay;
 
+    int32_t thumbWidth = 0, thumbHeight = 0;
+    m_pDevice->GetOutputWindowDimensions(m_Thumbnails[i].outputID, thumbWidth, thumbHeight);
+
+    disp.viewportWidth = (uint32_t)thumbWidth;
+    disp.viewportHeight = (uint32_t)thumbHeight;
+
     if(m_Thumbnails[i].typeHint == CompType::SNorm)
       disp.rangeMin = -1.0f;
 
@@ -730,6 +780,7 @@ void ReplayOutput::Display()
     m_pDevice->FlipOutputWindow(m_Thumbnails[i].outputID);
 
     m_Thumbnails[i].dirty = false;
+    numThumbnailRenders++;
   }
 }
 
@@ -753,6 +804,11 @@ void ReplayOutput::DisplayTex()
   texDisplay.rawOutput = false;
   texDisplay.resourceId = m_pDevice->GetLiveID(texDisplay.resourceId);
 
+  // let the driver know how much of the texture is on screen, so a remote proxy can restrict
+  // transfers of huge textures to the visible region.
+  texDisplay.viewportWidth = (uint32_t)m_Width;
+  texDisplay.viewportHeight = (uint32_t)m_Height;
+
   if(m_RenderData.texDisplay.overlay != DebugOverlay::NoOverlay && draw)
   {
     if(m_OverlayDirty)
@@ -67,6 +67,14 @@ struct xml_file_writer : pugi::xml_writer
   void write(const void *data, size_t size) { stream.Write(data, size); }
 };
 
+struct xml_string_writer : pugi::xml_writer
+{
+  std::string &str;
+
+  xml_string_writer(std::string &s) : str(s) {}
+  void write(const void *data, size_t size) { str.append((const char *)data, size); }
+};
+
 // avoid &, <, and > since they throw off the ascii alignment
 static constexpr bool IsXMLPrintable(const char c)
 {
@@ -271,6 +279,43 @@ static void Obj2XML(pugi::xml_node &parent, SDObject &child)
   }
 }
 
+static void Chunk2XML(pugi::xml_node &xChunk, SDChunk *chunk)
+{
+  xChunk.append_attribute("id") = chunk->metadata.chunkID;
+  xChunk.append_attribute("name") = chunk->name.c_str();
+  xChunk.append_attribute("length") = chunk->metadata.length;
+  if(chunk->metadata.threadID)
+    xChunk.append_attribute("threadID") = chunk->metadata.threadID;
+  if(chunk->metadata.timestampMicro)
+    xChunk.append_attribute("timestamp") = chunk->metadata.timestampMicro;
+  if(chunk->metadata.durationMicro >= 0)
+    xChunk.append_attribute("duration") = chunk->metadata.durationMicro;
+  if(chunk->metadata.flags & SDChunkFlags::HasCallstack)
+  {
+    pugi::xml_node stack = xChunk.append_child("callstack");
+
+    for(size_t i = 0; i < chunk->metadata.callstack.size(); i++)
+    {
+      stack.append_child("address").text() = chunk->metadata.callstack[i];
+    }
+  }
+
+  if(chunk->metadata.flags & SDChunkFlags::OpaqueChunk)
+  {
+    xChunk.append_attribute("opaque") = true;
+
+    RDCASSERT(!chunk->data.children.empty());
+    pugi::xml_node opaque = xChunk.append_child("buffer");
+    opaque.append_attribute("byteLength") = chunk->data.children[0]->type.byteSize;
+    opaque.text() = chunk->data.children[0]->data.basic.u;
+  }
+  else
+  {
+    for(size_t o = 0; o < chunk->data.children.size(); o++)
+      Obj2XML(xChunk, *chunk->data.children[o]);
+  }
+}
+
 static ReplayStatus Structured2XML(const char *filename, const RDCFile &file, uint64_t version,
                                    const StructuredChunkList &chunks,
                                    RENDERDOC_ProgressCallback progress)
@@ -396,55 +441,106 @@ static ReplayStatus Structured2XML(const char *filename, const RDCFile &file, ui
   if(progress)
     progress(StructuredProgress(0.2f));
 
-  pugi::xml_node xChunks = xRoot.append_child("chunks");
-
-  xChunks.append_attribute("version") = version;
+  // stream the output to disk instead of building the whole document in memory - a large capture
+  // can produce multi-GB XML. We write the header/sections document with the root element left
+  // open, stream the chunks into it, then close the root by hand.
+  xml_file_writer writer(filename);
 
-  for(size_t c = 0; c < chunks.size(); c++)
   {
-    pugi::xml_node xChunk = xChunks.append_child("chunk");
-    SDChunk *chunk = chunks[c];
+    const char xmlHeader[] = "<?xml version=\"1.0\"?>\n<rdc>\n";
+    writer.stream.Write(xmlHeader, sizeof(xmlHeader) - 1);
+
+    for(pugi::xml_node node = xRoot.first_child(); node; node = node.next_sibling())
+      node.print(writer, "\t", pugi::format_default, pugi::encoding_auto, 1);
+
+    std::string xChunks = StringFormat::Fmt("\t<chunks version=\"%llu\">\n", version);
+    writer.stream.Write(xChunks.c_str(), xChunks.size());
+  }
+
+  // chunks are independent, so convert batches of them to XML text on a pool of worker threads and
+  // stitch the results together in order. Each worker builds a local document fragment per batch -
+  // pugixml documents aren't thread-safe, but separate documents are independent.
+  const size_t chunksPerBatch = 512;
+  const size_t numBatches = (chunks.size() + chunksPerBatch - 1) / chunksPerBatch;
+
+  std::vector<std::string> batchXML(numBatches);
+  std::vector<int32_t> batchReady(numBatches, 0);
 
-    xChunk.append_attribute("id") = chunk->metadata.chunkID;
-    xChunk.append_attribute("name") = chunk->name.c_str();
-    xChunk.append_attribute("length") = chunk->metadata.length;
-    if(chunk->metadata.threadID)
-      xChunk.append_attribute("threadID") = chunk->metadata.threadID;
-    if(chunk->metadata.timestampMicro)
-      xChunk.append_attribute("timestamp") = chunk->metadata.timestampMicro;
-    if(chunk->metadata.durationMicro >= 0)
-      xChunk.append_attribute("duration") = chunk->metadata.durationMicro;
-    if(chunk->metadata.flags & SDChunkFlags::HasCallstack)
+  volatile int32_t nextBatch = 0;
+  volatile int32_t writtenBatches = 0;
+
+  uint32_t numThreads = RDCMIN(Threading::NumberOfCores(), (uint32_t)numBatches);
+
+  // bound how far conversion can run ahead of the file writer, so only a window of converted XML
+  // is resident at any time.
+  const int32_t inflightLimit = int32_t(numThreads) * 4;
+
+  std::function<void()> convertThread = [&chunks, &batchXML, &batchReady, &nextBatch,
+                                         &writtenBatches, chunksPerBatch, numBatches,
+                                         inflightLimit]() {
+    for(;;)
     {
-      pugi::xml_node stack = xChunk.append_child("callstack");
+      int32_t batch = Atomic::Inc32(&nextBatch) - 1;
+
+      if(batch >= (int32_t)numBatches)
+        break;
+
+      while(batch - writtenBatches >= inflightLimit)
+        Threading::Sleep(2);
+
+      pugi::xml_document fragment;
 
-      for(size_t i = 0; i < chunk->metadata.callstack.size(); i++)
+      size_t first = batch * chunksPerBatch;
+      size_t last = RDCMIN(first + chunksPerBatch, chunks.size());
+
+      for(size_t c = first; c < last; c++)
       {
-        stack.append_child("address").text() = chunk->metadata.callstack[i];
+        pugi::xml_node xChunk = fragment.append_child("chunk");
+        Chunk2XML(xChunk, chunks[c]);
       }
-    }
 
-    if(chunk->metadata.flags & SDChunkFlags::OpaqueChunk)
-    {
-      xChunk.append_attribute("opaque") = true;
+      xml_string_writer stringWriter(batchXML[batch]);
 
-      RDCASSERT(!chunk->data.children.empty());
-      pugi::xml_node opaque = xChunk.append_child("buffer");
-      opaque.append_attribute("byteLength") = chunk->data.children[0]->type.byteSize;
-      opaque.text() = chunk->data.children[0]->data.basic.u;
-    }
-    else
-    {
-      for(size_t o = 0; o < chunk->data.children.size(); o++)
-        Obj2XML(xChunk, *chunk->data.children[o]);
+      for(pugi::xml_node node = fragment.first_child(); node; node = node.next_sibling())
+        node.print(stringWriter, "\t", pugi::format_default, pugi::encoding_auto, 2);
+
+      // publish the batch. Inc32 is a full barrier, so the string contents are visible to the
+      // writer before the flag is.
+      Atomic::Inc32(&batchReady[batch]);
     }
+  };
+
+  std::vector<Threading::ThreadHandle> threads;
+  for(uint32_t i = 0; i < numThreads; i++)
+    threads.push_back(Threading::CreateThread(convertThread));
+
+  // write each batch as soon as it's converted, in order, releasing the memory as we go.
+  for(size_t batch = 0; batch < numBatches; batch++)
+  {
+    while(Atomic::CmpExch32(&batchReady[batch], 1, 1) == 0)
+      Threading::Sleep(1);
+
+    writer.stream.Write(batchXML[batch].c_str(), batchXML[batch].size());
+
+    // free the batch's memory now it's written
+    std::string().swap(batchXML[batch]);
+
+    Atomic::Inc32(&writtenBatches);
 
     if(progress)
-      progress(StructuredProgress(0.2f + 0.8f * (float(c) / float(chunks.size()))));
+      progress(StructuredProgress(0.2f + 0.8f * (float(batch) / float(numBatches))));
   }
 
-  xml_file_writer writer(filename);
-  doc.save(writer);
+  for(Threading::ThreadHandle thread : threads)
+  {
+    Threading::JoinThread(thread);
+    Threading::CloseThread(thread);
+  }
+
+  {
+    const char xmlFooter[] = "\t</chunks>\n</rdc>\n";
+    writer.stream.Write(xmlFooter, sizeof(xmlFooter) - 1);
+  }
 
   return writer.stream.IsErrored() ? ReplayStatus::FileIOFailed : ReplayStatus::Succeeded;
 }
@@ -190,4 +190,124 @@ TEST_CASE("Test ZSTD compression/decompression", "[streamio][zstd]")
   delete[] randomData;
 };
 
+TEST_CASE("Test pipelined background decompression", "[streamio][lz4]")
+{
+  StreamWriter buf(StreamWriter::DefaultScratchSize);
+
+  // use enough data that the pipelined reader has to cycle through several windows
+  const uint64_t dataSize = PipelinedDecompressor::WindowSize * 3 + 12345;
+
+  byte *sourceData = new byte[dataSize];
+
+  for(uint64_t i = 0; i < dataSize; i++)
+    sourceData[i] = byte((i * 7) & 0xff);
+
+  // write the data
+  {
+    StreamWriter writer(new LZ4Compressor(&buf, Ownership::Nothing), Ownership::Stream);
+
+    writer.Write(sourceData, dataSize);
+
+    CHECK_FALSE(writer.IsErrored());
+
+    writer.Finish();
+
+    CHECK_FALSE(writer.IsErrored());
+  }
+
+  // decompress it through the pipelined wrapper, reading in odd-sized pieces so reads straddle
+  // window boundaries
+  {
+    StreamReader reader(
+        new PipelinedDecompressor(
+            new LZ4Decompressor(new StreamReader(buf.GetData(), buf.GetOffset()), Ownership::Stream),
+            dataSize, Ownership::Stream),
+        dataSize, Ownership::Stream);
+
+    byte *readData = new byte[dataSize];
+
+    const uint64_t pieceSize = 100 * 1000;
+
+    uint64_t offs = 0;
+    while(offs < dataSize)
+    {
+      uint64_t readBytes = RDCMIN(pieceSize, dataSize - offs);
+      reader.Read(readData + offs, readBytes);
+      offs += readBytes;
+    }
+
+    CHECK_FALSE(memcmp(readData, sourceData, (size_t)dataSize));
+
+    CHECK_FALSE(reader.IsErrored());
+    CHECK(reader.AtEnd());
+
+    delete[] readData;
+  }
+
+  delete[] sourceData;
+};
+
+TEST_CASE("Test flushing LZ4 compression for streaming transports", "[streamio][lz4]")
+{
+  StreamWriter buf(StreamWriter::DefaultScratchSize);
+
+  // deliberately awkward sizes - none of them page-aligned, some smaller than a block, one
+  // spanning several blocks - so flushes emit partial blocks at varying offsets.
+  const uint64_t messageSizes[] = {100, 70000, 5, 300000, 1, 64 * 1024};
+
+  uint64_t dataSize = 0;
+  for(uint64_t sz : messageSizes)
+    dataSize += sz;
+
+  byte *sourceData = new byte[dataSize];
+
+  for(uint64_t i = 0; i < dataSize; i++)
+    sourceData[i] = byte((i * 13 + (i >> 7)) & 0xff);
+
+  // write the data, flushing after each message like the proxy serialiser does after each chunk
+  {
+    StreamWriter writer(new LZ4FlushingCompressor(&buf, Ownership::Nothing), Ownership::Stream);
+
+    const byte *src = sourceData;
+    for(uint64_t sz : messageSizes)
+    {
+      writer.Write(src, sz);
+      writer.Flush();
+      src += sz;
+    }
+
+    CHECK_FALSE(writer.IsErrored());
+
+    writer.Finish();
+
+    CHECK_FALSE(writer.IsErrored());
+  }
+
+  // read it back through the streaming constructor, which doesn't know the decompressed size
+  // up-front - as on a socket. Each message must be satisfied by the blocks flushed for it,
+  // without reading ahead into data that wouldn't have arrived yet.
+  {
+    StreamReader reader(
+        new LZ4Decompressor(new StreamReader(buf.GetData(), buf.GetOffset()), Ownership::Stream),
+        Ownership::Stream);
+
+    byte *readData = new byte[dataSize];
+
+    uint64_t offs = 0;
+    for(uint64_t sz : messageSizes)
+    {
+      reader.Read(readData + offs, sz);
+      offs += sz;
+    }
+
+    CHECK_FALSE(memcmp(readData, sourceData, (size_t)dataSize));
+
+    CHECK_FALSE(reader.IsErrored());
+
+    delete[] readData;
+  }
+
+  delete[] sourceData;
+};
+
 #endif    // ENABLED(ENABLE_UNIT_TESTS)
@@ -152,6 +152,22 @@ bool LZ4Compressor::FlushPage0()
   return success;
 }
 
+bool LZ4FlushingCompressor::Flush()
+{
+  // if we encountered a stream error this will be NULL
+  if(!m_CompressBuffer)
+    return false;
+
+  bool success = true;
+
+  // emit any buffered input as a partial block. If the page is empty there's nothing to emit -
+  // everything written so far is already on the wire.
+  if(m_PageOffset > 0)
+    success &= FlushPage0();
+
+  return success && m_Write->Flush();
+}
+
 LZ4Decompressor::LZ4Decompressor(StreamReader *read, Ownership own) : Decompressor(read, own)
 {
   m_Page[0] = AllocAlignedBuffer(lz4BlockSize);
@@ -36,7 +36,7 @@ public:
   bool Write(const void *data, uint64_t numBytes);
   bool Finish();
 
-private:
+protected:
   bool FlushPage0();
 
   byte *m_Page[2];
@@ -46,6 +46,18 @@ private:
   LZ4_stream_t m_LZ4Comp;
 };
 
+// variant for interactive transports like the remote replay connection: Flush() emits whatever is
+// buffered as a (possibly partial) block and flushes the underlying writer, so the reading end can
+// make progress without waiting for a full block. The decompressor handles variable-sized blocks
+// already so LZ4Decompressor reads both layouts, but partial blocks cost some compression ratio -
+// file writing keeps using LZ4Compressor where Flush() is a no-op.
+class LZ4FlushingCompressor : public LZ4Compressor
+{
+public:
+  LZ4FlushingCompressor(StreamWriter *write, Ownership own) : LZ4Compressor(write, own) {}
+  bool Flush();
+};
+
 class LZ4Decompressor : public Decompressor
 {
 public:
@@ -131,6 +131,10 @@ bool is_exr_file(FILE *f)
 
 static const uint32_t MAGIC_HEADER = MAKE_FOURCC('R', 'D', 'O', 'C');
 
+// magic number of the sidecar metadata index, stored next to the capture as <filename>.index
+static const uint32_t MAGIC_INDEX = MAKE_FOURCC('R', 'D', 'C', 'I');
+static const uint32_t INDEX_VERSION = 1;
+
 namespace
 {
 struct FileHeader
@@ -207,6 +211,62 @@ struct BinarySectionHeader
   // char name[sectionNameLength];
   // byte data[sectionLength];
 };
+
+// the sidecar metadata index duplicates everything needed to populate an RDCFile's metadata -
+// thumbnail, driver, machine ident and the section directory - so that it can be read in one
+// small I/O without seeking through the whole capture, which is slow on network storage. The
+// capture file remains authoritative: the index records the capture's size and modification
+// timestamp at write time, and if either doesn't match (or the index is missing or malformed in
+// any way) we silently fall back to the full header scan.
+struct MetadataIndexHeader
+{
+  uint64_t magic;
+  uint32_t indexVersion;
+  // SERIALISE_VERSION of the capture itself
+  uint32_t serVer;
+
+  // size and modification timestamp of the capture when the index was written, used to detect
+  // stale indices
+  uint64_t fileSize;
+  uint64_t timestamp;
+
+  uint64_t machineIdent;
+  uint32_t driverID;
+  // length in bytes of the driver name including null terminator
+  uint32_t driverNameLength;
+
+  // the thumbnail as stored in RDCThumb - if an extended thumbnail section exists this is already
+  // the extended data, so the section doesn't need to be decompressed on open
+  uint16_t thumbWidth;
+  uint16_t thumbHeight;
+  uint32_t thumbFormat;
+  uint32_t thumbLength;
+
+  uint32_t sectionCount;
+
+  // followed by:
+  // char driverName[driverNameLength];
+  // byte thumbData[thumbLength];
+  // sectionCount * { MetadataIndexSection; char name[nameLength]; }
+};
+
+struct MetadataIndexSection
+{
+  // SectionProperties for this section
+  uint32_t type;
+  uint32_t flags;
+  uint64_t version;
+  uint64_t compressedSize;
+  uint64_t uncompressedSize;
+  // SectionLocation for this section, locating the data within the capture file
+  uint64_t headerOffset;
+  uint64_t dataOffset;
+  uint64_t diskLength;
+  // byte length of the name including null terminator
+  uint32_t nameLength;
+
+  // char name[nameLength];
+};
 };
 
 #define SETERROR(error, ...)                        \
@@ -222,8 +282,23 @@ struct BinarySectionHeader
     return;                       \
   }
 
+// sections replaced by an in-place update are left behind in the file as tombstones, identified
+// by an Unknown type and a name consisting entirely of '~'s. See RDCFile::WriteSection() and
+// RDCFile::TombstoneSection().
+static bool IsTombstonedSection(SectionType type, const std::string &name)
+{
+  return type == SectionType::Unknown && !name.empty() &&
+         name.find_first_not_of('~') == std::string::npos;
+}
+
 RDCFile::~RDCFile()
 {
+  if(m_MapBase)
+  {
+    UnregisterStableMemoryRange(m_MapBase);
+    FileIO::ReleaseMapping(m_MapBase, m_MapSize);
+  }
+
   if(m_File)
     FileIO::fclose(m_File);
 
@@ -283,9 +358,31 @@ void RDCFile::Open(const char *path)
   uint64_t fileSize = FileIO::ftell64(m_File);
   FileIO::fseek64(m_File, 0, SEEK_SET);
 
-  StreamReader reader(m_File, fileSize, Ownership::Nothing);
+  // an up-to-date sidecar index gives us the metadata and section directory in one small read,
+  // skipping the scan through the whole file below.
+  if(!TryOpenMetadataIndex(fileSize))
+  {
+    StreamReader reader(m_File, fileSize, Ownership::Nothing);
+
+    Init(reader);
 
-  Init(reader);
+    // index the file so the next open is fast. This also covers captures written by older
+    // versions, which get indexed the first time they're opened.
+    if(m_Error == ContainerError::NoError)
+      WriteMetadataIndex();
+  }
+
+  // try to map the file for zero-copy section reads. If this fails (e.g. 32-bit process with a
+  // huge capture) we silently fall back to buffered FILE* reads in ReadSection.
+  if(m_Error == ContainerError::NoError)
+  {
+    m_MapBase = FileIO::MapReadOnly(m_File, fileSize);
+    m_MapSize = m_MapBase ? fileSize : 0;
+
+    // deserialised values can borrow views straight into the mapping - see EnableBorrowedViews
+    if(m_MapBase)
+      RegisterStableMemoryRange(m_MapBase, m_MapBase + m_MapSize);
+  }
 }
 
 void RDCFile::Open(const std::vector<byte> &buffer)
@@ -523,8 +620,15 @@ void RDCFile::Init(StreamReader &reader)
         RETURNERROR(ContainerError::Corrupt, "Error seeking past ASCII section '%s' data",
                     name.c_str());
 
-      m_Sections.push_back(props);
-      m_SectionLocations.push_back(loc);
+      if(IsTombstonedSection(props.type, props.name))
+      {
+        m_HasTombstones = true;
+      }
+      else
+      {
+        m_Sections.push_back(props);
+        m_SectionLocations.push_back(loc);
+      }
     }
     else if(sectionHeader.isASCII == 0x0)
     {
@@ -564,8 +668,15 @@ void RDCFile::Init(StreamReader &reader)
       loc.dataOffset = reader.GetOffset();
       loc.diskLength = sectionHeader.sectionCompressedLength;
 
-      m_Sections.push_back(props);
-      m_SectionLocations.push_back(loc);
+      if(IsTombstonedSection(props.type, props.name))
+      {
+        m_HasTombstones = true;
+      }
+      else
+      {
+        m_Sections.push_back(props);
+        m_SectionLocations.push_back(loc);
+      }
 
       reader.SkipBytes(loc.diskLength);
 
@@ -615,13 +726,340 @@ void RDCFile::Init(StreamReader &reader)
   }
 }
 
+bool RDCFile::TryOpenMetadataIndex(uint64_t fileSize)
+{
+  RDCCOMPILE_ASSERT(sizeof(MetadataIndexHeader) == 64,
+                    "MetadataIndexHeader size has changed or contains padding");
+
+  std::string indexPath = m_Filename + ".index";
+
+  FILE *f = FileIO::fopen(indexPath.c_str(), "rb");
+
+  if(!f)
+    return false;
+
+  FileIO::fseek64(f, 0, SEEK_END);
+  uint64_t indexSize = FileIO::ftell64(f);
+  FileIO::fseek64(f, 0, SEEK_SET);
+
+  // the index should only be a thumbnail plus a few hundred bytes, reject anything implausible
+  if(indexSize < sizeof(MetadataIndexHeader) || indexSize > 64 * 1024 * 1024)
+  {
+    FileIO::fclose(f);
+    return false;
+  }
+
+  // read the whole index in one go
+  std::vector<byte> buffer;
+  buffer.resize((size_t)indexSize);
+  size_t numRead = FileIO::fread(buffer.data(), 1, (size_t)indexSize, f);
+
+  FileIO::fclose(f);
+
+  if(numRead != (size_t)indexSize)
+    return false;
+
+  StreamReader reader(buffer);
+
+  MetadataIndexHeader header;
+  reader.Read(header);
+
+  if(reader.IsErrored() || header.magic != MAGIC_INDEX || header.indexVersion != INDEX_VERSION)
+    return false;
+
+  if(header.serVer != SERIALISE_VERSION && header.serVer != V1_0_VERSION)
+    return false;
+
+  // stale index - the capture has been modified since it was written. Ignore it, the full open
+  // below will rewrite it.
+  if(header.fileSize != fileSize || header.timestamp != FileIO::GetModifiedTimestamp(m_Filename))
+    return false;
+
+  // sanity check against corruption, with the same limits as the full header parse
+  if(header.thumbLength > 10 * 1024 * 1024 || header.driverNameLength == 0 ||
+     header.driverNameLength > 256 || header.thumbFormat >= (uint32_t)FileType::Count ||
+     header.sectionCount == 0 || header.sectionCount > 64)
+    return false;
+
+  std::string driverName;
+  driverName.resize(header.driverNameLength - 1);
+  reader.Read(&driverName[0], header.driverNameLength - 1);
+  reader.SkipBytes(1);
+
+  byte *thumbData = NULL;
+  if(header.thumbLength > 0)
+  {
+    thumbData = new byte[header.thumbLength];
+    reader.Read(thumbData, header.thumbLength);
+  }
+
+  std::vector<SectionProperties> sections;
+  std::vector<SectionLocation> locations;
+
+  bool hasFrameCapture = false;
+
+  for(uint32_t i = 0; i < header.sectionCount && !reader.IsErrored(); i++)
+  {
+    MetadataIndexSection entry;
+    reader.Read(entry);
+
+    if(reader.IsErrored() || entry.nameLength == 0 || entry.nameLength > 2 * 1024 ||
+       entry.dataOffset + entry.diskLength > fileSize)
+      break;
+
+    SectionProperties props;
+    props.type = (SectionType)entry.type;
+    props.flags = (SectionFlags)entry.flags;
+    props.version = entry.version;
+    props.compressedSize = entry.compressedSize;
+    props.uncompressedSize = entry.uncompressedSize;
+
+    props.name.resize(entry.nameLength - 1);
+    reader.Read(&props.name[0], entry.nameLength - 1);
+    reader.SkipBytes(1);
+
+    SectionLocation loc;
+    loc.headerOffset = entry.headerOffset;
+    loc.dataOffset = entry.dataOffset;
+    loc.diskLength = entry.diskLength;
+
+    hasFrameCapture |= (props.type == SectionType::FrameCapture);
+
+    sections.push_back(props);
+    locations.push_back(loc);
+  }
+
+  // an index that doesn't describe a valid capture is no use
+  if(reader.IsErrored() || sections.size() != header.sectionCount || !hasFrameCapture)
+  {
+    delete[] thumbData;
+    return false;
+  }
+
+  m_SerVer = header.serVer;
+  m_Driver = (RDCDriver)header.driverID;
+  m_DriverName = driverName;
+  m_MachineIdent = header.machineIdent;
+
+  m_Thumb.width = header.thumbWidth;
+  m_Thumb.height = header.thumbHeight;
+  m_Thumb.len = header.thumbLength;
+  m_Thumb.format = (FileType)header.thumbFormat;
+
+  if(m_Thumb.len > 0 && m_Thumb.width > 0 && m_Thumb.height > 0)
+  {
+    m_Thumb.pixels = thumbData;
+    thumbData = NULL;
+  }
+
+  delete[] thumbData;
+
+  m_Sections.swap(sections);
+  m_SectionLocations.swap(locations);
+
+  // tombstoned sections aren't listed in the index, but they show up as gaps: if the file header
+  // plus the live sections don't cover the whole file, there's dead space to reclaim on the next
+  // save through CopyFileTo().
+  uint64_t firstHeaderOffset = m_SectionLocations[0].headerOffset;
+  uint64_t coveredBytes = 0;
+
+  for(size_t i = 0; i < m_SectionLocations.size(); i++)
+  {
+    const SectionLocation &loc = m_SectionLocations[i];
+
+    firstHeaderOffset = RDCMIN(firstHeaderOffset, loc.headerOffset);
+    coveredBytes += (loc.dataOffset - loc.headerOffset) + loc.diskLength;
+  }
+
+  m_HasTombstones = (firstHeaderOffset + coveredBytes != fileSize);
+
+  RDCDEBUG("Opened %s from metadata index", m_Filename.c_str());
+
+  return true;
+}
+
+bool RDCFile::WriteMetadataIndex()
+{
+  if(m_Filename.empty() || m_Error != ContainerError::NoError || m_Driver == RDCDriver::Image)
+    return false;
+
+  // in-memory sections have no location on disk, so the file can't be indexed
+  if(m_File == NULL || m_Sections.empty() || !m_MemorySections.empty())
+    return false;
+
+  uint64_t prevPos = FileIO::ftell64(m_File);
+  FileIO::fseek64(m_File, 0, SEEK_END);
+  uint64_t fileSize = FileIO::ftell64(m_File);
+  FileIO::fseek64(m_File, prevPos, SEEK_SET);
+
+  std::string indexPath = m_Filename + ".index";
+
+  FILE *f = FileIO::fopen(indexPath.c_str(), "wb");
+
+  // the capture may live somewhere we can't write, e.g. a read-only network share. The index is
+  // only an accelerator so this isn't an error.
+  if(!f)
+    return false;
+
+  MetadataIndexHeader header = {};
+  header.magic = MAGIC_INDEX;
+  header.indexVersion = INDEX_VERSION;
+  header.serVer = m_SerVer ? m_SerVer : SERIALISE_VERSION;
+  header.fileSize = fileSize;
+  header.timestamp = FileIO::GetModifiedTimestamp(m_Filename);
+  header.machineIdent = m_MachineIdent;
+  header.driverID = (uint32_t)m_Driver;
+  header.driverNameLength = uint32_t(m_DriverName.size() + 1);
+  header.thumbWidth = m_Thumb.width;
+  header.thumbHeight = m_Thumb.height;
+  header.thumbFormat = (uint32_t)m_Thumb.format;
+  header.thumbLength = m_Thumb.len;
+  header.sectionCount = (uint32_t)m_Sections.size();
+
+  bool success = false;
+
+  {
+    StreamWriter writer(f, Ownership::Nothing);
+
+    writer.Write(header);
+    writer.Write(m_DriverName.c_str(), header.driverNameLength);
+
+    if(m_Thumb.len > 0)
+      writer.Write(m_Thumb.pixels, m_Thumb.len);
+
+    for(size_t i = 0; i < m_Sections.size(); i++)
+    {
+      const SectionProperties &props = m_Sections[i];
+      const SectionLocation &loc = m_SectionLocations[i];
+
+      MetadataIndexSection entry = {};
+      entry.type = (uint32_t)props.type;
+      entry.flags = (uint32_t)props.flags;
+      entry.version = props.version;
+      entry.compressedSize = props.compressedSize;
+      entry.uncompressedSize = props.uncompressedSize;
+      entry.headerOffset = loc.headerOffset;
+      entry.dataOffset = loc.dataOffset;
+      entry.diskLength = loc.diskLength;
+      entry.nameLength = uint32_t(props.name.size() + 1);
+
+      writer.Write(entry);
+      writer.Write(props.name.c_str(), entry.nameLength);
+    }
+
+    success = !writer.IsErrored();
+  }
+
+  FileIO::fclose(f);
+
+  // never leave a half-written index behind
+  if(!success)
+    FileIO::Delete(indexPath.c_str());
+
+  return success;
+}
+
 bool RDCFile::CopyFileTo(const char *filename)
 {
   if(!m_File)
     return false;
 
-  // remember our position and close the file
+  // remember our position
   uint64_t prevPos = FileIO::ftell64(m_File);
+
+  if(m_HasTombstones)
+  {
+    // the file contains tombstoned sections - dead bytes left behind by section updates. Rather
+    // than duplicating them into the copy, compact as we go by writing only the file header and
+    // the live sections.
+    FILE *dst = FileIO::fopen(filename, "w+b");
+
+    if(dst == NULL)
+    {
+      RDCERR("Couldn't open '%s' for writing", filename);
+      return false;
+    }
+
+    // the global file header is everything before the first section on disk
+    uint64_t fileHeaderLength = m_SectionLocations[0].headerOffset;
+    for(size_t i = 1; i < m_SectionLocations.size(); i++)
+      fileHeaderLength = RDCMIN(fileHeaderLength, m_SectionLocations[i].headerOffset);
+
+    std::vector<SectionLocation> newLocations = m_SectionLocations;
+
+    StreamWriter writer(dst, Ownership::Nothing);
+
+    {
+      FileIO::fseek64(m_File, 0, SEEK_SET);
+      StreamReader reader(m_File, fileHeaderLength, Ownership::Nothing);
+      StreamTransfer(&writer, &reader, NULL);
+    }
+
+    // copy each live section's header and data together, recording where it lands
+    for(size_t i = 0; i < m_SectionLocations.size(); i++)
+    {
+      const SectionLocation &loc = m_SectionLocations[i];
+
+      uint64_t headerLen = loc.dataOffset - loc.headerOffset;
+
+      newLocations[i].headerOffset = writer.GetOffset();
+      newLocations[i].dataOffset = newLocations[i].headerOffset + headerLen;
+
+      FileIO::fseek64(m_File, loc.headerOffset, SEEK_SET);
+      StreamReader reader(m_File, headerLen + loc.diskLength, Ownership::Nothing);
+      StreamTransfer(&writer, &reader, NULL);
+    }
+
+    writer.Flush();
+
+    bool success = !writer.IsErrored();
+
+    uint64_t newSize = writer.GetOffset();
+
+    FileIO::fclose(dst);
+
+    if(!success)
+    {
+      RDCERR("I/O error compacting capture to '%s'", filename);
+      FileIO::Delete(filename);
+      FileIO::fseek64(m_File, prevPos, SEEK_SET);
+      return false;
+    }
+
+    // switch over to the compacted copy. The mapping (if any) reflects the old layout, so remap.
+    if(m_MapBase)
+    {
+      UnregisterStableMemoryRange(m_MapBase);
+      FileIO::ReleaseMapping(m_MapBase, m_MapSize);
+    }
+    m_MapBase = NULL;
+    m_MapSize = 0;
+
+    FileIO::fclose(m_File);
+
+    m_Filename = filename;
+    m_SectionLocations = newLocations;
+    m_HasTombstones = false;
+
+    m_File = FileIO::fopen(m_Filename.c_str(), "rb");
+    FileIO::fseek64(m_File, prevPos, SEEK_SET);
+
+    if(m_File)
+    {
+      m_MapBase = FileIO::MapReadOnly(m_File, newSize);
+      m_MapSize = m_MapBase ? newSize : 0;
+
+      if(m_MapBase)
+        RegisterStableMemoryRange(m_MapBase, m_MapBase + m_MapSize);
+    }
+
+    // refresh the sidecar index to match the compacted layout
+    WriteMetadataIndex();
+
+    return true;
+  }
+
+  // close the file ready to copy it
   FileIO::fclose(m_File);
 
   // try to move to the new location
@@ -799,23 +1237,39 @@ StreamReader *RDCFile::ReadSection(int index) const
 
   const SectionProperties &props = m_Sections[index];
   SectionLocation offsetSize = m_SectionLocations[index];
+
+  bool compressed = (props.flags & SectionFlags::LZ4Compressed) ||
+                    (props.flags & SectionFlags::ZstdCompressed);
+
+  // uncompressed sections can be read zero-copy straight out of the mapped file, with no
+  // intermediate heap copy at all.
+  if(m_MapBase && !compressed)
+    return new StreamReader(StreamReader::ExternalBuffer, m_MapBase + offsetSize.dataOffset,
+                            offsetSize.diskLength);
+
   FileIO::fseek64(m_File, offsetSize.dataOffset, SEEK_SET);
 
   StreamReader *fileReader = new StreamReader(m_File, offsetSize.diskLength, Ownership::Nothing);
 
   StreamReader *compReader = NULL;
 
+  Decompressor *decomp = NULL;
+
   if(props.flags & SectionFlags::LZ4Compressed)
-  {
-    // the user will delete the compressed reader, and then it will delete the compressor and the
-    // file reader
-    compReader = new StreamReader(new LZ4Decompressor(fileReader, Ownership::Stream),
-                                  props.uncompressedSize, Ownership::Stream);
-  }
+    decomp = new LZ4Decompressor(fileReader, Ownership::Stream);
   else if(props.flags & SectionFlags::ZstdCompressed)
+    decomp = new ZSTDDecompressor(fileReader, Ownership::Stream);
+
+  if(decomp)
   {
-    compReader = new StreamReader(new ZSTDDecompressor(fileReader, Ownership::Stream),
-                                  props.uncompressedSize, Ownership::Stream);
+    // for sections large enough to be worth a thread, decompress the next window in the background
+    // while the caller parses the current one. Small sections (thumbnails etc) stay synchronous.
+    if(props.uncompressedSize >= PipelinedDecompressor::WindowSize * 4)
+      decomp = new PipelinedDecompressor(decomp, props.uncompressedSize, Ownership::Stream);
+
+    // the user will delete the compressed reader, and then it will delete the decompressor and the
+    // file reader
+    compReader = new StreamReader(decomp, props.uncompressedSize, Ownership::Stream);
   }
 
   // if we're compressing return that writer, otherwise return the file writer directly
@@ -1006,10 +1460,13 @@ StreamWriter *RDCFile::WriteSection(const SectionProperties &props)
     }
     else
     {
-      // we're writing some section after the frame capture. We'll do this in-place by reading the
-      // other sections out to memory (assuming that they are mostly small, and even if they are
-      // somewhat large, it's still much better to leave the frame capture (which should dominate
-      // file size) on disk where it is.
+      // we're updating some section after the frame capture. Rather than rewriting everything
+      // that comes after the old section - which on a multi-GB capture means shuffling the bulk of
+      // the file to save a few KB of metadata - we append the new version at the end of the file
+      // and tombstone the old one. The tombstone is just the old header patched to an Unknown type
+      // with a junk name, so readers old and new skip over the dead bytes via the lengths still
+      // recorded in the header. The wasted space is reclaimed the next time the capture is saved
+      // out through CopyFileTo().
       int index = SectionIndex(type);
 
       if(index < 0)
@@ -1017,72 +1474,46 @@ StreamWriter *RDCFile::WriteSection(const SectionProperties &props)
 
       RDCASSERT(index >= 0);
 
-      std::vector<bytebuf> origSectionData;
-      std::vector<uint64_t> origHeaderSizes;
-
-      uint64_t overwriteLocation = m_SectionLocations[index].headerOffset;
-      uint64_t oldLength = m_SectionLocations[index].diskLength;
-
-      // erase the target section. The others will be moved up to match
-      m_Sections.erase(m_Sections.begin() + index);
-      m_SectionLocations.erase(m_SectionLocations.begin() + index);
-
-      origSectionData.reserve(NumSections() - index);
-      origHeaderSizes.reserve(NumSections() - index);
-
-      // go through all subsequent sections after this one in the file, read them into memory.
-      // this could be optimised since we're going to write them back out below, we could do this
-      // just with an in-memory window large enough.
-      for(int i = index; i < NumSections(); i++)
+      if(index == NumSections() - 1)
       {
-        const SectionLocation &loc = m_SectionLocations[i];
+        // the old section is already last in the file, so just overwrite it in place - repeatedly
+        // updating the same section shouldn't grow the file with a trail of tombstones.
+        uint64_t oldLength = m_SectionLocations[index].diskLength;
 
-        FileIO::fseek64(m_File, loc.headerOffset, SEEK_SET);
+        FileIO::fseek64(m_File, m_SectionLocations[index].headerOffset, SEEK_SET);
 
-        uint64_t headerLen = loc.dataOffset - loc.headerOffset;
+        m_Sections.erase(m_Sections.begin() + index);
+        m_SectionLocations.erase(m_SectionLocations.begin() + index);
 
-        // read header and data together
-        StreamReader reader(m_File, headerLen + loc.diskLength, Ownership::Nothing);
-
-        origHeaderSizes.push_back(headerLen);
-        origSectionData.push_back(bytebuf());
-
-        bytebuf &data = origSectionData.back();
-        data.resize((size_t)reader.GetSize());
-        reader.Read(data.data(), data.size());
+        // after writing, we need to be sure to fixup the size (in case we wrote less data).
+        modifySectionCallback = [this, oldLength]() {
+          if(oldLength > m_SectionLocations.back().diskLength)
+          {
+            FileIO::ftruncateat(m_File, m_SectionLocations.back().dataOffset +
+                                            m_SectionLocations.back().diskLength);
+          }
+        };
       }
+      else
+      {
+        SectionLocation oldLoc = m_SectionLocations[index];
+        bool oldASCII = bool(m_Sections[index].flags & SectionFlags::ASCIIStored);
 
-      // we write the sections now over where the old section used to be, so the newly written
-      // section is last in the file. This means if the same section is updated over and over, it
-      // doesn't require moving any sections once it's already at the end.
+        m_Sections.erase(m_Sections.begin() + index);
+        m_SectionLocations.erase(m_SectionLocations.begin() + index);
 
-      // seek to write to where the removed section started
-      FileIO::fseek64(m_File, overwriteLocation, SEEK_SET);
+        // seek to the end of the file to append the new version
+        FileIO::fseek64(m_File, 0, SEEK_END);
 
-      // write the old sections
-      for(size_t i = 0; i < origSectionData.size(); i++)
-      {
-        // update the offsets to where they are in the new file
-        m_SectionLocations[index + i].headerOffset = FileIO::ftell64(m_File);
-        m_SectionLocations[index + i].dataOffset =
-            m_SectionLocations[index + i].headerOffset + origHeaderSizes[i];
-
-        // write the data
-        StreamWriter writer(m_File, Ownership::Nothing);
-        writer.Write(origSectionData[i].data(), origSectionData[i].size());
+        // only tombstone the old section once the new one has been completely written and its
+        // header lengths fixed up, so that a crash mid-write leaves the old version intact.
+        modifySectionCallback = [this, oldLoc, oldASCII]() {
+          TombstoneSection(oldLoc, oldASCII);
+          m_HasTombstones = true;
+        };
       }
 
-      // after writing, we need to be sure to fixup the size (in case we wrote less data).
-      modifySectionCallback = [this, oldLength]() {
-        if(oldLength > m_SectionLocations.back().diskLength)
-        {
-          FileIO::ftruncateat(
-              m_File, m_SectionLocations.back().dataOffset + m_SectionLocations.back().diskLength);
-        }
-      };
-
-      // fall through - we now write to m_File with the new section wherever we left off after the
-      // moved sections.
+      // fall through - we now write the new section wherever we've seeked to.
     }
   }
   else
@@ -1132,8 +1563,15 @@ StreamWriter *RDCFile::WriteSection(const SectionProperties &props)
   {
     // the user will delete the compressed writer, and then it will delete the compressor and the
     // file writer
-    compWriter =
-        new StreamWriter(new LZ4Compressor(fileWriter, Ownership::Stream), Ownership::Stream);
+    Compressor *comp = new LZ4Compressor(fileWriter, Ownership::Stream);
+
+    // the frame capture section is the multi-GB bulk of the file and is written at the end of a
+    // capture while the application is stalled - run compression and disk IO on a worker thread
+    // so serialising the chunks doesn't alternate with them.
+    if(type == SectionType::FrameCapture)
+      comp = new PipelinedCompressor(comp, Ownership::Stream);
+
+    compWriter = new StreamWriter(comp, Ownership::Stream);
   }
   else if(props.flags & SectionFlags::ZstdCompressed)
   {
@@ -1200,12 +1638,80 @@ StreamWriter *RDCFile::WriteSection(const SectionProperties &props)
     // re-open the file and re-seek
     m_File = FileIO::fopen(m_Filename.c_str(), "rb");
     FileIO::fseek64(m_File, prevPos, SEEK_SET);
+
+    // refresh the sidecar index to match the new contents
+    WriteMetadataIndex();
   });
 
   // if we're compressing return that writer, otherwise return the file writer directly
   return compWriter ? compWriter : fileWriter;
 }
 
+void RDCFile::TombstoneSection(const SectionLocation &loc, bool ascii)
+{
+  // patch the dead section's header in place so readers skip over it: the type becomes Unknown and
+  // the name becomes all '~'s, both without changing any byte counts so the recorded lengths still
+  // carry a reader safely past the stale data. Old versions of the code just see an unknown
+  // user-defined section and ignore it.
+  size_t headerLen = size_t(loc.dataOffset - loc.headerOffset);
+
+  std::vector<byte> header(headerLen);
+
+  FileIO::fseek64(m_File, loc.headerOffset, SEEK_SET);
+
+  if(FileIO::fread(header.data(), 1, headerLen, m_File) != headerLen)
+  {
+    RDCERR("Error reading section header to tombstone, errno %d", errno);
+    return;
+  }
+
+  if(ascii)
+  {
+    // the ASCII header is a line each of length, type, version and name. The length and version
+    // must keep their values, so overwrite the type digits (between the first and second newlines)
+    // with '0' = Unknown, and the name characters (between the third and fourth) with '~'.
+    size_t newlines[4] = {};
+    size_t n = 0;
+
+    for(size_t i = 0; i < headerLen && n < 4; i++)
+    {
+      if(header[i] == '\n')
+        newlines[n++] = i;
+    }
+
+    if(n < 4)
+    {
+      RDCERR("Malformed ASCII section header at %llu, not tombstoning", loc.headerOffset);
+      return;
+    }
+
+    for(size_t i = newlines[0] + 1; i < newlines[1]; i++)
+      header[i] = '0';
+    for(size_t i = newlines[2] + 1; i < newlines[3]; i++)
+      header[i] = '~';
+  }
+  else
+  {
+    BinarySectionHeader *binHeader = (BinarySectionHeader *)header.data();
+
+    binHeader->sectionType = SectionType::Unknown;
+
+    // preserve the trailing NULL in the name
+    memset(header.data() + offsetof(BinarySectionHeader, name), '~',
+           binHeader->sectionNameLength - 1);
+  }
+
+  FileIO::fseek64(m_File, loc.headerOffset, SEEK_SET);
+
+  if(FileIO::fwrite(header.data(), 1, headerLen, m_File) != headerLen)
+  {
+    RDCERR("Error writing tombstoned section header, errno %d", errno);
+    return;
+  }
+
+  FileIO::fflush(m_File);
+}
+
 FILE *RDCFile::StealImageFileHandle(std::string &filename)
 {
   if(m_Driver != RDCDriver::Image)
@@ -83,6 +83,11 @@ public:
   // creates a new file with current properties, file will be overwritten if it already exists
   void Create(const char *filename);
 
+  // writes (or refreshes) the sidecar metadata index next to the capture, allowing future Opens
+  // to populate the metadata and section directory with a single small read instead of scanning
+  // the whole file. The index is purely an accelerator, so failure to write it is not an error.
+  bool WriteMetadataIndex();
+
   ContainerError ErrorCode() const { return m_Error; }
   std::string ErrorString() const { return m_ErrorString; }
   RDCDriver GetDriver() const { return m_Driver; }
@@ -102,11 +107,20 @@ public:
 
 private:
   void Init(StreamReader &reader);
+  bool TryOpenMetadataIndex(uint64_t fileSize);
+
+  struct SectionLocation;
+  void TombstoneSection(const SectionLocation &loc, bool ascii);
 
   FILE *m_File = NULL;
   std::string m_Filename;
   std::vector<byte> m_Buffer;
 
+  // read-only memory mapping of the whole file, if the OS could provide one. Uncompressed sections
+  // are read zero-copy out of this view instead of through m_File.
+  byte *m_MapBase = NULL;
+  uint64_t m_MapSize = 0;
+
   SectionProperties m_CurrentWritingProps;
 
   uint32_t m_SerVer = 0;
@@ -129,4 +143,17 @@ private:
   std::vector<SectionProperties> m_Sections;
   std::vector<SectionLocation> m_SectionLocations;
   std::vector<std::vector<byte>> m_MemorySections;
+
+  // true if the file contains tombstoned sections - dead bytes left behind when a section was
+  // updated by appending the new version at the end of the file. The space is reclaimed when the
+  // capture is next saved out through CopyFileTo().
+  bool m_HasTombstones = false;
 };
+
+// packs a capture into an archive-friendly form: the frame capture payload is moved out into
+// content-addressed blob files under blobdir, shared between any captures containing identical
+// data, and packfile is written as a normal container with an ExternalBlobs section referencing
+// the blobs. UnpackRDC reverses the process, reassembling a standalone capture from the store.
+// See SectionType::ExternalBlobs.
+ContainerError PackRDC(const char *infile, const char *packfile, const char *blobdir);
+ContainerError UnpackRDC(const char *packfile, const char *outfile, const char *blobdir);
@@ -0,0 +1,418 @@
+/******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Baldur Karlsson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "rdcfile.h"
+#include "3rdparty/zstd/xxhash.h"
+#include "serialiser.h"
+
+// see SectionType::ExternalBlobs. The section payload is a uint64 blob count followed by one
+// (hashA, hashB, size) tuple per blob, in the order the blobs concatenate to rebuild the
+// uncompressed frame capture data.
+static const uint64_t ExternalBlobsVersion = 1;
+
+struct ExternalBlob
+{
+  // two independent XXH64 hashes (seeds 0 and 1) of the blob contents. One 64-bit hash is not
+  // enough to trust content-addressing across a large corpus, two effectively gives us a 128-bit
+  // identity. The pair also names the blob file in the store.
+  uint64_t hashA;
+  uint64_t hashB;
+  uint64_t size;
+};
+
+// blobs smaller than this aren't worth a file each - segments of the frame capture are grown to
+// at least this size before being cut at the next chunk boundary.
+static const uint64_t MinimumBlobSize = 1024 * 1024;
+
+static std::string BlobFilename(const char *blobdir, const ExternalBlob &blob)
+{
+  return StringFormat::Fmt("%s/%016llx%016llx.blob", blobdir, blob.hashA, blob.hashB);
+}
+
+static bool WriteBlob(const char *blobdir, const ExternalBlob &blob, const byte *data)
+{
+  std::string filename = BlobFilename(blobdir, blob);
+
+  // identical contents hash to the same name, so if the blob exists some capture already
+  // contributed it and there's nothing to write - this is where the deduplication happens.
+  if(FileIO::exists(filename.c_str()))
+    return true;
+
+  FileIO::CreateParentDirectory(filename);
+
+  // write to a temporary name and move into place, so a crashed or concurrent pack can never
+  // leave a half-written blob under its final content-addressed name.
+  std::string tempname = StringFormat::Fmt("%s.%u.tmp", filename.c_str(), Process::GetCurrentPID());
+
+  FILE *f = FileIO::fopen(tempname.c_str(), "wb");
+
+  if(f == NULL)
+  {
+    RDCERR("Couldn't write blob file '%s'", tempname.c_str());
+    return false;
+  }
+
+  size_t numWritten = FileIO::fwrite(data, 1, (size_t)blob.size, f);
+
+  FileIO::fclose(f);
+
+  if(numWritten != (size_t)blob.size)
+  {
+    RDCERR("Error writing blob file '%s'", tempname.c_str());
+    FileIO::Delete(tempname.c_str());
+    return false;
+  }
+
+  // if another pack raced us and moved its copy in first, the contents are identical anyway.
+  FileIO::Move(tempname.c_str(), filename.c_str(), true);
+
+  return true;
+}
+
+static bool ReadBlob(const char *blobdir, const ExternalBlob &blob, byte *data)
+{
+  std::string filename = BlobFilename(blobdir, blob);
+
+  FILE *f = FileIO::fopen(filename.c_str(), "rb");
+
+  if(f == NULL)
+  {
+    RDCERR("Missing blob file '%s' - can't unpack without the blob store it was packed against",
+           filename.c_str());
+    return false;
+  }
+
+  size_t numRead = FileIO::fread(data, 1, (size_t)blob.size, f);
+
+  FileIO::fclose(f);
+
+  if(numRead != (size_t)blob.size || XXH64(data, (size_t)blob.size, 0) != blob.hashA ||
+     XXH64(data, (size_t)blob.size, 1) != blob.hashB)
+  {
+    RDCERR("Blob file '%s' doesn't match its recorded size and hashes - blob store is corrupt",
+           filename.c_str());
+    return false;
+  }
+
+  return true;
+}
+
+ContainerError PackRDC(const char *infile, const char *packfile, const char *blobdir)
+{
+  RDCFile in;
+  in.Open(infile);
+
+  if(in.ErrorCode() != ContainerError::NoError)
+    return in.ErrorCode();
+
+  if(in.SectionIndex(SectionType::ExternalBlobs) >= 0)
+  {
+    RDCERR("'%s' is already packed", infile);
+    return ContainerError::Corrupt;
+  }
+
+  int frameIdx = in.SectionIndex(SectionType::FrameCapture);
+
+  // Open() requires a frame capture section, but be safe
+  if(frameIdx < 0)
+    return ContainerError::Corrupt;
+
+  SectionProperties frameProps = in.GetSectionProperties(frameIdx);
+
+  // read the whole uncompressed frame capture into memory. Packing is offline archive tooling,
+  // so the simplicity is worth the transient memory cost.
+  std::vector<byte> data;
+
+  {
+    StreamReader *reader = in.ReadSection(frameIdx);
+
+    data.resize((size_t)reader->GetSize());
+
+    if(!data.empty())
+      reader->Read(data.data(), data.size());
+
+    bool success = !reader->IsErrored();
+
+    delete reader;
+
+    if(!success)
+      return ContainerError::FileIO;
+  }
+
+  // cut the data into segments at chunk boundaries from the chunk index, grown to at least
+  // MinimumBlobSize each. Cutting on chunk boundaries means captures sharing a prefix of chunks
+  // (e.g. the same program's initial states captured repeatedly) produce byte-identical leading
+  // segments that deduplicate in the store. Without an index the whole section is one blob, which
+  // still deduplicates bit-identical captures.
+  std::vector<uint64_t> cuts;
+  cuts.push_back(0);
+
+  {
+    std::vector<ChunkIndexEntry> index;
+
+    if(ReadChunkIndex(&in, index))
+    {
+      for(const ChunkIndexEntry &entry : index)
+      {
+        // ignore an index that doesn't match the data rather than producing bad segments
+        if(entry.offset > data.size() || entry.offset < cuts.back())
+        {
+          cuts.resize(1);
+          break;
+        }
+
+        if(entry.offset - cuts.back() >= MinimumBlobSize)
+          cuts.push_back(entry.offset);
+      }
+    }
+  }
+
+  // hash each segment and write any blobs not already in the store
+  std::vector<ExternalBlob> blobs;
+  blobs.reserve(cuts.size());
+
+  for(size_t i = 0; i < cuts.size(); i++)
+  {
+    uint64_t end = (i + 1 < cuts.size()) ? cuts[i + 1] : data.size();
+
+    ExternalBlob blob;
+    blob.size = end - cuts[i];
+    blob.hashA = XXH64(data.data() + cuts[i], (size_t)blob.size, 0);
+    blob.hashB = XXH64(data.data() + cuts[i], (size_t)blob.size, 1);
+
+    if(!WriteBlob(blobdir, blob, data.data() + cuts[i]))
+      return ContainerError::FileIO;
+
+    blobs.push_back(blob);
+  }
+
+  // write the pack file. It's a normal container - same metadata and thumbnail, every section
+  // other than the frame capture copied verbatim - so existing tools can still inspect it. The
+  // frame capture section is written zero-length with its original properties preserved, since
+  // the first section written must be the frame capture and unpacking needs the original flags
+  // and version to rewrite it faithfully.
+  ContainerError err = ContainerError::NoError;
+
+  // scoped so the output file is closed before we delete a partial file on error below
+  {
+    RDCFile out;
+
+    RDCThumb thumb = in.GetThumbnail();
+    out.SetData(in.GetDriver(), in.GetDriverName().c_str(), in.GetMachineIdent(), &thumb);
+    out.Create(packfile);
+
+    if(out.ErrorCode() != ContainerError::NoError)
+      return out.ErrorCode();
+
+    {
+      StreamWriter *w = out.WriteSection(frameProps);
+      w->Finish();
+      delete w;
+    }
+
+    for(int i = 0; i < in.NumSections() && err == ContainerError::NoError; i++)
+    {
+      if(i == frameIdx)
+        continue;
+
+      StreamReader *reader = in.ReadSection(i);
+      StreamWriter *writer = out.WriteSection(in.GetSectionProperties(i));
+
+      StreamTransfer(writer, reader, NULL);
+
+      bool success = !reader->IsErrored() && !writer->IsErrored();
+
+      writer->Finish();
+
+      delete reader;
+      delete writer;
+
+      if(!success)
+        err = ContainerError::FileIO;
+    }
+
+    if(err == ContainerError::NoError)
+    {
+      SectionProperties props = {};
+      props.type = SectionType::ExternalBlobs;
+      props.version = ExternalBlobsVersion;
+
+      StreamWriter *w = out.WriteSection(props);
+
+      uint64_t count = blobs.size();
+
+      w->Write(count);
+
+      for(const ExternalBlob &blob : blobs)
+      {
+        w->Write(blob.hashA);
+        w->Write(blob.hashB);
+        w->Write(blob.size);
+      }
+
+      if(w->IsErrored())
+        err = ContainerError::FileIO;
+
+      w->Finish();
+
+      delete w;
+    }
+  }
+
+  if(err != ContainerError::NoError)
+    FileIO::Delete(packfile);
+
+  return err;
+}
+
+ContainerError UnpackRDC(const char *packfile, const char *outfile, const char *blobdir)
+{
+  RDCFile in;
+  in.Open(packfile);
+
+  if(in.ErrorCode() != ContainerError::NoError)
+    return in.ErrorCode();
+
+  int blobIdx = in.SectionIndex(SectionType::ExternalBlobs);
+
+  if(blobIdx < 0)
+  {
+    RDCERR("'%s' is not a packed capture", packfile);
+    return ContainerError::Corrupt;
+  }
+
+  if(in.GetSectionProperties(blobIdx).version != ExternalBlobsVersion)
+  {
+    RDCERR("Unsupported pack version %llu in '%s'", in.GetSectionProperties(blobIdx).version,
+           packfile);
+    return ContainerError::UnsupportedVersion;
+  }
+
+  std::vector<ExternalBlob> blobs;
+
+  {
+    StreamReader *reader = in.ReadSection(blobIdx);
+
+    uint64_t count = 0;
+    reader->Read(count);
+
+    const uint64_t entrySize = sizeof(uint64_t) * 3;
+
+    if(reader->IsErrored() || count * entrySize > reader->GetSize())
+    {
+      delete reader;
+      RDCERR("Corrupt blob list in '%s'", packfile);
+      return ContainerError::Corrupt;
+    }
+
+    blobs.resize((size_t)count);
+
+    for(ExternalBlob &blob : blobs)
+    {
+      reader->Read(blob.hashA);
+      reader->Read(blob.hashB);
+      reader->Read(blob.size);
+    }
+
+    bool success = !reader->IsErrored();
+
+    delete reader;
+
+    if(!success)
+      return ContainerError::Corrupt;
+  }
+
+  int frameIdx = in.SectionIndex(SectionType::FrameCapture);
+
+  if(frameIdx < 0)
+    return ContainerError::Corrupt;
+
+  ContainerError err = ContainerError::NoError;
+
+  // scoped so the output file is closed before we delete a partial file on error below
+  {
+    RDCFile out;
+
+    RDCThumb thumb = in.GetThumbnail();
+    out.SetData(in.GetDriver(), in.GetDriverName().c_str(), in.GetMachineIdent(), &thumb);
+    out.Create(outfile);
+
+    if(out.ErrorCode() != ContainerError::NoError)
+      return out.ErrorCode();
+
+    // reassemble the frame capture from the blob store, under the properties preserved on the
+    // zero-length stub so the rewritten section compresses the same way the original did.
+    {
+      StreamWriter *writer = out.WriteSection(in.GetSectionProperties(frameIdx));
+
+      std::vector<byte> data;
+
+      for(const ExternalBlob &blob : blobs)
+      {
+        data.resize((size_t)blob.size);
+
+        if(!ReadBlob(blobdir, blob, data.data()))
+        {
+          err = ContainerError::FileNotFound;
+          break;
+        }
+
+        writer->Write(data.data(), data.size());
+      }
+
+      if(writer->IsErrored())
+        err = ContainerError::FileIO;
+
+      writer->Finish();
+
+      delete writer;
+    }
+
+    for(int i = 0; i < in.NumSections() && err == ContainerError::NoError; i++)
+    {
+      if(i == frameIdx || i == blobIdx)
+        continue;
+
+      StreamReader *reader = in.ReadSection(i);
+      StreamWriter *writer = out.WriteSection(in.GetSectionProperties(i));
+
+      StreamTransfer(writer, reader, NULL);
+
+      bool success = !reader->IsErrored() && !writer->IsErrored();
+
+      writer->Finish();
+
+      delete reader;
+      delete writer;
+
+      if(!success)
+        err = ContainerError::FileIO;
+    }
+  }
+
+  if(err != ContainerError::NoError)
+    FileIO::Delete(outfile);
+
+  return err;
+}
@@ -0,0 +1,325 @@
+/******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Baldur Karlsson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "api/replay/renderdoc_replay.h"
+#include "common/common.h"
+#include "common/threading.h"
+#include "os/os_specific.h"
+
+// Slab allocator backing SDObject and SDChunk - see the operator new/delete overloads in
+// structured_data.h, which route every structured object allocation through
+// RENDERDOC_AllocStructuredMem/RENDERDOC_FreeStructuredMem below.
+//
+// A structured file for a big capture contains millions of objects of only two sizes
+// (sizeof(SDObject) and sizeof(SDChunk)), all with the same lifetime - they're built up while the
+// capture is loaded or converted, then destroyed together when the file is. Allocating them
+// individually from the heap wastes time on both ends, with teardown being the worst since
+// freeing every object one-by-one at session close can take tens of seconds on large captures.
+//
+// Instead we carve fixed-size blocks out of large slabs, one slab list per block size. Each block
+// carries a pointer back to its owning slab so frees don't need a lookup, freed blocks go onto a
+// per-slab freelist for reuse, and a slab whose blocks are all free is returned to the heap
+// wholesale. One empty slab per size is kept in reserve so that alloc/free cycles at a slab
+// boundary don't thrash the heap. Keeping objects of the same size densely packed also improves
+// locality for the UI traversals that constantly walk these trees.
+
+namespace
+{
+struct Slab;
+
+// precedes every block. The pointer back to the owning slab is only needed while the block is
+// live, so once the block is freed the same word holds the freelist chain.
+union BlockHeader
+{
+  Slab *slab;
+  BlockHeader *nextFree;
+};
+
+struct Slab
+{
+  // doubly-linked list of slabs with at least one free block, per size class
+  Slab *prev;
+  Slab *next;
+
+  uint32_t blockSize;    // in bytes, including the header
+  uint32_t capacity;     // total number of blocks carved from this slab
+  uint32_t liveCount;    // blocks currently allocated
+  uint32_t bumpCount;    // blocks handed out at least once - those beyond have no freelist entry
+  BlockHeader *freelist;
+
+  byte *blocks() { return (byte *)(this + 1); }
+};
+
+struct SizeClass
+{
+  uint32_t blockSize = 0;
+  // slabs with at least one free block. Full slabs are unlinked and only rediscovered when one of
+  // their blocks is freed, via the block header.
+  Slab *partial = NULL;
+  // one empty slab kept in reserve rather than freed, to avoid heap churn when allocation counts
+  // oscillate around a slab boundary
+  Slab *spare = NULL;
+};
+
+// total allocation per slab, including the slab header
+static const size_t SlabByteSize = 256 * 1024;
+
+// in practice only sizeof(SDObject) and sizeof(SDChunk) come through here, but leave headroom in
+// case a size changes or an external subclass appears
+static const size_t MaxSizeClasses = 8;
+
+// any block too large to fit comfortably in a slab falls back to the heap, marked with a NULL
+// slab pointer in its header
+static const size_t MaxPooledBlockSize = SlabByteSize / 16;
+
+static Threading::CriticalSection poolLock;
+static SizeClass sizeClasses[MaxSizeClasses];
+
+static void UnlinkPartial(SizeClass &sc, Slab *slab)
+{
+  if(slab->prev)
+    slab->prev->next = slab->next;
+  else
+    sc.partial = slab->next;
+
+  if(slab->next)
+    slab->next->prev = slab->prev;
+
+  slab->prev = slab->next = NULL;
+}
+
+static void LinkPartial(SizeClass &sc, Slab *slab)
+{
+  slab->prev = NULL;
+  slab->next = sc.partial;
+
+  if(sc.partial)
+    sc.partial->prev = slab;
+
+  sc.partial = slab;
+}
+
+static SizeClass &GetSizeClass(uint32_t blockSize)
+{
+  for(size_t i = 0; i < MaxSizeClasses; i++)
+  {
+    if(sizeClasses[i].blockSize == blockSize)
+      return sizeClasses[i];
+
+    if(sizeClasses[i].blockSize == 0)
+    {
+      sizeClasses[i].blockSize = blockSize;
+      return sizeClasses[i];
+    }
+  }
+
+  // we only expect a tiny handful of distinct sizes, so this should be impossible
+  RDCFATAL("Too many distinct structured object sizes: %u", blockSize);
+
+  return sizeClasses[0];
+}
+};    // namespace
+
+extern "C" RENDERDOC_API void *RENDERDOC_CC RENDERDOC_AllocStructuredMem(uint64_t sz)
+{
+  // round the block up so that every block (and so every returned pointer) stays 8-byte aligned
+  uint32_t blockSize = uint32_t(AlignUp<uint64_t>(sizeof(BlockHeader) + sz, 8));
+
+  if(blockSize > MaxPooledBlockSize)
+  {
+    BlockHeader *header = (BlockHeader *)malloc(blockSize);
+    header->slab = NULL;
+    return header + 1;
+  }
+
+  SCOPED_LOCK(poolLock);
+
+  SizeClass &sc = GetSizeClass(blockSize);
+
+  Slab *slab = sc.partial;
+
+  if(slab == NULL)
+  {
+    if(sc.spare)
+    {
+      slab = sc.spare;
+      sc.spare = NULL;
+    }
+    else
+    {
+      slab = (Slab *)malloc(SlabByteSize);
+      slab->blockSize = blockSize;
+      slab->capacity = uint32_t((SlabByteSize - sizeof(Slab)) / blockSize);
+      slab->liveCount = 0;
+      slab->bumpCount = 0;
+      slab->freelist = NULL;
+    }
+
+    LinkPartial(sc, slab);
+  }
+
+  BlockHeader *header;
+
+  if(slab->freelist)
+  {
+    header = slab->freelist;
+    slab->freelist = header->nextFree;
+  }
+  else
+  {
+    header = (BlockHeader *)(slab->blocks() + slab->bumpCount * blockSize);
+    slab->bumpCount++;
+  }
+
+  slab->liveCount++;
+
+  // full slabs drop off the partial list - a free of one of their blocks brings them back
+  if(slab->liveCount == slab->capacity)
+    UnlinkPartial(sc, slab);
+
+  header->slab = slab;
+  return header + 1;
+}
+
+extern "C" RENDERDOC_API void RENDERDOC_CC RENDERDOC_FreeStructuredMem(void *mem)
+{
+  if(mem == NULL)
+    return;
+
+  BlockHeader *header = (BlockHeader *)mem - 1;
+
+  // over-sized blocks went straight to the heap
+  if(header->slab == NULL)
+  {
+    free(header);
+    return;
+  }
+
+  SCOPED_LOCK(poolLock);
+
+  Slab *slab = header->slab;
+  SizeClass &sc = GetSizeClass(slab->blockSize);
+
+  bool wasFull = (slab->liveCount == slab->capacity);
+
+  header->nextFree = slab->freelist;
+  slab->freelist = header;
+  slab->liveCount--;
+
+  if(wasFull)
+    LinkPartial(sc, slab);
+
+  if(slab->liveCount == 0)
+  {
+    UnlinkPartial(sc, slab);
+
+    if(sc.spare == NULL)
+    {
+      // keep the slab in reserve, but as-new - all blocks return to the bump region
+      slab->bumpCount = 0;
+      slab->freelist = NULL;
+      sc.spare = slab;
+    }
+    else
+    {
+      free(slab);
+    }
+  }
+}
+
+#if ENABLED(ENABLE_UNIT_TESTS)
+
+#include "3rdparty/catch/catch.hpp"
+
+TEST_CASE("Test structured object pool", "[sdobject]")
+{
+  SECTION("distinct allocations with reuse after free")
+  {
+    void *a = RENDERDOC_AllocStructuredMem(sizeof(SDObject));
+    void *b = RENDERDOC_AllocStructuredMem(sizeof(SDObject));
+    void *c = RENDERDOC_AllocStructuredMem(sizeof(SDChunk));
+
+    CHECK(a != NULL);
+    CHECK(b != NULL);
+    CHECK(c != NULL);
+    CHECK(a != b);
+
+    CHECK(uintptr_t(a) % sizeof(void *) == 0);
+    CHECK(uintptr_t(b) % sizeof(void *) == 0);
+    CHECK(uintptr_t(c) % sizeof(void *) == 0);
+
+    memset(a, 0xfe, sizeof(SDObject));
+    memset(c, 0xfe, sizeof(SDChunk));
+
+    RENDERDOC_FreeStructuredMem(b);
+
+    // the most recently freed block should be handed straight back
+    void *b2 = RENDERDOC_AllocStructuredMem(sizeof(SDObject));
+    CHECK(b2 == b);
+
+    RENDERDOC_FreeStructuredMem(a);
+    RENDERDOC_FreeStructuredMem(b2);
+    RENDERDOC_FreeStructuredMem(c);
+  }
+
+  SECTION("bulk allocation over many slabs")
+  {
+    std::vector<void *> allocs;
+    allocs.resize(100000);
+
+    for(size_t i = 0; i < allocs.size(); i++)
+    {
+      allocs[i] = RENDERDOC_AllocStructuredMem(sizeof(SDObject));
+      memset(allocs[i], 0x40, sizeof(SDObject));
+    }
+
+    // free in an interleaved order so slabs empty out while others are still live
+    for(size_t i = 0; i < allocs.size(); i += 2)
+      RENDERDOC_FreeStructuredMem(allocs[i]);
+    for(size_t i = 1; i < allocs.size(); i += 2)
+      RENDERDOC_FreeStructuredMem(allocs[i]);
+  }
+
+  SECTION("SDObjects themselves pool transparently")
+  {
+    SDObject *obj = new SDObject("name"_lit, "type"_lit);
+
+    obj->data.children.push_back(makeSDUInt32("child", 42U));
+
+    delete obj;
+  }
+
+  SECTION("over-sized allocations fall back to the heap")
+  {
+    void *big = RENDERDOC_AllocStructuredMem(4 * 1024 * 1024);
+
+    CHECK(big != NULL);
+
+    memset(big, 0x40, 4 * 1024 * 1024);
+
+    RENDERDOC_FreeStructuredMem(big);
+  }
+}
+
+#endif    // ENABLED(ENABLE_UNIT_TESTS)
@@ -26,7 +26,9 @@
 #define SERIALISER_IMPL
 
 #include "serialiser.h"
+#include "common/profiler.h"
 #include "core/core.h"
+#include "rdcfile.h"
 #include "strings/string_utils.h"
 
 #if !defined(RELEASE)
@@ -36,6 +38,216 @@ int64_t Chunk::m_TotalMem = 0;
 
 #endif
 
+/////////////////////////////////////////////////////////////
+// ChunkAllocator
+
+const uint64_t ChunkAllocator::PageSize;
+const uint64_t ChunkAllocator::MaxSuballocSize;
+const uint64_t ChunkAllocator::HeaderSize;
+
+Threading::CriticalSection ChunkAllocator::m_Lock;
+std::vector<ChunkAllocator::Page *> ChunkAllocator::m_FreePages;
+
+ChunkAllocator::ThreadPage &ChunkAllocator::CurPage()
+{
+  static thread_local ThreadPage page;
+  return page;
+}
+
+ChunkAllocator::ThreadPage::~ThreadPage()
+{
+  // drop the owning reference when the thread exits, so the page can recycle once any remaining
+  // allocations in it are freed
+  if(page)
+    ChunkAllocator::ReleaseRef(page);
+}
+
+ChunkAllocator::Page *ChunkAllocator::GetNewPage()
+{
+  SCOPED_LOCK(m_Lock);
+
+  Page *ret = NULL;
+
+  if(!m_FreePages.empty())
+  {
+    ret = m_FreePages.back();
+    m_FreePages.pop_back();
+  }
+  else
+  {
+    ret = new Page;
+    ret->base = AllocAlignedBuffer(PageSize);
+  }
+
+  ret->offset = 0;
+  // the owning thread's reference, released when the page is retired
+  ret->live = 1;
+
+  return ret;
+}
+
+void ChunkAllocator::ReleaseRef(Page *page)
+{
+  if(Atomic::Dec32(&page->live) == 0)
+  {
+    SCOPED_LOCK(m_Lock);
+    m_FreePages.push_back(page);
+  }
+}
+
+byte *ChunkAllocator::Alloc(uint32_t size)
+{
+  // anything too large to pack into a page gets its own heap allocation, with a NULL page in the
+  // header so Free() knows to hand it back to the heap.
+  if(size > MaxSuballocSize)
+  {
+    byte *alloc = AllocAlignedBuffer(HeaderSize + size);
+    memset(alloc, 0, sizeof(Page *));
+    *(volatile int32_t *)(alloc + sizeof(Page *)) = 1;
+    return alloc + HeaderSize;
+  }
+
+  ThreadPage &cur = CurPage();
+
+  if(cur.page == NULL || cur.page->offset + HeaderSize + size > PageSize)
+  {
+    // retire the old page - drop this thread's owning reference, so it recycles once all of its
+    // allocations are freed
+    if(cur.page)
+      ReleaseRef(cur.page);
+
+    cur.page = GetNewPage();
+  }
+
+  Page *page = cur.page;
+
+  byte *alloc = page->base + page->offset;
+
+  *(Page **)alloc = page;
+  *(volatile int32_t *)(alloc + sizeof(Page *)) = 1;
+
+  // keep each suballocation 64-byte aligned, like AllocAlignedBuffer. Only the owning thread
+  // touches offset, so no atomics are needed there.
+  page->offset += (HeaderSize + size + 63ULL) & ~63ULL;
+  Atomic::Inc32(&page->live);
+
+  return alloc + HeaderSize;
+}
+
+void ChunkAllocator::AddRef(byte *ptr)
+{
+  if(ptr)
+    Atomic::Inc32((volatile int32_t *)(ptr - HeaderSize + sizeof(Page *)));
+}
+
+void ChunkAllocator::Free(byte *ptr)
+{
+  if(ptr == NULL)
+    return;
+
+  // drop this allocation's reference - duplicated chunks may still share the payload
+  if(Atomic::Dec32((volatile int32_t *)(ptr - HeaderSize + sizeof(Page *))) > 0)
+    return;
+
+  Page *page = *(Page **)(ptr - HeaderSize);
+
+  if(page == NULL)
+  {
+    FreeAlignedBuffer(ptr - HeaderSize);
+    return;
+  }
+
+  ReleaseRef(page);
+}
+
+void ChunkAllocator::ReleaseFreePages()
+{
+  SCOPED_LOCK(m_Lock);
+
+  for(Page *page : m_FreePages)
+  {
+    FreeAlignedBuffer(page->base);
+    delete page;
+  }
+
+  m_FreePages.clear();
+}
+
+/////////////////////////////////////////////////////////////
+// ChunkArena
+
+static const size_t ChunkArenaPageSize = 256 * 1024;
+
+// only one arena can be active at once - chunk deserialisation is single-threaded, and drivers
+// that don't opt in simply never activate one.
+static ChunkArena *activeDeserialiseArena = NULL;
+
+void SetActiveDeserialiseArena(ChunkArena *arena)
+{
+  activeDeserialiseArena = arena;
+}
+
+void *DeserialiseArenaAlloc(size_t size)
+{
+  if(activeDeserialiseArena == NULL)
+    return NULL;
+
+  return activeDeserialiseArena->Alloc(size);
+}
+
+bool DeserialiseArenaOwns(const void *ptr)
+{
+  return activeDeserialiseArena != NULL && activeDeserialiseArena->Owns(ptr);
+}
+
+ChunkArena::~ChunkArena()
+{
+  for(Page &p : m_Pages)
+    delete[] p.base;
+}
+
+void *ChunkArena::Alloc(size_t size)
+{
+  // keep all allocations 16-byte aligned
+  size = AlignUp(size, (size_t)16);
+
+  for(Page &p : m_Pages)
+  {
+    if(p.size - p.used >= size)
+    {
+      void *ret = p.base + p.used;
+      p.used += size;
+      return ret;
+    }
+  }
+
+  // no room in any existing page, add a new one big enough for at least this allocation
+  Page p;
+  p.size = RDCMAX(size, ChunkArenaPageSize);
+  p.base = new byte[p.size];
+  p.used = size;
+  m_Pages.push_back(p);
+
+  return p.base;
+}
+
+void ChunkArena::Reset()
+{
+  for(Page &p : m_Pages)
+    p.used = 0;
+}
+
+bool ChunkArena::Owns(const void *ptr) const
+{
+  const byte *b = (const byte *)ptr;
+
+  for(const Page &p : m_Pages)
+    if(b >= p.base && b < p.base + p.size)
+      return true;
+
+  return false;
+}
+
 /////////////////////////////////////////////////////////////
 // Read Serialiser functions
 
@@ -64,6 +276,8 @@ uint32_t Serialiser<SerialiserMode::Reading>::BeginChunk(uint32_t, uint64_t)
 {
   uint32_t chunkID = 0;
 
+  uint64_t headerOffset = m_Read->GetOffset();
+
   m_ChunkMetadata = SDChunkMetaData();
 
   {
@@ -121,11 +335,28 @@ uint32_t Serialiser<SerialiserMode::Reading>::BeginChunk(uint32_t, uint64_t)
     if(name.empty())
       name = "<Unknown Chunk>";
 
-    SDChunk *chunk = new SDChunk(name.c_str());
+    // chunk names repeat endlessly, so share one interned copy when we have persistent string
+    // storage rather than allocating a copy per chunk
+    SDChunk *chunk = m_ExtStringDB ? new SDChunk(InternString(name)) : new SDChunk(name.c_str());
     chunk->metadata = m_ChunkMetadata;
 
     m_StructuredFile->chunks.push_back(chunk);
-    m_StructureStack.push_back(chunk);
+
+    if(m_LazyStructure)
+    {
+      // in lazy mode the chunk stays an empty stub - just remember where it lives so the full
+      // structured data can be materialised on demand, and suppress export of its contents.
+      chunk->metadata.flags |= SDChunkFlags::StubChunk;
+      chunk->type.byteSize = m_ChunkMetadata.length;
+
+      m_LazyChunks.push_back({chunk, headerOffset});
+
+      m_LazyActive = true;
+    }
+    else
+    {
+      m_StructureStack.push_back(chunk);
+    }
 
     m_InternalElement = false;
   }
@@ -197,7 +428,11 @@ void Serialiser<SerialiserMode::Reading>::SkipCurrentChunk()
 template <>
 void Serialiser<SerialiserMode::Reading>::EndChunk()
 {
-  if(ExportStructure())
+  if(m_LazyActive)
+  {
+    m_LazyActive = false;
+  }
+  else if(ExportStructure())
   {
     RDCASSERTMSG("Object Stack is imbalanced!", m_StructureStack.size() <= 1,
                  m_StructureStack.size());
@@ -271,6 +506,12 @@ void Serialiser<SerialiserMode::Writing>::SetChunkMetadataRecording(uint32_t fla
 template <>
 uint32_t Serialiser<SerialiserMode::Writing>::BeginChunk(uint32_t chunkID, uint64_t byteLength)
 {
+  if(CaptureProfiler::IsEnabled())
+    m_ChunkStartTick = Timing::GetTick();
+
+  if(m_IndexChunks)
+    m_ChunkIndex.push_back({chunkID, 0, m_Write->GetOffset()});
+
   {
     // chunk index needs to be valid
     RDCASSERT(chunkID > 0);
@@ -439,6 +680,13 @@ void Serialiser<SerialiserMode::Writing>::EndChunk()
   m_ChunkMetadata = SDChunkMetaData();
 
   m_Write->Flush();
+
+  if(m_ChunkStartTick)
+  {
+    CaptureProfiler::AccumulateTicks(CaptureProfiler::Counter::ChunkWrite,
+                                     Timing::GetTick() - m_ChunkStartTick);
+    m_ChunkStartTick = 0;
+  }
 }
 
 template <>
@@ -520,6 +768,94 @@ void Serialiser<SerialiserMode::Writing>::WriteStructuredFile(const SDFile &file
   scratchWriter.m_StructuredFile = &scratchWriter.m_StructData;
 }
 
+static const uint64_t ChunkIndexVersion = 1;
+
+bool WriteChunkIndex(RDCFile *rdc, const std::vector<ChunkIndexEntry> &index)
+{
+  if(rdc == NULL || index.empty())
+    return false;
+
+  SectionProperties props = {};
+  props.type = SectionType::ChunkIndex;
+  props.version = ChunkIndexVersion;
+  // left uncompressed so it can be read zero-copy out of a mapped file
+
+  StreamWriter *w = rdc->WriteSection(props);
+
+  uint64_t count = index.size();
+
+  w->Write(count);
+
+  for(const ChunkIndexEntry &entry : index)
+  {
+    w->Write(entry.chunkID);
+    w->Write(entry.eventID);
+    w->Write(entry.offset);
+  }
+
+  bool success = !w->IsErrored();
+
+  w->Finish();
+
+  delete w;
+
+  return success;
+}
+
+bool ReadChunkIndex(RDCFile *rdc, std::vector<ChunkIndexEntry> &index)
+{
+  index.clear();
+
+  if(rdc == NULL)
+    return false;
+
+  int idx = rdc->SectionIndex(SectionType::ChunkIndex);
+
+  if(idx < 0)
+    return false;
+
+  const SectionProperties &props = rdc->GetSectionProperties(idx);
+
+  if(props.version != ChunkIndexVersion)
+  {
+    RDCWARN("Unsupported chunk index version %llu, ignoring index", props.version);
+    return false;
+  }
+
+  StreamReader *reader = rdc->ReadSection(idx);
+
+  uint64_t count = 0;
+  reader->Read(count);
+
+  const uint64_t entrySize = sizeof(uint32_t) + sizeof(uint32_t) + sizeof(uint64_t);
+
+  // sanity check the count against the section size before reserving anything
+  if(reader->IsErrored() || count * entrySize > reader->GetSize())
+  {
+    RDCWARN("Corrupt chunk index section, ignoring index");
+    delete reader;
+    return false;
+  }
+
+  index.resize((size_t)count);
+
+  for(ChunkIndexEntry &entry : index)
+  {
+    reader->Read(entry.chunkID);
+    reader->Read(entry.eventID);
+    reader->Read(entry.offset);
+  }
+
+  bool success = !reader->IsErrored();
+
+  delete reader;
+
+  if(!success)
+    index.clear();
+
+  return success;
+}
+
 template <>
 rdcstr DoStringise(const SDBasic &el)
 {
@@ -564,6 +900,8 @@ rdcstr DoStringise(const SDChunkFlags &el)
     STRINGISE_BITFIELD_CLASS_VALUE(NoFlags);
 
     STRINGISE_BITFIELD_CLASS_BIT(OpaqueChunk);
+
+    STRINGISE_BITFIELD_CLASS_BIT(StubChunk);
   }
   END_BITFIELD_STRINGISE();
 }
@@ -774,6 +1112,71 @@ void DoSerialise(SerialiserType &ser, SDObject *el)
 /////////////////////////////////////////////////////////////
 // Basic types
 
+// fast integer formatting core. Structured export and disassembly stringise a huge number of
+// plain integers, and routing each one through sprintf means parsing a format string per value.
+// Instead write digits in pairs from a 00-99 table, building backwards from the end of a small
+// stack buffer - two digits per divide and no format string parsing. The generated enum
+// stringisers don't need the same treatment, they already compile to a switch returning string
+// literals.
+static const char digitPairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+// writes el backwards, ending at (and not including) end. Returns the pointer to the first digit
+static char *FormatUint(char *end, uint64_t el)
+{
+  char *c = end;
+
+  while(el >= 100)
+  {
+    const char *pair = digitPairs + (el % 100) * 2;
+    el /= 100;
+    *--c = pair[1];
+    *--c = pair[0];
+  }
+
+  if(el >= 10)
+  {
+    const char *pair = digitPairs + el * 2;
+    *--c = pair[1];
+    *--c = pair[0];
+  }
+  else
+  {
+    *--c = char('0' + el);
+  }
+
+  return c;
+}
+
+static rdcstr StringiseUint(uint64_t el)
+{
+  // maximum uint64 is 20 digits
+  char buf[20];
+  char *start = FormatUint(buf + sizeof(buf), el);
+  return rdcstr(start, buf + sizeof(buf) - start);
+}
+
+static rdcstr StringiseInt(int64_t el)
+{
+  // minimum int64 is 19 digits and a sign
+  char buf[20];
+  // negate in unsigned space so INT64_MIN doesn't overflow
+  uint64_t val = el < 0 ? uint64_t(0) - uint64_t(el) : uint64_t(el);
+  char *start = FormatUint(buf + sizeof(buf), val);
+  if(el < 0)
+    *--start = '-';
+  return rdcstr(start, buf + sizeof(buf) - start);
+}
+
 template <>
 rdcstr DoStringise(const std::string &el)
 {
@@ -795,27 +1198,27 @@ rdcstr DoStringise(void *const &el)
 template <>
 rdcstr DoStringise(const int64_t &el)
 {
-  return StringFormat::Fmt("%lld", el);
+  return StringiseInt(el);
 }
 
 #if ENABLED(RDOC_SIZET_SEP_TYPE)
 template <>
 rdcstr DoStringise(const size_t &el)
 {
-  return StringFormat::Fmt("%llu", (uint64_t)el);
+  return StringiseUint((uint64_t)el);
 }
 #endif
 
 template <>
 rdcstr DoStringise(const uint64_t &el)
 {
-  return StringFormat::Fmt("%llu", el);
+  return StringiseUint(el);
 }
 
 template <>
 rdcstr DoStringise(const uint32_t &el)
 {
-  return StringFormat::Fmt("%u", el);
+  return StringiseUint(el);
 }
 
 template <>
@@ -833,25 +1236,25 @@ rdcstr DoStringise(const wchar_t &el)
 template <>
 rdcstr DoStringise(const byte &el)
 {
-  return StringFormat::Fmt("%hhu", el);
+  return StringiseUint(el);
 }
 
 template <>
 rdcstr DoStringise(const uint16_t &el)
 {
-  return StringFormat::Fmt("%hu", el);
+  return StringiseUint(el);
 }
 
 template <>
 rdcstr DoStringise(const int32_t &el)
 {
-  return StringFormat::Fmt("%d", el);
+  return StringiseInt(el);
 }
 
 template <>
 rdcstr DoStringise(const int16_t &el)
 {
-  return StringFormat::Fmt("%hd", el);
+  return StringiseInt(el);
 }
 
 template <>
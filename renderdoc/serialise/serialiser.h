@@ -25,8 +25,10 @@
 #pragma once
 
 #include <list>
+#include <new>
 #include <set>
 #include <string>
+#include <type_traits>
 #include <vector>
 #include "api/replay/renderdoc_replay.h"
 #include "streamio.h"
@@ -42,6 +44,88 @@ void Deserialise(const T &el)
   template <>                          \
   void Deserialise(const type &el);
 
+// chunk-lifetime arena for deserialised allocations. Reading a creation chunk allocates every
+// nested array and pNext struct individually, only for them all to be freed again as soon as the
+// API call has been made. With an arena active those allocations are carved out of reusable pages
+// instead, the matching frees become no-ops, and the memory is reclaimed in one go when the arena
+// is reset after the chunk has been processed.
+class ChunkArena
+{
+public:
+  ~ChunkArena();
+  void *Alloc(size_t size);
+  // reclaims every allocation at once. The backing pages are kept for re-use by later chunks.
+  void Reset();
+  bool Owns(const void *ptr) const;
+
+private:
+  struct Page
+  {
+    byte *base;
+    size_t size;
+    size_t used;
+  };
+  std::vector<Page> m_Pages;
+};
+
+// (de)activates the arena backing deserialise allocations. Only one arena can be active at a time
+// and chunk processing is single-threaded, so this is a plain global. While no arena is active
+// (the default, and always the case when writing) allocations come from the heap as before.
+void SetActiveDeserialiseArena(ChunkArena *arena);
+void *DeserialiseArenaAlloc(size_t size);
+bool DeserialiseArenaOwns(const void *ptr);
+
+// allocation/free pair used for deserialised arrays and nullable pointers. Types with non-trivial
+// destructors always come from the heap, since the arena reclaims memory without destroying
+// anything.
+template <class T>
+T *AllocDeserialiseArray(size_t count)
+{
+  if(count == 0)
+    return NULL;
+
+  if(std::is_trivially_destructible<T>::value)
+  {
+    void *mem = DeserialiseArenaAlloc(sizeof(T) * count);
+    if(mem)
+    {
+      T *arr = (T *)mem;
+      for(size_t i = 0; i < count; i++)
+        new(arr + i) T;
+      return arr;
+    }
+  }
+
+  return new T[count];
+}
+
+template <class T>
+T *AllocDeserialiseType()
+{
+  if(std::is_trivially_destructible<T>::value)
+  {
+    void *mem = DeserialiseArenaAlloc(sizeof(T));
+    if(mem)
+      return new(mem) T;
+  }
+
+  return new T;
+}
+
+template <class T>
+void FreeDeserialiseArray(const T *el)
+{
+  if(el && !DeserialiseArenaOwns(el))
+    delete[] el;
+}
+
+template <class T>
+void FreeDeserialiseType(const T *el)
+{
+  if(el && !DeserialiseArenaOwns(el))
+    delete el;
+}
+
 // this is a bit of a hack, but necessary. We don't want to have all of our DoSerialise functions
 // defined in global cross-project headers and compiled everywhere, we just want to define them in
 // .cpp files.
@@ -53,6 +137,52 @@ void Deserialise(const T &el)
 
 typedef std::string (*ChunkLookup)(uint32_t chunkType);
 
+// one entry in the optional chunk offset index (see SectionType::ChunkIndex). Offsets are
+// relative to the start of the uncompressed frame capture section. eventID is 0 for chunks
+// written at capture time before events are assigned, replay tooling can rewrite the index with
+// event IDs populated.
+struct ChunkIndexEntry
+{
+  uint32_t chunkID;
+  uint32_t eventID;
+  uint64_t offset;
+};
+
+class RDCFile;
+
+// writes/reads the chunk offset index to/from its optional section in the container. Reading
+// returns false if the section isn't present or is corrupt - the index is purely an accelerator,
+// so callers must always be able to fall back to linear parsing.
+bool WriteChunkIndex(RDCFile *rdc, const std::vector<ChunkIndexEntry> &index);
+bool ReadChunkIndex(RDCFile *rdc, std::vector<ChunkIndexEntry> &index);
+
+// records where a chunk that was lazily exported as a stub lives in the stream, so its structured
+// data can be materialised on demand later. Keyed by the stub itself rather than its index, since
+// replay can insert extra chunks (e.g. indirect sub-commands) that shift indices around.
+// See Serialiser::SetLazyStructuredExport().
+struct LazyChunkLocation
+{
+  // the stub chunk added to SDFile::chunks
+  SDChunk *chunk;
+  // offset of the chunk header in the stream the chunk was read from
+  uint64_t offset;
+};
+
+// detects types whose DoSerialise writes exactly the element's in-memory bytes to the stream -
+// the built-in arithmetic types and enums, which go through SerialiseValue as raw byte soup.
+// Arrays of these can be read/written with one bulk stream operation instead of a DoSerialise
+// call per element, which matters when serialising millions of POD elements (index buffers,
+// uint arrays) in the capture hot path.
+//
+// Struct types must NOT specialise this to true: their DoSerialise serialises per-member, so
+// the padding in their in-memory layout is not part of the stream format and a bulk copy would
+// change (and break) serialised compatibility.
+template <typename T>
+struct is_trivially_serialisable
+{
+  static constexpr bool value = std::is_arithmetic<T>::value || std::is_enum<T>::value;
+};
+
 enum class SerialiserFlags
 {
   NoFlags = 0x0,
@@ -90,7 +220,8 @@ public:
   static constexpr bool IsWriting() { return sertype == SerialiserMode::Writing; }
   bool ExportStructure() const
   {
-    return sertype == SerialiserMode::Reading && m_ExportStructured && !m_InternalElement;
+    return sertype == SerialiserMode::Reading && m_ExportStructured && !m_InternalElement &&
+           !m_LazyActive;
   }
 
   enum ChunkFlags
@@ -117,6 +248,22 @@ public:
   void SetChunkMetadataRecording(uint32_t flags);
 
   SDChunkMetaData &ChunkMetadata() { return m_ChunkMetadata; }
+  // enables recording of chunk offsets as chunks are written, for storing in a
+  // SectionType::ChunkIndex section afterwards. Only valid on writing serialisers.
+  void EnableChunkIndexing(bool enable) { m_IndexChunks = enable; }
+  std::vector<ChunkIndexEntry> &GetChunkIndex() { return m_ChunkIndex; }
+  // enables borrowed-view deserialisation on a reading serialiser whose stream wraps stable
+  // storage such as the memory-mapped capture file. Byte buffers read with AllocateMemory then
+  // point directly into that storage instead of being copied into a fresh allocation
+  // (FreeAlignedBuffer recognises and ignores them - see RegisterStableMemoryRange), and strings
+  // are interned in the external string DB rather than allocated per read. Has no effect if the
+  // stream doesn't support borrowing. Only enable when the storage outlives everything
+  // deserialised from it - note borrowed buffers don't carry AllocAlignedBuffer's alignment
+  // guarantee, so keep this off for paths that need aligned data.
+  void EnableBorrowedViews(bool enable)
+  {
+    m_BorrowViews = enable && m_Read && m_Read->IsExternalBuffer();
+  }
   //////////////////////////////////////////
   // Utility functions
 
@@ -157,6 +304,13 @@ public:
     m_ExportStructured = (lookup != NULL);
   }
 
+  // when lazily exporting structure, each chunk is added to the structured file as an empty stub
+  // with only its metadata filled in and flagged with SDChunkFlags::StubChunk, and the location of
+  // the chunk in the stream is recorded so that the full structured data can be materialised later
+  // on demand, without paying the cost of building 'just in case' trees for millions of chunks.
+  void SetLazyStructuredExport(bool lazy) { m_LazyStructure = lazy; }
+  const std::vector<LazyChunkLocation> &GetLazyChunkLocations() { return m_LazyChunks; }
+
   uint32_t BeginChunk(uint32_t chunkID, uint64_t byteLength);
   void EndChunk();
 
@@ -183,7 +337,12 @@ public:
   {
     if(ExportStructure())
     {
-      m_StructureStack.back()->data.str = ToStr(el);
+      // stringified values are duplicated endlessly, so share one interned copy when we have
+      // persistent string storage to back it
+      if(m_ExtStringDB)
+        m_StructureStack.back()->data.str = InternString(ToStr(el));
+      else
+        m_StructureStack.back()->data.str = ToStr(el);
       m_StructureStack.back()->type.flags |= SDTypeFlags::HasCustomString;
     }
   }
@@ -277,6 +436,8 @@ public:
         // ensure byte alignment
         m_Read->AlignTo<ChunkAlignment>();
 
+        bool borrowed = false;
+
 // Coverity is unable to tie this allocation together with the automatic scoped deallocation in the
 // ScopedDeseralise* classes. We can verify with e.g. valgrind that there are no leaks, so to keep
 // the analysis non-spammy we just don't allocate for coverity builds
@@ -284,9 +445,23 @@ public:
         if(flags & SerialiserFlags::AllocateMemory)
         {
           if(byteSize > 0)
-            el = AllocAlignedBuffer(byteSize);
+          {
+            // borrow a view straight out of the stable storage behind the stream rather than
+            // allocating and copying. The pointer flows through the normal ownership paths -
+            // FreeAlignedBuffer recognises it and leaves it alone.
+            if(m_BorrowViews)
+            {
+              el = (byte *)m_Read->BorrowRead(byteSize);
+              borrowed = (el != NULL);
+            }
+
+            if(el == NULL)
+              el = AllocAlignedBuffer(byteSize);
+          }
           else
+          {
             el = NULL;
+          }
         }
 
         // if we're exporting the buffers, make sure to always alloc space to read the data, so we
@@ -301,7 +476,8 @@ public:
         }
 #endif
 
-        m_Read->Read(el, byteSize);
+        if(!borrowed)
+          m_Read->Read(el, byteSize);
       }
     }
 
@@ -603,8 +779,7 @@ public:
     }
     else
     {
-      for(size_t i = 0; i < N && i < count; i++)
-        SerialiseDispatch<Serialiser, T>::Do(*this, el[i]);
+      SerialiseArrayContents(el, RDCMIN((uint64_t)N, count));
 
       for(size_t i = N; i < count; i++)
       {
@@ -685,12 +860,7 @@ public:
 // the analysis non-spammy we just don't allocate for coverity builds
 #if !defined(__COVERITY__)
       if(IsReading() && (flags & SerialiserFlags::AllocateMemory))
-      {
-        if(arrayCount > 0)
-          el = new T[(size_t)arrayCount];
-        else
-          el = NULL;
-      }
+        el = AllocDeserialiseArray<T>((size_t)arrayCount);
 #endif
 
       for(uint64_t i = 0; el && i < arrayCount; i++)
@@ -720,16 +890,11 @@ public:
 // the analysis non-spammy we just don't allocate for coverity builds
 #if !defined(__COVERITY__)
       if(IsReading() && (flags & SerialiserFlags::AllocateMemory))
-      {
-        if(arrayCount > 0)
-          el = new T[(size_t)arrayCount];
-        else
-          el = NULL;
-      }
+        el = AllocDeserialiseArray<T>((size_t)arrayCount);
 #endif
 
-      for(size_t i = 0; el && i < arrayCount; i++)
-        SerialiseDispatch<Serialiser, T>::Do(*this, el[i]);
+      if(el)
+        SerialiseArrayContents(el, arrayCount);
     }
 
     return *this;
@@ -799,8 +964,7 @@ public:
       if(IsReading())
         el.resize((size_t)size);
 
-      for(size_t i = 0; i < (size_t)size; i++)
-        SerialiseDispatch<Serialiser, U>::Do(*this, el[i]);
+      SerialiseArrayContents(el.data(), size);
     }
 
     return *this;
@@ -1007,8 +1171,7 @@ public:
       if(IsReading())
         el.resize((int)size);
 
-      for(size_t i = 0; i < (size_t)size; i++)
-        SerialiseDispatch<Serialiser, U>::Do(*this, el[i]);
+      SerialiseArrayContents(el.data(), size);
     }
 
     return *this;
@@ -1122,12 +1285,7 @@ public:
 // the analysis non-spammy we just don't allocate for coverity builds
 #if !defined(__COVERITY__)
       if(IsReading())
-      {
-        if(present)
-          el = new T;
-        else
-          el = NULL;
-      }
+        el = present ? AllocDeserialiseType<T>() : NULL;
 #endif
 
       if(el)
@@ -1163,12 +1321,7 @@ public:
 // the analysis non-spammy we just don't allocate for coverity builds
 #if !defined(__COVERITY__)
       if(IsReading())
-      {
-        if(present)
-          el = new T;
-        else
-          el = NULL;
-      }
+        el = present ? AllocDeserialiseType<T>() : NULL;
 #endif
 
       if(el)
@@ -1463,9 +1616,24 @@ public:
     if(IsReading())
     {
       m_Read->Read(len);
-      el.resize((int)len);
-      if(len > 0)
-        m_Read->Read(&el[0], len);
+
+      // with borrowed views and an external string DB we can hand out a fixed string over the
+      // interned copy instead of allocating one per read. Strings repeat endlessly across chunks
+      // (resource names, markers, entry points) so the pool stays small, and rdcstr transparently
+      // copies-on-write if the caller mutates it.
+      if(m_BorrowViews && m_ExtStringDB && len > 0)
+      {
+        std::string str;
+        str.resize(len);
+        m_Read->Read(&str[0], len);
+        el = rdcstr(InternString(str));
+      }
+      else
+      {
+        el.resize((int)len);
+        if(len > 0)
+          m_Read->Read(&el[0], len);
+      }
     }
     else
     {
@@ -1518,7 +1686,14 @@ public:
 
       current.type.basetype = type;
       current.type.byteSize = RDCMAX(len, 0);
-      current.data.str = el ? el : "";
+
+      // when reading with an external string DB, el already points at interned storage that
+      // outlives us (see StringDB above) so we can borrow it instead of copying
+      if(el && IsReading() && m_ExtStringDB)
+        current.data.str = make_rdcliteral(el, (size_t)len);
+      else
+        current.data.str = el ? el : "";
+
       if(len == -1)
         current.type.flags |= SDTypeFlags::NullString;
     }
@@ -1558,6 +1733,29 @@ private:
     }
   };
 
+  // bulk read/write for array contents. For trivially-serialisable elements this produces
+  // byte-identical stream contents to calling DoSerialise per element, but with a single stream
+  // operation for the whole array. Only used on the non-structured path - the structured export
+  // path needs to visit every element to build an SDObject for it anyway. The array count has
+  // already been bounds-checked against the stream by VerifyArraySize when reading.
+  template <class T>
+  typename std::enable_if<is_trivially_serialisable<T>::value>::type SerialiseArrayContents(
+      T *el, uint64_t count)
+  {
+    if(IsWriting())
+      m_Write->Write(el, count * sizeof(T));
+    else if(IsReading())
+      m_Read->Read(el, count * sizeof(T));
+  }
+
+  template <class T>
+  typename std::enable_if<!is_trivially_serialisable<T>::value>::type SerialiseArrayContents(
+      T *el, uint64_t count)
+  {
+    for(uint64_t i = 0; i < count; i++)
+      SerialiseDispatch<Serialiser, T>::Do(*this, el[i]);
+  }
+
   void VerifyArraySize(uint64_t &count)
   {
     uint64_t size = m_Read->GetSize();
@@ -1601,9 +1799,18 @@ private:
   uint64_t m_LastChunkOffset = 0;
   uint64_t m_ChunkFixup = 0;
 
+  // tick at BeginChunk when the capture profiler is enabled, so EndChunk can account the whole
+  // chunk write (header, elements and flush) to the chunk writing counter.
+  uint64_t m_ChunkStartTick = 0;
+
   bool m_ExportStructured = false;
   bool m_ExportBuffers = false;
   bool m_InternalElement = false;
+  // see SetLazyStructuredExport. m_LazyActive is set between BeginChunk and EndChunk when the
+  // current chunk is being stubbed out, suppressing structured export of its contents.
+  bool m_LazyStructure = false;
+  bool m_LazyActive = false;
+  std::vector<LazyChunkLocation> m_LazyChunks;
   SDFile m_StructData;
   SDFile *m_StructuredFile = &m_StructData;
   std::vector<SDObject *> m_StructureStack;
@@ -1611,6 +1818,13 @@ private:
   uint32_t m_ChunkFlags = 0;
   SDChunkMetaData m_ChunkMetadata;
 
+  // see EnableChunkIndexing
+  bool m_IndexChunks = false;
+  std::vector<ChunkIndexEntry> m_ChunkIndex;
+
+  // see EnableBorrowedViews - only ever true on a reading serialiser over an external buffer
+  bool m_BorrowViews = false;
+
   // a database of strings read from the file, useful when serialised structures
   // expect a char* to return and point to static memory
   std::set<std::string> m_StringDB;
@@ -1630,6 +1844,16 @@ private:
     return it.first->c_str();
   }
 
+  // interns a dynamically-built string in the external string DB and returns it as a literal, so
+  // the structured tree shares one immutable copy instead of allocating per-object. Strings like
+  // chunk names and stringified enum values repeat endlessly across millions of chunks. Only valid
+  // when an external string DB is set, since the structured file can outlive this serialiser.
+  rdcliteral InternString(const std::string &s)
+  {
+    auto it = m_ExtStringDB->insert(s);
+    return make_rdcliteral(it.first->c_str(), it.first->size());
+  }
+
   ChunkLookup m_ChunkLookup = NULL;
 };
 
@@ -1744,6 +1968,57 @@ DECLARE_STRINGISE_TYPE(SDObject *);
 
 class ScopedChunk;
 
+// suballocates chunk payload memory out of large shared pages, to avoid one heap allocation per
+// recorded API call during capture. Each allocation carries a hidden header pointing at its owning
+// page, and each page counts its live allocations - when the count drops to zero the page is
+// recycled. Allocations too large to suballocate fall back to the heap with a NULL page header,
+// so Free() works uniformly. All methods are thread-safe.
+//
+// The header also holds a per-allocation reference count, so a payload can be shared between
+// multiple Chunks - AddRef() takes an extra reference and Free() only releases the memory when the
+// last reference drops.
+class ChunkAllocator
+{
+public:
+  static byte *Alloc(uint32_t size);
+  static void AddRef(byte *ptr);
+  static void Free(byte *ptr);
+
+  // returns pages on the free list back to the OS, e.g. after a capture has been written
+  static void ReleaseFreePages();
+
+private:
+  struct Page
+  {
+    byte *base;
+    uint64_t offset;
+    // allocations can be freed from any thread, so the live count is atomic. While a page is some
+    // thread's current page that thread holds one extra reference, so in-flight frees can never
+    // recycle it underneath the owner.
+    volatile int32_t live;
+  };
+
+  // each thread fills its own current page, so the common alloc path takes no lock - the shared
+  // lock only guards the free page list, touched once per ~PageSize of chunk data.
+  struct ThreadPage
+  {
+    ~ThreadPage();
+    Page *page = NULL;
+  };
+
+  static ThreadPage &CurPage();
+  static Page *GetNewPage();
+  static void ReleaseRef(Page *page);
+
+  static const uint64_t PageSize = 256 * 1024;
+  static const uint64_t MaxSuballocSize = 16 * 1024;
+  // large enough for the page pointer while keeping the payload 64-byte aligned
+  static const uint64_t HeaderSize = 64;
+
+  static Threading::CriticalSection m_Lock;
+  static std::vector<Page *> m_FreePages;
+};
+
 // holds the memory, length and type for a given chunk, so that it can be
 // passed around and moved between owners before being serialised out
 class Chunk
@@ -1751,7 +2026,7 @@ class Chunk
 public:
   ~Chunk()
   {
-    FreeAlignedBuffer(m_Data);
+    ChunkAllocator::Free(m_Data);
 
 #if !defined(RELEASE)
     Atomic::Dec64(&m_LiveChunks);
@@ -1781,7 +2056,7 @@ public:
 
     m_ChunkType = chunkType;
 
-    m_Data = AllocAlignedBuffer(m_Length);
+    m_Data = ChunkAllocator::Alloc(m_Length);
 
     memcpy(m_Data, ser.GetWriter()->GetData(), (size_t)m_Length);
 
@@ -1794,15 +2069,18 @@ public:
   }
 
   byte *GetData() const { return m_Data; }
+  uint32_t GetLength() const { return m_Length; }
+  // the payload is immutable once the chunk is created, so duplicates share it by reference.
+  // This makes merging a deferred command list's chunks into the frame record a pointer append
+  // rather than a copy of the list's whole recorded payload.
   Chunk *Duplicate()
   {
     Chunk *ret = new Chunk();
     ret->m_Length = m_Length;
     ret->m_ChunkType = m_ChunkType;
 
-    ret->m_Data = AllocAlignedBuffer(m_Length);
-
-    memcpy(ret->m_Data, m_Data, (size_t)m_Length);
+    ret->m_Data = m_Data;
+    ChunkAllocator::AddRef(m_Data);
 
 #if !defined(RELEASE)
     Atomic::Inc64(&m_LiveChunks);
@@ -1896,7 +2174,7 @@ struct ScopedDeserialiseNullable
     if(m_Ser.IsReading() && *m_El != NULL)
     {
       Deserialise(**m_El);
-      delete *m_El;
+      FreeDeserialiseType(*m_El);
     }
   }
   const SerialiserType &m_Ser;
@@ -1915,7 +2193,7 @@ struct ScopedDeserialiseArray
     {
       for(uint64_t i = 0; i < count; i++)
         Deserialise((*m_El)[i]);
-      delete[] * m_El;
+      FreeDeserialiseArray(*m_El);
     }
   }
   void setCount(uint64_t c) { count = c; }
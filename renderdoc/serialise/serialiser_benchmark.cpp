@@ -0,0 +1,269 @@
+/******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Baldur Karlsson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "common/timing.h"
+#include "lz4io.h"
+#include "serialiser.h"
+#include "zstdio.h"
+
+#if ENABLED(ENABLE_UNIT_TESTS)
+
+#include "3rdparty/catch/catch.hpp"
+
+// Throughput benchmarks for the serialisation layer, so regressions can be tracked between builds.
+// They are hidden from a default test run since they take a while and have no pass/fail criteria
+// beyond basic sanity - run them explicitly with the [benchmark] tag, e.g.:
+//
+//   renderdoccmd test unit [benchmark]
+//
+// All results are reported as bytes processed per second via WARN so they appear in the output
+// regardless of verbosity.
+
+static std::string ThroughputString(const char *name, uint64_t bytes, double milliseconds)
+{
+  double mbps = (double(bytes) / (1000.0 * 1000.0)) / (milliseconds / 1000.0);
+  return StringFormat::Fmt("%s: %.2f MB processed in %.2f ms = %.2f MB/s", name,
+                           double(bytes) / (1000.0 * 1000.0), milliseconds, mbps);
+}
+
+// serialises a chunk of mixed-type data roughly representative of a captured API call - a handful
+// of integers/floats, a string, and a small array.
+template <typename SerialiserType>
+static void SyntheticChunkBody(SerialiserType &ser, uint32_t chunkIdx)
+{
+  uint64_t commandBuffer = 0x1000 + chunkIdx;
+  uint32_t firstIndex = chunkIdx * 3;
+  uint32_t indexCount = 36;
+  int32_t vertexOffset = -int32_t(chunkIdx & 0xf);
+  float depthBias = 1.5f;
+  bool indexed = true;
+  std::string marker = "synthetic draw call marker";
+  uint32_t offsets[4] = {0, 64, 128, 192};
+
+  SERIALISE_ELEMENT(commandBuffer);
+  SERIALISE_ELEMENT(firstIndex);
+  SERIALISE_ELEMENT(indexCount);
+  SERIALISE_ELEMENT(vertexOffset);
+  SERIALISE_ELEMENT(depthBias);
+  SERIALISE_ELEMENT(indexed);
+  SERIALISE_ELEMENT(marker);
+  SERIALISE_ELEMENT(offsets);
+}
+
+static void WriteSyntheticChunk(WriteSerialiser &ser, uint32_t chunkIdx)
+{
+  SCOPED_SERIALISE_CHUNK(42);
+
+  SyntheticChunkBody(ser, chunkIdx);
+}
+
+static void ReadSyntheticChunk(ReadSerialiser &ser, uint32_t chunkIdx)
+{
+  uint32_t chunkID = ser.ReadChunk<uint32_t>();
+  RDCASSERT(chunkID == 42);
+
+  SyntheticChunkBody(ser, chunkIdx);
+
+  ser.EndChunk();
+}
+
+static std::string BenchmarkChunkLookup(uint32_t chunkType)
+{
+  return "SyntheticChunk";
+}
+
+TEST_CASE("Benchmark chunk write/read throughput", "[!hide][benchmark][serialiser]")
+{
+  const uint32_t numChunks = 200000;
+
+  StreamWriter *buf = new StreamWriter(StreamWriter::DefaultScratchSize);
+
+  // write throughput - serialise the synthetic chunk stream into a growing memory buffer.
+  {
+    WriteSerialiser ser(buf, Ownership::Nothing);
+
+    ser.SetChunkMetadataRecording(WriteSerialiser::ChunkThreadID);
+
+    PerformanceTimer timer;
+
+    for(uint32_t c = 0; c < numChunks; c++)
+      WriteSyntheticChunk(ser, c);
+
+    WARN(ThroughputString("chunk write", buf->GetOffset(), timer.GetMilliseconds()));
+
+    REQUIRE_FALSE(ser.IsErrored());
+  }
+
+  // read throughput - deserialise the same stream without structured export, as replay does once
+  // initial load is complete.
+  {
+    ReadSerialiser ser(new StreamReader(buf->GetData(), buf->GetOffset()), Ownership::Stream);
+
+    PerformanceTimer timer;
+
+    for(uint32_t c = 0; c < numChunks; c++)
+      ReadSyntheticChunk(ser, c);
+
+    WARN(ThroughputString("chunk read", buf->GetOffset(), timer.GetMilliseconds()));
+
+    REQUIRE_FALSE(ser.IsErrored());
+  }
+
+  delete buf;
+}
+
+TEST_CASE("Benchmark compression codec throughput", "[!hide][benchmark][streamio]")
+{
+  // mix of compressible and incompressible data, the same blend the other streamio tests use, so
+  // neither codec gets an unrealistically easy or hard time.
+  const uint64_t dataSize = 64 * 1024 * 1024;
+
+  byte *data = new byte[dataSize];
+
+  for(uint64_t i = 0; i < dataSize; i++)
+  {
+    if(i % 3 == 0)
+      data[i] = rand() & 0xff;
+    else
+      data[i] = i & 0xff;
+  }
+
+  StreamWriter compressed(StreamWriter::DefaultScratchSize);
+
+  SECTION("LZ4")
+  {
+    {
+      StreamWriter writer(new LZ4Compressor(&compressed, Ownership::Nothing), Ownership::Stream);
+
+      PerformanceTimer timer;
+
+      writer.Write(data, dataSize);
+      writer.Finish();
+
+      WARN(ThroughputString("LZ4 compress", dataSize, timer.GetMilliseconds()));
+
+      REQUIRE_FALSE(writer.IsErrored());
+    }
+
+    {
+      StreamReader reader(new LZ4Decompressor(new StreamReader(compressed.GetData(),
+                                                               compressed.GetOffset()),
+                                              Ownership::Stream),
+                          dataSize, Ownership::Stream);
+
+      byte *readback = new byte[dataSize];
+
+      PerformanceTimer timer;
+
+      reader.Read(readback, dataSize);
+
+      WARN(ThroughputString("LZ4 decompress", dataSize, timer.GetMilliseconds()));
+
+      REQUIRE_FALSE(reader.IsErrored());
+      CHECK_FALSE(memcmp(readback, data, (size_t)dataSize));
+
+      delete[] readback;
+    }
+  }
+
+  SECTION("Zstd")
+  {
+    {
+      StreamWriter writer(new ZSTDCompressor(&compressed, Ownership::Nothing), Ownership::Stream);
+
+      PerformanceTimer timer;
+
+      writer.Write(data, dataSize);
+      writer.Finish();
+
+      WARN(ThroughputString("Zstd compress", dataSize, timer.GetMilliseconds()));
+
+      REQUIRE_FALSE(writer.IsErrored());
+    }
+
+    {
+      StreamReader reader(new ZSTDDecompressor(new StreamReader(compressed.GetData(),
+                                                                compressed.GetOffset()),
+                                               Ownership::Stream),
+                          dataSize, Ownership::Stream);
+
+      byte *readback = new byte[dataSize];
+
+      PerformanceTimer timer;
+
+      reader.Read(readback, dataSize);
+
+      WARN(ThroughputString("Zstd decompress", dataSize, timer.GetMilliseconds()));
+
+      REQUIRE_FALSE(reader.IsErrored());
+      CHECK_FALSE(memcmp(readback, data, (size_t)dataSize));
+
+      delete[] readback;
+    }
+  }
+
+  delete[] data;
+}
+
+TEST_CASE("Benchmark structured data conversion", "[!hide][benchmark][serialiser][structured]")
+{
+  const uint32_t numChunks = 100000;
+
+  StreamWriter *buf = new StreamWriter(StreamWriter::DefaultScratchSize);
+
+  {
+    WriteSerialiser ser(buf, Ownership::Nothing);
+
+    for(uint32_t c = 0; c < numChunks; c++)
+      WriteSyntheticChunk(ser, c);
+
+    REQUIRE_FALSE(ser.IsErrored());
+  }
+
+  // read the stream back with structured export enabled, as initial load does, measuring the rate
+  // at which chunks are converted to SDObject trees.
+  {
+    ReadSerialiser ser(new StreamReader(buf->GetData(), buf->GetOffset()), Ownership::Stream);
+
+    ser.ConfigureStructuredExport(&BenchmarkChunkLookup, true);
+
+    PerformanceTimer timer;
+
+    for(uint32_t c = 0; c < numChunks; c++)
+      ReadSyntheticChunk(ser, c);
+
+    double ms = timer.GetMilliseconds();
+
+    WARN(ThroughputString("structured conversion", buf->GetOffset(), ms));
+    WARN(StringFormat::Fmt("structured conversion: %.2f chunks/sec",
+                           double(numChunks) / (ms / 1000.0)));
+
+    REQUIRE_FALSE(ser.IsErrored());
+    REQUIRE(ser.GetStructuredFile().chunks.size() == numChunks);
+  }
+
+  delete buf;
+}
+
+#endif    // ENABLED(ENABLE_UNIT_TESTS)
@@ -947,6 +947,106 @@ TEST_CASE("Read/write container types", "[serialiser][structured]")
   delete buf;
 };
 
+TEST_CASE("Read/write POD arrays", "[serialiser][structured]")
+{
+  StreamWriter *buf = new StreamWriter(StreamWriter::DefaultScratchSize);
+
+  const uint64_t numIndices = 1000;
+
+  uint32_t *indices = new uint32_t[numIndices];
+  for(uint32_t i = 0; i < numIndices; i++)
+    indices[i] = i * 3 + 7;
+
+  // write a dynamic array and a vector of POD elements - these go through the bulk fast path
+  {
+    WriteSerialiser ser(buf, Ownership::Nothing);
+
+    {
+      SCOPED_SERIALISE_CHUNK(6);
+
+      uint64_t count = numIndices;
+
+      std::vector<uint32_t> v(indices, indices + numIndices);
+
+      SERIALISE_ELEMENT_ARRAY(indices, count);
+      SERIALISE_ELEMENT(v);
+    }
+
+    REQUIRE_FALSE(ser.IsErrored());
+  }
+
+  // plain read - also the bulk path
+  {
+    ReadSerialiser ser(new StreamReader(buf->GetData(), buf->GetOffset()), Ownership::Stream);
+
+    uint32_t chunkID = ser.ReadChunk<uint32_t>();
+
+    CHECK(chunkID == 6);
+
+    {
+      uint32_t *readIndices = NULL;
+      uint64_t count = 0;
+      std::vector<uint32_t> v;
+
+      SERIALISE_ELEMENT_ARRAY(readIndices, count);
+      SERIALISE_ELEMENT(v);
+
+      REQUIRE(count == numIndices);
+      REQUIRE(v.size() == numIndices);
+
+      CHECK_FALSE(memcmp(readIndices, indices, numIndices * sizeof(uint32_t)));
+      CHECK_FALSE(memcmp(v.data(), indices, numIndices * sizeof(uint32_t)));
+    }
+
+    ser.EndChunk();
+
+    REQUIRE_FALSE(ser.IsErrored());
+
+    CHECK(ser.GetReader()->AtEnd());
+  }
+
+  // read with structured export - which visits every element individually - and rewrite. The
+  // result must be bitwise identical to the bulk-written stream.
+  {
+    ReadSerialiser ser(new StreamReader(buf->GetData(), buf->GetOffset()), Ownership::Stream);
+
+    ser.ConfigureStructuredExport([](uint32_t) -> std::string { return "TestChunk"; }, true);
+
+    ser.ReadChunk<uint32_t>();
+    {
+      uint32_t *readIndices = NULL;
+      uint64_t count = 0;
+      std::vector<uint32_t> v;
+
+      SERIALISE_ELEMENT_ARRAY(readIndices, count);
+      SERIALISE_ELEMENT(v);
+    }
+    ser.EndChunk();
+
+    REQUIRE_FALSE(ser.IsErrored());
+
+    CHECK(ser.GetReader()->AtEnd());
+
+    const SDFile &structData = ser.GetStructuredFile();
+
+    StreamWriter *rewriteBuf = new StreamWriter(StreamWriter::DefaultScratchSize);
+
+    {
+      WriteSerialiser rewrite(rewriteBuf, Ownership::Nothing);
+
+      rewrite.WriteStructuredFile(structData, NULL);
+    }
+
+    REQUIRE(rewriteBuf->GetOffset() == buf->GetOffset());
+    CHECK_FALSE(memcmp(rewriteBuf->GetData(), buf->GetData(), (size_t)rewriteBuf->GetOffset()));
+
+    delete rewriteBuf;
+  }
+
+  delete[] indices;
+  delete buf;
+};
+
 struct struct1
 {
   struct1() : x(0.0f), y(0.0f), width(0.0f), height(0.0f) {}
@@ -1421,6 +1521,30 @@ rdcstr DoStringise(const TestBitfield &el)
 
 TEST_CASE("Test stringification works as expected", "[tostr]")
 {
+  SECTION("Integers")
+  {
+    CHECK(ToStr(uint32_t(0)) == "0");
+    CHECK(ToStr(uint32_t(9)) == "9");
+    CHECK(ToStr(uint32_t(10)) == "10");
+    CHECK(ToStr(uint32_t(99)) == "99");
+    CHECK(ToStr(uint32_t(100)) == "100");
+    CHECK(ToStr(uint32_t(12345)) == "12345");
+    CHECK(ToStr(UINT32_MAX) == "4294967295");
+    CHECK(ToStr(UINT64_MAX) == "18446744073709551615");
+
+    CHECK(ToStr(int32_t(0)) == "0");
+    CHECK(ToStr(int32_t(-1)) == "-1");
+    CHECK(ToStr(int32_t(-100)) == "-100");
+    CHECK(ToStr(INT32_MIN) == "-2147483648");
+    CHECK(ToStr(INT32_MAX) == "2147483647");
+    CHECK(ToStr(INT64_MIN) == "-9223372036854775808");
+    CHECK(ToStr(INT64_MAX) == "9223372036854775807");
+
+    CHECK(ToStr(uint16_t(65535)) == "65535");
+    CHECK(ToStr(int16_t(-32768)) == "-32768");
+    CHECK(ToStr(byte(255)) == "255");
+  };
+
   SECTION("Enum classes")
   {
     TestEnumClass foo = TestEnumClass::A;
@@ -1528,4 +1652,92 @@ TEST_CASE("Test stringification works as expected", "[tostr]")
   };
 };
 
+TEST_CASE("Test chunk page allocator", "[serialiser][chunks]")
+{
+  SECTION("Small suballocations")
+  {
+    std::vector<byte *> allocs;
+
+    // allocate enough small buffers to spill over several pages
+    for(uint32_t i = 0; i < 1000; i++)
+    {
+      byte *alloc = ChunkAllocator::Alloc(1000);
+
+      REQUIRE(alloc != NULL);
+
+      // check alignment matches AllocAlignedBuffer
+      CHECK(uintptr_t(alloc) % 64 == 0);
+
+      memset(alloc, int(i & 0xff), 1000);
+
+      allocs.push_back(alloc);
+    }
+
+    // check no allocation was trampled by a later one, then free out of order
+    for(uint32_t i = 0; i < 1000; i++)
+    {
+      byte expect[16];
+      memset(expect, int(i & 0xff), sizeof(expect));
+
+      CHECK(memcmp(allocs[i], expect, sizeof(expect)) == 0);
+      CHECK(memcmp(allocs[i] + 1000 - sizeof(expect), expect, sizeof(expect)) == 0);
+    }
+
+    for(uint32_t i = 0; i < 1000; i += 2)
+      ChunkAllocator::Free(allocs[i]);
+    for(uint32_t i = 1; i < 1000; i += 2)
+      ChunkAllocator::Free(allocs[i]);
+  };
+
+  SECTION("Referenced allocations survive an unbalanced free")
+  {
+    byte *alloc = ChunkAllocator::Alloc(256);
+
+    REQUIRE(alloc != NULL);
+
+    memset(alloc, 0x3a, 256);
+
+    // take a second reference, as Chunk::Duplicate does, and free once - the payload must still
+    // be intact for the sharing owner
+    ChunkAllocator::AddRef(alloc);
+    ChunkAllocator::Free(alloc);
+
+    byte expect[16];
+    memset(expect, 0x3a, sizeof(expect));
+
+    CHECK(memcmp(alloc, expect, sizeof(expect)) == 0);
+
+    ChunkAllocator::Free(alloc);
+  };
+
+  SECTION("Oversized allocations fall back to the heap")
+  {
+    byte *alloc = ChunkAllocator::Alloc(4 * 1024 * 1024);
+
+    REQUIRE(alloc != NULL);
+    CHECK(uintptr_t(alloc) % 64 == 0);
+
+    memset(alloc, 0x7c, 4 * 1024 * 1024);
+
+    ChunkAllocator::Free(alloc);
+  };
+
+  SECTION("Freed pages are re-used")
+  {
+    // everything above was freed, so allocating again shouldn't grow the page list - just check
+    // this doesn't crash or return bad memory after a release of the free pages.
+    ChunkAllocator::ReleaseFreePages();
+
+    byte *alloc = ChunkAllocator::Alloc(128);
+
+    REQUIRE(alloc != NULL);
+
+    memset(alloc, 0xfe, 128);
+
+    ChunkAllocator::Free(alloc);
+
+    ChunkAllocator::Free(NULL);
+  };
+};
+
 #endif    // ENABLED(ENABLE_UNIT_TESTS)
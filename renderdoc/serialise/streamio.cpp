@@ -40,6 +40,281 @@ Decompressor::~Decompressor()
 
 static const uint64_t initialBufferSize = 64 * 1024;
 const byte StreamWriter::empty[128] = {};
+const uint64_t PipelinedDecompressor::WindowSize;
+const uint64_t PipelinedCompressor::WindowSize;
+
+PipelinedCompressor::PipelinedCompressor(Compressor *inner, Ownership own)
+    : Compressor(NULL, own), m_Inner(inner)
+{
+  m_Window[0] = AllocAlignedBuffer(WindowSize);
+  m_Window[1] = AllocAlignedBuffer(WindowSize);
+
+  m_WindowLength[0] = m_WindowLength[1] = 0;
+  m_WindowState[0] = m_WindowState[1] = 0;
+}
+
+PipelinedCompressor::~PipelinedCompressor()
+{
+  if(m_Thread)
+  {
+    // Finish() was never called, e.g. an error path abandoned the stream. Bail out rather than
+    // write a partial tail.
+    Atomic::Inc32(&m_Shutdown);
+
+    Threading::JoinThread(m_Thread);
+    Threading::CloseThread(m_Thread);
+  }
+
+  FreeAlignedBuffer(m_Window[0]);
+  FreeAlignedBuffer(m_Window[1]);
+
+  if(m_Ownership == Ownership::Stream && m_Inner)
+    delete m_Inner;
+}
+
+void PipelinedCompressor::StartThread()
+{
+  m_Thread = Threading::CreateThread([this]() { ThreadEntry(); });
+}
+
+void PipelinedCompressor::ThreadEntry()
+{
+  int workWindow = 0;
+
+  while(m_Shutdown == 0)
+  {
+    // wait for the next window to be filled by the producer. Windows are filled and written
+    // strictly in order, so once we're finishing an empty window means everything is drained.
+    while(m_WindowState[workWindow] != 1 && m_Shutdown == 0)
+    {
+      if(m_Finishing != 0 && m_WindowState[workWindow] != 1)
+        return;
+
+      Threading::Sleep(0);
+    }
+
+    if(m_Shutdown != 0)
+      return;
+
+    bool success = m_Inner->Write(m_Window[workWindow], m_WindowLength[workWindow]);
+
+    if(!success)
+    {
+      Atomic::Inc32(&m_ThreadError);
+      return;
+    }
+
+    Atomic::CmpExch32(&m_WindowState[workWindow], 1, 0);
+
+    workWindow = 1 - workWindow;
+  }
+}
+
+bool PipelinedCompressor::Write(const void *data, uint64_t numBytes)
+{
+  if(numBytes == 0)
+    return true;
+
+  if(!m_Thread)
+    StartThread();
+
+  const byte *src = (const byte *)data;
+
+  while(numBytes > 0)
+  {
+    // wait for the current window to be handed back by the worker
+    while(m_WindowState[m_FillWindow] != 0)
+    {
+      if(m_ThreadError != 0)
+        return false;
+
+      Threading::Sleep(0);
+    }
+
+    if(m_ThreadError != 0)
+      return false;
+
+    uint64_t space = WindowSize - m_FillOffset;
+    uint64_t copyBytes = RDCMIN(space, numBytes);
+
+    memcpy(m_Window[m_FillWindow] + m_FillOffset, src, (size_t)copyBytes);
+
+    src += copyBytes;
+    numBytes -= copyBytes;
+    m_FillOffset += copyBytes;
+
+    // filled this window, hand it to the worker and move to the other one
+    if(m_FillOffset == WindowSize)
+    {
+      m_WindowLength[m_FillWindow] = WindowSize;
+      m_FillOffset = 0;
+      Atomic::CmpExch32(&m_WindowState[m_FillWindow], 0, 1);
+      m_FillWindow = 1 - m_FillWindow;
+    }
+  }
+
+  return true;
+}
+
+bool PipelinedCompressor::Finish()
+{
+  // no data was ever written, nothing to drain
+  if(!m_Thread)
+    return m_Inner->Finish();
+
+  // push out any partial window
+  if(m_FillOffset > 0)
+  {
+    while(m_WindowState[m_FillWindow] != 0 && m_ThreadError == 0)
+      Threading::Sleep(0);
+
+    if(m_ThreadError == 0)
+    {
+      m_WindowLength[m_FillWindow] = m_FillOffset;
+      m_FillOffset = 0;
+      Atomic::CmpExch32(&m_WindowState[m_FillWindow], 0, 1);
+      m_FillWindow = 1 - m_FillWindow;
+    }
+  }
+
+  // tell the worker to exit once it has written all outstanding windows
+  Atomic::Inc32(&m_Finishing);
+
+  Threading::JoinThread(m_Thread);
+  Threading::CloseThread(m_Thread);
+  m_Thread = 0;
+
+  if(m_ThreadError != 0)
+    return false;
+
+  return m_Inner->Finish();
+}
+
+PipelinedDecompressor::PipelinedDecompressor(Decompressor *inner, uint64_t uncompressedSize,
+                                             Ownership own)
+    : Decompressor(NULL, own), m_Inner(inner), m_RemainingInput(uncompressedSize)
+{
+  m_Window[0] = AllocAlignedBuffer(WindowSize);
+  m_Window[1] = AllocAlignedBuffer(WindowSize);
+
+  m_WindowLength[0] = m_WindowLength[1] = 0;
+  m_WindowState[0] = m_WindowState[1] = 0;
+}
+
+PipelinedDecompressor::~PipelinedDecompressor()
+{
+  if(m_Thread)
+  {
+    // force the worker to bail out - it only ever waits for a window to become empty, so mark
+    // both windows as drained so it wakes up and notices the shutdown flag.
+    Atomic::Inc32(&m_Shutdown);
+    m_WindowState[0] = 0;
+    m_WindowState[1] = 0;
+
+    Threading::JoinThread(m_Thread);
+    Threading::CloseThread(m_Thread);
+  }
+
+  FreeAlignedBuffer(m_Window[0]);
+  FreeAlignedBuffer(m_Window[1]);
+
+  if(m_Ownership == Ownership::Stream && m_Inner)
+    delete m_Inner;
+}
+
+bool PipelinedDecompressor::Recompress(Compressor *comp)
+{
+  // recompression is a straight streamed copy, there's no parsing to overlap with so just
+  // delegate to the inner decompressor. Only valid before any Read() has started the thread.
+  RDCASSERT(m_Thread == 0);
+  return m_Inner->Recompress(comp);
+}
+
+void PipelinedDecompressor::StartThread()
+{
+  m_Thread = Threading::CreateThread([this]() { ThreadEntry(); });
+}
+
+void PipelinedDecompressor::ThreadEntry()
+{
+  int fillWindow = 0;
+
+  while(m_RemainingInput > 0 && m_Shutdown == 0)
+  {
+    // wait for the window to be drained by the consumer
+    while(m_WindowState[fillWindow] != 0 && m_Shutdown == 0)
+      Threading::Sleep(0);
+
+    if(m_Shutdown != 0)
+      break;
+
+    uint64_t chunkSize = RDCMIN(WindowSize, m_RemainingInput);
+
+    bool success = m_Inner->Read(m_Window[fillWindow], chunkSize);
+
+    if(!success)
+    {
+      Atomic::Inc32(&m_ThreadError);
+
+      // mark the window ready so the consumer wakes up and sees the error
+      m_WindowLength[fillWindow] = 0;
+      Atomic::CmpExch32(&m_WindowState[fillWindow], 0, 1);
+      return;
+    }
+
+    m_RemainingInput -= chunkSize;
+    m_WindowLength[fillWindow] = chunkSize;
+
+    Atomic::CmpExch32(&m_WindowState[fillWindow], 0, 1);
+
+    fillWindow = 1 - fillWindow;
+  }
+}
+
+bool PipelinedDecompressor::Read(void *data, uint64_t numBytes)
+{
+  if(numBytes == 0)
+    return true;
+
+  if(!m_Thread)
+    StartThread();
+
+  byte *dst = (byte *)data;
+
+  while(numBytes > 0)
+  {
+    // wait for the current window to be filled by the worker
+    while(m_WindowState[m_ConsumeWindow] != 1)
+    {
+      if(m_ThreadError != 0)
+        return false;
+
+      Threading::Sleep(0);
+    }
+
+    if(m_ThreadError != 0)
+      return false;
+
+    uint64_t available = m_WindowLength[m_ConsumeWindow] - m_ConsumeOffset;
+    uint64_t copyBytes = RDCMIN(available, numBytes);
+
+    memcpy(dst, m_Window[m_ConsumeWindow] + m_ConsumeOffset, (size_t)copyBytes);
+
+    dst += copyBytes;
+    numBytes -= copyBytes;
+    m_ConsumeOffset += copyBytes;
+
+    // fully drained this window, hand it back to the worker and move to the other one
+    if(m_ConsumeOffset == m_WindowLength[m_ConsumeWindow])
+    {
+      m_ConsumeOffset = 0;
+      Atomic::CmpExch32(&m_WindowState[m_ConsumeWindow], 1, 0);
+      m_ConsumeWindow = 1 - m_ConsumeWindow;
+    }
+  }
+
+  return true;
+}
 
 StreamReader::StreamReader(const byte *buffer, uint64_t bufferSize)
 {
@@ -61,6 +336,18 @@ StreamReader::StreamReader(const std::vector<byte> &buffer)
   m_Ownership = Ownership::Nothing;
 }
 
+StreamReader::StreamReader(StreamExternalType, const byte *buffer, uint64_t bufferSize)
+{
+  m_InputSize = m_BufferSize = bufferSize;
+
+  // we never write through this pointer, but the head works in non-const bytes
+  m_BufferHead = m_BufferBase = (byte *)buffer;
+
+  m_ExternalBuffer = true;
+
+  m_Ownership = Ownership::Nothing;
+}
+
 StreamReader::StreamReader(StreamInvalidType)
 {
   m_InputSize = 0;
@@ -173,12 +460,52 @@ StreamReader::StreamReader(Decompressor *decompressor, uint64_t uncompressedSize
   ReadFromExternal(0, RDCMIN(uncompressedSize, m_BufferSize));
 }
 
+StreamReader::StreamReader(Decompressor *decompressor, Ownership own)
+{
+  m_Decompressor = decompressor;
+  m_StreamingSource = true;
+
+  // like sockets, m_InputSize tracks how much data has been read into the buffer so far. We don't
+  // pre-fill the buffer since the other end may not have sent anything yet.
+  m_InputSize = 0;
+
+  m_BufferSize = initialBufferSize;
+  m_BufferHead = m_BufferBase = AllocAlignedBuffer(m_BufferSize);
+
+  m_Ownership = own;
+}
+
+StreamReader::StreamReader(StreamReopenCallback reopen, uint64_t baseOffset, uint64_t totalSize,
+                           uint64_t windowSize)
+{
+  m_Reopen = reopen;
+  m_SourceBaseOffset = baseOffset;
+  m_InputSize = totalSize;
+
+  m_BufferSize = RDCMIN(totalSize, windowSize);
+  m_BufferHead = m_BufferBase = AllocAlignedBuffer(m_BufferSize);
+
+  m_Ownership = Ownership::Stream;
+
+  m_Source = m_Reopen();
+
+  if(!m_Source || !m_Source->SkipBytes(m_SourceBaseOffset))
+  {
+    RDCERR("Couldn't open source stream for windowed reader");
+    m_HasError = true;
+    return;
+  }
+
+  ReadFromExternal(0, m_BufferSize);
+}
+
 StreamReader::~StreamReader()
 {
   for(StreamCloseCallback cb : m_Callbacks)
     cb();
 
-  FreeAlignedBuffer(m_BufferBase);
+  if(!m_ExternalBuffer)
+    FreeAlignedBuffer(m_BufferBase);
 
   if(m_Ownership == Ownership::Stream)
   {
@@ -188,10 +515,64 @@ StreamReader::~StreamReader()
     if(m_Decompressor)
       delete m_Decompressor;
   }
+
+  // the source reader for a windowed reader is always ours, since we created it via the callback
+  SAFE_DELETE(m_Source);
 }
 
 void StreamReader::SetOffset(uint64_t offs)
 {
+  if(m_Source)
+  {
+    if(offs > m_InputSize)
+    {
+      RDCERR("Seeking off the end of the stream");
+      m_HasError = true;
+      return;
+    }
+
+    uint64_t filled = RDCMIN(m_BufferSize, m_InputSize - m_ReadOffset);
+
+    // if the target is inside the resident window, just move the head
+    if(offs >= m_ReadOffset && offs < m_ReadOffset + filled)
+    {
+      m_BufferHead = m_BufferBase + (offs - m_ReadOffset);
+      return;
+    }
+
+    // the source always sits at the end of the resident window. Seeking forwards just skips
+    // through it, but seeking backwards means re-opening it and reading forwards from the start
+    // again, since forward-only sources (i.e. compressed data) can't rewind.
+    uint64_t sourcePos = m_ReadOffset + filled;
+
+    if(offs < sourcePos)
+    {
+      delete m_Source;
+      m_Source = m_Reopen();
+      sourcePos = 0;
+
+      if(m_Source)
+        m_Source->SkipBytes(m_SourceBaseOffset + offs);
+    }
+    else
+    {
+      m_Source->SkipBytes(offs - sourcePos);
+    }
+
+    if(!m_Source || m_Source->IsErrored())
+    {
+      RDCERR("Couldn't re-open source stream seeking windowed reader");
+      m_HasError = true;
+      return;
+    }
+
+    // refill the window from the new position
+    m_ReadOffset = offs;
+    m_BufferHead = m_BufferBase;
+    ReadFromExternal(0, RDCMIN(m_BufferSize, m_InputSize - offs));
+    return;
+  }
+
   if(m_File || m_Decompressor)
   {
     RDCERR("File and decompress stream readers do not support seeking");
@@ -203,7 +584,7 @@ void StreamReader::SetOffset(uint64_t offs)
 
 bool StreamReader::Reserve(uint64_t numBytes)
 {
-  RDCASSERT(m_Sock || m_File || m_Decompressor);
+  RDCASSERT(m_Sock || m_File || m_Decompressor || m_Source);
 
   // store old buffer and the read data, so we can move it into the new buffer
   byte *oldBuffer = m_BufferBase;
@@ -214,7 +595,7 @@ bool StreamReader::Reserve(uint64_t numBytes)
   byte *currentData = m_BufferHead - backwardsWindow;
   uint64_t currentDataSize = m_BufferSize - (m_BufferHead - m_BufferBase) + backwardsWindow;
 
-  if(m_Sock)
+  if(m_Sock || m_StreamingSource)
     currentDataSize = m_InputSize - (m_BufferHead - m_BufferBase) + backwardsWindow;
 
   uint64_t BufferOffset = m_BufferHead - m_BufferBase;
@@ -242,7 +623,7 @@ bool StreamReader::Reserve(uint64_t numBytes)
     m_BufferHead = m_BufferBase + BufferOffset;
   }
 
-  if(m_Sock)
+  if(m_Sock || m_StreamingSource)
     m_InputSize = currentDataSize;
 
   // if there's anything left of the file to read in, do so now
@@ -252,8 +633,9 @@ bool StreamReader::Reserve(uint64_t numBytes)
       RDCMIN(m_BufferSize - currentDataSize, m_InputSize - m_ReadOffset - currentDataSize);
 
   // we'll read as much as possible anyway using m_BufferSize, but we need to know how much we
-  // *must* read.
-  if(m_Sock)
+  // *must* read. Streaming decompressors are the same - asking for more would block until the
+  // other end sends data it may not have flushed yet.
+  if(m_Sock || m_StreamingSource)
     readSize = numBytes - Available();
 
   ret = ReadFromExternal(currentDataSize, readSize);
@@ -271,6 +653,13 @@ bool StreamReader::ReadFromExternal(uint64_t bufferOffs, uint64_t length)
   if(m_Decompressor)
   {
     success = m_Decompressor->Read(m_BufferBase + bufferOffs, length);
+
+    if(success && m_StreamingSource)
+      m_InputSize += length;
+  }
+  else if(m_Source)
+  {
+    success = m_Source->Read(m_BufferBase + bufferOffs, length) && !m_Source->IsErrored();
   }
   else if(m_File)
   {
@@ -335,6 +724,8 @@ bool StreamReader::ReadFromExternal(uint64_t bufferOffs, uint64_t length)
         delete m_Decompressor;
     }
 
+    SAFE_DELETE(m_Source);
+
     m_File = NULL;
     m_Sock = NULL;
     m_Decompressor = NULL;
@@ -368,10 +759,10 @@ StreamWriter::StreamWriter(StreamInvalidType)
   m_HasError = true;
 }
 
-StreamWriter::StreamWriter(Network::Socket *sock, Ownership own)
+StreamWriter::StreamWriter(Network::Socket *sock, Ownership own, uint64_t coalesceBufferSize)
 {
-  m_BufferBase = m_BufferHead = AllocAlignedBuffer(initialBufferSize);
-  m_BufferEnd = m_BufferBase + initialBufferSize;
+  m_BufferBase = m_BufferHead = AllocAlignedBuffer(coalesceBufferSize);
+  m_BufferEnd = m_BufferBase + coalesceBufferSize;
 
   m_Sock = sock;
 
@@ -418,9 +809,17 @@ StreamWriter::~StreamWriter()
 
 bool StreamWriter::SendSocketData(const void *data, uint64_t numBytes)
 {
-  // try to coalesce small writes without doing blocking sends, at least until we're flushed.
-  // if the buffer is already full, flush it.
-  if(m_BufferHead + numBytes >= m_BufferEnd)
+  // try to coalesce small writes without doing blocking sends, at least until we're flushed
+  if(m_BufferHead + numBytes < m_BufferEnd)
+  {
+    memcpy(m_BufferHead, data, (size_t)numBytes);
+    m_BufferHead += numBytes;
+    return true;
+  }
+
+  // too large to coalesce with what's already buffered, but small enough for an empty buffer -
+  // flush and coalesce as above
+  if(m_BufferBase + numBytes < m_BufferEnd)
   {
     bool success = FlushSocketData();
     if(!success)
@@ -428,25 +827,39 @@ bool StreamWriter::SendSocketData(const void *data, uint64_t numBytes)
       HandleError();
       return false;
     }
+
+    memcpy(m_BufferHead, data, (size_t)numBytes);
+    m_BufferHead += numBytes;
+    return true;
   }
 
-  // if it's larger than our buffer (even after flushing) just write directly
-  if(m_BufferHead + numBytes >= m_BufferEnd)
+  // larger than the coalescing buffer entirely - hand whatever we've coalesced (typically a chunk
+  // header) and the payload to the kernel in a single vectored send. The payload goes out without
+  // being copied through our buffer, and without splitting the header into a separate send.
+  Network::Socket::SendVec vecs[2];
+  uint32_t count = 0;
+
+  if(m_BufferHead > m_BufferBase)
   {
-    bool success = m_Sock->SendDataBlocking(data, (uint32_t)numBytes);
-    if(!success)
-    {
-      HandleError();
-      return false;
-    }
+    vecs[count].data = m_BufferBase;
+    vecs[count].length = uint32_t(m_BufferHead - m_BufferBase);
+    count++;
   }
-  else
+
+  vecs[count].data = data;
+  vecs[count].length = (uint32_t)numBytes;
+  count++;
+
+  bool success = m_Sock->SendDataVectoredBlocking(vecs, count);
+  if(!success)
   {
-    // otherwise, write it into the in-memory buffer
-    memcpy(m_BufferHead, data, (size_t)numBytes);
-    m_BufferHead += numBytes;
+    HandleError();
+    return false;
   }
 
+  // the buffered data went out with the payload, reset the buffer to the start
+  m_BufferHead = m_BufferBase;
+
   return true;
 }
 
@@ -39,6 +39,7 @@ class StreamWriter;
 class StreamReader;
 
 typedef std::function<void()> StreamCloseCallback;
+typedef std::function<StreamReader *()> StreamReopenCallback;
 
 class Compressor
 {
@@ -47,12 +48,62 @@ public:
   virtual ~Compressor();
   virtual bool Write(const void *data, uint64_t numBytes) = 0;
   virtual bool Finish() = 0;
+  // emit any buffered input so the reading end can make progress, without ending the stream. A
+  // no-op by default - file compressors deliberately ignore flushes to keep their block layout,
+  // only interactive transports implement this (see LZ4FlushingCompressor).
+  virtual bool Flush() { return true; }
 
 protected:
   StreamWriter *m_Write;
   Ownership m_Ownership;
 };
 
+// wraps another compressor and runs it on a background thread, compressing and writing the
+// previous window of data while the producing thread fills the next one. This pipelines
+// serialisation with compression and disk IO when writing large sections, instead of
+// alternating between them on one thread.
+class PipelinedCompressor : public Compressor
+{
+public:
+  PipelinedCompressor(Compressor *inner, Ownership own);
+  ~PipelinedCompressor();
+
+  bool Write(const void *data, uint64_t numBytes);
+  bool Finish();
+
+  static const uint64_t WindowSize = 4 * 1024 * 1024;
+
+private:
+  void StartThread();
+  void ThreadEntry();
+
+  Compressor *m_Inner;
+
+  // double-buffered windows of uncompressed data. The producer fills a window and marks it
+  // ready, the worker compresses it through the inner compressor and marks it empty again.
+  byte *m_Window[2];
+  uint64_t m_WindowLength[2];
+
+  // 0 = empty (producer may fill), 1 = ready (worker may compress). Only ever written by the
+  // owning side - producer moves 0 -> 1, worker moves 1 -> 0.
+  volatile int32_t m_WindowState[2];
+
+  // which window the producer is currently filling, and how far through it we are
+  int m_FillWindow = 0;
+  uint64_t m_FillOffset = 0;
+
+  // set by the worker if the inner compressor fails
+  volatile int32_t m_ThreadError = 0;
+
+  // set by Finish() so the worker exits once all outstanding windows are written
+  volatile int32_t m_Finishing = 0;
+
+  // set by the destructor to make the worker bail out early if Finish() was never called
+  volatile int32_t m_Shutdown = 0;
+
+  Threading::ThreadHandle m_Thread = 0;
+};
+
 class Decompressor
 {
 public:
@@ -66,6 +117,51 @@ protected:
   Ownership m_Ownership;
 };
 
+// wraps another decompressor and runs it on a background thread, decompressing the next window of
+// data while the consuming thread reads the current one. This pipelines decompression with parsing
+// when reading large compressed sections, instead of alternating between the two on one thread.
+class PipelinedDecompressor : public Decompressor
+{
+public:
+  PipelinedDecompressor(Decompressor *inner, uint64_t uncompressedSize, Ownership own);
+  ~PipelinedDecompressor();
+
+  bool Recompress(Compressor *comp);
+  bool Read(void *data, uint64_t numBytes);
+
+  static const uint64_t WindowSize = 4 * 1024 * 1024;
+
+private:
+  void StartThread();
+  void ThreadEntry();
+
+  Decompressor *m_Inner;
+
+  // double-buffered windows of decompressed data. The worker fills a window and marks it ready,
+  // the consumer drains it and marks it empty again.
+  byte *m_Window[2];
+  uint64_t m_WindowLength[2];
+
+  // 0 = empty (worker may fill), 1 = ready (consumer may read). Only ever written by the owning
+  // side - worker moves 0 -> 1, consumer moves 1 -> 0.
+  volatile int32_t m_WindowState[2];
+
+  // which window the consumer is currently draining, and how far through it we are
+  int m_ConsumeWindow = 0;
+  uint64_t m_ConsumeOffset = 0;
+
+  // total bytes the worker still has to pull from the inner decompressor
+  uint64_t m_RemainingInput;
+
+  // set by the worker if the inner decompressor fails
+  volatile int32_t m_ThreadError = 0;
+
+  // set by the destructor to make the worker bail out early
+  volatile int32_t m_Shutdown = 0;
+
+  Threading::ThreadHandle m_Thread = 0;
+};
+
 class StreamReader
 {
 public:
@@ -77,10 +173,17 @@ public:
   {
     DummyStream
   };
+  enum StreamExternalType
+  {
+    ExternalBuffer
+  };
 
   StreamReader(StreamInvalidType);
   StreamReader(StreamDummyType);
   StreamReader(const byte *buffer, uint64_t bufferSize);
+  // wraps an externally-owned buffer without copying it. The buffer must stay valid for the
+  // lifetime of this reader - used e.g. for zero-copy reads out of a memory-mapped file.
+  StreamReader(StreamExternalType, const byte *buffer, uint64_t bufferSize);
   StreamReader(const std::vector<byte> &buffer);
 
   StreamReader(Network::Socket *sock, Ownership own);
@@ -88,6 +191,17 @@ public:
   StreamReader(FILE *file);
   StreamReader(StreamReader *reader, uint64_t bufferSize);
   StreamReader(Decompressor *decompressor, uint64_t uncompressedSize, Ownership own);
+  // streaming decompressor reader with no known total size, e.g. over a socket. Reads pull exactly
+  // as many decompressed bytes as required, so the reader never blocks waiting for data beyond
+  // what the other end has flushed.
+  StreamReader(Decompressor *decompressor, Ownership own);
+  // windowed random-access reader over a forward-only source such as a compressed section. Only
+  // around windowSize bytes of the source are resident at once - forward seeks skip through the
+  // source, and backwards seeks re-open it with the callback and read forwards again from the
+  // start, trading decompression time for memory. baseOffset is where this reader's data begins
+  // within the re-opened stream, totalSize how many bytes belong to this reader.
+  StreamReader(StreamReopenCallback reopen, uint64_t baseOffset, uint64_t totalSize,
+               uint64_t windowSize);
 
   ~StreamReader();
 
@@ -100,7 +214,7 @@ public:
   {
     if(m_Dummy)
       return false;
-    if(m_Sock)
+    if(m_Sock || m_StreamingSource)
       return Available() == 0;
     return GetOffset() >= GetSize();
   }
@@ -118,6 +232,32 @@ public:
     return true;
   }
 
+  // true if this reader wraps an externally-owned buffer (see StreamExternalType) whose lifetime
+  // exceeds the reader, so reads can hand out pointers into the buffer instead of copying.
+  bool IsExternalBuffer() const { return m_ExternalBuffer; }
+  // for external buffer readers only: returns a pointer directly into the underlying storage for
+  // the next numBytes and advances past them, or NULL if this reader can't borrow or the read
+  // would run off the end. The caller must ensure the backing storage outlives every use of the
+  // returned pointer - note that unlike AllocAlignedBuffer the pointer carries no alignment
+  // guarantee beyond its position in the stream.
+  const byte *BorrowRead(uint64_t numBytes)
+  {
+    if(!m_ExternalBuffer || m_Dummy || !m_BufferBase || numBytes == 0)
+      return NULL;
+
+    if(GetOffset() + numBytes > GetSize())
+    {
+      RDCERR("Reading off the end of the stream");
+      m_BufferHead = m_BufferBase + m_BufferSize;
+      m_HasError = true;
+      return NULL;
+    }
+
+    const byte *ret = m_BufferHead;
+    m_BufferHead += numBytes;
+    return ret;
+  }
+
   bool Read(void *data, uint64_t numBytes)
   {
     if(numBytes == 0 || m_Dummy)
@@ -133,7 +273,7 @@ public:
     }
 
     // if we're reading past the end, error, read nothing (no partial reads) and return
-    if(m_Sock == NULL && GetOffset() + numBytes > GetSize())
+    if(m_Sock == NULL && !m_StreamingSource && GetOffset() + numBytes > GetSize())
     {
       RDCERR("Reading off the end of the stream");
       m_BufferHead = m_BufferBase + m_BufferSize;
@@ -144,7 +284,7 @@ public:
     }
 
     // if we're reading from an external source, reserve enough bytes to do the read
-    if(m_File || m_Sock || m_Decompressor)
+    if(m_File || m_Sock || m_Decompressor || m_Source)
     {
       // This preserves everything from min(m_BufferBase, m_BufferHead - 64) -> end of buffer
       // which will still be in place relative to m_BufferHead.
@@ -200,7 +340,9 @@ public:
 private:
   inline uint64_t Available()
   {
-    if(m_Sock)
+    // for sockets and streaming decompressors m_InputSize tracks how much data has actually been
+    // read into the buffer, since the total isn't known up front.
+    if(m_Sock || m_StreamingSource)
       return m_InputSize - (m_BufferHead - m_BufferBase);
     return m_BufferSize - (m_BufferHead - m_BufferBase);
   }
@@ -224,12 +366,22 @@ private:
   // file pointer, if we're reading from a file
   FILE *m_File = NULL;
 
+  // source reader plus the callback to re-open it, if we're a windowed reader. The source is
+  // always positioned at the end of the resident window, and owned by us.
+  StreamReader *m_Source = NULL;
+  StreamReopenCallback m_Reopen;
+  uint64_t m_SourceBaseOffset = 0;
+
   // socket, if we're reading from a socket
   Network::Socket *m_Sock = NULL;
 
   // the decompressor, if reading from it
   Decompressor *m_Decompressor = NULL;
 
+  // true when reading from a decompressor with no known total size - uses socket-style accounting
+  // where m_InputSize grows as data is decompressed into the buffer
+  bool m_StreamingSource = false;
+
   // the offset in the file/decompressor that corresponds to the start of m_BufferBase
   uint64_t m_ReadOffset = 0;
 
@@ -240,6 +392,10 @@ private:
   // structured serialiser to 'read' pre-existing data.
   bool m_Dummy = false;
 
+  // flag indicating the buffer is externally owned (e.g. a memory-mapped file view) and must not
+  // be freed on destruction.
+  bool m_ExternalBuffer = false;
+
   // do we own the file/compressor? are we responsible for
   // cleaning it up?
   Ownership m_Ownership;
@@ -259,11 +415,15 @@ public:
   StreamWriter(StreamInvalidType);
   StreamWriter(uint64_t initialBufSize);
   StreamWriter(FILE *file, Ownership own);
-  StreamWriter(Network::Socket *file, Ownership own);
+  // socket writer. Writes smaller than the coalescing buffer are gathered up and sent together on
+  // the next flush, larger writes bypass the buffer with a vectored send (see SendSocketData).
+  StreamWriter(Network::Socket *sock, Ownership own,
+               uint64_t coalesceBufferSize = DefaultSocketCoalesceSize);
   StreamWriter(Compressor *compressor, Ownership own);
 
   bool IsErrored() { return m_HasError; }
   static const int DefaultScratchSize = 32 * 1024;
+  static const uint64_t DefaultSocketCoalesceSize = 64 * 1024;
 
   ~StreamWriter();
 
@@ -408,7 +568,7 @@ public:
   bool Flush()
   {
     if(m_Compressor)
-      return true;
+      return m_Compressor->Flush();
     else if(m_File)
       return FileIO::fflush(m_File);
     else if(m_Sock)
@@ -308,4 +308,93 @@ TEST_CASE("Test stream I/O operations over the network", "[streamio][network]")
   delete server;
 };
 
+TEST_CASE("Test windowed reader over a forward-only source", "[streamio]")
+{
+  // patterned data so any byte can be verified from its offset
+  const uint64_t dataSize = 1024 * 1024;
+
+  std::vector<byte> data;
+  data.resize((size_t)dataSize);
+
+  for(uint64_t i = 0; i < dataSize; i++)
+    data[i] = byte((i * 7 + (i >> 8)) & 0xff);
+
+  // count re-opens so we can check seeking behaves as expected
+  int reopens = 0;
+
+  const uint64_t baseOffset = 1000;
+  const uint64_t totalSize = dataSize - baseOffset;
+  const uint64_t windowSize = 64 * 1024;
+
+  StreamReader reader(
+      [&data, &reopens]() {
+        reopens++;
+        return new StreamReader(data.data(), data.size());
+      },
+      baseOffset, totalSize, windowSize);
+
+  CHECK(reopens == 1);
+  CHECK(reader.GetSize() == totalSize);
+  CHECK_FALSE(reader.IsErrored());
+
+  byte b = 0;
+
+  SECTION("sequential reads past the window boundary")
+  {
+    for(uint64_t i = 0; i < windowSize * 3; i += 1024)
+    {
+      reader.SetOffset(i);
+      reader.Read(b);
+      CHECK(b == data[(size_t)(baseOffset + i)]);
+    }
+
+    // never went backwards, so the source shouldn't have been re-opened
+    CHECK(reopens == 1);
+    CHECK_FALSE(reader.IsErrored());
+  }
+
+  SECTION("forward seek far past the window")
+  {
+    reader.SetOffset(totalSize - 8);
+    reader.Read(b);
+
+    CHECK(b == data[(size_t)(dataSize - 8)]);
+    CHECK(reopens == 1);
+    CHECK_FALSE(reader.IsErrored());
+  }
+
+  SECTION("backwards seek re-opens the source")
+  {
+    reader.SetOffset(windowSize * 4);
+    reader.Read(b);
+    CHECK(b == data[(size_t)(baseOffset + windowSize * 4)]);
+
+    reader.SetOffset(16);
+    reader.Read(b);
+
+    CHECK(b == data[(size_t)(baseOffset + 16)]);
+    CHECK(reopens == 2);
+
+    // a seek within the re-read window shouldn't re-open again
+    reader.SetOffset(100);
+    reader.Read(b);
+
+    CHECK(b == data[(size_t)(baseOffset + 100)]);
+    CHECK(reopens == 2);
+    CHECK_FALSE(reader.IsErrored());
+  }
+
+  SECTION("large read straddling the window boundary")
+  {
+    std::vector<byte> readback;
+    readback.resize((size_t)windowSize * 2);
+
+    reader.SetOffset(windowSize / 2);
+    reader.Read(readback.data(), readback.size());
+
+    CHECK_FALSE(memcmp(readback.data(), data.data() + baseOffset + windowSize / 2, readback.size()));
+    CHECK_FALSE(reader.IsErrored());
+  }
+};
+
 #endif    // ENABLED(ENABLE_UNIT_TESTS)
\ No newline at end of file
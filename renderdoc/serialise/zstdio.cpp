@@ -28,28 +28,142 @@
 static const uint64_t zstdBlockSize = 128 * 1024;
 static const uint64_t compressBlockSize = ZSTD_compressBound(zstdBlockSize);
 
+// compresses one block into its own zstd frame. Used from the worker threads with per-thread
+// streams, so it must not touch any compressor state.
+static bool CompressZSTDFrame(ZSTD_CStream *stream, ZSTD_inBuffer &in, ZSTD_outBuffer &out)
+{
+  size_t err = ZSTD_initCStream(stream, 7);
+
+  if(ZSTD_isError(err))
+  {
+    RDCERR("Error compressing: %s", ZSTD_getErrorName(err));
+    return false;
+  }
+
+  // keep calling compressStream until everything is consumed
+  while(in.pos < in.size)
+  {
+    size_t inpos = in.pos;
+    size_t outpos = out.pos;
+
+    err = ZSTD_compressStream(stream, &out, &in);
+
+    if(ZSTD_isError(err) || (inpos == in.pos && outpos == out.pos))
+    {
+      if(ZSTD_isError(err))
+        RDCERR("Error compressing: %s", ZSTD_getErrorName(err));
+      else
+        RDCERR("Error compressing, no progress made");
+      return false;
+    }
+  }
+
+  err = ZSTD_endStream(stream, &out);
+
+  if(ZSTD_isError(err) || err != 0)
+  {
+    if(ZSTD_isError(err))
+      RDCERR("Error compressing: %s", ZSTD_getErrorName(err));
+    else
+      RDCERR("Error compressing, couldn't end stream");
+    return false;
+  }
+
+  return true;
+}
+
 ZSTDCompressor::ZSTDCompressor(StreamWriter *write, Ownership own) : Compressor(write, own)
 {
-  m_Page = AllocAlignedBuffer(zstdBlockSize);
-  m_CompressBuffer = AllocAlignedBuffer(compressBlockSize);
+  // leave one core for the thread feeding us data, and cap the gains - zstd at this level
+  // saturates the source stream long before 4 threads on most machines.
+  uint32_t numThreads = RDCMIN(Threading::NumberOfCores() - 1, 4U);
+
+  // enough slots that the workers stay busy while the oldest block drains to the stream
+  m_Jobs.resize(numThreads > 0 ? numThreads * 2 : 1);
+
+  for(Job &job : m_Jobs)
+  {
+    job.page = AllocAlignedBuffer(zstdBlockSize);
+    job.compressBuffer = AllocAlignedBuffer(compressBlockSize);
+  }
 
+  m_Page = m_Jobs[0].page;
   m_PageOffset = 0;
 
   m_Stream = ZSTD_createCStream();
+
+  for(uint32_t i = 0; i < numThreads; i++)
+    m_Threads.push_back(Threading::CreateThread([this]() { WorkerEntry(); }));
 }
 
 ZSTDCompressor::~ZSTDCompressor()
 {
+  Atomic::Inc32(&m_Shutdown);
+
+  for(Threading::ThreadHandle t : m_Threads)
+  {
+    Threading::JoinThread(t);
+    Threading::CloseThread(t);
+  }
+
   ZSTD_freeCStream(m_Stream);
 
-  FreeAlignedBuffer(m_Page);
-  FreeAlignedBuffer(m_CompressBuffer);
+  for(Job &job : m_Jobs)
+  {
+    FreeAlignedBuffer(job.page);
+    FreeAlignedBuffer(job.compressBuffer);
+  }
+}
+
+void ZSTDCompressor::WorkerEntry()
+{
+  ZSTD_CStream *stream = ZSTD_createCStream();
+
+  while(m_Shutdown == 0)
+  {
+    bool found = false;
+
+    for(Job &job : m_Jobs)
+    {
+      if(Atomic::CmpExch32(&job.state, 1, 2) == 1)
+      {
+        ZSTD_inBuffer in = {job.page, (size_t)job.pageSize, 0};
+        ZSTD_outBuffer out = {job.compressBuffer, ZSTD_CStreamOutSize(), 0};
+
+        if(!CompressZSTDFrame(stream, in, out))
+          Atomic::Inc32(&m_Error);
+
+        job.compSize = (uint32_t)out.pos;
+
+        Atomic::CmpExch32(&job.state, 2, 3);
+
+        found = true;
+      }
+    }
+
+    if(!found)
+      Threading::Sleep(0);
+  }
+
+  ZSTD_freeCStream(stream);
+}
+
+bool ZSTDCompressor::WriteJobOutput(Job &job)
+{
+  bool success = true;
+
+  // a bit redundant to write this but it means we can read the entire frame without
+  // doing multiple reads
+  success &= m_Write->Write(job.compSize);
+  success &= m_Write->Write(job.compressBuffer, job.compSize);
+
+  return success;
 }
 
 bool ZSTDCompressor::Write(const void *data, uint64_t numBytes)
 {
-  // if we encountered a stream error this will be NULL
-  if(!m_CompressBuffer)
+  // if we encountered a stream or compression error, bail
+  if(m_Error != 0)
     return false;
 
   if(numBytes == 0)
@@ -107,90 +221,95 @@ bool ZSTDCompressor::Write(const void *data, uint64_t numBytes)
 
 bool ZSTDCompressor::Finish()
 {
-  // This function just writes the current page and closes zstd. Since we assume all blocks are
-  // precisely 64kb in size
-  // only the last one can be smaller, so we only write a partial page when finishing.
-  // Calling Write() after Finish() is illegal
+  // This function writes the current (possibly partial) page, then drains any blocks still being
+  // compressed on the workers, in order. Calling Write() after Finish() is illegal
 
-  return FlushPage();
-}
+  bool success = FlushPage();
 
-bool ZSTDCompressor::FlushPage()
-{
-  // if we encountered a stream error this will be NULL
-  if(!m_CompressBuffer)
-    return false;
+  if(success && !m_Threads.empty())
+  {
+    // the oldest unwritten block is in the slot after the one FlushPage just handed out, since
+    // slots are filled and written in ring order
+    for(size_t i = 1; i < m_Jobs.size() && success; i++)
+    {
+      Job &job = m_Jobs[(m_FillJob + i) % m_Jobs.size()];
 
-  ZSTD_inBuffer in = {m_Page, (size_t)m_PageOffset, 0};
-  ZSTD_outBuffer out = {m_CompressBuffer, ZSTD_CStreamOutSize(), 0};
+      if(job.state == 0)
+        continue;
 
-  bool success = true;
+      while(job.state != 3 && m_Error == 0)
+        Threading::Sleep(0);
 
-  success &= CompressZSTDFrame(in, out);
+      if(m_Error != 0)
+      {
+        success = false;
+        break;
+      }
 
-  // if there was an error, bail
-  if(!m_CompressBuffer)
-    return false;
-
-  // a bit redundant to write this but it means we can read the entire frame without
-  // doing multiple reads
-  success &= m_Write->Write((uint32_t)out.pos);
-  success &= m_Write->Write(m_CompressBuffer, out.pos);
+      success &= WriteJobOutput(job);
 
-  // start writing to the start of the page again
-  m_PageOffset = 0;
+      Atomic::CmpExch32(&job.state, 3, 0);
+    }
+  }
 
   return success;
 }
 
-bool ZSTDCompressor::CompressZSTDFrame(ZSTD_inBuffer &in, ZSTD_outBuffer &out)
+bool ZSTDCompressor::FlushPage()
 {
-  size_t err = ZSTD_initCStream(m_Stream, 7);
-
-  if(ZSTD_isError(err))
-  {
-    RDCERR("Error compressing: %s", ZSTD_getErrorName(err));
-    FreeAlignedBuffer(m_Page);
-    FreeAlignedBuffer(m_CompressBuffer);
-    m_Page = m_CompressBuffer = NULL;
+  // if we encountered a stream or compression error, bail
+  if(m_Error != 0)
     return false;
-  }
 
-  // keep calling compressStream until everything is consumed
-  while(in.pos < in.size)
-  {
-    size_t inpos = in.pos;
-    size_t outpos = out.pos;
+  Job &job = m_Jobs[m_FillJob];
+  job.pageSize = m_PageOffset;
 
-    err = ZSTD_compressStream(m_Stream, &out, &in);
+  if(m_Threads.empty())
+  {
+    // single-core fallback - compress and write in place
+    ZSTD_inBuffer in = {job.page, (size_t)job.pageSize, 0};
+    ZSTD_outBuffer out = {job.compressBuffer, ZSTD_CStreamOutSize(), 0};
 
-    if(ZSTD_isError(err) || (inpos == in.pos && outpos == out.pos))
+    if(!CompressZSTDFrame(m_Stream, in, out))
     {
-      if(ZSTD_isError(err))
-        RDCERR("Error compressing: %s", ZSTD_getErrorName(err));
-      else
-        RDCERR("Error compressing, no progress made");
-      FreeAlignedBuffer(m_Page);
-      FreeAlignedBuffer(m_CompressBuffer);
-      m_Page = m_CompressBuffer = NULL;
+      Atomic::Inc32(&m_Error);
       return false;
     }
+
+    job.compSize = (uint32_t)out.pos;
+
+    m_PageOffset = 0;
+
+    return WriteJobOutput(job);
   }
 
-  err = ZSTD_endStream(m_Stream, &out);
+  // hand the block to the workers
+  Atomic::CmpExch32(&job.state, 0, 1);
 
-  if(ZSTD_isError(err) || err != 0)
+  m_FillJob = (m_FillJob + 1) % m_Jobs.size();
+
+  Job &next = m_Jobs[m_FillJob];
+
+  // if the next slot in the ring still holds an in-flight block, wait for it to finish
+  // compressing and write its output - blocks hit the stream strictly in ring order
+  if(next.state != 0)
   {
-    if(ZSTD_isError(err))
-      RDCERR("Error compressing: %s", ZSTD_getErrorName(err));
-    else
-      RDCERR("Error compressing, couldn't end stream");
-    FreeAlignedBuffer(m_Page);
-    FreeAlignedBuffer(m_CompressBuffer);
-    m_Page = m_CompressBuffer = NULL;
-    return false;
+    while(next.state != 3 && m_Error == 0)
+      Threading::Sleep(0);
+
+    if(m_Error != 0)
+      return false;
+
+    if(!WriteJobOutput(next))
+      return false;
+
+    Atomic::CmpExch32(&next.state, 3, 0);
   }
 
+  // start writing to the start of the new slot's page
+  m_Page = next.page;
+  m_PageOffset = 0;
+
   return true;
 }
 
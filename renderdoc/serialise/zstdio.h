@@ -37,14 +37,39 @@ public:
   bool Finish();
 
 private:
+  // each job slot holds one block. Since every block is compressed as an independent zstd frame
+  // (the decompressor re-inits its stream per block) blocks can compress in parallel on worker
+  // threads, as long as the compressed output is still written to the stream in block order. The
+  // output is identical in layout to what the old serial path produced.
+  struct Job
+  {
+    byte *page = NULL;
+    byte *compressBuffer = NULL;
+    uint64_t pageSize = 0;
+    uint32_t compSize = 0;
+
+    // 0 = empty, 1 = ready to compress, 2 = compressing, 3 = done
+    volatile int32_t state = 0;
+  };
+
   bool FlushPage();
+  bool WriteJobOutput(Job &job);
+  void WorkerEntry();
+
+  std::vector<Job> m_Jobs;
+  std::vector<Threading::ThreadHandle> m_Threads;
 
-  bool CompressZSTDFrame(ZSTD_inBuffer &in, ZSTD_outBuffer &out);
+  // the slot currently being filled. Slots are filled, compressed and written in ring order
+  size_t m_FillJob = 0;
 
+  volatile int32_t m_Shutdown = 0;
+  volatile int32_t m_Error = 0;
+
+  // points at the page of the slot being filled
   byte *m_Page;
-  byte *m_CompressBuffer;
   uint64_t m_PageOffset;
 
+  // stream for the single-threaded fallback path
   ZSTD_CStream *m_Stream;
 };
 
@@ -194,6 +194,39 @@ void merge(const std::vector<std::string> &in, std::string &out, const char sep)
   }
 }
 
+void StringBuilder::append(const char *str, size_t length)
+{
+  while(length > 0)
+  {
+    if(m_Chunks.empty() || m_Chunks.back().size() == ChunkSize)
+    {
+      m_Chunks.push_back(std::string());
+      m_Chunks.back().reserve(ChunkSize);
+    }
+
+    std::string &chunk = m_Chunks.back();
+
+    size_t copy = std::min(length, ChunkSize - chunk.size());
+    chunk.append(str, copy);
+    str += copy;
+    length -= copy;
+  }
+}
+
+std::string StringBuilder::str() const
+{
+  size_t total = 0;
+  for(const std::string &chunk : m_Chunks)
+    total += chunk.size();
+
+  std::string ret;
+  ret.reserve(total);
+  for(const std::string &chunk : m_Chunks)
+    ret += chunk;
+
+  return ret;
+}
+
 std::string removeFromEnd(const std::string &value, const std::string &ending)
 {
   string::size_type pos;
@@ -407,4 +440,52 @@ TEST_CASE("String manipulation", "[string]")
   };
 };
 
+TEST_CASE("String builder", "[string]")
+{
+  SECTION("empty builder")
+  {
+    StringBuilder builder;
+
+    CHECK(builder.str() == "");
+  };
+
+  SECTION("appends concatenate in order")
+  {
+    StringBuilder builder;
+
+    builder += "Hello";
+    builder += ' ';
+    builder += std::string("World");
+
+    CHECK(builder.str() == "Hello World");
+  };
+
+  SECTION("appends spanning multiple chunks")
+  {
+    StringBuilder builder;
+
+    // larger than any single chunk, to cover both filling a chunk mid-append and appending many
+    // times into the same chunk
+    const size_t targetSize = 4 * 1024 * 1024;
+
+    std::string piece = "0123456789ABCDE\n";
+
+    std::string expected;
+    expected.reserve(targetSize + piece.size());
+
+    while(expected.size() < targetSize)
+    {
+      builder += piece;
+      expected += piece;
+    }
+
+    std::string singlePiece(targetSize, '!');
+
+    builder += singlePiece;
+    expected += singlePiece;
+
+    CHECK(builder.str() == expected);
+  };
+};
+
 #endif    // ENABLED(ENABLE_UNIT_TESTS)
@@ -26,6 +26,7 @@
 #pragma once
 
 #include <stdint.h>
+#include <string.h>
 #include <string>
 #include <vector>
 
@@ -44,3 +45,36 @@ std::string get_dirname(const std::string &path);
 
 void split(const std::string &in, std::vector<std::string> &out, const char sep);
 void merge(const std::vector<std::string> &in, std::string &out, const char sep);
+
+// accumulates a large string from many small appends. std::string keeps its buffer contiguous, so
+// growing a multi-MB string copies everything written so far each time the buffer fills - building
+// a big disassembly that way spends most of its time moving memory. The builder writes into a list
+// of fixed-size chunks that never move once filled, and only assembles the contiguous result once,
+// in str().
+class StringBuilder
+{
+public:
+  void append(const char *str, size_t length);
+
+  StringBuilder &operator+=(const std::string &str)
+  {
+    append(str.data(), str.size());
+    return *this;
+  }
+  StringBuilder &operator+=(const char *str)
+  {
+    append(str, strlen(str));
+    return *this;
+  }
+  StringBuilder &operator+=(char c)
+  {
+    append(&c, 1);
+    return *this;
+  }
+
+  std::string str() const;
+
+private:
+  static const size_t ChunkSize = 256 * 1024;
+  std::vector<std::string> m_Chunks;
+};
@@ -26,6 +26,10 @@
 #include "renderdoccmd.h"
 #include <app/renderdoc_app.h>
 #include <replay/version.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
 #include <string>
 
 // normally this is in the renderdoc core library, but it's needed for the 'unknown enum' path,
@@ -510,6 +514,64 @@ struct RemoteServerCommand : public Command
   }
 };
 
+struct DaemonCommand : public Command
+{
+  DaemonCommand(const GlobalEnvironment &env) : Command(env) {}
+  virtual void AddOptions(cmdline::parser &parser)
+  {
+    parser.set_footer("<capture.rdc>");
+    parser.add("background", 'b', "Go into the background.");
+    parser.add<string>("host", 'h',
+                       "The interface to listen on. By default only listens locally.", false, "");
+    parser.add<uint32_t>("port", 'p', "The port to listen on.", false,
+                         RENDERDOC_GetDefaultRemoteServerPort());
+  }
+  virtual const char *Description()
+  {
+    return "Load a capture once and serve successive analysis connections against it.";
+  }
+  virtual bool IsInternalOnly() { return false; }
+  virtual bool IsCaptureCommand() { return false; }
+  virtual int Execute(cmdline::parser &parser, const CaptureOptions &)
+  {
+    std::vector<std::string> rest = parser.rest();
+    if(rest.empty())
+    {
+      std::cerr << "Error: daemon command requires a filename to load." << std::endl
+                << std::endl
+                << parser.usage();
+      return 0;
+    }
+
+    string filename = rest[0];
+
+    rest.erase(rest.begin());
+
+    string host = parser.get<string>("host");
+    uint32_t port = parser.get<uint32_t>("port");
+
+    RENDERDOC_InitGlobalEnv(m_Env, convertArgs(rest));
+
+    std::cerr << "Loading '" << filename << "' and serving analysis requests on "
+              << (host.empty() ? "localhost" : host) << ":" << port << "..." << std::endl;
+
+    if(parser.exist("background"))
+    {
+      std::cerr << "Detaching." << std::endl;
+      Daemonise();
+    }
+
+    usingKillSignal = true;
+
+    RENDERDOC_BecomeReplayDaemon(host.empty() ? NULL : host.c_str(), port, filename.c_str(),
+                                 []() { return killSignal; }, NULL);
+
+    std::cerr << std::endl << "Cleaning up from serving analysis requests." << std::endl;
+
+    return 0;
+  }
+};
+
 struct ReplayCommand : public Command
 {
   ReplayCommand(const GlobalEnvironment &env) : Command(env) {}
@@ -623,6 +685,405 @@ struct ReplayCommand : public Command
   }
 };
 
+struct BenchCommand : public Command
+{
+  BenchCommand(const GlobalEnvironment &env) : Command(env) {}
+  virtual void AddOptions(cmdline::parser &parser)
+  {
+    parser.set_footer("<capture.rdc>");
+    parser.add<uint32_t>("seeks", 's', "How many random event seeks to measure.", false, 100);
+    parser.add<uint32_t>("seed", 0, "Seed for selecting the random events, for reproducible runs.",
+                         false, 6502);
+    parser.add<string>("output", 'o', "Write the JSON results to this file instead of stdout.",
+                       false);
+  }
+  virtual const char *Description()
+  {
+    return "Replay the log file without a window and report performance timings as JSON.";
+  }
+  virtual bool IsInternalOnly() { return false; }
+  virtual bool IsCaptureCommand() { return false; }
+  static double CurrentTimeMS()
+  {
+    return double(std::chrono::duration_cast<std::chrono::microseconds>(
+                      std::chrono::steady_clock::now().time_since_epoch())
+                      .count()) /
+           1000.0;
+  }
+
+  static void GatherEvents(const rdcarray<DrawcallDescription> &draws,
+                           std::vector<uint32_t> &events)
+  {
+    for(const DrawcallDescription &d : draws)
+    {
+      events.push_back(d.eventId);
+      GatherEvents(d.children, events);
+    }
+  }
+
+  virtual int Execute(cmdline::parser &parser, const CaptureOptions &)
+  {
+    std::vector<std::string> rest = parser.rest();
+    if(rest.empty())
+    {
+      std::cerr << "Error: bench command requires a filename to load." << std::endl
+                << std::endl
+                << parser.usage();
+      return 0;
+    }
+
+    string filename = rest[0];
+
+    rest.erase(rest.begin());
+
+    RENDERDOC_InitGlobalEnv(m_Env, convertArgs(rest));
+
+    double start = CurrentTimeMS();
+
+    ICaptureFile *file = RENDERDOC_OpenCaptureFile();
+
+    if(file->OpenFile(filename.c_str(), "rdc", NULL) != ReplayStatus::Succeeded)
+    {
+      std::cerr << "Couldn't load '" << filename << "'." << std::endl;
+      return 1;
+    }
+
+    double openFileMS = CurrentTimeMS() - start;
+
+    start = CurrentTimeMS();
+
+    IReplayController *renderer = NULL;
+    ReplayStatus status = ReplayStatus::InternalError;
+    std::tie(status, renderer) = file->OpenCapture(NULL);
+
+    file->Shutdown();
+
+    if(status != ReplayStatus::Succeeded)
+    {
+      std::cerr << "Couldn't load and replay '" << filename << "': " << ToStr(status) << std::endl;
+      return 1;
+    }
+
+    // this covers the whole load - log initialisation, initial state apply and the first replay
+    // through the frame. The replay API doesn't expose the internal phase split.
+    double loadMS = CurrentTimeMS() - start;
+
+    std::vector<uint32_t> events;
+    GatherEvents(renderer->GetDrawcalls(), events);
+
+    if(events.empty())
+    {
+      std::cerr << "Capture contains no events to benchmark." << std::endl;
+      renderer->Shutdown();
+      return 1;
+    }
+
+    // a full replay to the end of the frame, now everything is warm
+    start = CurrentTimeMS();
+    renderer->SetFrameEvent(events.back(), true);
+    double fullReplayMS = CurrentTimeMS() - start;
+
+    // measure the latency of seeking to randomly chosen events. A fixed-seed LCG keeps the event
+    // sequence reproducible from run to run so nightly numbers are comparable.
+    uint32_t numSeeks = parser.get<uint32_t>("seeks");
+    uint32_t rng = parser.get<uint32_t>("seed");
+
+    std::vector<double> seekMS;
+    seekMS.reserve(numSeeks);
+
+    for(uint32_t i = 0; i < numSeeks; i++)
+    {
+      rng = rng * 1664525 + 1013904223;
+
+      uint32_t eventId = events[rng % events.size()];
+
+      start = CurrentTimeMS();
+      renderer->SetFrameEvent(eventId, true);
+      seekMS.push_back(CurrentTimeMS() - start);
+    }
+
+    std::sort(seekMS.begin(), seekMS.end());
+
+    double seekTotal = 0.0;
+    for(double t : seekMS)
+      seekTotal += t;
+
+    // read back the top mip of every texture to measure fetch throughput
+    uint64_t texBytes = 0;
+    size_t texCount = 0;
+
+    start = CurrentTimeMS();
+
+    for(const TextureDescription &tex : renderer->GetTextures())
+    {
+      bytebuf data = renderer->GetTextureData(tex.resourceId, 0, 0);
+
+      texBytes += data.size();
+      texCount++;
+    }
+
+    double texMS = CurrentTimeMS() - start;
+
+    renderer->Shutdown();
+
+    // escape backslashes and quotes so windows paths survive the JSON round-trip
+    std::string escaped;
+    for(char c : filename)
+    {
+      if(c == '\\' || c == '"')
+        escaped += '\\';
+      escaped += c;
+    }
+
+    std::ostringstream json;
+
+    json << "{\n";
+    json << "  \"capture\": \"" << escaped << "\",\n";
+    json << "  \"openFileMS\": " << openFileMS << ",\n";
+    json << "  \"loadMS\": " << loadMS << ",\n";
+    json << "  \"fullReplayMS\": " << fullReplayMS << ",\n";
+    json << "  \"seek\": {\n";
+    json << "    \"samples\": " << seekMS.size() << ",\n";
+    json << "    \"minMS\": " << seekMS.front() << ",\n";
+    json << "    \"meanMS\": " << seekTotal / double(seekMS.size()) << ",\n";
+    json << "    \"medianMS\": " << seekMS[seekMS.size() / 2] << ",\n";
+    json << "    \"p90MS\": " << seekMS[(seekMS.size() * 9) / 10] << ",\n";
+    json << "    \"maxMS\": " << seekMS.back() << "\n";
+    json << "  },\n";
+    json << "  \"textureRead\": {\n";
+    json << "    \"textures\": " << texCount << ",\n";
+    json << "    \"bytes\": " << texBytes << ",\n";
+    json << "    \"totalMS\": " << texMS << ",\n";
+    json << "    \"MBPerSec\": "
+         << (texMS > 0.0 ? (double(texBytes) / (1024.0 * 1024.0)) / (texMS / 1000.0) : 0.0) << "\n";
+    json << "  }\n";
+    json << "}\n";
+
+    if(parser.exist("output"))
+    {
+      std::ofstream out(parser.get<string>("output").c_str());
+
+      if(!out)
+      {
+        std::cerr << "Couldn't open '" << parser.get<string>("output") << "' for writing."
+                  << std::endl;
+        return 1;
+      }
+
+      out << json.str();
+    }
+    else
+    {
+      std::cout << json.str();
+    }
+
+    return 0;
+  }
+};
+
+struct OverheadCommand : public Command
+{
+  OverheadCommand(const GlobalEnvironment &env) : Command(env) {}
+  virtual void AddOptions(cmdline::parser &parser)
+  {
+    parser.set_footer("<path to demos executable>");
+    parser.add<string>("tests", 't', "Comma-separated list of demo tests to run as workloads.",
+                       false, "VK_Simple_Triangle,GL_Simple_Triangle,D3D11_Simple_Triangle");
+    parser.add<uint32_t>("frames", 'f', "How many frames to run each workload for.", false, 1000);
+    parser.add<uint32_t>("capture-every", 0,
+                         "How often to trigger a capture in the active-capture pass.", false, 100);
+    parser.add<string>("output", 'o', "Write the JSON results to this file instead of stdout.",
+                       false);
+  }
+  virtual const char *Description()
+  {
+    return "Measure the frame time overhead the capture layer adds to demo workloads.";
+  }
+  virtual bool IsInternalOnly() { return false; }
+  virtual bool IsCaptureCommand() { return false; }
+  virtual int Execute(cmdline::parser &parser, const CaptureOptions &)
+  {
+    std::vector<std::string> rest = parser.rest();
+    if(rest.empty())
+    {
+      std::cerr << "Error: overhead command requires the path to the demos executable."
+                << std::endl
+                << std::endl
+                << parser.usage();
+      return 0;
+    }
+
+    string demos = rest[0];
+
+    rest.erase(rest.begin());
+
+    RENDERDOC_InitGlobalEnv(m_Env, convertArgs(rest));
+
+    std::vector<std::string> tests;
+
+    {
+      std::string list = parser.get<string>("tests");
+
+      size_t offs = 0;
+      while(offs < list.size())
+      {
+        size_t comma = list.find(',', offs);
+        if(comma == std::string::npos)
+          comma = list.size();
+
+        if(comma > offs)
+          tests.push_back(list.substr(offs, comma - offs));
+
+        offs = comma + 1;
+      }
+    }
+
+    uint32_t frames = parser.get<uint32_t>("frames");
+    uint32_t captureEvery = parser.get<uint32_t>("capture-every");
+
+    // the demo writes its measured average frame time here, so the numbers exclude process
+    // startup and capture library load and measure only the per-frame cost we care about.
+    const char *benchFile = "renderdoc_overhead_frametime.txt";
+
+    // runs the demo once, clean or injected, and returns the average frame time in milliseconds
+    // it reported, or a negative value if the run failed.
+    auto runPass = [&](const std::string &test, bool inject, const CaptureOptions &opts,
+                       uint32_t capEvery) -> double {
+      remove(benchFile);
+
+      std::string args = test + " --frames " + std::to_string(frames) + " --bench-out " + benchFile;
+
+      if(capEvery > 0)
+        args += " --capture-every " + std::to_string(capEvery);
+
+      if(inject)
+      {
+        rdcarray<EnvironmentModification> env;
+
+        ExecuteResult res = RENDERDOC_ExecuteAndInject(
+            demos.c_str(), NULL, args.c_str(), env, "renderdoc_overhead_capture", opts, true);
+
+        if(res.status != ReplayStatus::Succeeded)
+        {
+          std::cerr << "Couldn't inject into '" << demos << "': " << ToStr(res.status) << std::endl;
+          return -1.0;
+        }
+      }
+      else
+      {
+        std::string cmd = "\"" + demos + "\" " + args;
+
+        // the exit code of the demo isn't meaningful cross-platform, rely on the bench file
+        (void)system(cmd.c_str());
+      }
+
+      double ret = -1.0;
+
+      FILE *f = fopen(benchFile, "r");
+      if(f)
+      {
+        if(fscanf(f, "%lf", &ret) != 1)
+          ret = -1.0;
+        fclose(f);
+        remove(benchFile);
+      }
+
+      return ret;
+    };
+
+    std::ostringstream json;
+
+    json << "{\n";
+    json << "  \"frames\": " << frames << ",\n";
+    json << "  \"captureEvery\": " << captureEvery << ",\n";
+    json << "  \"workloads\": [";
+
+    bool first = true;
+
+    for(const std::string &test : tests)
+    {
+      std::cerr << "Running '" << test << "' clean..." << std::endl;
+
+      double clean = runPass(test, false, CaptureOptions(), 0);
+
+      if(!first)
+        json << ",";
+      first = false;
+
+      json << "\n    {\n";
+      json << "      \"test\": \"" << test << "\",\n";
+
+      if(clean <= 0.0)
+      {
+        std::cerr << "'" << test << "' didn't report a clean frame time - skipping." << std::endl;
+        json << "      \"failed\": true\n";
+        json << "    }";
+        continue;
+      }
+
+      json << "      \"cleanFrameMS\": " << clean << ",\n";
+      json << "      \"paths\": {";
+
+      struct
+      {
+        const char *name;
+        bool callstacks;
+        uint32_t capEvery;
+      } paths[] = {
+          {"idle", false, 0}, {"activeCapture", false, captureEvery}, {"callstacks", true, 0},
+      };
+
+      for(size_t i = 0; i < sizeof(paths) / sizeof(paths[0]); i++)
+      {
+        std::cerr << "Running '" << test << "' injected (" << paths[i].name << ")..." << std::endl;
+
+        CaptureOptions opts;
+        opts.captureCallstacks = paths[i].callstacks;
+
+        double injected = runPass(test, true, opts, paths[i].capEvery);
+
+        json << (i == 0 ? "" : ",") << "\n        \"" << paths[i].name << "\": {";
+
+        if(injected <= 0.0)
+        {
+          json << " \"failed\": true }";
+          continue;
+        }
+
+        json << "\n          \"frameMS\": " << injected << ",\n";
+        json << "          \"overheadPercent\": " << ((injected - clean) / clean) * 100.0 << "\n";
+        json << "        }";
+      }
+
+      json << "\n      }\n";
+      json << "    }";
+    }
+
+    json << "\n  ]\n";
+    json << "}\n";
+
+    if(parser.exist("output"))
+    {
+      std::ofstream out(parser.get<string>("output").c_str());
+
+      if(!out)
+      {
+        std::cerr << "Couldn't open '" << parser.get<string>("output") << "' for writing."
+                  << std::endl;
+        return 1;
+      }
+
+      out << json.str();
+    }
+    else
+    {
+      std::cout << json.str();
+    }
+
+    return 0;
+  }
+};
+
 struct formats_reader
 {
   formats_reader()
@@ -1170,6 +1631,64 @@ struct EmbeddedSectionCommand : public Command
   }
 };
 
+struct PackCommand : public Command
+{
+  bool m_Unpack = false;
+  PackCommand(const GlobalEnvironment &env, bool unpack) : Command(env) { m_Unpack = unpack; }
+  virtual void AddOptions(cmdline::parser &parser)
+  {
+    parser.set_footer(m_Unpack ? "<packed.rdc> <output.rdc>" : "<capture.rdc> <packed.rdc>");
+    parser.add<std::string>("store", 's', "The blob store directory shared across the archive.");
+  }
+  virtual const char *Description()
+  {
+    if(m_Unpack)
+      return "Reassemble a standalone capture from a packed capture and its blob store.";
+    else
+      return "Pack a capture for archiving, deduplicating its data into a shared blob store.";
+  }
+  virtual bool IsInternalOnly() { return false; }
+  virtual bool IsCaptureCommand() { return false; }
+  virtual int Execute(cmdline::parser &parser, const CaptureOptions &)
+  {
+    std::vector<std::string> rest = parser.rest();
+    if(rest.size() < 2)
+    {
+      std::cerr << "Error: this command requires an input and an output filename." << std::endl
+                << std::endl
+                << parser.usage();
+      return 0;
+    }
+
+    std::string infile = rest[0];
+    std::string outfile = rest[1];
+
+    rest.erase(rest.begin(), rest.begin() + 2);
+
+    RENDERDOC_InitGlobalEnv(m_Env, convertArgs(rest));
+
+    std::string store = parser.get<std::string>("store");
+
+    ReplayStatus status;
+
+    if(m_Unpack)
+      status = RENDERDOC_UnpackCaptureFile(infile.c_str(), outfile.c_str(), store.c_str());
+    else
+      status = RENDERDOC_PackCaptureFile(infile.c_str(), outfile.c_str(), store.c_str());
+
+    if(status != ReplayStatus::Succeeded)
+    {
+      std::cerr << "Couldn't " << (m_Unpack ? "unpack '" : "pack '") << infile
+                << "': " << ToStr(status) << std::endl;
+      return 1;
+    }
+
+    std::cout << "Wrote '" << outfile << "'." << std::endl;
+
+    return 0;
+  }
+};
+
 REPLAY_PROGRAM_MARKER()
 
 int renderdoccmd(const GlobalEnvironment &env, std::vector<std::string> &argv)
@@ -1201,12 +1720,17 @@ int renderdoccmd(const GlobalEnvironment &env, std::vector<std::string> &argv)
     add_command("capture", new CaptureCommand(env));
     add_command("inject", new InjectCommand(env));
     add_command("remoteserver", new RemoteServerCommand(env));
+    add_command("daemon", new DaemonCommand(env));
     add_command("replay", new ReplayCommand(env));
+    add_command("bench", new BenchCommand(env));
+    add_command("overhead", new OverheadCommand(env));
     add_command("capaltbit", new CapAltBitCommand(env));
     add_command("test", new TestCommand(env));
     add_command("convert", new ConvertCommand(env));
     add_command("embed", new EmbeddedSectionCommand(env, false));
     add_command("extract", new EmbeddedSectionCommand(env, true));
+    add_command("pack", new PackCommand(env, false));
+    add_command("unpack", new PackCommand(env, true));
 
     if(argv.size() <= 1)
     {
@@ -250,6 +250,10 @@ Usage: %s Test_Name [test_options]
   --frames <n>
   --max-frames <n>
   --frame-count <n>             Only run the demo for this number of frames
+  --capture-every <n>           Trigger a capture every n frames via the in-app
+                                API, when running injected.
+  --bench-out <file>            Write the average frame time in milliseconds to
+                                this file on the final frame.
   --data <path>                 Specfiy where extended data should come from.
                                 By default in the path in $RENDERDOC_DEMOS_DATA
                                 environment variable, or else in the data/demos
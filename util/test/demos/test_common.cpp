@@ -26,6 +26,11 @@
 #include <stdarg.h>
 #include <stdio.h>
 #include <algorithm>
+#include <chrono>
+
+#if !defined(WIN32)
+#include <dlfcn.h>
+#endif
 
 const DefaultA2V DefaultTri[3] = {
     {Vec3f(-0.5f, -0.5f, 0.0f), Vec4f(1.0f, 0.0f, 0.0f, 1.0f), Vec2f(0.0f, 0.0f)},
@@ -372,6 +377,16 @@ bool GraphicsTest::Init(int argc, char **argv)
       maxFrameCount = atoi(argv[i + 1]);
     }
 
+    if(i + 1 < argc && !strcmp(argv[i], "--capture-every"))
+    {
+      captureEvery = atoi(argv[i + 1]);
+    }
+
+    if(i + 1 < argc && !strcmp(argv[i], "--bench-out"))
+    {
+      benchOut = argv[i + 1];
+    }
+
     if(i + 1 < argc && !strcmp(argv[i], "--data"))
     {
       dataRoot = argv[i + 1];
@@ -401,6 +416,26 @@ bool GraphicsTest::Init(int argc, char **argv)
 
 #else
 
+  // if we're running injected the capture library is already loaded, look it up without loading
+  void *mod = dlopen("librenderdoc.so", RTLD_NOW | RTLD_NOLOAD);
+  if(mod)
+  {
+    pRENDERDOC_GetAPI RENDERDOC_GetAPI = (pRENDERDOC_GetAPI)dlsym(mod, "RENDERDOC_GetAPI");
+
+    if(RENDERDOC_GetAPI)
+    {
+      int ret = RENDERDOC_GetAPI(eRENDERDOC_API_Version_1_4_0, (void **)&rdoc);
+
+      if(ret != 1)
+        rdoc = NULL;
+
+      ret = RENDERDOC_GetAPI(eRENDERDOC_API_Version_1_0_0, (void **)&rdoc100);
+
+      if(ret != 1)
+        rdoc100 = NULL;
+    }
+  }
+
 #endif
 
   return true;
@@ -415,9 +450,43 @@ std::string GraphicsTest::GetDataPath(const std::string &filename)
   return dataRoot + filename;
 }
 
+static double CurTimeMS()
+{
+  return double(std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch())
+                    .count()) /
+         1000.0;
+}
+
 bool GraphicsTest::FrameLimit()
 {
   curFrame++;
+
+  // when benchmarking capture overhead, exercise the active-capture path on a steady cadence
+  if(captureEvery > 0 && rdoc100 && (curFrame % captureEvery) == 0)
+    rdoc100->TriggerCapture();
+
+  if(!benchOut.empty() && maxFrameCount > 0)
+  {
+    // let the first frames warm up swapchains, shader caches etc before timing
+    const int warmup = std::min(10, maxFrameCount / 2);
+
+    if(curFrame == warmup)
+      benchStartMS = CurTimeMS();
+
+    if(curFrame >= maxFrameCount && curFrame > warmup)
+    {
+      double avgMS = (CurTimeMS() - benchStartMS) / double(curFrame - warmup);
+
+      FILE *f = fopen(benchOut.c_str(), "w");
+      if(f)
+      {
+        fprintf(f, "%f\n", avgMS);
+        fclose(f);
+      }
+    }
+  }
+
   if(maxFrameCount > 0 && curFrame >= maxFrameCount)
     return false;
 
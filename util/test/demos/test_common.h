@@ -166,6 +166,13 @@ struct GraphicsTest
   int curFrame = 0;
   int maxFrameCount = -1;
 
+  // when running as a capture overhead benchmark workload: trigger a capture through the in-app
+  // API every N frames, and write the measured average frame time in milliseconds to a file on
+  // the final frame so the harness can compare clean and injected runs.
+  int captureEvery = 0;
+  std::string benchOut;
+  double benchStartMS = 0.0;
+
   int screenWidth = 400;
   int screenHeight = 300;
   const char *screenTitle = "RenderDoc test program";